@@ -9,6 +9,7 @@
 #include <corgi/rendering/renderer.h>
 #include <corgi/utils/Physic.h>
 #include <corgi/utils/TimeHelper.h>
+#include <corgi/utils/time/FrameLimiter.h>
 
 #include <functional>
 #include <memory>
@@ -70,6 +71,7 @@ public:
     [[nodiscard]] float           time_step();
 
     [[nodiscard]] Time&                                time() { return time_; }
+    [[nodiscard]] corgi::time::FrameLimiter&           frame_limiter() { return frame_limiter_; }
     [[nodiscard]] std::function<void(Window& window)>& update() { return update_; }
 
     /*!
@@ -154,6 +156,9 @@ private:
     Profiler    profiler_;
     Inputs      inputs_;
 
+    // Disabled until a target frame rate is set
+    corgi::time::FrameLimiter frame_limiter_;
+
     float time_step_ = 1.0f / 60.0f;    // 4 bytes
 
     bool quit_ = false;    // 1 byte
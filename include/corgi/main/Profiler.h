@@ -1,6 +1,7 @@
 #pragma once
 
 #include <corgi/utils/TimeHelper.h>
+#include <corgi/utils/time/FrameTimeHistogram.h>
 
 namespace corgi
 {
@@ -20,6 +21,10 @@ namespace corgi
 		Counter update_counter_;
 		Counter renderer_counter_;
 		Counter loop_counter_;
+
+		// Duration of every frame since the game started, reset() doesn't
+		// clear it
+		time::FrameTimeHistogram frame_times_;
 		
 		float refresh_rate_ = 0.85f;
 
@@ -14,9 +14,11 @@
 
 #include <corgi/utils/TextUtils.h>
 
-#include <vector>
-#include <string>
+#include <cstddef>
 #include <memory>
+#include <string>
+#include <utility>
+#include <vector>
 
 namespace corgi
 {
@@ -54,6 +56,23 @@ namespace corgi
                 Down
             };
 
+            /*!
+             * @brief   How update turns the vertices into something drawable
+             */
+            enum class MeshMode
+            {
+                // A new mesh is built every time
+                Rebuild,
+
+                // The mesh keeps its buffers and only uploads the glyph quads
+                // that changed, reallocating only when the text outgrows them
+                Incremental,
+
+                // No mesh, DrawList::add_text copies the vertices into the
+                // text buffer shared by the whole DrawList
+                Shared
+            };
+
             std::vector<corgi::utils::text::ShapedGlyph> shapedGlyphs_;
 
             Vec2                position;
@@ -61,6 +80,7 @@ namespace corgi
             std::string        text;
             Material            material;
             std::shared_ptr<Mesh> mesh;
+            MeshMode            mesh_mode {MeshMode::Rebuild};
             float               scaling = 1.0f;
             HorizontalAlignment horizontal_alignment {
                 DrawList::Text::HorizontalAlignment::Centered};
@@ -96,6 +116,47 @@ namespace corgi
             void setText(const std::vector<corgi::utils::text::ShapedGlyph>& glyphs);
 
             void update();
+
+            /*!
+             * @brief   Vertices built by the last update, 4 vertices of 5 floats
+             *          per glyph. Empty in Rebuild mode, where they're moved
+             *          inside the mesh
+             */
+            std::vector<float> vertices;
+
+            /*!
+             * @brief   Appends to @a indexes the 2 triangles of every quad
+             *          between the last one they index and @a quad_count
+             */
+            static void append_quad_indexes(std::vector<unsigned>& indexes,
+                                            std::size_t            quad_count);
+
+            /*!
+             * @brief   Returns how many quads the buffers of an Incremental
+             *          mesh get room for when @a quad_count doesn't fit
+             *          anymore
+             *
+             *          Leaves room so a growing text, like a counter, doesn't
+             *          reallocate the buffers every time it gains a glyph
+             */
+            [[nodiscard]] static std::size_t grown_quad_capacity(std::size_t quad_count) noexcept;
+
+            /*!
+             * @brief   Returns the first float that differs between @a before
+             *          and @a after, and how many floats from there must be
+             *          copied so @a before equals @a after
+             */
+            static std::pair<std::size_t, std::size_t>
+            changed_range(const std::vector<float>& before, const std::vector<float>& after);
+
+        private:
+            void build_vertices();
+
+            /*!
+             * @brief   Copies the quads that changed into the mesh and uploads
+             *          them, growing the mesh's buffers if needed
+             */
+            void upload_changed_quads();
         };
 
         struct Rectangle
@@ -194,6 +255,18 @@ namespace corgi
 
         void add(Text text);
 
+        /*!
+         * @brief   Draws @a text from the vertex buffer shared by every text
+         *          added this way, uploaded once when the DrawList is drawn
+         *
+         *          @a text must have been updated in MeshMode::Shared. Like
+         *          add_mesh, @a material is kept by reference
+         */
+        void add_text(const Text&     text,
+                      const Matrix&   model_matrix,
+                      const Material& material,
+                      Window*         window = nullptr);
+
         void add_nine_slice(NineSlice nine_slice);
         void add_mesh(const Mesh&     mesh,
                       const Matrix&   model_matrix,
@@ -263,6 +336,7 @@ namespace corgi
             Text,
             Sprite,
             Mesh,
+            SharedText,
             ResetStencilBuffer
         };
 
@@ -283,6 +357,21 @@ namespace corgi
         };
 
         std::vector<MeshToRender>            _meshes;
+
+        struct SharedTextToRender
+        {
+            const Material& material;
+            Matrix          matrix;
+            std::size_t     first_index;
+            int             index_count;
+            corgi::Window*  window = nullptr;
+        };
+
+        // Vertices of every text added with add_text, kept from one frame to
+        // the next so they're only allocated once
+        std::vector<float>              text_vertices_;
+        std::vector<SharedTextToRender> shared_texts_;
+
         std::vector<std::pair<DrawListType, int>> order_;
     };
 }    // namespace corgi
@@ -12,10 +12,16 @@
 #include <cstring>
 #include <memory>
 #include <string>
+#include <string_view>
 #include <vector>
 
 struct UniformFloat;
 
+namespace corgi::filesystem
+{
+class VirtualFileSystem;
+}
+
 namespace corgi
 {
 class Texture;
@@ -75,6 +81,12 @@ public:
     Material(const std::string& name = "empty");
     Material(const std::string& path, const std::string& relative_name);
 
+    /*!
+     * @brief   Loads the material @a identifier of a mounted pack. Its shaders
+     *          are loaded through the ResourcesCache, from the packs too
+     */
+    Material(const filesystem::VirtualFileSystem& vfs, const std::string& identifier);
+
     ~Material() override = default;
 
     // Functions
@@ -94,6 +106,27 @@ public:
     void set_texture(int index, const Texture& texture, const std::string& name);
     void set_texture(int index, const Texture& texture);
 
+    /*!
+     * @brief   Builds the material again from the content of its .mat file
+     *
+     *          Textures are bound by code rather than by the file, so the
+     *          samplers that still exist keep their texture. The new program
+     *          isn't shared with the copies made before the reload
+     *
+     * @return  Returns false if @a json can't be parsed. The material is left
+     *          untouched then
+     */
+    bool reload(const std::string& identifier, std::string_view json);
+
+    /*!
+     * @brief   Relinks the material's program after one of its shaders was
+     *          reloaded, and updates the uniform locations
+     *
+     *          The program is shared with the copies of the material, so they
+     *          use the new shader too, but keep their previous locations
+     */
+    void relink();
+
     // TODO : Set all variables privates
 
     struct TextureUniform
@@ -419,5 +452,11 @@ public:
 
 private:
     void generate_shaders();
+
+    /*!
+     * @brief   Builds the material from the content of the .mat file
+     *          @a identifier
+     */
+    void load(const std::string& identifier, std::string_view json);
 };
 }    // namespace corgi
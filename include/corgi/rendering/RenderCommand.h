@@ -2,6 +2,10 @@
 
 #include <corgi/rendering/ShaderProgram.h>
 #include <corgi/rendering/texture.h>
+#include <corgi/utils/TextureCompression.h>
+
+#include <cstddef>
+#include <span>
 
 namespace corgi
 {
@@ -28,6 +32,21 @@ namespace corgi
         buffer_index_subdata(unsigned int buffer_id, const unsigned int* data, int size);
         static void delete_vertex_buffer_object(unsigned int index);
 
+        // Allocates @a size bytes for a buffer whose content is then replaced
+        // piece by piece with the subdata functions taking an offset
+        static void allocate_vertex_data(unsigned int index, std::size_t size);
+        static void allocate_index_data(unsigned int buffer_id, std::size_t size);
+
+        // Replaces @a size bytes of the buffer, starting @a offset bytes in
+        static void buffer_vertex_subdata(unsigned int index,
+                                          std::size_t  offset,
+                                          const void*  data,
+                                          std::size_t  size);
+        static void buffer_index_subdata(unsigned int buffer_id,
+                                         std::size_t  offset,
+                                         const void*  data,
+                                         std::size_t  size);
+
         static void         delete_texture_object(unsigned int index);
         static void         bind_texture_object(unsigned int id);
         static unsigned int generate_texture_object();
@@ -38,6 +57,46 @@ namespace corgi
                                                       Texture::DataType       dt,
                                                       void*                   data = 0);
 
+        // Returns true if the context can sample textures encoded with @a format
+        [[nodiscard]] static bool supports_texture_format(texture_compression::Format format);
+
+        // Returns the width and height of the largest texture the context can
+        // allocate
+        [[nodiscard]] static int max_texture_size();
+
+        // Uploads the mip level @a level of the bound texture object, already
+        // encoded with @a format, so block compressed levels are uploaded as is.
+        // Formats the context doesn't support are decoded and uploaded as RGBA8
+        static void upload_texture_level(texture_compression::Format format,
+                                         int                         level,
+                                         int                         width,
+                                         int                         height,
+                                         std::span<const std::byte>  data);
+
+        // Highest mip level of the bound texture object the sampler may use
+        static void texture_max_level(int level);
+
+        // Binds @a buffer as the source of the next texture uploads and maps
+        // its first @a size bytes for writing. The buffer's storage is
+        // replaced by @a allocate bytes first when @a allocate isn't 0.
+        // Returns nullptr if the buffer couldn't be mapped
+        static std::byte*
+        map_pixel_buffer(unsigned int buffer, std::size_t size, std::size_t allocate);
+
+        // Unmaps the bound pixel buffer. The next texture uploads read their
+        // pixels from it, their data pointer being an offset inside it.
+        // Returns false if the buffer's content was lost while mapped
+        static bool unmap_pixel_buffer();
+
+        // Texture uploads read their pixels from client memory again
+        static void unbind_pixel_buffer();
+
+        // Returns a fence signaled once the commands issued so far completed
+        static void* insert_fence();
+
+        // Waits until @a fence is signaled, then deletes it
+        static void wait_fence(void* fence);
+
         static void begin_texture(const Texture* texture);
         static void end_texture();
 
@@ -63,6 +122,26 @@ namespace corgi
 
         static void
         vertex_attribute_pointer(unsigned id, unsigned stride, int offset, unsigned size);
+
+        // Attributes read once per instance by instanced draw calls. The offset
+        // is in bytes
+        static void instance_attribute_pointer(unsigned id,
+                                               unsigned stride,
+                                               std::size_t offset,
+                                               unsigned size);
+
+        // Same as instance_attribute_pointer, for 4 normalized unsigned bytes
+        static void
+        instance_color_attribute_pointer(unsigned id, unsigned stride, std::size_t offset);
+
+        // Replaces the content of a buffer updated every frame
+        static void buffer_stream_data(unsigned int index, const void* data, std::size_t size);
+
+        // Draws @a index_count indexes of the bound index buffer, starting at
+        // the index @a first_index
+        static void draw_triangles(int index_count, std::size_t first_index);
+
+        static void draw_instanced_triangles(int index_count, int instance_count);
         static void enable_vertex_attribute(unsigned id);
         static void disable_vertex_attribute(unsigned id);
         static void check_error();
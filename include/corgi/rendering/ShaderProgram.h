@@ -30,6 +30,15 @@ namespace corgi
 
         unsigned int id() const { return id_; }
 
+        /*!
+         * @brief   Attaches the current objects of the program's shaders and
+         *          links it again, keeping its id
+         *
+         *          Called once a shader was reloaded. Uniform locations may
+         *          change if the shader's uniforms did
+         */
+        void relink();
+
         // Variables
 
         ShortString  name_;
@@ -59,6 +59,15 @@ namespace corgi
 
 		// The pivot thing tells the renderer how he should actually 
 		void pivot(Pivot pivot);
+
+		/*!
+		 * @brief	Writes the sprite's offset and size, in uv space, into @a rect
+		 *
+		 *			Coordinates are relative to the texture actually bound, so
+		 *			a sprite whose texture is a region of an atlas page is
+		 *			mapped to the right part of the page
+		 */
+		void uv_rect(float rect[4]) const;
 		
 	// Variables
 			
@@ -0,0 +1,129 @@
+#pragma once
+
+#include <corgi/rendering/Material.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace corgi
+{
+    class Texture;
+
+    /*!
+     * @brief   Per-instance attributes of a sprite, uploaded as is to the
+     *          instance buffer of the sprite batches
+     *
+     *          Everything a sprite needs that isn't shared with the other
+     *          sprites of its batch lives here, so the material doesn't need
+     *          any per-sprite uniform
+     */
+    struct SpriteInstance
+    {
+        // Column major, like Matrix::data(). Attribute locations 2 to 5
+        float world_matrix[16];
+
+        // Offset and size of the sprite inside the texture, in uv space.
+        // The size is negative on a flipped axis. Attribute location 6
+        float uv_rect[4];
+
+        // Width, height, pivot x, pivot y. Attribute location 7
+        float quad[4];
+
+        // RGBA, 8 bits per channel. Attribute location 8
+        std::uint32_t tint;
+    };
+
+    static_assert(sizeof(SpriteInstance) == 25 * sizeof(float),
+                  "SpriteInstance is uploaded without padding");
+
+    /*!
+     * @brief   Groups sprites by material and texture, so each group can be
+     *          drawn with a single instanced draw call
+     *
+     *          Every group owns one material, built the first time a material
+     *          and texture pair is used. Sprites sharing a texture, or an
+     *          atlas, therefore share a material instead of each owning a copy.
+     *          Groups are identified by the serials of the material and the
+     *          texture rather than their addresses, which can be reused once
+     *          they're destroyed. They're kept from one frame to the next, as
+     *          long as they are used
+     */
+    class SpriteBatch
+    {
+    public:
+        struct Batch
+        {
+            // Resource::serial of the material and of the texture
+            std::uint64_t base {0u};
+            std::uint64_t texture {0u};
+
+            // Copy of base, with texture bound to its first sampler
+            Material material;
+
+            std::vector<SpriteInstance> instances;
+        };
+
+        // Functions
+
+        /*!
+         * @brief   Empties every batch, keeping their materials and memory.
+         *          Batches that stayed empty since the previous clear are
+         *          removed
+         */
+        void clear() noexcept;
+
+        /*!
+         * @brief   Removes every batch, and the material copies they own
+         */
+        void release() noexcept;
+
+        /*!
+         * @brief   Appends an instance to the batch drawing @a texture with
+         *          @a base, creating the batch if needed
+         *
+         *          Textures that are regions of the same atlas page share
+         *          their batch
+         *
+         * @return  Returns the new instance, whose content is left to the caller
+         */
+        SpriteInstance& emplace(const Material& base, const Texture& texture);
+
+        /*!
+         * @brief   Sorts the instances of the batches whose material blends
+         *          back to front, by increasing z, and by decreasing y on
+         *          equal z
+         *
+         *          Blended sprites can't rely on the depth test, so inside a
+         *          batch they're drawn in the order they overlap
+         */
+        void sort_blended() noexcept;
+
+        // Accessors
+
+        [[nodiscard]] const std::vector<Batch>& batches() const noexcept { return batches_; }
+
+        /*!
+         * @brief   Returns how many batches contain at least one sprite, which
+         *          is the number of draw calls needed to draw them
+         */
+        [[nodiscard]] std::size_t draw_count() const noexcept;
+
+        [[nodiscard]] std::size_t instance_count() const noexcept;
+
+        /*!
+         * @brief   Packs a color into the 8 bits per channel format used by
+         *          SpriteInstance::tint
+         */
+        [[nodiscard]] static std::uint32_t pack_color(int r, int g, int b, int a) noexcept;
+
+    private:
+        Batch& find_or_add(const Material& base, const Texture& texture);
+
+        std::vector<Batch> batches_;
+
+        // Consecutive sprites usually share their texture, so we check the
+        // last used batch before searching the others
+        std::size_t last_ {0};
+    };
+}    // namespace corgi
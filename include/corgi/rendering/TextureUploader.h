@@ -0,0 +1,65 @@
+#pragma once
+
+#include <corgi/rendering/texture.h>
+
+#include <array>
+#include <cstddef>
+
+namespace corgi
+{
+/*!
+ * @brief   Uploads texture pixels through a ring of pixel buffer objects
+ *
+ *          Uploading from client memory makes the driver copy the pixels
+ *          before glTexImage2D returns. Here the pixels are written straight
+ *          into a mapped pixel buffer, and the GPU copies them into the
+ *          texture asynchronously while the next image is read or decoded
+ *          into the next buffer of the ring. A buffer is only waited for when
+ *          the ring comes back to it before its upload completed
+ */
+class TextureUploader
+{
+public:
+    // Functions
+
+    /*!
+     * @brief   Returns @a size bytes to write the pixels of the next upload
+     *          into, or nullptr if no pixel buffer could be mapped, the
+     *          pixels being uploaded from client memory then
+     */
+    [[nodiscard]] static std::byte* stage(std::size_t size);
+
+    /*!
+     * @brief   Uploads the pixels written in the memory returned by stage to
+     *          the bound texture object
+     *
+     * @return  Returns false if the staged pixels were lost, the texture's
+     *          storage is still allocated
+     */
+    static bool upload(Texture::Format         format,
+                       Texture::InternalFormat internal_format,
+                       int                     width,
+                       int                     height,
+                       Texture::DataType       data_type);
+
+    /*!
+     * @brief   Deletes the pixel buffers, called before the OpenGL context
+     *          is destroyed
+     */
+    static void release();
+
+private:
+    struct PixelBuffer
+    {
+        unsigned    id {0};
+        std::size_t capacity {0};
+
+        // Signaled once the upload reading the buffer completed
+        void* fence {nullptr};
+    };
+
+    // Enough to decode an image while the 2 previous ones are being copied
+    static std::array<PixelBuffer, 3> buffers_;
+    static std::size_t                current_;
+};
+}    // namespace corgi
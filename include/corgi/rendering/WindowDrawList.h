@@ -49,6 +49,11 @@ namespace corgi
                       const Material& material,
                       corgi::Window&  window
             );
+        void add_text(const DrawList::Text& text,
+                      const Matrix&         model_matrix,
+                      const Material&       material,
+                      corgi::Window&        window
+            );
         void resetStencilBuffer();
 
         void clear()
@@ -4,11 +4,13 @@
 #include <corgi/ecs/ComponentPool.h>
 
 #include <corgi/math/Matrix.h>
+#include <corgi/math/Vec2.h>
 #include <corgi/math/Vec3.h>
 #include <corgi/math/Vec4.h>
 
 #include <corgi/rendering/DrawList.h>
 #include <corgi/rendering/Profiler.h>
+#include <corgi/rendering/SpriteBatch.h>
 #include <corgi/rendering/WindowDrawList.h>
 
 #include <corgi/utils/Color.h>
@@ -92,6 +94,13 @@ namespace corgi
         void initialize();
         void initialize_opengl_state();
         void clear();
+
+        /*!
+		 * @brief	Deletes the buffers and the material copies the renderer
+		 *			owns, called before the OpenGL context is destroyed
+		 */
+        void release();
+
         void draw_scene(Window& window);
         void draw_colliders(Scene& scene);
 
@@ -122,6 +131,17 @@ namespace corgi
          */
         void set_current_window(Window* window);
 
+        /*!
+         * @brief   Sets how far the current frame is between the last two fixed
+         *          updates, in the [0.0f, 1.0f] range
+         *
+         *          Cameras and meshes are drawn between their previous and current
+         *          world matrices using this value. 1 draws the latest state
+         */
+        void interpolation_alpha(float alpha) noexcept;
+
+        [[nodiscard]] float interpolation_alpha() const noexcept;
+
         /*!
 		 * @brief	Actually send the model matrix with the mesh's vertex to the GPU
 		 */
@@ -179,6 +199,29 @@ namespace corgi
 		 */
         void drawScreenSpace(Window& window);
 
+        /*!
+		 * @brief	Draws the scene's sprite renderers seen by @a camera
+		 *
+		 *			Visible sprites are grouped by material and texture, and
+		 *			each group is drawn with a single instanced draw call
+		 */
+        void draw_sprites(Scene&        scene,
+                          const Camera& camera,
+                          const Vec2&   camera_position,
+                          float         max_distance);
+
+        /*!
+		 * @brief	Creates the quad and the instance buffer shared by every
+		 *			sprite batch
+		 */
+        void initialize_sprite_buffers();
+
+        /*!
+		 * @brief	Uploads the vertices of the texts added to @a drawlist with
+		 *			DrawList::add_text, with a single upload for all of them
+		 */
+        void upload_shared_texts(const DrawList& drawlist);
+
         // Member Variables
 
         Matrix _view_matrix;
@@ -199,6 +242,24 @@ namespace corgi
 
         ComponentPool<Transform>* transform_map_ = nullptr;
 
+        float interpolation_alpha_ {1.0f};
+
+        SpriteBatch sprite_batch_;
+
+        // Last ResourcesCache::generation the sprite batches were built with
+        unsigned resources_generation_ {0u};
+
+        unsigned sprite_vao_ {0};
+        unsigned sprite_vbo_ {0};
+        unsigned sprite_ibo_ {0};
+        unsigned sprite_instance_vbo_ {0};
+
+        // Buffers the texts of the draw lists are streamed into
+        unsigned    text_vao_ {0};
+        unsigned    text_vbo_ {0};
+        unsigned    text_ibo_ {0};
+        std::size_t text_quad_capacity_ {0};
+
         Scene* _current_scene {nullptr};
         Window* current_window_ {nullptr};
     };
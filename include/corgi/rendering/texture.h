@@ -2,8 +2,15 @@
 
 #include <corgi/resources/Resource.h>
 
+#include <cstddef>
+#include <span>
 #include <string>
 
+namespace corgi::filesystem
+{
+class VirtualFileSystem;
+}
+
 namespace corgi
 {
 class Image;
@@ -106,6 +113,12 @@ public:
 		 */
     Texture(const std::string& path, const std::string& relative_path);
 
+    /*!
+		 * @brief	Construct a texture from the .tex file @a identifier of a mounted
+		 *			pack. The pixels are uploaded straight from the pack's mapping
+		 */
+    Texture(const filesystem::VirtualFileSystem& vfs, const std::string& identifier);
+
     /*!
 		 * @brief	Generates a new texture
 		 *			Copies the name
@@ -122,6 +135,22 @@ public:
             DataType           dt,
             unsigned char*     data = nullptr);
 
+    /*!
+		 * @brief	Creates a view on the @a width * @a height rectangle of @a page
+		 *			starting at @a x, @a y
+		 *
+		 *			The view doesn't own any OpenGL object, it is drawn with its
+		 *			page's texture object so sprites using different regions of
+		 *			the same atlas page can share a draw call. width() and height()
+		 *			return the size of the region
+		 */
+    Texture(const std::string& name,
+            const Texture&     page,
+            unsigned           x,
+            unsigned           y,
+            unsigned           width,
+            unsigned           height);
+
     Texture(Texture&& texture) noexcept;
     Texture(const Texture& texture) = delete;
 
@@ -149,6 +178,9 @@ public:
     /*!
 		 *	@brief	Returns the texture's the number returned by the GPU to 
 		 *			identify the current Texture
+		 *
+		 *			Regions return their page's, so they follow it when it's
+		 *			reloaded
 		 */
     [[nodiscard]] unsigned int id() const noexcept;
 
@@ -185,6 +217,25 @@ public:
     [[nodiscard]] unsigned width() const noexcept;
     [[nodiscard]] unsigned height() const noexcept;
 
+    /*!
+		 * @brief	Returns the texture actually bound when drawing this one
+		 *
+		 *			That's the atlas page for a region, the texture itself otherwise
+		 */
+    [[nodiscard]] const Texture& page() const noexcept;
+
+    /*!
+		 * @brief	Returns true if the texture is a region of an atlas page
+		 */
+    [[nodiscard]] bool is_region() const noexcept;
+
+    /*!
+		 * @brief	Position of the texture inside its page, in pixels. Always 0
+		 *			when the texture isn't a region
+		 */
+    [[nodiscard]] unsigned page_x() const noexcept;
+    [[nodiscard]] unsigned page_y() const noexcept;
+
     void width(unsigned width) noexcept;
     void height(unsigned height) noexcept;
 
@@ -267,10 +318,27 @@ public:
     void apply_changes();
     void unpack_pixels();
 
+    /*!
+		 * @brief	Replaces the texture object with one created from the
+		 *			content of a .tex file and its .img file, keeping the
+		 *			Texture itself so the pointers to it stay valid
+		 *
+		 * @return	Returns false if @a description can't be parsed, if @a image
+		 *			is truncated or isn't a valid compressed image, or if the
+		 *			texture is a region. The texture is left untouched then
+		 */
+    bool reload(std::span<const std::byte> description, std::span<const std::byte> image);
+
     /*  void tex_sub_image(int mipmap_level, int x, int y, int width, int height,
 						   Image::Format, void * pixels);*/
 
 private:
+    /*!
+		 * @brief	Creates the texture object from the content of a .tex file and
+		 *			its .img file
+		 */
+    void load(std::span<const std::byte> description, std::span<const std::byte> image);
+
     // Variables
 
     std::string name_;
@@ -289,6 +357,13 @@ private:
     unsigned _width  = 0u;    // 4 bytes
     unsigned _height = 0u;    // 4 bytes
 
-    // Total size : 20 bytes
+    // What the pixels take on the GPU, every mip level included
+    std::size_t pixels_size_ {0u};
+
+    // Non owning pointer to the atlas page, only set for regions
+    const Texture* page_ {nullptr};
+
+    unsigned page_x_ = 0u;
+    unsigned page_y_ = 0u;
 };
 }    // namespace corgi
@@ -5,6 +5,7 @@
 
 #include <map>
 #include <memory>
+#include <string>
 #include <vector>
 
 namespace corgi
@@ -57,7 +58,11 @@ public:
         Light,
         Mono,
         LCD,
-        LCD_V
+        LCD_V,
+
+        // Signed distance field rendered at a reference size and drawn at
+        // any size, see add_distance_field
+        DistanceField
     };
 
     struct Configuration
@@ -74,9 +79,43 @@ public:
         // We're using void* instead of hb_font_t here just to avoid
         // including harfbuzz headers here
         void* hb_font;
+
+        // How far the distance field goes around the glyphs, in pixels at
+        // this configuration's size. 0 for bitmap configurations
+        int spread {0};
     };
 
+    /*!
+     * @brief   Adds a configuration storing the distance field of every glyph,
+     *          rendered once at @a reference_size pixels
+     *
+     *          A FontView asking for a size no bitmap configuration has uses
+     *          it, scaled to that size, so a single configuration serves every
+     *          size, zoom and scale animation. It's drawn with the
+     *          unlit_distance_field_text material, which keeps edges crisp when
+     *          scaled. The glyphs are generated from the .ttf file next to the
+     *          .fnt file
+     *
+     * @param spread    How far the field goes around the glyphs, in pixels at
+     *                  @a reference_size. Also limits how thin the text can get
+     *                  once scaled down, and the size of outlines or glows
+     *
+     * @return  Returns the new configuration, or the existing distance field
+     *          configuration if the font already had one
+     */
+    const Configuration& add_distance_field(int reference_size = 48, int spread = 6);
+
+    /*!
+     * @brief   Returns the distance field configuration, nullptr if the font
+     *          doesn't have any
+     */
+    [[nodiscard]] const Configuration* distance_field() const;
+
     std::vector<std::unique_ptr<Configuration>> configurations_;
     int                                         current_configuration_index_ {0};
+
+private:
+    // Used to render the glyphs of the distance field configuration
+    std::string ttf_path_;
 };
 }    // namespace corgi
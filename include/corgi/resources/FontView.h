@@ -59,12 +59,30 @@ namespace corgi
 
         [[nodiscard]] Font::RenderingMode rendering_mode() const;
 
+        /**
+         * @brief   Returns how much the glyphs of the current configuration
+         *          are scaled to reach the requested size
+         *
+         *          Only distance field configurations are scaled, the others
+         *          return 1
+         */
+        [[nodiscard]] float scale() const;
+
+        /**
+         * @brief   Uses the configuration with the given size and rendering mode
+         *
+         *          When the font has none, but has a distance field
+         *          configuration, that one is used and scaled to @a size
+         */
         void set(int                 size,
                  Font::RenderingMode rendering_mode = Font::RenderingMode::Normal);
 
         const Font* font_ {nullptr};
         int         current_configuration_index_ {0};
 
+        // Size asked for with set, 0 to use the configuration's size
+        int size_ {0};
+
     private:
         void check_errors() const;
     };
@@ -72,5 +72,15 @@ namespace corgi
          * @brief x offset of glyph in texture coordinates
          */
         float tx {0.0f};
+
+        /**
+         * @brief   Distance between the glyph's top and the top of the texture,
+         *          in texture coordinates
+         *
+         *          Glyphs are stored upside down. The .fnt files put every glyph
+         *          on a single row, against the top of the texture, and don't
+         *          store this value
+         */
+        float ty {0.0f};
     };
 };    // namespace corgi
\ No newline at end of file
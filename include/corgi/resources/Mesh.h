@@ -4,12 +4,18 @@
 #include <corgi/math/Vec3.h>
 #include <corgi/resources/Resource.h>
 
+#include <cstddef>
 #include <string>
 #include <vector>
 #include <memory>
 
 namespace corgi
 {
+    namespace math
+    {
+        class TriangleBvh;
+    }
+
     enum class PrimitiveType : char
     {
         Triangles,
@@ -109,6 +115,17 @@ namespace corgi
 
         void build_bounding_volumes();
 
+        /*!
+         * @brief   Returns the BVH built over the mesh's triangles, in local
+         *          space. Used to raycast against the mesh
+         *
+         *          The tree is built by the first call, and built again if the
+         *          mesh changed since (update_vertices, clear, set_vertices and
+         *          set_indices invalidate it). Since meshes are shared, every
+         *          collider using the same mesh also shares the tree
+         */
+        const math::TriangleBvh& bvh();
+
         struct BoundingBox
         {
             float bottom_left_x {std::numeric_limits<float>::infinity()};
@@ -162,6 +179,26 @@ namespace corgi
 
         void update_vertices_really();
 
+        /*!
+         * @brief   Allocates GPU buffers holding up to @a vertex_capacity floats
+         *          and @a index_capacity indexes, and uploads the mesh into them
+         *
+         *          Meshes changing every frame keep those buffers afterwards,
+         *          and only upload what changed with update_vertices(first, count),
+         *          as long as they fit inside
+         */
+        void reserve(std::size_t vertex_capacity, std::size_t index_capacity);
+
+        /*!
+         * @brief   Uploads the @a count floats of the vertices starting at
+         *          @a first, inside the buffers allocated by reserve
+         */
+        void update_vertices(std::size_t first, std::size_t count);
+
+        // Floats and indexes the GPU buffers can hold
+        [[nodiscard]] std::size_t vertex_capacity() const noexcept { return vertex_capacity_; }
+        [[nodiscard]] std::size_t index_capacity() const noexcept { return index_capacity_; }
+
         // Returns the mesh's vertices
         [[nodiscard]] const std::vector<float>& vertices() const;
 
@@ -200,5 +237,13 @@ namespace corgi
 
         // Primitive used for rendering. Can be TRIANGLES, QUADS or other things
         PrimitiveType _primitive_type;    // 57 bytes (so 60 total)
+
+        // Floats and indexes the GPU buffers can hold
+        std::size_t vertex_capacity_ = 0;
+        std::size_t index_capacity_  = 0;
+
+        // Built on demand, most meshes are never raycasted
+        std::unique_ptr<math::TriangleBvh> _bvh;
+        bool                               _bvh_dirty = true;
     };
 }    // namespace corgi
@@ -1,11 +1,47 @@
 #pragma once
 
+#include <atomic>
+#include <cstdint>
+
 namespace corgi
 {
 struct Resource
 {
+    Resource() noexcept
+        : serial_(next_serial())
+    {
+    }
+
+    // A copy is another resource, and a resource something else is assigned
+    // to isn't the same one anymore, so both get a new serial
+    Resource(const Resource&) noexcept
+        : serial_(next_serial())
+    {
+    }
+
+    Resource& operator=(const Resource&) noexcept
+    {
+        serial_ = next_serial();
+        return *this;
+    }
+
     virtual ~Resource() {}
 
     [[nodiscard]] virtual long long memory_usage() const { return 0; }
+
+    /*!
+     * @brief   Identifies the resource. Unlike its address, a serial is never
+     *          given to another resource, even once this one is destroyed
+     */
+    [[nodiscard]] std::uint64_t serial() const noexcept { return serial_; }
+
+private:
+    static std::uint64_t next_serial() noexcept
+    {
+        static std::atomic<std::uint64_t> serial {1u};
+        return serial.fetch_add(1u, std::memory_order_relaxed);
+    }
+
+    std::uint64_t serial_;
 };
 }    // namespace corgi
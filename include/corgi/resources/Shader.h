@@ -3,6 +3,12 @@
 #include <corgi/resources/Resource.h>
 
 #include <string>
+#include <string_view>
+
+namespace corgi::filesystem
+{
+class VirtualFileSystem;
+}
 
 namespace corgi
 {
@@ -21,6 +27,11 @@ public:
     // Lifecycle
 
     Shader(const std::string& path, const std::string& identifier);
+
+    /*!
+     * @brief   Compiles the shader @a identifier of a mounted pack
+     */
+    Shader(const filesystem::VirtualFileSystem& vfs, const std::string& identifier);
     ~Shader() override;
 
     Shader(const Shader& other) = delete;
@@ -39,7 +50,25 @@ public:
 
     [[nodiscard]] long long memory_usage() const override;
 
+    /*!
+     * @brief   Compiles @a code into a new shader object, replacing the
+     *          current one if it succeeds
+     *
+     *          Programs using the shader must be relinked afterward, see
+     *          ShaderProgram::relink
+     *
+     * @return  Returns false if @a code doesn't compile. The shader keeps its
+     *          previous object then
+     */
+    bool reload(const std::string& identifier, std::string_view code);
+
 private:
+    /*!
+     * @brief   Compiles @a code. The shader's type is deduced from @a path,
+     *          which must contain "_vs" or "_fs"
+     */
+    void compile(const std::string& path, std::string_view code);
+
     unsigned          id_;
     const std::string source_;
     const std::string name_;
@@ -2,6 +2,9 @@
 
 #include <corgi/resources/Resource.h>
 
+#include <cstdint>
+#include <memory>
+#include <span>
 #include <string>
 #include <vector>
 namespace corgi
@@ -127,6 +130,67 @@ public:
 
     Tilemap() = default;
 
+    /*!
+     * @brief   Tile ids of a layer, flip flags included
+     *
+     *          When the tilemap is loaded from the binary format, the ids
+     *          aren't copied : the TileData points inside the mapped file,
+     *          which stays mapped as long as a TileData uses it. The ids are
+     *          only copied the first time one of them is modified
+     */
+    class TileData
+    {
+    public:
+        // Lifecycle
+
+        TileData() = default;
+
+        explicit TileData(std::vector<std::uint32_t> tiles);
+
+        /*!
+         * @param owner Keeps the memory @a tiles points to alive
+         */
+        TileData(std::span<const std::uint32_t> tiles, std::shared_ptr<const void> owner);
+
+        TileData(const TileData& other);
+        TileData(TileData&& other) noexcept;
+
+        TileData& operator=(const TileData& other);
+        TileData& operator=(TileData&& other) noexcept;
+
+        ~TileData() = default;
+
+        // Functions
+
+        [[nodiscard]] std::uint32_t operator[](std::size_t index) const noexcept
+        {
+            return view_[index];
+        }
+
+        void set(std::size_t index, std::uint32_t tile);
+
+        [[nodiscard]] std::size_t size() const noexcept { return view_.size(); }
+        [[nodiscard]] bool        empty() const noexcept { return view_.empty(); }
+
+        [[nodiscard]] const std::uint32_t* begin() const noexcept { return view_.data(); }
+        [[nodiscard]] const std::uint32_t* end() const noexcept
+        {
+            return view_.data() + view_.size();
+        }
+
+        [[nodiscard]] std::span<const std::uint32_t> span() const noexcept { return view_; }
+
+        /*!
+         * @brief   Returns true if the ids still point inside a mapped file
+         */
+        [[nodiscard]] bool is_mapped() const noexcept { return owner_ != nullptr; }
+
+    private:
+        std::span<const std::uint32_t> view_;
+        std::vector<std::uint32_t>     tiles_;
+        std::shared_ptr<const void>    owner_;
+    };
+
     struct Object
     {
         Object() = default;
@@ -185,10 +249,9 @@ public:
         TileLayer(std::fstream& file);
         float height {0.0f};
         float width {0.0f};
-        // Tiles are apparently stored as long long
-        // though tiles can encode it differently or even
-        // compress it but that'll do for now
-        std::vector<long long> data;
+        // Tiled's global ids only use 32 bits, the 3 highest ones being the
+        // flip flags
+        TileData data;
     };
 
     struct TerrainInfo
@@ -224,8 +287,39 @@ public:
         std::vector<TileAnimation> animations;
     };
 
+    /*!
+     * @brief   What we need to know about a tile when generating a tilemap,
+     *          without having to search TilesetInfo::tiles
+     */
+    struct TileLookup
+    {
+        // Index of the tile's TileInfo inside TilesetInfo::tiles, -1 if the
+        // tile doesn't have one
+        std::int32_t info {-1};
+
+        // Index inside Tilemap::animations, -1 if the tile isn't animated
+        std::int32_t animation {-1};
+    };
+
+    struct AnimationInfo
+    {
+        int tileset {0};
+
+        // Index of the animated tile's TileInfo inside TilesetInfo::tiles
+        int info {0};
+
+        // Sum of the frame durations, in milliseconds
+        int duration {0};
+    };
+
     struct TilesetInfo
     {
+        /*!
+         * @brief   Returns the lookup entry of a tile, @a tile_id being the id
+         *          of the tile inside the tileset
+         */
+        [[nodiscard]] const TileLookup& lookup(long long tile_id) const noexcept;
+
         int      firstgid {0};
         int      columns {0};
         int      image_height {0};
@@ -242,12 +336,57 @@ public:
 
         std::vector<TerrainInfo> terrains;
         std::vector<TileInfo>    tiles;
+
+        // Indexed by the tile's id, built by Tilemap::build_lookup_tables
+        std::vector<TileLookup> lookups;
     };
 
     // Lifecycle
 
+    /*!
+     * @brief   Loads the tilemap located at @a path
+     *
+     *          Files starting with binary_magic are mapped in memory, and the
+     *          tile layers point inside the mapping. Otherwise the file is
+     *          read with the older, field by field, format
+     */
     Tilemap(const std::string& path, const std::string& identifier);
 
+    /*!
+     * @brief   "CTMB", written at the beginning of the binary format
+     */
+    static constexpr char          binary_magic[4] = {'C', 'T', 'M', 'B'};
+    static constexpr std::uint32_t binary_version  = 1;
+
+    /*!
+     * @brief   Writes the tilemap with the binary format
+     *
+     *          Every section of the file, and the tile ids of every layer,
+     *          start on a 64 bytes boundary so they can be used straight from
+     *          the mapped file. Strings are only written once, inside a
+     *          string table
+     */
+    void save(const std::string& path) const;
+
+    // Functions
+
+    /*!
+     * @brief   Builds the dense tables used to find the tileset and the
+     *          TileInfo of a tile in constant time
+     *
+     *          Called once the tilemap is loaded. Must be called again if the
+     *          tilesets are modified afterward
+     */
+    void build_lookup_tables();
+
+    /*!
+     * @brief   Returns the index of the tileset a global tile id (without its
+     *          flip flags) belongs to, or -1 if no tileset contains it
+     */
+    [[nodiscard]] int tileset_index(long long gid) const noexcept;
+
+    [[nodiscard]] long long memory_usage() const override;
+
     std::string identifier;
 
     int   height {0};
@@ -267,5 +406,15 @@ public:
     std::vector<TilesetInfo> tileset_infos;
     std::vector<TileLayer>   tile_layers;
     std::vector<ObjectGroup> object_groups;
+
+    // Every animated tile of every tileset
+    std::vector<AnimationInfo> animations;
+
+private:
+    void load_binary(const std::string& path);
+    void load_legacy(const std::string& path);
+
+    // Indexed by global tile id. Ids past the end belong to the last tileset
+    std::vector<std::int32_t> gid_to_tileset_;
 };
 }    // namespace corgi
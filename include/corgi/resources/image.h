@@ -23,9 +23,15 @@ namespace corgi
 
         // Creates an empty Image with the parameters given
         Image(int width, int height, int channel);
+
+        // Takes ownership of @a data, which must come from StagingPool::shared(),
+        // like the images decoded by stb_image
         Image(int width, int height, int channel, Byte* data);
         Image(const char* img);
 
+        Image(const Image& other)            = delete;
+        Image& operator=(const Image& other) = delete;
+
         ~Image();
         
         Byte* pixels()const;
@@ -53,7 +53,7 @@ public:
 
             const auto e = animators_.entity_id(i);
 
-            auto& entity = Game::instance().scene().entity_contiguous()[e.id_];
+            auto& entity = Game::instance().scene().entities()[e.id_];
 
             update_scaling_animation(animator, entity);
 
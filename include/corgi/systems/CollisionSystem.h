@@ -2,6 +2,9 @@
 
 #include <corgi/ecs/System.h>
 #include <corgi/ecs/ComponentPool.h>
+#include <corgi/math/Collisions.h>
+#include <corgi/math/Vec2.h>
+#include <corgi/utils/Event.h>
 
 #include <vector>
 
@@ -20,6 +23,10 @@ namespace corgi
 		EntityId entity_a;
 		EntityId entity_b;
 		bool is_2D{ true };
+
+		// Smallest translation to apply to entity_a so it doesn't
+		// collide with entity_b anymore
+		Vec2 minimum_translation;
 	};
 
 	// Check the collisions for every collider in the game, and fire their callbacks
@@ -42,6 +49,50 @@ namespace corgi
 
 	private:
 
+		enum class CollisionCallback : char
+		{
+			Enter,
+			Stay,
+			Exit
+		};
+
+		/*!
+		 * @brief	Invokes the on_enter/on_collision/on_exit events of the
+		 *			collider owned by @a entity_a
+		 *
+		 *			Colliders are fetched again from their entity ids because
+		 *			a previous callback could have modified the pool
+		 */
+		void invoke_callback(EntityId entity_a, EntityId entity_b, CollisionCallback callback);
+
+		/*!
+		 * @brief	Everything the narrow phase needs to know about a 2D
+		 *			collider, computed once per frame
+		 */
+		struct WorldCollider2D
+		{
+			math::OrientedBox2D box;
+			EntityId			entity;
+			int					layer;
+			bool				enabled;
+		};
+
+		/*!
+		 * @brief	Transforms every 2D collider in world space
+		 *
+		 *			Stored in the same order as the collider pool, so the
+		 *			narrow phase never has to look up an entity or a transform
+		 */
+		void update_world_colliders();
+
+		std::vector<WorldCollider2D> _world_colliders;
+
+		// The narrow phase only records which callbacks must be invoked.
+		// They are all invoked once every pair has been tested, so callbacks
+		// can freely add or remove colliders, and the narrow phase could be
+		// split between threads (each one filling its own queue)
+		EventQueue<EntityId, EntityId, CollisionCallback> _pending_callbacks;
+
 		std::vector<Collision> _collisions;
 		std::vector<Collision> _enter_collisions;
 		std::vector<Collision> _exit_collisions;
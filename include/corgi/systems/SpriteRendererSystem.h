@@ -24,5 +24,9 @@ namespace corgi
         void before_update(float elapsed_time) override;
 
         Scene& _scene;
+
+    private:
+        // Last ResourcesCache::generation the sprites were checked against
+        unsigned resources_generation_ {0u};
     };
 }
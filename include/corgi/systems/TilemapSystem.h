@@ -0,0 +1,26 @@
+#pragma once
+
+#include <corgi/ecs/Scene.h>
+#include <corgi/ecs/System.h>
+
+namespace corgi
+{
+/*!
+ * @brief   Streams the chunks of the TilemapRenderer components around the
+ *          orthographic cameras of the scene, rebuilds the chunks whose
+ *          tiles or tileset textures changed and animates the tiles
+ */
+class TilemapSystem : public AbstractSystem
+{
+public:
+    TilemapSystem(Scene& scene);
+
+    void before_update(float elapsed_time) override;
+
+    Scene& _scene;
+
+private:
+    // Last ResourcesCache::generation the tilesets were checked against
+    unsigned resources_generation_ {0u};
+};
+}    // namespace corgi
@@ -3,6 +3,7 @@
 #include <corgi/containers/Node.h>
 #include <corgi/ecs/System.h>
 #include <corgi/inputs/Inputs.h>
+#include <corgi/ui/HitTestIndex.h>
 #include <corgi/ui/Widget.h>
 
 #include <chrono>
@@ -74,22 +75,22 @@ namespace corgi
         [[nodiscard]] bool checkRightEdge(const ui::Widget& widget) const noexcept;
 
     protected:
-        void handleMouseEnter(float elapsedTime, NodeWidget& node);
-        void handleMouseExit(float elapsedTime, NodeWidget& nodeWidget);
-        void handleMouseButtonDown(float elapsedTime, NodeWidget& nodeWidget);
-        void handleMouseButtonUp(float elapsedTime, NodeWidget& nodeWidget);
-        void handleWheelEvent(float elapsedTime, NodeWidget& nodeWidget);
-        void handleMouseClick(float elapsedTime, NodeWidget& nodeWidget);
+        void handleMouseEnter();
+        void handleMouseExit();
+        void handleMouseButtonDown(float elapsedTime);
+        void handleMouseButtonUp();
+        void handleWheelEvent();
+        void handleMouseClick();
 
         /**
          * @brief Internally handles the mouse over event
          */
-        void handle_mouse_over(float elapsedTime, NodeWidget& nodeWidget);
+        void handle_mouse_over();
 
         /**
          * @brief Internally handles the mouse_drag_event, mouse_drag_start_event and mouse_drag_end_event
          */
-        void handle_drag_event(float elapsed_time, NodeWidget& node_widget);
+        void handle_drag_event();
 
         /**
          * @brief   Resizes a Widget the user is currently editing
@@ -122,6 +123,28 @@ namespace corgi
 
         std::vector<ui::Widget*> pushed_widgets_;
 
+        /**
+         * @brief   Rebuilt at the beginning of every update, used to find
+         *          the widgets under the mouse cursor
+         */
+        ui::HitTestIndex hit_test_index_;
+
+        /**
+         * @brief   Widgets under the mouse cursor for the current frame
+         */
+        std::vector<ui::Widget*> hovered_widgets_;
+
+        /**
+         * @brief   Widgets that could trigger a mouse exit event this frame
+         */
+        std::vector<ui::Widget*> exit_candidates_;
+
+        /**
+         * @brief   hovered_widgets_ sorted by address, so exit candidates
+         *          are looked up with a binary search
+         */
+        std::vector<ui::Widget*> sorted_hovered_widgets_;
+
         /**
          * @brief   Search for widget marked for destruction
          * 
@@ -0,0 +1,222 @@
+#pragma once
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+namespace corgi
+{
+	/*!
+	 * @brief	Places rectangles inside a single bin with the MaxRects algorithm
+	 *
+	 *			The bin keeps every maximal free rectangle, possibly overlapping
+	 *			each other, and puts a new rectangle where it leaves the shortest
+	 *			leftover side (Best Short Side Fit). Rectangles are never rotated
+	 */
+	class MaxRects
+	{
+	public:
+
+		struct Rect
+		{
+			unsigned x		{0u};
+			unsigned y		{0u};
+			unsigned width	{0u};
+			unsigned height	{0u};
+		};
+
+	// Lifecycle
+
+		MaxRects(unsigned width, unsigned height);
+
+	// Functions
+
+		/*!
+		 * @brief	Tries to place a @a width * @a height rectangle inside the bin
+		 *
+		 * @return	Returns false if the rectangle doesn't fit, @a result is left
+		 *			untouched in that case
+		 */
+		bool insert(unsigned width, unsigned height, Rect& result);
+
+	// Accessors
+
+		[[nodiscard]] unsigned width()const noexcept { return width_; }
+		[[nodiscard]] unsigned height()const noexcept { return height_; }
+
+		/*!
+		 * @brief	Returns the area covered by the inserted rectangles
+		 */
+		[[nodiscard]] std::size_t used_area()const noexcept { return used_area_; }
+
+		/*!
+		 * @brief	Returns the smallest width and height containing every
+		 *			inserted rectangle
+		 */
+		[[nodiscard]] unsigned used_width()const noexcept { return used_width_; }
+		[[nodiscard]] unsigned used_height()const noexcept { return used_height_; }
+
+	private:
+
+		void split(const Rect& used);
+		void prune();
+
+		std::vector<Rect> free_;
+		std::vector<Rect> new_free_;
+
+		unsigned	width_;
+		unsigned	height_;
+		unsigned	used_width_		{0u};
+		unsigned	used_height_	{0u};
+		std::size_t	used_area_		{0u};
+	};
+
+	/*!
+	 * @brief	Packs images into a few large atlas pages, offline
+	 *
+	 *			Images are packed by group, a page only ever containing images
+	 *			of the same group. Every image is surrounded by @a extrude pixels
+	 *			copied from its borders, so linear filtering and rounding don't
+	 *			bleed the neighbouring images in, and by @a padding empty pixels
+	 *
+	 *			The packer writes the pages as regular .tex/.img pairs, and an
+	 *			atlas manifest telling the ResourcesCache where every packed
+	 *			image ended up
+	 */
+	class AtlasPacker
+	{
+	public:
+
+		struct Settings
+		{
+			unsigned page_width		{2048u};
+			unsigned page_height	{2048u};
+			unsigned padding		{2u};
+			unsigned extrude		{1u};
+		};
+
+		struct Image
+		{
+			// Identifier the image is requested with, like "sprites/hero.tex"
+			std::string name;
+			std::string group;
+
+			unsigned width	{0u};
+			unsigned height	{0u};
+
+			// RGBA, 8 bits per channel, rows in the same order as .img files.
+			// Can be left empty when only the layout is needed
+			std::vector<unsigned char> pixels;
+
+			// Filters written in the page's .tex file
+			std::string min_filter {"nearest"};
+			std::string mag_filter {"nearest"};
+		};
+
+		struct Placement
+		{
+			std::size_t		image;	// Index inside images()
+			MaxRects::Rect	rect;	// Where the image is, without extrusion
+		};
+
+		struct Page
+		{
+			std::string				group;
+			unsigned				width	{0u};
+			unsigned				height	{0u};
+			std::size_t				used_area {0u};
+			std::vector<Placement>	placements;
+		};
+
+		struct Report
+		{
+			std::size_t image_count	{0u};
+			std::size_t page_count	{0u};
+
+			// Pixels covered by the images themselves, and by the pages
+			std::size_t image_area	{0u};
+			std::size_t page_area	{0u};
+
+			/*!
+			 * @brief	Returns the fraction of the pages' pixels actually used
+			 *			by images
+			 */
+			[[nodiscard]] float efficiency()const noexcept;
+		};
+
+	// Lifecycle
+
+		AtlasPacker() = default;
+		explicit AtlasPacker(Settings settings);
+
+	// Functions
+
+		void add(Image image);
+
+		/*!
+		 * @brief	Packs every added image, replacing the previous pages
+		 *
+		 *			Images are inserted from the tallest to the shortest, in the
+		 *			first page of their group with enough room. Pages are then
+		 *			shrunk to the smallest power of two size their images fit in
+		 *
+		 * @return	Returns false if an image is too big to fit an empty page.
+		 *			That image is left out, the others are still packed
+		 */
+		bool pack();
+
+		/*!
+		 * @brief	Returns the pixels of page @a index, RGBA, with every image
+		 *			copied and extruded
+		 */
+		[[nodiscard]] std::vector<unsigned char> compose(std::size_t index)const;
+
+		/*!
+		 * @brief	Writes every page and the manifest inside @a directory
+		 *
+		 *			Pages are written as "atlases/<group>_<index>.tex/.img" and the
+		 *			manifest as "atlas.manifest", so @a directory can directly be
+		 *			used as a resource directory
+		 *
+		 * @return	Returns false if a file couldn't be written
+		 */
+		bool write(const std::string& directory)const;
+
+		/*!
+		 * @brief	Returns the identifier of page @a index, relative to the
+		 *			directory given to write()
+		 */
+		[[nodiscard]] std::string page_name(std::size_t index)const;
+
+		/*!
+		 * @brief	Summarizes how well the images were packed
+		 */
+		[[nodiscard]] Report report()const;
+
+	// Accessors
+
+		[[nodiscard]] const Settings& settings()const noexcept { return settings_; }
+		[[nodiscard]] const std::vector<Image>& images()const noexcept { return images_; }
+		[[nodiscard]] const std::vector<Page>& pages()const noexcept { return pages_; }
+
+		static inline const char* manifest_name = "atlas.manifest";
+
+	private:
+
+		/*!
+		 * @brief	Places every image of @a page again inside a @a width *
+		 *			@a height page. @a page is left untouched if they don't fit
+		 */
+		bool place(Page& page, unsigned width, unsigned height)const;
+
+		/*!
+		 * @brief	Resizes @a page to the smallest power of two size its
+		 *			images fit in
+		 */
+		void shrink(Page& page)const;
+
+		Settings			settings_;
+		std::vector<Image>	images_;
+		std::vector<Page>	pages_;
+	};
+}
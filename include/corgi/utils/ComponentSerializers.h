@@ -0,0 +1,14 @@
+#pragma once
+
+namespace corgi
+{
+    /*!
+	 * @brief	Registers the engine's components inside the ComponentRegistry
+	 *			so they are saved in scene snapshots
+	 *
+	 *			Transform and SpriteRenderer aren't trivially copyable, they are
+	 *			written field by field and the sprite's texture is stored by name,
+	 *			then loaded back through the ResourcesCache
+	 */
+    void register_component_serializers();
+}    // namespace corgi
@@ -0,0 +1,184 @@
+#pragma once
+
+#include <cstddef>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+namespace corgi
+{
+template<class Signature, std::size_t BufferSize = 4 * sizeof(void*)>
+class Delegate;
+
+/**
+ * @brief   Type erased callable, like std::function, but with a guaranteed
+ *          inline storage
+ *
+ *          Callables smaller than BufferSize (a lambda capturing a few
+ *          pointers or references, a function pointer) are stored directly
+ *          inside the delegate, so constructing, copying and invoking the
+ *          delegate never allocates. Bigger callables are stored on the heap.
+ *
+ * @tparam R            Return type of the callable
+ * @tparam Args         Arguments of the callable
+ * @tparam BufferSize   Size in bytes of the inline storage
+ */
+template<class R, class... Args, std::size_t BufferSize>
+class Delegate<R(Args...), BufferSize>
+{
+public:
+    // Lifecycle
+
+    Delegate() noexcept = default;
+
+    template<class F,
+             class = std::enable_if_t<!std::is_same_v<std::decay_t<F>, Delegate> &&
+                                      std::is_invocable_r_v<R, std::decay_t<F>&, Args...>>>
+    Delegate(F&& callable)
+    {
+        using Callable = std::decay_t<F>;
+
+        if constexpr(is_stored_inline<Callable>)
+            ::new(static_cast<void*>(storage_)) Callable(std::forward<F>(callable));
+        else
+            ::new(static_cast<void*>(storage_)) Callable*(new Callable(std::forward<F>(callable)));
+
+        operations_ = &operations_for<Callable>;
+    }
+
+    Delegate(const Delegate& other)
+    {
+        if(other.operations_)
+            other.operations_->copy(storage_, other.storage_);
+        operations_ = other.operations_;
+    }
+
+    Delegate(Delegate&& other) noexcept
+    {
+        if(other.operations_)
+            other.operations_->move(storage_, other.storage_);
+        operations_       = other.operations_;
+        other.operations_ = nullptr;
+    }
+
+    Delegate& operator=(const Delegate& other)
+    {
+        if(this != &other)
+        {
+            Delegate copy(other);
+            *this = std::move(copy);
+        }
+        return *this;
+    }
+
+    Delegate& operator=(Delegate&& other) noexcept
+    {
+        if(this != &other)
+        {
+            reset();
+
+            if(other.operations_)
+                other.operations_->move(storage_, other.storage_);
+            operations_       = other.operations_;
+            other.operations_ = nullptr;
+        }
+        return *this;
+    }
+
+    ~Delegate() { reset(); }
+
+    // Functions
+
+    R operator()(Args... args) const
+    {
+        return operations_->invoke(const_cast<unsigned char*>(storage_),
+                                   std::forward<Args>(args)...);
+    }
+
+    [[nodiscard]] explicit operator bool() const noexcept { return operations_ != nullptr; }
+
+    /**
+     * @brief   Destroys the stored callable, if any
+     */
+    void reset() noexcept
+    {
+        if(operations_)
+        {
+            operations_->destroy(storage_);
+            operations_ = nullptr;
+        }
+    }
+
+    /**
+     * @brief   Returns true if a callable of type F would be stored without
+     *          any allocation
+     */
+    template<class F>
+    static constexpr bool is_stored_inline =
+        sizeof(F) <= BufferSize && alignof(F) <= alignof(std::max_align_t) &&
+        std::is_nothrow_move_constructible_v<F>;
+
+private:
+    /**
+     * @brief   We use a table of function pointers instead of virtual functions
+     *          so the delegate doesn't need to allocate a polymorphic object
+     */
+    struct Operations
+    {
+        R (*invoke)(void* storage, Args&&... args);
+        void (*copy)(void* destination, const void* source);
+        void (*move)(void* destination, void* source) noexcept;
+        void (*destroy)(void* storage) noexcept;
+    };
+
+    template<class Callable>
+    static Callable& get(void* storage) noexcept
+    {
+        if constexpr(is_stored_inline<Callable>)
+            return *std::launder(static_cast<Callable*>(storage));
+        else
+            return **std::launder(static_cast<Callable**>(storage));
+    }
+
+    template<class Callable>
+    static constexpr Operations operations_for {
+        [](void* storage, Args&&... args) -> R
+        { return static_cast<R>(get<Callable>(storage)(std::forward<Args>(args)...)); },
+
+        [](void* destination, const void* source)
+        {
+            auto& callable = get<Callable>(const_cast<void*>(source));
+
+            if constexpr(is_stored_inline<Callable>)
+                ::new(destination) Callable(callable);
+            else
+                ::new(destination) Callable*(new Callable(callable));
+        },
+
+        [](void* destination, void* source) noexcept
+        {
+            if constexpr(is_stored_inline<Callable>)
+            {
+                auto& callable = get<Callable>(source);
+                ::new(destination) Callable(std::move(callable));
+                callable.~Callable();
+            }
+            else
+            {
+                // We only have to steal the pointer
+                ::new(destination) Callable*(get<Callable*>(source));
+            }
+        },
+
+        [](void* storage) noexcept
+        {
+            if constexpr(is_stored_inline<Callable>)
+                get<Callable>(storage).~Callable();
+            else
+                delete &get<Callable>(storage);
+        }};
+
+    alignas(std::max_align_t) unsigned char storage_[BufferSize];
+    const Operations* operations_ = nullptr;
+};
+}    // namespace corgi
@@ -0,0 +1,34 @@
+#pragma once
+
+#include <cstdint>
+#include <span>
+#include <vector>
+
+namespace corgi::distance_field
+{
+	/*!
+	 * @brief	Image with a single channel of 8 bits, rows going down
+	 */
+	struct Bitmap
+	{
+		unsigned width	{0u};
+		unsigned height	{0u};
+
+		std::vector<std::uint8_t> pixels;
+	};
+
+	/*!
+	 * @brief	Returns the signed distance field of the @a width * @a height
+	 *			coverage bitmap @a coverage, like a glyph rendered by FreeType,
+	 *			grown by @a spread pixels on every side
+	 *
+	 *			A pixel stores 128 on the outline, rising to 255 @a spread pixels
+	 *			inside the shape and falling to 0 @a spread pixels outside, so
+	 *			the outline can be found again at any scale by thresholding the
+	 *			bilinearly filtered field. Distances are exact euclidean distances
+	 *			(Felzenszwalb and Huttenlocher), the partially covered pixels
+	 *			moving the outline by less than a pixel
+	 */
+	[[nodiscard]] Bitmap generate(std::span<const std::uint8_t> coverage, unsigned width,
+								  unsigned height, unsigned spread);
+}
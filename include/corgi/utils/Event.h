@@ -1,45 +1,392 @@
 #pragma once
 
-#include <functional>
-#include <map>
+#include <corgi/utils/Delegate.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <tuple>
+#include <utility>
+#include <vector>
 
 namespace corgi
 {
+/**
+ * @brief   Handle returned when adding a callback to an Event. Used to
+ *          remove the callback later on
+ *
+ *          The generation makes sure an old handle can't remove a callback
+ *          that was added after the one it referred to was removed
+ */
+struct EventHandle
+{
+    static constexpr std::uint32_t invalid = std::numeric_limits<std::uint32_t>::max();
+
+    std::uint32_t index      = invalid;
+    std::uint32_t generation = 0;
+
+    [[nodiscard]] bool is_valid() const noexcept { return index != invalid; }
+};
+
 template<class... Args>
 class Event
 {
 public:
+    using Callback = Delegate<void(Args...)>;
+
+    // Lifecycle
+
+    Event() = default;
+
+    Event(const Event& other)
+        : storage_(copy_storage(other))
+    {
+    }
+
+    Event(Event&& other) noexcept = default;
+
+    Event& operator=(const Event& other)
+    {
+        if(this != &other)
+            storage_ = copy_storage(other);
+        return *this;
+    }
+
+    Event& operator=(Event&& other) noexcept = default;
+
+    ~Event() = default;
+
     /**
-         * @brief   We return a key that can be used to remove the callback
-         *          from the event in case we need it 
-         * 
-         * @tparam U 
-         * @param callback 
-         * @return int 
+         * @brief   We return a handle that can be used to remove the callback
+         *          from the event in case we need it
+         *
+         *          Callbacks added while the event is being dispatched will
+         *          only be called by the next dispatch
+         *
+         * @tparam U
+         * @param callback
+         * @return EventHandle
          */
     template<class U>
-    int operator+=(U callback)
+    EventHandle operator+=(U&& callback)
     {
-        callbacks_.emplace(key, callback);
-        key++;
-        return key;
+        if(!storage_)
+            storage_ = std::make_unique<Storage>();
+
+        auto&      storage    = *storage_;
+        const auto slot_index = storage.allocate_slot();
+
+        if(storage.dispatching > 0)
+        {
+            // Adding to the callbacks now could reallocate the vector
+            // while one of its callbacks is running
+            storage.slots[slot_index].dense = pending;
+            storage.pending.emplace_back(Callback(std::forward<U>(callback)), slot_index);
+        }
+        else
+        {
+            storage.slots[slot_index].dense =
+                static_cast<std::uint32_t>(storage.callbacks.size());
+            storage.callbacks.emplace_back(std::forward<U>(callback));
+            storage.owners.push_back(slot_index);
+        }
+
+        return {slot_index, storage.slots[slot_index].generation};
     }
 
-    void operator-=(int key) { callbacks_.erase(key); }
+    /**
+         * @brief   Removes the callback. Does nothing if the handle is invalid
+         *          or if the callback was already removed
+         */
+    void operator-=(EventHandle handle)
+    {
+        if(!storage_ || handle.index >= storage_->slots.size())
+            return;
+
+        auto& storage = *storage_;
+        auto& slot    = storage.slots[handle.index];
+
+        if(slot.generation != handle.generation || slot.dense == unused)
+            return;
+
+        if(slot.dense == pending)
+        {
+            for(auto it = storage.pending.begin(); it != storage.pending.end(); ++it)
+            {
+                if(it->second == handle.index)
+                {
+                    storage.pending.erase(it);
+                    break;
+                }
+            }
+        }
+        else if(storage.dispatching > 0)
+        {
+            // We can't move the callbacks around while dispatching, so
+            // we only mark it as removed and compact once we're done
+            storage.owners[slot.dense] = unused;
+            storage.needs_compaction   = true;
+        }
+        else
+        {
+            // We keep the insertion order so callbacks are always
+            // called in the order they were added
+            storage.callbacks.erase(storage.callbacks.begin() + slot.dense);
+            storage.owners.erase(storage.owners.begin() + slot.dense);
+
+            for(auto i = slot.dense; i < storage.owners.size(); ++i)
+                storage.slots[storage.owners[i]].dense = i;
+        }
+
+        storage.release_slot(handle.index);
+    }
 
     void operator()(Args... args)
     {
-        for(auto& callback : callbacks_)
+        if(!storage_)
+            return;
+
+        auto& storage = *storage_;
+        ++storage.dispatching;
+
+        // Callbacks added during the dispatch are stored in the pending
+        // list, so the size can't change while we loop
+        const auto count = storage.callbacks.size();
+
+        for(std::size_t i = 0; i < count; ++i)
+        {
+            if(storage.owners[i] != unused)
+                storage.callbacks[i](args...);
+        }
+
+        if(--storage.dispatching == 0 &&
+           (storage.needs_compaction || !storage.pending.empty()))
+            storage.compact();
+    }
+
+    /**
+         * @brief   Removes every callback
+         */
+    void clear()
+    {
+        if(!storage_)
+            return;
+
+        auto& storage = *storage_;
+
+        for(auto slot : storage.owners)
+            if(slot != unused)
+                storage.release_slot(slot);
+
+        for(auto& [callback, slot] : storage.pending)
+            storage.release_slot(slot);
+
+        storage.pending.clear();
+
+        if(storage.dispatching > 0)
+        {
+            std::fill(storage.owners.begin(), storage.owners.end(), unused);
+            storage.needs_compaction = true;
+        }
+        else
+        {
+            storage.callbacks.clear();
+            storage.owners.clear();
+        }
+    }
+
+    /**
+         * @brief   Returns how many callbacks are connected to the event
+         */
+    [[nodiscard]] std::size_t size() const noexcept
+    {
+        if(!storage_)
+            return 0;
+
+        std::size_t count = storage_->pending.size();
+
+        for(auto slot : storage_->owners)
+            if(slot != unused)
+                count++;
+        return count;
+    }
+
+    [[nodiscard]] bool empty() const noexcept { return size() == 0; }
+
+private:
+    static constexpr std::uint32_t unused  = std::numeric_limits<std::uint32_t>::max();
+    static constexpr std::uint32_t pending = unused - 1;
+
+    struct Slot
+    {
+        // Index of the callback inside callbacks, or unused/pending
+        std::uint32_t dense      = unused;
+        std::uint32_t generation = 0;
+    };
+
+    struct Storage
+    {
+        std::uint32_t allocate_slot()
+        {
+            if(!free_slots.empty())
+            {
+                const auto index = free_slots.back();
+                free_slots.pop_back();
+                return index;
+            }
+
+            slots.emplace_back();
+            return static_cast<std::uint32_t>(slots.size() - 1);
+        }
+
+        void release_slot(std::uint32_t index)
+        {
+            slots[index].dense = unused;
+            slots[index].generation++;
+            free_slots.push_back(index);
+        }
+
+        /**
+         * @brief   Removes the callbacks marked as removed during a dispatch
+         *          and adds the ones that were added during a dispatch
+         */
+        void compact()
+        {
+            std::size_t last = 0;
+
+            for(std::size_t i = 0; i < callbacks.size(); ++i)
+            {
+                if(owners[i] == unused)
+                    continue;
+
+                if(i != last)
+                {
+                    callbacks[last] = std::move(callbacks[i]);
+                    owners[last]    = owners[i];
+                }
+                last++;
+            }
+
+            callbacks.erase(callbacks.begin() + last, callbacks.end());
+            owners.erase(owners.begin() + last, owners.end());
+
+            for(auto& [callback, slot] : pending)
+            {
+                callbacks.push_back(std::move(callback));
+                owners.push_back(slot);
+            }
+            pending.clear();
+
+            for(std::uint32_t i = 0; i < owners.size(); ++i)
+                slots[owners[i]].dense = i;
+
+            needs_compaction = false;
+        }
+
+        // Callbacks are stored contiguously, in the order they were added.
+        // owners[i] is the index of the slot referencing callbacks[i]
+        std::vector<Callback>      callbacks;
+        std::vector<std::uint32_t> owners;
+
+        std::vector<Slot>          slots;
+        std::vector<std::uint32_t> free_slots;
+
+        std::vector<std::pair<Callback, std::uint32_t>> pending;
+
+        int  dispatching      = 0;
+        bool needs_compaction = false;
+    };
+
+    static std::unique_ptr<Storage> copy_storage(const Event& other)
+    {
+        if(!other.storage_)
+            return nullptr;
+
+        auto storage = std::make_unique<Storage>(*other.storage_);
+
+        // The copy isn't being dispatched, even if the original is
+        storage->dispatching = 0;
+
+        if(storage->needs_compaction || !storage->pending.empty())
+            storage->compact();
+
+        return storage;
+    }
+
+    /**
+     * @brief   Most events never get any callback (widgets have plenty of
+     *          them), so the storage is only allocated by the first callback.
+     *          An empty event is just a pointer
+     */
+    std::unique_ptr<Storage> storage_;
+};
+
+/**
+ * @brief   Stores event invocations so they can be dispatched later, in batch
+ *
+ *          Useful when the invocations are gathered somewhere callbacks can't
+ *          be safely run, like a worker thread or a loop iterating over a
+ *          component pool the callbacks could modify. Every thread can fill
+ *          its own queue, then the queues are appended together and
+ *          dispatched on the main thread.
+ *
+ *          The arguments are stored as is, so references must still be valid
+ *          when the queue gets dispatched
+ */
+template<class... Args>
+class EventQueue
+{
+public:
+    template<class... U>
+    void push(U&&... args)
+    {
+        queued_.emplace_back(std::forward<U>(args)...);
+    }
+
+    /**
+     * @brief   Moves the invocations stored in @a other at the end of
+     *          the queue
+     */
+    void append(EventQueue& other)
+    {
+        queued_.insert(queued_.end(), std::make_move_iterator(other.queued_.begin()),
+                       std::make_move_iterator(other.queued_.end()));
+        other.queued_.clear();
+    }
+
+    /**
+     * @brief   Calls @a function for every stored invocation, in the order
+     *          they were pushed, then empties the queue
+     *
+     *          The queue keeps its capacity so filling it again doesn't
+     *          allocate
+     */
+    template<class F>
+    void dispatch(F&& function)
+    {
+        // Callbacks are allowed to push new invocations, which will be
+        // dispatched by this same call
+        for(std::size_t i = 0; i < queued_.size(); ++i)
         {
-            callback.second(std::forward<Args>(args)...);
+            auto arguments = std::move(queued_[i]);
+            std::apply(function, arguments);
         }
+        queued_.clear();
+    }
+
+    void dispatch(Event<Args...>& event)
+    {
+        dispatch([&](auto&&... args) { event(args...); });
     }
-    // TODO : I probably should just use a double array system
-    // with one array storing the functions and the other one the ids
-    // for performance
-    std::map<int, std::function<void(Args...)>> callbacks_;
+
+    void clear() noexcept { queued_.clear(); }
+
+    [[nodiscard]] std::size_t size() const noexcept { return queued_.size(); }
+
+    [[nodiscard]] bool empty() const noexcept { return queued_.empty(); }
 
 private:
-    int key = 0;
+    std::vector<std::tuple<Args...>> queued_;
 };
 }    // namespace corgi
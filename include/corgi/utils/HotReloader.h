@@ -0,0 +1,93 @@
+#pragma once
+
+#include <corgi/filesystem/FileWatcher.h>
+
+#include <atomic>
+#include <cstddef>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace corgi
+{
+/*!
+ * @brief   Watches the resource directories and reads the files that changed
+ *          on a background thread
+ *
+ *          The thread only touches the disk : it turns the changed paths
+ *          into resource identifiers and reads their content. Applying the
+ *          changes needs the OpenGL context and the cache, so it's left to
+ *          the main thread, see ResourcesCache::apply_reloads
+ */
+class HotReloader
+{
+public:
+    /*!
+     * @brief   A resource whose file changed, with the content read from the
+     *          disk
+     */
+    struct Change
+    {
+        std::string            identifier;
+        std::string            path;       // Full path of the resource's file
+        std::vector<std::byte> content;
+        std::vector<std::byte> image;      // Textures only, content of their .img
+    };
+
+    // Lifecycle
+
+    HotReloader() = default;
+    ~HotReloader();
+
+    HotReloader(const HotReloader& other)            = delete;
+    HotReloader& operator=(const HotReloader& other) = delete;
+
+    // Functions
+
+    /*!
+     * @brief   Starts watching @a directories. Like ResourcesCache::find, a
+     *          file hidden by the same file inside a previous directory is
+     *          ignored
+     *
+     * @return  Returns false if files can't be watched on this platform
+     */
+    bool start(const std::vector<std::string>& directories);
+
+    void stop();
+
+    [[nodiscard]] bool is_running() const noexcept { return thread_.joinable(); }
+
+    /*!
+     * @brief   Returns true if changes are waiting to be taken. Doesn't lock
+     *          anything, so it can be checked every frame
+     */
+    [[nodiscard]] bool has_changes() const noexcept { return has_changes_; }
+
+    /*!
+     * @brief   Returns the changes read since the last call, oldest first
+     */
+    [[nodiscard]] std::vector<Change> take_changes();
+
+private:
+    void run(std::stop_token token);
+
+    /*!
+     * @brief   Returns the identifier of the resource stored at @a path, or an
+     *          empty string if it isn't the file ResourcesCache would load
+     */
+    [[nodiscard]] std::string identifier(const std::string& path) const;
+
+    [[nodiscard]] Change read(const std::string& identifier) const;
+
+    std::vector<std::string> directories_;
+    filesystem::FileWatcher  watcher_;
+
+    std::mutex          mutex_;
+    std::vector<Change> changes_;
+    std::atomic<bool>   has_changes_ {false};
+
+    // Declared last so it's joined before the members it uses are destroyed
+    std::jthread thread_;
+};
+}    // namespace corgi
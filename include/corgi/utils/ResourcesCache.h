@@ -1,15 +1,24 @@
 #pragma once
 
+#include <corgi/containers/HashMap.h>
+#include <corgi/ecs/TypeId.h>
+#include <corgi/filesystem/VirtualFileSystem.h>
 #include <corgi/resources/Animation.h>
 #include <corgi/resources/Resource.h>
 
+#include <cstddef>
 #include <map>
 #include <memory>
 #include <string>
+#include <type_traits>
+#include <unordered_map>
 #include <vector>
 
 namespace corgi
 {
+class Texture;
+class HotReloader;
+
 // TODO : Maybe put that everywhere
 
 //template <class T>
@@ -51,16 +60,54 @@ public:
     template<class T>
     [[nodiscard]] static T* get(const std::string& id)
     {
-        if(contains(id))
-            return dynamic_cast<T*>(resources_.at(id).get());
+        auto& typed_resources = resources_of_type<T>();
+
+        if(auto it = typed_resources.find(id); it != typed_resources.end())
+            return static_cast<T*>(it->second);
+
+        // The resource may have been loaded through another type, or added
+        // with ResourcesCache::add
+        if(auto it = resources_.find(id); it != resources_.end())
+        {
+            auto* resource = dynamic_cast<T*>(it->second.get());
+
+            if(resource != nullptr)
+                typed_resources.try_emplace(id, resource);
+            return resource;
+        }
+
+        // Packed images are regions of an atlas page
+        if constexpr(std::is_same_v<T, Texture>)
+        {
+            if(auto* region = find_atlas_region(id); region != nullptr)
+            {
+                typed_resources.try_emplace(id, region);
+                return static_cast<T*>(region);
+            }
+        }
+
+        // Files of the mounted packs are read straight from their mapping,
+        // without looking for them on the disk
+        if constexpr(std::is_constructible_v<T, const filesystem::VirtualFileSystem&,
+                                             const std::string&>)
+        {
+            if(vfs_.contains(id))
+            {
+                auto* resource =
+                    resources_.emplace(id, std::make_unique<T>(vfs_, id)).first->second.get();
+                typed_resources.try_emplace(id, resource);
+                return static_cast<T*>(resource);
+            }
+        }
 
         auto path = find(id);
 
         if(path == "")
             return nullptr;
 
-        return dynamic_cast<T*>(
-            resources_.emplace(id, std::make_unique<T>(path, id)).first->second.get());
+        auto* resource = resources_.emplace(id, std::make_unique<T>(path, id)).first->second.get();
+        typed_resources.try_emplace(id, resource);
+        return static_cast<T*>(resource);
     }
 
     /*!
@@ -95,6 +142,21 @@ public:
 	 */
     [[nodiscard]] static bool is_cached(const std::string& identifier);
 
+    /*!
+	 * @brief	Mounts the pack file located at @a path
+	 *
+	 *			Resources found inside a mounted pack are loaded from it before
+	 *			the resource directories are searched. See PackFile
+	 *
+	 * @return	Returns false if the pack couldn't be opened
+	 */
+    static bool mount(const std::string& path);
+
+    /*!
+	 * @brief	Returns the file system giving access to the mounted packs
+	 */
+    [[nodiscard]] static filesystem::VirtualFileSystem& vfs() noexcept { return vfs_; }
+
     /*!
 	 * @brief 	Returns a reference to the directory list
 	 */
@@ -102,11 +164,15 @@ public:
 
     /*!
 	 * @brief	Returns the sum of every object's size stored by the cache
+	 *
+	 *			Textures count what their pixels take on the GPU, so compressed
+	 *			textures count their compressed size
 	 */
-    [[nodiscard]] static int memory_usage();
+    [[nodiscard]] static long long memory_usage();
 
     /*!
-	 * @brief	Free the cache memory and every loaded resource
+	 * @brief	Free the cache memory and every loaded resource. Increments
+	 *			the generation, so copies of the cleared resources are dropped
 	 */
     static void clear() noexcept;
 
@@ -129,6 +195,76 @@ public:
 	 */
     [[nodiscard]] static std::string find(const std::string& relative_path);
 
+    /*!
+	 * @brief	Loads the atlas manifest @a identifier, written by the atlas packer
+	 *
+	 *			Once loaded, requesting a texture that was packed returns a region
+	 *			of its atlas page instead of loading the original image. The
+	 *			"atlas.manifest" file of the resource directories is loaded
+	 *			automatically the first time a texture is requested
+	 *
+	 * @return	Returns false if the manifest couldn't be found
+	 */
+    static bool load_atlas_manifest(const std::string& identifier);
+
+    /*!
+	 * @brief	Starts watching the resource directories for changes
+	 *
+	 *			Opt-in, meant for content iteration. Once watching, a changed
+	 *			file is read on a background thread, and the resource using it
+	 *			is reloaded in place by the next call to apply_reloads, so the
+	 *			pointers returned by get stay valid. Resources that were never
+	 *			loaded are left alone
+	 *
+	 * @return	Returns false if files can't be watched on this platform
+	 */
+    static bool watch();
+
+    static void unwatch();
+
+    /*!
+	 * @brief	Reloads the resources whose file changed since the last call,
+	 *			then the resources depending on them
+	 *
+	 *			Needs the OpenGL context, and must be called between two frames
+	 *			so a frame never sees half of a reload. Game::run calls it at the
+	 *			beginning of every frame. Does nothing if watch wasn't called
+	 *
+	 * @return	Returns how many resources were reloaded
+	 */
+    static std::size_t apply_reloads();
+
+    /*!
+	 * @brief	Records that the resource @a identifier uses the resource
+	 *			@a dependency, so it's updated when @a dependency is reloaded
+	 *
+	 *			Materials depend on their shaders, atlas regions on their page
+	 *			and tilemaps on their tileset textures
+	 */
+    static void add_dependency(const std::string& identifier, const std::string& dependency);
+
+    /*!
+	 * @brief	Returns every resource depending on @a identifier, directly or
+	 *			not
+	 */
+    [[nodiscard]] static std::vector<std::string> dependents(const std::string& identifier);
+
+    /*!
+	 * @brief	Incremented every time apply_reloads reloads something, and
+	 *			when the cache is cleared
+	 *
+	 *			Objects deriving data from a resource, like the uvs of a sprite,
+	 *			keep the generation they last checked and ask reloaded_since
+	 *			when it changed
+	 */
+    [[nodiscard]] static unsigned generation() noexcept { return generation_; }
+
+    /*!
+	 * @brief	Returns true if @a resource, or one of its dependencies, was
+	 *			reloaded after @a generation
+	 */
+    [[nodiscard]] static bool reloaded_since(const Resource* resource, unsigned generation);
+
     /*!
 	 * @brief	Tries to an animation file
 	 */
@@ -148,7 +284,45 @@ public:
     static int index(const std::string& key);
 
 private:
+    using TypedResources = HashMap<std::string, Resource*>;
+
+    struct AtlasRegion
+    {
+        std::string page;
+        unsigned    x {0u};
+        unsigned    y {0u};
+        unsigned    width {0u};
+        unsigned    height {0u};
+    };
+
+    /*!
+     * @brief   Returns the texture @a id as a region of its atlas page, creating
+     *          it if needed. Returns nullptr if @a id wasn't packed
+     */
+    [[nodiscard]] static Resource* find_atlas_region(const std::string& id);
+
+    /*!
+     * @brief   Returns the resources already fetched as a T
+     *
+     *          Resources of every type share the same map, so finding one
+     *          also means checking its type. We keep a map per type,
+     *          indexed by the type's id, so a resource that was already
+     *          fetched as a T is found without any dynamic_cast
+     */
+    template<class T>
+    [[nodiscard]] static TypedResources& resources_of_type()
+    {
+        const auto id = TypeIds<Resource>::get<T>();
+
+        if(id >= resources_by_type_.size())
+            resources_by_type_.resize(id + 1);
+
+        return resources_by_type_[id];
+    }
+
     static inline std::vector<std::string> directories_;
+
+    static inline filesystem::VirtualFileSystem vfs_;
     //std::map<SimpleString, std::unique_ptr<Resource>> resources_;
 
     // TODO : It's actually slower to use a Vector here but well,
@@ -156,5 +330,22 @@ private:
     // Use my own map implementation one day for this
     //Vector<SimpleString>		_indexes_to_resources;
     static inline Resources resources_;
+
+    static inline std::vector<TypedResources> resources_by_type_;
+
+    // Packed images, indexed by the identifier of their original texture
+    static inline std::unordered_map<std::string, AtlasRegion> atlas_regions_;
+    static inline bool atlas_manifest_loaded_ {false};
+
+    // Set by watch. Defined with the HotReloader's complete type, inside
+    // ResourcesCache.cpp
+    static std::unique_ptr<HotReloader> hot_reloader_;
+
+    // Resources using a resource, indexed by the identifier of the used one
+    static inline std::unordered_map<std::string, std::vector<std::string>> dependents_;
+
+    // Generation at which each resource was last reloaded
+    static inline std::unordered_map<const Resource*, unsigned> reload_generations_;
+    static inline unsigned generation_ {0u};
 };
 }    // namespace corgi
@@ -0,0 +1,99 @@
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+namespace corgi
+{
+	/*!
+	 * @brief	Hands out the large buffers images are decoded and staged into,
+	 *			reusing the released ones
+	 *
+	 *			Loading a batch of textures used to allocate, fill and free a
+	 *			buffer of about the same size for every image, plus the decoder's
+	 *			own scratch buffers. Released buffers are kept, their capacity
+	 *			rounded up to a power of two, and given back to the next
+	 *			allocation they can hold, so a batch only allocates for its
+	 *			largest images
+	 */
+	class StagingPool
+	{
+	public:
+
+	// Lifecycle
+
+		/*!
+		 * @param	max_retained_bytes	Released buffers beyond that size are
+		 *			freed instead of being kept
+		 */
+		explicit StagingPool(std::size_t max_retained_bytes = std::size_t(64) << 20u);
+
+		StagingPool(const StagingPool& other)				= delete;
+		StagingPool& operator=(const StagingPool& other)	= delete;
+
+	// Functions
+
+		/*!
+		 * @brief	Pool used to decode the images, shared by every loader
+		 */
+		[[nodiscard]] static StagingPool& shared();
+
+		/*!
+		 * @brief	Returns a buffer of at least @a size bytes, to give back
+		 *			with release
+		 */
+		[[nodiscard]] std::byte* allocate(std::size_t size);
+
+		/*!
+		 * @brief	Same as realloc for a buffer returned by allocate. Keeps
+		 *			@a data when it can already hold @a size bytes
+		 */
+		[[nodiscard]] std::byte* reallocate(void* data, std::size_t size);
+
+		/*!
+		 * @brief	Gives back a buffer returned by allocate. Does nothing if
+		 *			@a data is nullptr
+		 */
+		void release(void* data) noexcept;
+
+		/*!
+		 * @brief	Frees every buffer kept for later allocations
+		 */
+		void trim() noexcept;
+
+	// Accessors
+
+		/*!
+		 * @brief	Returns how many bytes the released buffers kept take
+		 */
+		[[nodiscard]] std::size_t retained_bytes() const noexcept;
+
+		/*!
+		 * @brief	Returns how many buffers were actually allocated, the others
+		 *			being reused
+		 */
+		[[nodiscard]] std::size_t system_allocations() const noexcept;
+
+	private:
+
+		struct Block
+		{
+			std::unique_ptr<std::byte[]>	data;
+			std::size_t						capacity {0u};
+		};
+
+		std::size_t max_retained_bytes_;
+		std::size_t retained_bytes_		{0u};
+		std::size_t system_allocations_	{0u};
+
+		// Released buffers, sorted by capacity
+		std::vector<Block> free_;
+
+		std::unordered_map<const std::byte*, Block> used_;
+
+		mutable std::mutex mutex_;
+	};
+}
@@ -2,6 +2,7 @@
 
 #include <corgi/resources/Font.h>
 
+#include <string_view>
 #include <vector>
 
 namespace corgi::utils::text
@@ -27,7 +28,7 @@ namespace corgi::utils::text
         // more than 1 character
         std::vector<char> characters;
 
-        // OffsetPosition of the glyph compared to the text
+        // Offset of the glyph's first character inside the text
         int textOffset = 0;
     };
 
@@ -39,10 +40,13 @@ namespace corgi::utils::text
      * 
      * @param text 
      * @param fontConfiguration 
+     * @param textOffset    Offset of @a text inside a larger text, added to
+     *                      the textOffset of the glyphs
      * @return Vector<ShapedGlyph> 
      */
     std::vector<ShapedGlyph>
-    buildShapedGlyphs(const char*                       text,
-                      const corgi::Font::Configuration& fontConfiguration);
+    buildShapedGlyphs(std::string_view                  text,
+                      const corgi::Font::Configuration& fontConfiguration,
+                      int                               textOffset = 0);
 
 }    // namespace corgi::utils::text
\ No newline at end of file
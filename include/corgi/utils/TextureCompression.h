@@ -0,0 +1,179 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+namespace corgi::texture_compression
+{
+	/*!
+	 * @brief	Pixel formats of the levels stored inside a Container
+	 *
+	 *			* RGBA8	: 4 bytes per pixel, uncompressed
+	 *			* BC1	: 8 bytes per 4x4 block, RGB with 1 bit of alpha
+	 *			* BC3	: 16 bytes per 4x4 block, RGB plus an interpolated alpha
+	 *			* BC7	: 16 bytes per 4x4 block, RGBA
+	 */
+	enum class Format : std::uint32_t
+	{
+		RGBA8	= 0,
+		BC1		= 1,
+		BC3		= 2,
+		BC7		= 3
+	};
+
+	/*!
+	 * @brief	Image with 4 channels of 8 bits, rows going up like the .img
+	 *			files. The codec doesn't care about the row order
+	 */
+	struct Image
+	{
+		unsigned width	{0u};
+		unsigned height	{0u};
+
+		std::vector<std::uint8_t> pixels;
+	};
+
+	/*!
+	 * @brief	Returns @a image followed by every smaller level, down to 1x1
+	 *
+	 *			Each level averages 2x2 pixels of the previous one (box filter).
+	 *			With @a srgb, colors are averaged in linear space, so the levels
+	 *			don't get darker. Colors are weighted by their alpha, so the
+	 *			transparent pixels around a sprite don't bleed into it
+	 */
+	[[nodiscard]] std::vector<Image> generate_mips(const Image& image, bool srgb);
+
+	/*!
+	 * @brief	Returns the size in bytes of a @a width * @a height image
+	 *			encoded with @a format
+	 */
+	[[nodiscard]] std::size_t encoded_size(Format format, unsigned width, unsigned height) noexcept;
+
+	/*!
+	 * @brief	Encodes @a image with @a format
+	 *
+	 *			BC1 uses its transparent color for the blocks containing pixels
+	 *			whose alpha is below 128. BC7 only uses mode 6 : one pair of
+	 *			RGBA endpoints and 16 interpolation steps per block
+	 */
+	[[nodiscard]] std::vector<std::uint8_t> encode(Format format, const Image& image);
+
+	/*!
+	 * @brief	Decodes the @a width * @a height image @a data, encoded with
+	 *			@a format
+	 *
+	 *			Only the BC7 blocks using mode 6, the one written by encode, are
+	 *			decoded. The others are left transparent black
+	 */
+	[[nodiscard]] Image decode(Format format, std::span<const std::uint8_t> data, unsigned width,
+							   unsigned height);
+
+	/*!
+	 * @brief	Returns the peak signal to noise ratio between @a a and @a b, in
+	 *			decibels, over the 4 channels. Infinite when they're identical
+	 */
+	[[nodiscard]] double psnr(const Image& a, const Image& b);
+
+	/*!
+	 * @brief	Returns the smallest format keeping @a image's alpha
+	 *
+	 *			BC1 when every pixel is either opaque or fully transparent, BC3
+	 *			otherwise
+	 */
+	[[nodiscard]] Format choose_format(const Image& image);
+
+	/*!
+	 * @brief	Stores the mip chain of a texture, every level already encoded
+	 *			so it can be uploaded as is
+	 *
+	 *			The content of a .img file, recognized by its magic number.
+	 *			Parsing a container doesn't copy anything, the levels point
+	 *			inside the parsed content
+	 *
+	 *			Layout :
+	 *
+	 *			Header
+	 *			Entry[level_count]	Largest level first
+	 *			Levels				Aligned on @a alignment bytes
+	 */
+	class Container
+	{
+	public:
+
+		static constexpr std::uint32_t	magic		= 0x58455443;	// "CTEX"
+		static constexpr std::uint32_t	version		= 1;
+		static constexpr std::size_t	alignment	= 16;
+
+		struct Header
+		{
+			std::uint32_t magic;
+			std::uint32_t version;
+			std::uint32_t format;
+			std::uint32_t level_count;
+			std::uint32_t width;
+			std::uint32_t height;
+		};
+
+		struct Entry
+		{
+			std::uint64_t offset;	// From the beginning of the container
+			std::uint64_t size;
+			std::uint32_t width;
+			std::uint32_t height;
+		};
+
+		static_assert(sizeof(Header) == 24, "Containers are read without padding");
+		static_assert(sizeof(Entry) == 24, "Containers are read without padding");
+
+		struct Level
+		{
+			unsigned					width	{0u};
+			unsigned					height	{0u};
+			std::span<const std::byte>	data;
+		};
+
+	// Functions
+
+		/*!
+		 * @brief	Returns true if @a content starts like a container
+		 */
+		[[nodiscard]] static bool is_container(std::span<const std::byte> content) noexcept;
+
+		/*!
+		 * @brief	Reads the container @a content, which must outlive the levels
+		 *
+		 * @return	Returns false if @a content isn't a valid container
+		 */
+		bool parse(std::span<const std::byte> content);
+
+		/*!
+		 * @brief	Encodes every level of @a levels with @a format and returns
+		 *			the resulting container
+		 */
+		[[nodiscard]] static std::vector<std::byte> write(Format format, const std::vector<Image>& levels);
+
+	// Accessors
+
+		[[nodiscard]] Format format() const noexcept { return format_; }
+
+		[[nodiscard]] unsigned width() const noexcept { return width_; }
+		[[nodiscard]] unsigned height() const noexcept { return height_; }
+
+		[[nodiscard]] const std::vector<Level>& levels() const noexcept { return levels_; }
+
+		/*!
+		 * @brief	Returns the size in bytes of every level, what the texture
+		 *			takes once uploaded
+		 */
+		[[nodiscard]] std::size_t size() const noexcept;
+
+	private:
+
+		Format				format_	{Format::RGBA8};
+		unsigned			width_	{0u};
+		unsigned			height_	{0u};
+		std::vector<Level>	levels_;
+	};
+}
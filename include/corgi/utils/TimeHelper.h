@@ -189,12 +189,44 @@ namespace corgi
         float timestep() const;
         void  timestep(float ts);
 
+        /*!
+		 * @brief	Sets how many fixed updates a single frame can run to catch up
+		 *			with the elapsed time
+		 *
+		 *			After a hitch, running every late update back to back makes the
+		 *			next frame even longer (the spiral of death). Once the limit is
+		 *			reached, the remaining late time is dropped and the simulation
+		 *			runs slower than real time for that frame
+		 */
+        void max_catch_up_steps(int steps);
+
+        [[nodiscard]] int max_catch_up_steps() const noexcept;
+
+        /*!
+		 * @brief	Returns the time dropped because of the catch up limit since
+		 *			the last start() call, in seconds
+		 */
+        [[nodiscard]] float dropped_time() const noexcept;
+
+        /*!
+		 * @brief	Returns how far we are between the last fixed update and the
+		 *			next one, in the [0.0f, 1.0f] range
+		 *
+		 *			Used by the renderer to interpolate between the previous and
+		 *			current state of the simulation
+		 */
+        [[nodiscard]] float alpha() const noexcept;
+
     private:
         std::vector<Callback*> _callbacks;
 
         float _timestep            = 1.0f / 100.0f;
         float _elapsed_time        = 0.0f;
         float _last_update_counter = 0.0f;
+        float _dropped_time        = 0.0f;
+
+        int _max_catch_up_steps = 5;
+        int _steps_this_frame   = 0;
     };
 
     /*!
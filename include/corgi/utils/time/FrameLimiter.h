@@ -0,0 +1,57 @@
+#pragma once
+
+#include <chrono>
+
+namespace corgi
+{
+	namespace time
+	{
+		/*!
+		 * @brief	Caps the frame rate by waiting at the end of every frame
+		 *
+		 *			Sleeping doesn't cost any CPU time but the OS can wake the
+		 *			thread up late. So we only sleep until spin_time() seconds
+		 *			before the deadline and busy wait for the rest of it.
+		 *
+		 *			A frame that ends after its deadline doesn't make the next
+		 *			ones shorter, the limiter starts counting again from there
+		 */
+		class FrameLimiter
+		{
+		public:
+
+		// Accessors
+
+			/*!
+			 * @brief	Sets the maximum frame rate. 0 disables the limiter
+			 */
+			void target_frame_rate(float frames_per_second) noexcept;
+			[[nodiscard]] float target_frame_rate()const noexcept;
+
+			/*!
+			 * @brief	Sets how long before the deadline we stop sleeping and
+			 *			start busy waiting, in seconds
+			 */
+			void spin_time(float seconds) noexcept;
+			[[nodiscard]] float spin_time()const noexcept;
+
+			[[nodiscard]] bool enabled()const noexcept;
+
+		// Functions
+
+			/*!
+			 * @brief	Blocks until the next frame is allowed to start
+			 */
+			void wait();
+
+		private:
+
+			using Clock = std::chrono::steady_clock;
+
+			float target_frame_rate_	{ 0.0f };
+			float spin_time_			{ 0.002f };
+
+			Clock::time_point next_frame_ {};
+		};
+	}
+}
@@ -0,0 +1,63 @@
+#pragma once
+
+#include <array>
+
+namespace corgi
+{
+	namespace time
+	{
+		/*!
+		 * @brief	Counts frames by duration in buckets of bucket_width seconds
+		 *
+		 *			Averages hide hitches, a histogram shows how often frames
+		 *			miss their budget. Frames longer than the last bucket are all
+		 *			counted inside it
+		 */
+		class FrameTimeHistogram
+		{
+		public:
+
+			static constexpr int	bucket_count = 100;
+			static constexpr float	bucket_width = 0.0005f;
+
+		// Functions
+
+			/*!
+			 * @brief	Registers a frame that lasted @a seconds
+			 */
+			void add(float seconds) noexcept;
+
+			void reset() noexcept;
+
+		// Accessors
+
+			/*!
+			 * @brief	Returns how many frames were registered since the last reset
+			 */
+			[[nodiscard]] int count()const noexcept;
+
+			/*!
+			 * @brief	Returns how many frames lasted between index * bucket_width
+			 *			and (index + 1) * bucket_width seconds
+			 */
+			[[nodiscard]] int bucket(int index)const;
+
+			/*!
+			 * @brief	Returns the duration, in seconds, under which @a percent
+			 *			percent of the frames ended. Precise to a bucket's width
+			 */
+			[[nodiscard]] float percentile(float percent)const noexcept;
+
+			[[nodiscard]] float average()const noexcept;
+			[[nodiscard]] float longest()const noexcept;
+
+		private:
+
+			std::array<int, bucket_count> buckets_ {};
+
+			int		count_		{ 0 };
+			double	total_		{ 0.0 };
+			float	longest_	{ 0.0f };
+		};
+	}
+}
@@ -2,6 +2,7 @@
 
 #include <corgi/ecs/Component.h>
 #include <corgi/math/Vec3.h>
+#include <corgi/utils/Event.h>
 
 #include <memory>
 #include <vector>
@@ -17,31 +18,11 @@ class ColliderComponent : public Component
     friend class Renderer;
     friend class Physic;
 
-    class CollisionEvent
-    {
-    public:
-        void operator+=(
-            std::function<void(Entity&, Entity&, ColliderComponent&, ColliderComponent&)>
-                callback)
-        {
-            _callbacks.push_back(callback);
-        }
-
-        void operator-=(int index) { _callbacks.erase(_callbacks.begin() + index); }
-
-        void clear() { _callbacks.clear(); }
-
-        template<class... T>
-        void invoke(T&&... args)
-        {
-            for(auto& callback : _callbacks)
-                callback(args...);
-        }
-
-        std::vector<
-            std::function<void(Entity&, Entity&, ColliderComponent&, ColliderComponent&)>>
-            _callbacks;
-    };
+    /**
+     * @brief   Callbacks receive the collider's entity, the other entity,
+     *          then both colliders in the same order
+     */
+    using CollisionEvent = Event<Entity&, Entity&, ColliderComponent&, ColliderComponent&>;
 
 public:
     // Lifecycle
@@ -56,9 +37,9 @@ public:
 
     // Variables
 
-    CollisionEvent on_enter;        // 16
-    CollisionEvent on_exit;         // 16
-    CollisionEvent on_collision;    // 16
+    CollisionEvent on_enter;        // 8
+    CollisionEvent on_exit;         // 8
+    CollisionEvent on_collision;    // 8
     //
     //Store the normals of every triangle of the mesh
     std::vector<Vec3> normals;    // 12
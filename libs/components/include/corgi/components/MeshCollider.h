@@ -1,7 +1,11 @@
 #pragma once
 
 #include <corgi/components/ColliderComponent.h>
+#include <corgi/math/Bvh.h>
+#include <corgi/math/Matrix.h>
+#include <corgi/math/Ray.h>
 
+#include <cstddef>
 
 namespace corgi
 {
@@ -17,7 +21,25 @@ namespace corgi
 	{
 	public:
 		
+		/*!
+		 * @brief	Sets the collider's mesh and builds the mesh's BVH if
+		 *			it wasn't already built by another collider
+		 */
 		void mesh(std::shared_ptr<Mesh> m);
 
+		/*!
+		 * @brief	Raycasts against the collider's mesh. The ray and the
+		 *			returned hit are in world space
+		 */
+		bool raycast(const Matrix& world_matrix, const Ray& ray, math::RayHit& hit) const;
+
+		/*!
+		 * @brief	Raycasts @a count rays against the collider's mesh, filling
+		 *			one hit per ray. Way faster than calling raycast for every
+		 *			ray, since the rays are traversed together
+		 *
+		 * @return	How many rays hit the mesh
+		 */
+		int raycast(const Matrix& world_matrix, const Ray* rays, math::RayHit* hits, std::size_t count) const;
 	};
-}
\ No newline at end of file
+}
@@ -17,6 +17,11 @@ namespace corgi
         MeshRenderer(RefEntity id);
         MeshRenderer(RefEntity id, Material material);
 
+        /*!
+         * @brief   Draws the mesh with @a material, without copying it
+         */
+        MeshRenderer(RefEntity id, std::shared_ptr<const Material> material);
+
         MeshRenderer(const MeshRenderer& other);
         MeshRenderer(MeshRenderer&& other) noexcept;
 
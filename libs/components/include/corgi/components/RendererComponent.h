@@ -24,7 +24,20 @@ public:
     }
     ~RendererComponent() override = default;
 
+    /*!
+     * @brief   Returns the material the component is drawn with, the shared
+     *          one when it's set
+     */
+    [[nodiscard]] const Material& drawn_material() const noexcept
+    {
+        return shared_material ? *shared_material : material;
+    }
+
     Material              material = Material("empty");
+
+    // Drawn instead of material when set, so renderers using the same
+    // material, like the chunks of a tilemap, don't each keep a copy
+    std::shared_ptr<const Material> shared_material;
     std::shared_ptr<Mesh> _mesh;
     size_t                entity_id = EntityId::npos;
     long long             layer     = 1;
@@ -3,6 +3,10 @@
 #include <corgi/math/Vec2.h>
 #include <corgi/rendering/Material.h>
 #include <corgi/rendering/Sprite.h>
+#include <corgi/rendering/SpriteBatch.h>
+#include <corgi/utils/Color.h>
+
+#include <memory>
 
 namespace corgi
 {
@@ -52,7 +56,8 @@ namespace corgi
         /*!
 		 * @brief	Returns a reference to the sprite currently being renderer
 		 */
-        [[nodiscard]] Sprite& sprite();
+        [[nodiscard]] Sprite&       sprite();
+        [[nodiscard]] const Sprite& sprite() const;
 
         /*!
 		 * @brief	Returns the pivot's position
@@ -142,14 +147,46 @@ namespace corgi
 		 */
         void flip_vertical(bool value);
 
-        const Material& material() const;
+        /*!
+		 * @brief	Sets the color multiplied with the sprite's texture. White
+		 *			by default
+		 */
+        void tint(const Color& color);
+
+        [[nodiscard]] const Color& tint() const noexcept;
 
+        /*!
+		 * @brief	Returns the material used to draw the sprite
+		 *
+		 *			Sprites using the same material and texture are drawn
+		 *			together, so the material must read the per-sprite values
+		 *			from the instance attributes described by SpriteInstance
+		 *			instead of uniforms
+		 */
+        [[nodiscard]] const Material& material() const;
+
+        /*!
+		 * @brief	Makes the sprite use a copy of @a material
+		 *
+		 *			Sprite renderers share their default material, a sprite
+		 *			with its own material can only be batched with the ones
+		 *			that were copied from it
+		 */
         void material(const Material& material);
 
     private:
         // Variables
 
-        Material _material;
+        // Shared between the sprite renderers, so it only identifies which
+        // sprites can be drawn together
+        std::shared_ptr<const Material> _material;
+
+        // Attributes of the sprite, refreshed by the SpriteRendererSystem
+        // when the sprite is dirty. Only the world matrix is written by the
+        // renderer every frame
+        SpriteInstance _instance {};
+
+        Color    _tint {255, 255, 255, 255};
         Sprite   sprite_;
         Vec2     _pivot_value {0.5f, 0.5f};
         bool     _flipped_x {false};
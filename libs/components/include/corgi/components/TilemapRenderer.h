@@ -2,25 +2,109 @@
 
 #include <corgi/ecs/Component.h>
 #include <corgi/ecs/RefEntity.h>
+#include <corgi/rendering/Material.h>
 #include <corgi/resources/Tilemap.h>
 
+#include <memory>
+#include <vector>
+
 namespace corgi
 {
 class Texture;
 class Renderer;
 
+/*!
+ * @brief   Renders the tile layers of a Tilemap
+ *
+ *          Every (layer, tileset) pair is split in chunks of chunk_size *
+ *          chunk_size tiles. Each chunk is an entity with its own mesh, so the
+ *          renderer culls the chunks outside of the camera, and changing a
+ *          tile only rebuilds the mesh of the chunk it belongs to.
+ *
+ *          When streaming is enabled, chunks are only built when the camera
+ *          gets close to them, and released once it moves away. See stream()
+ *          and TilemapSystem
+ *
+ *          Animated tiles are drawn by the chunk meshes like any other tile.
+ *          Every animation of the tilemap follows the same clock, and only
+ *          the uvs of the animated tiles are rewritten when their frame
+ *          changes
+ */
 class TilemapRenderer : public Component
 {
 public:
     friend class Renderer;
 
+    static constexpr int chunk_size = 32;
+
+    // Position, uv, normal
+    static constexpr int floats_per_vertex = 8;
+
+    struct AnimatedTile
+    {
+        // Index of the first float of the tile's 4 vertices inside the
+        // chunk's vertices
+        int vertex {0};
+
+        // Index inside Tilemap::animations
+        int animation {0};
+    };
+
+    struct Chunk
+    {
+        // Index inside tileset_layers_
+        int tileset_layer {0};
+
+        int column {0};
+        int row {0};
+
+        // Bounds of the chunk, in the tilemap's space
+        float left {0.0f};
+        float bottom {0.0f};
+        float right {0.0f};
+        float top {0.0f};
+
+        // Invalid when the chunk isn't loaded
+        RefEntity entity;
+
+        std::vector<AnimatedTile> animated_tiles;
+
+        bool dirty {false};
+
+        // True while no tile of the chunk belongs to its tileset. Empty
+        // chunks are never loaded, they only keep the grid dense
+        bool empty {true};
+    };
+
+    /*!
+     * @brief   Vertices generated for an area of a layer. Kept outside of the
+     *          chunk's mesh so it can be generated without a rendering context
+     */
+    struct ChunkGeometry
+    {
+        void clear() noexcept;
+
+        std::vector<float>        vertices;
+        std::vector<unsigned>     indexes;
+        std::vector<AnimatedTile> animated_tiles;
+    };
+
     // Constructors
 
     TilemapRenderer();
 
     // Functions
 
-    void initialize(Tilemap tilemap, RefEntity e);
+    /*!
+     * @brief   Generates the chunks of every tile layer of @a tilemap as
+     *          children of @a e
+     *
+     *          The renderer keeps its own tilemap so set_tile doesn't modify
+     *          the given one. Move the tilemap in when it isn't needed
+     *          anymore to avoid the copy
+     */
+    void initialize(const Tilemap& tilemap, RefEntity e);
+    void initialize(Tilemap&& tilemap, RefEntity e);
     // tile_width and tile_height is set in pixel here
 
     // For now I send the renderer like that because I don't really know
@@ -29,7 +113,7 @@ public:
 
     // I mean, I'd need to make a "TilemapLayerRenderer" component
     // and have them all inherit from this?
-    void generate_mesh(Tilemap tilemap, Tilemap::TileLayer layer);
+    void generate_mesh(const Tilemap& tilemap, const Tilemap::TileLayer& layer);
 
     void generate_layer(RefEntity e, const Tilemap::TileLayer& tile_layer);
 
@@ -43,6 +127,78 @@ public:
 		 */
     int extract_tileset_from_tileid(long long tile_id);
 
+    /*!
+     * @brief   Changes the tile at column @a x and row @a y of the layer
+     *          @a layer. Only the chunks containing the tile are rebuilt, the
+     *          next time rebuild_dirty_chunks or stream is called
+     *
+     * @param tile_id   Tiled's global tile id, flip flags included
+     */
+    void set_tile(int layer, int x, int y, long long tile_id);
+
+    [[nodiscard]] long long tile(int layer, int x, int y) const;
+
+    /*!
+     * @brief   Loads the chunks overlapping the given rectangle and unloads
+     *          the ones that are far away from it, then rebuilds the dirty
+     *          chunks. The rectangle is given in the tilemap's space
+     *
+     *          Chunks are loaded stream_margin chunks ahead of the rectangle,
+     *          and only unloaded one chunk further than that, so moving the
+     *          camera back and forth around a chunk border doesn't keep
+     *          building and releasing the same chunks
+     */
+    void stream(float left, float bottom, float right, float top);
+
+    /*!
+     * @brief   Rebuilds the meshes of the loaded chunks whose tiles changed
+     */
+    void rebuild_dirty_chunks();
+
+    /*!
+     * @brief   Marks dirty the loaded chunks whose tileset texture was
+     *          reloaded after @a generation, since the uvs depend on its
+     *          size. See ResourcesCache::generation
+     */
+    void invalidate_reloaded_tilesets(unsigned generation);
+
+    /*!
+     * @brief   Advances the animation clock and updates the uvs of the
+     *          animated tiles whose frame changed
+     *
+     * @param elapsed_time  In seconds
+     */
+    void update_animations(float elapsed_time);
+
+    /*!
+     * @brief   Generates the vertices of the tiles of @a layer that belong to
+     *          @a tileset, between [first_column, last_column[ and
+     *          [first_row, last_row[
+     *
+     * @param animation_frames  Current frame of every animation of the
+     *                          tilemap. Animated tiles use their first frame
+     *                          when empty
+     */
+    static void build_geometry(const Tilemap&          tilemap,
+                               int                     layer,
+                               int                     tileset,
+                               int                     first_column,
+                               int                     first_row,
+                               int                     last_column,
+                               int                     last_row,
+                               int                     texture_width,
+                               int                     texture_height,
+                               const std::vector<int>& animation_frames,
+                               ChunkGeometry&          geometry);
+
+    [[nodiscard]] const std::vector<Chunk>& chunks() const noexcept;
+    [[nodiscard]] int                       loaded_chunk_count() const noexcept;
+
+    /*!
+     * @brief   Entity the tilemap was initialized with
+     */
+    [[nodiscard]] RefEntity root() const noexcept;
+
     // Variables
 
     int cameraLayer_ = 1;
@@ -64,20 +220,72 @@ public:
 
     int points {0};    // 4 bytes
 
+    // Must be set before calling initialize. When false, every chunk is
+    // built by initialize and never released
+    bool streaming {false};
+
+    // How many chunks are loaded ahead of the streamed rectangle
+    int stream_margin {1};
+
     Tilemap tilemap_;
 
     Tilemap::TileLayer layer_;
 
 private:
+    /*!
+     * @brief   Every chunk of a (layer, tileset) pair share the same material
+     */
+    struct TilesetLayer
+    {
+        int layer {0};
+        int tileset {0};
+
+        RefEntity entity;
+        Texture*  texture {nullptr};
+
+        // Shared by the mesh renderers of the chunks rather than copied
+        std::shared_ptr<Material> material;
+
+        // Index of the first chunk inside chunks_. Chunks are stored row by row
+        int first_chunk {0};
+        int columns {0};
+        int rows {0};
+    };
+
     // Functions
 
-    void create_animated_tile(long long                           tile_id,
-                              Texture*                            texture,
-                              float                               left,
-                              float                               bottom,
-                              unsigned                            tileset_tile_width,
-                              unsigned                            tileset_tile_height,
-                              RefEntity                           e,
-                              std::vector<Tilemap::TileAnimation> animations);
+    [[nodiscard]] Chunk& chunk_at(const TilesetLayer& tileset_layer, int column, int row);
+
+    void load_chunk(Chunk& chunk);
+    void unload_chunk(Chunk& chunk);
+    void build_chunk(Chunk& chunk);
+
+    /*!
+     * @brief   Returns the index of the frame an animation is at after
+     *          @a time milliseconds
+     */
+    [[nodiscard]] int animation_frame(const Tilemap::AnimationInfo& animation,
+                                      double                        time) const;
+
+    // Variables
+
+    RefEntity root_;
+
+    std::vector<TilesetLayer> tileset_layers_;
+    std::vector<Chunk>        chunks_;
+
+    // Indexes of the loaded chunks
+    std::vector<int> loaded_chunks_;
+
+    // Reused by every chunk build
+    ChunkGeometry geometry_;
+
+    // In milliseconds, like the durations of Tiled's animations
+    double animation_clock_ {0.0};
+
+    // Current frame of every animation of tilemap_, and whether it changed
+    // during the last update_animations
+    std::vector<int>  animation_frames_;
+    std::vector<char> animation_changed_;
 };
 }    // namespace corgi
\ No newline at end of file
@@ -90,6 +90,20 @@ public:
 	*/
 	[[nodiscard]] const Matrix& world_matrix() const noexcept;
 
+	/*!
+	* @brief	Returns the world matrix computed during the previous fixed update
+	*/
+	[[nodiscard]] const Matrix& previous_world_matrix() const noexcept;
+
+	/*!
+	* @brief	Blends the previous and current world matrices
+	*
+	*			Used by the renderer to draw the transform between two fixed
+	*			updates. An @a alpha of 0 returns the previous matrix, 1 the
+	*			current one
+	*/
+	[[nodiscard]] Matrix interpolated_world_matrix(float alpha) const noexcept;
+
 	/*!
 	* @brief	Returns the world position of the current transform
 	*			Warning : Actually compute the matrix and its parents if
@@ -145,6 +159,12 @@ private:
 
 	Matrix _world_matrix; // Matrix are 64 bytes	128
 
+	// World matrix of the previous fixed update, used for interpolation
+	Matrix _previous_world_matrix;
+
+	// False until the world matrix has been computed once, so a new transform
+	// isn't interpolated from the identity matrix
+	bool _has_previous_world_matrix = false;
 	bool _dirty         = true; // 129
 	bool _inverse_dirty = true; // 130
 	// If true, the transform doesn't apply the parent's transformation
@@ -26,5 +26,31 @@ namespace corgi
 
 			normals.push_back(math::get_triangle_normal(posA, posB, posC));
 		}
+
+		// Built now rather than during the first raycast
+		m->bvh();
+	}
+
+	bool MeshCollider::raycast(const Matrix& world_matrix, const Ray& ray, math::RayHit& hit) const
+	{
+		if (!_mesh)
+		{
+			hit = math::RayHit();
+			return false;
+		}
+		return _mesh->bvh().raycast(world_matrix, world_matrix.inverse(), ray, hit);
+	}
+
+	int MeshCollider::raycast(const Matrix& world_matrix, const Ray* rays, math::RayHit* hits, std::size_t count) const
+	{
+		if (!_mesh)
+		{
+			for (std::size_t i = 0; i < count; i++)
+				hits[i] = math::RayHit();
+			return 0;
+		}
+
+		// The inverse matrix is only computed once for every ray
+		return _mesh->bvh().raycast(world_matrix, world_matrix.inverse(), rays, hits, count);
 	}
 }
\ No newline at end of file
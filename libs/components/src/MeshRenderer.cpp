@@ -20,38 +20,49 @@ MeshRenderer::MeshRenderer(RefEntity id, Material material)
     layers.emplace_back(1);
 }
 
+MeshRenderer::MeshRenderer(RefEntity id, std::shared_ptr<const Material> material)
+{
+    _entity_id      = id;
+    shared_material = std::move(material);
+    layers.emplace_back(1);
+}
+
 MeshRenderer::MeshRenderer(const MeshRenderer& other)
 {
-    material   = other.material;
-    _mesh      = other._mesh;
-    _entity_id = other._entity_id;
-    layer      = other.layer;
+    material        = other.material;
+    shared_material = other.shared_material;
+    _mesh           = other._mesh;
+    _entity_id      = other._entity_id;
+    layer           = other.layer;
     layers.emplace_back(1);
 }
 
 MeshRenderer::MeshRenderer(MeshRenderer&& other) noexcept
 {
-    material   = other.material;
-    _mesh      = (other._mesh);
-    _entity_id = other._entity_id;
-    layer      = other.layer;
+    material        = other.material;
+    shared_material = other.shared_material;
+    _mesh           = (other._mesh);
+    _entity_id      = other._entity_id;
+    layer           = other.layer;
 }
 
 MeshRenderer& MeshRenderer::operator=(const MeshRenderer& other)
 {
-    material   = other.material;
-    _mesh      = other._mesh;
-    _entity_id = other._entity_id;
-    layer      = other.layer;
+    material        = other.material;
+    shared_material = other.shared_material;
+    _mesh           = other._mesh;
+    _entity_id      = other._entity_id;
+    layer           = other.layer;
     return *this;
 }
 
 MeshRenderer& MeshRenderer::operator=(MeshRenderer&& other) noexcept
 {
-    material   = other.material;
-    _mesh      = other._mesh;
-    _entity_id = other._entity_id;
-    layer      = other.layer;
+    material        = other.material;
+    shared_material = other.shared_material;
+    _mesh           = other._mesh;
+    _entity_id      = other._entity_id;
+    layer           = other.layer;
     return *this;
 }
 }    // namespace corgi
@@ -6,21 +6,27 @@
 
 namespace corgi
 {
+// Every sprite renderer references the same material, owned by the
+// resources cache, so they can all be batched together
+static std::shared_ptr<const Material> default_material()
+{
+    return std::shared_ptr<const Material>(
+        std::shared_ptr<const Material>(),
+        ResourcesCache::get<Material>("corgi/materials/unlit/unlit_sprite_instanced.mat"));
+}
+
 SpriteRenderer::SpriteRenderer()
-    : _material(*ResourcesCache::get<Material>(
-        "corgi/materials/unlit/unlit_sprite.mat"))
+    : _material(default_material())
 { }
 
 SpriteRenderer::SpriteRenderer(Texture& tex)
-    : _material(*ResourcesCache::get<Material>(
-        "corgi/materials/unlit/unlit_sprite.mat"))
+    : _material(default_material())
 {
     sprite(tex);
 }
 
 SpriteRenderer::SpriteRenderer(Sprite sprite, Pivot pivot)
-    : _material(*ResourcesCache::get<Material>(
-        "corgi/materials/unlit/unlit_sprite.mat"))
+    : _material(default_material())
 {
     static Vec2 pivots_[] = {
             {Vec2(0.5f, 0.5f)},    // Pivot::Center
@@ -51,6 +57,7 @@ void SpriteRenderer::sprite(Texture& texture)
 void SpriteRenderer::flip_horizontal()
 {
     _flipped_x = !_flipped_x;
+    _dirty     = true;
 }
 
 void SpriteRenderer::flip_horizontal(bool value)
@@ -73,13 +80,24 @@ void SpriteRenderer::flip_vertical(bool value)
 
 void SpriteRenderer::material(const Material& material)
 {
-    _material = material;
+    _material = std::make_shared<const Material>(material);
     _dirty    = true;
 }
 
 const Material& SpriteRenderer::material() const
 {
-    return _material;
+    return *_material;
+}
+
+void SpriteRenderer::tint(const Color& color)
+{
+    _tint  = color;
+    _dirty = true;
+}
+
+const Color& SpriteRenderer::tint() const noexcept
+{
+    return _tint;
 }
 
 void SpriteRenderer::pivot(Pivot pivot)
@@ -97,6 +115,7 @@ void SpriteRenderer::pivot(Pivot pivot)
         };
 
     _pivot_value = pivots_[static_cast<int>(pivot)];
+    _dirty       = true;
 }
 
 void SpriteRenderer::pivot(float x, float y)
@@ -130,6 +149,11 @@ Sprite& SpriteRenderer::sprite()
     return sprite_;
 }
 
+const Sprite& SpriteRenderer::sprite() const
+{
+    return sprite_;
+}
+
 Vec2 SpriteRenderer::pivot() const noexcept
 {
     return _pivot_value;
@@ -1,6 +1,4 @@
-#include <corgi/components/Animator.h>
 #include <corgi/components/MeshRenderer.h>
-#include <corgi/components/SpriteRenderer.h>
 #include <corgi/components/TilemapRenderer.h>
 #include <corgi/components/Transform.h>
 #include <corgi/ecs/Entity.h>
@@ -11,7 +9,9 @@
 #include <corgi/resources/Mesh.h>
 #include <corgi/utils/ResourcesCache.h>
 
+#include <algorithm>
 #include <cassert>
+#include <cmath>
 #include <numbers>
 
 namespace corgi
@@ -21,68 +21,86 @@ static const unsigned FLIPPED_HORIZONTALLY_FLAG = 0x80000000;
 static const unsigned FLIPPED_VERTICALLY_FLAG   = 0x40000000;
 static const unsigned FLIPPED_DIAGONALLY_FLAG   = 0x20000000;
 
-static Animation make_animation(Texture&                                   texture,
-                                const std::vector<Tilemap::TileAnimation>& animations,
-                                unsigned                                   tile_width,
-                                unsigned                                   tile_height)
+/*!
+ * @brief   Returns the index of the tileset the tile @a flagged_tile_id
+ *          belongs to, or -1 when there's no tile
+ */
+static int tileset_of(const Tilemap& tilemap, long long flagged_tile_id)
 {
-    Animation anim;
-    anim.name("tile_animation");
-    anim.looping   = true;
-    anim.flipped_x = false;
-    anim.frames.reserve(animations.size());
+    const long long tile_id = flagged_tile_id & ~(FLIPPED_HORIZONTALLY_FLAG |
+                                                  FLIPPED_VERTICALLY_FLAG |
+                                                  FLIPPED_DIAGONALLY_FLAG);
 
-    for(const auto& tile_animation : animations)
-    {
-        const int cols = static_cast<int>(texture.width() / tile_width);
+    if(tile_id == 0)
+        return -1;
+
+    return tilemap.tileset_index(tile_id);
+}
 
-        const auto x_offset = tile_animation.tile_id % cols;
-        const auto y_offset = tile_animation.tile_id / cols;
+/*!
+ * @brief   Writes the uvs of the tile @a tile_id inside the 4 vertices starting
+ *          at @a vertices
+ */
+static void write_tile_uvs(float*                      vertices,
+                           long long                   tile_id,
+                           const Tilemap::TilesetInfo& tileset_info,
+                           int                         texture_width,
+                           int                         texture_height)
+{
+    const auto tex_tile_width =
+        static_cast<float>(tileset_info.tile_width) / static_cast<float>(texture_width);
+    const auto tex_tile_height =
+        static_cast<float>(tileset_info.tile_height) / static_cast<float>(texture_height);
 
-        Sprite sprite(tile_width, tile_height, x_offset * tile_width,
-                      texture.height() - y_offset * tile_height - tile_height, 0.5f, 0.5f,
-                      &texture);
+    const unsigned cols = texture_width / tileset_info.tile_width;
 
-        anim.frames.emplace_back(sprite, tile_animation.duration);
-    }
-    return anim;
+    const long long xcoord = tile_id % cols;
+    const long long ycoord = tile_id / cols;
+
+    const float u = xcoord * tex_tile_width;
+    const float v = 1.0f - ycoord * tex_tile_height;
+
+    constexpr int stride = TilemapRenderer::floats_per_vertex;
+
+    vertices[3] = u;
+    vertices[4] = v;
+
+    vertices[stride + 3] = u;
+    vertices[stride + 4] = v - tex_tile_height;
+
+    vertices[stride * 2 + 3] = u + tex_tile_width;
+    vertices[stride * 2 + 4] = v - tex_tile_height;
+
+    vertices[stride * 3 + 3] = u + tex_tile_width;
+    vertices[stride * 3 + 4] = v;
 }
 
 /*!
- *  Check if the given tile_id is animated in the given TilesetInfo
+ * @brief   Adds the 4 vertices and 6 indexes of a tile to the given buffers
+ *
+ * @param flagged_tile_id   Tile id with Tiled's flip flags
+ * @param tile_id           Tile id inside its tileset, without the flags
  */
-//static bool is_tile_animated(long long tile_id, const Tilemap::TilesetInfo& tileset_info)
-//{
-//	const auto result = std::ranges::find_if(tileset_info.tiles, [&](const Tilemap::TileInfo& ti)->bool
-//		{
-//			return ti.id == tile_id;
-//		});
-
-//	return result != tileset_info.tiles.end();
-//}
-
-void TilemapRenderer::create_animated_tile(long long tile_id,
-                                           Texture*  texture,
-                                           float     left,
-                                           float     bottom,
-                                           unsigned  tileset_tile_width,
-                                           unsigned  tileset_tile_height,
-                                           RefEntity e,
-                                           std::vector<Tilemap::TileAnimation> animations)
+static void push_tile(std::vector<float>&         vertices,
+                      std::vector<unsigned>&      indexes,
+                      long long                   flagged_tile_id,
+                      long long                   tile_id,
+                      float                       left,
+                      float                       bottom,
+                      bool                        use_y_as_z,
+                      const Tilemap::TilesetInfo& tileset_info,
+                      int                         texture_width,
+                      int                         texture_height)
 {
-    // What an actual fucking mess
+    const bool flipped_horizontally = (flagged_tile_id & FLIPPED_HORIZONTALLY_FLAG);
+    const bool flipped_vertically   = (flagged_tile_id & FLIPPED_VERTICALLY_FLAG);
+    const bool flipped_diagonally   = (flagged_tile_id & FLIPPED_DIAGONALLY_FLAG);
 
-    const bool flipped_horizontally = (tile_id & FLIPPED_HORIZONTALLY_FLAG);
-    const bool flipped_vertically   = (tile_id & FLIPPED_VERTICALLY_FLAG);
-    const bool flipped_diagonally   = (tile_id & FLIPPED_DIAGONALLY_FLAG);
+    // Managing flips and rotations
 
-    const auto pi =
-        std::numbers::pi_v<float>;    // Kinda sucks that I have to do that but ok
+    float      rotation_value {0.0f};
+    const auto pi = std::numbers::pi_v<float>;
 
-    float rotation_value {0.0f};
-
-    // This values are actually use to know if I must flip on the x or y axis "for real"
-    // and not just rotate the thing
     bool flip_v {false};
     bool flip_h {false};
 
@@ -113,75 +131,99 @@ void TilemapRenderer::create_animated_tile(long long tile_id,
         rotation_value = pi / 2.0f;
     }
 
-    auto entity = e->emplace_back("RootTileAnimation");
-    entity->add_component<Transform>(left + tileset_tile_width / 2.0f,
-                                     bottom - tileset_tile_height / 2.0f);
+    Matrix mat = Matrix::rotation_z(rotation_value);
 
-    auto animation_entity = entity->emplace_back("TileAnimation");
-    auto tr               = animation_entity->add_component<Transform>();
+    const auto ttw = static_cast<float>(tileset_info.tile_width);
+    const auto tth = static_cast<float>(tileset_info.tile_height);
 
-    tr->euler_angles(0.0f, 0.0f, rotation_value);
+    // First step, tile, center, used with the rotation thing
 
-    // TODO : This might not always work, if something feels wrong check this
+    float z_value = 0.0f;
 
-    if(flip_h)
-        tr->euler_angles(0.0f, math::pi, rotation_value);
+    if(use_y_as_z)
+        z_value = -(bottom - tth / 2.0f - tth / 2.0f);
+
+    Vec3 center(left + ttw / 2.0f, bottom - tth / 2.0f, z_value);
+
+    Vec3 v1(-ttw / 2.0f, tth / 2.0f, 0.0f);
+    Vec3 v2(-ttw / 2.0f, -tth / 2.0f, 0.0f);
+    Vec3 v3(ttw / 2.0f, -tth / 2.0f, 0.0f);
+    Vec3 v4(ttw / 2.0f, tth / 2.0f, 0.0f);
 
     if(flip_v)
-        tr->euler_angles(math::pi, 0.0f, rotation_value);
+    {
+        v1 = Vec3(-ttw / 2.0f, -tth / 2.0f, 0.0f);
+        v2 = Vec3(-ttw / 2.0f, tth / 2.0f, 0.0f);
+        v3 = Vec3(ttw / 2.0f, tth / 2.0f, 0.0f);
+        v4 = Vec3(ttw / 2.0f, -tth / 2.0f, 0.0f);
+    }
+
+    if(flip_h)
+    {
+        v1 = Vec3(ttw / 2.0f, tth / 2.0f, 0.0f);
+        v2 = Vec3(ttw / 2.0f, -tth / 2.0f, 0.0f);
+        v3 = Vec3(-ttw / 2.0f, -tth / 2.0f, 0.0f);
+        v4 = Vec3(-ttw / 2.0f, tth / 2.0f, 0.0f);
+    }
 
-    auto sr         = animation_entity->add_component<SpriteRenderer>();
-    sr->cameraLayer = cameraLayer_;
-    auto mat        = sr->material();
+    // After rotating a tile, we put it back where it's supposed to be
 
-    // We know that the material we use for sprites contains
-    // one sampler that is the main texture
-    mat._texture_uniforms.at(0).texture = texture;
+    const auto r1 = mat * v1 + center;
+    const auto r2 = mat * v2 + center;
+    const auto r3 = mat * v3 + center;
+    const auto r4 = mat * v4 + center;
 
-    sr->material(mat);
+    constexpr int stride = TilemapRenderer::floats_per_vertex;
 
-    auto animator = animation_entity->add_component<Animator>();
-    animator->add_animation(
-        make_animation(*texture, animations, tileset_tile_width, tileset_tile_height));
-    animator->play("tile_animation");
+    const auto first_vertex = static_cast<unsigned>(vertices.size() / stride);
+
+    // Position, uv, normal. The uvs are written afterward
+    vertices.insert(vertices.end(), {r1.x, r1.y, r1.z, 0.0f, 0.0f, 0.0f, 0.0f, 1.0f,
+                                     r2.x, r2.y, r2.z, 0.0f, 0.0f, 0.0f, 0.0f, 1.0f,
+                                     r3.x, r3.y, r3.z, 0.0f, 0.0f, 0.0f, 0.0f, 1.0f,
+                                     r4.x, r4.y, r4.z, 0.0f, 0.0f, 0.0f, 0.0f, 1.0f});
+
+    write_tile_uvs(vertices.data() + first_vertex * stride, tile_id, tileset_info,
+                   texture_width, texture_height);
+
+    indexes.insert(indexes.end(), {first_vertex, first_vertex + 1, first_vertex + 2,
+                                   first_vertex, first_vertex + 2, first_vertex + 3});
 }
 
 void TilemapRenderer::generate_tileset_layer(RefEntity                   parent,
                                              const Tilemap::TileLayer&   layer,
                                              const Tilemap::TilesetInfo& tileset_info)
 {
-    bool use_y_as_z   = layer.name == "Objects";
-    bool always_front = layer.name == "AlwaysFront";
-
-    // I generate the component needed to make the thing
-    auto e = parent->emplace_back(layer.name.c_str());
-    e->add_component<Transform>();
-    auto mesh_renderer   = e->add_component<MeshRenderer>(e);
-    mesh_renderer->layer = cameraLayer_;
+    TilesetLayer tileset_layer;
 
-    int actualLayer = mesh_renderer->layer;
+    const bool always_front = layer.name == "AlwaysFront";
 
-    // Getting back the basic information from the tilemap and layer
-    const auto width  = layer.width;
-    const auto height = layer.height;
-    const auto x      = layer.x;
-    const auto y      = layer.y;
+    // The chunks are rebuilt from tilemap_, so the layer and the tileset
+    // must be the ones it stores
+    assert(&layer >= tilemap_.tile_layers.data() &&
+           &layer < tilemap_.tile_layers.data() + tilemap_.tile_layers.size());
+    assert(&tileset_info >= tilemap_.tileset_infos.data() &&
+           &tileset_info < tilemap_.tileset_infos.data() + tilemap_.tileset_infos.size());
 
-    const auto tilemap_tile_width  = tilemap_.tile_width;
-    const auto tilemap_tile_height = tilemap_.tile_height;
+    tileset_layer.layer = static_cast<int>(&layer - tilemap_.tile_layers.data());
+    tileset_layer.tileset =
+        static_cast<int>(&tileset_info - tilemap_.tileset_infos.data());
 
-    const auto tileset_tile_width  = tileset_info.tile_width;
-    const auto tileset_tile_height = tileset_info.tile_height;
+    // The chunks will be the children of this entity
+    tileset_layer.entity = parent->emplace_back(layer.name.c_str());
+    tileset_layer.entity->add_component<Transform>();
 
     // We get back the tileset's texture
 
-    auto* texture = ResourcesCache::get<Texture>(tileset_info.image.c_str());
+    auto* texture         = ResourcesCache::get<Texture>(tileset_info.image.c_str());
+    tileset_layer.texture = texture;
 
-    // Define the material
+    // Define the material, shared by every chunk
 
-    auto& material = mesh_renderer->material;
+    tileset_layer.material = std::make_shared<Material>(
+        *ResourcesCache::get<Material>("corgi/materials/unlit/unlit_texture.mat"));
 
-    material = *ResourcesCache::get<Material>("corgi/materials/unlit/unlit_texture.mat");
+    auto& material = *tileset_layer.material;
 
     if(material._texture_uniforms.empty())
         material.add_texture(*texture);
@@ -192,308 +234,428 @@ void TilemapRenderer::generate_tileset_layer(RefEntity                   parent,
     material.depth_test = DepthTest::LEqual;
     material.set_uniform("use_flat_color", 0);
 
-    //const int  ratio			= (texture->width() / _tile_width);
-    const float tex_tile_width = static_cast<float>(tileset_info.tile_width) /
-                                 static_cast<float>(texture->width());
-    const float tex_tile_height = static_cast<float>(tileset_info.tile_height) /
-                                  static_cast<float>(texture->height());
+    if(always_front)
+    {
+        material.enable_depth_test(false);
+        material.render_queue = 10000;
+    }
 
-    auto mesh = Mesh::new_standard_mesh();
+    // Splitting the layer in chunks
 
-    int  tile_count        = 0;
-    auto tileset_info_size = tileset_info.tiles.size();
+    const auto width  = static_cast<int>(layer.width);
+    const auto height = static_cast<int>(layer.height);
 
-    int w = static_cast<int>(width);
+    tileset_layer.columns     = (width + chunk_size - 1) / chunk_size;
+    tileset_layer.rows        = (height + chunk_size - 1) / chunk_size;
+    tileset_layer.first_chunk = static_cast<int>(chunks_.size());
 
-    // We first check how many tile we actually have to draw to properly size
-    // the mesh that will be created
-    for(int i = 0; i < height; ++i)
+    const auto tile_width  = static_cast<float>(tilemap_.tile_width);
+    const auto tile_height = static_cast<float>(tilemap_.tile_height);
+
+    for(int row = 0; row < tileset_layer.rows; ++row)
     {
-        for(int j = 0; j < w; ++j)
+        for(int column = 0; column < tileset_layer.columns; ++column)
         {
-            // Get the tile id
-            long long tile_id = layer.data[i * w + j];
+            Chunk chunk;
+            chunk.tileset_layer = static_cast<int>(tileset_layers_.size());
+            chunk.column        = column;
+            chunk.row           = row;
+
+            const int last_column = std::min(width, (column + 1) * chunk_size);
+            const int last_row    = std::min(height, (row + 1) * chunk_size);
+
+            // Rows go down, like in Tiled
+            chunk.left   = layer.x + column * chunk_size * tile_width;
+            chunk.right  = layer.x + last_column * tile_width;
+            chunk.top    = layer.y - row * chunk_size * tile_height;
+            chunk.bottom = layer.y - last_row * tile_height;
+
+            // Most tilesets only cover a part of the layer, no entity is
+            // made for the chunks they have no tile in
+            for(int i = row * chunk_size; i < last_row && chunk.empty; ++i)
+            {
+                for(int j = column * chunk_size; j < last_column; ++j)
+                {
+                    if(tileset_of(tilemap_, layer.data[i * width + j]) == tileset_layer.tileset)
+                    {
+                        chunk.empty = false;
+                        break;
+                    }
+                }
+            }
 
-            // Remove the flags from the id
-            tile_id &= ~(FLIPPED_HORIZONTALLY_FLAG | FLIPPED_VERTICALLY_FLAG |
-                         FLIPPED_DIAGONALLY_FLAG);
+            chunks_.push_back(chunk);
+        }
+    }
 
-            // if the tile id is equal to zero, we just skip the thing
-            if(tile_id == 0)
-                continue;
+    tileset_layers_.push_back(std::move(tileset_layer));
+}
 
-            auto tileset_gid = extract_tileset_from_tileid(tile_id);
+TilemapRenderer::Chunk&
+TilemapRenderer::chunk_at(const TilesetLayer& tileset_layer, int column, int row)
+{
+    return chunks_[tileset_layer.first_chunk + row * tileset_layer.columns + column];
+}
 
-            if(tileset_gid != tileset_info.firstgid)
-                continue;
+void TilemapRenderer::load_chunk(Chunk& chunk)
+{
+    auto& tileset_layer = tileset_layers_[chunk.tileset_layer];
 
-            tile_id -= tileset_gid;
+    chunk.entity = tileset_layer.entity->emplace_back("TilemapChunk");
+    chunk.entity->add_component<Transform>();
 
-            // Look if the tile is animated
+    auto mesh_renderer =
+        chunk.entity->add_component<MeshRenderer>(chunk.entity, tileset_layer.material);
+    mesh_renderer->layer = cameraLayer_;
+    mesh_renderer->_mesh = Mesh::new_standard_mesh();
 
-            bool     found       = false;
-            unsigned found_index = -1;
+    loaded_chunks_.push_back(static_cast<int>(&chunk - chunks_.data()));
 
-            for(SizeType i = 0; i < tileset_info_size; i++)
-            {
-                if(tileset_info.tiles[i].id == tile_id)
-                {
-                    found       = true;
-                    found_index = i;
-                    break;
-                }
-            }
+    build_chunk(chunk);
+}
 
-            if(found)
-            {
-                if(!tileset_info.tiles[found_index].animations.empty())
-                    continue;
-            }
+void TilemapRenderer::unload_chunk(Chunk& chunk)
+{
+    auto& tileset_layer = tileset_layers_[chunk.tileset_layer];
 
-            tile_count++;
-        }
-    }
+    chunk.entity->remove();
+    tileset_layer.entity->remove_child(chunk.entity);
+    chunk.entity.reset();
+    chunk.dirty = false;
+}
+
+void TilemapRenderer::ChunkGeometry::clear() noexcept
+{
+    vertices.clear();
+    indexes.clear();
+    animated_tiles.clear();
+}
+
+void TilemapRenderer::build_geometry(const Tilemap&          tilemap,
+                                     int                     layer_index,
+                                     int                     tileset,
+                                     int                     first_column,
+                                     int                     first_row,
+                                     int                     last_column,
+                                     int                     last_row,
+                                     int                     texture_width,
+                                     int                     texture_height,
+                                     const std::vector<int>& animation_frames,
+                                     ChunkGeometry&          geometry)
+{
+    const auto& layer        = tilemap.tile_layers[layer_index];
+    const auto& tileset_info = tilemap.tileset_infos[tileset];
+
+    const bool use_y_as_z = layer.name == "Objects";
 
-    float* vertices = new float[tile_count * 4 * 8];
-    auto*  indices  = new unsigned[tile_count * 3 * 2];
+    const auto w = static_cast<int>(layer.width);
 
-    int current_tile = 0;
+    const auto tilemap_tile_width  = tilemap.tile_width;
+    const auto tilemap_tile_height = tilemap.tile_height;
 
-    // Drawing the TilemapRenderer in the most naive way for now
-    for(int i = 0; i < height; ++i)
+    for(int i = first_row; i < last_row; ++i)
     {
-        float bottom = static_cast<float>(y) - i * tilemap_tile_height;
+        float bottom = static_cast<float>(layer.y) - i * tilemap_tile_height;
 
-        for(int j = 0; j < w; ++j)
+        for(int j = first_column; j < last_column; ++j)
         {
-            float left = static_cast<float>(x) + j * tilemap_tile_width;
-
-            // Get the tile id
-            long long tile_id = layer.data[i * w + j];
+            float left = static_cast<float>(layer.x) + j * tilemap_tile_width;
 
-            const bool flipped_horizontally = (tile_id & FLIPPED_HORIZONTALLY_FLAG);
-            const bool flipped_vertically   = (tile_id & FLIPPED_VERTICALLY_FLAG);
-            const bool flipped_diagonally   = (tile_id & FLIPPED_DIAGONALLY_FLAG);
+            const long long flagged_tile_id = layer.data[i * w + j];
 
             // Remove the flags from the id
-            tile_id &= ~(FLIPPED_HORIZONTALLY_FLAG | FLIPPED_VERTICALLY_FLAG |
-                         FLIPPED_DIAGONALLY_FLAG);
-
-            // long long tile_x = tile_id % ratio;
-            // long long tile_y = tile_id / ratio;
+            long long tile_id = flagged_tile_id & ~(FLIPPED_HORIZONTALLY_FLAG |
+                                                    FLIPPED_VERTICALLY_FLAG |
+                                                    FLIPPED_DIAGONALLY_FLAG);
 
             // if the tile id is equal to zero, we just skip the thing
             if(tile_id == 0)
                 continue;
 
+            if(tilemap.tileset_index(tile_id) != tileset)
+                continue;
+
             // now we find the real tileid, because somehow
             // the tileset id is into the tile_id, and we substract it
-            // though to be fair, this won't really support more than
-            // 1 tileset for now on
+            tile_id -= tileset_info.firstgid;
 
-            // WARNING : This only works if we go from the highest
-            // tileset first, so, if something goes wrong, maybe
-            // check that out
+            const auto& lookup = tileset_info.lookup(tile_id);
 
-            auto tileset_gid = extract_tileset_from_tileid(tile_id);
+            if(lookup.animation >= 0)
+            {
+                const auto& frames = tileset_info.tiles[lookup.info].animations;
 
-            if(tileset_gid != tileset_info.firstgid)
-                continue;
+                const int frame = animation_frames.empty()
+                                      ? 0
+                                      : animation_frames[lookup.animation];
 
-            tile_id -= tileset_gid;
+                geometry.animated_tiles.push_back(
+                    {static_cast<int>(geometry.vertices.size()), lookup.animation});
 
-            // Look if the tile is animated
+                tile_id = frames[frame].tile_id;
+            }
 
-            bool     found       = false;
-            unsigned found_index = -1;
+            push_tile(geometry.vertices, geometry.indexes, flagged_tile_id, tile_id, left,
+                      bottom, use_y_as_z, tileset_info, texture_width, texture_height);
+        }
+    }
+}
 
-            for(SizeType i = 0; i < tileset_info_size; i++)
-            {
-                if(tileset_info.tiles[i].id == tile_id)
-                {
-                    found       = true;
-                    found_index = i;
-                    break;
-                }
-            }
+void TilemapRenderer::build_chunk(Chunk& chunk)
+{
+    const auto& tileset_layer = tileset_layers_[chunk.tileset_layer];
+    const auto& layer         = tilemap_.tile_layers[tileset_layer.layer];
 
-            if(found)
-            {
-                if(!tileset_info.tiles[found_index].animations.empty())
-                {
-                    create_animated_tile(tile_id, texture, left, bottom,
-                                         tileset_tile_width, tileset_tile_height, e,
-                                         tileset_info.tiles[found_index].animations);
-                    // We move to the next tile
-                    continue;
-                }
-            }
+    const auto first_row    = chunk.row * chunk_size;
+    const auto first_column = chunk.column * chunk_size;
 
-            // Managing flips and rotations
+    geometry_.clear();
 
-            float      rotation_value {0.0f};
-            const auto pi = std::numbers::pi_v<float>;
+    build_geometry(tilemap_, tileset_layer.layer, tileset_layer.tileset, first_column,
+                   first_row,
+                   std::min(static_cast<int>(layer.width), first_column + chunk_size),
+                   std::min(static_cast<int>(layer.height), first_row + chunk_size),
+                   tileset_layer.texture->width(), tileset_layer.texture->height(),
+                   animation_frames_, geometry_);
 
-            bool flip_v {false};
-            bool flip_h {false};
+    chunk.animated_tiles = geometry_.animated_tiles;
 
-            if(!flipped_horizontally && flipped_vertically && flipped_diagonally)
-                rotation_value = pi / 2.0f;
+    auto& mesh = chunk.entity->get_component<MeshRenderer>()->_mesh;
 
-            if(flipped_horizontally && flipped_vertically && !flipped_diagonally)
-                rotation_value = pi;
+    mesh->set_vertices(geometry_.vertices.data(),
+                       static_cast<int>(geometry_.vertices.size()));
+    mesh->set_indices(geometry_.indexes.data(), static_cast<int>(geometry_.indexes.size()));
+    mesh->update_vertices();
+    mesh->build_bounding_volumes();
+
+    chunk.dirty = false;
+}
 
-            if(flipped_horizontally && !flipped_vertically && flipped_diagonally)
-                rotation_value = pi + pi / 2.0f;
+int TilemapRenderer::animation_frame(const Tilemap::AnimationInfo& animation,
+                                     double                        time) const
+{
+    const auto& frames =
+        tilemap_.tileset_infos[animation.tileset].tiles[animation.info].animations;
 
-            if(!flipped_horizontally && flipped_vertically && !flipped_diagonally)
-                flip_v = true;
+    if(animation.duration <= 0)
+        return 0;
 
-            if(flipped_horizontally && flipped_vertically && flipped_diagonally)
-            {
-                flip_v         = true;
-                rotation_value = pi / 2.0f;
-            }
+    auto t = static_cast<int>(std::fmod(time, static_cast<double>(animation.duration)));
 
-            if(flipped_horizontally && !flipped_vertically && !flipped_diagonally)
-                flip_h = true;
+    for(int i = 0; i < static_cast<int>(frames.size()); ++i)
+    {
+        if(t < frames[i].duration)
+            return i;
+        t -= frames[i].duration;
+    }
+    return static_cast<int>(frames.size()) - 1;
+}
 
-            if(!flipped_horizontally && !flipped_vertically && flipped_diagonally)
-            {
-                flip_h         = true;
-                rotation_value = pi / 2.0f;
-            }
+void TilemapRenderer::update_animations(float elapsed_time)
+{
+    if(tilemap_.animations.empty())
+        return;
 
-            Matrix mat = Matrix::rotation_z(rotation_value);
+    animation_clock_ += static_cast<double>(elapsed_time) * 1000.0;
 
-            // First step, tile, center, used with the rotation thing
+    bool changed = false;
 
-            float z_value = 0.0f;
+    for(std::size_t i = 0; i < tilemap_.animations.size(); ++i)
+    {
+        const int frame = animation_frame(tilemap_.animations[i], animation_clock_);
 
-            if(use_y_as_z)
-                z_value =
-                    -(bottom - tileset_tile_height / 2.0f - tileset_tile_height / 2.0f);
+        animation_changed_[i] = frame != animation_frames_[i];
+        animation_frames_[i]  = frame;
 
-            const auto ttw = static_cast<float>(tileset_tile_width);
-            const auto tth = static_cast<float>(tileset_tile_height);
+        changed |= animation_changed_[i] != 0;
+    }
 
-            Vec3 center(left + ttw / 2.0f, bottom - tth / 2.0f, z_value);
+    if(!changed)
+        return;
 
-            Vec3 v1(-ttw / 2.0f, tth / 2.0f, 0.0f);
-            Vec3 v2(-ttw / 2.0f, -tth / 2.0f, 0.0f);
-            Vec3 v3(ttw / 2.0f, -tth / 2.0f, 0.0f);
-            Vec3 v4(ttw / 2.0f, tth / 2.0f, 0.0f);
+    for(const auto index : loaded_chunks_)
+    {
+        auto& chunk = chunks_[index];
 
-            if(flip_v)
-            {
-                v1 = Vec3(-ttw / 2.0f, -tth / 2.0f, 0.0f);
-                v2 = Vec3(-ttw / 2.0f, tth / 2.0f, 0.0f);
-                v3 = Vec3(ttw / 2.0f, tth / 2.0f, 0.0f);
-                v4 = Vec3(ttw / 2.0f, -tth / 2.0f, 0.0f);
-            }
+        // Will be built with the right frames anyway
+        if(chunk.animated_tiles.empty() || chunk.dirty)
+            continue;
 
-            if(flip_h)
-            {
-                v1 = Vec3(ttw / 2.0f, tth / 2.0f, 0.0f);
-                v2 = Vec3(ttw / 2.0f, -tth / 2.0f, 0.0f);
-                v3 = Vec3(-ttw / 2.0f, -tth / 2.0f, 0.0f);
-                v4 = Vec3(-ttw / 2.0f, tth / 2.0f, 0.0f);
-            }
+        const auto& tileset_layer = tileset_layers_[chunk.tileset_layer];
+        const auto& tileset_info  = tilemap_.tileset_infos[tileset_layer.tileset];
 
-            // After rotating a tile, we put it back where it's supposed to be
+        auto& mesh     = chunk.entity->get_component<MeshRenderer>()->_mesh;
+        auto& vertices = mesh->vertices();
 
-            auto r1 = mat * v1 + center;
-            auto r2 = mat * v2 + center;
-            auto r3 = mat * v3 + center;
-            auto r4 = mat * v4 + center;
+        bool chunk_changed = false;
 
-            const auto tile_width_ratio  = ttw / static_cast<float>(texture->width());
-            const auto tile_height_ratio = tth / static_cast<float>(texture->height());
+        for(const auto& animated_tile : chunk.animated_tiles)
+        {
+            if(!animation_changed_[animated_tile.animation])
+                continue;
 
-            unsigned cols = texture->width() / tileset_info.tile_width;
+            const auto& animation = tilemap_.animations[animated_tile.animation];
+            const auto& frames    = tileset_info.tiles[animation.info].animations;
 
-            long long xcoord = tile_id % cols;
-            long long ycoord = tile_id / cols;
+            write_tile_uvs(vertices.data() + animated_tile.vertex,
+                           frames[animation_frames_[animated_tile.animation]].tile_id,
+                           tileset_info, tileset_layer.texture->width(),
+                           tileset_layer.texture->height());
 
-            Vec2 coord(xcoord * tile_width_ratio, 1.0f - ycoord * tile_height_ratio);
+            chunk_changed = true;
+        }
 
-            const int vertex_per_tile       = 4;
-            const int attributes_per_vertex = 8;
-            const int sum                   = vertex_per_tile * attributes_per_vertex;
+        if(chunk_changed)
+            mesh->update_vertices();
+    }
+}
 
-            vertices[current_tile * sum]     = r1.x;
-            vertices[current_tile * sum + 1] = r1.y;
-            vertices[current_tile * sum + 2] = r1.z;
+void TilemapRenderer::set_tile(int layer, int x, int y, long long tile_id)
+{
+    auto& tile_layer = tilemap_.tile_layers.at(layer);
 
-            vertices[current_tile * sum + 3] = coord.x;
-            vertices[current_tile * sum + 4] = coord.y;
+    const auto w = static_cast<int>(tile_layer.width);
 
-            vertices[(current_tile)*sum + 8]  = r2.x;
-            vertices[(current_tile)*sum + 9]  = r2.y;
-            vertices[(current_tile)*sum + 10] = r2.z;
+    assert(x >= 0 && x < w && y >= 0 && y < static_cast<int>(tile_layer.height));
 
-            vertices[(current_tile)*sum + 11] = coord.x;
-            vertices[(current_tile)*sum + 12] = coord.y - tex_tile_height;
+    tile_layer.data.set(static_cast<std::size_t>(y) * w + x, static_cast<std::uint32_t>(tile_id));
 
-            vertices[(current_tile)*sum + 16] = r3.x;
-            vertices[(current_tile)*sum + 17] = r3.y;
-            vertices[(current_tile)*sum + 18] = r3.z;
+    // The tile could have been drawn by any tileset of the layer, and the
+    // new one could use another one
+    for(const auto& tileset_layer : tileset_layers_)
+    {
+        if(tileset_layer.layer != layer)
+            continue;
 
-            vertices[(current_tile)*sum + 19] = coord.x + tex_tile_width;
-            vertices[(current_tile)*sum + 20] = coord.y - tex_tile_height;
+        auto& chunk = chunk_at(tileset_layer, x / chunk_size, y / chunk_size);
 
-            vertices[(current_tile)*sum + 24] = r4.x;
-            vertices[(current_tile)*sum + 25] = r4.y;
-            vertices[(current_tile)*sum + 26] = r4.z;
+        if(!chunk.empty)
+        {
+            chunk.dirty = true;
+            continue;
+        }
 
-            vertices[(current_tile)*sum + 27] = coord.x + tex_tile_width;
-            vertices[(current_tile)*sum + 28] = coord.y;
+        if(tileset_of(tilemap_, tile_id) != tileset_layer.tileset)
+            continue;
 
-            int in = (current_tile + 1) * 4 - 4;
+        // First tile of this tileset in the chunk. Streamed chunks are
+        // loaded once they're close enough to the camera
+        chunk.empty = false;
 
-            indices[current_tile * 6]     = in;
-            indices[current_tile * 6 + 1] = in + 1;
-            indices[current_tile * 6 + 2] = in + 2;
+        if(!streaming)
+            load_chunk(chunk);
+    }
+}
 
-            indices[current_tile * 6 + 3] = in;
-            indices[current_tile * 6 + 4] = in + 2;
-            indices[current_tile * 6 + 5] = in + 3;
+long long TilemapRenderer::tile(int layer, int x, int y) const
+{
+    const auto& tile_layer = tilemap_.tile_layers.at(layer);
+    return tile_layer.data[y * static_cast<int>(tile_layer.width) + x];
+}
 
-            current_tile++;
+void TilemapRenderer::stream(float left, float bottom, float right, float top)
+{
+    const auto chunk_width  = static_cast<float>(chunk_size * tilemap_.tile_width);
+    const auto chunk_height = static_cast<float>(chunk_size * tilemap_.tile_height);
+
+    for(const auto& tileset_layer : tileset_layers_)
+    {
+        const auto& layer = tilemap_.tile_layers[tileset_layer.layer];
+
+        // Chunk coordinates of the rectangle
+        const int first_column =
+            static_cast<int>(std::floor((left - layer.x) / chunk_width)) - stream_margin;
+        const int last_column =
+            static_cast<int>(std::floor((right - layer.x) / chunk_width)) + stream_margin;
+        const int first_row =
+            static_cast<int>(std::floor((layer.y - top) / chunk_height)) - stream_margin;
+        const int last_row =
+            static_cast<int>(std::floor((layer.y - bottom) / chunk_height)) + stream_margin;
+
+        for(int row = std::max(0, first_row);
+            row <= std::min(tileset_layer.rows - 1, last_row); ++row)
+        {
+            for(int column = std::max(0, first_column);
+                column <= std::min(tileset_layer.columns - 1, last_column); ++column)
+            {
+                auto& chunk = chunk_at(tileset_layer, column, row);
+
+                if(!chunk.entity && !chunk.empty)
+                    load_chunk(chunk);
+            }
         }
+
+        // Unloading the chunks of this layer that are too far away
+        loaded_chunks_.erase(
+            std::remove_if(loaded_chunks_.begin(), loaded_chunks_.end(),
+                           [&](int index)
+                           {
+                               auto& chunk = chunks_[index];
+
+                               if(&tileset_layers_[chunk.tileset_layer] != &tileset_layer)
+                                   return false;
+
+                               if(chunk.column >= first_column - 1 &&
+                                  chunk.column <= last_column + 1 &&
+                                  chunk.row >= first_row - 1 && chunk.row <= last_row + 1)
+                                   return false;
+
+                               unload_chunk(chunk);
+                               return true;
+                           }),
+            loaded_chunks_.end());
     }
 
-    mesh->set_vertices(vertices, tile_count * 8 * 4);
-    mesh->set_indices(indices, tile_count * 6);
+    rebuild_dirty_chunks();
+}
 
-    if(always_front)
+void TilemapRenderer::rebuild_dirty_chunks()
+{
+    for(const auto index : loaded_chunks_)
     {
-        mesh_renderer->material.enable_depth_test(false);
-        mesh_renderer->material.render_queue = 10000;
-    }
+        auto& chunk = chunks_[index];
 
-    mesh->update_vertices();
-    //mesh_renderer->material.polygon_mode(Material::PolygonMode::Line);
-    mesh_renderer->_mesh = mesh;
-    mesh->build_bounding_volumes();
+        if(chunk.dirty)
+            build_chunk(chunk);
+    }
 }
 
-int TilemapRenderer::extract_tileset_from_tileid(long long tile_id)
+void TilemapRenderer::invalidate_reloaded_tilesets(unsigned generation)
 {
-    for(unsigned i = tilemap_.tileset_infos.size() - 1; i > 0; i--)
+    for(const auto index : loaded_chunks_)
     {
-        const auto& tileset_info = tilemap_.tileset_infos[i];
+        auto& chunk = chunks_[index];
 
-        if(tileset_info.firstgid <= tile_id)
-            return tileset_info.firstgid;
+        if(ResourcesCache::reloaded_since(tileset_layers_[chunk.tileset_layer].texture,
+                                          generation))
+            chunk.dirty = true;
     }
+}
 
-    const auto& tileset_info = tilemap_.tileset_infos[0];
+const std::vector<TilemapRenderer::Chunk>& TilemapRenderer::chunks() const noexcept
+{
+    return chunks_;
+}
+
+int TilemapRenderer::loaded_chunk_count() const noexcept
+{
+    return static_cast<int>(loaded_chunks_.size());
+}
+
+RefEntity TilemapRenderer::root() const noexcept
+{
+    return root_;
+}
+
+int TilemapRenderer::extract_tileset_from_tileid(long long tile_id)
+{
+    const auto index = tilemap_.tileset_index(tile_id);
 
-    if(tileset_info.firstgid <= tile_id)
-        return tileset_info.firstgid;
     // TODO not to sure about that lol
-    return -1;
+    if(index < 0)
+        return -1;
+
+    return tilemap_.tileset_infos[index].firstgid;
 }
 
 void TilemapRenderer::generate_layer(RefEntity e, const Tilemap::TileLayer& tile_layer)
@@ -508,24 +670,50 @@ void TilemapRenderer::generate_layer(RefEntity e, const Tilemap::TileLayer& tile
 
 TilemapRenderer::TilemapRenderer() {}
 
-void TilemapRenderer::initialize(Tilemap tilemap, RefEntity e)
+void TilemapRenderer::initialize(const Tilemap& tilemap, RefEntity e)
+{
+    // Tile ids of mapped tilemaps are shared, not copied
+    initialize(Tilemap(tilemap), e);
+}
+
+void TilemapRenderer::initialize(Tilemap&& tilemap, RefEntity e)
 {
     tilemap_ = std::move(tilemap);
+    root_    = e;
     depth    = 0.0f;
 
+    tileset_layers_.clear();
+    chunks_.clear();
+    loaded_chunks_.clear();
+
+    tilemap_.build_lookup_tables();
+
+    animation_clock_ = 0.0;
+    animation_frames_.assign(tilemap_.animations.size(), 0);
+    animation_changed_.assign(tilemap_.animations.size(), 0);
+
     for(const auto& layer : tilemap_.tile_layers)
     {
         generate_layer(e, layer);
         depth += 0.1f;
     }
+
+    if(streaming)
+        return;
+
+    for(auto& chunk : chunks_)
+    {
+        if(!chunk.empty)
+            load_chunk(chunk);
+    }
 }
 
-void TilemapRenderer::generate_mesh(Tilemap tilemap, Tilemap::TileLayer layer)
+void TilemapRenderer::generate_mesh(const Tilemap& tilemap, const Tilemap::TileLayer& layer)
 {
     _height = static_cast<int>(layer.height);
     _width  = static_cast<int>(layer.width);
 
     layer_   = layer;
-    tilemap_ = std::move(tilemap);
+    tilemap_ = tilemap;
 }
 }    // namespace corgi
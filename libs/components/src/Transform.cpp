@@ -17,6 +17,8 @@ Transform::Transform(const Transform& other): _position(other._position),
 	_euler_angles(other._euler_angles),
 	_scale(other._scale),
 	_world_matrix(other._world_matrix),
+	_previous_world_matrix(other._previous_world_matrix),
+	_has_previous_world_matrix(other._has_previous_world_matrix),
 	_dirty(other._dirty),
 	_inverse_dirty(other._inverse_dirty),
 	is_world_(other.is_world_)
@@ -28,6 +30,8 @@ Transform::Transform(Transform&& other) noexcept:
 	_euler_angles(other._euler_angles),
 	_scale(other._scale),
 	_world_matrix(other._world_matrix),
+	_previous_world_matrix(other._previous_world_matrix),
+	_has_previous_world_matrix(other._has_previous_world_matrix),
 	_dirty(other._dirty),
 	_inverse_dirty(other._inverse_dirty),
 	is_world_(other.is_world_)
@@ -39,6 +43,8 @@ Transform& Transform::operator=(const Transform& other)
 	_euler_angles  = other._euler_angles;
 	_scale         = other._scale;
 	_world_matrix  = other._world_matrix;
+	_previous_world_matrix     = other._previous_world_matrix;
+	_has_previous_world_matrix = other._has_previous_world_matrix;
 	_dirty         = other._dirty;
 	_inverse_dirty = other._inverse_dirty;
 	is_world_      = other.is_world_;
@@ -52,6 +58,8 @@ Transform& Transform::operator=(Transform&& other) noexcept
 	_euler_angles		= other._euler_angles;
 	_scale				= other._scale;
 	_world_matrix		= other._world_matrix;
+	_previous_world_matrix		= other._previous_world_matrix;
+	_has_previous_world_matrix	= other._has_previous_world_matrix;
 	_dirty				= other._dirty;
 	_inverse_dirty		= other._inverse_dirty;
 	is_world_			= other.is_world_;
@@ -69,6 +77,24 @@ const Matrix& Transform::world_matrix() const noexcept
 	return _world_matrix;
 }
 
+const Matrix& Transform::previous_world_matrix() const noexcept
+{
+	return _previous_world_matrix;
+}
+
+Matrix Transform::interpolated_world_matrix(float alpha) const noexcept
+{
+	if (alpha >= 1.0f)
+		return _world_matrix;
+
+	// Blending the coefficients is exact for translations and scales, and
+	// close enough for the small rotations happening between 2 updates
+	Matrix m;
+	for (int i = 0; i < 16; i++)
+		m[i] = _previous_world_matrix[i] + (_world_matrix[i] - _previous_world_matrix[i]) * alpha;
+	return m;
+}
+
 bool Transform::is_world() const noexcept
 {
 	return is_world_;
@@ -0,0 +1,99 @@
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <stdexcept>
+#include <vector>
+
+namespace corgi
+{
+    /*!
+     * @brief   Index accessible array that grows by chunks of ChunkSize items
+     *
+     *          Growing only allocates new chunks, so items never move once
+     *          created and references to them stay valid until the container
+     *          is cleared or destroyed. Accessing an item costs a shift and a
+     *          mask instead of a single addition
+     *
+     * @tparam  ChunkSize   Number of items inside a chunk, must be a power of 2
+     */
+    template<class T, std::size_t ChunkSize = 1024>
+    class ChunkedVector
+    {
+        static_assert(ChunkSize != 0 && (ChunkSize & (ChunkSize - 1)) == 0,
+                      "ChunkSize must be a power of 2");
+
+    public:
+        static constexpr std::size_t chunk_size = ChunkSize;
+
+        // Capacity
+
+        [[nodiscard]] std::size_t size() const noexcept { return size_; }
+        [[nodiscard]] bool        empty() const noexcept { return size_ == 0; }
+
+        [[nodiscard]] std::size_t capacity() const noexcept
+        {
+            return chunks_.size() * ChunkSize;
+        }
+
+        [[nodiscard]] std::size_t chunk_count() const noexcept { return chunks_.size(); }
+
+        // Modifiers
+
+        /*!
+         * @brief   Default constructs items until the container holds @a size
+         *          items. Never shrinks the container
+         */
+        void resize(std::size_t size)
+        {
+            while(capacity() < size)
+                chunks_.push_back(std::make_unique<T[]>(ChunkSize));
+
+            if(size > size_)
+                size_ = size;
+        }
+
+        /*!
+         * @brief   Destroys every item and releases the chunks
+         */
+        void clear() noexcept
+        {
+            chunks_.clear();
+            size_ = 0;
+        }
+
+        // Element access
+
+        [[nodiscard]] T& operator[](std::size_t index) noexcept
+        {
+            return chunks_[index / ChunkSize][index & (ChunkSize - 1)];
+        }
+
+        [[nodiscard]] const T& operator[](std::size_t index) const noexcept
+        {
+            return chunks_[index / ChunkSize][index & (ChunkSize - 1)];
+        }
+
+        /*!
+         * @brief   Throws an out_of_range exception if @a index is greater or
+         *          equal to size()
+         */
+        [[nodiscard]] T& at(std::size_t index)
+        {
+            if(index >= size_)
+                throw std::out_of_range("ChunkedVector::at : index out of range");
+            return (*this)[index];
+        }
+
+        [[nodiscard]] const T& at(std::size_t index) const
+        {
+            if(index >= size_)
+                throw std::out_of_range("ChunkedVector::at : index out of range");
+            return (*this)[index];
+        }
+
+    private:
+        std::vector<std::unique_ptr<T[]>> chunks_;
+        std::size_t                       size_ {0};
+    };
+}    // namespace corgi
@@ -0,0 +1,200 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <functional>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace corgi
+{
+    /*!
+     * @brief   Ordered map storing its items inside a vector sorted by key
+     *
+     *          Searching is a binary search over contiguous memory, and
+     *          iterating is iterating over a vector, which is what maps built
+     *          once and read many times do the most. Inserting or erasing
+     *          moves every item after the modified one, so building a large
+     *          map should go through the constructor taking a vector
+     *
+     *          Iterators, pointers and references to the items are
+     *          invalidated by insertions and erasures
+     *
+     *          The keys of the items must not be modified through iterators
+     *
+     * @tparam  Compare     Orders the keys. With a transparent comparison, like
+     *                      the default std::less<>, the map can be searched with
+     *                      any type comparable with Key, like a string_view for
+     *                      string keys
+     */
+    template<class Key, class Value, class Compare = std::less<>>
+    class FlatMap
+    {
+        static constexpr bool is_transparent = requires { typename Compare::is_transparent; };
+
+    public:
+        using value_type     = std::pair<Key, Value>;
+        using iterator       = typename std::vector<value_type>::iterator;
+        using const_iterator = typename std::vector<value_type>::const_iterator;
+
+        // Lifecycle
+
+        FlatMap() = default;
+
+        /*!
+         * @brief   Sorts @a items once instead of inserting them one by one.
+         *          When several items use the same key, the first one is kept
+         */
+        explicit FlatMap(std::vector<value_type> items)
+            : items_(std::move(items))
+        {
+            std::stable_sort(items_.begin(), items_.end(),
+                             [](const value_type& a, const value_type& b)
+                             { return Compare()(a.first, b.first); });
+
+            items_.erase(std::unique(items_.begin(), items_.end(),
+                                     [](const value_type& a, const value_type& b)
+                                     { return !Compare()(a.first, b.first); }),
+                         items_.end());
+        }
+
+        // Iterators
+
+        [[nodiscard]] iterator       begin() noexcept { return items_.begin(); }
+        [[nodiscard]] const_iterator begin() const noexcept { return items_.begin(); }
+        [[nodiscard]] iterator       end() noexcept { return items_.end(); }
+        [[nodiscard]] const_iterator end() const noexcept { return items_.end(); }
+
+        // Capacity
+
+        [[nodiscard]] std::size_t size() const noexcept { return items_.size(); }
+        [[nodiscard]] bool        empty() const noexcept { return items_.empty(); }
+
+        void reserve(std::size_t count) { items_.reserve(count); }
+
+        // Lookup
+
+        template<class K = Key>
+        [[nodiscard]] iterator find(const K& key)
+        {
+            const auto& lookup = lookup_key(key);
+            auto        it     = lower_bound(lookup);
+            return it != items_.end() && !Compare()(lookup, it->first) ? it : items_.end();
+        }
+
+        template<class K = Key>
+        [[nodiscard]] const_iterator find(const K& key) const
+        {
+            return const_cast<FlatMap&>(*this).find(key);
+        }
+
+        template<class K = Key>
+        [[nodiscard]] bool contains(const K& key) const
+        {
+            return find(key) != items_.end();
+        }
+
+        /*!
+         * @brief   Throws an out_of_range exception if @a key isn't stored
+         *          inside the map
+         */
+        template<class K = Key>
+        [[nodiscard]] Value& at(const K& key)
+        {
+            auto it = find(key);
+
+            if(it == items_.end())
+                throw std::out_of_range("FlatMap::at : key not found");
+            return it->second;
+        }
+
+        template<class K = Key>
+        [[nodiscard]] const Value& at(const K& key) const
+        {
+            return const_cast<FlatMap&>(*this).at(key);
+        }
+
+        Value& operator[](const Key& key) { return try_emplace(key).first->second; }
+        Value& operator[](Key&& key) { return try_emplace(std::move(key)).first->second; }
+
+        // Modifiers
+
+        /*!
+         * @brief   Constructs the value with @a args if @a key isn't already
+         *          stored inside the map. Otherwise nothing happens
+         *
+         * @return  Returns an iterator to the item using @a key, and true if
+         *          it was inserted
+         */
+        template<class K, class... Args>
+        std::pair<iterator, bool> try_emplace(K&& key, Args&&... args)
+        {
+            if constexpr(!is_transparent && !std::is_same_v<std::remove_cvref_t<K>, Key>)
+                return try_emplace(Key(std::forward<K>(key)), std::forward<Args>(args)...);
+
+            auto it = lower_bound(key);
+
+            if(it != items_.end() && !Compare()(key, it->first))
+                return {it, false};
+
+            it = items_.emplace(it, std::piecewise_construct,
+                                std::forward_as_tuple(std::forward<K>(key)),
+                                std::forward_as_tuple(std::forward<Args>(args)...));
+            return {it, true};
+        }
+
+        std::pair<iterator, bool> insert(value_type item)
+        {
+            auto it = lower_bound(item.first);
+
+            if(it != items_.end() && !Compare()(item.first, it->first))
+                return {it, false};
+
+            return {items_.insert(it, std::move(item)), true};
+        }
+
+        /*!
+         * @brief   Removes the item using @a key, if any
+         *
+         * @return  Returns how many items were removed, 0 or 1
+         */
+        template<class K = Key>
+        std::size_t erase(const K& key)
+        {
+            auto it = find(key);
+
+            if(it == items_.end())
+                return 0;
+
+            items_.erase(it);
+            return 1;
+        }
+
+        iterator erase(const_iterator it) { return items_.erase(it); }
+        iterator erase(iterator it) { return items_.erase(it); }
+
+        void clear() noexcept { items_.clear(); }
+
+    private:
+        template<class K>
+        [[nodiscard]] static decltype(auto) lookup_key(const K& key)
+        {
+            if constexpr(is_transparent || std::is_same_v<K, Key>)
+                return (key);
+            else
+                return Key(key);
+        }
+
+        template<class K>
+        [[nodiscard]] iterator lower_bound(const K& key)
+        {
+            return std::lower_bound(items_.begin(), items_.end(), key,
+                                    [](const value_type& item, const K& k)
+                                    { return Compare()(item.first, k); });
+        }
+
+        std::vector<value_type> items_;
+    };
+}    // namespace corgi
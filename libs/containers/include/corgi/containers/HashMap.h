@@ -0,0 +1,677 @@
+#pragma once
+
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <iterator>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <utility>
+
+namespace corgi
+{
+    /*!
+     * @brief   Hash function used by HashMap
+     *
+     *          Strings are hashed as string_views, so a HashMap using strings
+     *          as keys can be searched with a string_view or a const char*
+     *          without building a string
+     */
+    template<class T>
+    struct Hash : std::hash<T>
+    {
+    };
+
+    template<>
+    struct Hash<std::string>
+    {
+        using is_transparent = void;
+
+        [[nodiscard]] std::size_t operator()(std::string_view string) const noexcept
+        {
+            return std::hash<std::string_view>()(string);
+        }
+    };
+
+    template<>
+    struct Hash<std::string_view> : Hash<std::string>
+    {
+    };
+
+    /*!
+     * @brief   Unordered map storing its items inside a single array, using
+     *          open addressing
+     *
+     *          Each slot of the array has a control byte, stored inside a
+     *          separate array. An empty or deleted slot has its highest bit
+     *          set, a full slot stores the 7 lowest bits of its key's hash.
+     *          Searching a key compares the control bytes 8 at a time, and
+     *          only compares the keys whose 7 bits match, so a lookup rarely
+     *          compares more than one key and never follows a pointer
+     *
+     *          Inserting can move every item, so iterators, pointers and
+     *          references to the items are invalidated by insertions.
+     *          Erasing leaves the other items where they are
+     *
+     *          The keys of the items must not be modified through iterators
+     *
+     * @tparam  Hash    Hash function. When it defines is_transparent, like the
+     *                  string one, the map can be searched with any type the
+     *                  hash and KeyEqual accept
+     */
+    template<class Key, class Value, class Hash = corgi::Hash<Key>, class KeyEqual = std::equal_to<>>
+    class HashMap
+    {
+        using Control = std::int8_t;
+
+        static constexpr Control empty_control   = -128;    // 0b10000000
+        static constexpr Control deleted_control = -2;      // 0b11111110
+
+        // Number of control bytes compared at once
+        static constexpr std::size_t group_width = 8;
+
+        static constexpr bool is_transparent = requires { typename Hash::is_transparent; };
+
+        // Lets find, contains and erase take any type when the hash is
+        // transparent. Otherwise the key is converted to Key first
+        template<class K>
+        [[nodiscard]] static decltype(auto) lookup_key(const K& key)
+        {
+            if constexpr(is_transparent || std::is_same_v<K, Key>)
+                return (key);
+            else
+                return Key(key);
+        }
+
+    public:
+        using value_type = std::pair<Key, Value>;
+
+        template<bool Const>
+        class Iterator
+        {
+        public:
+            using iterator_category = std::forward_iterator_tag;
+            using value_type        = HashMap::value_type;
+            using difference_type   = std::ptrdiff_t;
+            using pointer   = std::conditional_t<Const, const value_type*, value_type*>;
+            using reference = std::conditional_t<Const, const value_type&, value_type&>;
+
+            Iterator() = default;
+
+            // Lets an iterator be converted into a const iterator
+            template<bool OtherConst>
+                requires(Const && !OtherConst)
+            Iterator(const Iterator<OtherConst>& other) noexcept
+                : control_(other.control_)
+                , slot_(other.slot_)
+                , end_(other.end_)
+            {
+            }
+
+            reference operator*() const noexcept { return *slot_; }
+            pointer   operator->() const noexcept { return slot_; }
+
+            Iterator& operator++() noexcept
+            {
+                ++control_;
+                ++slot_;
+                skip_free_slots();
+                return *this;
+            }
+
+            Iterator operator++(int) noexcept
+            {
+                auto copy = *this;
+                ++*this;
+                return copy;
+            }
+
+            bool operator==(const Iterator& other) const noexcept { return slot_ == other.slot_; }
+
+        private:
+            friend class HashMap;
+
+            template<bool>
+            friend class Iterator;
+
+            Iterator(const Control* control, pointer slot, const Control* end) noexcept
+                : control_(control)
+                , slot_(slot)
+                , end_(end)
+            {
+            }
+
+            void skip_free_slots() noexcept
+            {
+                while(control_ != end_ && *control_ < 0)
+                {
+                    ++control_;
+                    ++slot_;
+                }
+            }
+
+            const Control* control_ {nullptr};
+            pointer        slot_ {nullptr};
+            const Control* end_ {nullptr};
+        };
+
+        using iterator       = Iterator<false>;
+        using const_iterator = Iterator<true>;
+
+        // Lifecycle
+
+        HashMap() = default;
+
+        ~HashMap() { release(); }
+
+        HashMap(const HashMap& other)
+        {
+            reserve(other.size_);
+
+            for(const auto& item : other)
+                insert_new(hash(item.first), item);
+        }
+
+        HashMap(HashMap&& other) noexcept { swap(other); }
+
+        HashMap& operator=(const HashMap& other)
+        {
+            if(this != &other)
+            {
+                HashMap copy(other);
+                swap(copy);
+            }
+            return *this;
+        }
+
+        HashMap& operator=(HashMap&& other) noexcept
+        {
+            if(this != &other)
+            {
+                release();
+                swap(other);
+            }
+            return *this;
+        }
+
+        void swap(HashMap& other) noexcept
+        {
+            std::swap(controls_, other.controls_);
+            std::swap(slots_, other.slots_);
+            std::swap(capacity_, other.capacity_);
+            std::swap(size_, other.size_);
+            std::swap(growth_left_, other.growth_left_);
+        }
+
+        // Iterators
+
+        [[nodiscard]] iterator begin() noexcept
+        {
+            iterator it(controls_, slots_, controls_ + capacity_);
+            it.skip_free_slots();
+            return it;
+        }
+
+        [[nodiscard]] const_iterator begin() const noexcept
+        {
+            const_iterator it(controls_, slots_, controls_ + capacity_);
+            it.skip_free_slots();
+            return it;
+        }
+
+        [[nodiscard]] iterator end() noexcept
+        {
+            return iterator(controls_ + capacity_, slots_ + capacity_, controls_ + capacity_);
+        }
+
+        [[nodiscard]] const_iterator end() const noexcept
+        {
+            return const_iterator(controls_ + capacity_, slots_ + capacity_,
+                                  controls_ + capacity_);
+        }
+
+        // Capacity
+
+        [[nodiscard]] std::size_t size() const noexcept { return size_; }
+        [[nodiscard]] bool        empty() const noexcept { return size_ == 0; }
+
+        /*!
+         * @brief   Returns how many slots the map allocated. The map grows
+         *          once 7/8 of them are used
+         */
+        [[nodiscard]] std::size_t capacity() const noexcept { return capacity_; }
+
+        /*!
+         * @brief   Allocates enough slots to store @a count items without
+         *          growing
+         */
+        void reserve(std::size_t count)
+        {
+            if(count > max_items(capacity_))
+                rehash(capacity_for(count));
+        }
+
+        // Lookup
+
+        template<class K = Key>
+        [[nodiscard]] iterator find(const K& key)
+        {
+            const auto index = index_of(key);
+            return index == capacity_ ? end() : iterator_at(index);
+        }
+
+        template<class K = Key>
+        [[nodiscard]] const_iterator find(const K& key) const
+        {
+            const auto index = index_of(key);
+            return index == capacity_ ? end() : const_iterator(iterator_at(index));
+        }
+
+        template<class K = Key>
+        [[nodiscard]] bool contains(const K& key) const
+        {
+            return index_of(key) != capacity_;
+        }
+
+        /*!
+         * @brief   Throws an out_of_range exception if @a key isn't stored
+         *          inside the map
+         */
+        template<class K = Key>
+        [[nodiscard]] Value& at(const K& key)
+        {
+            const auto index = index_of(key);
+
+            if(index == capacity_)
+                throw std::out_of_range("HashMap::at : key not found");
+            return slots_[index].second;
+        }
+
+        template<class K = Key>
+        [[nodiscard]] const Value& at(const K& key) const
+        {
+            const auto index = index_of(key);
+
+            if(index == capacity_)
+                throw std::out_of_range("HashMap::at : key not found");
+            return slots_[index].second;
+        }
+
+        Value& operator[](const Key& key) { return try_emplace(key).first->second; }
+        Value& operator[](Key&& key) { return try_emplace(std::move(key)).first->second; }
+
+        // Modifiers
+
+        /*!
+         * @brief   Constructs the value with @a args if @a key isn't already
+         *          stored inside the map. Otherwise nothing happens
+         *
+         * @return  Returns an iterator to the item using @a key, and true if
+         *          it was inserted
+         */
+        template<class K, class... Args>
+        std::pair<iterator, bool> try_emplace(K&& key, Args&&... args)
+        {
+            if constexpr(!is_transparent && !std::is_same_v<std::remove_cvref_t<K>, Key>)
+                return try_emplace(Key(std::forward<K>(key)), std::forward<Args>(args)...);
+
+            const auto h = hash(key);
+
+            if(const auto index = find_index(key, h); index != capacity_)
+                return {iterator_at(index), false};
+
+            const auto index =
+                insert_new(h, value_type(std::piecewise_construct,
+                                         std::forward_as_tuple(std::forward<K>(key)),
+                                         std::forward_as_tuple(std::forward<Args>(args)...)));
+            return {iterator_at(index), true};
+        }
+
+        std::pair<iterator, bool> insert(value_type item)
+        {
+            const auto h = hash(item.first);
+
+            if(const auto index = find_index(item.first, h); index != capacity_)
+                return {iterator_at(index), false};
+
+            return {iterator_at(insert_new(h, std::move(item))), true};
+        }
+
+        /*!
+         * @brief   Removes the item using @a key, if any
+         *
+         * @return  Returns how many items were removed, 0 or 1
+         */
+        template<class K = Key>
+        std::size_t erase(const K& key)
+        {
+            const auto index = index_of(key);
+
+            if(index == capacity_)
+                return 0;
+
+            erase_at(index);
+            return 1;
+        }
+
+        /*!
+         * @brief   Removes the item pointed by @a it and returns an iterator
+         *          to the next one
+         */
+        iterator erase(const_iterator it)
+        {
+            const auto index = static_cast<std::size_t>(it.slot_ - slots_);
+            erase_at(index);
+
+            auto next = iterator_at(index);
+            next.skip_free_slots();
+            return next;
+        }
+
+        iterator erase(iterator it) { return erase(const_iterator(it)); }
+
+        /*!
+         * @brief   Destroys every item but keeps the slots
+         */
+        void clear() noexcept
+        {
+            for(std::size_t i = 0; i < capacity_; i++)
+            {
+                if(controls_[i] >= 0)
+                    std::destroy_at(slots_ + i);
+            }
+
+            if(capacity_ != 0)
+                std::memset(controls_, empty_control, capacity_ + group_width);
+
+            size_        = 0;
+            growth_left_ = max_items(capacity_);
+        }
+
+    private:
+        // The standard hashes often return integers as is, so the bits are
+        // mixed before being split between the position and the control byte
+        template<class K>
+        [[nodiscard]] std::size_t hash(const K& key) const
+        {
+            auto h = static_cast<std::uint64_t>(Hash()(key));
+            h ^= h >> 32;
+            h *= 0x9E3779B97F4A7C15ull;
+            h ^= h >> 29;
+            return static_cast<std::size_t>(h);
+        }
+
+        // The 7 bits stored inside the control byte
+        [[nodiscard]] static Control h2(std::size_t hash) noexcept
+        {
+            return static_cast<Control>(hash & 0x7F);
+        }
+
+        // Where the probing starts
+        [[nodiscard]] static std::size_t h1(std::size_t hash) noexcept { return hash >> 7; }
+
+        [[nodiscard]] static std::size_t max_items(std::size_t capacity) noexcept
+        {
+            return capacity - capacity / 8;
+        }
+
+        // Smallest power of 2 storing @a count items without growing
+        [[nodiscard]] static std::size_t capacity_for(std::size_t count) noexcept
+        {
+            std::size_t capacity = group_width;
+
+            while(max_items(capacity) < count)
+                capacity *= 2;
+            return capacity;
+        }
+
+        /*!
+         * @brief   Loads 8 control bytes starting at @a index, the first one
+         *          inside the lowest byte
+         *
+         *          The first group_width control bytes are copied after the
+         *          last one, so a group can start anywhere
+         */
+        [[nodiscard]] std::uint64_t group(std::size_t index) const noexcept
+        {
+            std::uint64_t word;
+
+            if constexpr(std::endian::native == std::endian::little)
+            {
+                std::memcpy(&word, controls_ + index, sizeof word);
+            }
+            else
+            {
+                word = 0;
+
+                for(std::size_t i = 0; i < group_width; i++)
+                    word |= std::uint64_t(std::uint8_t(controls_[index + i])) << (8 * i);
+            }
+            return word;
+        }
+
+        static constexpr std::uint64_t lsbs = 0x0101010101010101ull;
+        static constexpr std::uint64_t msbs = 0x8080808080808080ull;
+
+        // Sets the highest bit of the bytes of @a group equal to @a control.
+        // Can report a byte following a match that isn't one, so the keys
+        // still need to be compared
+        [[nodiscard]] static std::uint64_t match(std::uint64_t group, Control control) noexcept
+        {
+            const auto x = group ^ (lsbs * std::uint8_t(control));
+            return (x - lsbs) & ~x & msbs;
+        }
+
+        [[nodiscard]] static std::uint64_t match_empty(std::uint64_t group) noexcept
+        {
+            // Only empty slots have their highest bit set and their second
+            // lowest bit cleared
+            return group & (~group << 6) & msbs;
+        }
+
+        [[nodiscard]] static std::uint64_t match_free(std::uint64_t group) noexcept
+        {
+            return group & msbs;
+        }
+
+        // Index of the byte whose highest bit is the lowest set inside @a mask
+        [[nodiscard]] static std::size_t first_match(std::uint64_t mask) noexcept
+        {
+            return static_cast<std::size_t>(std::countr_zero(mask)) / 8;
+        }
+
+        template<class K>
+        [[nodiscard]] std::size_t index_of(const K& key) const
+        {
+            const auto& lookup = lookup_key(key);
+            return find_index(lookup, hash(lookup));
+        }
+
+        /*!
+         * @brief   Returns the index of the slot storing @a key, or capacity_
+         *
+         *          Groups are probed quadratically : the nth group probed
+         *          starts n * (n + 1) / 2 groups after the first one, which
+         *          visits every group because the capacity is a power of 2
+         */
+        template<class K>
+        [[nodiscard]] std::size_t find_index(const K& key, std::size_t hash) const
+        {
+            if(capacity_ == 0)
+                return capacity_;
+
+            const auto mask    = capacity_ - 1;
+            const auto control = h2(hash);
+
+            auto position = h1(hash) & mask;
+
+            for(std::size_t step = group_width;; step += group_width)
+            {
+                const auto word = group(position);
+
+                for(auto matches = match(word, control); matches != 0; matches &= matches - 1)
+                {
+                    const auto index = (position + first_match(matches)) & mask;
+
+                    if(KeyEqual()(slots_[index].first, key))
+                        return index;
+                }
+
+                // The key would have been inserted inside the empty slot
+                if(match_empty(word) != 0)
+                    return capacity_;
+
+                position = (position + step) & mask;
+            }
+        }
+
+        // Returns the first empty or deleted slot of the probe sequence of
+        // @a hash
+        [[nodiscard]] std::size_t find_free_slot(std::size_t hash) const noexcept
+        {
+            const auto mask = capacity_ - 1;
+
+            auto position = h1(hash) & mask;
+
+            for(std::size_t step = group_width;; step += group_width)
+            {
+                if(const auto matches = match_free(group(position)); matches != 0)
+                    return (position + first_match(matches)) & mask;
+
+                position = (position + step) & mask;
+            }
+        }
+
+        void set_control(std::size_t index, Control control) noexcept
+        {
+            controls_[index] = control;
+
+            if(index < group_width)
+                controls_[capacity_ + index] = control;
+        }
+
+        // Inserts @a item, whose key isn't stored yet, and returns its index
+        std::size_t insert_new(std::size_t hash, value_type&& item)
+        {
+            if(growth_left_ == 0)
+            {
+                // Deleted slots count as used ones until the next rehash. When
+                // they're the ones filling the map, dropping them is enough
+                if(capacity_ == 0)
+                    rehash(group_width);
+                else if(size_ < max_items(capacity_) / 2)
+                    rehash(capacity_);
+                else
+                    rehash(capacity_ * 2);
+            }
+
+            const auto index = find_free_slot(hash);
+
+            // Reusing a deleted slot doesn't consume any growth
+            if(controls_[index] == empty_control)
+                growth_left_--;
+
+            std::construct_at(slots_ + index, std::move(item));
+            set_control(index, h2(hash));
+            size_++;
+            return index;
+        }
+
+        std::size_t insert_new(std::size_t hash, const value_type& item)
+        {
+            return insert_new(hash, value_type(item));
+        }
+
+        void erase_at(std::size_t index) noexcept
+        {
+            std::destroy_at(slots_ + index);
+            size_--;
+
+            // A search stops at the first group containing an empty slot. If
+            // every group containing this slot was full, a search may have
+            // gone past it, so the slot can only be marked as deleted
+            const auto mask = capacity_ - 1;
+
+            const auto empty_before = match_empty(group((index - group_width) & mask));
+            const auto empty_after  = match_empty(group(index));
+
+            const auto full_before = static_cast<std::size_t>(std::countl_zero(empty_before)) / 8;
+            const auto full_after  = static_cast<std::size_t>(std::countr_zero(empty_after)) / 8;
+
+            if(full_before + full_after < group_width)
+            {
+                set_control(index, empty_control);
+                growth_left_++;
+            }
+            else
+            {
+                set_control(index, deleted_control);
+            }
+        }
+
+        // Moves every item inside @a capacity new slots, dropping the deleted
+        // slots
+        void rehash(std::size_t capacity)
+        {
+            auto* old_controls = controls_;
+            auto* old_slots    = slots_;
+            auto  old_capacity = capacity_;
+
+            controls_    = new Control[capacity + group_width];
+            slots_       = std::allocator<value_type>().allocate(capacity);
+            capacity_    = capacity;
+            growth_left_ = max_items(capacity) - size_;
+
+            std::memset(controls_, empty_control, capacity + group_width);
+
+            for(std::size_t i = 0; i < old_capacity; i++)
+            {
+                if(old_controls[i] < 0)
+                    continue;
+
+                const auto h     = hash(old_slots[i].first);
+                const auto index = find_free_slot(h);
+
+                std::construct_at(slots_ + index, std::move(old_slots[i]));
+                std::destroy_at(old_slots + i);
+                set_control(index, h2(h));
+            }
+
+            if(old_capacity != 0)
+            {
+                delete[] old_controls;
+                std::allocator<value_type>().deallocate(old_slots, old_capacity);
+            }
+        }
+
+        void release() noexcept
+        {
+            if(capacity_ == 0)
+                return;
+
+            clear();
+            delete[] controls_;
+            std::allocator<value_type>().deallocate(slots_, capacity_);
+
+            controls_    = nullptr;
+            slots_       = nullptr;
+            capacity_    = 0;
+            growth_left_ = 0;
+        }
+
+        [[nodiscard]] iterator iterator_at(std::size_t index) const noexcept
+        {
+            return iterator(controls_ + index, slots_ + index, controls_ + capacity_);
+        }
+
+        Control*    controls_ {nullptr};    // capacity_ + group_width bytes
+        value_type* slots_ {nullptr};
+        std::size_t capacity_ {0};
+        std::size_t size_ {0};
+        std::size_t growth_left_ {0};       // Empty slots left before growing
+    };
+}    // namespace corgi
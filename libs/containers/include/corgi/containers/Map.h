@@ -1,68 +1,15 @@
 #pragma once
 
-#include <corgi/containers/binarytree.h>
+#include <corgi/containers/FlatMap.h>
 
 namespace corgi
 {
 	// @brief   A map stores pair of objects associated by key/value
-	//  Uses a binary search tree under the hood
+	//  Uses a FlatMap under the hood, so the items are iterated in the
+	//	order of their keys
 	template<class Key, class Value>
 	class Map
 	{
-		/*!
-			* @brief Associate a Key with a value
-			*/
-		class KeyValue
-		{
-		public:
-
-			// Constructors
-
-			explicit KeyValue() = default;
-
-			explicit KeyValue(Key k)
-				:_key(k) {}
-
-			explicit  KeyValue(Key k, Value v) 
-				: _key(k), _value(v) {}
-
-			// Comparison operators
-
-			bool operator==(const KeyValue& rh) const 
-			{
-				// Maybe this is cheating, but this allow the Binary tree to only
-				// look for the key
-				return (_key == rh._key);
-			}
-
-			bool operator>(const KeyValue& rh)const 
-			{
-				return _key > rh._key;
-			}
-
-			bool operator<(const KeyValue& rh)const 
-			{
-				return _key < rh._key;
-			}
-
-			// Getters
-
-			Key key()const 
-			{
-				return _key;
-			}
-
-			Value value() const 
-			{
-				return _value;
-			}
-
-		private:
-
-			Key     _key;
-			Value   _value;
-		};
-
 	public:
 
 		// Constructors
@@ -78,68 +25,78 @@ namespace corgi
 
 		auto begin()
 		{
-			return _binary_tree.begin();
+			return _flat_map.begin();
 		}
 
 		auto end()
 		{
-			return _binary_tree.end();
+			return _flat_map.end();
+		}
+
+		auto begin() const
+		{
+			return _flat_map.begin();
+		}
+
+		auto end() const
+		{
+			return _flat_map.end();
 		}
 
 		/*!
 			* @brief Try to find the value associated to the @ref key
-			* If the key isn't associated to any value, return a default object
-			* /!\ Warning, if the key doesn't exist, an exception will be sent
-			* or undefined behavior
+			* /!\ Warning, if the key doesn't exist, an out_of_range
+			* exception is thrown
 			*/
-		Value value(Key key)
+		Value value(const Key& key) const
 		{
-			return _binary_tree.find(KeyValue(key))->value().value();
+			return _flat_map.at(key);
 		}
 
 		/*!
-			* @brief Add a key/value pair to the map
+			* @brief Add a key/value pair to the map. Nothing happens if the
+			* key already exist
 			*/
 		void add(Key key, Value value)
 		{
-			_binary_tree.insert(KeyValue(key, value));
+			_flat_map.try_emplace(std::move(key), std::move(value));
 		}
 
 		/*!
 			* @brief Returns true if the map doesn't store any item
 			*/
-		bool empty()const 
+		bool empty()const
 		{
-			return _binary_tree.size() == 0;
+			return _flat_map.empty();
 		}
 
 		/*!
 			* @brief Removes a key-value pair from the map
 			*/
-		void remove(Key key) 
+		void remove(const Key& key)
 		{
-			_binary_tree.remove(KeyValue(key));
+			_flat_map.erase(key);
 		}
 
 		/*!
 			* @brief Check if @ref key exist inside the map
 			* @returns Returns true if key exist, false otherwise
 			*/
-		bool key_exist(Key key) 
+		bool key_exist(const Key& key) const
 		{
-			return _binary_tree.find(KeyValue(key)) != nullptr;
+			return _flat_map.contains(key);
 		}
 
 		/*!
 			* @brief Returns how many items are stored inside the map
 			*/
-		int size() const 
+		int size() const
 		{
-			return _binary_tree.size();
+			return static_cast<int>(_flat_map.size());
 		}
 
 	private:
 
-		BinaryTree<KeyValue> _binary_tree;
+		FlatMap<Key, Value> _flat_map;
 	};
-}
\ No newline at end of file
+}
@@ -0,0 +1,64 @@
+#include <corgi/containers/ChunkedVector.h>
+#include <corgi/test/test.h>
+
+#include <stdexcept>
+
+using namespace corgi;
+using namespace corgi::test;
+
+class TestChunkedVector : public Test
+{
+public:
+    ChunkedVector<int, 4> vector;
+};
+
+TEST_F(TestChunkedVector, Empty)
+{
+    assert_that(vector.size(), equals(0u));
+    assert_that(vector.empty(), equals(true));
+    assert_that(vector.capacity(), equals(0u));
+}
+
+TEST_F(TestChunkedVector, Resize)
+{
+    vector.resize(5);
+
+    assert_that(vector.size(), equals(5u));
+    assert_that(vector.chunk_count(), equals(2u));
+    assert_that(vector.capacity(), equals(8u));
+    assert_that(vector[4], equals(0));
+
+    // Resizing never shrinks the container
+    vector.resize(2);
+    assert_that(vector.size(), equals(5u));
+}
+
+TEST_F(TestChunkedVector, ItemsNeverMove)
+{
+    vector.resize(3);
+    vector[2] = 42;
+
+    const int* address = &vector[2];
+
+    vector.resize(100);
+
+    assert_that(&vector[2] == address, equals(true));
+    assert_that(vector[2], equals(42));
+}
+
+TEST_F(TestChunkedVector, At)
+{
+    vector.resize(3);
+
+    bool thrown = false;
+
+    try
+    {
+        (void)vector.at(3);
+    }
+    catch(const std::out_of_range&)
+    {
+        thrown = true;
+    }
+    assert_that(thrown, equals(true));
+}
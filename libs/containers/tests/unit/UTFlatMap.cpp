@@ -0,0 +1,111 @@
+#include <corgi/containers/FlatMap.h>
+#include <corgi/containers/Map.h>
+#include <corgi/test/test.h>
+
+#include <stdexcept>
+#include <string>
+#include <string_view>
+
+using namespace corgi;
+using namespace corgi::test;
+
+class TestFlatMap : public Test
+{
+public:
+    FlatMap<std::string, int> map;
+};
+
+TEST_F(TestFlatMap, Empty)
+{
+    assert_that(map.size(), equals(0u));
+    assert_that(map.empty(), equals(true));
+    assert_that(map.contains("key"), equals(false));
+}
+
+TEST_F(TestFlatMap, Sorted)
+{
+    map["c"] = 3;
+    map["a"] = 1;
+    map["b"] = 2;
+
+    std::string keys;
+
+    for(const auto& [key, value] : map)
+        keys += key;
+
+    assert_that(keys, equals(std::string("abc")));
+}
+
+TEST_F(TestFlatMap, Insert)
+{
+    assert_that(map.try_emplace("first", 1).second, equals(true));
+    assert_that(map.try_emplace("first", 2).second, equals(false));
+    assert_that(map.at("first"), equals(1));
+    assert_that(map.size(), equals(1u));
+}
+
+TEST_F(TestFlatMap, StringViewLookup)
+{
+    map["texture.tex"] = 42;
+
+    const std::string_view key = "texture.tex";
+
+    assert_that(map.find(key) != map.end(), equals(true));
+    assert_that(map.find(key)->second, equals(42));
+    assert_that(map.contains(std::string_view("shader.vs")), equals(false));
+}
+
+TEST_F(TestFlatMap, Erase)
+{
+    map["first"]  = 1;
+    map["second"] = 2;
+
+    assert_that(map.erase("first"), equals(1u));
+    assert_that(map.erase("first"), equals(0u));
+    assert_that(map.size(), equals(1u));
+    assert_that(map.contains("second"), equals(true));
+}
+
+TEST_F(TestFlatMap, BuildFromVector)
+{
+    FlatMap<int, int> built({{3, 30}, {1, 10}, {3, 31}, {2, 20}});
+
+    assert_that(built.size(), equals(3u));
+    assert_that(built.begin()->first, equals(1));
+
+    // The first item using a key is kept
+    assert_that(built.at(3), equals(30));
+}
+
+TEST_F(TestFlatMap, At)
+{
+    bool thrown = false;
+
+    try
+    {
+        (void)map.at("missing");
+    }
+    catch(const std::out_of_range&)
+    {
+        thrown = true;
+    }
+
+    assert_that(thrown, equals(true));
+}
+
+TEST(TestMap, SortedInsertions)
+{
+    Map<int, int> map;
+
+    for(int i = 0; i < 1000; i++)
+        map.add(i, i * 2);
+
+    assert_that(map.size(), equals(1000));
+    assert_that(map.value(500), equals(1000));
+    assert_that(map.key_exist(999), equals(true));
+
+    map.remove(999);
+
+    assert_that(map.key_exist(999), equals(false));
+    assert_that(map.empty(), equals(false));
+}
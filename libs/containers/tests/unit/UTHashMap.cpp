@@ -0,0 +1,146 @@
+#include <corgi/containers/HashMap.h>
+#include <corgi/test/test.h>
+
+#include <stdexcept>
+#include <string>
+#include <string_view>
+
+using namespace corgi;
+using namespace corgi::test;
+
+class TestHashMap : public Test
+{
+public:
+    HashMap<std::string, int> map;
+};
+
+TEST_F(TestHashMap, Empty)
+{
+    assert_that(map.size(), equals(0u));
+    assert_that(map.empty(), equals(true));
+    assert_that(map.capacity(), equals(0u));
+    assert_that(map.begin() == map.end(), equals(true));
+    assert_that(map.contains("key"), equals(false));
+}
+
+TEST_F(TestHashMap, Insert)
+{
+    map["first"] = 1;
+
+    auto [it, inserted] = map.try_emplace("second", 2);
+
+    assert_that(inserted, equals(true));
+    assert_that(it->second, equals(2));
+
+    // Existing keys are left alone
+    auto [existing, inserted_again] = map.try_emplace("second", 3);
+
+    assert_that(inserted_again, equals(false));
+    assert_that(existing->second, equals(2));
+    assert_that(map.size(), equals(2u));
+}
+
+TEST_F(TestHashMap, StringViewLookup)
+{
+    map["texture.tex"] = 42;
+
+    const std::string_view key = "texture.tex";
+
+    assert_that(map.find(key) != map.end(), equals(true));
+    assert_that(map.find(key)->second, equals(42));
+    assert_that(map.contains(std::string_view("shader.vs")), equals(false));
+}
+
+TEST_F(TestHashMap, Erase)
+{
+    map["first"]  = 1;
+    map["second"] = 2;
+
+    assert_that(map.erase("first"), equals(1u));
+    assert_that(map.erase("first"), equals(0u));
+    assert_that(map.size(), equals(1u));
+    assert_that(map.contains("first"), equals(false));
+    assert_that(map.at("second"), equals(2));
+}
+
+TEST_F(TestHashMap, Grow)
+{
+    for(int i = 0; i < 1000; i++)
+        map[std::to_string(i)] = i;
+
+    assert_that(map.size(), equals(1000u));
+
+    for(int i = 0; i < 1000; i++)
+        assert_that(map.at(std::to_string(i)), equals(i));
+
+    int sum = 0;
+
+    for(const auto& [key, value] : map)
+        sum += value;
+
+    assert_that(sum, equals(499500));
+}
+
+TEST_F(TestHashMap, EraseAndInsert)
+{
+    // Erased slots must be reused, or at least dropped, instead of growing
+    // the map forever
+    for(int i = 0; i < 10000; i++)
+    {
+        map[std::to_string(i)] = i;
+        map.erase(std::to_string(i));
+    }
+
+    assert_that(map.empty(), equals(true));
+    assert_that(map.capacity() <= 16u, equals(true));
+}
+
+TEST_F(TestHashMap, EraseIterator)
+{
+    for(int i = 0; i < 100; i++)
+        map[std::to_string(i)] = i;
+
+    for(auto it = map.begin(); it != map.end();)
+    {
+        if(it->second % 2 == 0)
+            it = map.erase(it);
+        else
+            ++it;
+    }
+
+    assert_that(map.size(), equals(50u));
+    assert_that(map.contains("3"), equals(true));
+    assert_that(map.contains("4"), equals(false));
+}
+
+TEST_F(TestHashMap, Copy)
+{
+    map["first"] = 1;
+
+    auto copy = map;
+    copy["first"] = 2;
+
+    assert_that(map.at("first"), equals(1));
+    assert_that(copy.at("first"), equals(2));
+
+    auto moved = std::move(copy);
+
+    assert_that(moved.at("first"), equals(2));
+    assert_that(copy.empty(), equals(true));
+}
+
+TEST_F(TestHashMap, At)
+{
+    bool thrown = false;
+
+    try
+    {
+        (void)map.at("missing");
+    }
+    catch(const std::out_of_range&)
+    {
+        thrown = true;
+    }
+
+    assert_that(thrown, equals(true));
+}
@@ -2,7 +2,10 @@
 
 #include <corgi/ecs/EntityId.h>
 #include <corgi/ecs/RefEntity.h>
+#include <corgi/ecs/TypeId.h>
 
+#include <algorithm>
+#include <memory>
 #include <vector>
 
 namespace corgi
@@ -35,6 +38,11 @@ public:
     virtual void* add(EntityId id, void* comp) = 0;
     virtual void  remove(EntityId id)          = 0;
 
+    /*!
+	 * @brief	Removes every component
+	 */
+    virtual void clear() noexcept = 0;
+
     // Lookup
 
     /*!
@@ -80,6 +88,36 @@ public:
 	 */
     virtual void*       at(size_t index)       = 0;
     virtual const void* at(size_t index) const = 0;
+
+    // Bulk operations
+
+    /*!
+	 * @brief	Returns the id of the pool's component type. See component_type_id
+	 */
+    [[nodiscard]] virtual TypeId type_id() const noexcept = 0;
+
+    /*!
+	 * @brief	Returns a new, empty pool storing the same component type
+	 */
+    [[nodiscard]] virtual std::unique_ptr<AbstractComponentPool> make_empty() const = 0;
+
+    /*!
+	 * @brief	Copies every component of @a source @a copies times
+	 *
+	 *			@a source must store the same component type. Its components
+	 *			are attached to indexes, not entities : the component attached
+	 *			to index n in the copy c goes to the entity ids[c * stride + n]
+	 */
+    virtual void append_copies(const AbstractComponentPool& source,
+                               const EntityId*              ids,
+                               size_t                       stride,
+                               size_t                       copies) = 0;
+
+    /*!
+	 * @brief	Exchanges the components of the pool with the ones of @a other,
+	 *			which must store the same component type
+	 */
+    virtual void swap_components(AbstractComponentPool& other) noexcept = 0;
 };
 
 template<class T>
@@ -199,9 +237,11 @@ public:
 
         _entity_id_to_components_vector[id.id_] = EntityId::npos;
 
+        // Entities without component are marked with npos, which is
+        // greater than any index
         for(auto& ind : _entity_id_to_components_vector)
         {
-            if(ind > index)
+            if(ind != EntityId::npos && ind > index)
                 ind--;
         }
     }
@@ -236,6 +276,86 @@ public:
         return components_.at(_entity_id_to_components_vector.at(id.id_));
     }
 
+    [[nodiscard]] TypeId type_id() const noexcept override { return component_type_id<T>(); }
+
+    [[nodiscard]] std::unique_ptr<AbstractComponentPool> make_empty() const override
+    {
+        return std::make_unique<ComponentPool<T>>();
+    }
+
+    void append_copies(const AbstractComponentPool& source,
+                       const EntityId*              ids,
+                       size_t                       stride,
+                       size_t                       copies) override
+    {
+        const auto& other = static_cast<const ComponentPool<T>&>(source);
+
+        if(other.empty() || copies == 0)
+            return;
+
+        // We only grow the arrays once, for every copy
+        size_t max_id = 0;
+
+        for(size_t c = 0; c < copies; c++)
+            for(auto index : other.component_index_to_entity_id_)
+                max_id = std::max(max_id, ids[c * stride + index].id_);
+
+        if(max_id >= _entity_id_to_components_vector.size())
+            _entity_id_to_components_vector.resize(max_id + 1u, EntityId::npos);
+
+        components_.reserve(components_.size() + other.size() * copies);
+        component_index_to_entity_id_.reserve(components_.capacity());
+
+        for(size_t c = 0; c < copies; c++)
+        {
+            for(size_t i = 0; i < other.size(); i++)
+            {
+                const auto id = ids[c * stride + other.component_index_to_entity_id_[i]].id_;
+
+                _entity_id_to_components_vector[id] = components_.size();
+                component_index_to_entity_id_.push_back(id);
+                components_.push_back(other.components_[i]);
+            }
+        }
+    }
+
+    void swap_components(AbstractComponentPool& other) noexcept override
+    {
+        auto& pool = static_cast<ComponentPool<T>&>(other);
+
+        components_.swap(pool.components_);
+        component_index_to_entity_id_.swap(pool.component_index_to_entity_id_);
+        _entity_id_to_components_vector.swap(pool._entity_id_to_components_vector);
+    }
+
+    void clear() noexcept override
+    {
+        components_.clear();
+        component_index_to_entity_id_.clear();
+        _entity_id_to_components_vector.clear();
+    }
+
+    /*!
+	 * @brief	Replaces the pool's content. The component components[i] is
+	 *			attached to the entity entity_ids[i]
+	 */
+    void assign(std::vector<size_t>&& entity_ids, std::vector<T>&& components)
+    {
+        component_index_to_entity_id_ = std::move(entity_ids);
+        components_                   = std::move(components);
+
+        size_t max_id = 0;
+
+        for(auto id : component_index_to_entity_id_)
+            max_id = std::max(max_id, id);
+
+        _entity_id_to_components_vector.assign(
+            component_index_to_entity_id_.empty() ? 0 : max_id + 1u, EntityId::npos);
+
+        for(size_t i = 0; i < component_index_to_entity_id_.size(); i++)
+            _entity_id_to_components_vector[component_index_to_entity_id_[i]] = i;
+    }
+
     [[nodiscard]] Ref<T> get_ref(EntityId id) { return Ref<T>(*this, id); }
 
     [[nodiscard]] ConstRef<T> get_const_ref(EntityId id) const
@@ -3,8 +3,10 @@
 #include <map>
 #include <memory>
 #include <typeindex>
+#include <vector>
 
 #include <corgi/ecs/ComponentPool.h>
+#include <corgi/ecs/TypeId.h>
 
 namespace corgi
 {
@@ -28,15 +30,20 @@ public:
 	template <class T>
 	[[nodiscard]] ComponentPool<T>* get()
 	{
-		if(!pools_.contains(typeid(T)))
+		auto* pool = find(component_type_id<T>());
+
+		if(pool == nullptr)
+		{
 			add<T>();
-		return dynamic_cast<ComponentPool<T>*>(get(typeid(T)));
+			pool = find(component_type_id<T>());
+		}
+		return static_cast<ComponentPool<T>*>(pool);
 	}
 
 	template <class T>
 	[[nodiscard]] const ComponentPool<T>* get() const
 	{
-		return dynamic_cast<const ComponentPool<T>*>(get(typeid(T)));
+		return static_cast<const ComponentPool<T>*>(find(component_type_id<T>()));
 	}
 
 	[[nodiscard]] const AbstractComponentPool* get(std::type_index t)const;
@@ -55,9 +62,17 @@ public:
 		if(contains<T>())
 			return;
 
-		pools_.emplace(typeid(T), new ComponentPool<T>(size));
+		add(typeid(T), std::make_unique<ComponentPool<T>>(size));
 	}
 
+	/*!
+	* @brief	Adds a pool whose type is only known at runtime. Does nothing
+	*			if a pool of the same type already exists
+	*
+	* @return	Returns the pool stored for that type
+	*/
+	AbstractComponentPool* add(std::type_index type, std::unique_ptr<AbstractComponentPool> pool);
+
 	/*!
 	* @brief	Removes a pool of type @a T from the list (if it exists)
 	*/
@@ -77,18 +92,36 @@ public:
 	template <class T>
 	[[nodiscard]] bool contains() const noexcept
 	{
-		return contains(typeid(T));
+		return find(component_type_id<T>()) != nullptr;
 	}
 
 	[[nodiscard]] bool contains(std::type_index t)const noexcept;
 
-	std::map<std::type_index, std::unique_ptr<AbstractComponentPool>>::iterator
-	begin();
-	std::map<std::type_index, std::unique_ptr<AbstractComponentPool>>::iterator
-	end();
+	/*!
+	 * @brief	Iterates over the pools. Adding or removing a pool goes
+	 *			through add and remove, so the type ids stay in sync
+	 */
+	[[nodiscard]] std::map<std::type_index, std::unique_ptr<AbstractComponentPool>>::const_iterator
+	begin() const noexcept;
+	[[nodiscard]] std::map<std::type_index, std::unique_ptr<AbstractComponentPool>>::const_iterator
+	end() const noexcept;
 
 private:
 
+	/*!
+	 * @brief	Returns the pool of the component type with the given id, or
+	 *			nullptr if there's none
+	 */
+	[[nodiscard]] AbstractComponentPool* find(TypeId id) const noexcept
+	{
+		return id < pools_by_id_.size() ? pools_by_id_[id] : nullptr;
+	}
+
 	std::map<std::type_index, std::unique_ptr<AbstractComponentPool>> pools_;
+
+	// Non owning pointers to the pools, indexed by component_type_id<T>(),
+	// so the templated accessors don't need to search the map
+	std::vector<AbstractComponentPool*> pools_by_id_;
+	std::map<std::type_index, TypeId>   type_ids_;
 };
 }
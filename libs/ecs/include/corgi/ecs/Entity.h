@@ -5,7 +5,13 @@
 #include <corgi/ecs/RefEntity.h>
 #include <corgi/ecs/Scene.h>
 
+#include <cstdint>
+#include <iterator>
+#include <limits>
+#include <string>
+#include <string_view>
 #include <typeindex>
+#include <utility>
 #include <vector>
 
 namespace corgi
@@ -17,6 +23,8 @@ namespace corgi
 class Entity
 {
     friend class Scene;
+    friend class Prefab;
+    friend class SceneSnapshot;
     friend class Game;
     friend class Renderer;
     friend class Physic;
@@ -54,22 +62,87 @@ public:
         [[nodiscard]] bool operator==(const Iterator& iterator) const;
 
     private:
+        // Only used when iterating breadth first, depth first iterations
+        // follow the scene's hierarchy links instead
         std::deque<RefEntity> queue_;
         IteratorMode          mode_ {IteratorMode::DepthFirst};
         bool                  recursive_ {true};
         RefEntity             current_node_;
+        EntityId              root_;
+    };
+
+    /*!
+	 * @brief	Range over the direct children of an entity
+	 *
+	 *			Children aren't stored by the entity, the range follows the
+	 *			sibling links kept by the scene. Accessing a child by its
+	 *			position walks through the previous ones
+	 */
+    class Children
+    {
+    public:
+        class iterator
+        {
+        public:
+            using iterator_category = std::forward_iterator_tag;
+            using value_type        = RefEntity;
+            using difference_type   = std::ptrdiff_t;
+            using pointer           = RefEntity;
+            using reference         = RefEntity;
+
+            iterator() = default;
+            iterator(Scene* scene, std::uint32_t index) noexcept;
+
+            [[nodiscard]] RefEntity operator*() const;
+
+            iterator& operator++() noexcept;
+
+            [[nodiscard]] bool operator==(const iterator& other) const noexcept
+            {
+                return index_ == other.index_;
+            }
+
+            [[nodiscard]] bool operator!=(const iterator& other) const noexcept
+            {
+                return index_ != other.index_;
+            }
+
+        private:
+            Scene*        scene_ {nullptr};
+            std::uint32_t index_ {std::numeric_limits<std::uint32_t>::max()};
+        };
+
+        Children(Scene& scene, EntityId parent) noexcept;
+
+        [[nodiscard]] iterator begin() const noexcept;
+        [[nodiscard]] iterator end() const noexcept;
+
+        [[nodiscard]] std::size_t size() const noexcept;
+        [[nodiscard]] bool        empty() const noexcept;
+
+        [[nodiscard]] RefEntity front() const;
+        [[nodiscard]] RefEntity back() const;
+
+        /*!
+		 * @brief	Throws an out_of_range exception if @a index is greater or
+		 *			equal to size()
+		 */
+        [[nodiscard]] RefEntity at(std::size_t index) const;
+
+    private:
+        Scene*   scene_;
+        EntityId parent_;
     };
 
     // Lifecycle
 
     Entity() = default;
-    Entity(EntityId id, Scene& scene, const char* name = "");
 
     /*!
-		 * @brief	Entity without a scene can only be built by another already
-		 *			attached entity
-		 */
-    Entity(EntityId id, RefEntity parent, const char* name = "NewEntity");
+	 * @brief	Entities are created by the scene, which also links them to
+	 *			their parent
+	 */
+    Entity(EntityId id, Scene& scene, StringPool::Handle name = StringPool::npos);
 
     ~Entity();
 
@@ -104,15 +177,45 @@ public:
 		 * @brief	Tries to find an entity called @a name in the entity's children
 		 *
 		 *			This functions is recursive, meaning it'll also checks inside
-		 *			the children's children
+		 *			the children's children. If several entities share the same
+		 *			name, the first one in depth first order is returned
+		 *
+		 *			The scene keeps an index of the entities' names, so we only
+		 *			check if the entities called @a name are inside our subtree
+		 *			instead of walking through it
 		 *
 		 * @param	name Name of the entity we try to find
 		 *
-		 * @return	std::optional holds std::nullopt if no entity could be found. Otherwise,
-		 *			returns a std::reference_wrapper to our Entity
+		 * @return	Returns an invalid RefEntity if no entity could be found
 		 */
     [[nodiscard]] RefEntity find(const char* name) noexcept;
 
+    /*!
+		 * @brief	Returns every entity called @a name inside the entity's
+		 *			subtree, in no particular order
+		 */
+    [[nodiscard]] std::vector<RefEntity> find_all(std::string_view name);
+
+    /*!
+		 * @brief	Returns the first entity tagged with @a tag inside the
+		 *			entity's subtree, in depth first order
+		 */
+    [[nodiscard]] RefEntity find_by_tag(std::string_view tag);
+
+    // Tags
+
+    /*!
+		 * @brief	Adds a tag to the entity. Does nothing if the entity
+		 *			already has the tag
+		 */
+    void add_tag(std::string_view tag);
+
+    void remove_tag(std::string_view tag);
+
+    [[nodiscard]] bool has_tag(std::string_view tag) const noexcept;
+
+    [[nodiscard]] const std::vector<std::string>& tags() const noexcept;
+
     // Functions
 
     /*!
@@ -123,6 +226,13 @@ public:
 
     [[nodiscard]] Scene& scene() noexcept;
 
+    /*!
+		 * @brief	Moves the entity, and its children, under @a new_parent
+		 *
+		 *			The entity is attached to the scene's root if @a new_parent
+		 *			is invalid. Throws an invalid_argument exception if
+		 *			@a new_parent is the entity itself or one of its children
+		 */
     void parent(RefEntity new_parent);
 
     void clear() noexcept;
@@ -174,14 +284,9 @@ public:
     void disable();
 
     /*!
-		 * @brief	Returns the entity's children list as a const reference
-		 */
-    [[nodiscard]] const std::vector<RefEntity>& children() const noexcept;
-
-    /*!
-		 * @brief	Returns the entity's children list as a reference
+		 * @brief	Returns the entity's children, in the order they were added
 		 */
-    [[nodiscard]] std::vector<RefEntity>& children() noexcept;
+    [[nodiscard]] Children children() const noexcept;
 
     RefEntity emplace_back(const char* name);
 
@@ -199,9 +304,7 @@ public:
     template<class T, class... Args>
     Ref<T> add_component(Args&&... args)
     {
-        if(!scene_->component_maps().contains<T>())
-            scene_->component_maps().add<T>();
-
+        // get adds the pool if it doesn't exist yet
         return scene_->component_maps().get<T>()->add_param(_id,
                                                             std::forward<Args>(args)...);
     }
@@ -215,7 +318,8 @@ public:
     template<class T>
     [[nodiscard]] bool has_component() const
     {
-        return has_component(typeid(T));
+        const auto* pool = std::as_const(scene_->component_maps()).template get<T>();
+        return pool != nullptr && pool->contains(_id);
     }
 
     [[nodiscard]] bool has_component(std::type_index t) const noexcept;
@@ -232,7 +336,9 @@ public:
             //throw std::invalid_argument("No component pool of unknown type could be found in entity \""+name_+"\"");
         }
 
-        if(!scene_->component_maps().get<T>()->contains(_id))
+        auto* pool = scene_->component_maps().get<T>();
+
+        if(!pool->contains(_id))
         {
             std::terminate();
             //throw;
@@ -240,7 +346,7 @@ public:
             //	throw std::invalid_argument("No component of type " +Component::type_name.at(typeid(T))+ " could be found in entity \""+name_+"\"");
             //throw std::invalid_argument("No component of unknown type could be found in entity "+name_+"\"");
         }
-        return scene_->component_maps().get<T>()->get_ref(_id);
+        return pool->get_ref(_id);
     }
 
     template<class T>
@@ -272,6 +378,8 @@ private:
     // Detach the current entity from its parent's children list
     void detach_from_parent();
 
+    void update_depth();
+
     template<class T>
     void check_template_argument()
     {
@@ -287,16 +395,16 @@ private:
     Scene* scene_ = nullptr;
     // We need the reference to the scene to actually delete the entity and its attached components
     // Although to be fair I could act as if there was only 1 scene and directly fetch it
-    RefEntity _parent;
-    EntityId  _id;
+    EntityId _id;
 
     bool _is_moved = false;
 
     long long current_layer_ = 0;
 
-    //std::vector<std::string> tags;
-    std::vector<corgi::RefEntity> children_;
-    std::string                   name_;
+    std::vector<std::string> tags_;
+
+    // The parent and children are stored by the scene, see Scene::Links
+    StringPool::Handle name_ {StringPool::npos};
 
     void copy(const Entity& e);
     void move(Entity&& e) noexcept;
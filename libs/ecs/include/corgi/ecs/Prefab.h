@@ -0,0 +1,98 @@
+#pragma once
+
+#include <corgi/ecs/ComponentPool.h>
+#include <corgi/ecs/RefEntity.h>
+
+#include <cstddef>
+#include <memory>
+#include <string>
+#include <typeindex>
+#include <vector>
+
+namespace corgi
+{
+class Scene;
+
+/*!
+ * @brief	Snapshot of an entity and its children, compiled once so it can
+ *			be instantiated many times
+ *
+ *			Scene::clone walks the source entity and asks every pool of the
+ *			scene if the entity has a component, for every node. A prefab does
+ *			that work only once : the hierarchy is flattened in depth first
+ *			order and the components are gathered in one batch per component
+ *			type.
+ *
+ *			Instantiating N copies then allocates every id at once, appends
+ *			every batch N times to its pool and links the parents in a single
+ *			pass over the flattened hierarchy.
+ *
+ *			The prefab doesn't keep any reference to the source entity, which
+ *			can be modified or removed afterward
+ */
+class Prefab
+{
+public:
+    // Lifecycle
+
+    Prefab() = default;
+
+    /*!
+	 * @brief	Compiles @a entity and its children
+	 */
+    explicit Prefab(RefEntity entity);
+
+    // Functions
+
+    /*!
+	 * @brief	Creates @a count copies of the prefab inside @a scene
+	 *
+	 *			Copies are attached to @a parent, or to the scene's root if
+	 *			@a parent is invalid. Pools missing from @a scene are created
+	 *
+	 * @return	Returns the root entity of every copy
+	 */
+    std::vector<RefEntity> instantiate(Scene&      scene,
+                                       std::size_t count,
+                                       RefEntity   parent = RefEntity()) const;
+
+    RefEntity instantiate(Scene& scene, RefEntity parent = RefEntity()) const;
+
+    // Capacity
+
+    /*!
+	 * @brief	Returns how many entities a single copy creates
+	 */
+    [[nodiscard]] std::size_t node_count() const noexcept { return nodes_.size(); }
+
+    [[nodiscard]] bool empty() const noexcept { return nodes_.empty(); }
+
+private:
+    struct Node
+    {
+        std::string              name;
+        std::vector<std::string> tags;
+
+        // Index of the parent node. Parents always come before their
+        // children, -1 for the prefab's root
+        int         parent {-1};
+        int         child_count {0};
+        long long   current_layer {0};
+        long long   layer_flag {1};
+        char        enabled {true};
+    };
+
+    struct Batch
+    {
+        std::type_index type {typeid(void)};
+
+        // Components are attached to node indexes instead of entity ids
+        std::unique_ptr<AbstractComponentPool> components;
+    };
+
+    void compile(Scene& scene, RefEntity entity, int parent);
+
+    std::vector<Node>  nodes_;
+    std::vector<Batch> batches_;
+};
+}    // namespace corgi
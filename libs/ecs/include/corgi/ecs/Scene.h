@@ -1,14 +1,23 @@
 #pragma once
 
+#include <corgi/containers/ChunkedVector.h>
 #include <corgi/ecs/ComponentPools.h>
 #include <corgi/ecs/EntityId.h>
 #include <corgi/ecs/RefEntity.h>
+#include <corgi/ecs/StringPool.h>
 #include <corgi/ecs/System.h>
+#include <corgi/ecs/TypeId.h>
 
+#include <cstdint>
 #include <deque>
+#include <functional>
+#include <limits>
 #include <map>
 #include <memory>
 #include <string>
+#include <string_view>
+#include <typeindex>
+#include <unordered_map>
 #include <vector>
 
 namespace corgi
@@ -23,6 +32,10 @@ class Entity;
 	 */
 class Scene
 {
+    friend class Entity;
+    friend class Prefab;
+    friend class SceneSnapshot;
+
 public:
     // Constructors
 
@@ -34,33 +47,43 @@ public:
     template<class T, class... Args>
     void emplace_system(Args&&... args)
     {
-        systems_order_.emplace_back(typeid(T));
-        systems_.emplace(typeid(T), std::make_unique<T>(std::forward<Args>(args)...));
+        if(has_system<T>())
+            return;
+
+        auto* system = systems_
+                           .emplace(typeid(T), std::make_unique<T>(std::forward<Args>(args)...))
+                           .first->second.get();
+
+        const auto id = system_type_id<T>();
+
+        if(id >= systems_by_id_.size())
+            systems_by_id_.resize(id + 1, nullptr);
+
+        systems_by_id_[id] = system;
+        ordered_systems_.push_back(system);
+        system_zone_names_.push_back(system_zone_name(typeid(T)));
     }
 
     template<class T>
     [[nodiscard]] T* get_system()
     {
+        const auto id = system_type_id<T>();
 
-        if(!systems_.contains(typeid(T)))
-        {
+        if(id >= systems_by_id_.size())
             return nullptr;
-        }
 
-        return dynamic_cast<T*>(systems_.at(typeid(T)).get());
+        return static_cast<T*>(systems_by_id_[id]);
     }
 
     template<class T>
     [[nodiscard]] bool has_system() const noexcept
     {
-        return systems_.contains(typeid(T));
+        const auto id = system_type_id<T>();
+        return id < systems_by_id_.size() && systems_by_id_[id] != nullptr;
     }
 
     void unregister_entity_from_component_pools(EntityId id);
 
-    /*Entity* find_by_name(std::string name);
-		Entity* find_by_tag(std::string tag);*/
-
     void before_update(float elapsed_time);
     void update(float elapsed_time);
     void after_update(float elapsed_time);
@@ -127,9 +150,28 @@ public:
 	 * @brief	Tries to find an entity called "name" inside the scene
 	 *			Returns a pointer to the entity if founded, returns nullptr 
 	 *			otherwise
+	 *
+	 *			Entities are indexed by name, so this doesn't walk the scene.
+	 *			If several entities share the same name, the first one in
+	 *			depth first order is returned
 	 */
     RefEntity find(std::string_view name);
 
+    /*!
+	 * @brief	Returns every entity called @a name, in no particular order
+	 */
+    std::vector<RefEntity> find_all(std::string_view name);
+
+    /*!
+	 * @brief	Returns the first entity, in depth first order, tagged with @a tag
+	 */
+    RefEntity find_by_tag(std::string_view tag);
+
+    /*!
+	 * @brief	Returns every entity tagged with @a tag, in no particular order
+	 */
+    std::vector<RefEntity> find_all_by_tag(std::string_view tag);
+
     corgi::RefEntity root() { return root_; }
 
     void remove_entity(RefEntity entity);
@@ -139,29 +181,166 @@ public:
 		void add_canvas(Canvas&& canvas);*/
     //Canvas& new_canvas();
 
-    std::map<std::type_index, std::unique_ptr<AbstractSystem>>& systems();
+    /*!
+	 * @brief	Returns the systems of the scene. Systems are added through
+	 *			emplace_system, which also indexes them
+	 */
+    [[nodiscard]] const std::map<std::type_index, std::unique_ptr<AbstractSystem>>&
+    systems() const noexcept;
 
-    [[nodiscard]] std::vector<Entity>& entity_contiguous()
-    {
-        return _entities_contiguous;
-    }
+    /*!
+	 * @brief	Entities are stored by chunks, indexed by their id. They never
+	 *			move once created, even when the scene needs more ids
+	 */
+    using EntityStorage = ChunkedVector<Entity>;
+
+    [[nodiscard]] EntityStorage& entities() { return entities_; }
+
+    /*!
+	 * @brief	Returns the pool storing the entities' names
+	 */
+    [[nodiscard]] const StringPool& names() const noexcept { return strings_; }
 
 private:
-    void     grow_ids();
+    /*!
+	 * @brief	Position of an entity inside the hierarchy, stored as the ids
+	 *			of its neighbours
+	 *
+	 *			Children form a doubly linked list going through their
+	 *			siblings, so adding or removing a child never allocates and
+	 *			walking the hierarchy only reads this array
+	 */
+    struct Links
+    {
+        static constexpr std::uint32_t none = std::numeric_limits<std::uint32_t>::max();
+
+        std::uint32_t parent {none};
+        std::uint32_t first_child {none};
+        std::uint32_t last_child {none};
+        std::uint32_t next_sibling {none};
+        std::uint32_t previous_sibling {none};
+        std::uint32_t child_count {0};
+    };
+
+    struct StringHash
+    {
+        using is_transparent = void;
+
+        std::size_t operator()(std::string_view str) const noexcept
+        {
+            return std::hash<std::string_view> {}(str);
+        }
+    };
+
+    /*!
+	 * @brief	Every distinct name (or tag) is stored once, with the ids of
+	 *			the entities using it. Lookups with a string_view don't build
+	 *			a temporary std::string
+	 */
+    using EntityIndex =
+        std::unordered_map<std::string, std::vector<EntityId>, StringHash, std::equal_to<>>;
+
+    /*!
+	 * @brief	Makes at least @a minimum new ids usable. Ids are added by
+	 *			whole chunks of the entity storage
+	 */
+    void     grow_ids(std::size_t minimum = 1);
     EntityId get_next_id();
 
+    /*!
+	 * @brief	Takes @a count usable ids at once, growing the entity array
+	 *			at most once
+	 */
+    void allocate_ids(std::size_t count, std::vector<EntityId>& ids);
+
+    static void add_to_index(EntityIndex& index, std::string_view key, EntityId id);
+    static void remove_from_index(EntityIndex& index, std::string_view key, EntityId id);
+
+    void add_name(StringPool::Handle name, EntityId id);
+    void remove_name(StringPool::Handle name, EntityId id);
+
+    /*!
+	 * @brief	Creates the entity @a id, called @a name, and appends it to
+	 *			@a parent's children. The root is created with an invalid parent
+	 */
+    Entity& emplace_entity(EntityId id, StringPool::Handle name, EntityId parent);
+
+    /*!
+	 * @brief	Appends @a child at the end of @a parent's children
+	 */
+    void link(EntityId child, EntityId parent) noexcept;
+
+    /*!
+	 * @brief	Removes @a child from its parent's children
+	 */
+    void unlink(EntityId child) noexcept;
+
+    /*!
+	 * @brief	Releases @a id and its descendants without touching the links
+	 *			of @a id's parent
+	 */
+    void remove_subtree(EntityId id);
+
+    /*!
+	 * @brief	Returns a reference to the entity stored at @a index, or an
+	 *			invalid reference for Links::none
+	 */
+    [[nodiscard]] RefEntity ref(std::uint32_t index);
+
+    /*!
+	 * @brief	Returns true if @a ancestor is a parent, or a parent's parent
+	 *			and so on, of @a entity
+	 */
+    bool is_descendant(EntityId entity, EntityId ancestor);
+
+    /*!
+	 * @brief	Returns true if @a a comes before @a b when iterating over
+	 *			the scene depth first
+	 */
+    bool precedes(EntityId a, EntityId b);
+
+    /*!
+	 * @brief	Returns the first entity of @a ids, in depth first order, that
+	 *			is inside @a scope's subtree. @a scope itself is ignored
+	 */
+    RefEntity first_in_subtree(const std::vector<EntityId>& ids, EntityId scope);
+
+    std::vector<RefEntity> all_in_subtree(const std::vector<EntityId>& ids, EntityId scope);
+
+    /*!
+	 * @brief	Returns the demangled name of a system type, used as its
+	 *			profiler zone name. Stays valid until the program exits
+	 */
+    static const char* system_zone_name(std::type_index type);
+
     ComponentPools _component_maps;                                         // 24 bytes
     std::map<std::type_index, std::unique_ptr<AbstractSystem>> systems_;    // 24 bytes
-    std::vector<std::type_index> systems_order_;                            // 32 bytes
-    std::vector<Entity>          _entities_contiguous;                      // 32 bytes
+
+    // Non owning pointers to the systems, indexed by system_type_id<T>()
+    std::vector<AbstractSystem*> systems_by_id_;
+
+    // Systems in the order they were added, so updating them doesn't search the map
+    std::vector<AbstractSystem*> ordered_systems_;
+    std::vector<const char*>     system_zone_names_;    // Same order as ordered_systems_
+
+    EntityStorage      entities_;
+    std::vector<Links> links_;    // Indexed by entity id
 
     std::deque<EntityId> _usable_ids;    // 40 bytes
     corgi::RefEntity     root_;          // 16 bytes
 
+    StringPool strings_;
+
+    // Entities using each name, indexed by the name's handle
+    std::vector<std::vector<EntityId>> names_;
+
+    // Position of each entity inside its name's bucket, indexed by entity id,
+    // so removing an entity doesn't search the bucket
+    std::vector<std::uint32_t> name_positions_;
+    EntityIndex                        tags_;
+
     int _existing_id_count {0};    // 4 bytes
 
     char padding_[4];
-
-    // 184 bytes
 };
 }    // namespace corgi
@@ -0,0 +1,263 @@
+#pragma once
+
+#include <corgi/ecs/ComponentPool.h>
+
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <typeindex>
+#include <unordered_map>
+#include <vector>
+
+namespace corgi
+{
+class Scene;
+
+/*!
+ * @brief	Binary stream used by the component serializers to write a
+ *			snapshot
+ *
+ *			Strings are written as an index inside the snapshot's string
+ *			table, so a resource referenced by thousands of components
+ *			(like a texture's path) is only stored once
+ */
+class SnapshotWriter
+{
+public:
+    template<class T>
+    void write(const T& value)
+    {
+        static_assert(std::is_trivially_copyable_v<T>,
+                      "Only trivially copyable values can be written directly");
+        write_bytes(&value, sizeof(T));
+    }
+
+    void write_bytes(const void* data, std::size_t size);
+
+    void write_string(std::string_view str);
+
+private:
+    friend class SceneSnapshot;
+
+    SnapshotWriter(std::vector<char>& buffer, std::vector<std::string>& strings);
+
+    /*!
+	 * @brief	Returns the index of @a str inside the string table, adding it
+	 *			if needed
+	 */
+    uint32_t intern(std::string_view str);
+
+    std::vector<char>&                        buffer_;
+    std::vector<std::string>&                 strings_;
+    std::unordered_map<std::string, uint32_t> string_indexes_;
+};
+
+/*!
+ * @brief	Reads back what a SnapshotWriter wrote. Throws a runtime_error
+ *			when reading past the end of the data
+ */
+class SnapshotReader
+{
+public:
+    template<class T>
+    [[nodiscard]] T read()
+    {
+        static_assert(std::is_trivially_copyable_v<T>,
+                      "Only trivially copyable values can be read directly");
+        T value;
+        read_bytes(&value, sizeof(T));
+        return value;
+    }
+
+    void read_bytes(void* data, std::size_t size);
+
+    [[nodiscard]] const std::string& read_string();
+
+    [[nodiscard]] std::size_t remaining() const noexcept { return size_ - offset_; }
+
+private:
+    friend class SceneSnapshot;
+
+    SnapshotReader(const char* data, std::size_t size, const std::vector<std::string>& strings);
+
+    const char*                     data_;
+    std::size_t                     size_;
+    std::size_t                     offset_ {0};
+    const std::vector<std::string>& strings_;
+};
+
+/*!
+ * @brief	Lists the component types that can be written inside a scene
+ *			snapshot
+ *
+ *			Every type is registered with a name that must not change from
+ *			one build to another, since it is what identifies the pool inside
+ *			the file. Pools whose type isn't registered aren't saved.
+ *
+ *			Trivially copyable components are written and read back as one
+ *			memcpy of the whole pool. Other components provide a function to
+ *			write one component and another one to read it back, which is
+ *			where resources get referenced by their identifier
+ */
+class ComponentRegistry
+{
+public:
+    template<class T>
+    using WriteFunction = void (*)(const T&, SnapshotWriter&);
+
+    template<class T>
+    using ReadFunction = T (*)(SnapshotReader&);
+
+    /*!
+	 * @brief	Registers a trivially copyable component
+	 */
+    template<class T>
+    static void add(const std::string& name)
+    {
+        static_assert(std::is_trivially_copyable_v<T> && std::is_default_constructible_v<T>,
+                      "Components that aren't trivially copyable need serialization functions");
+
+        Entry entry = make_entry<T>(name);
+
+        entry.write = [](const AbstractComponentPool& pool, SnapshotWriter& writer)
+        {
+            const auto& components = static_cast<const ComponentPool<T>&>(pool).components();
+            writer.write_bytes(components.data(), components.size() * sizeof(T));
+        };
+
+        entry.read = [](AbstractComponentPool& pool, SnapshotReader& reader,
+                        std::vector<size_t>&& ids)
+        {
+            std::vector<T> components(ids.size());
+            reader.read_bytes(components.data(), components.size() * sizeof(T));
+            static_cast<ComponentPool<T>&>(pool).assign(std::move(ids), std::move(components));
+        };
+
+        register_entry(std::move(entry));
+    }
+
+    /*!
+	 * @brief	Registers a component using the given functions to write and
+	 *			read every component
+	 */
+    template<class T>
+    static void add(const std::string& name, WriteFunction<T> write, ReadFunction<T> read)
+    {
+        Entry entry = make_entry<T>(name);
+
+        entry.write = [write](const AbstractComponentPool& pool, SnapshotWriter& writer)
+        {
+            for(const auto& component : static_cast<const ComponentPool<T>&>(pool).components())
+                write(component, writer);
+        };
+
+        entry.read = [read](AbstractComponentPool& pool, SnapshotReader& reader,
+                            std::vector<size_t>&& ids)
+        {
+            std::vector<T> components;
+            components.reserve(ids.size());
+
+            for(std::size_t i = 0; i < ids.size(); i++)
+                components.push_back(read(reader));
+
+            static_cast<ComponentPool<T>&>(pool).assign(std::move(ids), std::move(components));
+        };
+
+        register_entry(std::move(entry));
+    }
+
+    template<class T>
+    [[nodiscard]] static bool contains()
+    {
+        return find(typeid(T)) != nullptr;
+    }
+
+    static void clear() noexcept;
+
+private:
+    friend class SceneSnapshot;
+
+    struct Entry
+    {
+        std::string     name;
+        std::type_index type {typeid(void)};
+
+        std::function<std::unique_ptr<AbstractComponentPool>()>               make_pool;
+        std::function<void(const AbstractComponentPool&, SnapshotWriter&)>     write;
+        std::function<void(AbstractComponentPool&, SnapshotReader&, std::vector<size_t>&&)>
+            read;
+    };
+
+    template<class T>
+    static Entry make_entry(const std::string& name)
+    {
+        Entry entry;
+        entry.name      = name;
+        entry.type      = typeid(T);
+        entry.make_pool = [] { return std::make_unique<ComponentPool<T>>(); };
+        return entry;
+    }
+
+    static void register_entry(Entry&& entry);
+
+    [[nodiscard]] static const Entry* find(std::type_index type);
+    [[nodiscard]] static const Entry* find(std::string_view name);
+
+    static inline std::vector<Entry> entries_;
+};
+
+/*!
+ * @brief	Saves and restores a whole scene : the entity hierarchy, the
+ *			unused ids and every pool whose component type is registered in
+ *			the ComponentRegistry
+ *
+ *			The file is made of a header followed by the entity records, the
+ *			children and tags arrays, the usable ids, one block per pool and
+ *			finally the string table. Each array is written in one go, and restoring
+ *			a pool replaces its content at once instead of adding components
+ *			entity by entity.
+ *
+ *			Snapshots store raw values, so they are only meant to be read back
+ *			by the same build on the same platform (quick saves, cached levels)
+ */
+class SceneSnapshot
+{
+public:
+    static constexpr char     magic[4] = {'C', 'S', 'N', 'P'};
+    static constexpr uint32_t version  = 1;
+
+    /*!
+	 * @brief	Writes the scene inside @a buffer
+	 */
+    static void write(Scene& scene, std::vector<char>& buffer);
+
+    /*!
+	 * @brief	Replaces the scene's entities and registered pools with the
+	 *			content of the snapshot. Systems are left untouched
+	 *
+	 *			Throws a runtime_error if the data isn't a valid snapshot. The
+	 *			whole snapshot is checked first, so the scene is left untouched
+	 *			then
+	 */
+    static void read(Scene& scene, const char* data, std::size_t size);
+
+    /*!
+	 * @brief	Writes the scene inside the file located at @a path
+	 *
+	 * @return	Returns false if the file couldn't be written
+	 */
+    static bool save(Scene& scene, const std::string& path);
+
+    /*!
+	 * @brief	Loads the snapshot file located at @a path inside @a scene
+	 *
+	 * @return	Returns false if the file couldn't be opened
+	 */
+    static bool load(Scene& scene, const std::string& path);
+};
+}    // namespace corgi
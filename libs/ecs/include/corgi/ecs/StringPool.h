@@ -0,0 +1,104 @@
+#pragma once
+
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+namespace corgi
+{
+/*!
+ * @brief	Stores every distinct string once and hands out small handles to
+ *			them
+ *
+ *			Strings are reference counted. Interning a string that is already
+ *			in the pool only increments its counter, so giving an entity a
+ *			name that another entity already uses doesn't allocate. The slot
+ *			of a string is reused once its last reference is released
+ */
+class StringPool
+{
+public:
+    using Handle = std::uint32_t;
+
+    static constexpr Handle npos = std::numeric_limits<Handle>::max();
+
+    // Functions
+
+    /*!
+	 * @brief	Adds @a count references to @a str, adding it to the pool if
+	 *			needed
+	 */
+    Handle intern(std::string_view str, std::uint32_t count = 1);
+
+    /*!
+	 * @brief	Adds @a count references to a string already in the pool
+	 */
+    void retain(Handle handle, std::uint32_t count = 1) noexcept;
+
+    /*!
+	 * @brief	Removes a reference to the string. The string is removed from
+	 *			the pool once nobody references it anymore
+	 */
+    void release(Handle handle) noexcept;
+
+    void clear() noexcept;
+
+    // Lookup
+
+    /*!
+	 * @brief	Returns the handle of @a str, or npos if the pool doesn't
+	 *			contain it. Never allocates
+	 */
+    [[nodiscard]] Handle find(std::string_view str) const noexcept;
+
+    [[nodiscard]] std::string_view view(Handle handle) const noexcept;
+    [[nodiscard]] const char*      c_str(Handle handle) const noexcept;
+
+    /*!
+	 * @brief	Returns how many entities, or anything else, reference the
+	 *			string
+	 */
+    [[nodiscard]] std::uint32_t references(Handle handle) const noexcept;
+
+    // Capacity
+
+    /*!
+	 * @brief	Returns how many distinct strings the pool contains
+	 */
+    [[nodiscard]] std::size_t size() const noexcept { return lookup_.size(); }
+
+    /*!
+	 * @brief	Returns the number of slots, used or not. Handles are always
+	 *			lower than this value
+	 */
+    [[nodiscard]] std::size_t slot_count() const noexcept { return strings_.size(); }
+
+private:
+    struct StringHash
+    {
+        using is_transparent = void;
+
+        std::size_t operator()(std::string_view str) const noexcept
+        {
+            return std::hash<std::string_view> {}(str);
+        }
+    };
+
+    struct Slot
+    {
+        // Strings are kept behind a pointer so the views used as keys by the
+        // lookup table stay valid when the slots array grows
+        std::unique_ptr<std::string> str;
+        std::uint32_t                references {0};
+    };
+
+    std::vector<Slot>   strings_;
+    std::vector<Handle> free_slots_;
+
+    std::unordered_map<std::string_view, Handle, StringHash, std::equal_to<>> lookup_;
+};
+}    // namespace corgi
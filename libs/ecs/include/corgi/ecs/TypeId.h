@@ -0,0 +1,59 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+
+namespace corgi
+{
+using TypeId = std::uint32_t;
+
+/*!
+ * @brief   Gives a small integer to every type of a family, so objects stored
+ *          per type can live in a flat array indexed by that integer instead
+ *          of a std::map<std::type_index, ...>
+ *
+ *          Every family (components, systems, resources...) has its own
+ *          counter, so ids of a family are dense and start at 0. A type gets
+ *          its id the first time it is asked, which means ids can change from
+ *          one run to another and must never be saved
+ *
+ * @tparam  Family  Tag type used to separate the counters
+ */
+template<class Family>
+class TypeIds
+{
+public:
+    template<class T>
+    [[nodiscard]] static TypeId get() noexcept
+    {
+        static const TypeId id = next_.fetch_add(1, std::memory_order_relaxed);
+        return id;
+    }
+
+    /*!
+     * @brief   Returns how many types of the family were given an id so far
+     */
+    [[nodiscard]] static TypeId count() noexcept
+    {
+        return next_.load(std::memory_order_relaxed);
+    }
+
+private:
+    inline static std::atomic<TypeId> next_ {0};
+};
+
+class AbstractComponentPool;
+class AbstractSystem;
+
+template<class T>
+[[nodiscard]] TypeId component_type_id() noexcept
+{
+    return TypeIds<AbstractComponentPool>::get<T>();
+}
+
+template<class T>
+[[nodiscard]] TypeId system_type_id() noexcept
+{
+    return TypeIds<AbstractSystem>::get<T>();
+}
+}    // namespace corgi
@@ -4,9 +4,33 @@ namespace corgi
 {
 	void ComponentPools::remove(const std::type_info& component_type)
 	{
+		auto it = type_ids_.find(component_type);
+
+		if(it != type_ids_.end())
+		{
+			pools_by_id_[it->second] = nullptr;
+			type_ids_.erase(it);
+		}
 		pools_.erase(component_type);
 	}
 
+	AbstractComponentPool* ComponentPools::add(std::type_index type, std::unique_ptr<AbstractComponentPool> pool)
+	{
+		if(auto it = pools_.find(type); it != pools_.end())
+			return it->second.get();
+
+		auto* ptr = pools_.emplace(type, std::move(pool)).first->second.get();
+
+		const auto id = ptr->type_id();
+
+		if(id >= pools_by_id_.size())
+			pools_by_id_.resize(id + 1, nullptr);
+
+		pools_by_id_[id] = ptr;
+		type_ids_.emplace(type, id);
+		return ptr;
+	}
+
 	int ComponentPools::size() const noexcept
 	{
 		return pools_.size();
@@ -22,7 +46,7 @@ namespace corgi
 		return pools_.at(t).get();
 	}
 
-	std::map<std::type_index, std::unique_ptr<AbstractComponentPool>>::iterator ComponentPools::end()
+	std::map<std::type_index, std::unique_ptr<AbstractComponentPool>>::const_iterator ComponentPools::end() const noexcept
 	{
 		return pools_.end();
 	}
@@ -32,7 +56,7 @@ namespace corgi
 		return pools_.contains(t);
 	}
 
-	std::map<std::type_index, std::unique_ptr<AbstractComponentPool>>::iterator ComponentPools::begin()
+	std::map<std::type_index, std::unique_ptr<AbstractComponentPool>>::const_iterator ComponentPools::begin() const noexcept
 	{
 		return pools_.begin();
 	}
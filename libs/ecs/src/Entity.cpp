@@ -10,8 +10,8 @@
 
 namespace corgi
 {
-	Entity::Entity(EntityId id, Scene& scene, const char* name) :
-		_id(id), scene_(&scene), name_(name)
+	Entity::Entity(EntityId id, Scene& scene, StringPool::Handle name) :
+		scene_(&scene), _id(id), name_(name)
 	{
 		_depth = 0;
 	}
@@ -36,13 +36,8 @@ namespace corgi
 		current_node_ = queue_.front();
 		queue_.pop_front();
 
-		// TODO : Maybe check if this can be done with simply a
-		// insert or something
-
-		for(int i=0; i< current_node_->children().size(); i++)
-		{
-			queue_.push_back(current_node_->children()[i]);
-		}
+		for (auto child : current_node_->children())
+			queue_.push_back(child);
 	}
 
 	bool Entity::Iterator::operator!=(const Iterator& iterator)const noexcept
@@ -57,15 +52,13 @@ namespace corgi
 
 	Entity::Iterator& Entity::Iterator::operator++()
 	{
-		if (queue_.empty())
-		{
-			current_node_.reset();
-			return *this;
-		}
 		switch (mode_)
 		{
 		case IteratorMode::BreadthFirst:
-			increment_breadth_first();
+			if (queue_.empty())
+				current_node_.reset();
+			else
+				increment_breadth_first();
 			break;
 
 		case IteratorMode::DepthFirst:
@@ -77,34 +70,117 @@ namespace corgi
 
 	void Entity::Iterator::increment_depth_first()
 	{
-		current_node_ = queue_.front();
-		queue_.pop_front();
+		if (!current_node_)
+			return;
 
-		for(int i = current_node_->children().size()-1; i>=0; i--)
+		auto& scene			= current_node_->scene();
+		const auto& links	= scene.links_;
+		auto index			= static_cast<std::uint32_t>(current_node_->id().id_);
+
+		// Going down first, then to the next sibling of the closest parent
+		// that has one, without leaving the iterated subtree
+
+		if (links[index].first_child != Scene::Links::none)
 		{
-			queue_.push_front(current_node_->children()[i]);
+			current_node_ = scene.ref(links[index].first_child);
+			return;
+		}
+
+		while (index != root_.id_)
+		{
+			if (links[index].next_sibling != Scene::Links::none)
+			{
+				current_node_ = scene.ref(links[index].next_sibling);
+				return;
+			}
+			index = links[index].parent;
 		}
+		current_node_.reset();
 	}
 
 	Entity::Iterator::Iterator(Entity& node, IteratorMode mode) :
-		mode_(mode)
-	{
-		std::ranges::transform
-		(
-			node.children_,
-			std::back_inserter(queue_),
-			[](RefEntity n)->RefEntity { return n; }
-		);
+		mode_(mode), root_(node.id())
+	{
+		if (mode_ == IteratorMode::DepthFirst)
+		{
+			current_node_ = node.scene_->ref(node.scene_->links_[node._id.id_].first_child);
+			return;
+		}
+
+		for (auto child : node.children())
+			queue_.push_back(child);
 		operator++();
 	}
 
+	Entity::Children::iterator::iterator(Scene* scene, std::uint32_t index) noexcept :
+		scene_(scene), index_(index)
+	{
+	}
+
+	RefEntity Entity::Children::iterator::operator*() const
+	{
+		return scene_->ref(index_);
+	}
+
+	Entity::Children::iterator& Entity::Children::iterator::operator++() noexcept
+	{
+		index_ = scene_->links_[index_].next_sibling;
+		return *this;
+	}
+
+	Entity::Children::Children(Scene& scene, EntityId parent) noexcept :
+		scene_(&scene), parent_(parent)
+	{
+	}
+
+	Entity::Children::iterator Entity::Children::begin() const noexcept
+	{
+		return iterator(scene_, scene_->links_[parent_.id_].first_child);
+	}
+
+	Entity::Children::iterator Entity::Children::end() const noexcept
+	{
+		return iterator(scene_, Scene::Links::none);
+	}
+
+	std::size_t Entity::Children::size() const noexcept
+	{
+		return scene_->links_[parent_.id_].child_count;
+	}
+
+	bool Entity::Children::empty() const noexcept
+	{
+		return scene_->links_[parent_.id_].first_child == Scene::Links::none;
+	}
+
+	RefEntity Entity::Children::front() const
+	{
+		return scene_->ref(scene_->links_[parent_.id_].first_child);
+	}
+
+	RefEntity Entity::Children::back() const
+	{
+		return scene_->ref(scene_->links_[parent_.id_].last_child);
+	}
+
+	RefEntity Entity::Children::at(std::size_t index) const
+	{
+		if (index >= size())
+			throw std::out_of_range("Entity::Children::at : index out of range");
+
+		auto it = begin();
+		for (std::size_t i = 0; i < index; i++)
+			++it;
+		return *it;
+	}
+
 	// TODO : THis is broken 
 	void Entity::copy(const Entity& e)
 	{
-		_parent			= e._parent;
 		//enabled_		= e.enabled_;
 		current_layer_	= e.current_layer_;
 		name_			= e.name_;
+		tags_			= e.tags_;
 		//transform_._entity = this;
 
 		// It's either that or have a virtual function in Components so :eyes:
@@ -121,9 +197,8 @@ namespace corgi
 
 	void Entity::move(Entity&& other)noexcept
 	{
-		_parent			= other._parent;
-		children_		= std::move(other.children_);
-		name_			= std::move(other.name_);
+		name_			= other.name_;
+		tags_			= std::move(other.tags_);
 		current_layer_	= other.current_layer_;
 		_id				= other.id();
 		scene_			= other.scene_;
@@ -152,14 +227,62 @@ namespace corgi
 
 	RefEntity Entity::find(const char* name) noexcept
 	{
-		const auto val = std::find_if(begin(), end(), [&](RefEntity e)->bool 
-		{ 
-			return std::strcmp(e->name(), name) == 0;
-		}).get();
+		const auto handle = scene_->strings_.find(name);
+
+		if(handle == StringPool::npos)
+			return RefEntity();
+
+		return scene_->first_in_subtree(scene_->names_[handle], _id);
+	}
+
+	std::vector<RefEntity> Entity::find_all(std::string_view name)
+	{
+		const auto handle = scene_->strings_.find(name);
+
+		if(handle == StringPool::npos)
+			return {};
+
+		return scene_->all_in_subtree(scene_->names_[handle], _id);
+	}
+
+	RefEntity Entity::find_by_tag(std::string_view tag)
+	{
+		const auto it = scene_->tags_.find(tag);
 
-		if(!val)
+		if(it == scene_->tags_.end())
 			return RefEntity();
-		return val;
+
+		return scene_->first_in_subtree(it->second, _id);
+	}
+
+	void Entity::add_tag(std::string_view tag)
+	{
+		if(has_tag(tag))
+			return;
+
+		tags_.emplace_back(tag);
+		Scene::add_to_index(scene_->tags_, tag, _id);
+	}
+
+	void Entity::remove_tag(std::string_view tag)
+	{
+		const auto it = std::find(tags_.begin(), tags_.end(), tag);
+
+		if(it == tags_.end())
+			return;
+
+		Scene::remove_from_index(scene_->tags_, tag, _id);
+		tags_.erase(it);
+	}
+
+	bool Entity::has_tag(std::string_view tag) const noexcept
+	{
+		return std::find(tags_.begin(), tags_.end(), tag) != tags_.end();
+	}
+
+	const std::vector<std::string>& Entity::tags() const noexcept
+	{
+		return tags_;
 	}
 
 	/*Behavior* Entity::behavior()
@@ -182,38 +305,8 @@ namespace corgi
 
 	void Entity::remove_child(RefEntity e)
 	{
-		for(int i=0; i< children_.size(); i++)
-		{
-			if(children_[i]==e)
-			{
-                children_.erase(children_.begin()+i);
-			}
-		}
-
-		/*children_.erase
-		(
-			std::remove_if
-			(
-				children_.begin(),
-				children_.end(),
-				[&](RefEntity p)->bool
-				{
-					return p == e;
-				}
-			),
-			children_.end()
-		);*/
-	}
-
-	
-
-	Entity::Entity(EntityId id, RefEntity parent, const char* name)
-		: _parent(parent), name_(name), _id(id)
-	{
-		if(!parent)
-			throw std::invalid_argument("Parent argument is null");
-		scene_ = parent->scene_;
-		_depth = parent->_depth + 1;
+		if (scene_->links_[e->id().id_].parent == _id.id_)
+			scene_->unlink(e->id());
 	}
 
 	bool Entity::has_component(std::type_index t) const noexcept
@@ -226,7 +319,9 @@ namespace corgi
 
 	[[nodiscard]] const char* Entity::name()const
 	{
-		return name_.c_str();
+		if (name_ == StringPool::npos)
+			return "";
+		return scene_->strings_.c_str(name_);
 	}
 
 	long long Entity::current_layer()const
@@ -236,7 +331,13 @@ namespace corgi
 
 	void Entity::rename(const char* n)
 	{
-		name_ = n;
+		// Interning the new name first keeps the string alive if the entity
+		// is renamed to its current name
+		const auto name = scene_->strings_.intern(n);
+
+		scene_->remove_name(name_, _id);
+		name_ = name;
+		scene_->add_name(name_, _id);
 	}
 
 	void Entity::current_layer(int cl)
@@ -288,7 +389,12 @@ namespace corgi
 
 	RefEntity Entity::parent() noexcept
 	{
-		return _parent;
+		return scene_->ref(scene_->links_[_id.id_].parent);
+	}
+
+	const RefEntity Entity::parent() const noexcept
+	{
+		return scene_->ref(scene_->links_[_id.id_].parent);
 	}
 
 	void Entity::remove_component_of_type(std::type_index index)
@@ -305,61 +411,59 @@ namespace corgi
 		scene_->component_maps().get(index)->remove(_id);
 	}
 
-	const std::vector<RefEntity>& Entity::children()const noexcept
+	Entity::Children Entity::children() const noexcept
 	{
-		return children_;
+		return Children(*scene_, _id);
 	}
 
-	std::vector<RefEntity>& Entity::children() noexcept
+	Scene& Entity::scene() noexcept
 	{
-		return children_;
+		return *scene_;
 	}
 
-	Scene& Entity::scene() noexcept
+	void Entity::parent(RefEntity new_parent)
 	{
-		return *scene_;
+		if(!new_parent)
+			new_parent = scene_->root();
+
+		if(new_parent->id() == _id || scene_->is_descendant(new_parent->id(), _id))
+			throw std::invalid_argument("An entity can't be moved inside its own subtree");
+
+		if(scene_->links_[_id.id_].parent == new_parent->id().id_)
+			return;
+
+		// The name index is global to the scene and lookups are scoped by
+		// walking up the parents, so it doesn't need to be updated here
+
+		scene_->unlink(_id);
+		scene_->link(_id, new_parent->id());
+
+		update_depth();
 	}
 
-	void Entity::parent(RefEntity newparent_)
+	void Entity::update_depth()
 	{
-		//if (!newparent_)
-		//{
-		//	if (parent_)
-		//	{
-		//		detach_from_parent();
-		//	}
+		const auto parent = scene_->links_[_id.id_].parent;
 
-		//	// TODO : Check this out, I'm hacking a bit here
-		//	parent_ = scene().root();
-		//	scene().root()->push_back(this);
-		//}
-		//else
-		//{
-		//	if (newparent_ != parent_)
-		//	{
-		//		if (parent_)
-		//			detach_from_parent();
+		_depth = parent != Scene::Links::none ? scene_->entities_[parent]._depth + 1 : 0;
 
-		//		newparent_->push_back(this);
-		//		parent_ = newparent_;
-		//	}
-		//}
+		for(auto child : children())
+			child->update_depth();
 	}
 
 	void Entity::clear() noexcept
 	{
-		for(auto child : children_)
-		{
-            child->clear();
-			scene_->remove_entity(child); 
-		}
-        children_.clear();
+		// remove_entity unlinks the child, so we always remove the first one
+		while (scene_->links_[_id.id_].first_child != Scene::Links::none)
+			scene_->remove_entity(scene_->ref(scene_->links_[_id.id_].first_child));
 	}
 
 	int Entity::depth(int d) const noexcept
 	{
-		if (_parent)
-			return _parent->depth(++d);
+		const auto parent = scene_->links_[_id.id_].parent;
+
+		if (parent != Scene::Links::none)
+			return scene_->entities_[parent].depth(++d);
 		return d;
 	}
 
@@ -0,0 +1,143 @@
+#include <corgi/ecs/Entity.h>
+#include <corgi/ecs/Prefab.h>
+#include <corgi/ecs/Scene.h>
+
+#include <algorithm>
+
+namespace corgi
+{
+Prefab::Prefab(RefEntity entity)
+{
+    compile(entity->scene(), entity, -1);
+}
+
+void Prefab::compile(Scene& scene, RefEntity entity, int parent)
+{
+    const auto index = static_cast<int>(nodes_.size());
+
+    auto& node         = nodes_.emplace_back();
+    node.name          = entity->name();
+    node.tags          = entity->tags_;
+    node.parent        = parent;
+    node.current_layer = entity->current_layer_;
+    node.layer_flag    = entity->actual_layer_flag;
+    node.enabled       = entity->_enabled;
+
+    if(parent != -1)
+        nodes_[parent].child_count++;
+
+    for(auto& [type, pool] : scene.component_maps())
+    {
+        if(!pool->contains(entity->id()))
+            continue;
+
+        auto batch = std::find_if(batches_.begin(), batches_.end(),
+                                  [&](const Batch& b) { return b.type == type; });
+
+        if(batch == batches_.end())
+        {
+            batches_.push_back({type, pool->make_empty()});
+            batch = batches_.end() - 1;
+        }
+
+        batch->components->add(EntityId(static_cast<std::size_t>(index)),
+                               pool->at(entity->id()));
+    }
+
+    for(auto child : entity->children())
+        compile(scene, child, index);
+}
+
+std::vector<RefEntity> Prefab::instantiate(Scene& scene, std::size_t count, RefEntity parent) const
+{
+    std::vector<RefEntity> roots;
+
+    if(nodes_.empty() || count == 0)
+        return roots;
+
+    if(!parent)
+        parent = scene.root();
+
+    const auto stride = nodes_.size();
+
+    std::vector<EntityId> ids;
+    ids.reserve(stride * count);
+    scene.allocate_ids(stride * count, ids);
+
+    // Every copy of a node has the same name, so each name is interned
+    // once with a reference per copy
+
+    std::vector<StringPool::Handle> names(stride);
+
+    for(std::size_t n = 0; n < stride; n++)
+        names[n] = scene.strings_.intern(nodes_[n].name, static_cast<std::uint32_t>(count));
+
+    // Creating the entities. Parents come first in the flattened hierarchy,
+    // so their depth is already known when we reach their children
+
+    roots.reserve(count);
+
+    for(std::size_t c = 0; c < count; c++)
+    {
+        const auto* copy_ids = ids.data() + c * stride;
+
+        for(std::size_t n = 0; n < stride; n++)
+        {
+            const auto& node = nodes_[n];
+
+            const auto node_parent = node.parent == -1 ? parent->id() : copy_ids[node.parent];
+
+            auto& entity = scene.emplace_entity(copy_ids[n], names[n], node_parent);
+
+            entity.tags_             = node.tags;
+            entity.current_layer_    = node.current_layer;
+            entity.actual_layer_flag = node.layer_flag;
+            entity._enabled          = node.enabled;
+        }
+
+        roots.emplace_back(scene, scene.entities_[copy_ids[0].id_]);
+    }
+
+    // Same for the tags, every copy of a node goes in the same bucket, so
+    // the bucket is only looked up once per tag of the node
+
+    for(std::size_t n = 0; n < stride; n++)
+    {
+        for(const auto& tag : nodes_[n].tags)
+        {
+            auto it = scene.tags_.find(std::string_view(tag));
+
+            if(it == scene.tags_.end())
+                it = scene.tags_.emplace(std::string(tag), std::vector<EntityId>()).first;
+
+            auto& bucket = it->second;
+            bucket.reserve(bucket.size() + count);
+
+            for(std::size_t c = 0; c < count; c++)
+                bucket.push_back(ids[c * stride + n]);
+        }
+    }
+
+    for(const auto& batch : batches_)
+    {
+        auto& pools = scene.component_maps();
+
+        auto* pool = pools.contains(batch.type)
+                         ? pools.get(batch.type)
+                         : pools.add(batch.type, batch.components->make_empty());
+
+        pool->append_copies(*batch.components, ids.data(), stride, count);
+    }
+
+    return roots;
+}
+
+RefEntity Prefab::instantiate(Scene& scene, RefEntity parent) const
+{
+    auto roots = instantiate(scene, 1, parent);
+
+    if(roots.empty())
+        return RefEntity();
+    return roots.front();
+}
+}    // namespace corgi
@@ -1,13 +1,22 @@
 #include <corgi/ecs/Entity.h>
 #include <corgi/ecs/Scene.h>
+#include <corgi/profiler/Profiler.h>
+
+#include <algorithm>
+#include <cstdlib>
+#include <mutex>
+#include <unordered_map>
+
+#ifdef __GNUG__
+#include <cxxabi.h>
+#endif
 
 namespace corgi
 {
 
 Scene::Scene()
 {
-    static const std::string root = "root";
-    root_                         = new_entity(*this, root);
+    root_ = new_entity(*this, "root");
 }
 
 RefEntity Scene::clone(RefEntity base, RefEntity par)
@@ -23,8 +32,8 @@ RefEntity Scene::clone(RefEntity base, RefEntity par)
     }
     else    // Otherwise, the copy will be a sibling of the copied
     {
-        if(base->_parent)
-            cloned_entity = new_entity(base->_parent, base->name());
+        if(auto parent = base->parent())
+            cloned_entity = new_entity(parent, base->name());
         else
             cloned_entity = new_entity(*base->scene_, base->name());
     }
@@ -40,7 +49,7 @@ RefEntity Scene::clone(RefEntity base, RefEntity par)
     }
 
     // Copy the children
-    for(const auto& child : base->children_)
+    for(auto child : base->children())
         clone(child, cloned_entity);
 
     return cloned_entity;
@@ -48,29 +57,119 @@ RefEntity Scene::clone(RefEntity base, RefEntity par)
 
 RefEntity Scene::new_entity(Scene& scene, const std::string& name)
 {
-    auto id                      = get_next_id();
-    _entities_contiguous[id.id_] = Entity(id, scene, name.c_str());
-    return RefEntity(*this, _entities_contiguous[id.id_]);
+    auto& entity = emplace_entity(get_next_id(), strings_.intern(name), EntityId());
+    return RefEntity(*this, entity);
 }
 
 RefEntity Scene::new_entity(RefEntity parent, const std::string& name)
 {
-    auto id = get_next_id();
-    auto ref =
-        RefEntity(*this, _entities_contiguous[id.id_] = Entity(id, parent, name.c_str()));
-    parent->children_.emplace_back(ref);
-    return ref;
+    auto& entity = emplace_entity(get_next_id(), strings_.intern(name), parent->id());
+    return RefEntity(*this, entity);
+}
+
+Entity& Scene::emplace_entity(EntityId id, StringPool::Handle name, EntityId parent)
+{
+    auto& entity = entities_[id.id_] = Entity(id, *this, name);
+    links_[id.id_]                   = Links();
+
+    if(parent.id_ != EntityId::npos)
+    {
+        entity._depth = entities_[parent.id_]._depth + 1;
+        link(id, parent);
+    }
+
+    add_name(name, id);
+    return entity;
+}
+
+void Scene::link(EntityId child, EntityId parent) noexcept
+{
+    const auto c = static_cast<std::uint32_t>(child.id_);
+    const auto p = static_cast<std::uint32_t>(parent.id_);
+
+    auto& child_links  = links_[c];
+    auto& parent_links = links_[p];
+
+    child_links.parent           = p;
+    child_links.next_sibling     = Links::none;
+    child_links.previous_sibling = parent_links.last_child;
+
+    if(parent_links.last_child != Links::none)
+        links_[parent_links.last_child].next_sibling = c;
+    else
+        parent_links.first_child = c;
+
+    parent_links.last_child = c;
+    parent_links.child_count++;
+}
+
+void Scene::unlink(EntityId child) noexcept
+{
+    auto& child_links = links_[child.id_];
+
+    if(child_links.parent == Links::none)
+        return;
+
+    auto& parent_links = links_[child_links.parent];
+
+    if(child_links.previous_sibling != Links::none)
+        links_[child_links.previous_sibling].next_sibling = child_links.next_sibling;
+    else
+        parent_links.first_child = child_links.next_sibling;
+
+    if(child_links.next_sibling != Links::none)
+        links_[child_links.next_sibling].previous_sibling = child_links.previous_sibling;
+    else
+        parent_links.last_child = child_links.previous_sibling;
+
+    parent_links.child_count--;
+
+    child_links.parent           = Links::none;
+    child_links.next_sibling     = Links::none;
+    child_links.previous_sibling = Links::none;
+}
+
+RefEntity Scene::ref(std::uint32_t index)
+{
+    if(index == Links::none)
+        return RefEntity();
+    return RefEntity(*this, entities_[index]);
 }
 
 void Scene::remove_entity(RefEntity entity)
+{
+    // Detaching the entity first, so the parent's children never
+    // reference a removed entity
+    unlink(entity->id());
+    remove_subtree(entity->id());
+}
+
+void Scene::remove_subtree(EntityId id)
 {
     // When we delete an entity, we simply put back its id in the
     // queue and remove its components
-    _usable_ids.push_front(entity->id());
-    entity->scene_->unregister_entity_from_component_pools(entity->id());
+    auto& entity = entities_[id.id_];
+
+    _usable_ids.push_front(id);
+    unregister_entity_from_component_pools(id);
 
-    for(auto child : entity->children())
-        remove_entity(child);
+    remove_name(entity.name_, id);
+    entity.name_ = StringPool::npos;
+
+    for(const auto& tag : entity.tags_)
+        remove_from_index(tags_, tag, id);
+    entity.tags_.clear();
+
+    auto child = links_[id.id_].first_child;
+
+    while(child != Links::none)
+    {
+        const auto next = links_[child].next_sibling;
+        remove_subtree(EntityId(child));
+        child = next;
+    }
+
+    links_[id.id_] = Links();
 }
 
 EntityId Scene::get_next_id()
@@ -84,17 +183,35 @@ EntityId Scene::get_next_id()
     return id;
 }
 
-void Scene::grow_ids()
+void Scene::grow_ids(std::size_t minimum)
 {
-    const auto start_new_ids = _existing_id_count;
-    const auto end_new_ids   = start_new_ids + _existing_id_count + 1 * 2;
+    // Growing by whole chunks means existing entities never move, and
+    // creating entities only allocates once every chunk_size entities
+
+    constexpr auto chunk = EntityStorage::chunk_size;
+
+    const auto new_ids = (std::max<std::size_t>(minimum, 1) + chunk - 1) / chunk * chunk;
+
+    const auto start_new_ids = static_cast<std::size_t>(_existing_id_count);
+    const auto end_new_ids   = start_new_ids + new_ids;
 
     for(auto i = start_new_ids; i < end_new_ids; i++)
         _usable_ids.push_back(EntityId(i));
 
-    _existing_id_count += _existing_id_count + 1 * 2;
+    _existing_id_count = static_cast<int>(end_new_ids);
+
+    entities_.resize(end_new_ids);
+    links_.resize(end_new_ids);
+    name_positions_.resize(end_new_ids);
+}
+
+void Scene::allocate_ids(std::size_t count, std::vector<EntityId>& ids)
+{
+    if(_usable_ids.size() < count)
+        grow_ids(count - _usable_ids.size());
 
-    _entities_contiguous.resize(end_new_ids);
+    ids.insert(ids.end(), _usable_ids.begin(), _usable_ids.begin() + count);
+    _usable_ids.erase(_usable_ids.begin(), _usable_ids.begin() + count);
 }
 
 Scene::~Scene()
@@ -104,14 +221,221 @@ Scene::~Scene()
 
 RefEntity Scene::find(std::string_view name)
 {
-    return root_->find(name.data());
+    const auto handle = strings_.find(name);
+
+    if(handle == StringPool::npos)
+        return RefEntity();
+
+    return first_in_subtree(names_[handle], root_->id());
+}
+
+std::vector<RefEntity> Scene::find_all(std::string_view name)
+{
+    const auto handle = strings_.find(name);
+
+    if(handle == StringPool::npos)
+        return {};
+
+    return all_in_subtree(names_[handle], root_->id());
+}
+
+RefEntity Scene::find_by_tag(std::string_view tag)
+{
+    auto it = tags_.find(tag);
+
+    if(it == tags_.end())
+        return RefEntity();
+
+    return first_in_subtree(it->second, root_->id());
+}
+
+std::vector<RefEntity> Scene::find_all_by_tag(std::string_view tag)
+{
+    auto it = tags_.find(tag);
+
+    if(it == tags_.end())
+        return {};
+
+    return all_in_subtree(it->second, root_->id());
+}
+
+void Scene::add_to_index(EntityIndex& index, std::string_view key, EntityId id)
+{
+    auto it = index.find(key);
+
+    if(it == index.end())
+        it = index.emplace(std::string(key), std::vector<EntityId>()).first;
+
+    it->second.push_back(id);
+}
+
+void Scene::remove_from_index(EntityIndex& index, std::string_view key, EntityId id)
+{
+    auto it = index.find(key);
+
+    if(it == index.end())
+        return;
+
+    auto& ids = it->second;
+    auto  pos = std::find(ids.begin(), ids.end(), id);
+
+    if(pos == ids.end())
+        return;
+
+    // The order inside a bucket doesn't matter
+    *pos = ids.back();
+    ids.pop_back();
+
+    if(ids.empty())
+        index.erase(it);
+}
+
+void Scene::add_name(StringPool::Handle name, EntityId id)
+{
+    if(name >= names_.size())
+        names_.resize(strings_.slot_count());
+
+    name_positions_[id.id_] = static_cast<std::uint32_t>(names_[name].size());
+    names_[name].push_back(id);
+}
+
+void Scene::remove_name(StringPool::Handle name, EntityId id)
+{
+    if(name == StringPool::npos)
+        return;
+
+    auto&      ids = names_[name];
+    const auto pos = name_positions_[id.id_];
+
+    // The order inside a bucket doesn't matter
+    ids[pos]                      = ids.back();
+    name_positions_[ids[pos].id_] = pos;
+    ids.pop_back();
+
+    strings_.release(name);
+}
+
+bool Scene::is_descendant(EntityId entity, EntityId ancestor)
+{
+    for(auto parent = links_[entity.id_].parent; parent != Links::none;
+        parent      = links_[parent].parent)
+    {
+        if(parent == ancestor.id_)
+            return true;
+    }
+    return false;
+}
+
+bool Scene::precedes(EntityId a, EntityId b)
+{
+    // We build the path from the root to both entities, then compare the
+    // position of the 2 branches inside their first common ancestor
+
+    auto path = [&](EntityId id)
+    {
+        std::vector<EntityId> ids;
+
+        for(auto e = static_cast<std::uint32_t>(id.id_); e != Links::none; e = links_[e].parent)
+            ids.push_back(EntityId(e));
+
+        std::reverse(ids.begin(), ids.end());
+        return ids;
+    };
+
+    const auto path_a = path(a);
+    const auto path_b = path(b);
+
+    std::size_t i = 0;
+
+    while(i < path_a.size() && i < path_b.size() && path_a[i] == path_b[i])
+        i++;
+
+    // One entity is the ancestor of the other one, parents come first
+    if(i == path_a.size() || i == path_b.size())
+        return path_a.size() < path_b.size();
+
+    for(auto child = links_[path_a[i - 1].id_].first_child; child != Links::none;
+        child      = links_[child].next_sibling)
+    {
+        if(child == path_a[i].id_)
+            return true;
+        if(child == path_b[i].id_)
+            return false;
+    }
+    return false;
 }
 
-std::map<std::type_index, std::unique_ptr<AbstractSystem>>& Scene::systems()
+RefEntity Scene::first_in_subtree(const std::vector<EntityId>& ids, EntityId scope)
+{
+    const bool whole_scene = scope == root_->id();
+
+    const EntityId* first = nullptr;
+
+    for(const auto& id : ids)
+    {
+        // Every indexed entity is inside the root's subtree
+        if(id == scope || (!whole_scene && !is_descendant(id, scope)))
+            continue;
+
+        if(first == nullptr || precedes(id, *first))
+            first = &id;
+    }
+
+    if(first == nullptr)
+        return RefEntity();
+
+    return RefEntity(*this, entities_[first->id_]);
+}
+
+std::vector<RefEntity> Scene::all_in_subtree(const std::vector<EntityId>& ids, EntityId scope)
+{
+    const bool whole_scene = scope == root_->id();
+
+    std::vector<RefEntity> entities;
+
+    for(auto id : ids)
+    {
+        if(id == scope || (!whole_scene && !is_descendant(id, scope)))
+            continue;
+
+        entities.emplace_back(*this, entities_[id.id_]);
+    }
+    return entities;
+}
+
+const std::map<std::type_index, std::unique_ptr<AbstractSystem>>&
+Scene::systems() const noexcept
 {
     return systems_;
 }
 
+const char* Scene::system_zone_name(std::type_index type)
+{
+    // Profiled zones keep a pointer to their name, so names are never freed.
+    // Scenes of any thread can register systems
+    static std::mutex                                       mutex;
+    static std::unordered_map<std::type_index, std::string> names;
+
+    const std::lock_guard lock(mutex);
+
+    auto [it, inserted] = names.try_emplace(type, type.name());
+
+#ifdef __GNUG__
+    if(inserted)
+    {
+        int   status    = 0;
+        char* demangled = abi::__cxa_demangle(type.name(), nullptr, nullptr, &status);
+
+        if(status == 0)
+            it->second = demangled;
+
+        std::free(demangled);
+    }
+#endif
+
+    return it->second.c_str();
+}
+
 void Scene::unregister_entity_from_component_pools(EntityId id)
 {
     for(auto& [key, pool] : _component_maps)
@@ -120,20 +444,35 @@ void Scene::unregister_entity_from_component_pools(EntityId id)
 
 void Scene::before_update(float elapsed_time)
 {
-    for(auto key : systems_order_)
-        systems_[key]->before_update(elapsed_time);
+    CORGI_PROFILE_ZONE("Scene::before_update");
+
+    for(std::size_t i = 0; i < ordered_systems_.size(); i++)
+    {
+        CORGI_PROFILE_ZONE(system_zone_names_[i]);
+        ordered_systems_[i]->before_update(elapsed_time);
+    }
 }
 
 void Scene::update(const float elapsed_time)
 {
-    for(auto key : systems_order_)
-        systems_[key]->update(elapsed_time);
+    CORGI_PROFILE_ZONE("Scene::update");
+
+    for(std::size_t i = 0; i < ordered_systems_.size(); i++)
+    {
+        CORGI_PROFILE_ZONE(system_zone_names_[i]);
+        ordered_systems_[i]->update(elapsed_time);
+    }
 }
 
 void Scene::after_update(const float elapsed_time)
 {
-    for(auto key : systems_order_)
-        systems_[key]->after_update(elapsed_time);
+    CORGI_PROFILE_ZONE("Scene::after_update");
+
+    for(std::size_t i = 0; i < ordered_systems_.size(); i++)
+    {
+        CORGI_PROFILE_ZONE(system_zone_names_[i]);
+        ordered_systems_[i]->after_update(elapsed_time);
+    }
 }
 
 /*Canvas& Scene::new_canvas()
@@ -163,7 +502,7 @@ RefEntity Scene::append(const std::string& name)
 
 Entity& Scene::get_entity(EntityId id)
 {
-    return _entities_contiguous.at(id.id_);
+    return entities_.at(id.id_);
 }
 
 void Scene::clear()
@@ -0,0 +1,512 @@
+#include <corgi/ecs/Entity.h>
+#include <corgi/ecs/Scene.h>
+#include <corgi/ecs/SceneSnapshot.h>
+
+#include <fstream>
+#include <utility>
+
+namespace corgi
+{
+namespace
+{
+struct Header
+{
+    char     magic[4];
+    uint32_t version;
+    uint64_t entity_count;
+    uint64_t root;
+    uint64_t children_count;
+    uint64_t tag_count;
+    uint64_t usable_id_count;
+    uint64_t pool_count;
+
+    // The string table is only complete once everything else has been
+    // written, so it's stored at the end of the file
+    uint64_t strings_offset;
+    uint64_t string_count;
+};
+
+struct EntityRecord
+{
+    uint64_t parent;
+    uint64_t first_child;
+    uint32_t child_count;
+    uint32_t name;
+    uint32_t first_tag;
+    uint32_t tag_count;
+    int64_t  current_layer;
+    int64_t  layer_flag;
+    uint8_t  enabled;
+    uint8_t  depth;
+    uint8_t  alive;
+    uint8_t  padding[5];
+};
+
+constexpr uint64_t no_parent = std::numeric_limits<uint64_t>::max();
+}    // namespace
+
+// SnapshotWriter
+
+SnapshotWriter::SnapshotWriter(std::vector<char>& buffer, std::vector<std::string>& strings)
+    : buffer_(buffer)
+    , strings_(strings)
+{
+}
+
+void SnapshotWriter::write_bytes(const void* data, std::size_t size)
+{
+    if(size == 0)
+        return;
+
+    const auto offset = buffer_.size();
+    buffer_.resize(offset + size);
+    std::memcpy(buffer_.data() + offset, data, size);
+}
+
+uint32_t SnapshotWriter::intern(std::string_view str)
+{
+    auto it = string_indexes_.find(std::string(str));
+
+    if(it == string_indexes_.end())
+    {
+        it = string_indexes_.emplace(std::string(str), static_cast<uint32_t>(strings_.size()))
+                 .first;
+        strings_.emplace_back(str);
+    }
+    return it->second;
+}
+
+void SnapshotWriter::write_string(std::string_view str)
+{
+    write(intern(str));
+}
+
+// SnapshotReader
+
+SnapshotReader::SnapshotReader(const char*                     data,
+                               std::size_t                     size,
+                               const std::vector<std::string>& strings)
+    : data_(data)
+    , size_(size)
+    , strings_(strings)
+{
+}
+
+void SnapshotReader::read_bytes(void* data, std::size_t size)
+{
+    if(size > remaining())
+        throw std::runtime_error("Scene snapshot : unexpected end of data");
+
+    if(size == 0)
+        return;
+
+    std::memcpy(data, data_ + offset_, size);
+    offset_ += size;
+}
+
+const std::string& SnapshotReader::read_string()
+{
+    const auto index = read<uint32_t>();
+
+    if(index >= strings_.size())
+        throw std::runtime_error("Scene snapshot : invalid string index");
+
+    return strings_[index];
+}
+
+// ComponentRegistry
+
+void ComponentRegistry::register_entry(Entry&& entry)
+{
+    for(auto& e : entries_)
+    {
+        if(e.type == entry.type || e.name == entry.name)
+        {
+            e = std::move(entry);
+            return;
+        }
+    }
+    entries_.push_back(std::move(entry));
+}
+
+const ComponentRegistry::Entry* ComponentRegistry::find(std::type_index type)
+{
+    for(const auto& entry : entries_)
+        if(entry.type == type)
+            return &entry;
+    return nullptr;
+}
+
+const ComponentRegistry::Entry* ComponentRegistry::find(std::string_view name)
+{
+    for(const auto& entry : entries_)
+        if(entry.name == name)
+            return &entry;
+    return nullptr;
+}
+
+void ComponentRegistry::clear() noexcept
+{
+    entries_.clear();
+}
+
+// SceneSnapshot
+
+void SceneSnapshot::write(Scene& scene, std::vector<char>& buffer)
+{
+    const auto start = buffer.size();
+
+    std::vector<std::string> strings;
+    SnapshotWriter           writer(buffer, strings);
+
+    Header header {};
+    std::memcpy(header.magic, magic, sizeof(magic));
+    header.version         = version;
+    header.entity_count    = scene.entities_.size();
+    header.root            = scene.root_->id().id_;
+    header.usable_id_count = scene._usable_ids.size();
+
+    // We write it again once every count is known
+    writer.write(header);
+
+    std::vector<bool> alive(scene.entities_.size(), true);
+
+    for(auto id : scene._usable_ids)
+        alive[id.id_] = false;
+
+    std::vector<EntityRecord> records(scene.entities_.size());
+    std::vector<uint64_t>     children;
+    std::vector<uint32_t>     tags;
+
+    for(std::size_t i = 0; i < records.size(); i++)
+    {
+        auto& record = records[i];
+        record       = {};
+        record.alive = alive[i];
+
+        if(!alive[i])
+            continue;
+
+        const auto& entity = scene.entities_[i];
+        const auto& links  = scene.links_[i];
+
+        record.parent = links.parent != Scene::Links::none ? links.parent : no_parent;
+        record.first_child   = children.size();
+        record.first_tag     = static_cast<uint32_t>(tags.size());
+        record.tag_count     = static_cast<uint32_t>(entity.tags_.size());
+        record.current_layer = entity.current_layer_;
+        record.layer_flag    = entity.actual_layer_flag;
+        record.enabled       = static_cast<uint8_t>(entity._enabled);
+        record.depth         = static_cast<uint8_t>(entity._depth);
+        record.name          = writer.intern(scene.strings_.view(entity.name_));
+
+        for(auto child = links.first_child; child != Scene::Links::none;
+            child      = scene.links_[child].next_sibling)
+            children.push_back(child);
+
+        record.child_count = static_cast<uint32_t>(children.size() - record.first_child);
+
+        for(const auto& tag : entity.tags_)
+            tags.push_back(writer.intern(tag));
+    }
+
+    writer.write_bytes(records.data(), records.size() * sizeof(EntityRecord));
+    writer.write_bytes(children.data(), children.size() * sizeof(uint64_t));
+    writer.write_bytes(tags.data(), tags.size() * sizeof(uint32_t));
+
+    for(auto id : scene._usable_ids)
+        writer.write(static_cast<uint64_t>(id.id_));
+
+    header.children_count = children.size();
+    header.tag_count      = tags.size();
+
+    for(auto& [type, pool] : scene.component_maps())
+    {
+        const auto* entry = ComponentRegistry::find(type);
+
+        if(entry == nullptr || pool->empty())
+            continue;
+
+        writer.write_string(entry->name);
+        writer.write(static_cast<uint64_t>(pool->size()));
+
+        for(std::size_t i = 0; i < pool->size(); i++)
+            writer.write(static_cast<uint64_t>(pool->entity_id_int(i)));
+
+        // The size of the block is only known once it's written
+        const auto size_offset = buffer.size();
+        writer.write(uint64_t {0});
+
+        entry->write(*pool, writer);
+
+        const uint64_t block_size = buffer.size() - size_offset - sizeof(uint64_t);
+        std::memcpy(buffer.data() + size_offset, &block_size, sizeof(uint64_t));
+
+        header.pool_count++;
+    }
+
+    header.strings_offset = buffer.size() - start;
+    header.string_count   = strings.size();
+
+    for(const auto& str : strings)
+    {
+        writer.write(static_cast<uint32_t>(str.size()));
+        writer.write_bytes(str.data(), str.size());
+    }
+
+    std::memcpy(buffer.data() + start, &header, sizeof(Header));
+}
+
+void SceneSnapshot::read(Scene& scene, const char* data, std::size_t size)
+{
+    if(size < sizeof(Header))
+        throw std::runtime_error("Scene snapshot : file too small");
+
+    Header header;
+    std::memcpy(&header, data, sizeof(Header));
+
+    if(std::memcmp(header.magic, magic, sizeof(magic)) != 0 || header.version != version)
+        throw std::runtime_error("Scene snapshot : invalid header");
+
+    if(header.strings_offset > size || header.root >= header.entity_count)
+        throw std::runtime_error("Scene snapshot : invalid header");
+
+    // String table
+
+    std::vector<std::string> strings;
+    strings.reserve(header.string_count);
+
+    {
+        const std::vector<std::string> none;
+        SnapshotReader                 reader(data + header.strings_offset,
+                                              size - header.strings_offset, none);
+
+        for(uint64_t i = 0; i < header.string_count; i++)
+        {
+            const auto length = reader.read<uint32_t>();
+
+            if(length > reader.remaining())
+                throw std::runtime_error("Scene snapshot : unexpected end of data");
+
+            strings.emplace_back(data + header.strings_offset + reader.offset_, length);
+            reader.offset_ += length;
+        }
+    }
+
+    SnapshotReader reader(data + sizeof(Header), header.strings_offset - sizeof(Header),
+                          strings);
+
+    std::vector<EntityRecord> records(header.entity_count);
+    std::vector<uint64_t>     children(header.children_count);
+    std::vector<uint32_t>     tags(header.tag_count);
+    std::vector<uint64_t>     usable_ids(header.usable_id_count);
+
+    reader.read_bytes(records.data(), records.size() * sizeof(EntityRecord));
+    reader.read_bytes(children.data(), children.size() * sizeof(uint64_t));
+    reader.read_bytes(tags.data(), tags.size() * sizeof(uint32_t));
+    reader.read_bytes(usable_ids.data(), usable_ids.size() * sizeof(uint64_t));
+
+    // Everything is validated, and the pools decoded, before the scene is
+    // modified, so a malformed snapshot leaves the scene as it was
+
+    if(!records[header.root].alive)
+        throw std::runtime_error("Scene snapshot : invalid header");
+
+    // Makes sure an entity is only the child of one parent
+    std::vector<bool> linked(records.size(), false);
+
+    for(std::size_t i = 0; i < records.size(); i++)
+    {
+        const auto& record = records[i];
+
+        if(!record.alive)
+            continue;
+
+        if(record.name >= strings.size() ||
+           record.first_child + record.child_count > children.size() ||
+           static_cast<uint64_t>(record.first_tag) + record.tag_count > tags.size())
+            throw std::runtime_error("Scene snapshot : invalid entity record");
+
+        for(uint32_t t = 0; t < record.tag_count; t++)
+        {
+            if(tags[record.first_tag + t] >= strings.size())
+                throw std::runtime_error("Scene snapshot : invalid tag");
+        }
+
+        if(record.parent != no_parent && record.parent >= records.size())
+            throw std::runtime_error("Scene snapshot : invalid parent");
+
+        for(uint32_t c = 0; c < record.child_count; c++)
+        {
+            const auto child = children[record.first_child + c];
+
+            if(child >= records.size() || !records[child].alive ||
+               records[child].parent != i || linked[child])
+                throw std::runtime_error("Scene snapshot : invalid child");
+
+            linked[child] = true;
+        }
+    }
+
+    for(auto id : usable_ids)
+    {
+        if(id >= records.size() || records[id].alive)
+            throw std::runtime_error("Scene snapshot : invalid usable id");
+    }
+
+    // Pools are read into new pools, whose components are swapped with the
+    // scene's ones afterward
+
+    std::vector<std::pair<std::type_index, std::unique_ptr<AbstractComponentPool>>> pools;
+
+    for(uint64_t p = 0; p < header.pool_count; p++)
+    {
+        const auto& name  = reader.read_string();
+        const auto  count = reader.read<uint64_t>();
+
+        if(count > reader.remaining() / sizeof(uint64_t))
+            throw std::runtime_error("Scene snapshot : invalid pool");
+
+        std::vector<size_t> ids(count);
+
+        for(auto& id : ids)
+        {
+            id = reader.read<uint64_t>();
+
+            if(id >= records.size() || !records[id].alive)
+                throw std::runtime_error("Scene snapshot : invalid component owner");
+        }
+
+        const auto block_size = reader.read<uint64_t>();
+
+        if(block_size > reader.remaining())
+            throw std::runtime_error("Scene snapshot : unexpected end of data");
+
+        SnapshotReader block(reader.data_ + reader.offset_, block_size, strings);
+        reader.offset_ += block_size;
+
+        // Pools of types that aren't registered anymore are skipped
+        const auto* entry = ComponentRegistry::find(std::string_view(name));
+
+        if(entry == nullptr)
+            continue;
+
+        auto pool = entry->make_pool();
+        entry->read(*pool, block, std::move(ids));
+        pools.emplace_back(entry->type, std::move(pool));
+    }
+
+    // Entities
+
+    for(auto& [type, pool] : scene.component_maps())
+        pool->clear();
+
+    scene.names_.clear();
+    scene.tags_.clear();
+    scene.strings_.clear();
+
+    auto& entities = scene.entities_;
+    entities.clear();
+    entities.resize(records.size());
+
+    scene.links_.assign(records.size(), Scene::Links());
+    scene.name_positions_.assign(records.size(), 0);
+
+    for(std::size_t i = 0; i < records.size(); i++)
+    {
+        const auto& record = records[i];
+
+        if(!record.alive)
+        {
+            entities[i] = Entity(EntityId(i), scene);
+            continue;
+        }
+
+        auto& entity = entities[i] =
+            Entity(EntityId(i), scene, scene.strings_.intern(strings[record.name]));
+
+        entity.current_layer_    = record.current_layer;
+        entity.actual_layer_flag = record.layer_flag;
+        entity._enabled          = static_cast<char>(record.enabled);
+        entity._depth            = static_cast<char>(record.depth);
+
+        scene.add_name(entity.name_, entity._id);
+
+        entity.tags_.reserve(record.tag_count);
+
+        for(uint32_t t = 0; t < record.tag_count; t++)
+        {
+            const auto& tag = strings[tags[record.first_tag + t]];
+
+            entity.tags_.push_back(tag);
+            Scene::add_to_index(scene.tags_, tag, entity._id);
+        }
+    }
+
+    // Every entity exists now, so we can link them together. Children are
+    // appended in the order they were written
+
+    for(std::size_t i = 0; i < records.size(); i++)
+    {
+        const auto& record = records[i];
+
+        if(!record.alive)
+            continue;
+
+        for(uint32_t c = 0; c < record.child_count; c++)
+            scene.link(EntityId(children[record.first_child + c]), EntityId(i));
+    }
+
+    scene._usable_ids.clear();
+
+    for(auto id : usable_ids)
+        scene._usable_ids.push_back(EntityId(id));
+
+    scene._existing_id_count = static_cast<int>(entities.size());
+    scene.root_              = RefEntity(scene, entities[header.root]);
+
+    // Pools
+
+    auto& scene_pools = scene.component_maps();
+
+    for(auto& [type, pool] : pools)
+    {
+        if(scene_pools.contains(type))
+            scene_pools.get(type)->swap_components(*pool);
+        else
+            scene_pools.add(type, std::move(pool));
+    }
+}
+
+bool SceneSnapshot::save(Scene& scene, const std::string& path)
+{
+    std::vector<char> buffer;
+    write(scene, buffer);
+
+    std::ofstream file(path, std::ios::binary);
+
+    if(!file)
+        return false;
+
+    file.write(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+    return static_cast<bool>(file);
+}
+
+bool SceneSnapshot::load(Scene& scene, const std::string& path)
+{
+    std::ifstream file(path, std::ios::binary | std::ios::ate);
+
+    if(!file)
+        return false;
+
+    std::vector<char> buffer(static_cast<std::size_t>(file.tellg()));
+    file.seekg(0);
+    file.read(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+
+    if(!file)
+        return false;
+
+    read(scene, buffer.data(), buffer.size());
+    return true;
+}
+}    // namespace corgi
@@ -0,0 +1,78 @@
+#include <corgi/ecs/StringPool.h>
+
+namespace corgi
+{
+StringPool::Handle StringPool::intern(std::string_view str, std::uint32_t count)
+{
+    if(const auto it = lookup_.find(str); it != lookup_.end())
+    {
+        strings_[it->second].references += count;
+        return it->second;
+    }
+
+    Handle handle;
+
+    if(free_slots_.empty())
+    {
+        handle = static_cast<Handle>(strings_.size());
+        strings_.emplace_back();
+    }
+    else
+    {
+        handle = free_slots_.back();
+        free_slots_.pop_back();
+    }
+
+    auto& slot      = strings_[handle];
+    slot.str        = std::make_unique<std::string>(str);
+    slot.references = count;
+
+    lookup_.emplace(std::string_view(*slot.str), handle);
+    return handle;
+}
+
+void StringPool::retain(Handle handle, std::uint32_t count) noexcept
+{
+    strings_[handle].references += count;
+}
+
+void StringPool::release(Handle handle) noexcept
+{
+    auto& slot = strings_[handle];
+
+    if(--slot.references != 0)
+        return;
+
+    lookup_.erase(std::string_view(*slot.str));
+    slot.str.reset();
+    free_slots_.push_back(handle);
+}
+
+void StringPool::clear() noexcept
+{
+    lookup_.clear();
+    strings_.clear();
+    free_slots_.clear();
+}
+
+StringPool::Handle StringPool::find(std::string_view str) const noexcept
+{
+    const auto it = lookup_.find(str);
+    return it == lookup_.end() ? npos : it->second;
+}
+
+std::string_view StringPool::view(Handle handle) const noexcept
+{
+    return *strings_[handle].str;
+}
+
+const char* StringPool::c_str(Handle handle) const noexcept
+{
+    return strings_[handle].str->c_str();
+}
+
+std::uint32_t StringPool::references(Handle handle) const noexcept
+{
+    return handle < strings_.size() ? strings_[handle].references : 0;
+}
+}    // namespace corgi
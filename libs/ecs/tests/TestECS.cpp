@@ -7,10 +7,13 @@
 
 #include <corgi/ecs/Component.h>
 #include <corgi/ecs/Entity.h>
+#include <corgi/ecs/Prefab.h>
 #include <corgi/ecs/Scene.h>
+#include <corgi/ecs/SceneSnapshot.h>
 #include <corgi/test/test.h>
 
 #include <set>
+#include <stdexcept>
 
 using namespace corgi;
 using namespace test;
@@ -135,6 +138,33 @@ TEST_F(ComponentPoolsTest, IterateOver)
     assert_that(pools().size(), equals(2));
 }
 
+TEST_F(ComponentPoolsTest, TypeIds)
+{
+    const auto test_id  = component_type_id<TestComponent>();
+    const auto other_id = component_type_id<OtherComponent>();
+
+    assert_that(test_id, non_equals(other_id));
+    assert_that(component_type_id<TestComponent>(), equals(test_id));
+
+    // Every family has its own counter
+    assert_that(TypeIds<AbstractComponentPool>::count() >= 2, equals(true));
+}
+
+TEST_F(ComponentPoolsTest, RemovedPoolIsNotFound)
+{
+    pools().add<TestComponent>();
+    pools().remove<TestComponent>();
+
+    const auto& const_pools = pools();
+
+    assert_that(pools().contains<TestComponent>(), equals(false));
+    assert_that(const_pools.get<TestComponent>() == nullptr, equals(true));
+
+    // Adding it back gives a new, empty pool
+    pools().get<TestComponent>()->add_param(EntityId(0u), 3);
+    assert_that(pools().get<TestComponent>()->size(), equals(1));
+}
+
 class ComponentPoolTest : public test::Test
 {
 public:
@@ -432,4 +462,480 @@ TEST_F(EntityTest, CloneEntity)
     assert_that(cloned->has_component<TestComponent>(), equals(true));
     assert_that(cloned->get_component<TestComponent>()->x,
                 equals(entity->get_component<TestComponent>()->x));
-}
\ No newline at end of file
+}
+class EntityIndexTest : public test::Test
+{
+public:
+    Scene scene;
+
+    void set_up() override {}
+    void tear_down() override {}
+};
+
+TEST_F(EntityIndexTest, FindByName)
+{
+    auto player = scene.new_entity("Player");
+    auto weapon = player->emplace_back("Weapon");
+
+    assert_that(scene.find("Player")->id(), equals(player->id()));
+    assert_that(scene.find("Weapon")->id(), equals(weapon->id()));
+    assert_that(static_cast<bool>(scene.find("Enemy")), equals(false));
+
+    // The entity itself isn't part of its own lookup
+    assert_that(static_cast<bool>(weapon->find("Weapon")), equals(false));
+}
+
+TEST_F(EntityIndexTest, DuplicateNames)
+{
+    auto first  = scene.new_entity("Group");
+    auto second = scene.new_entity("Group");
+    auto nested = first->emplace_back("Enemy");
+
+    second->emplace_back("Enemy");
+    second->emplace_back("Enemy");
+
+    assert_that(scene.find_all("Enemy").size(), equals(3u));
+
+    // Like the depth first walk, the first enemy of the first group wins
+    assert_that(scene.find("Enemy")->id(), equals(nested->id()));
+    assert_that(second->find_all("Enemy").size(), equals(2u));
+    assert_that(first->find("Enemy")->id(), equals(nested->id()));
+}
+
+TEST_F(EntityIndexTest, RenameAndRemove)
+{
+    auto entity = scene.new_entity("Before");
+    auto child  = entity->emplace_back("Child");
+
+    entity->rename("After");
+
+    assert_that(static_cast<bool>(scene.find("Before")), equals(false));
+    assert_that(scene.find("After")->id(), equals(entity->id()));
+
+    scene.root()->remove_child(entity);
+    entity->remove();
+
+    assert_that(static_cast<bool>(scene.find("After")), equals(false));
+    assert_that(static_cast<bool>(scene.find("Child")), equals(false));
+}
+
+TEST_F(EntityIndexTest, Reparent)
+{
+    auto left  = scene.new_entity("Left");
+    auto right = scene.new_entity("Right");
+    auto item  = left->emplace_back("Item");
+
+    item->parent(right);
+
+    assert_that(static_cast<bool>(left->find("Item")), equals(false));
+    assert_that(right->find("Item")->id(), equals(item->id()));
+    assert_that(left->children().empty(), equals(true));
+    assert_that(static_cast<int>(item->_depth), equals(2));
+
+    bool thrown = false;
+
+    try
+    {
+        right->parent(item);
+    }
+    catch(const std::invalid_argument&)
+    {
+        thrown = true;
+    }
+    assert_that(thrown, equals(true));
+}
+
+TEST_F(EntityIndexTest, Tags)
+{
+    auto enemy = scene.new_entity("Enemy");
+    auto boss  = scene.new_entity("Boss");
+
+    enemy->add_tag("hostile");
+    boss->add_tag("hostile");
+    boss->add_tag("hostile");
+
+    assert_that(boss->tags().size(), equals(1u));
+    assert_that(scene.find_all_by_tag("hostile").size(), equals(2u));
+    assert_that(scene.find_by_tag("hostile")->id(), equals(enemy->id()));
+
+    enemy->remove_tag("hostile");
+
+    assert_that(enemy->has_tag("hostile"), equals(false));
+    assert_that(scene.find_by_tag("hostile")->id(), equals(boss->id()));
+}
+
+class StringPoolTest : public test::Test
+{
+public:
+    StringPool pool;
+
+    void set_up() override {}
+    void tear_down() override {}
+};
+
+TEST_F(StringPoolTest, Intern)
+{
+    const auto a = pool.intern("Enemy");
+    const auto b = pool.intern("Enemy");
+    const auto c = pool.intern("Player");
+
+    assert_that(a, equals(b));
+    assert_that(a, non_equals(c));
+    assert_that(pool.size(), equals(2u));
+    assert_that(pool.references(a), equals(2u));
+    assert_that(pool.view(c) == "Player", equals(true));
+    assert_that(pool.find("Player"), equals(c));
+    assert_that(pool.find("Boss"), equals(StringPool::npos));
+}
+
+TEST_F(StringPoolTest, ReleaseReusesSlot)
+{
+    const auto a = pool.intern("Enemy", 2);
+
+    pool.release(a);
+    assert_that(pool.find("Enemy"), equals(a));
+
+    pool.release(a);
+    assert_that(pool.find("Enemy"), equals(StringPool::npos));
+    assert_that(pool.size(), equals(0u));
+
+    // The freed slot is handed to the next new string
+    assert_that(pool.intern("Player"), equals(a));
+    assert_that(pool.slot_count(), equals(1u));
+}
+
+class EntityStorageTest : public test::Test
+{
+public:
+    Scene scene;
+
+    void set_up() override {}
+    void tear_down() override {}
+};
+
+TEST_F(EntityStorageTest, EntitiesNeverMove)
+{
+    auto  first   = scene.new_entity("First");
+    auto* address = &scene.get_entity(first->id());
+
+    for(std::size_t i = 0; i < 3 * Scene::EntityStorage::chunk_size; i++)
+        scene.new_entity("Filler");
+
+    assert_that(&scene.get_entity(first->id()) == address, equals(true));
+
+    // Every filler shares the same string
+    assert_that(scene.names().references(scene.names().find("Filler")),
+                equals(static_cast<std::uint32_t>(3 * Scene::EntityStorage::chunk_size)));
+}
+
+TEST_F(EntityStorageTest, ChildrenLinks)
+{
+    auto parent = scene.new_entity("Parent");
+    auto a      = parent->emplace_back("A");
+    auto b      = parent->emplace_back("B");
+    auto c      = parent->emplace_back("C");
+
+    assert_that(parent->children().size(), equals(3u));
+    assert_that(parent->children().front()->id(), equals(a->id()));
+    assert_that(parent->children().back()->id(), equals(c->id()));
+    assert_that(b->parent()->id(), equals(parent->id()));
+
+    b->remove();
+
+    assert_that(parent->children().size(), equals(2u));
+    assert_that(parent->children().at(1)->id(), equals(c->id()));
+
+    // Moving an entity appends it at the end of its new parent's children
+    a->parent(c);
+
+    assert_that(parent->children().size(), equals(1u));
+    assert_that(c->children().front()->id(), equals(a->id()));
+    assert_that(a->depth(), equals(3));
+}
+
+TEST_F(EntityStorageTest, DepthFirstIteration)
+{
+    auto parent = scene.new_entity("Parent");
+    auto a      = parent->emplace_back("A");
+    a->emplace_back("A1");
+    a->emplace_back("A2");
+    parent->emplace_back("B")->emplace_back("B1");
+
+    // The sibling after the iterated entity isn't part of its subtree
+    scene.new_entity("Sibling");
+
+    std::string order;
+
+    for(auto entity : *parent)
+        order += std::string(entity->name()) + " ";
+
+    assert_that(order, equals(std::string("A A1 A2 B B1 ")));
+}
+
+class CountingSystem : public AbstractSystem
+{
+public:
+    std::vector<int>& calls;
+    int               value;
+
+    CountingSystem(std::vector<int>& c, int v)
+        : calls(c)
+        , value(v)
+    {
+    }
+
+protected:
+    void update(float) override { calls.push_back(value); }
+};
+
+class OtherCountingSystem : public CountingSystem
+{
+public:
+    using CountingSystem::CountingSystem;
+};
+
+TEST_F(EntityTest, Systems)
+{
+    std::vector<int> calls;
+
+    assert_that(scene.has_system<CountingSystem>(), equals(false));
+    assert_that(scene.get_system<CountingSystem>() == nullptr, equals(true));
+
+    scene.emplace_system<OtherCountingSystem>(calls, 1);
+    scene.emplace_system<CountingSystem>(calls, 2);
+
+    // Emplacing a system twice keeps the first one
+    scene.emplace_system<CountingSystem>(calls, 3);
+
+    assert_that(scene.has_system<CountingSystem>(), equals(true));
+    assert_that(scene.get_system<CountingSystem>()->value, equals(2));
+    assert_that(scene.get_system<OtherCountingSystem>()->value, equals(1));
+
+    scene.update(0.0f);
+
+    assert_that(calls.size(), equals(2u));
+    assert_that(calls[0], equals(1));
+    assert_that(calls[1], equals(2));
+}
+
+class PrefabTest : public test::Test
+{
+public:
+    Scene scene;
+
+    RefEntity source;
+
+    void set_up() override
+    {
+        source     = scene.new_entity("Enemy");
+        auto arm   = source->emplace_back("Arm");
+        auto hand  = arm->emplace_back("Hand");
+        auto other = source->emplace_back("Head");
+
+        source->add_component<TestComponent>(1);
+        hand->add_component<TestComponent>(3);
+        other->add_component<OtherComponent>();
+        hand->add_tag("weapon");
+    }
+
+    void tear_down() override {}
+};
+
+TEST_F(PrefabTest, Compile)
+{
+    Prefab prefab(source);
+
+    assert_that(prefab.node_count(), equals(4u));
+}
+
+TEST_F(PrefabTest, Instantiate)
+{
+    Prefab prefab(source);
+
+    auto copies = prefab.instantiate(scene, 10);
+
+    assert_that(copies.size(), equals(10u));
+    assert_that(scene.find_all("Hand").size(), equals(11u));
+    assert_that(scene.find_all_by_tag("weapon").size(), equals(11u));
+    assert_that(scene.component_maps().get<TestComponent>()->size(), equals(22));
+
+    for(auto copy : copies)
+    {
+        assert_that(copy->parent()->id(), equals(scene.root()->id()));
+        assert_that(copy->children().size(), equals(2u));
+        assert_that(copy->get_component<TestComponent>()->x, equals(1));
+
+        auto hand = copy->find("Hand");
+
+        assert_that(hand->parent()->parent()->id(), equals(copy->id()));
+        assert_that(static_cast<int>(hand->_depth), equals(3));
+        assert_that(hand->get_component<TestComponent>()->x, equals(3));
+        assert_that(copy->find("Head")->has_component<OtherComponent>(), equals(true));
+    }
+}
+
+TEST_F(PrefabTest, InstantiateInAnotherScene)
+{
+    Prefab prefab(source);
+
+    Scene other;
+    auto  parent = other.new_entity("Spawner");
+    auto  copy   = prefab.instantiate(other, parent);
+
+    assert_that(copy->parent()->id(), equals(parent->id()));
+    assert_that(other.component_maps().contains<OtherComponent>(), equals(true));
+    assert_that(parent->find("Hand")->get_component<TestComponent>()->x, equals(3));
+}
+
+struct Velocity
+{
+    float x;
+    float y;
+};
+
+class SceneSnapshotTest : public test::Test
+{
+public:
+    Scene scene;
+
+    void set_up() override
+    {
+        ComponentRegistry::add<Velocity>("Velocity");
+        ComponentRegistry::add<TestComponent>(
+            "TestComponent",
+            [](const TestComponent& component, SnapshotWriter& writer)
+            { writer.write(component.x); },
+            [](SnapshotReader& reader) { return TestComponent(reader.read<int>()); });
+
+        auto player = scene.new_entity("Player");
+        auto weapon = player->emplace_back("Weapon");
+        auto enemy  = scene.new_entity("Enemy");
+        auto dead   = scene.new_entity("Dead");
+
+        player->add_component<Velocity>(Velocity {1.0f, 2.0f});
+        enemy->add_component<Velocity>(Velocity {3.0f, 4.0f});
+        weapon->add_component<TestComponent>(42);
+        weapon->add_tag("item");
+        enemy->disable();
+
+        scene.remove_entity(dead);
+    }
+
+    void tear_down() override { ComponentRegistry::clear(); }
+};
+
+TEST_F(SceneSnapshotTest, RoundTrip)
+{
+    std::vector<char> buffer;
+    SceneSnapshot::write(scene, buffer);
+
+    Scene loaded;
+    loaded.new_entity("Overwritten")->add_component<Velocity>(Velocity {});
+
+    SceneSnapshot::read(loaded, buffer.data(), buffer.size());
+
+    assert_that(static_cast<bool>(loaded.find("Overwritten")), equals(false));
+    assert_that(loaded.root()->children().size(), equals(2u));
+
+    auto player = loaded.find("Player");
+    auto weapon = loaded.find("Weapon");
+    auto enemy  = loaded.find("Enemy");
+
+    assert_that(weapon->parent()->id(), equals(player->id()));
+    assert_that(static_cast<int>(weapon->_depth), equals(2));
+    assert_that(enemy->is_enabled(), equals(false));
+    assert_that(loaded.find_by_tag("item")->id(), equals(weapon->id()));
+
+    assert_that(player->get_component<Velocity>()->y, equals(2.0f));
+    assert_that(enemy->get_component<Velocity>()->x, equals(3.0f));
+    assert_that(weapon->get_component<TestComponent>()->x, equals(42));
+    assert_that(loaded.component_maps().get<Velocity>()->size(), equals(2));
+
+    // The removed entity's id is reused first, like in the saved scene
+    auto reused = loaded.new_entity("Reused");
+    auto again  = scene.new_entity("Reused");
+
+    assert_that(reused->id(), equals(again->id()));
+}
+
+TEST_F(SceneSnapshotTest, UnregisteredPoolsAreSkipped)
+{
+    scene.find("Enemy")->add_component<OtherComponent>();
+
+    std::vector<char> buffer;
+    SceneSnapshot::write(scene, buffer);
+
+    Scene loaded;
+    SceneSnapshot::read(loaded, buffer.data(), buffer.size());
+
+    assert_that(loaded.component_maps().contains<OtherComponent>(), equals(false));
+    assert_that(loaded.component_maps().contains<Velocity>(), equals(true));
+}
+
+TEST_F(SceneSnapshotTest, InvalidData)
+{
+    std::vector<char> buffer;
+    SceneSnapshot::write(scene, buffer);
+
+    Scene loaded;
+    bool  thrown = false;
+
+    try
+    {
+        SceneSnapshot::read(loaded, buffer.data(), buffer.size() / 2);
+    }
+    catch(const std::runtime_error&)
+    {
+        thrown = true;
+    }
+    assert_that(thrown, equals(true));
+
+    thrown    = false;
+    buffer[0] = 'X';
+
+    try
+    {
+        SceneSnapshot::read(loaded, buffer.data(), buffer.size());
+    }
+    catch(const std::runtime_error&)
+    {
+        thrown = true;
+    }
+    assert_that(thrown, equals(true));
+}
+
+TEST_F(SceneSnapshotTest, InvalidDataLeavesSceneUntouched)
+{
+    std::vector<char> buffer;
+    SceneSnapshot::write(scene, buffer);
+
+    // The children array follows the header (72 bytes) and the entity
+    // records (56 bytes each). Its first child now points past the entities
+    uint64_t entity_count = 0;
+    std::memcpy(&entity_count, buffer.data() + 8, sizeof(uint64_t));
+
+    const uint64_t invalid_child = 1000;
+    std::memcpy(buffer.data() + 72 + entity_count * 56, &invalid_child, sizeof(uint64_t));
+
+    Scene loaded;
+    loaded.new_entity("Kept")->add_component<Velocity>(Velocity {5.0f, 6.0f});
+
+    bool thrown = false;
+
+    try
+    {
+        SceneSnapshot::read(loaded, buffer.data(), buffer.size());
+    }
+    catch(const std::runtime_error&)
+    {
+        thrown = true;
+    }
+    assert_that(thrown, equals(true));
+
+    auto kept = loaded.find("Kept");
+
+    assert_that(static_cast<bool>(kept), equals(true));
+    assert_that(static_cast<bool>(loaded.find("Player")), equals(false));
+    assert_that(kept->get_component<Velocity>()->x, equals(5.0f));
+    assert_that(loaded.component_maps().get<Velocity>()->size(), equals(1));
+}
@@ -0,0 +1,59 @@
+#pragma once
+
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace corgi::filesystem
+{
+/*!
+ * @brief   Tells which files were written inside a set of directories
+ *
+ *          Uses inotify on Linux, so watching a directory costs nothing
+ *          until one of its files changes. Other platforms aren't supported
+ *          yet : watch() returns false and poll() never reports anything
+ */
+class FileWatcher
+{
+public:
+    // Lifecycle
+
+    FileWatcher();
+    ~FileWatcher();
+
+    FileWatcher(const FileWatcher& other)            = delete;
+    FileWatcher& operator=(const FileWatcher& other) = delete;
+
+    // Functions
+
+    /*!
+     * @brief   Returns true if files can be watched on this platform
+     */
+    [[nodiscard]] static bool is_supported() noexcept;
+
+    /*!
+     * @brief   Watches @a directory and its sub directories, including the
+     *          ones created afterward
+     *
+     * @return  Returns false if the directory couldn't be watched
+     */
+    bool watch(const std::string& directory);
+
+    /*!
+     * @brief   Waits at most @a timeout_ms milliseconds for a change, then
+     *          returns the full path of every file written, created or moved
+     *          inside the watched directories since the last call
+     *
+     *          A file written several times is reported as many times
+     */
+    [[nodiscard]] std::vector<std::string> poll(int timeout_ms);
+
+private:
+    void add_watch(const std::string& directory);
+
+    int fd_ {-1};
+
+    // Watched directories, indexed by their inotify watch descriptor
+    std::unordered_map<int, std::string> directories_;
+};
+}    // namespace corgi::filesystem
@@ -0,0 +1,71 @@
+#pragma once
+
+#include <cstddef>
+#include <string>
+
+namespace corgi::filesystem
+{
+/*!
+ * @brief   Read only view of a file mapped in memory
+ *
+ *          The file's content is only loaded by the system when it's
+ *          accessed, and stays shared with the page cache, so opening a
+ *          big file costs the same as opening a small one
+ */
+class MappedFile
+{
+public:
+    // Lifecycle
+
+    MappedFile() = default;
+
+    /*!
+     * @brief   Maps the file located at @a path. Check is_open() to know if
+     *          it succeeded
+     */
+    explicit MappedFile(const std::string& path);
+
+    MappedFile(const MappedFile& other)            = delete;
+    MappedFile& operator=(const MappedFile& other) = delete;
+
+    MappedFile(MappedFile&& other) noexcept;
+    MappedFile& operator=(MappedFile&& other) noexcept;
+
+    ~MappedFile();
+
+    // Functions
+
+    /*!
+     * @brief   Maps the file located at @a path, closing the previously
+     *          mapped file if any
+     *
+     * @return  Returns false if the file doesn't exist, is empty or couldn't
+     *          be mapped
+     */
+    bool open(const std::string& path);
+
+    void close() noexcept;
+
+    [[nodiscard]] bool is_open() const noexcept;
+
+    /*!
+     * @brief   Returns the beginning of the mapping. The mapping is aligned on
+     *          a page, so it's safe to align data relatively to it
+     */
+    [[nodiscard]] const std::byte* data() const noexcept;
+
+    /*!
+     * @brief   Returns the file's size in bytes
+     */
+    [[nodiscard]] std::size_t size() const noexcept;
+
+private:
+    const std::byte* data_ {nullptr};
+    std::size_t      size_ {0};
+
+#ifdef _WIN32
+    void* file_ {nullptr};
+    void* mapping_ {nullptr};
+#endif
+};
+}    // namespace corgi::filesystem
@@ -0,0 +1,135 @@
+#pragma once
+
+#include <corgi/filesystem/MappedFile.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+namespace corgi::filesystem
+{
+/*!
+ * @brief   Returns the 64 bits FNV-1a hash of @a data
+ *
+ *          Used for the paths and the contents stored inside pack files, so
+ *          the value must never change from one version to the next
+ */
+[[nodiscard]] std::uint64_t hash(std::span<const std::byte> data) noexcept;
+[[nodiscard]] std::uint64_t hash(std::string_view str) noexcept;
+
+/*!
+ * @brief   Read only archive of files, built offline and memory mapped
+ *
+ *          Opening a pack maps it and checks its header, nothing else is
+ *          read. Files are then accessed through spans pointing inside the
+ *          mapping, without any copy or system call
+ *
+ *          Layout :
+ *
+ *          Header
+ *          Entry[entry_count]      Sorted by path hash, the manifest
+ *          char[paths_size]        Every path, not null terminated
+ *          Content                 Every file, aligned on @a alignment bytes
+ */
+class PackFile
+{
+public:
+    static constexpr std::uint32_t magic     = 0x4b415043;    // "CPAK"
+    static constexpr std::uint32_t version   = 1;
+    static constexpr std::size_t   alignment = 16;
+
+    struct Header
+    {
+        std::uint32_t magic;
+        std::uint32_t version;
+        std::uint32_t entry_count;
+        std::uint32_t paths_size;
+    };
+
+    struct Entry
+    {
+        std::uint64_t path_hash;
+        std::uint64_t content_hash;
+        std::uint64_t offset;    // From the beginning of the pack
+        std::uint64_t size;
+        std::uint32_t path_offset;    // Inside the paths
+        std::uint32_t path_size;
+    };
+
+    static_assert(sizeof(Header) == 16, "Pack files are read without padding");
+    static_assert(sizeof(Entry) == 40, "Pack files are read without padding");
+
+    /*!
+     * @brief   A file to be written inside a pack, as a path relative to the
+     *          pack's root and the file's content
+     */
+    using File = std::pair<std::string, std::vector<std::byte>>;
+
+    // Lifecycle
+
+    PackFile() = default;
+
+    /*!
+     * @brief   Maps the pack located at @a path. Check is_open() to know if it
+     *          succeeded
+     */
+    explicit PackFile(const std::string& path);
+
+    // Functions
+
+    /*!
+     * @brief   Maps the pack located at @a path, closing the previous one
+     *
+     * @return  Returns false if the file couldn't be mapped, or isn't a valid
+     *          pack
+     */
+    bool open(const std::string& path);
+
+    void close() noexcept;
+
+    [[nodiscard]] bool is_open() const noexcept;
+
+    /*!
+     * @brief   Returns the entry of the file located at @a path, or nullptr
+     *          if the pack doesn't contain it
+     */
+    [[nodiscard]] const Entry* find(std::string_view path) const noexcept;
+
+    /*!
+     * @brief   Same as find(path), with the path's hash already computed
+     */
+    [[nodiscard]] const Entry* find(std::string_view path, std::uint64_t path_hash) const noexcept;
+
+    [[nodiscard]] std::span<const Entry> entries() const noexcept;
+
+    [[nodiscard]] std::string_view path(const Entry& entry) const noexcept;
+
+    /*!
+     * @brief   Returns the content of @a entry, pointing inside the mapping
+     */
+    [[nodiscard]] std::span<const std::byte> content(const Entry& entry) const noexcept;
+
+    /*!
+     * @brief   Returns true if the content of @a entry still matches the hash
+     *          computed when the pack was written
+     */
+    [[nodiscard]] bool verify(const Entry& entry) const noexcept;
+
+    /*!
+     * @brief   Writes a pack containing @a files at @a path
+     *
+     * @return  Returns false if the file couldn't be written
+     */
+    static bool write(const std::string& path, const std::vector<File>& files);
+
+private:
+    MappedFile    file_;
+    const Header* header_ {nullptr};
+    const Entry*  entries_ {nullptr};
+    const char*   paths_ {nullptr};
+};
+}    // namespace corgi::filesystem
@@ -0,0 +1,90 @@
+#pragma once
+
+#include <corgi/filesystem/PackFile.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <span>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+namespace corgi::filesystem
+{
+/*!
+ * @brief   Gives access to the files of every mounted pack through their path
+ *
+ *          Mounting a pack adds its prebuilt manifest to a single table
+ *          indexed by path hash, so finding a file never touches the disk
+ *          nor builds a string, whatever the number of packs. When several
+ *          packs contain the same path, the last mounted one wins, so a
+ *          patch can be mounted over the base pack
+ */
+class VirtualFileSystem
+{
+public:
+    // Functions
+
+    /*!
+     * @brief   Maps the pack located at @a path and adds its files
+     *
+     * @return  Returns false if the pack couldn't be opened
+     */
+    bool mount(const std::string& path);
+
+    /*!
+     * @brief   Unmounts every pack. The spans returned by read() are
+     *          invalidated
+     */
+    void unmount_all() noexcept;
+
+    [[nodiscard]] bool contains(std::string_view path) const noexcept;
+
+    /*!
+     * @brief   Returns the content of the file located at @a path, pointing
+     *          inside its pack's mapping, or an empty span if no mounted pack
+     *          contains it
+     *
+     *          The span stays valid until the packs are unmounted
+     */
+    [[nodiscard]] std::span<const std::byte> read(std::string_view path) const noexcept;
+
+    /*!
+     * @brief   Returns the hash of the file's content computed when its pack
+     *          was built, or 0 if no mounted pack contains it
+     */
+    [[nodiscard]] std::uint64_t content_hash(std::string_view path) const noexcept;
+
+    /*!
+     * @brief   Returns the path of every file, in no particular order
+     */
+    [[nodiscard]] std::vector<std::string_view> paths() const;
+
+    /*!
+     * @brief   Returns how many distinct files are available
+     */
+    [[nodiscard]] std::size_t size() const noexcept;
+
+    [[nodiscard]] std::size_t pack_count() const noexcept { return packs_.size(); }
+
+private:
+    struct Location
+    {
+        const PackFile*        pack;
+        const PackFile::Entry* entry;
+    };
+
+    [[nodiscard]] const Location* find(std::string_view path) const noexcept;
+
+    // Packs are never moved once mounted, locations point inside them
+    std::vector<std::unique_ptr<PackFile>> packs_;
+
+    std::unordered_map<std::uint64_t, Location> files_;
+
+    // Files whose path hash was already used by another path. Practically
+    // always empty
+    std::vector<Location> collisions_;
+};
+}    // namespace corgi::filesystem
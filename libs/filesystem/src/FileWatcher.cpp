@@ -0,0 +1,142 @@
+#include <corgi/filesystem/FileWatcher.h>
+
+#include <filesystem>
+
+#ifdef __linux__
+#include <poll.h>
+#include <sys/inotify.h>
+#include <unistd.h>
+#else
+#include <chrono>
+#include <thread>
+#endif
+
+namespace corgi::filesystem
+{
+#ifdef __linux__
+
+namespace
+{
+constexpr auto watched_events = IN_CLOSE_WRITE | IN_MOVED_TO | IN_CREATE;
+}
+
+FileWatcher::FileWatcher()
+    : fd_(inotify_init1(IN_NONBLOCK | IN_CLOEXEC))
+{
+}
+
+FileWatcher::~FileWatcher()
+{
+    if(fd_ != -1)
+        ::close(fd_);
+}
+
+bool FileWatcher::is_supported() noexcept
+{
+    return true;
+}
+
+bool FileWatcher::watch(const std::string& directory)
+{
+    std::error_code error;
+
+    if(fd_ == -1 || !std::filesystem::is_directory(directory, error))
+        return false;
+
+    add_watch(directory);
+
+    for(const auto& item : std::filesystem::recursive_directory_iterator(directory, error))
+        if(item.is_directory())
+            add_watch(item.path().string());
+
+    return true;
+}
+
+void FileWatcher::add_watch(const std::string& directory)
+{
+    const int descriptor = inotify_add_watch(fd_, directory.c_str(), watched_events);
+
+    if(descriptor != -1)
+        directories_.insert_or_assign(descriptor, directory);
+}
+
+std::vector<std::string> FileWatcher::poll(int timeout_ms)
+{
+    std::vector<std::string> paths;
+
+    if(fd_ == -1)
+        return paths;
+
+    pollfd descriptor {fd_, POLLIN, 0};
+
+    if(::poll(&descriptor, 1, timeout_ms) <= 0)
+        return paths;
+
+    alignas(inotify_event) char buffer[4096];
+
+    for(;;)
+    {
+        const auto length = ::read(fd_, buffer, sizeof buffer);
+
+        if(length <= 0)
+            break;
+
+        for(const char* ptr = buffer; ptr < buffer + length;)
+        {
+            const auto* event = reinterpret_cast<const inotify_event*>(ptr);
+            ptr += sizeof(inotify_event) + event->len;
+
+            const auto directory = directories_.find(event->wd);
+
+            if(directory == directories_.end() || event->len == 0)
+                continue;
+
+            auto path = directory->second + "/" + event->name;
+
+            // Directories created afterward must be watched too. Files
+            // copied inside before the watch was added are missed, the
+            // editor will write them again
+            if(event->mask & IN_ISDIR)
+            {
+                if(event->mask & (IN_CREATE | IN_MOVED_TO))
+                    add_watch(path);
+                continue;
+            }
+
+            // Creating a file is followed by a IN_CLOSE_WRITE once its
+            // content has been written
+            if(event->mask & IN_CREATE)
+                continue;
+
+            paths.push_back(std::move(path));
+        }
+    }
+    return paths;
+}
+
+#else
+
+FileWatcher::FileWatcher() = default;
+
+FileWatcher::~FileWatcher() = default;
+
+bool FileWatcher::is_supported() noexcept
+{
+    return false;
+}
+
+bool FileWatcher::watch(const std::string& directory)
+{
+    return false;
+}
+
+void FileWatcher::add_watch(const std::string& directory) {}
+
+std::vector<std::string> FileWatcher::poll(int timeout_ms)
+{
+    std::this_thread::sleep_for(std::chrono::milliseconds(timeout_ms));
+    return {};
+}
+
+#endif
+}    // namespace corgi::filesystem
@@ -0,0 +1,172 @@
+#include <corgi/filesystem/MappedFile.h>
+
+#include <utility>
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace corgi::filesystem
+{
+MappedFile::MappedFile(const std::string& path)
+{
+    open(path);
+}
+
+MappedFile::MappedFile(MappedFile&& other) noexcept
+    : data_(std::exchange(other.data_, nullptr))
+    , size_(std::exchange(other.size_, 0))
+#ifdef _WIN32
+    , file_(std::exchange(other.file_, nullptr))
+    , mapping_(std::exchange(other.mapping_, nullptr))
+#endif
+{
+}
+
+MappedFile& MappedFile::operator=(MappedFile&& other) noexcept
+{
+    if(this != &other)
+    {
+        close();
+
+        data_ = std::exchange(other.data_, nullptr);
+        size_ = std::exchange(other.size_, 0);
+#ifdef _WIN32
+        file_    = std::exchange(other.file_, nullptr);
+        mapping_ = std::exchange(other.mapping_, nullptr);
+#endif
+    }
+    return *this;
+}
+
+MappedFile::~MappedFile()
+{
+    close();
+}
+
+#ifdef _WIN32
+
+bool MappedFile::open(const std::string& path)
+{
+    close();
+
+    file_ = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr,
+                        OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+
+    if(file_ == INVALID_HANDLE_VALUE)
+    {
+        file_ = nullptr;
+        return false;
+    }
+
+    LARGE_INTEGER file_size;
+
+    if(!GetFileSizeEx(file_, &file_size) || file_size.QuadPart == 0)
+    {
+        close();
+        return false;
+    }
+
+    mapping_ = CreateFileMappingA(file_, nullptr, PAGE_READONLY, 0, 0, nullptr);
+
+    if(mapping_ == nullptr)
+    {
+        close();
+        return false;
+    }
+
+    data_ = static_cast<const std::byte*>(MapViewOfFile(mapping_, FILE_MAP_READ, 0, 0, 0));
+
+    if(data_ == nullptr)
+    {
+        close();
+        return false;
+    }
+
+    size_ = static_cast<std::size_t>(file_size.QuadPart);
+    return true;
+}
+
+void MappedFile::close() noexcept
+{
+    if(data_ != nullptr)
+        UnmapViewOfFile(data_);
+
+    if(mapping_ != nullptr)
+        CloseHandle(mapping_);
+
+    if(file_ != nullptr)
+        CloseHandle(file_);
+
+    data_    = nullptr;
+    size_    = 0;
+    mapping_ = nullptr;
+    file_    = nullptr;
+}
+
+#else
+
+bool MappedFile::open(const std::string& path)
+{
+    close();
+
+    const int file = ::open(path.c_str(), O_RDONLY);
+
+    if(file == -1)
+        return false;
+
+    struct stat status;
+
+    if(fstat(file, &status) == -1 || status.st_size == 0)
+    {
+        ::close(file);
+        return false;
+    }
+
+    void* mapping =
+        mmap(nullptr, static_cast<std::size_t>(status.st_size), PROT_READ, MAP_PRIVATE, file, 0);
+
+    // The mapping stays valid once the file is closed
+    ::close(file);
+
+    if(mapping == MAP_FAILED)
+        return false;
+
+    data_ = static_cast<const std::byte*>(mapping);
+    size_ = static_cast<std::size_t>(status.st_size);
+    return true;
+}
+
+void MappedFile::close() noexcept
+{
+    if(data_ != nullptr)
+        munmap(const_cast<std::byte*>(data_), size_);
+
+    data_ = nullptr;
+    size_ = 0;
+}
+
+#endif
+
+bool MappedFile::is_open() const noexcept
+{
+    return data_ != nullptr;
+}
+
+const std::byte* MappedFile::data() const noexcept
+{
+    return data_;
+}
+
+std::size_t MappedFile::size() const noexcept
+{
+    return size_;
+}
+}    // namespace corgi::filesystem
@@ -0,0 +1,202 @@
+#include <corgi/filesystem/PackFile.h>
+
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <numeric>
+
+namespace corgi::filesystem
+{
+namespace
+{
+constexpr std::uint64_t fnv_offset = 14695981039346656037ull;
+constexpr std::uint64_t fnv_prime  = 1099511628211ull;
+
+std::uint64_t align(std::uint64_t value)
+{
+    return (value + PackFile::alignment - 1) / PackFile::alignment * PackFile::alignment;
+}
+}    // namespace
+
+std::uint64_t hash(std::span<const std::byte> data) noexcept
+{
+    auto result = fnv_offset;
+
+    for(auto byte : data)
+    {
+        result ^= static_cast<std::uint64_t>(byte);
+        result *= fnv_prime;
+    }
+    return result;
+}
+
+std::uint64_t hash(std::string_view str) noexcept
+{
+    return hash(std::as_bytes(std::span(str.data(), str.size())));
+}
+
+PackFile::PackFile(const std::string& path)
+{
+    open(path);
+}
+
+bool PackFile::open(const std::string& path)
+{
+    close();
+
+    if(!file_.open(path) || file_.size() < sizeof(Header))
+    {
+        close();
+        return false;
+    }
+
+    const auto* header = reinterpret_cast<const Header*>(file_.data());
+
+    const auto manifest_size =
+        sizeof(Header) + std::uint64_t(header->entry_count) * sizeof(Entry) + header->paths_size;
+
+    if(header->magic != magic || header->version != version || manifest_size > file_.size())
+    {
+        close();
+        return false;
+    }
+
+    header_  = header;
+    entries_ = reinterpret_cast<const Entry*>(file_.data() + sizeof(Header));
+    paths_   = reinterpret_cast<const char*>(entries_ + header->entry_count);
+
+    // A truncated pack would make content() read past the mapping. The
+    // offset is checked first so a corrupted size can't wrap the sum around
+    for(const auto& entry : entries())
+    {
+        if(entry.offset > file_.size() || entry.size > file_.size() - entry.offset ||
+           std::uint64_t(entry.path_offset) + entry.path_size > header->paths_size)
+        {
+            close();
+            return false;
+        }
+    }
+    return true;
+}
+
+void PackFile::close() noexcept
+{
+    file_.close();
+    header_  = nullptr;
+    entries_ = nullptr;
+    paths_   = nullptr;
+}
+
+bool PackFile::is_open() const noexcept
+{
+    return header_ != nullptr;
+}
+
+const PackFile::Entry* PackFile::find(std::string_view path) const noexcept
+{
+    return find(path, hash(path));
+}
+
+const PackFile::Entry* PackFile::find(std::string_view path, std::uint64_t path_hash) const noexcept
+{
+    const auto entries = this->entries();
+
+    auto it = std::lower_bound(entries.begin(), entries.end(), path_hash,
+                               [](const Entry& entry, std::uint64_t value)
+                               { return entry.path_hash < value; });
+
+    // Different paths can share a hash, so we check every entry using it
+    for(; it != entries.end() && it->path_hash == path_hash; ++it)
+        if(this->path(*it) == path)
+            return &*it;
+
+    return nullptr;
+}
+
+std::span<const PackFile::Entry> PackFile::entries() const noexcept
+{
+    if(header_ == nullptr)
+        return {};
+
+    return {entries_, header_->entry_count};
+}
+
+std::string_view PackFile::path(const Entry& entry) const noexcept
+{
+    return {paths_ + entry.path_offset, entry.path_size};
+}
+
+std::span<const std::byte> PackFile::content(const Entry& entry) const noexcept
+{
+    return {file_.data() + entry.offset, static_cast<std::size_t>(entry.size)};
+}
+
+bool PackFile::verify(const Entry& entry) const noexcept
+{
+    return hash(content(entry)) == entry.content_hash;
+}
+
+bool PackFile::write(const std::string& path, const std::vector<File>& files)
+{
+    std::vector<std::size_t> order(files.size());
+    std::iota(order.begin(), order.end(), 0u);
+
+    std::vector<std::uint64_t> hashes(files.size());
+
+    for(std::size_t i = 0; i < files.size(); i++)
+        hashes[i] = hash(files[i].first);
+
+    std::sort(order.begin(), order.end(),
+              [&](std::size_t a, std::size_t b) { return hashes[a] < hashes[b]; });
+
+    Header header {magic, version, static_cast<std::uint32_t>(files.size()), 0u};
+
+    std::string paths;
+
+    for(auto index : order)
+        paths += files[index].first;
+
+    header.paths_size = static_cast<std::uint32_t>(paths.size());
+
+    std::vector<Entry> entries(files.size());
+
+    auto offset = align(sizeof(Header) + entries.size() * sizeof(Entry) + paths.size());
+    std::uint32_t path_offset = 0u;
+
+    for(std::size_t i = 0; i < order.size(); i++)
+    {
+        const auto& [file_path, content] = files[order[i]];
+
+        entries[i] = {hashes[order[i]], hash(content), offset, content.size(), path_offset,
+                      static_cast<std::uint32_t>(file_path.size())};
+
+        path_offset += static_cast<std::uint32_t>(file_path.size());
+        offset = align(offset + content.size());
+    }
+
+    std::ofstream file(path, std::ios::binary);
+
+    if(!file.is_open())
+        return false;
+
+    file.write(reinterpret_cast<const char*>(&header), sizeof header);
+    file.write(reinterpret_cast<const char*>(entries.data()),
+               static_cast<std::streamsize>(entries.size() * sizeof(Entry)));
+    file.write(paths.data(), static_cast<std::streamsize>(paths.size()));
+
+    const char zeros[alignment] {};
+    auto       position = sizeof(Header) + entries.size() * sizeof(Entry) + paths.size();
+
+    for(std::size_t i = 0; i < order.size(); i++)
+    {
+        const auto& content = files[order[i]].second;
+
+        file.write(zeros, static_cast<std::streamsize>(entries[i].offset - position));
+        file.write(reinterpret_cast<const char*>(content.data()),
+                   static_cast<std::streamsize>(content.size()));
+
+        position = entries[i].offset + content.size();
+    }
+    return file.good();
+}
+}    // namespace corgi::filesystem
@@ -0,0 +1,111 @@
+#include <corgi/filesystem/VirtualFileSystem.h>
+
+#include <algorithm>
+
+namespace corgi::filesystem
+{
+bool VirtualFileSystem::mount(const std::string& path)
+{
+    auto pack = std::make_unique<PackFile>(path);
+
+    if(!pack->is_open())
+        return false;
+
+    for(const auto& entry : pack->entries())
+    {
+        const Location location {pack.get(), &entry};
+        const auto     file_path = pack->path(entry);
+
+        auto [it, inserted] = files_.try_emplace(entry.path_hash, location);
+
+        if(inserted || it->second.pack->path(*it->second.entry) == file_path)
+        {
+            it->second = location;
+            continue;
+        }
+
+        auto collision = std::find_if(collisions_.begin(), collisions_.end(),
+                                      [&](const Location& other)
+                                      { return other.pack->path(*other.entry) == file_path; });
+
+        if(collision != collisions_.end())
+            *collision = location;
+        else
+            collisions_.push_back(location);
+    }
+
+    packs_.push_back(std::move(pack));
+    return true;
+}
+
+void VirtualFileSystem::unmount_all() noexcept
+{
+    files_.clear();
+    collisions_.clear();
+    packs_.clear();
+}
+
+const VirtualFileSystem::Location* VirtualFileSystem::find(std::string_view path) const noexcept
+{
+    if(files_.empty())
+        return nullptr;
+
+    const auto it = files_.find(hash(path));
+
+    if(it == files_.end())
+        return nullptr;
+
+    if(it->second.pack->path(*it->second.entry) == path)
+        return &it->second;
+
+    for(const auto& location : collisions_)
+        if(location.pack->path(*location.entry) == path)
+            return &location;
+
+    return nullptr;
+}
+
+bool VirtualFileSystem::contains(std::string_view path) const noexcept
+{
+    return find(path) != nullptr;
+}
+
+std::span<const std::byte> VirtualFileSystem::read(std::string_view path) const noexcept
+{
+    const auto* location = find(path);
+
+    if(location == nullptr)
+        return {};
+
+    return location->pack->content(*location->entry);
+}
+
+std::uint64_t VirtualFileSystem::content_hash(std::string_view path) const noexcept
+{
+    const auto* location = find(path);
+
+    if(location == nullptr)
+        return 0u;
+
+    return location->entry->content_hash;
+}
+
+std::vector<std::string_view> VirtualFileSystem::paths() const
+{
+    std::vector<std::string_view> result;
+    result.reserve(size());
+
+    for(const auto& [path_hash, location] : files_)
+        result.push_back(location.pack->path(*location.entry));
+
+    for(const auto& location : collisions_)
+        result.push_back(location.pack->path(*location.entry));
+
+    return result;
+}
+
+std::size_t VirtualFileSystem::size() const noexcept
+{
+    return files_.size() + collisions_.size();
+}
+}    // namespace corgi::filesystem
@@ -1,6 +1,10 @@
 #include <corgi/test/test.h>
+#include <corgi/math/Bvh.h>
+#include <corgi/math/Collisions.h>
 #include <corgi/math/Vec2.h>
+#include <cmath>
 #include <random>
+#include <vector>
 
 using namespace corgi;
 
@@ -37,4 +41,86 @@ TEST(MathBenchmark, test_random_vector_generation_normalized)
 		v *= 2.0f;
 		sum += v.x;
 	}
-}
\ No newline at end of file
+}
+
+// A 50k triangles grid, raycasted by 256 rays going downward
+
+struct RaycastBenchmarkData
+{
+	RaycastBenchmarkData()
+	{
+		const int size = 158;
+
+		for (int y = 0; y <= size; y++)
+		{
+			for (int x = 0; x <= size; x++)
+			{
+				vertices.push_back(static_cast<float>(x));
+				vertices.push_back(std::sin(static_cast<float>(x + y) * 0.1f));
+				vertices.push_back(static_cast<float>(y));
+			}
+		}
+
+		for (int y = 0; y < size; y++)
+		{
+			for (int x = 0; x < size; x++)
+			{
+				const unsigned a = y * (size + 1) + x;
+				indexes.insert(indexes.end(), { a, a + 1, a + size + 2, a, a + size + 2, a + size + 1 });
+			}
+		}
+
+		std::uniform_real_distribution<float> position(0.0f, static_cast<float>(size));
+
+		for (int i = 0; i < 256; i++)
+			rays.emplace_back(Vec3(position(mt), 10.0f, position(mt)), Vec3(0.0f, -1.0f, 0.0f), 20.0f);
+
+		bvh.build(vertices.data(), 3, 0, indexes.data(), static_cast<int>(indexes.size()));
+		hits.resize(rays.size());
+	}
+
+	std::vector<float> vertices;
+	std::vector<unsigned> indexes;
+	std::vector<Ray> rays;
+	std::vector<math::RayHit> hits;
+	math::TriangleBvh bvh;
+	Matrix model = Matrix::translation(5.0f, 0.0f, 5.0f);
+};
+
+static RaycastBenchmarkData& raycast_data()
+{
+	static RaycastBenchmarkData data;
+	return data;
+}
+
+TEST(MathBenchmark, raycast_mesh_brute_force)
+{
+	auto& data = raycast_data();
+
+	for (const auto& ray : data.rays)
+	{
+		Vec3 point;
+		Vec3 normal;
+		sum += math::intersect_with_mesh(data.indexes.data(), static_cast<int>(data.indexes.size()),
+			data.vertices.data(), 0, 3, data.model, ray, point, normal);
+	}
+}
+
+TEST(MathBenchmark, raycast_mesh_bvh)
+{
+	auto& data = raycast_data();
+	const auto inverse = data.model.inverse();
+
+	for (const auto& ray : data.rays)
+	{
+		math::RayHit hit;
+		sum += data.bvh.raycast(data.model, inverse, ray, hit);
+	}
+}
+
+TEST(MathBenchmark, raycast_mesh_bvh_batch)
+{
+	auto& data = raycast_data();
+
+	sum += data.bvh.raycast(data.model, data.model.inverse(), data.rays.data(), data.hits.data(), data.rays.size());
+}
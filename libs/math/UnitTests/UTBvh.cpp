@@ -0,0 +1,175 @@
+#include <corgi/math/Bvh.h>
+#include <corgi/math/Collisions.h>
+#include <corgi/test/test.h>
+
+#include <random>
+#include <vector>
+
+using namespace corgi;
+using namespace corgi::test;
+
+class TestBvh : public corgi::test::Test
+{
+public:
+    std::vector<float>    vertices;
+    std::vector<unsigned> indexes;
+
+    std::mt19937 generator {42};
+
+    // Small random triangles scattered inside a cube
+    void set_up() override
+    {
+        std::uniform_real_distribution<float> position(-10.0f, 10.0f);
+        std::uniform_real_distribution<float> offset(-1.0f, 1.0f);
+
+        for(unsigned i = 0; i < 2000; i++)
+        {
+            const float x = position(generator);
+            const float y = position(generator);
+            const float z = position(generator);
+
+            for(int v = 0; v < 3; v++)
+            {
+                vertices.push_back(x + offset(generator));
+                vertices.push_back(y + offset(generator));
+                vertices.push_back(z + offset(generator));
+                indexes.push_back(i * 3 + v);
+            }
+        }
+    }
+
+    Ray random_ray()
+    {
+        std::uniform_real_distribution<float> position(-12.0f, 12.0f);
+
+        const Vec3 start(position(generator), position(generator), position(generator));
+        const Vec3 target(position(generator), position(generator), position(generator));
+
+        return Ray(start, (target - start).normalized(), 30.0f);
+    }
+
+    bool reference(const Matrix& m, const Ray& ray, Vec3& point)
+    {
+        Vec3 normal;
+        return math::intersect_with_mesh(indexes.data(), static_cast<int>(indexes.size()),
+                                         vertices.data(), 0, 3, m, ray, point, normal);
+    }
+};
+
+TEST_F(TestBvh, build)
+{
+    math::TriangleBvh bvh;
+    bvh.build(vertices.data(), 3, 0, indexes.data(), static_cast<int>(indexes.size()));
+
+    assert_that(bvh.empty(), equals(false));
+    assert_that(bvh.triangle_count(), equals(indexes.size() / 3));
+    assert_that(bvh.node_count() > 1, equals(true));
+    assert_that(bvh.bounds_min().x >= -11.0f, equals(true));
+    assert_that(bvh.bounds_max().x <= 11.0f, equals(true));
+}
+
+TEST_F(TestBvh, empty_mesh)
+{
+    math::TriangleBvh bvh;
+    bvh.build(vertices.data(), 3, 0, indexes.data(), 0);
+
+    math::RayHit hit;
+    assert_that(bvh.raycast(Ray(Vec3(0.0f, 0.0f, -5.0f), Vec3(0.0f, 0.0f, 1.0f), 10.0f), hit),
+                equals(false));
+}
+
+TEST_F(TestBvh, local_raycast)
+{
+    std::vector<float>    quad {-1.0f, -1.0f, 0.0f, 1.0f, -1.0f, 0.0f,
+                             1.0f,  1.0f,  0.0f, -1.0f, 1.0f, 0.0f};
+    std::vector<unsigned> quad_indexes {0, 1, 2, 0, 2, 3};
+
+    math::TriangleBvh bvh;
+    bvh.build(quad.data(), 3, 0, quad_indexes.data(), 6);
+
+    math::RayHit hit;
+
+    assert_that(bvh.raycast(Ray(Vec3(-0.5f, 0.5f, -5.0f), Vec3(0.0f, 0.0f, 1.0f), 10.0f), hit),
+                equals(true));
+    assert_that(hit.distance, almost_equals(5.0f, 0.0001f));
+    assert_that(hit.point.x, almost_equals(-0.5f, 0.0001f));
+    assert_that(hit.triangle, equals(1u));
+
+    // Too short
+    assert_that(bvh.raycast(Ray(Vec3(0.5f, 0.5f, -5.0f), Vec3(0.0f, 0.0f, 1.0f), 4.0f), hit),
+                equals(false));
+
+    // Negative length goes backward
+    assert_that(bvh.raycast(Ray(Vec3(0.5f, 0.5f, -5.0f), Vec3(0.0f, 0.0f, -1.0f), -10.0f), hit),
+                equals(true));
+}
+
+TEST_F(TestBvh, same_result_as_intersect_with_mesh)
+{
+    const auto model = Matrix::translation(3.0f, -2.0f, 1.0f) * Matrix::rotation_y(0.7f) *
+                       Matrix::scale(1.5f, 0.5f, 2.0f);
+
+    math::TriangleBvh bvh;
+    bvh.build(vertices.data(), 3, 0, indexes.data(), static_cast<int>(indexes.size()));
+
+    const auto inverse = model.inverse();
+
+    int hits = 0;
+
+    for(int i = 0; i < 500; i++)
+    {
+        const auto ray = random_ray();
+
+        Vec3         expected;
+        math::RayHit hit;
+
+        const bool result = reference(model, ray, expected);
+
+        assert_that(bvh.raycast(model, inverse, ray, hit), equals(result));
+
+        if(result)
+        {
+            hits++;
+            assert_that(hit.point.x, almost_equals(expected.x, 0.001f));
+            assert_that(hit.point.y, almost_equals(expected.y, 0.001f));
+            assert_that(hit.point.z, almost_equals(expected.z, 0.001f));
+        }
+    }
+
+    assert_that(hits > 50, equals(true));
+}
+
+TEST_F(TestBvh, batch_raycast)
+{
+    const auto model   = Matrix::translation(1.0f, 2.0f, 3.0f) * Matrix::rotation_z(1.2f);
+    const auto inverse = model.inverse();
+
+    math::TriangleBvh bvh;
+    bvh.build(vertices.data(), 3, 0, indexes.data(), static_cast<int>(indexes.size()));
+
+    // Not a multiple of the packet size on purpose
+    std::vector<Ray> rays;
+
+    for(int i = 0; i < 301; i++)
+        rays.push_back(random_ray());
+
+    std::vector<math::RayHit> hits(rays.size());
+
+    const int count = bvh.raycast(model, inverse, rays.data(), hits.data(), rays.size());
+
+    int expected_count = 0;
+
+    for(size_t i = 0; i < rays.size(); i++)
+    {
+        math::RayHit expected;
+
+        if(bvh.raycast(model, inverse, rays[i], expected))
+            expected_count++;
+
+        assert_that(hits[i].hit, equals(expected.hit));
+        assert_that(hits[i].triangle, equals(expected.triangle));
+        assert_that(hits[i].distance, almost_equals(expected.distance, 0.0001f));
+    }
+
+    assert_that(count, equals(expected_count));
+}
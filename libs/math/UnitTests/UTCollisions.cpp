@@ -1,6 +1,7 @@
 #include <corgi/math/Collisions.h>
 #include <corgi/math/Vec3.h>
 #include <ostream>
+#include <random>
 #include <vector>
 
 using namespace corgi;
@@ -8,6 +9,7 @@ using namespace corgi;
 #include <corgi/test/test.h>
 
 using namespace std;
+using namespace corgi::test;
 
 class TestTriangle : public corgi::test::Test
 {
@@ -40,4 +42,117 @@ class TestTriangle : public corgi::test::Test
 //	{
 //		math::get_triangle_normal(v1[i], v2[i], v3[i]);
 //	}
-//}
\ No newline at end of file
+//}
+
+// Same box as the one built by BoxCollider2D
+class TestOrientedBox : public corgi::test::Test
+{
+public:
+    std::vector<Vec2> positions {Vec2(-0.5f, -0.5f), Vec2(0.5f, -0.5f), Vec2(-0.5f, 0.5f),
+                                 Vec2(0.5f, 0.5f)};
+    std::vector<Vec2> axes {Vec2(1.0f, 0.0f), Vec2(0.0f, 1.0f)};
+
+    static Matrix without_translation(Matrix m)
+    {
+        m[12] = 0.0f;
+        m[13] = 0.0f;
+        m[14] = 0.0f;
+        return m;
+    }
+
+    // What the CollisionSystem used to do for every pair
+    bool reference(const Matrix& a, const Matrix& b, Vec2& mtv)
+    {
+        return math::intersect_2D(positions.data(), 4, positions.data(), 4, a, b,
+                                  axes.data(), 2, axes.data(), 2, without_translation(a),
+                                  without_translation(b), &mtv);
+    }
+
+    bool oriented(const Matrix& a, const Matrix& b, Vec2& mtv)
+    {
+        math::OrientedBox2D box_a;
+        math::OrientedBox2D box_b;
+        math::transform_box(positions.data(), axes.data(), a, box_a);
+        math::transform_box(positions.data(), axes.data(), b, box_b);
+        return math::intersect_oriented_boxes(box_a, box_b, mtv);
+    }
+};
+
+TEST_F(TestOrientedBox, separated_boxes)
+{
+    Vec2 mtv;
+    assert_that(oriented(Matrix::translation(0.0f, 0.0f, 0.0f),
+                         Matrix::translation(2.0f, 0.0f, 0.0f), mtv),
+                equals(false));
+}
+
+TEST_F(TestOrientedBox, overlapping_boxes_mtv)
+{
+    Vec2 mtv;
+
+    // b is 0.75 to the right of a, so a must be pushed 0.25 to the left
+    assert_that(oriented(Matrix::translation(0.0f, 0.0f, 0.0f),
+                         Matrix::translation(0.75f, 0.1f, 0.0f), mtv),
+                equals(true));
+
+    assert_that(mtv.x, almost_equals(-0.25f, 0.0001f));
+    assert_that(mtv.y, almost_equals(0.0f, 0.0001f));
+}
+
+TEST_F(TestOrientedBox, rotated_boxes)
+{
+    // A box rotated by 45 degrees has its corners further away than
+    // an axis aligned one
+    const auto rotated = Matrix::translation(1.15f, 0.0f, 0.0f) *
+                         Matrix::rotation_z(3.14159265f / 4.0f);
+    Vec2 mtv;
+
+    assert_that(oriented(Matrix::translation(0.0f, 0.0f, 0.0f), rotated, mtv),
+                equals(true));
+    assert_that(reference(Matrix::translation(0.0f, 0.0f, 0.0f), rotated, mtv),
+                equals(true));
+}
+
+TEST_F(TestOrientedBox, same_result_as_intersect_2D)
+{
+    std::mt19937                          generator(1234);
+    std::uniform_real_distribution<float> position(-3.0f, 3.0f);
+    std::uniform_real_distribution<float> angle(0.0f, 6.2831853f);
+    std::uniform_real_distribution<float> scale(0.2f, 3.0f);
+
+    auto random_matrix = [&]()
+    {
+        return Matrix::translation(position(generator), position(generator), 0.0f) *
+               Matrix::rotation_z(angle(generator)) *
+               Matrix::scale(scale(generator), scale(generator), 1.0f);
+    };
+
+    int intersections = 0;
+
+    for(int i = 0; i < 10000; i++)
+    {
+        const auto a = random_matrix();
+        const auto b = random_matrix();
+
+        Vec2 expected_mtv;
+        Vec2 mtv;
+
+        const bool expected = reference(a, b, expected_mtv);
+
+        assert_that(oriented(a, b, mtv), equals(expected));
+
+        if(expected)
+        {
+            intersections++;
+            assert_that(mtv.x, almost_equals(expected_mtv.x, 0.001f));
+            assert_that(mtv.y, almost_equals(expected_mtv.y, 0.001f));
+
+            // Once pushed by the mtv, the boxes should only touch
+            const auto pushed = Matrix::translation(mtv.x * 1.01f, mtv.y * 1.01f, 0.0f) * a;
+            assert_that(oriented(pushed, b, mtv), equals(false));
+        }
+    }
+
+    // Making sure the test actually tested something
+    assert_that(intersections > 100, equals(true));
+}
@@ -0,0 +1,176 @@
+#pragma once
+
+#include <corgi/math/Matrix.h>
+#include <corgi/math/Ray.h>
+#include <corgi/math/Vec3.h>
+
+#include <cstddef>
+#include <vector>
+
+namespace corgi::math
+{
+/*!
+ * @brief   Result of a raycast against a TriangleBvh
+ */
+struct RayHit
+{
+    [[nodiscard]] explicit operator bool() const noexcept { return hit; }
+
+    bool hit {false};
+
+    // Ray parameter of the intersection : the point is start + direction * distance.
+    // Equals the distance to the ray's start when the direction is normalized
+    float distance {0.0f};
+
+    // Index of the triangle inside the mesh, that is the index of its first
+    // vertex index divided by 3
+    unsigned triangle {0};
+
+    Vec3 point;
+    Vec3 normal;
+};
+
+/*!
+ * @brief   Bounding volume hierarchy built over the triangles of a mesh, in
+ *          the mesh's local space
+ *
+ *          The tree is built by binning the triangle centroids and picking
+ *          the split with the lowest surface area heuristic cost. Nodes are
+ *          stored in a flat array, children of a node being next to each
+ *          other, and the triangles are copied in leaf order with their edges
+ *          precomputed so a leaf is tested without touching the mesh again.
+ *
+ *          Rays given in world space are transformed in local space once,
+ *          instead of transforming every vertex of the mesh in world space.
+ *          The local direction isn't normalized so the ray parameter of a hit
+ *          is the same in both spaces.
+ */
+class TriangleBvh
+{
+public:
+    static constexpr int bin_count          = 12;
+    static constexpr int max_leaf_triangles = 4;
+
+    /*!
+     * @brief   How many rays are traversed together by the batch raycast
+     */
+    static constexpr int packet_size = 8;
+
+    // Functions
+
+    /*!
+     * @brief   Builds the tree. We assume the indexes describe GL_TRIANGLES
+     *
+     * @param vertices      Mesh's vertices
+     * @param vertex_size   Size of 1 vertex, not in bytes but in float
+     * @param offset        Offset of the position attribute inside a vertex
+     */
+    void build(const float*    vertices,
+               int             vertex_size,
+               int             offset,
+               const unsigned* indexes,
+               int             indexes_size);
+
+    void clear();
+
+    /*!
+     * @brief   Returns the closest intersection between the tree and a ray
+     *          given in local space
+     */
+    bool raycast(const Ray& ray, RayHit& hit) const;
+
+    /*!
+     * @brief   Returns the closest intersection between the tree and a ray
+     *          given in world space. The hit is returned in world space
+     */
+    bool raycast(const Matrix& model_matrix,
+                 const Matrix& inverse_matrix,
+                 const Ray&    ray,
+                 RayHit&       hit) const;
+
+    /*!
+     * @brief   Casts @a count rays given in world space against the tree
+     *
+     *          Rays are traversed by packets : a node is only fetched once
+     *          for every ray of the packet. Works best when the rays are
+     *          coherent, like rays going from the same point or going in
+     *          the same direction
+     *
+     * @return  How many rays hit the mesh
+     */
+    int raycast(const Matrix& model_matrix,
+                const Matrix& inverse_matrix,
+                const Ray*    rays,
+                RayHit*       hits,
+                std::size_t   count) const;
+
+    [[nodiscard]] bool        empty() const noexcept;
+    [[nodiscard]] std::size_t node_count() const noexcept;
+    [[nodiscard]] std::size_t triangle_count() const noexcept;
+
+    /*!
+     * @brief   Returns the bounds of the whole mesh, in local space
+     */
+    [[nodiscard]] Vec3 bounds_min() const noexcept;
+    [[nodiscard]] Vec3 bounds_max() const noexcept;
+
+private:
+    // 32 bytes so 2 nodes fit inside a cache line
+    struct Node
+    {
+        float min[3];
+
+        // Index of the left child for inner nodes (the right child is
+        // right after), index of the first triangle for leaves
+        unsigned first;
+
+        float max[3];
+
+        // Triangle count. 0 for inner nodes
+        unsigned count;
+    };
+
+    struct Triangle
+    {
+        Vec3 a;
+        Vec3 edge1;
+        Vec3 edge2;
+    };
+
+    // Local space ray, ready to be tested against the nodes
+    struct LocalRay
+    {
+        Vec3  start;
+        Vec3  direction;
+        Vec3  inverse_direction;
+        float max_distance;
+    };
+
+    static LocalRay make_local_ray(const Vec3& start, const Vec3& direction, float length);
+
+    /*!
+     * @brief   Returns the distance at which the ray enters the node, or
+     *          infinity if the ray misses it before @a max_distance
+     */
+    static float node_distance(const Node& node, const LocalRay& ray, float max_distance);
+
+    static bool intersect_triangle(const Triangle& triangle,
+                                   const LocalRay& ray,
+                                   float           max_distance,
+                                   float&          distance);
+
+    void traverse(const LocalRay& ray, RayHit& hit) const;
+    void traverse_packet(const LocalRay* rays, RayHit* hits, int count) const;
+
+    void fill_hit(const LocalRay& ray, RayHit& hit) const;
+    static void to_world(const Matrix& model_matrix, RayHit& hit);
+
+    void subdivide(unsigned node_index, std::vector<Vec3>& centroids, int depth);
+
+    std::vector<Node>     nodes_;
+    std::vector<Triangle> triangles_;
+
+    // Index of every triangle inside the mesh, in leaf order
+    std::vector<unsigned> triangle_indexes_;
+};
+}    // namespace corgi::math
@@ -7,6 +7,48 @@
 
 namespace corgi::math
 {
+/*!
+ * @brief   2D box already transformed in world space, ready to be used by
+ *          the SAT
+ *
+ *          The corners and axes are stored as structures of arrays so the
+ *          4 corners can be projected on the 4 axes of a pair of boxes with
+ *          a handful of SIMD instructions
+ */
+struct OrientedBox2D
+{
+    alignas(16) float corners_x[4];
+    alignas(16) float corners_y[4];
+
+    // Normalized axes of the box, in world space
+    float axes_x[2];
+    float axes_y[2];
+};
+
+/*!
+ * @brief   Transforms the 4 @a positions and the 2 @a axes of a box in
+ *          world space and stores them inside @a box
+ *
+ *          Meant to be done once per frame and per box, instead of once per
+ *          tested pair and per axis
+ */
+void transform_box(const Vec2*   positions,
+                   const Vec2*   axes,
+                   const Matrix& world_matrix,
+                   OrientedBox2D& box);
+
+/*!
+ * @brief   SAT test specialized for 2 oriented boxes
+ *
+ *          Gives the same result as intersect_2D, but projects both boxes on
+ *          the 4 axes at once
+ *
+ * @param   mtv     If the boxes intersect, receives the minimum translation
+ *                  vector, the smallest translation to apply to @a a so it
+ *                  doesn't intersect with @a b anymore
+ */
+bool intersect_oriented_boxes(const OrientedBox2D& a, const OrientedBox2D& b, Vec2& mtv);
+
 // TODO : Maybe really have a Triangle class with static function for this stuff
 // I could at least put that and "point_in_triangle" there
 Vec3 get_triangle_normal(const Vec3& a, const Vec3& b, const Vec3& c);
@@ -57,7 +99,8 @@ bool intersect_2D(const Vec2*   vertices_a,
                   const Vec2*   edges2,
                   unsigned int  edges_2_size,
                   const Matrix& mat1,    // without translation
-                  const Matrix& mat2);
+                  const Matrix& mat2,
+                  Vec2*         mtv = nullptr);
 
 bool intersect_3D(Matrix          model_matrix_a,
                   const unsigned* index1,
@@ -0,0 +1,599 @@
+#include <corgi/math/Bvh.h>
+
+#include <algorithm>
+#include <limits>
+#include <numeric>
+
+namespace corgi::math
+{
+// Deeper nodes are turned into leaves, so the traversal can use a fixed size stack
+static constexpr int max_depth = 64;
+
+static constexpr float infinity = std::numeric_limits<float>::infinity();
+
+static float component(const Vec3& v, int axis)
+{
+    return axis == 0 ? v.x : (axis == 1 ? v.y : v.z);
+}
+
+namespace
+{
+struct Bounds
+{
+    void grow(const Vec3& p)
+    {
+        min[0] = std::min(min[0], p.x);
+        min[1] = std::min(min[1], p.y);
+        min[2] = std::min(min[2], p.z);
+        max[0] = std::max(max[0], p.x);
+        max[1] = std::max(max[1], p.y);
+        max[2] = std::max(max[2], p.z);
+    }
+
+    void grow(const Bounds& b)
+    {
+        for(int i = 0; i < 3; i++)
+        {
+            min[i] = std::min(min[i], b.min[i]);
+            max[i] = std::max(max[i], b.max[i]);
+        }
+    }
+
+    [[nodiscard]] float area() const
+    {
+        const float dx = max[0] - min[0];
+        const float dy = max[1] - min[1];
+        const float dz = max[2] - min[2];
+        return 2.0f * (dx * dy + dy * dz + dz * dx);
+    }
+
+    float min[3] {infinity, infinity, infinity};
+    float max[3] {-infinity, -infinity, -infinity};
+};
+
+struct Bin
+{
+    Bounds   bounds;
+    unsigned count {0};
+};
+}    // namespace
+
+void TriangleBvh::build(const float*    vertices,
+                        int             vertex_size,
+                        int             offset,
+                        const unsigned* indexes,
+                        int             indexes_size)
+{
+    clear();
+
+    const auto count = static_cast<unsigned>(indexes_size / 3);
+
+    if(count == 0)
+        return;
+
+    triangles_.reserve(count);
+
+    std::vector<Vec3> centroids;
+    centroids.reserve(count);
+
+    for(unsigned i = 0; i < count; i++)
+    {
+        const Vec3 a(&vertices[indexes[i * 3] * vertex_size + offset]);
+        const Vec3 b(&vertices[indexes[i * 3 + 1] * vertex_size + offset]);
+        const Vec3 c(&vertices[indexes[i * 3 + 2] * vertex_size + offset]);
+
+        triangles_.push_back({a, b - a, c - a});
+        centroids.push_back((a + b + c) / 3.0f);
+    }
+
+    triangle_indexes_.resize(count);
+    std::iota(triangle_indexes_.begin(), triangle_indexes_.end(), 0u);
+
+    // A binary tree with at least 1 triangle per leaf can't have more nodes
+    nodes_.reserve(2 * count - 1);
+    nodes_.push_back({{}, 0, {}, count});
+
+    subdivide(0, centroids, 0);
+
+    // Triangles are stored in leaf order so the leaves read them contiguously
+    std::vector<Triangle> sorted;
+    sorted.reserve(count);
+
+    for(auto index : triangle_indexes_)
+        sorted.push_back(triangles_[index]);
+
+    triangles_ = std::move(sorted);
+}
+
+void TriangleBvh::subdivide(unsigned node_index, std::vector<Vec3>& centroids, int depth)
+{
+    const unsigned first = nodes_[node_index].first;
+    const unsigned count = nodes_[node_index].count;
+
+    Bounds bounds;
+    Bounds centroid_bounds;
+
+    for(unsigned i = first; i < first + count; i++)
+    {
+        const auto& triangle = triangles_[triangle_indexes_[i]];
+        bounds.grow(triangle.a);
+        bounds.grow(triangle.a + triangle.edge1);
+        bounds.grow(triangle.a + triangle.edge2);
+        centroid_bounds.grow(centroids[triangle_indexes_[i]]);
+    }
+
+    auto& node = nodes_[node_index];
+    std::copy(std::begin(bounds.min), std::end(bounds.min), node.min);
+    std::copy(std::begin(bounds.max), std::end(bounds.max), node.max);
+
+    if(count <= max_leaf_triangles || depth >= max_depth)
+        return;
+
+    // We bin the centroids along every axis and evaluate the SAH cost of a
+    // split between every consecutive bins
+
+    float best_cost  = infinity;
+    int   best_axis  = -1;
+    int   best_split = 0;
+
+    for(int axis = 0; axis < 3; axis++)
+    {
+        const float extent = centroid_bounds.max[axis] - centroid_bounds.min[axis];
+
+        if(extent <= 0.0f)
+            continue;
+
+        const float scale = static_cast<float>(bin_count) / extent;
+
+        Bin bins[bin_count];
+
+        for(unsigned i = first; i < first + count; i++)
+        {
+            const auto& triangle = triangles_[triangle_indexes_[i]];
+            const auto  bin      = std::min(
+                bin_count - 1,
+                static_cast<int>(
+                    (component(centroids[triangle_indexes_[i]], axis) - centroid_bounds.min[axis]) *
+                    scale));
+
+            bins[bin].count++;
+            bins[bin].bounds.grow(triangle.a);
+            bins[bin].bounds.grow(triangle.a + triangle.edge1);
+            bins[bin].bounds.grow(triangle.a + triangle.edge2);
+        }
+
+        // left_cost[i] is the cost of the bins before the split i + 1
+        float  left_cost[bin_count - 1];
+        Bounds left_bounds;
+        unsigned left_count = 0;
+
+        for(int i = 0; i < bin_count - 1; i++)
+        {
+            left_count += bins[i].count;
+            left_bounds.grow(bins[i].bounds);
+            left_cost[i] = left_count != 0 ? left_bounds.area() * static_cast<float>(left_count) : 0.0f;
+        }
+
+        Bounds   right_bounds;
+        unsigned right_count = 0;
+
+        for(int i = bin_count - 1; i > 0; i--)
+        {
+            right_count += bins[i].count;
+            right_bounds.grow(bins[i].bounds);
+
+            const float right_cost =
+                right_count != 0 ? right_bounds.area() * static_cast<float>(right_count) : 0.0f;
+
+            const float cost = left_cost[i - 1] + right_cost;
+
+            if(cost < best_cost)
+            {
+                best_cost  = cost;
+                best_axis  = axis;
+                best_split = i;
+            }
+        }
+    }
+
+    // Every centroid is at the same position, we can't split them
+    if(best_axis == -1)
+        return;
+
+    // Splitting costs more than testing every triangle. We still split if
+    // the leaf would be too big, as a bad tree is better than no tree
+    if(best_cost >= bounds.area() * static_cast<float>(count) &&
+       count <= 4 * max_leaf_triangles)
+        return;
+
+    const float scale =
+        static_cast<float>(bin_count) /
+        (centroid_bounds.max[best_axis] - centroid_bounds.min[best_axis]);
+
+    // Must compute the bins exactly like above so the partition matches the
+    // evaluated split
+    auto* middle = std::partition(
+        triangle_indexes_.data() + first, triangle_indexes_.data() + first + count,
+        [&](unsigned index)
+        {
+            const auto bin = std::min(
+                bin_count - 1,
+                static_cast<int>(
+                    (component(centroids[index], best_axis) - centroid_bounds.min[best_axis]) *
+                    scale));
+            return bin < best_split;
+        });
+
+    const auto left_count = static_cast<unsigned>(middle - (triangle_indexes_.data() + first));
+
+    if(left_count == 0 || left_count == count)
+        return;
+
+    const auto left = static_cast<unsigned>(nodes_.size());
+
+    nodes_.push_back({{}, first, {}, left_count});
+    nodes_.push_back({{}, first + left_count, {}, count - left_count});
+
+    nodes_[node_index].first = left;
+    nodes_[node_index].count = 0;
+
+    subdivide(left, centroids, depth + 1);
+    subdivide(left + 1, centroids, depth + 1);
+}
+
+void TriangleBvh::clear()
+{
+    nodes_.clear();
+    triangles_.clear();
+    triangle_indexes_.clear();
+}
+
+bool TriangleBvh::empty() const noexcept
+{
+    return nodes_.empty();
+}
+
+std::size_t TriangleBvh::node_count() const noexcept
+{
+    return nodes_.size();
+}
+
+std::size_t TriangleBvh::triangle_count() const noexcept
+{
+    return triangles_.size();
+}
+
+Vec3 TriangleBvh::bounds_min() const noexcept
+{
+    if(nodes_.empty())
+        return Vec3();
+    return Vec3(nodes_[0].min);
+}
+
+Vec3 TriangleBvh::bounds_max() const noexcept
+{
+    if(nodes_.empty())
+        return Vec3();
+    return Vec3(nodes_[0].max);
+}
+
+TriangleBvh::LocalRay
+TriangleBvh::make_local_ray(const Vec3& start, const Vec3& direction, float length)
+{
+    LocalRay ray;
+    ray.start        = start;
+    ray.direction    = direction;
+    ray.max_distance = length;
+
+    // Rays can have a negative length, in which case they go backward
+    if(length < 0.0f)
+    {
+        ray.direction    = -direction;
+        ray.max_distance = -length;
+    }
+
+    ray.inverse_direction = Vec3(ray.direction.x != 0.0f ? 1.0f / ray.direction.x : infinity,
+                                 ray.direction.y != 0.0f ? 1.0f / ray.direction.y : infinity,
+                                 ray.direction.z != 0.0f ? 1.0f / ray.direction.z : infinity);
+    return ray;
+}
+
+float TriangleBvh::node_distance(const Node& node, const LocalRay& ray, float max_distance)
+{
+    // Slab test
+    const float tx1 = (node.min[0] - ray.start.x) * ray.inverse_direction.x;
+    const float tx2 = (node.max[0] - ray.start.x) * ray.inverse_direction.x;
+    float       near = std::min(tx1, tx2);
+    float       far  = std::max(tx1, tx2);
+
+    const float ty1 = (node.min[1] - ray.start.y) * ray.inverse_direction.y;
+    const float ty2 = (node.max[1] - ray.start.y) * ray.inverse_direction.y;
+    near            = std::max(near, std::min(ty1, ty2));
+    far             = std::min(far, std::max(ty1, ty2));
+
+    const float tz1 = (node.min[2] - ray.start.z) * ray.inverse_direction.z;
+    const float tz2 = (node.max[2] - ray.start.z) * ray.inverse_direction.z;
+    near            = std::max(near, std::min(tz1, tz2));
+    far             = std::min(far, std::max(tz1, tz2));
+
+    if(far < near || far <= 0.0f || near >= max_distance)
+        return infinity;
+
+    return near;
+}
+
+bool TriangleBvh::intersect_triangle(const Triangle& triangle,
+                                     const LocalRay& ray,
+                                     float           max_distance,
+                                     float&          distance)
+{
+    // Möller–Trumbore
+    const Vec3  p           = ray.direction.cross(triangle.edge2);
+    const float determinant = triangle.edge1.dot(p);
+
+    // The ray is parallel to the triangle
+    if(determinant == 0.0f)
+        return false;
+
+    const float inverse = 1.0f / determinant;
+    const Vec3  s       = ray.start - triangle.a;
+    const float u       = s.dot(p) * inverse;
+
+    if(u < 0.0f || u > 1.0f)
+        return false;
+
+    const Vec3  q = s.cross(triangle.edge1);
+    const float v = ray.direction.dot(q) * inverse;
+
+    if(v < 0.0f || u + v > 1.0f)
+        return false;
+
+    const float t = triangle.edge2.dot(q) * inverse;
+
+    // Same bounds as intersect_with_collider, the ray's start and end
+    // are excluded
+    if(t <= 0.0f || t >= max_distance)
+        return false;
+
+    distance = t;
+    return true;
+}
+
+void TriangleBvh::traverse(const LocalRay& ray, RayHit& hit) const
+{
+    unsigned stack[max_depth + 1];
+    int      size = 0;
+
+    float closest = ray.max_distance;
+
+    if(node_distance(nodes_[0], ray, closest) == infinity)
+        return;
+
+    stack[size++] = 0;
+
+    while(size > 0)
+    {
+        const auto& node = nodes_[stack[--size]];
+
+        if(node.count != 0)
+        {
+            for(unsigned i = node.first; i < node.first + node.count; i++)
+            {
+                float distance;
+
+                if(intersect_triangle(triangles_[i], ray, closest, distance))
+                {
+                    closest      = distance;
+                    hit.hit      = true;
+                    hit.distance = distance;
+                    hit.triangle = i;
+                }
+            }
+            continue;
+        }
+
+        // Visiting the closest child first makes the other one more likely
+        // to be culled by the early out
+        const float left  = node_distance(nodes_[node.first], ray, closest);
+        const float right = node_distance(nodes_[node.first + 1], ray, closest);
+
+        if(left <= right)
+        {
+            if(right != infinity)
+                stack[size++] = node.first + 1;
+            if(left != infinity)
+                stack[size++] = node.first;
+        }
+        else
+        {
+            if(left != infinity)
+                stack[size++] = node.first;
+            stack[size++] = node.first + 1;
+        }
+    }
+}
+
+void TriangleBvh::traverse_packet(const LocalRay* rays, RayHit* hits, int count) const
+{
+    struct Entry
+    {
+        unsigned node;
+
+        // Rays of the packet that reached the node
+        unsigned mask;
+    };
+
+    Entry stack[max_depth + 1];
+    int   size = 0;
+
+    float closest[packet_size];
+
+    for(int r = 0; r < count; r++)
+        closest[r] = rays[r].max_distance;
+
+    stack[size++] = {0, (1u << count) - 1u};
+
+    while(size > 0)
+    {
+        const auto entry = stack[--size];
+        const auto& node = nodes_[entry.node];
+
+        // Rays could have found a closer hit since the node was pushed
+        unsigned mask = 0;
+
+        for(int r = 0; r < count; r++)
+            if((entry.mask & (1u << r)) != 0 &&
+               node_distance(node, rays[r], closest[r]) != infinity)
+                mask |= 1u << r;
+
+        if(mask == 0)
+            continue;
+
+        if(node.count != 0)
+        {
+            for(unsigned i = node.first; i < node.first + node.count; i++)
+            {
+                for(int r = 0; r < count; r++)
+                {
+                    float distance;
+
+                    if((mask & (1u << r)) != 0 &&
+                       intersect_triangle(triangles_[i], rays[r], closest[r], distance))
+                    {
+                        closest[r]       = distance;
+                        hits[r].hit      = true;
+                        hits[r].distance = distance;
+                        hits[r].triangle = i;
+                    }
+                }
+            }
+            continue;
+        }
+
+        // The first ray of the packet decides which child is visited first
+        int first_ray = 0;
+        while((mask & (1u << first_ray)) == 0)
+            first_ray++;
+
+        const float left =
+            node_distance(nodes_[node.first], rays[first_ray], closest[first_ray]);
+        const float right =
+            node_distance(nodes_[node.first + 1], rays[first_ray], closest[first_ray]);
+
+        if(left <= right)
+        {
+            stack[size++] = {node.first + 1, mask};
+            stack[size++] = {node.first, mask};
+        }
+        else
+        {
+            stack[size++] = {node.first, mask};
+            stack[size++] = {node.first + 1, mask};
+        }
+    }
+}
+
+void TriangleBvh::fill_hit(const LocalRay& ray, RayHit& hit) const
+{
+    const auto& triangle = triangles_[hit.triangle];
+
+    hit.point    = ray.start + ray.direction * hit.distance;
+    hit.normal   = triangle.edge1.cross(triangle.edge2).normalized();
+    hit.triangle = triangle_indexes_[hit.triangle];
+}
+
+void TriangleBvh::to_world(const Matrix& model_matrix, RayHit& hit)
+{
+    hit.point  = model_matrix * hit.point;
+    hit.normal = model_matrix * hit.normal - model_matrix * Vec3::zero();
+}
+
+bool TriangleBvh::raycast(const Ray& ray, RayHit& hit) const
+{
+    hit = RayHit();
+
+    if(nodes_.empty())
+        return false;
+
+    const auto local_ray = make_local_ray(ray.start, ray.direction, ray.length);
+
+    traverse(local_ray, hit);
+
+    if(hit.hit)
+        fill_hit(local_ray, hit);
+
+    return hit.hit;
+}
+
+bool TriangleBvh::raycast(const Matrix& model_matrix,
+                          const Matrix& inverse_matrix,
+                          const Ray&    ray,
+                          RayHit&       hit) const
+{
+    hit = RayHit();
+
+    if(nodes_.empty())
+        return false;
+
+    // Transforming the ray once is way cheaper than transforming every
+    // vertex of the mesh
+    const auto local_ray = make_local_ray(
+        inverse_matrix * ray.start,
+        inverse_matrix * ray.direction - inverse_matrix * Vec3::zero(), ray.length);
+
+    traverse(local_ray, hit);
+
+    if(!hit.hit)
+        return false;
+
+    fill_hit(local_ray, hit);
+    to_world(model_matrix, hit);
+    return true;
+}
+
+int TriangleBvh::raycast(const Matrix& model_matrix,
+                         const Matrix& inverse_matrix,
+                         const Ray*    rays,
+                         RayHit*       hits,
+                         std::size_t   count) const
+{
+    int hit_count = 0;
+
+    for(std::size_t i = 0; i < count; i++)
+        hits[i] = RayHit();
+
+    if(nodes_.empty())
+        return 0;
+
+    const Vec3 origin = inverse_matrix * Vec3::zero();
+
+    LocalRay local_rays[packet_size];
+
+    for(std::size_t packet = 0; packet < count; packet += packet_size)
+    {
+        const int size = static_cast<int>(std::min<std::size_t>(packet_size, count - packet));
+
+        for(int r = 0; r < size; r++)
+        {
+            const auto& ray = rays[packet + r];
+            local_rays[r]   = make_local_ray(inverse_matrix * ray.start,
+                                             inverse_matrix * ray.direction - origin, ray.length);
+        }
+
+        traverse_packet(local_rays, hits + packet, size);
+
+        for(int r = 0; r < size; r++)
+        {
+            auto& hit = hits[packet + r];
+
+            if(!hit.hit)
+                continue;
+
+            fill_hit(local_rays[r], hit);
+            to_world(model_matrix, hit);
+            hit_count++;
+        }
+    }
+    return hit_count;
+}
+}    // namespace corgi::math
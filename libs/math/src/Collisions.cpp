@@ -4,6 +4,11 @@
 #include <limits>
 #include <vector>
 
+#if defined(__SSE__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 1)
+    #define CORGI_MATH_SSE
+    #include <xmmintrin.h>
+#endif
+
 namespace corgi::math
 {
 static void extract_position_attribute(std::vector<Vec3>& positions,
@@ -155,88 +160,185 @@ bool intersect_2D(const Vec2*   vertices_a,
                   const Vec2*   edges2,
                   unsigned int  edges_2_size,
                   const Matrix& mat1,    // without translation
-                  const Matrix& mat2)
+                  const Matrix& mat2,
+                  Vec2*         mtv)
 {
-    Vec2 shape1projections;
-    Vec2 shape2projections;
-
-    float smallestmagnitude = std::numeric_limits<float>::max();
-
-    for(auto i = 0u; i < edges_1_size; i++)
+    float smallest_overlap = std::numeric_limits<float>::max();
+    Vec2  smallest_axis;
+    bool  push_backward = false;
+
+    // The project point doesn't really returns the projected point, but
+    // directly a min/max value from the edge perspective?
+    //
+    //
+    //  Shape 1                Shape 2
+    //
+    //		*
+    //      |   *
+    //   *  |   |                *
+    //   |  |   |           *          *
+    //   |  |   |				^Working on this edge
+    //   *--*---*
+    //  min    max
+    //
+    auto test_axis = [&](const Vec2& e) -> bool
     {
-        const auto& edge = edges1[i];
-
-        // The project point doesn't really returns the projected point, but
-        // directly a min/max value from the edge perspective?
-        //
-        //
-        //  Shape 1                Shape 2
-        //
-        //		*
-        //      |   *
-        //   *  |   |                *
-        //   |  |   |           *          *
-        //   |  |   |				^Working on this edge
-        //   *--*---*
-        //  min    max
-        //
-
-        const auto e = (mat1 * edge).normalized();
-
-        shape1projections = (project_points(vertices_a, vertices_a_size, m1, e));
-        shape2projections = (project_points(vertices_b, vertices_b_size, m2, e));
+        const auto shape1projections = project_points(vertices_a, vertices_a_size, m1, e);
+        const auto shape2projections = project_points(vertices_b, vertices_b_size, m2, e);
 
         if(!Overlap(shape1projections.x, shape1projections.y, shape2projections.x,
                     shape2projections.y))
             return false;
 
-        const float overlapvalue = GetOverlap(shape1projections.x, shape1projections.y,
-                                              shape2projections.x, shape2projections.y);
+        // Shape 1 can get out either by going backward or forward along
+        // the axis, even when one interval contains the other
+        const float backward = shape1projections.y - shape2projections.x;
+        const float forward  = shape2projections.y - shape1projections.x;
+        const float overlap  = std::min(backward, forward);
 
-        if(overlapvalue < smallestmagnitude)
+        if(overlap < smallest_overlap)
         {
-            smallestmagnitude = overlapvalue;
-            //smallestaxis		= edge;
+            smallest_overlap = overlap;
+            smallest_axis    = e;
+            push_backward    = backward < forward;
         }
-    }
+        return true;
+    };
+
+    for(auto i = 0u; i < edges_1_size; i++)
+        if(!test_axis((mat1 * edges1[i]).normalized()))
+            return false;
 
     for(auto i = 0u; i < edges_2_size; i++)
+        if(!test_axis((mat2 * edges2[i]).normalized()))
+            return false;
+
+    if(mtv != nullptr)
+        *mtv = smallest_axis * (push_backward ? -smallest_overlap : smallest_overlap);
+
+    return true;
+}
+
+void transform_box(const Vec2*    positions,
+                   const Vec2*    axes,
+                   const Matrix&  world_matrix,
+                   OrientedBox2D& box)
+{
+    for(int i = 0; i < 4; i++)
     {
-        const auto& edge = edges2[i];
-
-        // The project point doesn't really returns the projected point, but
-        // directly a min/max value from the edge perspective?
-        //
-        //
-        //  Shape 1                Shape 2
-        //
-        //		*
-        //      |   *
-        //   *  |   |                *
-        //   |  |   |           *          *
-        //   |  |   |				^Working on this edge
-        //   *--*---*
-        //  min    max
-        //
-
-        const auto e = (mat2 * edge).normalized();
-
-        shape1projections = (project_points(vertices_a, vertices_a_size, m1, e));
-        shape2projections = (project_points(vertices_b, vertices_b_size, m2, e));
+        const auto corner = world_matrix * positions[i];
+        box.corners_x[i]  = corner.x;
+        box.corners_y[i]  = corner.y;
+    }
 
-        if(!Overlap(shape1projections.x, shape1projections.y, shape2projections.x,
-                    shape2projections.y))
+    // Same as multiplying by the matrix without its translation
+    for(int i = 0; i < 2; i++)
+    {
+        const auto axis = Vec2(world_matrix[0] * axes[i].x + world_matrix[4] * axes[i].y,
+                               world_matrix[1] * axes[i].x + world_matrix[5] * axes[i].y)
+                              .normalized();
+        box.axes_x[i] = axis.x;
+        box.axes_y[i] = axis.y;
+    }
+}
+
+bool intersect_oriented_boxes(const OrientedBox2D& a, const OrientedBox2D& b, Vec2& mtv)
+{
+    // Every lane works on one of the 4 axes : the 2 axes of a, then the 2 axes of b
+    alignas(16) const float axes_x[4] = {a.axes_x[0], a.axes_x[1], b.axes_x[0], b.axes_x[1]};
+    alignas(16) const float axes_y[4] = {a.axes_y[0], a.axes_y[1], b.axes_y[0], b.axes_y[1]};
+
+    alignas(16) float backward[4];
+    alignas(16) float forward[4];
+
+#if defined(CORGI_MATH_SSE)
+    const __m128 ax = _mm_load_ps(axes_x);
+    const __m128 ay = _mm_load_ps(axes_y);
+
+    // Projects the 4 corners of a box on the 4 axes and keeps the min/max
+    // per axis. Broadcasting the corners instead of the axes means we never
+    // need any horizontal operation
+    auto project = [&](const OrientedBox2D& box, __m128& mi, __m128& ma)
+    {
+        mi = _mm_add_ps(_mm_mul_ps(_mm_set1_ps(box.corners_x[0]), ax),
+                        _mm_mul_ps(_mm_set1_ps(box.corners_y[0]), ay));
+        ma = mi;
+
+        for(int i = 1; i < 4; i++)
+        {
+            const __m128 d = _mm_add_ps(_mm_mul_ps(_mm_set1_ps(box.corners_x[i]), ax),
+                                        _mm_mul_ps(_mm_set1_ps(box.corners_y[i]), ay));
+            mi             = _mm_min_ps(mi, d);
+            ma             = _mm_max_ps(ma, d);
+        }
+    };
+
+    __m128 mia, maa, mib, mab;
+    project(a, mia, maa);
+    project(b, mib, mab);
+
+    // Separated on at least one axis
+    const __m128 separated = _mm_or_ps(_mm_cmplt_ps(maa, mib), _mm_cmplt_ps(mab, mia));
+
+    if(_mm_movemask_ps(separated) != 0)
+        return false;
+
+    // How far a must go backward or forward along each axis to get out of b
+    _mm_store_ps(backward, _mm_sub_ps(maa, mib));
+    _mm_store_ps(forward, _mm_sub_ps(mab, mia));
+#else
+    float min_a[4];
+    float max_a[4];
+    float min_b[4];
+    float max_b[4];
+
+    auto project = [&](const OrientedBox2D& box, float* mi, float* ma)
+    {
+        for(int axis = 0; axis < 4; axis++)
+        {
+            mi[axis] = box.corners_x[0] * axes_x[axis] + box.corners_y[0] * axes_y[axis];
+            ma[axis] = mi[axis];
+
+            for(int i = 1; i < 4; i++)
+            {
+                const float d = box.corners_x[i] * axes_x[axis] + box.corners_y[i] * axes_y[axis];
+                mi[axis]      = std::min(mi[axis], d);
+                ma[axis]      = std::max(ma[axis], d);
+            }
+        }
+    };
+
+    project(a, min_a, max_a);
+    project(b, min_b, max_b);
+
+    for(int axis = 0; axis < 4; axis++)
+    {
+        if(max_a[axis] < min_b[axis] || max_b[axis] < min_a[axis])
             return false;
 
-        const float overlapvalue = GetOverlap(shape1projections.x, shape1projections.y,
-                                              shape2projections.x, shape2projections.y);
+        backward[axis] = max_a[axis] - min_b[axis];
+        forward[axis]  = max_b[axis] - min_a[axis];
+    }
+#endif
 
-        if(overlapvalue < smallestmagnitude)
+    int   smallest         = 0;
+    float smallest_overlap = std::numeric_limits<float>::max();
+    float overlap          = 0.0f;
+
+    // Same order and comparisons as intersect_2D so both pick the same axis
+    for(int axis = 0; axis < 4; axis++)
+    {
+        const float o = std::min(backward[axis], forward[axis]);
+
+        if(o < smallest_overlap)
         {
-            smallestmagnitude = overlapvalue;
-            //smallestaxis		= edge;
+            smallest_overlap = o;
+            smallest         = axis;
+            overlap          = backward[axis] < forward[axis] ? -o : o;
         }
     }
+
+    mtv = Vec2(axes_x[smallest] * overlap, axes_y[smallest] * overlap);
     return true;
 }
 
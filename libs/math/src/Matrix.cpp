@@ -326,7 +326,7 @@ namespace corgi {
 						  get_value(0, 3) * Inverse.get_value(3,0)
 						  );
 
-			return Inverse * (1.0f / (Dot0.x + Dot0.y) + (Dot0.z + Dot0.w));
+			return Inverse * (1.0f / ((Dot0.x + Dot0.y) + (Dot0.z + Dot0.w)));
 
 
 
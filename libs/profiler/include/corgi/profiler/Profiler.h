@@ -0,0 +1,161 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/*
+ * Instrumentation macros. They expand to nothing unless CORGI_PROFILER_ENABLED
+ * is defined (see the CORGI_PROFILER cmake option), so zones can be left in
+ * hot code
+ *
+ *  CORGI_PROFILE_ZONE("Name")  Records the time spent until the end of the scope
+ *  CORGI_PROFILE_FUNCTION()    Same, named after the current function
+ *  CORGI_PROFILE_FRAME()       Closes the current frame, see profiler::end_frame
+ */
+#ifdef CORGI_PROFILER_ENABLED
+
+#define CORGI_PROFILE_CONCAT_IMPL(a, b) a##b
+#define CORGI_PROFILE_CONCAT(a, b)      CORGI_PROFILE_CONCAT_IMPL(a, b)
+
+#define CORGI_PROFILE_ZONE(name)                                                         \
+    const ::corgi::profiler::ScopedZone CORGI_PROFILE_CONCAT(corgi_profile_zone_,        \
+                                                             __LINE__)(name)
+#define CORGI_PROFILE_FUNCTION() CORGI_PROFILE_ZONE(__func__)
+#define CORGI_PROFILE_FRAME()    ::corgi::profiler::end_frame()
+
+#else
+
+#define CORGI_PROFILE_ZONE(name) static_cast<void>(0)
+#define CORGI_PROFILE_FUNCTION() static_cast<void>(0)
+#define CORGI_PROFILE_FRAME()    static_cast<void>(0)
+
+#endif
+
+namespace corgi::profiler
+{
+/*!
+ * @brief   Time spent inside a zone, in nanoseconds since the profiler's epoch
+ */
+struct ZoneEvent
+{
+    // Must outlive the profiler : string literals, __func__ or type names
+    const char* name {nullptr};
+
+    std::int64_t start {0};
+    std::int64_t end {0};
+
+    // Index of the thread that recorded the zone, see thread_name()
+    std::uint32_t thread {0};
+
+    // How many zones were opened on the thread when this one started
+    std::uint32_t depth {0};
+};
+
+struct Frame
+{
+    std::uint64_t index {0};
+
+    std::int64_t start {0};
+    std::int64_t end {0};
+
+    // Zones that ended during the frame, grouped by thread
+    std::vector<ZoneEvent> zones;
+
+    // Zones lost because a thread's buffer was full before end_frame
+    std::size_t dropped {0};
+
+    [[nodiscard]] double duration_ms() const noexcept
+    {
+        return static_cast<double>(end - start) / 1'000'000.0;
+    }
+};
+
+/*!
+ * @brief   Records the time spent between its construction and destruction
+ *
+ *          Zones are written inside a buffer owned by the current thread
+ *          without any lock. They are only gathered by end_frame
+ */
+class ScopedZone
+{
+public:
+    explicit ScopedZone(const char* name) noexcept;
+    ~ScopedZone();
+
+    ScopedZone(const ScopedZone&)            = delete;
+    ScopedZone& operator=(const ScopedZone&) = delete;
+
+private:
+    const char*  name_;
+    std::int64_t start_;
+};
+
+/*!
+ * @brief   Returns the time elapsed since the profiler's epoch, in nanoseconds
+ */
+[[nodiscard]] std::int64_t now() noexcept;
+
+/*!
+ * @brief   Names the current thread in the exported traces
+ */
+void set_thread_name(const std::string& name);
+
+[[nodiscard]] std::string thread_name(std::uint32_t thread);
+
+/*!
+ * @brief   Gathers the zones recorded by every thread since the last call
+ *          into a new frame of the history, and starts the next frame
+ *
+ *          Must be called by a single thread, usually once per game loop
+ */
+void end_frame();
+
+/*!
+ * @brief   Returns how many threads currently own a zone buffer
+ *
+ *          The buffer of a thread that exited is freed by the next
+ *          end_frame, once its zones are gathered
+ */
+[[nodiscard]] std::size_t thread_buffer_count();
+
+/*!
+ * @brief   Sets how many frames the history keeps. Older frames are
+ *          overwritten. Clears the history
+ */
+void set_history_size(std::size_t size);
+
+[[nodiscard]] std::size_t history_size() noexcept;
+
+/*!
+ * @brief   Returns how many frames are currently stored in the history
+ */
+[[nodiscard]] std::size_t frame_count() noexcept;
+
+/*!
+ * @brief   Returns a frame of the history, 0 being the last ended frame.
+ *          Returns nullptr if @a age is greater or equal to frame_count()
+ */
+[[nodiscard]] const Frame* frame(std::size_t age) noexcept;
+
+/*!
+ * @brief   Returns the longest frame of the history, nullptr if empty
+ */
+[[nodiscard]] const Frame* slowest_frame() noexcept;
+
+void clear_history();
+
+/*!
+ * @brief   Returns the frame history using the Chrome trace event format,
+ *          that can be opened with chrome://tracing or ui.perfetto.dev
+ */
+[[nodiscard]] std::string chrome_trace();
+
+/*!
+ * @brief   Writes chrome_trace() inside the file located at @a path
+ *
+ * @return  Returns false if the file couldn't be written
+ */
+bool export_chrome_trace(const std::string& path);
+}    // namespace corgi::profiler
@@ -0,0 +1,330 @@
+#include <corgi/profiler/Profiler.h>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <fstream>
+#include <memory>
+#include <mutex>
+
+namespace corgi::profiler
+{
+namespace
+{
+/*!
+ * @brief   Zones recorded by a thread
+ *
+ *          Single producer, single consumer ring : only the owning thread
+ *          writes zones, and only end_frame reads them, so the positions are
+ *          the only thing that needs to be synchronized
+ */
+struct ThreadBuffer
+{
+    static constexpr std::size_t capacity = 1u << 15;
+
+    std::unique_ptr<ZoneEvent[]> events {new ZoneEvent[capacity]};
+
+    std::atomic<std::uint64_t> written {0};
+    std::atomic<std::uint64_t> read {0};
+    std::atomic<std::size_t>   dropped {0};
+
+    // Set once the owning thread exited, it won't record zones anymore
+    std::atomic<bool> retired {false};
+
+    std::uint32_t index {0};
+
+    // Only used by the owning thread
+    std::uint32_t depth {0};
+};
+
+const auto epoch = std::chrono::steady_clock::now();
+
+// Threads only lock this when they record their first zone, or when they
+// are named
+std::mutex                                 registry_mutex;
+std::vector<std::shared_ptr<ThreadBuffer>> registry;
+std::vector<std::string>                   thread_names;
+
+std::vector<Frame> history(300);
+std::size_t        history_head {0};    // Where the next frame is written
+std::size_t        history_count {0};
+std::uint64_t      frame_index {0};
+std::int64_t       frame_start {0};
+
+/*!
+ * @brief   Retires the buffer of a thread when the thread exits
+ */
+struct ThreadBufferOwner
+{
+    ThreadBufferOwner()
+        : buffer(std::make_shared<ThreadBuffer>())
+    {
+        const std::lock_guard lock(registry_mutex);
+
+        buffer->index = static_cast<std::uint32_t>(thread_names.size());
+        thread_names.push_back("Thread " + std::to_string(buffer->index));
+        registry.push_back(buffer);
+    }
+
+    ~ThreadBufferOwner() { buffer->retired.store(true, std::memory_order_release); }
+
+    ThreadBufferOwner(const ThreadBufferOwner&)            = delete;
+    ThreadBufferOwner& operator=(const ThreadBufferOwner&) = delete;
+
+    std::shared_ptr<ThreadBuffer> buffer;
+};
+
+ThreadBuffer& thread_buffer()
+{
+    // The registry also owns the buffer, so the zones of a thread that
+    // already exited can still be gathered. end_frame frees it afterward
+    thread_local ThreadBufferOwner owner;
+
+    return *owner.buffer;
+}
+
+void append_escaped(std::string& out, const char* text)
+{
+    for(; *text != '\0'; ++text)
+    {
+        const char c = *text;
+
+        if(c == '"' || c == '\\')
+        {
+            out += '\\';
+            out += c;
+        }
+        else if(static_cast<unsigned char>(c) < 0x20)
+            out += ' ';
+        else
+            out += c;
+    }
+}
+
+void append_microseconds(std::string& out, std::int64_t nanoseconds)
+{
+    char buffer[32];
+    std::snprintf(buffer, sizeof buffer, "%.3f", static_cast<double>(nanoseconds) / 1000.0);
+    out += buffer;
+}
+}    // namespace
+
+ScopedZone::ScopedZone(const char* name) noexcept
+    : name_(name)
+    , start_(now())
+{
+    thread_buffer().depth++;
+}
+
+ScopedZone::~ScopedZone()
+{
+    const auto end = now();
+
+    auto& buffer = thread_buffer();
+    buffer.depth--;
+
+    const auto written = buffer.written.load(std::memory_order_relaxed);
+
+    // We never overwrite zones end_frame didn't gather yet
+    if(written - buffer.read.load(std::memory_order_acquire) >= ThreadBuffer::capacity)
+    {
+        buffer.dropped.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+
+    buffer.events[written % ThreadBuffer::capacity] = {name_, start_, end, buffer.index,
+                                                       buffer.depth};
+    buffer.written.store(written + 1, std::memory_order_release);
+}
+
+std::int64_t now() noexcept
+{
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+               std::chrono::steady_clock::now() - epoch)
+        .count();
+}
+
+void set_thread_name(const std::string& name)
+{
+    const auto index = thread_buffer().index;
+
+    const std::lock_guard lock(registry_mutex);
+    thread_names[index] = name;
+}
+
+std::string thread_name(std::uint32_t thread)
+{
+    const std::lock_guard lock(registry_mutex);
+
+    if(thread >= thread_names.size())
+        return "";
+    return thread_names[thread];
+}
+
+void end_frame()
+{
+    const auto end = now();
+
+    auto& frame = history[history_head];
+
+    frame.index   = frame_index++;
+    frame.start   = frame_start;
+    frame.end     = end;
+    frame.dropped = 0;
+    frame.zones.clear();    // Keeps its capacity
+
+    {
+        const std::lock_guard lock(registry_mutex);
+
+        for(auto& buffer : registry)
+        {
+            // Read before the zones, so a retired buffer is always drained
+            // of its last zones before being freed
+            const bool retired = buffer->retired.load(std::memory_order_acquire);
+
+            const auto read    = buffer->read.load(std::memory_order_relaxed);
+            const auto written = buffer->written.load(std::memory_order_acquire);
+
+            for(auto i = read; i < written; ++i)
+                frame.zones.push_back(buffer->events[i % ThreadBuffer::capacity]);
+
+            buffer->read.store(written, std::memory_order_release);
+            frame.dropped += buffer->dropped.exchange(0, std::memory_order_relaxed);
+
+            // The thread exited and its zones are gathered. Its name stays,
+            // the history still references it
+            if(retired)
+                buffer.reset();
+        }
+
+        std::erase(registry, nullptr);
+    }
+
+    history_head  = (history_head + 1) % history.size();
+    history_count = std::min(history_count + 1, history.size());
+    frame_start   = end;
+}
+
+std::size_t thread_buffer_count()
+{
+    const std::lock_guard lock(registry_mutex);
+    return registry.size();
+}
+
+void set_history_size(std::size_t size)
+{
+    history.assign(std::max<std::size_t>(size, 1), Frame());
+    history_head  = 0;
+    history_count = 0;
+}
+
+std::size_t history_size() noexcept
+{
+    return history.size();
+}
+
+std::size_t frame_count() noexcept
+{
+    return history_count;
+}
+
+const Frame* frame(std::size_t age) noexcept
+{
+    if(age >= history_count)
+        return nullptr;
+
+    return &history[(history_head + history.size() - 1 - age) % history.size()];
+}
+
+const Frame* slowest_frame() noexcept
+{
+    const Frame* slowest = nullptr;
+
+    for(std::size_t age = 0; age < history_count; ++age)
+    {
+        const auto* f = frame(age);
+
+        if(slowest == nullptr || f->end - f->start > slowest->end - slowest->start)
+            slowest = f;
+    }
+    return slowest;
+}
+
+void clear_history()
+{
+    for(auto& f : history)
+        f.zones.clear();
+
+    history_head  = 0;
+    history_count = 0;
+}
+
+std::string chrome_trace()
+{
+    std::string out = "{\"traceEvents\":[\n";
+
+    // Frames get their own track, after the threads
+    std::uint32_t frame_track = 0;
+
+    {
+        const std::lock_guard lock(registry_mutex);
+
+        frame_track = static_cast<std::uint32_t>(thread_names.size());
+
+        for(std::uint32_t i = 0; i < thread_names.size(); ++i)
+        {
+            out += "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":0,\"tid\":";
+            out += std::to_string(i);
+            out += ",\"args\":{\"name\":\"";
+            append_escaped(out, thread_names[i].c_str());
+            out += "\"}},\n";
+        }
+    }
+
+    out += "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":0,\"tid\":";
+    out += std::to_string(frame_track);
+    out += ",\"args\":{\"name\":\"Frames\"}}";
+
+    auto append_event = [&](const char* name, std::int64_t start, std::int64_t end,
+                            std::uint32_t thread)
+    {
+        out += ",\n{\"name\":\"";
+        append_escaped(out, name);
+        out += "\",\"cat\":\"corgi\",\"ph\":\"X\",\"ts\":";
+        append_microseconds(out, start);
+        out += ",\"dur\":";
+        append_microseconds(out, end - start);
+        out += ",\"pid\":0,\"tid\":";
+        out += std::to_string(thread);
+        out += '}';
+    };
+
+    // Oldest frame first
+    for(std::size_t age = history_count; age-- > 0;)
+    {
+        const auto* f = frame(age);
+
+        const auto frame_name = "Frame " + std::to_string(f->index);
+        append_event(frame_name.c_str(), f->start, f->end, frame_track);
+
+        for(const auto& zone : f->zones)
+            append_event(zone.name, zone.start, zone.end, zone.thread);
+    }
+
+    out += "\n]}\n";
+    return out;
+}
+
+bool export_chrome_trace(const std::string& path)
+{
+    std::ofstream file(path.c_str(), std::ofstream::binary | std::ofstream::trunc);
+
+    if(!file.is_open())
+        return false;
+
+    const auto trace = chrome_trace();
+    file.write(trace.data(), static_cast<std::streamsize>(trace.size()));
+    return static_cast<bool>(file);
+}
+}    // namespace corgi::profiler
@@ -0,0 +1,151 @@
+#include <corgi/profiler/Profiler.h>
+#include <corgi/test/test.h>
+
+#include <string>
+#include <thread>
+
+using namespace corgi;
+using namespace corgi::test;
+
+int main()
+{
+    test::run_all();
+}
+
+class ProfilerTest : public test::Test
+{
+public:
+    void set_up() override
+    {
+        // Flushes whatever the previous tests recorded
+        profiler::end_frame();
+        profiler::set_history_size(4);
+    }
+};
+
+TEST_F(ProfilerTest, nested_zones)
+{
+    {
+        profiler::ScopedZone outer("outer");
+        {
+            profiler::ScopedZone inner("inner");
+        }
+    }
+    profiler::end_frame();
+
+    assert_that(profiler::frame_count(), equals(1u));
+
+    const auto* frame = profiler::frame(0);
+
+    // Zones are recorded when they end
+    assert_that(frame->zones.size(), equals(2u));
+    assert_that(std::string(frame->zones[0].name), equals(std::string("inner")));
+    assert_that(frame->zones[0].depth, equals(1u));
+    assert_that(frame->zones[1].depth, equals(0u));
+
+    assert_that(frame->zones[1].start <= frame->zones[0].start, equals(true));
+    assert_that(frame->zones[1].end >= frame->zones[0].end, equals(true));
+    assert_that(frame->start <= frame->zones[1].start, equals(true));
+}
+
+TEST_F(ProfilerTest, zones_from_other_threads)
+{
+    std::thread worker(
+        []
+        {
+            profiler::set_thread_name("Worker");
+
+            for(int i = 0; i < 10; i++)
+                profiler::ScopedZone zone("work");
+        });
+    worker.join();
+
+    {
+        profiler::ScopedZone zone("main");
+    }
+
+    profiler::end_frame();
+
+    const auto* frame = profiler::frame(0);
+
+    assert_that(frame->zones.size(), equals(11u));
+
+    int worker_zones = 0;
+
+    for(const auto& zone : frame->zones)
+    {
+        if(profiler::thread_name(zone.thread) == "Worker")
+            worker_zones++;
+    }
+
+    assert_that(worker_zones, equals(10));
+}
+
+TEST_F(ProfilerTest, exited_threads_release_their_buffer)
+{
+    const auto buffers = profiler::thread_buffer_count();
+
+    for(int i = 0; i < 8; i++)
+    {
+        std::thread worker(
+            []
+            {
+                profiler::ScopedZone zone("short lived");
+            });
+        worker.join();
+    }
+
+    // Not freed before their zones are gathered
+    assert_that(profiler::thread_buffer_count(), equals(buffers + 8));
+
+    profiler::end_frame();
+
+    assert_that(profiler::frame(0)->zones.size(), equals(8u));
+    assert_that(profiler::thread_buffer_count(), equals(buffers));
+}
+
+TEST_F(ProfilerTest, history_is_a_ring)
+{
+    for(int i = 0; i < 6; i++)
+    {
+        profiler::ScopedZone zone("frame");
+        profiler::end_frame();
+    }
+
+    assert_that(profiler::frame_count(), equals(4u));
+    assert_that(profiler::frame(4) == nullptr, equals(true));
+
+    // Frames are ordered from the most recent one
+    assert_that(profiler::frame(0)->index, equals(profiler::frame(1)->index + 1));
+    assert_that(profiler::frame(0)->start, equals(profiler::frame(1)->end));
+}
+
+TEST_F(ProfilerTest, chrome_trace)
+{
+    {
+        profiler::ScopedZone zone("quoted \"zone\"");
+    }
+    profiler::end_frame();
+
+    const auto trace = profiler::chrome_trace();
+
+    assert_that(trace.find("{\"traceEvents\":[") == 0, equals(true));
+    assert_that(trace.find("quoted \\\"zone\\\"") != std::string::npos, equals(true));
+    assert_that(trace.find("\"ph\":\"X\"") != std::string::npos, equals(true));
+    assert_that(trace.find("\"name\":\"Frames\"") != std::string::npos, equals(true));
+}
+
+TEST_F(ProfilerTest, macros)
+{
+    {
+        CORGI_PROFILE_ZONE("macro");
+        CORGI_PROFILE_FUNCTION();
+    }
+    profiler::end_frame();
+
+#ifdef CORGI_PROFILER_ENABLED
+    assert_that(profiler::frame(0)->zones.size(), equals(2u));
+#else
+    assert_that(profiler::frame(0)->zones.size(), equals(0u));
+#endif
+}
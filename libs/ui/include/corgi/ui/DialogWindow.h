@@ -46,11 +46,11 @@ namespace corgi::ui
         float positionAtStartDragX_;
         float positionAtStartDragY_;
 
-        int keyTitleBackgroundColorChangedCallback_;
-        int keyContentBackgroundColorChangedCallback_;
-        int keyTitleFontChangedCallback_;
-        int keyTitleTextColorChangedCallback_;
-        int keyTitleBarHeightChangedCallback_;
+        EventHandle keyTitleBackgroundColorChangedCallback_;
+        EventHandle keyContentBackgroundColorChangedCallback_;
+        EventHandle keyTitleFontChangedCallback_;
+        EventHandle keyTitleTextColorChangedCallback_;
+        EventHandle keyTitleBarHeightChangedCallback_;
     };
 
 }    // namespace corgi::ui
\ No newline at end of file
@@ -0,0 +1,122 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+namespace corgi::ui
+{
+class Widget;
+
+/**
+ * @brief   Spatial index used by the UISystem to route mouse events
+ *
+ *          The index is rebuilt once per frame from the widget hierarchy
+ *          currently receiving events (the top modal widget if there's one,
+ *          the regular root otherwise). Every widget rectangle is clipped by
+ *          its closest viewport and bucketed into a uniform grid, so a point
+ *          query only has to test the widgets overlapping the cell under
+ *          the cursor instead of walking the whole hierarchy.
+ *
+ *          Widgets are stored in depth first order, which is the order the
+ *          hierarchy gets painted in, so the results of a query follow the
+ *          same z-order than a regular traversal of the tree
+ */
+class HitTestIndex
+{
+public:
+    /**
+     * @brief   Rebuilds the index from the children of @a root
+     *
+     *          @a root itself isn't indexed, the same way iterating over
+     *          a Node doesn't return the node itself
+     *
+     * @param root          Widget whose descendants will be indexed
+     * @param cell_size     Width and height of a grid cell in pixels
+     */
+    void build(Widget& root, float cell_size = 64.0f);
+
+    /**
+     * @brief   Empties the index
+     *
+     *          Called once the widgets marked for destruction are removed
+     *          so we never keep dangling pointers around
+     */
+    void clear() noexcept;
+
+    /**
+     * @brief   Returns the deepest widget under the given point that can
+     *          process events
+     *
+     *          Disabled and deactivated widgets, widgets with their events
+     *          disabled and widgets not processing events are skipped. If
+     *          several widgets share the same depth, the first one in depth
+     *          first order is returned. Returns nullptr if nothing was found
+     */
+    [[nodiscard]] Widget* find_deepest(int x, int y) const;
+
+    /**
+     * @brief   Fills @a widgets with every indexed widget under the given point
+     *
+     *          Widgets are returned in depth first order, without any
+     *          filtering on their state
+     */
+    void query(int x, int y, std::vector<Widget*>& widgets) const;
+
+    /**
+     * @brief   Returns how many widgets have a non empty clipped rectangle
+     */
+    [[nodiscard]] std::size_t size() const noexcept { return entries_.size(); }
+
+    [[nodiscard]] bool empty() const noexcept { return entries_.empty(); }
+
+private:
+    struct Entry
+    {
+        Widget* widget;
+
+        // Absolute rectangle of the widget, clipped by its viewport
+        float left;
+        float top;
+        float right;
+        float bottom;
+
+        int  depth;
+        bool processes_events;
+
+        [[nodiscard]] bool contains(float x, float y) const noexcept
+        {
+            return x >= left && x <= right && y >= top && y <= bottom;
+        }
+    };
+
+    struct Rect
+    {
+        float left;
+        float top;
+        float right;
+        float bottom;
+    };
+
+    void collect(Widget& widget, const Rect& viewport, int depth);
+
+    /**
+     * @brief   Returns the index of the cell containing the given point, or
+     *          -1 if the point is outside the grid
+     */
+    [[nodiscard]] int cell_index(float x, float y) const noexcept;
+
+    std::vector<Entry> entries_;
+
+    // The grid is stored as a compressed sparse row : the indexes of the
+    // entries overlapping cell i are stored in
+    // cell_entries_[cell_offsets_[i] .. cell_offsets_[i+1]]
+    std::vector<std::uint32_t> cell_offsets_;
+    std::vector<std::uint32_t> cell_entries_;
+
+    float min_x_     = 0.0f;
+    float min_y_     = 0.0f;
+    float cell_size_ = 64.0f;
+    int   columns_   = 0;
+    int   rows_      = 0;
+};
+}    // namespace corgi::ui
@@ -5,11 +5,13 @@
 #include <corgi/resources/FontView.h>
 #include <corgi/resources/Mesh.h>
 #include <corgi/ui/TextEnums.h>
+#include <corgi/ui/TextLayout.h>
 #include <corgi/ui/Widget.h>
 #include <corgi/utils/TextUtils.h>
 
 #include <memory>
 #include <string>
+#include <string_view>
 
 namespace corgi::ui
 {
@@ -24,6 +26,9 @@ public:
 
     /*!
          * @brief Returns the text displayed by the widget
+         *
+         *        The text is stored by the layout, the string is only
+         *        built again when the text changed since the last call
          */
     [[nodiscard]] const std::string& text() const;
 
@@ -39,6 +44,15 @@ public:
          */
     void setText(const std::string& text);
 
+    /*!
+         * @brief   Replaces the @a removed characters starting at @a offset
+         *          by @a inserted
+         *
+         *          Only the lines touched by the edit are shaped again, so
+         *          editing a large text costs about the size of a line
+         */
+    void replaceText(std::size_t offset, std::size_t removed, std::string_view inserted);
+
     /**
          * @brief   Set a string on a single line and fits it if needed
          * 
@@ -152,10 +166,16 @@ public:
     [[nodiscard]] const std::vector<corgi::utils::text::ShapedGlyph>&
     shapedGlyphs() const noexcept;
 
+    /**
+     * @brief   Returns the lines of the text and the glyphs they start at
+     */
+    [[nodiscard]] const TextLayout& layout() const noexcept;
+
     /**
          * @brief Set size of the font, if available
          *        This function will simply loop through every configuration
-         *        available looking for on with the requested size
+         *        available looking for on with the requested size. A font
+         *        with a distance field configuration can use any size
          * 
          * 
          * @param size 
@@ -169,17 +189,44 @@ public:
 
     void setDepth(float depth);
 
+    /**
+     * @brief   Mesh mode given to every new Text
+     *
+     *          Labels change often, a score or a timer every frame, so they
+     *          only upload the glyphs that changed by default. Set it to
+     *          Shared to stream every label into a single buffer per frame
+     */
+    static inline DrawList::Text::MeshMode defaultMeshMode =
+        DrawList::Text::MeshMode::Incremental;
+
+    /**
+     * @brief   Sets how the text's mesh is updated when the text changes
+     */
+    void setMeshMode(DrawList::Text::MeshMode mode);
+
 private:
     // Functions
 
+    /**
+     * @brief   Uses the material matching the font's current configuration
+     *          and gives it the configuration's texture
+     */
+    void updateMaterial();
+
     // Variables
 
+    // Material mMaterial was loaded from
+    std::string materialPath_;
+
     DrawList::Text _text;
+
     // In case the string is simplified, we still have the
-    // actual string in there
-    std::string actualText_;
+    // actual string in there, shaped line by line
+    TextLayout layout_;
 
-    std::vector<corgi::utils::text::ShapedGlyph> shapedGlyphs_;
+    // Built from the layout's buffer by text()
+    mutable std::string text_;
+    mutable bool        textChanged_ = true;
 
     Color mColor {0, 0, 0, 255};
 
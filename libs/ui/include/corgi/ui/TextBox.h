@@ -4,8 +4,8 @@
 #include <corgi/ui/Text.h>
 #include <corgi/ui/Widget.h>
 
-#include <functional>
 #include <string>
+#include <string_view>
 
 namespace corgi::ui
 {
@@ -13,7 +13,6 @@ class TextBox : public Widget
 {
 public:
     TextBox(const std::string& text = "");
-    TextBox(std::reference_wrapper<std::string> text);
 
     void init() override;
 
@@ -23,6 +22,9 @@ public:
 
     void setText(const std::string& str);
 
+    /**
+         * @brief   Returns the edited text, built from the text widget's buffer
+         */
     std::string text();
 
     /**
@@ -52,6 +54,16 @@ private:
     void initializeVerticalBar();
     void initializeSelectionRectangle();
 
+    /**
+         * @brief   Inserts @a text at the cursor and moves the cursor after it
+         */
+    void insertText(std::string_view text);
+
+    /**
+         * @brief   Erases the characters of the glyph before the cursor
+         */
+    void eraseBeforeCursor();
+
     int findCursorIndex(int x, int y);
 
     bool isCursorOutOfBound(int x, int y);
@@ -101,8 +113,9 @@ private:
 
     corgi::Event<std::string> mTextUpdated;
 
-    std::string  mLocalText = "";
-    std::string& mText;
+    // Text given before the text widget exists, the widget's layout holds
+    // it afterwards
+    std::string initialText_;
 
     Color mBackgroundColor {255, 255, 255, 255};
     Color mMouseOverBackgroundColor {230, 230, 230, 255};
@@ -0,0 +1,120 @@
+#pragma once
+
+#include <cstddef>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace corgi::ui
+{
+/**
+ * @brief   Editable text stored inside a gap buffer, with an index of where
+ *          every line starts
+ *
+ *          The characters are stored in a single array with a hole, the gap,
+ *          sitting where the last edit happened. Typing moves the gap to the
+ *          cursor once, then every character is written inside the gap
+ *          without moving the rest of the text, so an edit costs the distance
+ *          from the previous one instead of the size of the text
+ *
+ *          Offsets are in bytes, and lines are separated by '\n'. A text
+ *          always has at least 1 line, even when empty
+ */
+class TextBuffer
+{
+public:
+    TextBuffer() = default;
+    explicit TextBuffer(std::string_view text);
+
+    // Modifiers
+
+    /**
+     * @brief   Replaces the whole text by @a text
+     */
+    void assign(std::string_view text);
+
+    /**
+     * @brief   Inserts @a text before the character at @a offset
+     */
+    void insert(std::size_t offset, std::string_view text);
+
+    /**
+     * @brief   Erases @a count characters, starting at @a offset
+     */
+    void erase(std::size_t offset, std::size_t count);
+
+    // Accessors
+
+    [[nodiscard]] std::size_t size() const noexcept { return data_.size() - gapSize(); }
+    [[nodiscard]] bool        empty() const noexcept { return size() == 0; }
+
+    [[nodiscard]] char operator[](std::size_t offset) const noexcept
+    {
+        return offset < gapStart_ ? data_[offset] : data_[offset + gapSize()];
+    }
+
+    /**
+     * @brief   Returns the whole text inside a single string
+     */
+    [[nodiscard]] std::string str() const;
+
+    [[nodiscard]] std::string substr(std::size_t offset, std::size_t count) const;
+
+    /**
+     * @brief   Returns true if the text is equal to @a text, without building
+     *          a string
+     */
+    [[nodiscard]] bool equals(std::string_view text) const noexcept;
+
+    // Lines
+
+    [[nodiscard]] std::size_t lineCount() const noexcept { return lineStarts_.size(); }
+
+    /**
+     * @brief   Returns the offset of the first character of @a line
+     */
+    [[nodiscard]] std::size_t lineStart(std::size_t line) const noexcept
+    {
+        return lineStarts_[line];
+    }
+
+    /**
+     * @brief   Returns the offset of the '\n' ending @a line, or the size of
+     *          the text for the last line
+     */
+    [[nodiscard]] std::size_t lineEnd(std::size_t line) const noexcept
+    {
+        return line + 1 < lineStarts_.size() ? lineStarts_[line + 1] - 1 : size();
+    }
+
+    /**
+     * @brief   Returns the line containing the character at @a offset
+     */
+    [[nodiscard]] std::size_t lineOf(std::size_t offset) const noexcept;
+
+    /**
+     * @brief   Returns the content of @a line, without its '\n'
+     */
+    [[nodiscard]] std::string line(std::size_t line) const;
+
+private:
+    [[nodiscard]] std::size_t gapSize() const noexcept { return gapEnd_ - gapStart_; }
+
+    /**
+     * @brief   Moves the gap so it starts at @a offset
+     */
+    void moveGap(std::size_t offset);
+
+    /**
+     * @brief   Grows the array until the gap holds at least @a count characters
+     */
+    void reserveGap(std::size_t count);
+
+    std::vector<char> data_;
+    std::size_t       gapStart_ = 0;
+    std::size_t       gapEnd_   = 0;
+
+    // Offset of the first character of every line
+    std::vector<std::size_t> lineStarts_ {0};
+};
+}    // namespace corgi::ui
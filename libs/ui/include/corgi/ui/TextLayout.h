@@ -0,0 +1,111 @@
+#pragma once
+
+#include <corgi/ui/TextBuffer.h>
+#include <corgi/utils/TextUtils.h>
+
+#include <cstddef>
+#include <functional>
+#include <string_view>
+#include <vector>
+
+namespace corgi::ui
+{
+/**
+ * @brief   Keeps the shaped glyphs of a TextBuffer up to date while it's
+ *          being edited
+ *
+ *          Lines are shaped separately, so an edit only reshapes the lines
+ *          it touched, instead of the whole text. Each line but the last one
+ *          is followed by a glyph whose codepoint is 0 standing for its '\n',
+ *          the way the DrawList::Text and the TextBox expect it
+ *
+ *          The textOffset of a glyph is the offset of its first character
+ *          inside the whole text
+ */
+class TextLayout
+{
+public:
+    /**
+     * @brief   Shapes @a line, which starts at @a textOffset inside the text
+     *          and doesn't contain any '\n'
+     */
+    using Shaper = std::function<std::vector<corgi::utils::text::ShapedGlyph>(
+        std::string_view line, int textOffset)>;
+
+    explicit TextLayout(Shaper shaper);
+
+    // Modifiers
+
+    /**
+     * @brief   Replaces the whole text, reshaping every line
+     */
+    void setText(std::string_view text);
+
+    /**
+     * @brief   Replaces the @a removed characters starting at @a offset by
+     *          @a inserted, and only reshapes the lines containing the edit
+     */
+    void replace(std::size_t offset, std::size_t removed, std::string_view inserted);
+
+    /**
+     * @brief   Reshapes every line, when the font changed for instance
+     */
+    void reshape();
+
+    // Accessors
+
+    [[nodiscard]] const TextBuffer& buffer() const noexcept { return buffer_; }
+
+    [[nodiscard]] const std::vector<corgi::utils::text::ShapedGlyph>& glyphs() const noexcept
+    {
+        return glyphs_;
+    }
+
+    [[nodiscard]] int lineCount() const noexcept
+    {
+        return static_cast<int>(lineGlyphStarts_.size());
+    }
+
+    /**
+     * @brief   Returns the index of the first glyph of @a line
+     */
+    [[nodiscard]] int lineFirstGlyph(int line) const noexcept
+    {
+        return static_cast<int>(lineGlyphStarts_[line]);
+    }
+
+    /**
+     * @brief   Returns the index of the glyph ending @a line, its '\n', or the
+     *          glyph count for the last line
+     */
+    [[nodiscard]] int lineEndGlyph(int line) const noexcept;
+
+    /**
+     * @brief   Returns the line a cursor standing before the glyph at
+     *          @a glyphIndex is on
+     */
+    [[nodiscard]] int lineOfGlyph(int glyphIndex) const noexcept;
+
+    /**
+     * @brief   Returns how many characters the last modification shaped
+     */
+    [[nodiscard]] std::size_t shapedCharacters() const noexcept { return shapedCharacters_; }
+
+private:
+    /**
+     * @brief   Shapes @a line and appends its glyphs, and its '\n' glyph if it
+     *          isn't the last line, to @a glyphs
+     */
+    void shapeLine(std::size_t line, std::vector<corgi::utils::text::ShapedGlyph>& glyphs);
+
+    Shaper     shaper_;
+    TextBuffer buffer_;
+
+    std::vector<corgi::utils::text::ShapedGlyph> glyphs_;
+
+    // Index of the first glyph of every line
+    std::vector<std::size_t> lineGlyphStarts_ {0};
+
+    std::size_t shapedCharacters_ = 0;
+};
+}    // namespace corgi::ui
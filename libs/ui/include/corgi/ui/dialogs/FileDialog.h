@@ -9,7 +9,9 @@
 namespace corgi::ui
 {
 class SimpleButton;
-class VerticalLayout;
+class VirtualLayout;
+class Text;
+class Image;
 
 /**
      * @brief   Widget displaying a file in the FileDialog
@@ -44,12 +46,28 @@ public:
          */
     [[nodiscard]] const corgi::filesystem::FileInfo& fileInfo() const noexcept;
 
+    /**
+         * @brief   Updates the icon and the text to display another file
+         * 
+         *          FileItems are recycled by the FileDialog's layout when
+         *          scrolling, so the same item displays different files
+         */
+    void setFileInfo(const corgi::filesystem::FileInfo& fileInfo);
+
+    /**
+         * @brief   Updates the background color depending on the selection state
+         */
+    void setSelected(bool selected);
+
 private:
     /**
          * @brief   Rectangle used as a text background
          */
     ui::Rectangle* textBackground_ = nullptr;
 
+    ui::Image* icon_ = nullptr;
+    ui::Text*  text_ = nullptr;
+
     /**
          * @brief True if the item is selected
          */
@@ -111,6 +129,12 @@ private:
          */
     void initOkButton();
 
+    /**
+         * @brief   Sets the callbacks used by the layout to create and
+         *          bind the FileItems
+         */
+    void initFileItems();
+
     /**
          * @brief Initialize the buttons widgets
          */
@@ -136,7 +160,7 @@ private:
     /**
      * @brief   Layout positionning the FileItem
      */
-    ui::VerticalLayout* flowLayout_ = nullptr;
+    ui::VirtualLayout* flowLayout_ = nullptr;
 
     /**
      * @brief   Image representing the 
@@ -154,9 +178,17 @@ private:
     std::string currentFolder;
 
     /**
-     * @brief Pointer to the item currently selected
+     * @brief   Files inside the current folder, sorted
+     */
+    std::vector<corgi::filesystem::FileInfo> files_;
+
+    /**
+     * @brief   Index of the file currently selected, -1 if none
+     * 
+     *          We can't keep a pointer to the selected FileItem since
+     *          FileItems get recycled when scrolling
      */
-    FileItem* selectedItem_ = nullptr;
+    int selectedIndex_ = -1;
 
     /**
      * @brief   Event called when the file dialog is closed that send the 
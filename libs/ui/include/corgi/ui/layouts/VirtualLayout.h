@@ -0,0 +1,190 @@
+#pragma once
+
+#include <corgi/ui/Widget.h>
+
+#include <functional>
+#include <vector>
+
+namespace corgi::ui
+{
+    /**
+     * @brief   Lines up a potentially huge amount of items vertically, or in a
+     *          grid, while only creating widgets for the visible ones
+     *
+     *          The layout doesn't own a widget per item. Instead it is driven
+     *          by an item count and 2 callbacks :
+     *
+     *          * The item factory creates a new, empty item widget. It should
+     *            construct it as a child of the layout (layout.emplaceBack)
+     *
+     *          * The item binder fills an item widget with the content of
+     *            the item at a given index
+     *
+     *          Only the items inside the closest viewport (usually a ScrollView)
+     *          plus a few overscan items are materialized. When scrolling, the
+     *          widgets leaving the viewport are disabled and kept in a pool so
+     *          they can be bound again to the items entering the viewport.
+     *
+     *          In List mode, items can have different heights by setting an
+     *          item measure callback. Measured heights are cached in a prefix
+     *          sum so finding the visible items is a binary search. Call
+     *          invalidateItem when an item's content changes.
+     */
+    class VirtualLayout : public Widget
+    {
+    public:
+        enum class Mode
+        {
+            List,
+            Grid
+        };
+
+        using ItemFactory = std::function<Widget*(VirtualLayout& layout)>;
+        using ItemBinder  = std::function<void(Widget& item, int index)>;
+        using ItemMeasure = std::function<float(int index)>;
+
+        [[nodiscard]] float height() const noexcept override;
+
+        void paint(Renderer& renderer) override;
+
+        // Items are created by the layout itself, we don't want the
+        // default behavior of logging them
+        void handleNewChild(Widget* w) override {}
+
+        void setMode(Mode mode);
+        void setItemCount(int count);
+        void setItemFactory(ItemFactory factory);
+        void setItemBinder(ItemBinder binder);
+
+        /**
+         * @brief   Sets the callback used to measure the height of an item
+         *
+         *          Only used in List mode. If no callback is set, every item
+         *          uses the height given to setItemHeight
+         */
+        void setItemMeasure(ItemMeasure measure);
+
+        void setItemHeight(float itemHeight);
+
+        /**
+         * @brief   Width of an item. Only used in Grid mode
+         */
+        void setItemWidth(float itemWidth);
+        void setSpacing(float spacing);
+
+        /**
+         * @brief   How many rows are materialized above and below the viewport
+         */
+        void setOverscan(int overscan);
+
+        /**
+         * @brief   Measures the item again and binds it again if it is visible
+         */
+        void invalidateItem(int index);
+
+        /**
+         * @brief   Measures every item again and rebinds the visible ones
+         *
+         *          Must be called when the data behind the items changed
+         */
+        void invalidate();
+
+        [[nodiscard]] Mode  getMode() const noexcept;
+        [[nodiscard]] int   getItemCount() const noexcept;
+        [[nodiscard]] float getItemHeight() const noexcept;
+        [[nodiscard]] float getItemWidth() const noexcept;
+        [[nodiscard]] float getSpacing() const noexcept;
+        [[nodiscard]] int   getOverscan() const noexcept;
+
+        /**
+         * @brief   Returns the widget currently bound to the item at @a index,
+         *          or nullptr if the item isn't materialized
+         */
+        [[nodiscard]] Widget* itemWidget(int index) const noexcept;
+
+        /**
+         * @brief   Returns the index of the item bound to @a widget, or -1
+         */
+        [[nodiscard]] int itemIndex(const Widget* widget) const noexcept;
+
+        /**
+         * @brief   Returns the y position of the item relative to the layout
+         */
+        [[nodiscard]] float itemOffset(int index) const noexcept;
+
+        /**
+         * @brief   Returns the index of the item at the given y position
+         *          relative to the layout, or -1. Only used in List mode
+         */
+        [[nodiscard]] int itemAt(float y) const noexcept;
+
+        /**
+         * @brief   Returns how many widgets are currently bound to an item
+         */
+        [[nodiscard]] int materializedCount() const noexcept;
+
+    private:
+        struct Slot
+        {
+            Widget* widget;
+            int     index;
+        };
+
+        [[nodiscard]] int getCountColumns() const noexcept;
+
+        /**
+         * @brief   Rebuilds the prefix sum starting at item @a from
+         */
+        void updateOffsets(int from = 0);
+
+        /**
+         * @brief   Computes the range of items overlapping the viewport
+         */
+        void visibleRange(int& first, int& last) const;
+
+        void placeItem(Widget& widget, int index);
+
+        ItemFactory mItemFactory;
+        ItemBinder  mItemBinder;
+        ItemMeasure mItemMeasure;
+
+        /**
+         * @brief   mOffsets[i] is the y position of the item i. The last
+         *          value is the total height of the layout
+         *
+         *          Only used in List mode
+         */
+        std::vector<float> mOffsets {0.0f};
+
+        /**
+         * @brief   Items bound to a widget, sorted by index
+         */
+        std::vector<Slot> mSlots;
+        std::vector<Slot> mNextSlots;
+
+        /**
+         * @brief   Widgets not bound to any item, ready to be recycled
+         */
+        std::vector<Widget*> mPool;
+
+        Mode mMode = Mode::List;
+
+        int   mItemCount  = 0;
+        int   mOverscan   = 2;
+        float mItemHeight = 30.0f;
+        float mItemWidth  = 100.0f;
+        float mSpacing    = 0.0f;
+
+        int mPreviousColumns = 0;
+
+        /**
+         * @brief   Set when every bound item must be placed again
+         */
+        bool mLayoutDirty = false;
+
+        /**
+         * @brief   Set when every bound item must be bound again
+         */
+        bool mRebindAll = false;
+    };
+}    // namespace corgi::ui
@@ -0,0 +1,183 @@
+#include <corgi/ui/HitTestIndex.h>
+#include <corgi/ui/Widget.h>
+
+#include <algorithm>
+#include <limits>
+
+namespace corgi::ui
+{
+
+// We don't want a huge widget (or a widget positioned very far away)
+// to allocate an absurd amount of cells, so the cell size gets enlarged
+// when the indexed area is bigger than this many cells on one axis
+static constexpr int max_cells_per_axis = 256;
+
+void HitTestIndex::clear() noexcept
+{
+    entries_.clear();
+    cell_offsets_.clear();
+    cell_entries_.clear();
+    columns_ = 0;
+    rows_    = 0;
+}
+
+void HitTestIndex::collect(Widget& widget, const Rect& viewport, int depth)
+{
+    const float x = widget.real_x();
+    const float y = widget.real_y();
+
+    const Rect rect {x, y, x + widget.width(), y + widget.height()};
+
+    // A viewport only clips its content, so the widget itself is
+    // tested against its own rectangle, the same way Widget::contains does
+    const Rect clip = widget.isViewport ? rect : viewport;
+
+    const Entry entry {&widget,
+                       std::max(rect.left, clip.left),
+                       std::max(rect.top, clip.top),
+                       std::min(rect.right, clip.right),
+                       std::min(rect.bottom, clip.bottom),
+                       depth,
+                       !widget.eventsDisabled() && widget.isEnabled() &&
+                           widget.isActive() && widget.mProcessEvent};
+
+    if(entry.left <= entry.right && entry.top <= entry.bottom)
+        entries_.push_back(entry);
+
+    // Nothing inside an empty viewport can be hit
+    if(clip.left > clip.right || clip.top > clip.bottom)
+        return;
+
+    for(auto& child : widget.getChildren())
+        collect(*child->mValue, clip, depth + 1);
+}
+
+void HitTestIndex::build(Widget& root, float cell_size)
+{
+    clear();
+
+    Rect viewport {std::numeric_limits<float>::lowest(), std::numeric_limits<float>::lowest(),
+                   std::numeric_limits<float>::max(), std::numeric_limits<float>::max()};
+
+    if(const auto* v = root.findViewport())
+        viewport = {v->real_x(), v->real_y(), v->real_x() + v->width(),
+                    v->real_y() + v->height()};
+
+    for(auto& child : root.getChildren())
+        collect(*child->mValue, viewport, 1);
+
+    if(entries_.empty())
+        return;
+
+    min_x_      = entries_.front().left;
+    min_y_      = entries_.front().top;
+    float max_x = entries_.front().right;
+    float max_y = entries_.front().bottom;
+
+    for(const auto& entry : entries_)
+    {
+        min_x_ = std::min(min_x_, entry.left);
+        min_y_ = std::min(min_y_, entry.top);
+        max_x  = std::max(max_x, entry.right);
+        max_y  = std::max(max_y, entry.bottom);
+    }
+
+    const float extent = std::max(max_x - min_x_, max_y - min_y_);
+
+    cell_size_ = std::max(cell_size, extent / static_cast<float>(max_cells_per_axis));
+    columns_   = static_cast<int>((max_x - min_x_) / cell_size_) + 1;
+    rows_      = static_cast<int>((max_y - min_y_) / cell_size_) + 1;
+
+    const auto cell_count = static_cast<std::size_t>(columns_ * rows_);
+
+    // First we count how many entries overlap each cell, then we turn
+    // the counts into offsets. The entries are then inserted backward
+    // so every cell ends up listing its entries in depth first order
+    cell_offsets_.assign(cell_count + 1, 0u);
+
+    const auto for_each_cell = [&](const Entry& entry, auto&& function)
+    {
+        const int c0 = static_cast<int>((entry.left - min_x_) / cell_size_);
+        const int c1 = static_cast<int>((entry.right - min_x_) / cell_size_);
+        const int r0 = static_cast<int>((entry.top - min_y_) / cell_size_);
+        const int r1 = static_cast<int>((entry.bottom - min_y_) / cell_size_);
+
+        for(int r = r0; r <= r1; ++r)
+            for(int c = c0; c <= c1; ++c)
+                function(static_cast<std::size_t>(r * columns_ + c));
+    };
+
+    for(const auto& entry : entries_)
+        for_each_cell(entry, [&](std::size_t cell) { cell_offsets_[cell]++; });
+
+    for(std::size_t i = 1; i <= cell_count; ++i)
+        cell_offsets_[i] += cell_offsets_[i - 1];
+
+    cell_entries_.resize(cell_offsets_[cell_count]);
+
+    for(auto i = static_cast<std::uint32_t>(entries_.size()); i-- > 0;)
+        for_each_cell(entries_[i],
+                      [&](std::size_t cell) { cell_entries_[--cell_offsets_[cell]] = i; });
+}
+
+int HitTestIndex::cell_index(float x, float y) const noexcept
+{
+    if(columns_ == 0 || x < min_x_ || y < min_y_)
+        return -1;
+
+    const int column = static_cast<int>((x - min_x_) / cell_size_);
+    const int row    = static_cast<int>((y - min_y_) / cell_size_);
+
+    if(column >= columns_ || row >= rows_)
+        return -1;
+
+    return row * columns_ + column;
+}
+
+Widget* HitTestIndex::find_deepest(int x, int y) const
+{
+    const auto fx = static_cast<float>(x);
+    const auto fy = static_cast<float>(y);
+
+    const int cell = cell_index(fx, fy);
+
+    if(cell < 0)
+        return nullptr;
+
+    Widget* selected_widget = nullptr;
+    int     depth           = -1;
+
+    for(auto i = cell_offsets_[cell]; i < cell_offsets_[cell + 1]; ++i)
+    {
+        const auto& entry = entries_[cell_entries_[i]];
+
+        if(entry.processes_events && entry.depth > depth && entry.contains(fx, fy))
+        {
+            selected_widget = entry.widget;
+            depth           = entry.depth;
+        }
+    }
+    return selected_widget;
+}
+
+void HitTestIndex::query(int x, int y, std::vector<Widget*>& widgets) const
+{
+    widgets.clear();
+
+    const auto fx = static_cast<float>(x);
+    const auto fy = static_cast<float>(y);
+
+    const int cell = cell_index(fx, fy);
+
+    if(cell < 0)
+        return;
+
+    for(auto i = cell_offsets_[cell]; i < cell_offsets_[cell + 1]; ++i)
+    {
+        const auto& entry = entries_[cell_entries_[i]];
+
+        if(entry.contains(fx, fy))
+            widgets.push_back(entry.widget);
+    }
+}
+}    // namespace corgi::ui
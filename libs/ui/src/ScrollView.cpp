@@ -211,8 +211,11 @@ void ScrollView::paint(corgi::Renderer& renderer)
     auto ch = c->height();
 
     c->y(-scrollbarOffset / height() * ch);
-    updateMaterialRecursively(c);
+
+    // Virtualized layouts create their item widgets while painting, so
+    // we update the materials afterward to make sure new items get clipped
     c->paint(renderer);
+    updateMaterialRecursively(c);
 }
 
 void ScrollView::actual_paint(Renderer& renderer)
@@ -9,16 +9,7 @@ using namespace corgi;
 
 int ui::Text::lines() const noexcept
 {
-    int lines = 1;
-
-    for(auto character : actualText_)
-    {
-        if(character == '\n')
-        {
-            lines++;
-        }
-    }
-    return lines;
+    return layout_.lineCount();
 }
 
 float ui::Text::text_top_distance() const noexcept
@@ -64,10 +55,16 @@ int ui::Text::selectedLine(int x, int y) const
 }
 
 ui::Text::Text(const std::string& txt)
+    : layout_(
+          [this](std::string_view line, int textOffset)
+          {
+              auto conf = font_view.font_->configurations_[font_view.current_configuration_index_]
+                              .get();
+              return corgi::utils::text::buildShapedGlyphs(line, *conf, textOffset);
+          })
 {
-    _text.scaling = 1.0f;
-
-    _text.text = txt;
+    _text.scaling   = 1.0f;
+    _text.mesh_mode = defaultMeshMode;
 
     switch(vertical_alignment_)
     {
@@ -99,20 +96,35 @@ ui::Text::Text(const std::string& txt)
 
     _text.dimensions = Vec2(width_, height_);
 
-    mMaterial = *ResourcesCache::get<Material>("corgi/materials/unlit/unlit_texture.mat");
-
     if(!font_view.font_)
     {
         font_view.font_ = ResourcesCache::get<Font>("corgi/fonts/Roboto-Regular.fnt");
     }
 
-    mMaterial.enable_stencil_test(false);
-
     _text.font = font_view;
 
+    updateMaterial();
+
+    layout_.setText(txt);
+}
+
+void ui::Text::updateMaterial()
+{
     auto& conf =
         *_text.font.font_->configurations_[_text.font.current_configuration_index_];
 
+    // Distance field glyphs need a shader that thresholds the field
+    const auto* path = conf.rendering_mode == Font::RenderingMode::DistanceField
+                           ? "corgi/materials/unlit/unlit_distance_field_text.mat"
+                           : "corgi/materials/unlit/unlit_texture.mat";
+
+    if(path != materialPath_)
+    {
+        materialPath_ = path;
+        mMaterial     = *ResourcesCache::get<Material>(path);
+        mMaterial.enable_stencil_test(false);
+    }
+
     mMaterial.set_uniform("flat_color", mColor);
     mMaterial.set_uniform("use_flat_color", 1);
 
@@ -145,16 +157,10 @@ void corgi::ui::Text::setFont(const Font& font)
 
     _text.font = font_view;
 
-    auto& conf =
-        *_text.font.font_->configurations_[_text.font.current_configuration_index_];
-
-    mMaterial.set_uniform("flat_color", mColor);
-    mMaterial.set_uniform("use_flat_color", 1);
+    updateMaterial();
 
-    if(mMaterial._texture_uniforms.empty())
-        mMaterial.add_texture(*conf.texture.get());
-    else
-        mMaterial.set_texture(0, *conf.texture.get());
+    layout_.reshape();
+    _text.setText(layout_.glyphs());
 }
 
 void corgi::ui::Text::setFont(const Font* font)
@@ -170,35 +176,31 @@ void corgi::ui::Text::setFont(const Font* font)
 
 void corgi::ui::Text::setFontSize(int size)
 {
-    _text.font.set(size);
+    // The shaper reads the glyphs from font_view, so both views must agree
+    font_view.set(size);
 
-    auto& conf =
-        *_text.font.font_->configurations_[_text.font.current_configuration_index_];
+    _text.font = font_view;
 
-    mMaterial.set_uniform("flat_color", mColor);
-    mMaterial.set_uniform("use_flat_color", 1);
+    updateMaterial();
 
-    if(mMaterial._texture_uniforms.empty())
-        mMaterial.add_texture(*conf.texture.get());
-    else
-        mMaterial.set_texture(0, *conf.texture.get());
+    layout_.reshape();
+    _text.setText(layout_.glyphs());
 }
 
 const std::string& corgi::ui::Text::text() const
 {
-    return _text.text;
+    // The layout's buffer holds the text, the string is only built when asked
+    if(textChanged_)
+    {
+        text_        = layout_.buffer().str();
+        textChanged_ = false;
+    }
+    return text_;
 }
 
 void corgi::ui::Text::text(const std::string& txt)
 {
-    auto conf =
-        font_view.font_->configurations_[font_view.current_configuration_index_].get();
-    shapedGlyphs_      = corgi::utils::text::buildShapedGlyphs(txt.c_str(), *conf);
-    actualText_        = txt;
-    _text.dimensions.x = width();
-    _text.dimensions.y = height();
-    _text.text         = txt;
-    _text.setText(shapedGlyphs_);
+    setText(txt);
 }
 
 void ui::Text::setShortenedLineString(const std::string& text)
@@ -233,21 +235,37 @@ void ui::Text::setShortenedLineString(const std::string& text)
 
 void ui::Text::setText(const std::string& text)
 {
-    auto conf =
-        font_view.font_->configurations_[font_view.current_configuration_index_].get();
-    actualText_   = text;
-    shapedGlyphs_ = corgi::utils::text::buildShapedGlyphs(text.c_str(), *conf);
+    layout_.setText(text);
+
+    _text.dimensions.x = width();
+    _text.dimensions.y = height();
+
+    textChanged_ = true;
+
+    _text.setText(layout_.glyphs());
+}
+
+void ui::Text::replaceText(std::size_t offset, std::size_t removed, std::string_view inserted)
+{
+    layout_.replace(offset, removed, inserted);
 
     _text.dimensions.x = width();
     _text.dimensions.y = height();
 
-    _text.setText(shapedGlyphs_);
+    textChanged_ = true;
+
+    _text.setText(layout_.glyphs());
 }
 
 const std::vector<corgi::utils::text::ShapedGlyph>&
 ui::Text::shapedGlyphs() const noexcept
 {
-    return shapedGlyphs_;
+    return layout_.glyphs();
+}
+
+const ui::TextLayout& ui::Text::layout() const noexcept
+{
+    return layout_;
 }
 
 float ui::Text::leftOffset() const noexcept
@@ -258,10 +276,10 @@ float ui::Text::leftOffset() const noexcept
             return 0.0f;
 
         case HorizontalAlignment::Center:
-            return (width() - textWidth(actualText_)) / 2.0f;
+            return (width() - textWidth(text())) / 2.0f;
 
         case HorizontalAlignment::Right:
-            return (width() - textWidth(actualText_));
+            return (width() - textWidth(text()));
     }
     return 0.0f;
 }
@@ -280,7 +298,7 @@ void ui::Text::update_mesh()
         _text.dimensions.y = height();
         _text.material     = mMaterial;
 
-        _text.setText(shapedGlyphs_);
+        _text.setText(layout_.glyphs());
     }
 }
 
@@ -303,13 +321,13 @@ VerticalAlignment ui::Text::vertical_alignment() const
 void ui::Text::setHorizontalAlignment(HorizontalAlignment horizontalAlignment)
 {
     horizontal_alignment_ = horizontalAlignment;
-    _text.setText(shapedGlyphs_);
+    _text.setText(layout_.glyphs());
 }
 
 void ui::Text::setVerticalAlignment(VerticalAlignment verticalAlignment)
 {
     vertical_alignment_ = verticalAlignment;
-    _text.setText(shapedGlyphs_);
+    _text.setText(layout_.glyphs());
 }
 
 float ui::Text::getRealWidth() const
@@ -347,15 +365,31 @@ void corgi::ui::Text::paint(Renderer& renderer)
             break;
     }
 
-    _text.dimensions = Vec2(width(), height());
-
+    // update_mesh compares the dimensions to the widget's to know if the
+    // text moved, so they're not set here
     update_mesh();
+
+    const auto matrix = Matrix::translation(corgi::math::round(real_x()),
+                                            corgi::math::round(real_y()), depth_);
+
+    if(_text.mesh_mode == DrawList::Text::MeshMode::Shared)
+    {
+        renderer.windowDrawList().add_text(_text, matrix, mMaterial, *window_);
+        return;
+    }
+
     // TODO : Using the Game Singleton to access the windows kinda sucks here
-    renderer.window_draw_list().add_mesh(*_text.mesh,
-                                         Matrix::translation(corgi::math::round(real_x()),
-                                                             corgi::math::round(real_y()),
-                                                             depth_),
-                                         mMaterial, *window_);
+    renderer.windowDrawList().add_mesh(*_text.mesh, matrix, mMaterial, *window_);
+}
+
+void ui::Text::setMeshMode(DrawList::Text::MeshMode mode)
+{
+    if(_text.mesh_mode == mode)
+        return;
+
+    _text.mesh_mode = mode;
+    _text.mesh.reset();
+    _text.setText(layout_.glyphs());
 }
 
 void ui::Text::setDepth(float depth)
@@ -3,12 +3,7 @@
 using namespace corgi::ui;
 
 TextBox::TextBox(const std::string& text)
-    : mText(mLocalText)
-{
-}
-
-TextBox::TextBox(std::reference_wrapper<std::string> text)
-    : mText(text.get())
+    : initialText_(text)
 {
 }
 
@@ -39,20 +34,15 @@ TextBox::Point TextBox::cursorPosition(int cursorPosition)
         return {uiText_->distanceLeft(0), uiText_->text_top_distance()};
     }
 
-    int line = 0;
-    offset.y += uiText_->text_top_distance();
+    // Only the glyphs of the cursor's line move it horizontally
+    const auto& layout = uiText_->layout();
+    const int   line   = layout.lineOfGlyph(cursorPosition);
 
-    for(int i = 1; i <= cursorPosition; i++)
-    {
-        if(uiText_->shapedGlyphs()[i - 1].codepoint == 0)
-        {
-            offset.y += uiText_->font_view.height();
-            offset.x = 0;
-            line++;
-            continue;
-        }
+    offset.y = uiText_->text_top_distance() + line * uiText_->font_view.height();
 
-        offset.x += uiText_->shapedGlyphs()[i - 1].advance.x;
+    for(int i = layout.lineFirstGlyph(line); i < cursorPosition; i++)
+    {
+        offset.x += uiText_->shapedGlyphs()[i].advance.x;
     }
 
     offset.x += uiText_->distanceLeft(line);
@@ -114,18 +104,67 @@ void TextBox::initializeVerticalBar()
 
 void TextBox::setText(const std::string& str)
 {
-    mText = str;
+    if(!uiText_)
+    {
+        initialText_ = str;
+        return;
+    }
+
+    uiText_->setText(str);
+    mTextUpdated(str);
+}
+
+void TextBox::insertText(std::string_view text)
+{
+    const auto& glyphs = uiText_->shapedGlyphs();
+
+    // Characters are inserted after the ones displayed by the glyph before
+    // the cursor
+    std::size_t offset = 0;
 
-    if(uiText_)
+    if(cursorIndexPosition_ != 0)
     {
-        uiText_->text(mText.c_str());
-        mTextUpdated(str);
+        const auto& glyph = glyphs[cursorIndexPosition_ - 1];
+        offset            = glyph.textOffset + glyph.characters.size();
     }
+
+    const int glyphCount = static_cast<int>(glyphs.size());
+
+    uiText_->replaceText(offset, 0, text);
+
+    cursorIndexPosition_ += static_cast<int>(uiText_->shapedGlyphs().size()) - glyphCount;
+
+    // The string is only built when someone listens
+    if(!mTextUpdated.empty())
+        mTextUpdated(uiText_->text());
+}
+
+void TextBox::eraseBeforeCursor()
+{
+    if(cursorIndexPosition_ == 0)
+        return;
+
+    const auto& glyph = uiText_->shapedGlyphs()[cursorIndexPosition_ - 1];
+
+    const std::size_t offset = glyph.textOffset;
+    const std::size_t count  = glyph.characters.size();
+
+    const int glyphCount = static_cast<int>(uiText_->shapedGlyphs().size());
+
+    uiText_->replaceText(offset, count, {});
+
+    cursorIndexPosition_ -= glyphCount - static_cast<int>(uiText_->shapedGlyphs().size());
+
+    if(!mTextUpdated.empty())
+        mTextUpdated(uiText_->text());
 }
 
 std::string TextBox::text()
 {
-    return mText.c_str();
+    if(!uiText_)
+        return initialText_;
+
+    return uiText_->text();
 }
 
 void TextBox::setBackgroundColor(Color color)
@@ -141,9 +180,6 @@ void TextBox::setBackgroundMouseOverColor(Color color)
 void TextBox::setTextColor(Color color)
 {
     uiText_->setColor(color);
-
-    if(uiText_)
-        uiText_->text(mText.c_str());
 }
 
 void TextBox::setHorizontalAlignment(HorizontalAlignment align)
@@ -175,22 +211,12 @@ int TextBox::findCursorIndex(int x, int y)
 
     double offset = uiText_->real_x() + uiText_->distanceLeft(line);
 
-    int index       = 0;
-    int currentLine = 0;
-    for(auto glyph : uiText_->shapedGlyphs())
-    {
-        if(glyph.codepoint == 0)
-        {
-            currentLine++;
-            index++;
-            continue;
-        }
+    const auto& layout = uiText_->layout();
+    const auto& glyphs = uiText_->shapedGlyphs();
 
-        if(currentLine != line)
-        {
-            index++;
-            continue;
-        }
+    for(int index = layout.lineFirstGlyph(line); index < layout.lineEndGlyph(line); index++)
+    {
+        const auto& glyph = glyphs[index];
 
         if(x >= offset && x <= offset + glyph.advance.x)
         {
@@ -202,7 +228,6 @@ int TextBox::findCursorIndex(int x, int y)
             return corgi::math::clamp(index, 0, uiText_->shapedGlyphs().size());
         }
         offset += glyph.advance.x;
-        index++;
     }
     return 0;
 }
@@ -215,81 +240,30 @@ bool TextBox::isCursorOutOfBound(int x, int y)
 
     double offset = uiText_->real_x() + uiText_->distanceLeft(line);
 
-    int index       = 0;
-    int currentLine = 0;
+    const auto& layout = uiText_->layout();
+    const auto& glyphs = uiText_->shapedGlyphs();
 
-    for(auto glyph : uiText_->shapedGlyphs())
+    for(int index = layout.lineFirstGlyph(line); index < layout.lineEndGlyph(line); index++)
     {
-        if(glyph.codepoint == 0)
-        {
-            currentLine++;
-            index++;
-            continue;
-        }
-
-        if(currentLine != line)
-        {
-            index++;
-            continue;
-        }
+        const auto& glyph = glyphs[index];
 
         if(x >= offset && x <= offset + glyph.advance.x)
         {
-            if(x >= offset + (glyph.advance.x / 2.0f))
-            {
-                return false;
-            }
-
             return false;
         }
         offset += glyph.advance.x;
-        index++;
     }
     return true;
 }
 
 int TextBox::cursorAtEndLine(int lineIndex)
 {
-    int currentLine = 0;
-    int index       = 0;
-
-    for(auto glyph : uiText_->shapedGlyphs())
-    {
-        if(glyph.codepoint == 0)
-        {
-            if(lineIndex == currentLine)
-            {
-                return index;
-            }
-            currentLine++;
-        }
-        index++;
-    }
-    return 0;
+    return uiText_->layout().lineEndGlyph(lineIndex);
 }
 
 int TextBox::cursorAtStartLine(int lineIndex)
 {
-    if(lineIndex == 0)
-        return 0;
-
-    int currentLine = 0;
-    int index       = 0;
-
-    for(auto glyph : uiText_->shapedGlyphs())
-    {
-        if(glyph.codepoint == 0)
-        {
-            currentLine++;
-            if(lineIndex == currentLine)
-            {
-                if((index + 1) < uiText_->shapedGlyphs().size())
-                    return index + 1;
-            }
-        }
-        index++;
-    }
-    return 0;
+    return uiText_->layout().lineFirstGlyph(lineIndex);
 }
 
 void TextBox::createSelectionRectangles(int x, int y)
@@ -416,21 +390,14 @@ void TextBox::createSelectionRectangles(int x, int y)
 
 int TextBox::cursorLinePosition(int index)
 {
-    int line = 0;
-
-    for(int i = 0; i < index; i++)
-    {
-        if(uiText_->shapedGlyphs()[i].codepoint == 0)
-        {
-            line++;
-        }
-    }
-    return line;
+    return uiText_->layout().lineOfGlyph(index);
 }
 
 void TextBox::initializeText()
 {
-    uiText_ = &mRectangle->emplace_back<corgi::ui::Text>(mText.c_str());
+    uiText_ = &mRectangle->emplace_back<corgi::ui::Text>(initialText_);
+    initialText_.clear();
+    initialText_.shrink_to_fit();
     uiText_->setAnchorsToFillParentSpace();
     uiText_->setPropagateEvent(true);
     uiText_->setDepth(0.1f);
@@ -470,10 +437,6 @@ float TextBox::cursorFlashingTime() const noexcept
 
 void TextBox::update(float elapsedTime)
 {
-    bool addedCharacter = false;
-    if(std::string(uiText_->text().c_str()) != mText)
-        uiText_->text(mText.c_str());
-
     if(mFocus)
     {
         mElapsedTimeSinceLastVerticalTick += elapsedTime;
@@ -491,8 +454,6 @@ void TextBox::update(float elapsedTime)
             mElapsedTimeSinceLastVerticalTick = 0.0f;
         }
 
-        bool updateTextMesh = false;
-
         if(Game::instance().inputs().keyboard().key_down(Key::Left))
         {
             cursorIndexPosition_ = corgi::math::clamp(cursorIndexPosition_ - 1, 0,
@@ -503,60 +464,28 @@ void TextBox::update(float elapsedTime)
         {
             cursorIndexPosition_ = corgi::math::clamp(cursorIndexPosition_ + 1, 0,
                                                       uiText_->shapedGlyphs().size());
-            std::cout << uiText_->shapedGlyphs().size() - 1 << std::endl;
         }
 
+        // Every edit only reshapes the line around the cursor, see Text::replaceText
         for(const auto& key : Game::instance().inputs().keyboard().keyPressed())
         {
             int keyCode = static_cast<int>(key);
 
             if(key == corgi::Key::Return)
             {
-                updateTextMesh = true;
-
-                int textOffset = 0;
-
-                if(cursorIndexPosition_ != 0)
-                {
-                    textOffset =
-                        uiText_->shapedGlyphs()[cursorIndexPosition_ - 1].textOffset + 1;
-                }
-                addedCharacter = true;
-                mText.insert(mText.begin() + textOffset, '\n');
+                insertText("\n");
+                continue;
             }
 
             if(key == corgi::Key::Backspace)
             {
-                if(cursorIndexPosition_ > 0)
-                {
-                    std::string s = mText.c_str();
-
-                    auto textOffset =
-                        uiText_->shapedGlyphs()[cursorIndexPosition_ - 1].textOffset;
-
-                    auto charactersSize =
-                        uiText_->shapedGlyphs()[cursorIndexPosition_ - 1]
-                            .characters.size();
-
-                    s.erase(s.begin() + textOffset);
-                    mText          = s.c_str();
-                    updateTextMesh = true;
-
-                    int glyphCount = uiText_->shapedGlyphs().size();
-
-                    setText(mText);
-
-                    cursorIndexPosition_ -= glyphCount - uiText_->shapedGlyphs().size();
-
-                    continue;
-                }
+                eraseBeforeCursor();
+                continue;
             }
 
             if(keyCode == ' ')
             {
-                updateTextMesh = true;
-                mText += " ";
-                cursorIndexPosition_++;
+                insertText(" ");
                 continue;
             }
 
@@ -569,40 +498,18 @@ void TextBox::update(float elapsedTime)
                              static_cast<int>(KeyModifiers::CAPS));
                 auto isInCapMode = (mod & mask) != 0;
 
-                updateTextMesh = true;
-
-                int textOffset = 0;
-
-                if(cursorIndexPosition_ != 0)
-                {
-                    textOffset =
-                        uiText_->shapedGlyphs()[cursorIndexPosition_ - 1].textOffset + 1;
-                }
-
                 if(isInCapMode)
                 {
                     if(keyCode >= 'a' && keyCode <= 'z')
                     {
-                        mText.insert(mText.begin() + textOffset,
-                                     static_cast<char>(key) - 32);
+                        const char character = static_cast<char>(keyCode - 32);
+                        insertText(std::string_view(&character, 1));
                     }
                 }
                 else
-                    mText.insert(mText.begin() + textOffset, static_cast<char>(key));
-
-                addedCharacter = true;
-            }
-
-            if(updateTextMesh)
-            {
-                int glyphCount = uiText_->shapedGlyphs().size();
-
-                setText(mText);
-
-                if(addedCharacter)
                 {
-                    addedCharacter = false;
-                    cursorIndexPosition_ += uiText_->shapedGlyphs().size() - glyphCount;
+                    const char character = static_cast<char>(keyCode);
+                    insertText(std::string_view(&character, 1));
                 }
             }
         }
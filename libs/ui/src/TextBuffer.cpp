@@ -0,0 +1,171 @@
+#include <corgi/ui/TextBuffer.h>
+
+#include <algorithm>
+#include <cstring>
+
+namespace corgi::ui
+{
+
+// Leaving some room when growing, so typing doesn't reallocate the array for
+// every character
+static constexpr std::size_t minimum_gap = 64;
+
+TextBuffer::TextBuffer(std::string_view text)
+{
+    assign(text);
+}
+
+void TextBuffer::assign(std::string_view text)
+{
+    data_.assign(text.begin(), text.end());
+    data_.resize(text.size() + minimum_gap);
+
+    gapStart_ = text.size();
+    gapEnd_   = data_.size();
+
+    lineStarts_.assign(1, 0);
+
+    for(std::size_t i = 0; i < text.size(); i++)
+    {
+        if(text[i] == '\n')
+            lineStarts_.push_back(i + 1);
+    }
+}
+
+void TextBuffer::insert(std::size_t offset, std::string_view text)
+{
+    if(text.empty())
+        return;
+
+    reserveGap(text.size());
+    moveGap(offset);
+
+    std::memcpy(data_.data() + gapStart_, text.data(), text.size());
+    gapStart_ += text.size();
+
+    // Lines after the insertion move by the inserted size, and every inserted
+    // '\n' starts a new line
+    const auto line = lineOf(offset);
+
+    for(auto i = line + 1; i < lineStarts_.size(); i++)
+        lineStarts_[i] += text.size();
+
+    std::vector<std::size_t> newLines;
+
+    for(std::size_t i = 0; i < text.size(); i++)
+    {
+        if(text[i] == '\n')
+            newLines.push_back(offset + i + 1);
+    }
+
+    lineStarts_.insert(lineStarts_.begin() + static_cast<std::ptrdiff_t>(line + 1),
+                       newLines.begin(), newLines.end());
+}
+
+void TextBuffer::erase(std::size_t offset, std::size_t count)
+{
+    count = std::min(count, size() - offset);
+
+    if(count == 0)
+        return;
+
+    moveGap(offset);
+    gapEnd_ += count;
+
+    // The lines starting inside the erased part lost their '\n'
+    const auto first = std::upper_bound(lineStarts_.begin(), lineStarts_.end(), offset);
+    const auto last  = std::upper_bound(first, lineStarts_.end(), offset + count);
+
+    const auto it = lineStarts_.erase(first, last);
+
+    for(auto i = it; i != lineStarts_.end(); ++i)
+        *i -= count;
+}
+
+std::string TextBuffer::str() const
+{
+    std::string text;
+    text.reserve(size());
+    text.append(data_.data(), gapStart_);
+    text.append(data_.data() + gapEnd_, data_.size() - gapEnd_);
+    return text;
+}
+
+std::string TextBuffer::substr(std::size_t offset, std::size_t count) const
+{
+    count = std::min(count, size() - offset);
+
+    std::string text;
+    text.reserve(count);
+
+    // Part before the gap, then part after it
+    if(offset < gapStart_)
+    {
+        const auto before = std::min(count, gapStart_ - offset);
+        text.append(data_.data() + offset, before);
+        offset += before;
+        count -= before;
+    }
+
+    if(count != 0)
+        text.append(data_.data() + offset + gapSize(), count);
+
+    return text;
+}
+
+bool TextBuffer::equals(std::string_view text) const noexcept
+{
+    if(text.size() != size())
+        return false;
+
+    return text.substr(0, gapStart_) == std::string_view(data_.data(), gapStart_) &&
+           text.substr(gapStart_) ==
+               std::string_view(data_.data() + gapEnd_, data_.size() - gapEnd_);
+}
+
+std::size_t TextBuffer::lineOf(std::size_t offset) const noexcept
+{
+    return static_cast<std::size_t>(
+               std::upper_bound(lineStarts_.begin(), lineStarts_.end(), offset) -
+               lineStarts_.begin()) -
+           1;
+}
+
+std::string TextBuffer::line(std::size_t line) const
+{
+    return substr(lineStart(line), lineEnd(line) - lineStart(line));
+}
+
+void TextBuffer::moveGap(std::size_t offset)
+{
+    if(offset < gapStart_)
+    {
+        // The characters between the offset and the gap go after the gap
+        const auto count = gapStart_ - offset;
+        std::memmove(data_.data() + gapEnd_ - count, data_.data() + offset, count);
+        gapStart_ -= count;
+        gapEnd_ -= count;
+    }
+    else if(offset > gapStart_)
+    {
+        const auto count = offset - gapStart_;
+        std::memmove(data_.data() + gapStart_, data_.data() + gapEnd_, count);
+        gapStart_ += count;
+        gapEnd_ += count;
+    }
+}
+
+void TextBuffer::reserveGap(std::size_t count)
+{
+    if(gapSize() >= count)
+        return;
+
+    // Doubling the array keeps the cost of growing constant per character
+    const auto after   = data_.size() - gapEnd_;
+    const auto newSize = std::max(data_.size() * 2, size() + count + minimum_gap);
+
+    data_.resize(newSize);
+    std::memmove(data_.data() + newSize - after, data_.data() + gapEnd_, after);
+    gapEnd_ = newSize - after;
+}
+}    // namespace corgi::ui
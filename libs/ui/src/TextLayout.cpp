@@ -0,0 +1,135 @@
+#include <corgi/ui/TextLayout.h>
+
+#include <algorithm>
+
+namespace corgi::ui
+{
+
+TextLayout::TextLayout(Shaper shaper)
+    : shaper_(std::move(shaper))
+{
+}
+
+void TextLayout::setText(std::string_view text)
+{
+    buffer_.assign(text);
+    reshape();
+}
+
+void TextLayout::reshape()
+{
+    glyphs_.clear();
+    lineGlyphStarts_.clear();
+    shapedCharacters_ = 0;
+
+    for(std::size_t line = 0; line < buffer_.lineCount(); line++)
+    {
+        lineGlyphStarts_.push_back(glyphs_.size());
+        shapeLine(line, glyphs_);
+    }
+}
+
+void TextLayout::replace(std::size_t offset, std::size_t removed, std::string_view inserted)
+{
+    // Glyphs of the lines touched by the edit, before the edit
+    const auto firstLine  = buffer_.lineOf(offset);
+    const auto lastLine   = buffer_.lineOf(offset + removed);
+    const auto firstGlyph = lineGlyphStarts_[firstLine];
+    const auto endGlyph   = lastLine + 1 < lineGlyphStarts_.size() ? lineGlyphStarts_[lastLine + 1]
+                                                                   : glyphs_.size();
+
+    buffer_.erase(offset, removed);
+    buffer_.insert(offset, inserted);
+
+    // Those lines are now the lines between the start and the end of the
+    // inserted text
+    const auto newLastLine = buffer_.lineOf(offset + inserted.size());
+
+    std::vector<corgi::utils::text::ShapedGlyph> glyphs;
+    std::vector<std::size_t>                     lineStarts;
+
+    shapedCharacters_ = 0;
+
+    for(auto line = firstLine; line <= newLastLine; line++)
+    {
+        lineStarts.push_back(firstGlyph + glyphs.size());
+        shapeLine(line, glyphs);
+    }
+
+    const auto glyphCount = static_cast<std::ptrdiff_t>(glyphs.size());
+
+    // The glyphs replacing old ones are assigned in place, so the glyphs of
+    // the following lines only move once
+    const auto oldCount = static_cast<std::ptrdiff_t>(endGlyph - firstGlyph);
+    const auto kept     = std::min(oldCount, glyphCount);
+
+    std::move(glyphs.begin(), glyphs.begin() + kept,
+              glyphs_.begin() + static_cast<std::ptrdiff_t>(firstGlyph));
+
+    if(glyphCount > oldCount)
+        glyphs_.insert(glyphs_.begin() + static_cast<std::ptrdiff_t>(endGlyph),
+                       std::make_move_iterator(glyphs.begin() + kept),
+                       std::make_move_iterator(glyphs.end()));
+    else
+        glyphs_.erase(glyphs_.begin() + static_cast<std::ptrdiff_t>(firstGlyph) + kept,
+                      glyphs_.begin() + static_cast<std::ptrdiff_t>(endGlyph));
+
+    // The following lines aren't reshaped, they only moved
+    const auto offsetDelta = static_cast<int>(inserted.size()) - static_cast<int>(removed);
+    const auto glyphDelta  = glyphCount - oldCount;
+
+    for(auto i = firstGlyph + glyphs.size(); i < glyphs_.size(); i++)
+        glyphs_[i].textOffset += offsetDelta;
+
+    lineGlyphStarts_.erase(lineGlyphStarts_.begin() + static_cast<std::ptrdiff_t>(firstLine),
+                           lineGlyphStarts_.begin() + static_cast<std::ptrdiff_t>(lastLine + 1));
+
+    const auto it =
+        lineGlyphStarts_.insert(lineGlyphStarts_.begin() + static_cast<std::ptrdiff_t>(firstLine),
+                                lineStarts.begin(), lineStarts.end());
+
+    for(auto i = it + static_cast<std::ptrdiff_t>(lineStarts.size()); i != lineGlyphStarts_.end(); ++i)
+        *i = static_cast<std::size_t>(static_cast<std::ptrdiff_t>(*i) + glyphDelta);
+}
+
+int TextLayout::lineEndGlyph(int line) const noexcept
+{
+    // The glyph before the next line is the '\n' of this one
+    if(line + 1 < lineCount())
+        return static_cast<int>(lineGlyphStarts_[line + 1]) - 1;
+
+    return static_cast<int>(glyphs_.size());
+}
+
+int TextLayout::lineOfGlyph(int glyphIndex) const noexcept
+{
+    const auto it = std::upper_bound(lineGlyphStarts_.begin(), lineGlyphStarts_.end(),
+                                     static_cast<std::size_t>(std::max(glyphIndex, 0)));
+
+    return static_cast<int>(it - lineGlyphStarts_.begin()) - 1;
+}
+
+void TextLayout::shapeLine(std::size_t line, std::vector<corgi::utils::text::ShapedGlyph>& glyphs)
+{
+    const auto start = buffer_.lineStart(line);
+    const auto end   = buffer_.lineEnd(line);
+    const auto text  = buffer_.substr(start, end - start);
+
+    auto shaped = shaper_(text, static_cast<int>(start));
+
+    glyphs.insert(glyphs.end(), std::make_move_iterator(shaped.begin()),
+                  std::make_move_iterator(shaped.end()));
+
+    shapedCharacters_ += text.size();
+
+    if(line + 1 == buffer_.lineCount())
+        return;
+
+    corgi::utils::text::ShapedGlyph newLine {};
+    newLine.codepoint  = 0;
+    newLine.cluster    = static_cast<unsigned>(text.size());
+    newLine.characters = {'\n'};
+    newLine.textOffset = static_cast<int>(end);
+    glyphs.push_back(std::move(newLine));
+}
+}    // namespace corgi::ui
@@ -7,7 +7,7 @@
 #include <corgi/ui/SimpleButton.h>
 #include <corgi/ui/dialogs/FileDialog.h>
 #include <corgi/ui/layouts/FlowLayout.h>
-#include <corgi/ui/layouts/VerticalLayout.h>
+#include <corgi/ui/layouts/VirtualLayout.h>
 #include <corgi/utils/ResourcesCache.h>
 
 using namespace corgi::ui;
@@ -24,33 +24,50 @@ const corgi::filesystem::FileInfo& FileItem::fileInfo() const noexcept
 
 void FileItem::initIcon()
 {
-    auto icon = textBackground_->emplaceBack<ui::Image>();
+    icon_ = textBackground_->emplaceBack<ui::Image>();
 
     textBackground_->set_name("FileItemBackground");
-    icon->setDimensions(16, 16);
-    icon->setLeft(10);
-    icon->setTop(7);
-
-    if(fileInfo_.is_folder())
-        icon->setImage(ResourcesCache::get<Texture>("Folder.tex"));
-    else
-        icon->setImage(ResourcesCache::get<Texture>("FileIcon.tex"));
+    icon_->setDimensions(16, 16);
+    icon_->setLeft(10);
+    icon_->setTop(7);
 }
 
-void FileItem::init()
+void FileItem::setFileInfo(const corgi::filesystem::FileInfo& fileInfo)
 {
-    textBackground_ = emplaceBack<ui::Rectangle>();
+    fileInfo_ = fileInfo;
 
     // We add the folder Icon in case we're dealing with a folder
     try
     {
-        initIcon();
+        if(fileInfo_.is_folder())
+            icon_->setImage(ResourcesCache::get<Texture>("Folder.tex"));
+        else
+            icon_->setImage(ResourcesCache::get<Texture>("FileIcon.tex"));
     }
     catch(std::exception e)
     {
         std::cout << e.what() << std::endl;
     }
 
+    text_->setText(fileInfo_.name().c_str());
+}
+
+void FileItem::setSelected(bool selected)
+{
+    isItemSelected_ = selected;
+
+    if(isItemSelected_)
+        textBackground_->setColor(Color(150, 150, 200));
+    else
+        textBackground_->setColor(Color(50, 50, 60));
+}
+
+void FileItem::init()
+{
+    textBackground_ = emplaceBack<ui::Rectangle>();
+
+    initIcon();
+
     textBackground_->setColor(Color(50, 50, 60));
 
     textBackground_->onMouseEnter() += [=, this](int, int)
@@ -67,13 +84,14 @@ void FileItem::init()
 
     textBackground_->setAnchorsToFillParentSpace();
 
-    auto text = textBackground_->emplaceBack<ui::Text>();
+    text_ = textBackground_->emplaceBack<ui::Text>();
 
-    text->setAnchorsToFillParentSpace();
-    text->setText(fileInfo_.name().c_str());
-    text->setHorizontalAlignment(corgi::HorizontalAlignment::Left);
-    text->setColor(Color(215, 215, 215));
-    text->setLeft(36);
+    text_->setAnchorsToFillParentSpace();
+    text_->setHorizontalAlignment(corgi::HorizontalAlignment::Left);
+    text_->setColor(Color(215, 215, 215));
+    text_->setLeft(36);
+
+    setFileInfo(fileInfo_);
 }
 
 void FileDialog::initFiles(const std::string& rootFolder)
@@ -85,54 +103,66 @@ void FileDialog::initFiles(const std::string& rootFolder)
 
     auto files = filesystem::list_directory(rootFolder);
 
-    std::vector<filesystem::FileInfo> fileInfos;
+    files_.clear();
 
     for(auto file : files)
     {
-        fileInfos.push_back(file);
+        files_.push_back(file);
     }
 
-    std::sort(fileInfos.begin(), fileInfos.end());
+    std::sort(files_.begin(), files_.end());
 
-    for(auto file : fileInfos)
-    {
-        auto fileItem = flowLayout_->emplaceBack<FileItem>(file);
-        fileItem->setHeight(30);
-        fileItem->setLeft(0);
-        fileItem->setRight(0);
+    selectedIndex_ = -1;
+    okButton_->deactivate();
+
+    // The layout only creates FileItems for the files currently visible
+    // in the scrollview, so big folders stay cheap to display
+    flowLayout_->setItemCount(static_cast<int>(files_.size()));
+    flowLayout_->invalidate();
+}
+
+void FileDialog::initFileItems()
+{
+    flowLayout_->setItemHeight(30);
 
-        fileItem->onMouseClick() += [&, fileItem](int, int)
+    flowLayout_->setItemFactory(
+        [&](VirtualLayout& layout) -> Widget*
         {
-            if(selectedItem_ != fileItem)
+            auto fileItem = layout.emplaceBack<FileItem>(files_.front());
+            fileItem->setLeft(0);
+            fileItem->setRight(0);
+
+            fileItem->onMouseClick() += [&, fileItem](int, int)
             {
-                if(selectedItem_ != nullptr)
-                {
-                    selectedItem_->isItemSelected_ = false;
-                    dynamic_cast<ui::Rectangle*>(
-                        selectedItem_->find("FileItemBackground"))
-                        ->setColor(Color(50, 50, 60));
-                }
+                const int index = flowLayout_->itemIndex(fileItem);
+
+                if(index == -1 || index == selectedIndex_)
+                    return;
+
+                if(auto* previous = flowLayout_->itemWidget(selectedIndex_))
+                    dynamic_cast<FileItem*>(previous)->setSelected(false);
 
                 okButton_->activate();
-                selectedItem_ = fileItem;
+                selectedIndex_ = index;
+                fileItem->setSelected(true);
+            };
+
+            fileItem->mouseDoubleClickEvent() += [&, fileItem](int, int)
+            {
+                if(fileItem->fileInfo().is_folder())
+                    initFiles(fileItem->fileInfo().path() + "/");
+            };
 
-                fileItem->isItemSelected_ = true;
-                dynamic_cast<ui::Rectangle*>(fileItem->find("FileItemBackground"))
-                    ->setColor(Color(150, 150, 200));
-            }
-        };
+            return fileItem;
+        });
 
-        fileItem->mouseDoubleClickEvent() += [=](int, int)
+    flowLayout_->setItemBinder(
+        [&](Widget& widget, int index)
         {
-            if(file.is_folder())
-            {
-                flowLayout_->clearChildren();
-                initFiles(file.path() + "/");
-                selectedItem_ = nullptr;
-                okButton_->deactivate();
-            }
-        };
-    }
+            auto& fileItem = dynamic_cast<FileItem&>(widget);
+            fileItem.setFileInfo(files_[index]);
+            fileItem.setSelected(index == selectedIndex_);
+        });
 }
 
 FileDialog::FileDialog(const std::string& folder, StyleSheet& styleSheet)
@@ -179,9 +209,9 @@ void FileDialog::initOkButton()
 
     okButton_->onMouseClick() += [&](int x, int y)
     {
-        if(selectedItem_ != nullptr)
+        if(selectedIndex_ != -1)
         {
-            onFileSelection_(selectedItem_->fileInfo().path());
+            onFileSelection_(files_[selectedIndex_].path());
         }
         parent()->destroy();
     };
@@ -221,9 +251,6 @@ void FileDialog::init()
     {
         auto parentFolder = filesystem::getParentFolder(currentFolder.c_str());
         parentFolder += "/";
-        selectedItem_ = nullptr;
-        okButton_->deactivate();
-        flowLayout_->clearChildren();
 
         initFiles(parentFolder.c_str());
     };
@@ -258,9 +285,10 @@ void FileDialog::init()
     scrollView->setRight(10);
     scrollView->setBottom(0);
 
-    flowLayout_ = scrollView->content()->emplaceBack<ui::VerticalLayout>();
+    flowLayout_ = scrollView->content()->emplaceBack<ui::VirtualLayout>();
     flowLayout_->setAnchorsToFillParentSpace();
 
-    initFiles(currentFolder);
     initButtons();
+    initFileItems();
+    initFiles(currentFolder);
 }
@@ -0,0 +1,350 @@
+#include <corgi/ui/layouts/VirtualLayout.h>
+
+#include <algorithm>
+#include <cmath>
+
+using namespace corgi::ui;
+
+void VirtualLayout::setMode(Mode mode)
+{
+    mMode        = mode;
+    mLayoutDirty = true;
+}
+
+void VirtualLayout::setItemCount(int count)
+{
+    mItemCount = std::max(0, count);
+    updateOffsets();
+    mRebindAll = true;
+}
+
+void VirtualLayout::setItemFactory(ItemFactory factory)
+{
+    mItemFactory = std::move(factory);
+}
+
+void VirtualLayout::setItemBinder(ItemBinder binder)
+{
+    mItemBinder = std::move(binder);
+    mRebindAll  = true;
+}
+
+void VirtualLayout::setItemMeasure(ItemMeasure measure)
+{
+    mItemMeasure = std::move(measure);
+    updateOffsets();
+    mLayoutDirty = true;
+}
+
+void VirtualLayout::setItemHeight(float itemHeight)
+{
+    mItemHeight = itemHeight;
+    updateOffsets();
+    mLayoutDirty = true;
+}
+
+void VirtualLayout::setItemWidth(float itemWidth)
+{
+    mItemWidth   = itemWidth;
+    mLayoutDirty = true;
+}
+
+void VirtualLayout::setSpacing(float spacing)
+{
+    mSpacing = spacing;
+    updateOffsets();
+    mLayoutDirty = true;
+}
+
+void VirtualLayout::setOverscan(int overscan)
+{
+    mOverscan = std::max(0, overscan);
+}
+
+void VirtualLayout::invalidateItem(int index)
+{
+    if(index < 0 || index >= mItemCount)
+        return;
+
+    // Only the items after the invalidated one can move
+    updateOffsets(index);
+    mLayoutDirty = true;
+
+    if(auto* widget = itemWidget(index); widget && mItemBinder)
+        mItemBinder(*widget, index);
+}
+
+void VirtualLayout::invalidate()
+{
+    updateOffsets();
+    mRebindAll = true;
+}
+
+VirtualLayout::Mode VirtualLayout::getMode() const noexcept
+{
+    return mMode;
+}
+
+int VirtualLayout::getItemCount() const noexcept
+{
+    return mItemCount;
+}
+
+float VirtualLayout::getItemHeight() const noexcept
+{
+    return mItemHeight;
+}
+
+float VirtualLayout::getItemWidth() const noexcept
+{
+    return mItemWidth;
+}
+
+float VirtualLayout::getSpacing() const noexcept
+{
+    return mSpacing;
+}
+
+int VirtualLayout::getOverscan() const noexcept
+{
+    return mOverscan;
+}
+
+int VirtualLayout::materializedCount() const noexcept
+{
+    return static_cast<int>(mSlots.size());
+}
+
+Widget* VirtualLayout::itemWidget(int index) const noexcept
+{
+    // Slots are sorted by index
+    auto it = std::lower_bound(mSlots.begin(), mSlots.end(), index,
+                               [](const Slot& slot, int i) { return slot.index < i; });
+
+    if(it == mSlots.end() || it->index != index)
+        return nullptr;
+    return it->widget;
+}
+
+int VirtualLayout::itemIndex(const Widget* widget) const noexcept
+{
+    for(const auto& slot : mSlots)
+        if(slot.widget == widget)
+            return slot.index;
+    return -1;
+}
+
+int VirtualLayout::getCountColumns() const noexcept
+{
+    if(mMode == Mode::List)
+        return 1;
+
+    const auto columns = static_cast<int>((width() - mSpacing) / (mItemWidth + mSpacing));
+    return std::max(1, columns);
+}
+
+void VirtualLayout::updateOffsets(int from)
+{
+    mOffsets.resize(mItemCount + 1);
+
+    if(from == 0)
+        mOffsets[0] = mSpacing;
+
+    for(int i = from; i < mItemCount; ++i)
+    {
+        const float itemHeight = mItemMeasure ? mItemMeasure(i) : mItemHeight;
+        mOffsets[i + 1]        = mOffsets[i] + itemHeight + mSpacing;
+    }
+}
+
+float VirtualLayout::itemOffset(int index) const noexcept
+{
+    if(mMode == Mode::List)
+        return mOffsets[std::clamp(index, 0, mItemCount)];
+
+    const int row = index / getCountColumns();
+    return mSpacing + static_cast<float>(row) * (mItemHeight + mSpacing);
+}
+
+int VirtualLayout::itemAt(float y) const noexcept
+{
+    if(mMode != Mode::List || mItemCount == 0)
+        return -1;
+
+    const auto it    = std::upper_bound(mOffsets.begin(), mOffsets.end(), y);
+    const auto index = static_cast<int>(it - mOffsets.begin()) - 1;
+
+    if(index < 0 || index >= mItemCount)
+        return -1;
+    return index;
+}
+
+float VirtualLayout::height() const noexcept
+{
+    switch(mMode)
+    {
+        case Mode::List:
+            return mOffsets.back();
+
+        case Mode::Grid:
+        {
+            const int columns = getCountColumns();
+            const int rows    = (mItemCount + columns - 1) / columns;
+            return static_cast<float>(rows) * mItemHeight +
+                   static_cast<float>(rows + 1) * mSpacing;
+        }
+    }
+    return 0.0f;
+}
+
+void VirtualLayout::visibleRange(int& first, int& last) const
+{
+    first = 0;
+    last  = mItemCount;
+
+    const auto* viewport = findViewport();
+
+    if(viewport == nullptr)
+        return;
+
+    // Visible area in the layout's coordinates
+    const float top    = viewport->real_y() - real_y();
+    const float bottom = top + viewport->height();
+
+    switch(mMode)
+    {
+        case Mode::List:
+        {
+            // First item whose bottom is below the top of the viewport
+            first = static_cast<int>(
+                std::upper_bound(mOffsets.begin() + 1, mOffsets.end(), top) -
+                (mOffsets.begin() + 1));
+
+            // First item whose top is below the bottom of the viewport
+            last = static_cast<int>(
+                std::lower_bound(mOffsets.begin(), mOffsets.end() - 1, bottom) -
+                mOffsets.begin());
+
+            first -= mOverscan;
+            last += mOverscan;
+            break;
+        }
+        case Mode::Grid:
+        {
+            const int   columns = getCountColumns();
+            const float pitch   = mItemHeight + mSpacing;
+
+            const auto firstRow = static_cast<int>(std::floor((top - mSpacing) / pitch));
+            const auto lastRow  = static_cast<int>(std::ceil(bottom / pitch));
+
+            first = (firstRow - mOverscan) * columns;
+            last  = (lastRow + mOverscan) * columns;
+            break;
+        }
+    }
+
+    first = std::clamp(first, 0, mItemCount);
+    last  = std::clamp(last, first, mItemCount);
+}
+
+void VirtualLayout::placeItem(Widget& widget, int index)
+{
+    switch(mMode)
+    {
+        case Mode::List:
+            widget.y(mOffsets[index]);
+            widget.setHeight(mOffsets[index + 1] - mOffsets[index] - mSpacing);
+            break;
+
+        case Mode::Grid:
+        {
+            const int columns = getCountColumns();
+            const int column  = index % columns;
+            const int row     = index / columns;
+
+            widget.x(mSpacing + static_cast<float>(column) * (mItemWidth + mSpacing));
+            widget.y(mSpacing + static_cast<float>(row) * (mItemHeight + mSpacing));
+            widget.setWidth(mItemWidth);
+            widget.setHeight(mItemHeight);
+            break;
+        }
+    }
+}
+
+void VirtualLayout::paint(Renderer& renderer)
+{
+    if(!mItemFactory)
+        return;
+
+    // In Grid mode a width change can change the column count, and so
+    // the position of every item
+    const int columns = getCountColumns();
+
+    if(columns != mPreviousColumns)
+    {
+        mPreviousColumns = columns;
+        mLayoutDirty     = true;
+    }
+
+    int first;
+    int last;
+    visibleRange(first, last);
+
+    // We recycle the widgets whose item isn't visible anymore
+    mNextSlots.clear();
+
+    for(const auto& slot : mSlots)
+    {
+        if(slot.index >= first && slot.index < last)
+        {
+            mNextSlots.push_back(slot);
+        }
+        else
+        {
+            slot.widget->disable();
+            mPool.push_back(slot.widget);
+        }
+    }
+
+    mSlots.clear();
+
+    auto kept = mNextSlots.begin();
+
+    for(int index = first; index < last; ++index)
+    {
+        // The item was already bound during a previous frame
+        if(kept != mNextSlots.end() && kept->index == index)
+        {
+            if(mRebindAll && mItemBinder)
+                mItemBinder(*kept->widget, index);
+
+            if(mRebindAll || mLayoutDirty)
+                placeItem(*kept->widget, index);
+
+            mSlots.push_back(*kept++);
+            continue;
+        }
+
+        Widget* widget = nullptr;
+
+        if(!mPool.empty())
+        {
+            widget = mPool.back();
+            mPool.pop_back();
+            widget->enable();
+        }
+        else
+        {
+            widget = mItemFactory(*this);
+        }
+
+        if(mItemBinder)
+            mItemBinder(*widget, index);
+
+        placeItem(*widget, index);
+        mSlots.push_back({widget, index});
+    }
+
+    mRebindAll   = false;
+    mLayoutDirty = false;
+}
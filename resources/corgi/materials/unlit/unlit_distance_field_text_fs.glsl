@@ -0,0 +1,35 @@
+#version 330 core
+
+in vec2 uv;
+
+uniform sampler2D	main_texture;
+uniform vec4 flat_color;
+uniform int use_flat_color;
+uniform float alpha;
+
+out vec4 color;
+
+
+void main()
+{
+	// The red channel stores the distance to the glyph's outline, 0.5 being
+	// on the outline. Smoothing over the distance covered by one screen pixel
+	// keeps the edges sharp at any size
+	float distance	= texture( main_texture, uv ).r;
+	float width		= fwidth(distance) * 0.7;
+	float coverage	= smoothstep(0.5 - width, 0.5 + width, distance);
+
+	// We discard fragments that are totally transparent
+	if(coverage==0.0)
+		discard;
+
+	if(use_flat_color ==1 )
+	{
+		color	= flat_color;
+		color.a	= coverage*flat_color.a;
+	}
+	else
+	{
+		color	= vec4(1.0, 1.0, 1.0, coverage*alpha);
+	}
+}
\ No newline at end of file
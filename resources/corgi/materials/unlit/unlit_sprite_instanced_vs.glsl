@@ -0,0 +1,30 @@
+#version 330 core
+
+layout(location = 0) in vec3 position;
+layout(location = 1) in vec2 texture_coordinates;
+
+// Per instance attributes, see corgi::SpriteInstance
+
+layout(location = 2) in mat4 world_matrix;
+layout(location = 6) in vec4 uv_rect;	// offset_u, offset_v, width_u, height_v
+layout(location = 7) in vec4 quad;		// width, height, pivot_x, pivot_y
+layout(location = 8) in vec4 tint;
+
+out vec2 uv;
+out vec4 sprite_tint;
+
+// Only holds the view projection matrix, the model matrix comes from the instance
+uniform mat4 mvp_matrix;
+
+void main()
+{
+	vec3 pos = vec3(position);
+
+	pos.x = pos.x * quad.x / 2.0 + (quad.z - 0.5) * quad.x;
+	pos.y = pos.y * quad.y / 2.0 - (quad.w - 0.5) * quad.y;
+
+	gl_Position = mvp_matrix * world_matrix * vec4(pos, 1.0);
+
+	uv			= uv_rect.xy + texture_coordinates * uv_rect.zw;
+	sprite_tint	= tint;
+}
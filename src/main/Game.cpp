@@ -5,8 +5,12 @@
 #include <corgi/main/Game.h>
 #include <corgi/main/Settings.h>
 #include <corgi/main/Window.h>
+#include <corgi/profiler/Profiler.h>
+#include <corgi/rendering/TextureUploader.h>
 #include <corgi/systems/SpriteRendererSystem.h>
 #include <corgi/ui/UiUtils.h>
+#include <corgi/utils/ComponentSerializers.h>
+#include <corgi/utils/ResourcesCache.h>
 #include <corgi/utils/TimeHelper.h>
 
 namespace corgi
@@ -18,6 +22,7 @@ Game::Game()
             "One Game object was already initialized, there can be only one");
     instance_ = this;
     settings_.initialize("resources/Settings.ini");
+    register_component_serializers();
 }
 
 Game::Game(const std::string& project_resource_directory,
@@ -37,6 +42,8 @@ Game::~Game()
 {
     SpriteRendererSystem::release_sprite_mesh();
     UiUtils::release_nineslice_mesh();
+    TextureUploader::release();
+    renderer_.release();
 }
 
 Window* Game::find_window(unsigned int window_id)
@@ -389,6 +396,10 @@ void Game::run()
 
     while(!quit_)
     {
+        // Resources changed on the disk are swapped in between two frames,
+        // see ResourcesCache::watch
+        ResourcesCache::apply_reloads();
+
         inputs_.update();
         inputs_.keyboard_.mKeyModifiers = SDL_GetModState();
         poll_events();
@@ -396,9 +407,13 @@ void Game::run()
         profiler_.update();
         time_.update();
 
+        // Includes the time spent waiting for the frame limiter
+        profiler_.frame_times_.add(time_.elapsed_time());
+
         // I probably need a time for each window no?
         while(time_.timestep_overrun())
         {
+            CORGI_PROFILE_ZONE("Game::update");
             profiler_.update_counter_.start();
 
             renderer().windowDrawList().clear();
@@ -414,6 +429,8 @@ void Game::run()
             profiler_.update_counter_.tick();
         }
 
+        renderer_.interpolation_alpha(time_.alpha());
+
         for(auto& window : windows_)
         {
             current_window_ = window.get();
@@ -426,12 +443,22 @@ void Game::run()
 
             // Not sure if I should pack swap_buffer with it or not
             profiler_.renderer_counter_.start();
-            renderer().draw_scene(*window.get());
+            {
+                CORGI_PROFILE_ZONE("Game::render");
+                renderer().draw_scene(*window.get());
+            }
             profiler_.renderer_counter_.tick();
 
             window->swap_buffers();
             profiler_.loop_counter_.tick();
         }
+
+        {
+            CORGI_PROFILE_ZONE("Game::frame_limiter");
+            frame_limiter_.wait();
+        }
+
+        CORGI_PROFILE_FRAME();
     }
 
     // Clearing resources when exiting the main loop
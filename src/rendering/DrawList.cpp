@@ -6,6 +6,8 @@
 #include <corgi/resources/Font.h>
 #include <corgi/utils/ResourcesCache.h>
 
+#include <algorithm>
+
 using namespace corgi;
 
 void DrawList::add_nine_slice(NineSlice nine_slice)
@@ -49,6 +51,23 @@ void DrawList::add(Text text)
     texts_.push_back(text);
 }
 
+void DrawList::add_text(const Text&     text,
+                        const Matrix&   model_matrix,
+                        const Material& material,
+                        Window*         window)
+{
+    // Every quad of the shared buffer is indexed the same way, so a text is
+    // drawn from the indexes of its first quad
+    const auto first_quad = text_vertices_.size() / 20;
+    const auto quads      = text.vertices.size() / 20;
+
+    order_.push_back({DrawListType::SharedText, shared_texts_.size()});
+    shared_texts_.emplace_back(SharedTextToRender {material, model_matrix, first_quad * 6,
+                                                   static_cast<int>(quads * 6), window});
+
+    text_vertices_.insert(text_vertices_.end(), text.vertices.begin(), text.vertices.end());
+}
+
 void DrawList::add_rectangle(
     float x, float y, float width, float height, float r, float g, float b, float a)
 {
@@ -157,7 +176,7 @@ Vector<int> DrawList::Text::charactersWidth(const std::string& text) const
 
     for(auto shapedGlyph : shapedGlyphs_)
     {
-        widths.push_back(static_cast<int>(shapedGlyph.advance.x));
+        widths.push_back(static_cast<int>(shapedGlyph.advance.x * font.scale()));
     }
 
     return widths;
@@ -172,10 +191,119 @@ float DrawList::Text::textWidth(const std::string& text) const
         width += shapedGlyph.advance.x;
     }
 
-    return static_cast<float>(width);
+    return static_cast<float>(width) * font.scale();
+}
+
+void DrawList::Text::append_quad_indexes(std::vector<unsigned>& indexes,
+                                         std::size_t            quad_count)
+{
+    indexes.reserve(quad_count * 6);
+
+    for(auto i = static_cast<unsigned>(indexes.size() / 6); i < quad_count; i++)
+        indexes.insert(indexes.end(),
+                       {i * 4 + 0, i * 4 + 1, i * 4 + 2, i * 4 + 0, i * 4 + 2, i * 4 + 3});
+}
+
+std::size_t DrawList::Text::grown_quad_capacity(std::size_t quad_count) noexcept
+{
+    return std::max<std::size_t>(quad_count * 2, 16);
+}
+
+std::pair<std::size_t, std::size_t>
+DrawList::Text::changed_range(const std::vector<float>& before, const std::vector<float>& after)
+{
+    const auto common = std::min(before.size(), after.size());
+
+    std::size_t first = 0;
+
+    while(first < common && before[first] == after[first])
+        first++;
+
+    // When the size changed, everything after the first difference moved
+    std::size_t last = after.size();
+
+    if(before.size() == after.size())
+    {
+        while(last > first && before[last - 1] == after[last - 1])
+            last--;
+    }
+
+    return {first, last - first};
 }
 
 void DrawList::Text::update()
+{
+    build_vertices();
+
+    switch(mesh_mode)
+    {
+        case MeshMode::Rebuild:
+        {
+            std::vector<unsigned> indexes;
+            append_quad_indexes(indexes, vertices.size() / 20);
+
+            mesh = Mesh::new_standard_2D_mesh(std::move(vertices), std::move(indexes));
+            vertices.clear();
+            break;
+        }
+
+        case MeshMode::Incremental:
+            upload_changed_quads();
+            break;
+
+        case MeshMode::Shared:
+            // Uploaded with the others by the DrawList
+            mesh.reset();
+            break;
+    }
+}
+
+void DrawList::Text::upload_changed_quads()
+{
+    const auto quads = vertices.size() / 20;
+
+    if(!mesh || mesh->vertex_capacity() < vertices.size())
+    {
+        const auto capacity = grown_quad_capacity(quads);
+
+        if(!mesh)
+            mesh = Mesh::new_standard_2D_mesh();
+
+        mesh->vertices() = vertices;
+
+        // The quads past the text are indexed too, so the text can grow
+        // without uploading indexes again
+        auto& indexes = mesh->indexes();
+        indexes.clear();
+        append_quad_indexes(indexes, capacity);
+
+        mesh->reserve(capacity * 20, capacity * 6);
+        indexes.resize(quads * 6);
+        return;
+    }
+
+    auto& current = mesh->vertices();
+
+    const auto [first, count] = changed_range(current, vertices);
+
+    current.resize(vertices.size());
+    std::copy(vertices.begin() + static_cast<std::ptrdiff_t>(first),
+              vertices.begin() + static_cast<std::ptrdiff_t>(first + count),
+              current.begin() + static_cast<std::ptrdiff_t>(first));
+
+    mesh->update_vertices(first, count);
+
+    // Only the CPU side changes, the buffer already holds the indexes of
+    // every quad it has room for
+    auto& indexes = mesh->indexes();
+
+    if(indexes.size() < quads * 6)
+        append_quad_indexes(indexes, quads);
+    else
+        indexes.resize(quads * 6);
+}
+
+void DrawList::Text::build_vertices()
 {
     // This variable mostly use in case I want an easy way to flip the v from uv coordinates
     // because of the fact that screen UI elements are inverted on the y axis
@@ -190,6 +318,10 @@ void DrawList::Text::update()
 
     auto descent = static_cast<float>(font.descent());
 
+    // Distance field glyphs are stored at a reference size and scaled to the
+    // requested one
+    const float font_scale = font.scale();
+
     double real_advance_x = 0.0;
 
     text_real_width = 0;
@@ -197,21 +329,9 @@ void DrawList::Text::update()
     lines_width.clear();
     std::vector<int> lines_characters;
 
-    // Here we're simply initializing the mesh data
-    std::vector<float>    vertices(5 * 4 * (shapedGlyphs_.size()), 0.0f);
-    std::vector<unsigned> indexes(shapedGlyphs_.size() * 6);
-
-    // Preparing the quads indexes
-    for(int i = 0; i < shapedGlyphs_.size(); i++)
-    {
-        indexes[i * 6 + 0] = (i * 4) + 0;
-        indexes[i * 6 + 1] = (i * 4) + 1;
-        indexes[i * 6 + 2] = (i * 4) + 2;
-
-        indexes[i * 6 + 3] = (i * 4) + 0;
-        indexes[i * 6 + 4] = (i * 4) + 2;
-        indexes[i * 6 + 5] = (i * 4) + 3;
-    }
+    // Here we're simply initializing the mesh data. The vector keeps its
+    // capacity from the previous update
+    vertices.assign(5 * 4 * (shapedGlyphs_.size()), 0.0f);
 
     Vec3 offset(position.x, position.y);
     // Selected the closest configuration according to the ViewFont parameter
@@ -274,36 +394,31 @@ void DrawList::Text::update()
 
         if(i == 0)
         {
-            if(text_max_height < ci.bitmap_top)
+            if(text_max_height < ci.bitmap_top * font_scale)
             {
-                text_max_height = ci.bitmap_top;
+                text_max_height = ci.bitmap_top * font_scale;
             }
         }
 
-        float vvv = baseline - (ci.glyph_height - ci.bitmap_top);
+        float vvv = baseline - (ci.glyph_height - ci.bitmap_top) * font_scale;
 
         if(text_min_height > vvv)
             text_min_height = vvv;
 
-        float v  = (texture_height - ci.glyph_height) / texture_height;
-        float aa = ci.glyph_width / texture_width;
+        // Glyphs are stored upside down, their top row being ty below the
+        // top of the texture
+        const float v_top = 1.0f - ci.ty;
+        float       v     = v_top - ci.glyph_height / texture_height;
+        float       aa    = ci.glyph_width / texture_width;
 
-        const float glyph_x_offset = ci.bearing_x;
+        const float glyph_x_offset = ci.bearing_x * font_scale;
         const float glpyh_y_offset =
-            -(ci.glyph_height * scaling - ci.bitmap_top * scaling);
-        const float glyph_width  = ci.glyph_width * scaling;
-        const float glyph_height = ci.glyph_height * scaling;    // abusing a bit here
+            -(ci.glyph_height * scaling - ci.bitmap_top * scaling) * font_scale;
+        const float glyph_width  = ci.glyph_width * scaling * font_scale;
+        const float glyph_height = ci.glyph_height * scaling * font_scale;    // abusing a bit here
 
         int ii = i * 20;
 
-        //std::cout << "OffsetX " << offset.x << std::endl;
-        std::cout << "text_real_width " << text_real_width << std::endl;
-        std::cout << "real_advance_x " << real_advance_x << std::endl;
-        //std::cout << "glyph_x_offset " << glyph_x_offset << std::endl;
-        std::cout << "glyph_width " << glyph_width << std::endl;
-        //std::cout << "ax " << ci.ax << std::endl;
-        std::cout << "glyph " << shapedGlyphs_[i].characters.front() << std::endl;
-
         // TODO : Check to make this works both in world space and screen space.
         // Probably juste have to change the sign of y depending on which space we are
         vertices[ii + 0] = offset.x + text_real_width + glyph_x_offset;
@@ -322,15 +437,15 @@ void DrawList::Text::update()
         vertices[ii + 11] = offset.y - glpyh_y_offset - glyph_height;
         vertices[ii + 12] = offset.z;
         vertices[ii + 13] = ci.tx + aa;
-        vertices[ii + 14] = 1.0f;
+        vertices[ii + 14] = v_top;
 
         vertices[ii + 15] = offset.x + text_real_width + glyph_x_offset;
         vertices[ii + 16] = offset.y - glpyh_y_offset - glyph_height;
         vertices[ii + 17] = offset.z;
         vertices[ii + 18] = ci.tx;
-        vertices[ii + 19] = 1.0f;
+        vertices[ii + 19] = v_top;
 
-        real_advance_x += shapedGlyphs_[i].advance.x;
+        real_advance_x += shapedGlyphs_[i].advance.x * font_scale;
 
         // Todo : I'm not exactly sure what's the best way to handle this here
         // because I usually have non integer value, which means : problems
@@ -441,7 +556,6 @@ void DrawList::Text::update()
         current_character += lines_characters[current_line];
         current_line++;
     }
-    mesh = Mesh::new_standard_2D_mesh(std::move(vertices), std::move(indexes));
 }
 
 void DrawList::clear()
@@ -452,4 +566,6 @@ void DrawList::clear()
     texts_.clear();
     order_.clear();
     _meshes.clear();
+    text_vertices_.clear();
+    shared_texts_.clear();
 }
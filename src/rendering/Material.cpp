@@ -1,14 +1,16 @@
 #include <corgi/filesystem/FileSystem.h>
+#include <corgi/filesystem/VirtualFileSystem.h>
+#include <corgi/logger/log.h>
 #include <corgi/rendering/Material.h>
 #include <corgi/rendering/RenderCommand.h>
 #include <corgi/resources/Shader.h>
 #include <corgi/utils/ResourcesCache.h>
 #include <glad/glad.h>
 #include <rapidjson/document.h>
-#include <rapidjson/filereadstream.h>
 #include <rapidjson/rapidjson.h>
 
 #include <fstream>
+#include <iterator>
 
 namespace corgi
 {
@@ -602,24 +604,24 @@ void Material::stencil_op(StencilOp value)
 
 Material::Material(const std::string& path, const std::string& relative_name)
 {
-    std::ifstream file(path.c_str(), std::ifstream::in | std::ifstream::binary);
+    std::ifstream     file(path, std::ifstream::binary);
+    const std::string json((std::istreambuf_iterator<char>(file)),
+                           std::istreambuf_iterator<char>());
 
-    int fileSize = 0;
-
-    if(file.is_open())
-    {
-        file.seekg(0, std::ios::end);
-        fileSize = int(file.tellg());
-        file.close();
-    }
+    load(relative_name, json);
+}
 
-    FILE* fp = fopen(path.c_str(), "rb");    // non-Windows use "r"
+Material::Material(const filesystem::VirtualFileSystem& vfs, const std::string& identifier)
+{
+    const auto json = vfs.read(identifier);
 
-    auto* readBuffer = new char[fileSize];
+    load(identifier, {reinterpret_cast<const char*>(json.data()), json.size()});
+}
 
-    rapidjson::FileReadStream is(fp, readBuffer, sizeof(readBuffer));
-    rapidjson::Document       document;
-    document.ParseStream(is);
+void Material::load(const std::string& identifier, std::string_view json)
+{
+    rapidjson::Document document;
+    document.Parse(json.data(), json.size());
 
     // Not optional
     assert(document.HasMember("vertex_shader"));
@@ -631,13 +633,16 @@ Material::Material(const std::string& path, const std::string& relative_name)
     auto vertex_shader   = ResourcesCache::get<Shader>(vertex_shader_path);
     auto fragment_shader = ResourcesCache::get<Shader>(fragment_shader_path);
 
-    auto program = generate_program(filesystem::filename(path.c_str()).c_str(),
+    ResourcesCache::add_dependency(identifier, vertex_shader_path);
+    ResourcesCache::add_dependency(identifier, fragment_shader_path);
+
+    auto program = generate_program(filesystem::filename(identifier.c_str()).c_str(),
                                     vertex_shader, fragment_shader);
 
     location_model_view_projection_matrix =
         glGetUniformLocation(program->id_, "mvp_matrix");
 
-    auto strr = filesystem::filename(path.c_str());
+    auto strr = filesystem::filename(identifier.c_str());
 
     name_          = strr.c_str();
     shader_program = program;
@@ -686,7 +691,49 @@ Material::Material(const std::string& path, const std::string& relative_name)
             }
         }
     }
-    delete[] readBuffer;
+}
+
+bool Material::reload(const std::string& identifier, std::string_view json)
+{
+    rapidjson::Document document;
+    document.Parse(json.data(), json.size());
+
+    if(document.HasParseError() || !document.HasMember("vertex_shader") ||
+       !document.HasMember("fragment_shader"))
+    {
+        log_warning("Could not reload the material " + identifier);
+        return false;
+    }
+
+    const auto texture_uniforms = std::move(_texture_uniforms);
+
+    *this = Material();
+    load(identifier, json);
+
+    for(auto& uniform : _texture_uniforms)
+        for(const auto& previous : texture_uniforms)
+            if(std::strcmp(uniform.name, previous.name) == 0)
+                uniform.texture = previous.texture;
+
+    return true;
+}
+
+void Material::relink()
+{
+    if(shader_program == nullptr)
+        return;
+
+    shader_program->relink();
+
+    const auto id = shader_program->id();
+
+    location_model_view_projection_matrix = glGetUniformLocation(id, "mvp_matrix");
+
+    for(auto& uniform : _texture_uniforms)
+        uniform.location = glGetUniformLocation(id, uniform.name);
+
+    for(auto& uniform : _uniforms)
+        uniform.location = glGetUniformLocation(id, uniform.name);
 }
 
 long long Material::memory_usage() const
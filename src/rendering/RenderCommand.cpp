@@ -6,6 +6,25 @@
 #include <corgi/logger/log.h>
 #include <corgi/rendering/texture.h>
 
+#include <algorithm>
+#include <string>
+#include <string_view>
+#include <vector>
+
+// Block compressed formats come from extensions that the loader may not
+// declare, the values are fixed by the specifications
+#ifndef GL_COMPRESSED_RGBA_S3TC_DXT1_EXT
+#define GL_COMPRESSED_RGBA_S3TC_DXT1_EXT 0x83F1
+#endif
+
+#ifndef GL_COMPRESSED_RGBA_S3TC_DXT5_EXT
+#define GL_COMPRESSED_RGBA_S3TC_DXT5_EXT 0x83F3
+#endif
+
+#ifndef GL_COMPRESSED_RGBA_BPTC_UNORM
+#define GL_COMPRESSED_RGBA_BPTC_UNORM 0x8E8C
+#endif
+
 // Made this a macro so the when I log the error, I actually knows who called what
 #define check_gl_error()                                        \
     {                                                           \
@@ -97,6 +116,39 @@ namespace corgi
         glBufferSubData(GL_ELEMENT_ARRAY_BUFFER, 0, size, data);
     }
 
+    void RenderCommand::allocate_vertex_data(unsigned int index, std::size_t size)
+    {
+        glBindBuffer(GL_ARRAY_BUFFER, index);
+        glBufferData(GL_ARRAY_BUFFER, static_cast<GLsizeiptr>(size), nullptr, GL_DYNAMIC_DRAW);
+    }
+
+    void RenderCommand::allocate_index_data(unsigned int index, std::size_t size)
+    {
+        glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, index);
+        glBufferData(GL_ELEMENT_ARRAY_BUFFER, static_cast<GLsizeiptr>(size), nullptr,
+                     GL_DYNAMIC_DRAW);
+    }
+
+    void RenderCommand::buffer_vertex_subdata(unsigned int index,
+                                              std::size_t  offset,
+                                              const void*  data,
+                                              std::size_t  size)
+    {
+        glBindBuffer(GL_ARRAY_BUFFER, index);
+        glBufferSubData(GL_ARRAY_BUFFER, static_cast<GLintptr>(offset),
+                        static_cast<GLsizeiptr>(size), data);
+    }
+
+    void RenderCommand::buffer_index_subdata(unsigned int index,
+                                             std::size_t  offset,
+                                             const void*  data,
+                                             std::size_t  size)
+    {
+        glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, index);
+        glBufferSubData(GL_ELEMENT_ARRAY_BUFFER, static_cast<GLintptr>(offset),
+                        static_cast<GLsizeiptr>(size), data);
+    }
+
     void RenderCommand::vertex_attribute_pointer(unsigned id,
                                                  unsigned stride,
                                                  int      offset,
@@ -107,6 +159,46 @@ namespace corgi
         check_gl_error();
     }
 
+    void RenderCommand::instance_attribute_pointer(unsigned    id,
+                                                   unsigned    stride,
+                                                   std::size_t offset,
+                                                   unsigned    size)
+    {
+        glVertexAttribPointer(id, size, GL_FLOAT, GL_FALSE, stride, (void*)offset);
+        glVertexAttribDivisor(id, 1);
+        check_gl_error();
+    }
+
+    void RenderCommand::instance_color_attribute_pointer(unsigned    id,
+                                                         unsigned    stride,
+                                                         std::size_t offset)
+    {
+        glVertexAttribPointer(id, 4, GL_UNSIGNED_BYTE, GL_TRUE, stride, (void*)offset);
+        glVertexAttribDivisor(id, 1);
+        check_gl_error();
+    }
+
+    void RenderCommand::buffer_stream_data(unsigned int index, const void* data, std::size_t size)
+    {
+        // Orphaning the previous storage first, so we don't wait for the draw
+        // calls still reading it
+        glBindBuffer(GL_ARRAY_BUFFER, index);
+        glBufferData(GL_ARRAY_BUFFER, static_cast<GLsizeiptr>(size), nullptr, GL_STREAM_DRAW);
+        glBufferSubData(GL_ARRAY_BUFFER, 0, static_cast<GLsizeiptr>(size), data);
+    }
+
+    void RenderCommand::draw_triangles(int index_count, std::size_t first_index)
+    {
+        glDrawElements(GL_TRIANGLES, index_count, GL_UNSIGNED_INT,
+                       (void*)(first_index * sizeof(GLuint)));
+    }
+
+    void RenderCommand::draw_instanced_triangles(int index_count, int instance_count)
+    {
+        glDrawElementsInstanced(GL_TRIANGLES, index_count, GL_UNSIGNED_INT, (void*)0,
+                                instance_count);
+    }
+
     void RenderCommand::enable_vertex_attribute(unsigned id)
     {
         glEnableVertexAttribArray(id);
@@ -462,4 +554,160 @@ namespace corgi
 
         check_gl_error();
     }
-}    // namespace corgi
\ No newline at end of file
+
+    bool RenderCommand::supports_texture_format(texture_compression::Format format)
+    {
+        using texture_compression::Format;
+
+        // Every window shares the same context, the extensions are only
+        // listed once
+        static const auto extensions = []
+        {
+            std::vector<std::string> names;
+
+            GLint count = 0;
+            glGetIntegerv(GL_NUM_EXTENSIONS, &count);
+
+            for(GLint i = 0; i < count; i++)
+            {
+                if(const auto* name = glGetStringi(GL_EXTENSIONS, static_cast<GLuint>(i)))
+                    names.emplace_back(reinterpret_cast<const char*>(name));
+            }
+            return names;
+        }();
+
+        const auto has_extension = [](std::string_view name)
+        { return std::find(extensions.begin(), extensions.end(), name) != extensions.end(); };
+
+        switch(format)
+        {
+            case Format::RGBA8:
+                return true;
+
+            case Format::BC1:
+            case Format::BC3:
+                return has_extension("GL_EXT_texture_compression_s3tc");
+
+            case Format::BC7:
+            {
+                // Core since OpenGL 4.2
+                GLint major = 0;
+                GLint minor = 0;
+                glGetIntegerv(GL_MAJOR_VERSION, &major);
+                glGetIntegerv(GL_MINOR_VERSION, &minor);
+
+                return major > 4 || (major == 4 && minor >= 2) ||
+                       has_extension("GL_ARB_texture_compression_bptc");
+            }
+        }
+        return false;
+    }
+
+    int RenderCommand::max_texture_size()
+    {
+        GLint size = 0;
+        glGetIntegerv(GL_MAX_TEXTURE_SIZE, &size);
+        return size;
+    }
+
+    void RenderCommand::upload_texture_level(texture_compression::Format format,
+                                             int                         level,
+                                             int                         width,
+                                             int                         height,
+                                             std::span<const std::byte>  data)
+    {
+        using texture_compression::Format;
+
+        if(format == Format::RGBA8)
+        {
+            glTexImage2D(GL_TEXTURE_2D, level, GL_RGBA, width, height, 0, GL_RGBA,
+                         GL_UNSIGNED_BYTE, data.data());
+            check_gl_error();
+            return;
+        }
+
+        if(!supports_texture_format(format))
+        {
+            // Decoded on the CPU instead, which takes 4 to 8 times more memory
+            // but still looks the same
+            const auto decoded = texture_compression::decode(
+                format,
+                std::span(reinterpret_cast<const std::uint8_t*>(data.data()), data.size()),
+                static_cast<unsigned>(width), static_cast<unsigned>(height));
+
+            glTexImage2D(GL_TEXTURE_2D, level, GL_RGBA, width, height, 0, GL_RGBA,
+                         GL_UNSIGNED_BYTE, decoded.pixels.data());
+            check_gl_error();
+            return;
+        }
+
+        GLenum internal_format {GL_COMPRESSED_RGBA_S3TC_DXT1_EXT};
+
+        switch(format)
+        {
+            case Format::BC3:
+                internal_format = GL_COMPRESSED_RGBA_S3TC_DXT5_EXT;
+                break;
+            case Format::BC7:
+                internal_format = GL_COMPRESSED_RGBA_BPTC_UNORM;
+                break;
+            default:
+                break;
+        }
+
+        glCompressedTexImage2D(GL_TEXTURE_2D, level, internal_format, width, height, 0,
+                               static_cast<GLsizei>(data.size()), data.data());
+        check_gl_error();
+    }
+
+    void RenderCommand::texture_max_level(int level)
+    {
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAX_LEVEL, level);
+    }
+
+    std::byte*
+    RenderCommand::map_pixel_buffer(unsigned int buffer, std::size_t size, std::size_t allocate)
+    {
+        glBindBuffer(GL_PIXEL_UNPACK_BUFFER, buffer);
+
+        if(allocate != 0)
+            glBufferData(GL_PIXEL_UNPACK_BUFFER, static_cast<GLsizeiptr>(allocate), nullptr,
+                         GL_STREAM_DRAW);
+
+        // The caller waited for the uploads still reading the buffer, so the
+        // driver doesn't need to synchronize
+        auto* data = glMapBufferRange(GL_PIXEL_UNPACK_BUFFER, 0, static_cast<GLsizeiptr>(size),
+                                      GL_MAP_WRITE_BIT | GL_MAP_INVALIDATE_RANGE_BIT |
+                                          GL_MAP_UNSYNCHRONIZED_BIT);
+        check_gl_error();
+        return static_cast<std::byte*>(data);
+    }
+
+    bool RenderCommand::unmap_pixel_buffer()
+    {
+        return glUnmapBuffer(GL_PIXEL_UNPACK_BUFFER) == GL_TRUE;
+    }
+
+    void RenderCommand::unbind_pixel_buffer()
+    {
+        glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+    }
+
+    void* RenderCommand::insert_fence()
+    {
+        return glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+    }
+
+    void RenderCommand::wait_fence(void* fence)
+    {
+        auto* sync = static_cast<GLsync>(fence);
+
+        // Flushing the first time, or the fence might never be signaled
+        GLbitfield flags = GL_SYNC_FLUSH_COMMANDS_BIT;
+
+        while(glClientWaitSync(sync, flags, 1000000) == GL_TIMEOUT_EXPIRED)
+            flags = 0;
+
+        glDeleteSync(sync);
+    }
+}    // namespace corgi
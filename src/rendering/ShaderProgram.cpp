@@ -8,3 +8,20 @@ ShaderProgram::~ShaderProgram()
 {
 	glDeleteProgram(id_);
 }
+
+void ShaderProgram::relink()
+{
+	GLuint  attached[2];
+	GLsizei count = 0;
+
+	glGetAttachedShaders(id_, 2, &count, attached);
+
+	// Detaching a reloaded shader's previous object is what frees it
+	for (GLsizei i = 0; i < count; i++)
+		glDetachShader(id_, attached[i]);
+
+	glAttachShader(id_, _vertex_shader->id());
+	glAttachShader(id_, _fragment_shader->id());
+
+	glLinkProgram(id_);
+}
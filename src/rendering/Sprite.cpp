@@ -43,6 +43,18 @@ namespace corgi
 		pivot_value = pivots_[static_cast<int>(pivot)];
 	}
 
+	void Sprite::uv_rect(float rect[4]) const
+	{
+		const auto& page		= texture->page();
+		const auto page_width	= static_cast<float>(page.width());
+		const auto page_height	= static_cast<float>(page.height());
+
+		rect[0] = (texture->page_x() + offset_x) / page_width;
+		rect[1] = (texture->page_y() + offset_y) / page_height;
+		rect[2] = width / page_width;
+		rect[3] = height / page_height;
+	}
+
 	bool Sprite::operator==(const Sprite& other) const noexcept
 	{
 		if (texture != other.texture)
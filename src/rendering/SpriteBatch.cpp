@@ -0,0 +1,105 @@
+#include <corgi/rendering/SpriteBatch.h>
+#include <corgi/rendering/texture.h>
+
+#include <algorithm>
+
+namespace corgi
+{
+    void SpriteBatch::clear() noexcept
+    {
+        // The material or texture of an unused batch may not exist anymore
+        std::erase_if(batches_, [](const Batch& b) { return b.instances.empty(); });
+
+        for(auto& batch : batches_)
+            batch.instances.clear();
+
+        last_ = 0;
+    }
+
+    void SpriteBatch::release() noexcept
+    {
+        batches_.clear();
+        last_ = 0;
+    }
+
+    SpriteInstance& SpriteBatch::emplace(const Material& base, const Texture& texture)
+    {
+        // Regions of an atlas page are drawn with the page's texture object
+        return find_or_add(base, texture.page()).instances.emplace_back();
+    }
+
+    void SpriteBatch::sort_blended() noexcept
+    {
+        for(auto& batch : batches_)
+        {
+            if(!batch.material.enable_blend() || batch.instances.size() < 2)
+                continue;
+
+            std::sort(batch.instances.begin(), batch.instances.end(),
+                      [](const SpriteInstance& a, const SpriteInstance& b)
+                      {
+                          // Translation of the column major world matrices
+                          if(a.world_matrix[14] != b.world_matrix[14])
+                              return a.world_matrix[14] < b.world_matrix[14];
+                          return a.world_matrix[13] > b.world_matrix[13];
+                      });
+        }
+    }
+
+    SpriteBatch::Batch& SpriteBatch::find_or_add(const Material& base, const Texture& texture)
+    {
+        const auto base_serial    = base.serial();
+        const auto texture_serial = texture.serial();
+
+        if(last_ < batches_.size() && batches_[last_].base == base_serial &&
+           batches_[last_].texture == texture_serial)
+            return batches_[last_];
+
+        const auto it =
+            std::find_if(batches_.begin(), batches_.end(), [&](const Batch& b)
+                         { return b.base == base_serial && b.texture == texture_serial; });
+
+        if(it != batches_.end())
+        {
+            last_ = static_cast<std::size_t>(it - batches_.begin());
+            return *it;
+        }
+
+        auto& batch    = batches_.emplace_back();
+        batch.base     = base_serial;
+        batch.texture  = texture_serial;
+        batch.material = base;
+
+        if(batch.material._texture_uniforms.empty())
+            batch.material.add_texture(texture);
+        else
+            batch.material.set_texture(0, texture);
+
+        last_ = batches_.size() - 1;
+        return batch;
+    }
+
+    std::size_t SpriteBatch::draw_count() const noexcept
+    {
+        return static_cast<std::size_t>(std::count_if(batches_.begin(), batches_.end(),
+                                                      [](const Batch& b)
+                                                      { return !b.instances.empty(); }));
+    }
+
+    std::size_t SpriteBatch::instance_count() const noexcept
+    {
+        std::size_t count = 0;
+
+        for(const auto& batch : batches_)
+            count += batch.instances.size();
+        return count;
+    }
+
+    std::uint32_t SpriteBatch::pack_color(int r, int g, int b, int a) noexcept
+    {
+        auto channel = [](int v) { return static_cast<std::uint32_t>(std::clamp(v, 0, 255)); };
+
+        // Read as 4 normalized unsigned bytes, so red must come first in memory
+        return channel(r) | channel(g) << 8 | channel(b) << 16 | channel(a) << 24;
+    }
+}    // namespace corgi
@@ -0,0 +1,89 @@
+#include <corgi/logger/log.h>
+#include <corgi/rendering/RenderCommand.h>
+#include <corgi/rendering/TextureUploader.h>
+
+#include <bit>
+
+using namespace corgi;
+
+std::array<TextureUploader::PixelBuffer, 3> TextureUploader::buffers_ {};
+std::size_t                                 TextureUploader::current_ {0};
+
+std::byte* TextureUploader::stage(std::size_t size)
+{
+    if(size == 0)
+        return nullptr;
+
+    auto& buffer = buffers_[current_];
+
+    if(buffer.fence != nullptr)
+    {
+        RenderCommand::wait_fence(buffer.fence);
+        buffer.fence = nullptr;
+    }
+
+    if(buffer.id == 0)
+        buffer.id = RenderCommand::generate_buffer_object();
+
+    // Growing to a power of two, so a batch of images of different sizes
+    // doesn't reallocate the buffer every time
+    std::size_t allocate = 0;
+
+    if(buffer.capacity < size)
+    {
+        allocate        = std::bit_ceil(size);
+        buffer.capacity = allocate;
+    }
+
+    auto* data = RenderCommand::map_pixel_buffer(buffer.id, size, allocate);
+
+    if(data == nullptr)
+        RenderCommand::unbind_pixel_buffer();
+
+    return data;
+}
+
+bool TextureUploader::upload(Texture::Format         format,
+                             Texture::InternalFormat internal_format,
+                             int                     width,
+                             int                     height,
+                             Texture::DataType       data_type)
+{
+    auto& buffer = buffers_[current_];
+
+    const bool staged = RenderCommand::unmap_pixel_buffer();
+
+    if(!staged)
+    {
+        log_warning("The staged pixels of a texture were lost");
+        RenderCommand::unbind_pixel_buffer();
+    }
+
+    // With a pixel buffer bound, the data pointer is an offset inside it
+    RenderCommand::initialize_texture_object(format, internal_format, width, height,
+                                             data_type, nullptr);
+
+    if(staged)
+    {
+        buffer.fence = RenderCommand::insert_fence();
+        RenderCommand::unbind_pixel_buffer();
+    }
+
+    current_ = (current_ + 1) % buffers_.size();
+    return staged;
+}
+
+void TextureUploader::release()
+{
+    for(auto& buffer : buffers_)
+    {
+        if(buffer.fence != nullptr)
+            RenderCommand::wait_fence(buffer.fence);
+
+        if(buffer.id != 0)
+            RenderCommand::delete_vertex_buffer_object(buffer.id);
+
+        buffer = PixelBuffer {};
+    }
+    current_ = 0;
+}
@@ -146,3 +146,12 @@ void WindowDrawList::add_mesh(const Mesh&     mesh,
 {
     draw_list_.add_mesh(mesh, model_matrix, material, &window);
 }
+
+void WindowDrawList::add_text(const DrawList::Text& text,
+                              const Matrix&         model_matrix,
+                              const Material&       material,
+                              corgi::Window&        window
+    )
+{
+    draw_list_.add_text(text, model_matrix, material, &window);
+}
@@ -2,14 +2,17 @@
 #include <corgi/components/BoxCollider.h>
 #include <corgi/components/BoxCollider2D.h>
 #include <corgi/components/Camera.h>
+#include <corgi/components/SpriteRenderer.h>
 #include <corgi/components/Transform.h>
 #include <corgi/ecs/Component.h>
 #include <corgi/ecs/Entity.h>
 #include <corgi/ecs/Scene.h>
 #include <corgi/logger/log.h>
 #include <corgi/main/Window.h>
+#include <corgi/profiler/Profiler.h>
 #include <corgi/rendering/FrameBuffer.h>
 #include <corgi/rendering/Material.h>
+#include <corgi/rendering/RenderCommand.h>
 #include <corgi/rendering/ShaderProgram.h>
 #include <corgi/rendering/renderer.h>
 #include <corgi/rendering/texture.h>
@@ -20,6 +23,9 @@
 #include <corgi/utils/ResourcesCache.h>
 #include <glad/glad.h>
 
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
 #include <fstream>
 #include <iostream>
 
@@ -220,6 +226,16 @@ void Renderer::set_current_window(Window* window)
     window_draw_list_.set_current_window(window);
 }
 
+void Renderer::interpolation_alpha(float alpha) noexcept
+{
+    interpolation_alpha_ = alpha;
+}
+
+float Renderer::interpolation_alpha() const noexcept
+{
+    return interpolation_alpha_;
+}
+
 void Renderer::draw_collider(ColliderComponent* collider, const Matrix& world_matrix)
 {
     static Material material =
@@ -268,7 +284,7 @@ void Renderer::draw_colliders(Scene& scene)
                                            .get<BoxCollider2D>()
                                            ->component_index_to_entity_id()
                                            .at(i));
-            auto& entity    = _current_scene->entity_contiguous().at(entity_id.id_);
+            auto& entity    = _current_scene->entities().at(entity_id.id_);
 
             if(collider.is_enabled() && entity.is_enabled())
             {
@@ -316,7 +332,7 @@ void Renderer::draw_colliders(Scene& scene)
         auto entity_id = EntityId(
             scene.component_maps().get<BoxCollider>()->component_index_to_entity_id().at(
                 i));
-        auto& entity = _current_scene->entity_contiguous().at(entity_id.id_);
+        auto& entity = _current_scene->entities().at(entity_id.id_);
 
         if(collider.is_enabled() && entity.is_enabled())
         {
@@ -441,7 +457,8 @@ void Renderer::draw_scene(Window& window)
         auto entity_id        = scene.component_maps().get<Camera>()->entity_id(i++);
         auto camera_transform = transform_map_->get(entity_id);
 
-        initialize_camera(camera_transform.world_matrix().inverse(), camera);
+        initialize_camera(
+            camera_transform.interpolated_world_matrix(interpolation_alpha_).inverse(), camera);
 
         if(camera.on_start)
             camera.on_start();
@@ -471,8 +488,13 @@ void Renderer::draw_scene(Window& window)
 
         std::map<Material, std::vector<const MeshRenderer*>> components_by_material;
 
-        auto components =
-            sort_by_camera_layer(scene, camera, rendering_system._meshes.components());
+        std::vector<const MeshRenderer*> components;
+
+        {
+            CORGI_PROFILE_ZONE("Renderer::sort_layers");
+            components =
+                sort_by_camera_layer(scene, camera, rendering_system._meshes.components());
+        }
 
         std::vector<const MeshRenderer*> culled_components;
         culled_components.reserve(components.size());
@@ -488,28 +510,31 @@ void Renderer::draw_scene(Window& window)
                              camera_transform.position().y);
 
         // This is the culling part, probably should put it in its own function
-        for(auto& cc : components)
         {
-            auto  mesh      = cc->_mesh;
-            auto& transform = transform_map_->get(EntityId(cc->_entity_id->id()));
-            //bool culled = true;
+            CORGI_PROFILE_ZONE("Renderer::cull");
+            for(auto& cc : components)
+            {
+                auto  mesh      = cc->_mesh;
+                auto& transform = transform_map_->get(EntityId(cc->_entity_id->id()));
+                //bool culled = true;
 
-            auto wm = transform.world_matrix();
+                auto wm = transform.interpolated_world_matrix(interpolation_alpha_);
 
-            auto wmdata = wm.data();
+                auto wmdata = wm.data();
 
-            Vec2 position;
+                Vec2 position;
 
-            position.x = mesh->bounding_circle_offset_x + wmdata[12];
-            position.y = mesh->bounding_circle_offset_y + wmdata[13];
+                position.x = mesh->bounding_circle_offset_x + wmdata[12];
+                position.y = mesh->bounding_circle_offset_y + wmdata[13];
 
-            // So now I have the actual center of the bounding circle;
+                // So now I have the actual center of the bounding circle;
 
-            const auto distance = (position - camera_position).length();
+                const auto distance = (position - camera_position).length();
 
-            if(distance < (max_distance + mesh->bounding_circle_radius))
-            {
-                culled_components.push_back(cc);
+                if(distance < (max_distance + mesh->bounding_circle_radius))
+                {
+                    culled_components.push_back(cc);
+                }
             }
         }
 
@@ -526,65 +551,68 @@ void Renderer::draw_scene(Window& window)
         std::vector<MaterialIndex>                    test_materials;
         test_materials.reserve(2000);
 
-        for(auto* component : components)
         {
-            /*auto r = std::find_if(test_materials.begin(), test_materials.end(), [&](const std::pair<Material,int>&p)
-                            {
-                                            return p.first == component->material;
-                            });*/
-
-            int  min   = 0;
-            int  max   = static_cast<int>(test_materials.size()) - 1;
-            bool found = false;
-
-            int index;
-            while(!found)
+            CORGI_PROFILE_ZONE("Renderer::sort");
+            for(auto* component : components)
             {
-                if(max == -1)
-                    break;
+                /*auto r = std::find_if(test_materials.begin(), test_materials.end(), [&](const std::pair<Material,int>&p)
+                                {
+                                                return p.first == component->material;
+                                });*/
 
-                index = (min + max) / 2;
+                int  min   = 0;
+                int  max   = static_cast<int>(test_materials.size()) - 1;
+                bool found = false;
 
-                if(*test_materials[index].material == component->material)
+                int index;
+                while(!found)
                 {
-                    found = true;
-                    break;
+                    if(max == -1)
+                        break;
+
+                    index = (min + max) / 2;
+
+                    if(*test_materials[index].material == component->drawn_material())
+                    {
+                        found = true;
+                        break;
+                    }
+
+                    if(min >= max)
+                        break;
+
+                    if(*test_materials[index].material < component->drawn_material())
+                    {
+                        max = index - 1;
+                    }
+                    else
+                    {
+                        min = index + 1;
+                    }
                 }
 
-                if(min >= max)
-                    break;
-
-                if(*test_materials[index].material < component->material)
+                if(found)
                 {
-                    max = index - 1;
+                    test_sort[test_materials[index].index].emplace_back(component);
                 }
                 else
                 {
-                    min = index + 1;
-                }
-            }
+                    test_materials.push_back(
+                        {&component->drawn_material(), (int)test_materials.size()});
 
-            if(found)
-            {
-                test_sort[test_materials[index].index].emplace_back(component);
-            }
-            else
-            {
-                test_materials.push_back(
-                    {&component->material, (int)test_materials.size()});
+                    qsort(test_materials.data(), test_materials.size(), sizeof(MaterialIndex),
+                          cmpfunc);
 
-                qsort(test_materials.data(), test_materials.size(), sizeof(MaterialIndex),
-                      cmpfunc);
+                    /*[]( const std::pair<Material, int>& p1, const std::pair<Material, int>& p2)->bool
+                                        {
+                                                        return p1.first < p2.first;
+                                        }
+                                        );*/
 
-                /*[]( const std::pair<Material, int>& p1, const std::pair<Material, int>& p2)->bool
-                                    {
-                                                    return p1.first < p2.first;
-                                    }
-                                    );*/
-
-                test_sort.emplace_back();
-                test_sort.back().reserve(20);
-                test_sort.back().push_back(component);
+                    test_sort.emplace_back();
+                    test_sort.back().reserve(20);
+                    test_sort.back().push_back(component);
+                }
             }
         }
 
@@ -595,19 +623,24 @@ void Renderer::draw_scene(Window& window)
         //	return a->material.render_queue < b->material.render_queue;
         //});
 
+        CORGI_PROFILE_ZONE("Renderer::submit");
+
         for(auto& components : test_sort)    // Drawing components by material
         {
-            begin_material(components[0]->material);
+            begin_material(components[0]->drawn_material());
 
             for(auto& mesh_renderer : components)
             {
                 auto& transform =
                     transform_map_->get(EntityId(mesh_renderer->_entity_id->id()));
                 draw_mesh(mesh_renderer->_mesh.get(),
-                          _view_projection_matrix * transform.world_matrix());
+                          _view_projection_matrix *
+                              transform.interpolated_world_matrix(interpolation_alpha_));
             }
         }
 
+        draw_sprites(scene, camera, camera_position, max_distance);
+
         draw_colliders(scene);    // Only drawn if show_collider_ = true
         draw_dl(_world_draw_list);
 
@@ -618,6 +651,183 @@ void Renderer::draw_scene(Window& window)
     drawScreenSpace(window);
 }
 
+void Renderer::initialize_sprite_buffers()
+{
+    // Same quad as the one used by the old sprite meshes, the vertex shader
+    // scales it with the sprite's size and pivot
+    const float vertices[] = {-1.0f, -1.0f, 0.0f, 0.0f, 0.0f, 1.0f, -1.0f, 0.0f, 1.0f, 0.0f,
+                              1.0f,  1.0f,  0.0f, 1.0f, 1.0f, -1.0f, 1.0f, 0.0f, 0.0f, 1.0f};
+
+    const unsigned indexes[] = {0, 1, 2, 0, 2, 3};
+
+    sprite_vao_          = RenderCommand::generate_vao_buffer();
+    sprite_vbo_          = RenderCommand::generate_buffer_object();
+    sprite_ibo_          = RenderCommand::generate_buffer_object();
+    sprite_instance_vbo_ = RenderCommand::generate_buffer_object();
+
+    RenderCommand::bind_vertex_array(sprite_vao_);
+
+    RenderCommand::buffer_vertex_data(sprite_vbo_, vertices, sizeof(vertices));
+    RenderCommand::buffer_index_data(sprite_ibo_, indexes, sizeof(indexes));
+
+    RenderCommand::enable_vertex_attribute(0);
+    RenderCommand::vertex_attribute_pointer(0, 5 * sizeof(float), 0, 3);
+    RenderCommand::enable_vertex_attribute(1);
+    RenderCommand::vertex_attribute_pointer(1, 5 * sizeof(float), 3, 2);
+
+    // A mat4 attribute takes 4 locations, one per column
+
+    RenderCommand::bind_vertex_buffer_object(sprite_instance_vbo_);
+
+    constexpr auto stride = static_cast<unsigned>(sizeof(SpriteInstance));
+
+    for(unsigned column = 0; column < 4; column++)
+    {
+        RenderCommand::enable_vertex_attribute(2 + column);
+        RenderCommand::instance_attribute_pointer(
+            2 + column, stride,
+            offsetof(SpriteInstance, world_matrix) + column * 4 * sizeof(float), 4);
+    }
+
+    RenderCommand::enable_vertex_attribute(6);
+    RenderCommand::instance_attribute_pointer(6, stride, offsetof(SpriteInstance, uv_rect), 4);
+    RenderCommand::enable_vertex_attribute(7);
+    RenderCommand::instance_attribute_pointer(7, stride, offsetof(SpriteInstance, quad), 4);
+    RenderCommand::enable_vertex_attribute(8);
+    RenderCommand::instance_color_attribute_pointer(8, stride, offsetof(SpriteInstance, tint));
+
+    RenderCommand::bind_vertex_array(0);
+}
+
+void Renderer::release()
+{
+    sprite_batch_.release();
+
+    if(sprite_vao_ != 0)
+    {
+        RenderCommand::delete_vertex_array_object(sprite_vao_);
+        RenderCommand::delete_vertex_buffer_object(sprite_vbo_);
+        RenderCommand::delete_vertex_buffer_object(sprite_ibo_);
+        RenderCommand::delete_vertex_buffer_object(sprite_instance_vbo_);
+
+        sprite_vao_          = 0;
+        sprite_vbo_          = 0;
+        sprite_ibo_          = 0;
+        sprite_instance_vbo_ = 0;
+    }
+
+    if(text_vao_ != 0)
+    {
+        RenderCommand::delete_vertex_array_object(text_vao_);
+        RenderCommand::delete_vertex_buffer_object(text_vbo_);
+        RenderCommand::delete_vertex_buffer_object(text_ibo_);
+
+        text_vao_           = 0;
+        text_vbo_           = 0;
+        text_ibo_           = 0;
+        text_quad_capacity_ = 0;
+    }
+}
+
+void Renderer::draw_sprites(Scene&        scene,
+                            const Camera& camera,
+                            const Vec2&   camera_position,
+                            float         max_distance)
+{
+    CORGI_PROFILE_ZONE("Renderer::draw_sprites");
+
+    if(!scene.component_maps().contains<SpriteRenderer>())
+        return;
+
+    auto* sprites = scene.component_maps().get<SpriteRenderer>();
+
+    const auto  layers = camera.culling_layers().layers();
+    const auto* array  = sprites->data();
+    const auto  size   = sprites->size();
+
+    // Batches keep a copy of their material, made before it was reloaded or
+    // the cache was cleared
+    if(ResourcesCache::generation() != resources_generation_)
+    {
+        sprite_batch_.release();
+        resources_generation_ = ResourcesCache::generation();
+    }
+
+    sprite_batch_.clear();
+
+    {
+        CORGI_PROFILE_ZONE("Renderer::batch_sprites");
+
+        for(std::size_t i = 0; i < size; i++)
+        {
+            const auto& sprite_renderer = array[i];
+
+            if(!sprite_renderer._enabled || sprite_renderer.sprite_.texture == nullptr ||
+               !(sprite_renderer.cameraLayer & layers))
+                continue;
+
+            const auto entity_id = sprites->entity_id(i);
+
+            if(!scene.entities()[entity_id.id_].is_enabled() ||
+               !transform_map_->contains(entity_id))
+                continue;
+
+            const auto world =
+                transform_map_->get(entity_id).interpolated_world_matrix(interpolation_alpha_);
+            const auto* m = world.data();
+
+            // Bounding circle of the scaled quad
+            const auto* quad   = sprite_renderer._instance.quad;
+            const auto  scale  = std::max(std::sqrt(m[0] * m[0] + m[1] * m[1]),
+                                          std::sqrt(m[4] * m[4] + m[5] * m[5]));
+            const auto  radius = 0.5f * scale * std::sqrt(quad[0] * quad[0] + quad[1] * quad[1]);
+
+            if((Vec2(m[12], m[13]) - camera_position).length() >= max_distance + radius)
+                continue;
+
+            auto& instance = sprite_batch_.emplace(*sprite_renderer._material,
+                                                   *sprite_renderer.sprite_.texture);
+
+            instance = sprite_renderer._instance;
+            std::copy(m, m + 16, instance.world_matrix);
+        }
+    }
+
+    if(sprite_batch_.instance_count() == 0)
+        return;
+
+    {
+        CORGI_PROFILE_ZONE("Renderer::sort_sprites");
+        sprite_batch_.sort_blended();
+    }
+
+    if(sprite_vao_ == 0)
+        initialize_sprite_buffers();
+
+    for(const auto& batch : sprite_batch_.batches())
+    {
+        if(batch.instances.empty())
+            continue;
+
+        begin_material(batch.material);
+
+        // The world matrices are per instance, so the material's matrix only
+        // holds the view projection
+        glUniformMatrix4fv(model_matrix_id, 1, GL_FALSE, _view_projection_matrix.data());
+
+        RenderCommand::buffer_stream_data(sprite_instance_vbo_, batch.instances.data(),
+                                          batch.instances.size() * sizeof(SpriteInstance));
+
+        RenderCommand::bind_vertex_array(sprite_vao_);
+        RenderCommand::draw_instanced_triangles(6, static_cast<int>(batch.instances.size()));
+
+        profiler_.draw_calls++;
+        profiler_.triangle_count += static_cast<unsigned>(batch.instances.size()) * 2u;
+    }
+
+    RenderCommand::bind_vertex_array(0);
+}
+
 void Renderer::drawScreenSpace(Window& window)
 {
     // First we return back to the default frame buffer
@@ -1138,14 +1348,13 @@ void Renderer::draw_dlsprite(const DrawList::DrawListSprite& sprite)
 
     // Also maybe this doesn't need to be computed all the time? Maybe it could
     // be cached on the Sprite class
-    const auto offset_texture_x =
-        sprite.sprite.offset_x / static_cast<float>(sprite.sprite.texture->width());
-    const auto offset_texture_y =
-        sprite.sprite.offset_y / static_cast<float>(sprite.sprite.texture->height());
-    const auto texture_width_coef =
-        sprite.sprite.width / static_cast<float>(sprite.sprite.texture->width());
-    const auto texture_height_coef =
-        sprite.sprite.height / static_cast<float>(sprite.sprite.texture->height());
+    float uv_rect[4];
+    sprite.sprite.uv_rect(uv_rect);
+
+    const auto offset_texture_x    = uv_rect[0];
+    const auto offset_texture_y    = uv_rect[1];
+    const auto texture_width_coef  = uv_rect[2];
+    const auto texture_height_coef = uv_rect[3];
 
     auto& vertices = mesh->vertices();
 
@@ -1267,8 +1476,49 @@ void Renderer::draw_rect(const DrawList::Rectangle& rectangle)
     draw_mesh(mesh.get(), _view_projection_matrix * Matrix());
 }
 
+void Renderer::upload_shared_texts(const DrawList& drawlist)
+{
+    if(text_vao_ == 0)
+    {
+        text_vao_ = RenderCommand::generate_vao_buffer();
+        text_vbo_ = RenderCommand::generate_buffer_object();
+        text_ibo_ = RenderCommand::generate_buffer_object();
+
+        RenderCommand::bind_vertex_array(text_vao_);
+        RenderCommand::bind_vertex_buffer_object(text_vbo_);
+        RenderCommand::enable_vertex_attribute(0);
+        RenderCommand::vertex_attribute_pointer(0, 5 * sizeof(float), 0, 3);
+        RenderCommand::enable_vertex_attribute(1);
+        RenderCommand::vertex_attribute_pointer(1, 5 * sizeof(float), 3, 2);
+        RenderCommand::bind_vertex_array(0);
+    }
+
+    const auto quads = drawlist.text_vertices_.size() / 20;
+
+    // Every quad is indexed the same way, so the indexes only change when
+    // there are more quads than ever before
+    if(quads > text_quad_capacity_)
+    {
+        text_quad_capacity_ = std::max(quads, text_quad_capacity_ * 2);
+
+        std::vector<unsigned> indexes;
+        DrawList::Text::append_quad_indexes(indexes, text_quad_capacity_);
+
+        RenderCommand::bind_vertex_array(text_vao_);
+        RenderCommand::buffer_index_data(text_ibo_, indexes.data(),
+                                         static_cast<int>(indexes.size() * sizeof(unsigned)));
+        RenderCommand::bind_vertex_array(0);
+    }
+
+    RenderCommand::buffer_stream_data(text_vbo_, drawlist.text_vertices_.data(),
+                                      drawlist.text_vertices_.size() * sizeof(float));
+}
+
 void Renderer::draw_dl(const DrawList& drawlist)
 {
+    if(!drawlist.text_vertices_.empty())
+        upload_shared_texts(drawlist);
+
     for(const auto& [class_type, index] : drawlist.order_)
     {
         switch(class_type)
@@ -1298,6 +1548,22 @@ void Renderer::draw_dl(const DrawList& drawlist)
                 }
 
                 break;
+            case DrawList::DrawListType::SharedText:
+            {
+                const auto& text = drawlist.shared_texts_[index];
+
+                if(text.index_count == 0 ||
+                   (text.window && text.window->id() != current_window_->id()))
+                    break;
+
+                begin_material(text.material);
+                glUniformMatrix4fv(model_matrix_id, 1, GL_FALSE,
+                                   (_view_projection_matrix * text.matrix).data());
+
+                RenderCommand::bind_vertex_array(text_vao_);
+                RenderCommand::draw_triangles(text.index_count, text.first_index);
+                break;
+            }
             case DrawList::DrawListType::ResetStencilBuffer:
                 glClearStencil(0);
                 glStencilMask(0xFF);
@@ -1,14 +1,22 @@
 #include <corgi/filesystem/FileSystem.h>
+#include <corgi/filesystem/MappedFile.h>
+#include <corgi/filesystem/VirtualFileSystem.h>
 #include <corgi/logger/log.h>
 #include <corgi/rendering/RenderCommand.h>
+#include <corgi/rendering/TextureUploader.h>
 #include <corgi/rendering/texture.h>
 #include <corgi/resources/image.h>
+#include <corgi/utils/TextureCompression.h>
 #include <corgi/utils/Utils.h>
 #include <rapidjson/document.h>
-#include <rapidjson/filereadstream.h>
 #include <rapidjson/rapidjson.h>
 
+#include <cstring>
+#include <fstream>
+#include <iterator>
 #include <map>
+#include <stdexcept>
+#include <vector>
 
 using namespace corgi;
 
@@ -31,6 +39,59 @@ static Texture::MinFilter parse_min_filter(const std::string& str)
     return min_filters_.at(str);
 }
 
+// Size of a pixel uploaded with @a format, with a byte per channel
+static std::size_t bytes_per_pixel(Texture::Format format)
+{
+    switch(format)
+    {
+        case Texture::Format::RED:
+        case Texture::Format::RED_INTEGER:
+            return 1;
+
+        case Texture::Format::RG:
+        case Texture::Format::RG_INTEGER:
+            return 2;
+
+        case Texture::Format::RGB:
+        case Texture::Format::BGR:
+        case Texture::Format::RGB_INTEGER:
+        case Texture::Format::BGR_INTEGER:
+            return 3;
+
+        default:
+            return 4;
+    }
+}
+
+// .img files start with the width, the height and the channel count,
+// followed by the pixels, always with 4 channels. Returns false if @a image
+// is too small to hold the pixels its header announces
+static bool read_image_header(std::span<const std::byte> image, int& width, int& height)
+{
+    if(image.size() < 3 * sizeof(int))
+        return false;
+
+    std::memcpy(&width, image.data(), sizeof width);
+    std::memcpy(&height, image.data() + sizeof width, sizeof height);
+
+    return width > 0 && height > 0 &&
+           (image.size() - 3 * sizeof(int)) / 4 / std::size_t(width) >= std::size_t(height);
+}
+
+// Checks that @a image can be loaded, compressed or not
+static bool is_valid_image(std::span<const std::byte> image)
+{
+    if(texture_compression::Container::is_container(image))
+    {
+        texture_compression::Container container;
+        return container.parse(image) && !container.levels().empty();
+    }
+
+    int width  = 0;
+    int height = 0;
+    return read_image_header(image, width, height);
+}
+
 static Texture::Wrap load_wrap(const std::string& str)
 {
     static std::map<std::string, Texture::Wrap> wraps = {
@@ -50,46 +111,34 @@ Texture::Texture()
 Texture::Texture(const std::string& path, const std::string& relative_path)
     : name_(relative_path.c_str())
 {
-    auto size = filesystem::size(path.c_str());
+    std::ifstream description_file(path, std::ifstream::binary);
 
-#ifdef __linux__
-    FILE* fp = fopen(path.c_str(), "r");    // non-Windows use "r"
-#else
-    FILE* fp = fopen(path.c_str(), "rb");    // non-Windows use "r"
-#endif
+    const std::vector<char> description((std::istreambuf_iterator<char>(description_file)),
+                                        std::istreambuf_iterator<char>());
 
-    std::vector<char> readBuffer(static_cast<unsigned int>(size));
+    // The pixels are read straight from the mapping, without copying the
+    // whole file into a buffer first
+    const filesystem::MappedFile image(path.substr(0, path.size() - 4) + ".img");
 
-    rapidjson::FileReadStream is(fp, readBuffer.data(), static_cast<unsigned int>(size));
+    load(std::as_bytes(std::span(description)), {image.data(), image.size()});
+}
+
+Texture::Texture(const filesystem::VirtualFileSystem& vfs, const std::string& identifier)
+    : name_(identifier)
+{
+    load(vfs.read(identifier), vfs.read(identifier.substr(0, identifier.size() - 4) + ".img"));
+}
 
+void Texture::load(std::span<const std::byte> description, std::span<const std::byte> image)
+{
     rapidjson::Document document;
-    document.ParseStream(is);
+    document.Parse(reinterpret_cast<const char*>(description.data()), description.size());
 
     assert(document.HasMember("wrap_s"));
     assert(document.HasMember("wrap_t"));
     assert(document.HasMember("min_filter"));
     assert(document.HasMember("mag_filter"));
 
-    // help
-    std::string pp       = path.c_str();
-    auto        img_path = pp.substr(0, pp.size() - 4) + ".img";
-
-    std::ifstream corgi_image(img_path, std::ifstream::binary | std::ifstream::in);
-
-    int w;
-    int h;
-    int channels;
-
-    corgi_image.read(reinterpret_cast<char*>(&w), sizeof w);
-    corgi_image.read(reinterpret_cast<char*>(&h), sizeof h);
-    corgi_image.read(reinterpret_cast<char*>(&channels), sizeof channels);
-
-    unsigned char* pixels = new unsigned char[w * h * 4];
-
-    corgi_image.read(reinterpret_cast<char*>(pixels), w * h * 4);
-
-    _width      = w;
-    _height     = h;
     min_filter_ = parse_min_filter(document["min_filter"].GetString());
     mag_filter_ = parse_mag_filter(document["mag_filter"].GetString());
     wrap_s_     = load_wrap(document["wrap_s"].GetString());
@@ -106,24 +155,148 @@ Texture::Texture(const std::string& path, const std::string& relative_path)
     RenderCommand::texture_wrap_s(wrap_s_);
     RenderCommand::texture_wrap_t(wrap_t_);
 
-    // if (channels == 3)
-    // {
-    // 	RenderCommand::initialize_texture_object
-    // 	(
-    // 		Format::RGB, InternalFormat::RGB, _width, _height,
-    // 		DataType::UnsignedByte, pixels
-    // 	);
-    // }
-
-    // if (channels == 4)
-    // {
-    RenderCommand::initialize_texture_object(Format::RGBA, InternalFormat::RGBA, _width,
-                                             _height, DataType::UnsignedByte, pixels);
-    //}
+    // Images converted by CorgiTextureCompressor store their whole mip chain,
+    // already encoded the way the GPU wants it
+    if(texture_compression::Container::is_container(image))
+    {
+        texture_compression::Container container;
+
+        if(container.parse(image) && !container.levels().empty())
+        {
+            const auto& levels = container.levels();
+
+            for(std::size_t i = 0; i < levels.size(); i++)
+                RenderCommand::upload_texture_level(container.format(), static_cast<int>(i),
+                                                    levels[i].width, levels[i].height,
+                                                    levels[i].data);
+
+            RenderCommand::texture_max_level(static_cast<int>(levels.size()) - 1);
+
+            _width       = container.width();
+            _height      = container.height();
+            pixels_size_ = container.size();
+        }
+        else
+        {
+            log_error("Could not read the compressed image of " + name_);
+        }
+
+        RenderCommand::end_texture();
+        return;
+    }
+
+    int w = 0;
+    int h = 0;
+
+    const std::byte* pixels = nullptr;
+
+    if(read_image_header(image, w, h))
+    {
+        pixels = image.data() + 3 * sizeof(int);
+    }
+    else
+    {
+        log_error("Could not read the image of " + name_);
+        w = 0;
+        h = 0;
+    }
+
+    _width       = w;
+    _height      = h;
+    pixels_size_ = std::size_t(w) * h * 4;
+
+    // Copied into a pixel buffer, the GPU reads them asynchronously while
+    // the next texture loads
+    auto* staging = TextureUploader::stage(pixels != nullptr ? pixels_size_ : 0);
+
+    if(staging != nullptr)
+        std::memcpy(staging, pixels, pixels_size_);
+
+    // Without a pixel buffer, or when the staged pixels were lost while
+    // unmapping it, the pixels are uploaded from the image itself
+    if(staging == nullptr || !TextureUploader::upload(Format::RGBA, InternalFormat::RGBA, _width,
+                                                      _height, DataType::UnsignedByte))
+    {
+        // The data isn't modified, but the render command takes a void pointer
+        RenderCommand::initialize_texture_object(Format::RGBA, InternalFormat::RGBA, _width,
+                                                 _height, DataType::UnsignedByte,
+                                                 const_cast<std::byte*>(pixels));
+    }
 
     RenderCommand::end_texture();
-    fclose(fp);
-    delete[] pixels;
+}
+
+bool Texture::reload(std::span<const std::byte> description, std::span<const std::byte> image)
+{
+    // Regions are rebuilt from their page, see ResourcesCache
+    if(page_ != nullptr)
+        return false;
+
+    rapidjson::Document document;
+    document.Parse(reinterpret_cast<const char*>(description.data()), description.size());
+
+    if(document.HasParseError() || !document.IsObject())
+    {
+        log_warning("Could not reload the texture " + name_);
+        return false;
+    }
+
+    for(const char* member : {"wrap_s", "wrap_t", "min_filter", "mag_filter"})
+    {
+        if(!document.HasMember(member) || !document[member].IsString())
+        {
+            log_warning("Could not reload the texture " + name_);
+            return false;
+        }
+    }
+
+    try
+    {
+        static_cast<void>(parse_min_filter(document["min_filter"].GetString()));
+        static_cast<void>(parse_mag_filter(document["mag_filter"].GetString()));
+        static_cast<void>(load_wrap(document["wrap_s"].GetString()));
+        static_cast<void>(load_wrap(document["wrap_t"].GetString()));
+    }
+    catch(const std::out_of_range&)
+    {
+        log_warning("Unknown filter or wrap mode in the texture " + name_);
+        return false;
+    }
+
+    // The previous texture object is only replaced by a complete image
+    if(!is_valid_image(image))
+    {
+        log_warning("Could not reload the image of the texture " + name_);
+        return false;
+    }
+
+    const auto previous = id_;
+
+    load(description, image);
+
+    if(previous != 0)
+        RenderCommand::delete_texture_object(previous);
+    return true;
+}
+
+Texture::Texture(const std::string& name,
+                 const Texture&     page,
+                 unsigned           x,
+                 unsigned           y,
+                 unsigned           width,
+                 unsigned           height)
+    : name_(name)
+    , id_(page.id_)
+    , min_filter_(page.min_filter_)
+    , mag_filter_(page.mag_filter_)
+    , wrap_s_(page.wrap_s_)
+    , wrap_t_(page.wrap_t_)
+    , _width(width)
+    , _height(height)
+    , page_(&page.page())
+    , page_x_(page.page_x_ + x)
+    , page_y_(page.page_y_ + y)
+{
 }
 
 Texture::Texture(Texture&& texture) noexcept
@@ -135,9 +308,14 @@ Texture::Texture(Texture&& texture) noexcept
     , wrap_t_(texture.wrap_t_)
     , _width(texture._width)
     , _height(texture._height)
+    , pixels_size_(texture.pixels_size_)
+    , page_(texture.page_)
+    , page_x_(texture.page_x_)
+    , page_y_(texture.page_y_)
 {
     //log_info("Texture Move Constructor for "+ name_);
 
+    texture.page_       = nullptr;
     texture.id_         = 0u;
     texture._width      = static_cast<unsigned short>(0);
     texture._height     = static_cast<unsigned short>(0);
@@ -151,18 +329,23 @@ Texture& Texture::operator=(Texture&& texture) noexcept
 {
     //log_info("Move Affectation texture for "+ name_);
 
-    if(id_ != 0)
+    if(id_ != 0 && page_ == nullptr)
         RenderCommand::delete_texture_object(id_);
 
-    name_       = std::move(texture.name_);
-    id_         = texture.id_;
-    min_filter_ = texture.min_filter_;
-    mag_filter_ = texture.mag_filter_;
-    wrap_s_     = texture.wrap_s_;
-    wrap_t_     = texture.wrap_t_;
-    _width      = texture._width;
-    _height     = texture._height;
-
+    name_        = std::move(texture.name_);
+    id_          = texture.id_;
+    min_filter_  = texture.min_filter_;
+    mag_filter_  = texture.mag_filter_;
+    wrap_s_      = texture.wrap_s_;
+    wrap_t_      = texture.wrap_t_;
+    _width       = texture._width;
+    _height      = texture._height;
+    pixels_size_ = texture.pixels_size_;
+    page_        = texture.page_;
+    page_x_      = texture.page_x_;
+    page_y_      = texture.page_y_;
+
+    texture.page_       = nullptr;
     texture.id_         = 0u;
     texture._width      = static_cast<unsigned short>(0);
     texture._height     = static_cast<unsigned short>(0);
@@ -198,6 +381,7 @@ Texture::Texture(const std::string& name,
     , wrap_t_(wrap_t)
     , _width(static_cast<unsigned short>(width))
     , _height(static_cast<unsigned short>(height))
+    , pixels_size_(std::size_t(width) * height * bytes_per_pixel(format))
 {
     //log_info("Texture Constructor for "+name);
 
@@ -215,7 +399,10 @@ Texture::Texture(const std::string& name,
 Texture::~Texture()
 {
     //log_info("Texture Destructor for "+name_);
-    RenderCommand::delete_texture_object(id_);
+
+    // Regions don't own their page's texture object
+    if(page_ == nullptr)
+        RenderCommand::delete_texture_object(id_);
 }
 
 bool Texture::operator==(const Texture& other) const noexcept
@@ -280,7 +467,11 @@ bool Texture::operator<(const Texture& other) const noexcept
 
 long long Texture::memory_usage() const
 {
-    return sizeof(Texture) + _width * _height * 4;
+    // The pixels of a region are counted by its page
+    if(page_ != nullptr)
+        return sizeof(Texture);
+
+    return sizeof(Texture) + static_cast<long long>(pixels_size_);
 }
 
 void Texture::apply_changes()
@@ -298,7 +489,7 @@ void Texture::apply_changes()
 
 unsigned Texture::id() const noexcept
 {
-    return id_;
+    return page_ != nullptr ? page_->id_ : id_;
 }
 
 Texture::MinFilter Texture::min_filter() const noexcept
@@ -331,6 +522,26 @@ unsigned Texture::height() const noexcept
     return _height;
 }
 
+const Texture& Texture::page() const noexcept
+{
+    return page_ != nullptr ? *page_ : *this;
+}
+
+bool Texture::is_region() const noexcept
+{
+    return page_ != nullptr;
+}
+
+unsigned Texture::page_x() const noexcept
+{
+    return page_x_;
+}
+
+unsigned Texture::page_y() const noexcept
+{
+    return page_y_;
+}
+
 void Texture::width(unsigned width) noexcept
 {
     _width = width;
@@ -1,13 +1,20 @@
 #include <corgi/logger/log.h>
+#include <corgi/rendering/RenderCommand.h>
 #include <corgi/rendering/texture.h>
 #include <corgi/resources/Font.h>
+#include <corgi/utils/AtlasPacker.h>
+#include <corgi/utils/DistanceField.h>
 #include <freetype2/ft2build.h>
 #include <harfbuzz/hb.h>
 
 #include FT_FREETYPE_H
 
+#include <algorithm>
+#include <cstddef>
 #include <fstream>
 #include <map>
+#include <stdexcept>
+#include <string>
 
 #include <hb-ft.h>
 
@@ -51,7 +58,7 @@ long long Font::memory_usage() const
 
     for(auto& configuration : configurations_)
     {
-        sum = configuration->texture->memory_usage();
+        sum += configuration->texture->memory_usage();
     }
 
     return sizeof(Font) +
@@ -110,6 +117,8 @@ Font::Font(const std::string& file, const std::string& name)
 
     log_info(("Constructing font : " + file).c_str());
 
+    ttf_path_ = file.substr(0, file.size() - 3) + "ttf";
+
     std::ifstream font_file(file.c_str(), std::ifstream::binary);
 
     if(!font_file.is_open())
@@ -152,8 +161,10 @@ Font::Font(const std::string& file, const std::string& name)
 
         for(int i = 0; i < charactersSize; i++)
         {
+            // The .fnt files stop before ty, their glyphs all touch the top of
+            // the texture
             GlyphInfo glyph_info;
-            font_file.read(reinterpret_cast<char*>(&glyph_info), sizeof(GlyphInfo));
+            font_file.read(reinterpret_cast<char*>(&glyph_info), offsetof(GlyphInfo, ty));
             configuration.glyphs.emplace(glyph_info.glyph_index, glyph_info);
         }
 
@@ -162,17 +173,15 @@ Font::Font(const std::string& file, const std::string& name)
             {RenderingMode::Light, "light"},
             {RenderingMode::Mono, "mono"},
             {RenderingMode::LCD, "lcd"},
-            {RenderingMode::LCD_V, "lcd_v"}};
+            {RenderingMode::LCD_V, "lcd_v"},
+            {RenderingMode::DistanceField, "distance_field"}};
 
         // We need the Freetype font for Harfbuzz later on
         //auto* face = new FT_Face();
 
         FT_Face face;
 
-        auto p = file.substr(0, file.size() - 3);
-        p += "ttf";
-
-        const auto error = FT_New_Face(*freetype_library, p.c_str(), 0, &face);
+        const auto error = FT_New_Face(*freetype_library, ttf_path_.c_str(), 0, &face);
 
         FT_Set_Pixel_Sizes(face, 0, configuration.size);
 
@@ -190,4 +199,163 @@ Font::Font(const std::string& file, const std::string& name)
         font_file.peek();
     }
 }
+
+const Font::Configuration* Font::distance_field() const
+{
+    for(const auto& configuration : configurations_)
+    {
+        if(configuration->rendering_mode == RenderingMode::DistanceField)
+            return configuration.get();
+    }
+    return nullptr;
+}
+
+const Font::Configuration& Font::add_distance_field(int reference_size, int spread)
+{
+    if(const auto* existing = distance_field())
+        return *existing;
+
+    log_info(("Building distance field for : " + ttf_path_).c_str());
+
+    FT_Face face;
+
+    if(FT_New_Face(*freetype_library, ttf_path_.c_str(), 0, &face))
+        throw std::invalid_argument(
+            ("File at \"" + ttf_path_ + "\" could not be opened").c_str());
+
+    FT_Set_Pixel_Sizes(face, 0, reference_size);
+
+    auto& configuration = *configurations_.emplace_back(std::make_unique<Configuration>());
+
+    configuration.size           = reference_size;
+    configuration.rendering_mode = RenderingMode::DistanceField;
+    configuration.spread         = spread;
+    configuration.ascent         = face->size->metrics.ascender >> 6;
+    configuration.descent        = face->size->metrics.descender >> 6;
+    configuration.height         = face->size->metrics.height >> 6;
+    configuration.hb_font        = hb_ft_font_create(face, NULL);
+
+    // Fields of every glyph reachable from a character, the harfbuzz shaping
+    // giving us glyph indexes
+    std::vector<distance_field::Bitmap> fields;
+    std::vector<GlyphInfo>              infos;
+
+    FT_UInt  glyph_index = 0;
+    FT_ULong character   = FT_Get_First_Char(face, &glyph_index);
+
+    for(; glyph_index != 0; character = FT_Get_Next_Char(face, character, &glyph_index))
+    {
+        if(configuration.glyphs.contains(static_cast<int>(glyph_index)) ||
+           FT_Load_Glyph(face, glyph_index, FT_LOAD_RENDER))
+            continue;
+
+        const auto& slot   = *face->glyph;
+        const auto& bitmap = slot.bitmap;
+
+        GlyphInfo info;
+        info.glyph_index = static_cast<int>(glyph_index);
+        info.advance_x   = static_cast<float>(slot.advance.x) / 64.0f;
+        info.advance_y   = static_cast<float>(slot.advance.y) / 64.0f;
+
+        configuration.glyphs.emplace(info.glyph_index, info);
+
+        // Spaces don't need a quad
+        if(bitmap.width == 0 || bitmap.rows == 0 || bitmap.pixel_mode != FT_PIXEL_MODE_GRAY)
+            continue;
+
+        std::vector<std::uint8_t> coverage(std::size_t(bitmap.width) * bitmap.rows);
+
+        for(unsigned row = 0; row < bitmap.rows; row++)
+            std::copy_n(bitmap.buffer + static_cast<std::ptrdiff_t>(row) * bitmap.pitch,
+                        bitmap.width, coverage.data() + std::size_t(row) * bitmap.width);
+
+        // The quad grows with the field
+        info.glyph_width  = static_cast<float>(bitmap.width + 2 * spread);
+        info.glyph_height = static_cast<float>(bitmap.rows + 2 * spread);
+        info.bearing_x    = static_cast<float>(slot.bitmap_left - spread);
+        info.bearing_y    = static_cast<float>(slot.metrics.horiBearingY) / 64.0f + spread;
+        info.bitmap_top   = static_cast<float>(slot.bitmap_top + spread);
+
+        fields.push_back(distance_field::generate(coverage, bitmap.width, bitmap.rows,
+                                                  static_cast<unsigned>(spread)));
+        infos.push_back(info);
+    }
+
+    // Tallest glyphs first, inside the smallest square page they fit in
+    std::vector<std::size_t> order(fields.size());
+
+    for(std::size_t i = 0; i < order.size(); i++)
+        order[i] = i;
+
+    std::sort(order.begin(), order.end(),
+              [&](auto a, auto b) { return fields[a].height > fields[b].height; });
+
+    std::vector<MaxRects::Rect> rects(fields.size());
+
+    const auto pack = [&](unsigned size)
+    {
+        MaxRects bin(size, size);
+
+        // 1 pixel between glyphs, so filtering doesn't bleed the neighbours in
+        for(auto i : order)
+        {
+            if(!bin.insert(fields[i].width + 1u, fields[i].height + 1u, rects[i]))
+                return false;
+        }
+        return true;
+    };
+
+    const auto max_size = static_cast<unsigned>(RenderCommand::max_texture_size());
+
+    unsigned size = std::min(256u, max_size);
+
+    while(!pack(size))
+    {
+        if(size * 2u > max_size)
+        {
+            // Even the largest texture the context can allocate is too small
+            log_error(("Distance field glyphs of " + ttf_path_ + " don't fit inside a " +
+                       std::to_string(max_size) + "x" + std::to_string(max_size) + " texture")
+                          .c_str());
+
+            hb_font_destroy(static_cast<hb_font_t*>(configuration.hb_font));
+            FT_Done_Face(face);
+            configurations_.pop_back();
+
+            throw std::length_error(
+                ("Distance field of \"" + ttf_path_ + "\" is too large, use a smaller reference size")
+                    .c_str());
+        }
+        size *= 2u;
+    }
+
+    // Glyphs are stored upside down like inside the .fnt files
+    std::vector<unsigned char> pixels(std::size_t(size) * size, 0u);
+
+    for(std::size_t i = 0; i < fields.size(); i++)
+    {
+        const auto& field = fields[i];
+        const auto& rect  = rects[i];
+
+        for(unsigned row = 0; row < field.height; row++)
+            std::copy_n(field.pixels.data() + std::size_t(row) * field.width, field.width,
+                        pixels.data() + std::size_t(rect.y + field.height - 1u - row) * size +
+                            rect.x);
+
+        auto& info = configuration.glyphs.at(infos[i].glyph_index);
+        info       = infos[i];
+        info.tx    = static_cast<float>(rect.x) / static_cast<float>(size);
+        info.ty    = 1.0f - static_cast<float>(rect.y + field.height) / static_cast<float>(size);
+    }
+
+    // The field is filtered linearly, that's what gives back the outline
+    // between its pixels
+    configuration.texture.reset(new Texture(
+        ttf_path_ + "-distance_field", size, size, Texture::MinFilter::Linear,
+        Texture::MagFilter::Linear, Texture::Wrap::ClampToEdge, Texture::Wrap::ClampToEdge,
+        Texture::Format::RED, Texture::InternalFormat::R8, Texture::DataType::UnsignedByte,
+        pixels.data()));
+
+    return configuration;
+}
 }    // namespace corgi
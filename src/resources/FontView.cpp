@@ -2,6 +2,7 @@
 #include <corgi/resources/Font.h>
 #include <corgi/resources/FontView.h>
 
+#include <cmath>
 #include <exception>
 #include <stdexcept>
 
@@ -11,14 +12,40 @@ void FontView::set(int size, Font::RenderingMode rendering_mode)
 {
     int index = 0;
 
+    int distance_field = -1;
+
     for(const auto& configuration : font_->configurations_)
     {
+        if(configuration->rendering_mode == Font::RenderingMode::DistanceField)
+            distance_field = index;
+
         if(configuration->size == size && rendering_mode == configuration->rendering_mode)
         {
             current_configuration_index_ = index;
+            size_                        = 0;
+            return;
         }
         index++;
     }
+
+    // The distance field can be drawn at any size
+    if(distance_field != -1)
+    {
+        current_configuration_index_ = distance_field;
+        size_                        = size;
+    }
+}
+
+float FontView::scale() const
+{
+    check_errors();
+
+    const auto& configuration = *font_->configurations_[current_configuration_index_];
+
+    if(configuration.rendering_mode != Font::RenderingMode::DistanceField || size_ == 0)
+        return 1.0f;
+
+    return static_cast<float>(size_) / static_cast<float>(configuration.size);
 }
 
 void FontView::check_errors() const
@@ -38,6 +65,10 @@ void FontView::check_errors() const
 int FontView::font_size() const
 {
     check_errors();
+
+    if(size_ != 0)
+        return size_;
+
     return font_->configurations_[current_configuration_index_]->size;
 }
 
@@ -50,17 +81,17 @@ Font::RenderingMode FontView::rendering_mode() const
 long FontView::height() const
 {
     check_errors();
-    return font_->configurations_[current_configuration_index_]->height;
+    return std::lround(font_->configurations_[current_configuration_index_]->height * scale());
 }
 
 long FontView::descent() const
 {
     check_errors();
-    return font_->configurations_[current_configuration_index_]->descent;
+    return std::lround(font_->configurations_[current_configuration_index_]->descent * scale());
 }
 
 long FontView::ascent() const
 {
     check_errors();
-    return font_->configurations_[current_configuration_index_]->ascent;
+    return std::lround(font_->configurations_[current_configuration_index_]->ascent * scale());
 }
@@ -1,3 +1,4 @@
+#include <corgi/math/Bvh.h>
 #include <corgi/math/MathUtils.h>
 #include <corgi/rendering/RenderCommand.h>
 #include <corgi/rendering/renderer.h>
@@ -282,6 +283,10 @@ Mesh::Mesh(std::vector<VertexAttribute>&& attributes,
     , indexes_(std::move(indices))
 {
     meshes.push_back(this);
+
+    vertex_capacity_ = vertices_.size();
+    index_capacity_  = indexes_.size();
+
     RenderCommand::bind_vertex_array(vao_id_);
 
     RenderCommand::buffer_vertex_data(_vbo_index, vertices_.data(),
@@ -324,6 +329,10 @@ std::vector<Vertex> Mesh::add_vertices(int count)
 
 void Mesh::update_vertices()
 {
+    _bvh_dirty       = true;
+    vertex_capacity_ = vertices_.size();
+    index_capacity_  = indexes_.size();
+
     RenderCommand::bind_vertex_array(vao_id_);
 
     RenderCommand::buffer_vertex_data(_vbo_index, vertices_.data(),
@@ -350,6 +359,9 @@ void Mesh::clear()
 {
     vertices_.clear();
     indexes_.clear();
+    _bvh_dirty       = true;
+    vertex_capacity_ = 0;
+    index_capacity_  = 0;
 
     // TODO : I don't think I need to delete and remake the VBO, I could probably use glBufferSubData or something no?
     RenderCommand::delete_vertex_buffer_object(_vbo_index);
@@ -374,6 +386,48 @@ void Mesh::update_vertices_really()
         _vbo_index, vertices_.data(), static_cast<int>(vertices_.size() * sizeof(float)));
 }
 
+void Mesh::reserve(std::size_t vertex_capacity, std::size_t index_capacity)
+{
+    vertex_capacity_ = std::max(vertex_capacity, vertices_.size());
+    index_capacity_  = std::max(index_capacity, indexes_.size());
+    _bvh_dirty       = true;
+
+    RenderCommand::bind_vertex_array(vao_id_);
+
+    RenderCommand::allocate_vertex_data(_vbo_index, vertex_capacity_ * sizeof(float));
+    RenderCommand::buffer_vertex_subdata(_vbo_index, 0, vertices_.data(),
+                                         vertices_.size() * sizeof(float));
+
+    RenderCommand::allocate_index_data(_ibo_index, index_capacity_ * sizeof(unsigned int));
+    RenderCommand::buffer_index_subdata(_ibo_index, 0, indexes_.data(),
+                                        indexes_.size() * sizeof(unsigned int));
+
+    for(auto& attribute : _attributes)
+    {
+        RenderCommand::enable_vertex_attribute(attribute.location);
+        RenderCommand::vertex_attribute_pointer(attribute.location,
+                                                vertex_size() * sizeof(float),
+                                                attribute.offset, attribute.size);
+    }
+
+    RenderCommand::bind_vertex_array(0);
+    for(auto& attribute : _attributes)
+        RenderCommand::disable_vertex_attribute(attribute.location);
+}
+
+void Mesh::update_vertices(std::size_t first, std::size_t count)
+{
+    assert(first + count <= vertex_capacity_);
+
+    _bvh_dirty = true;
+
+    if(count == 0)
+        return;
+
+    RenderCommand::buffer_vertex_subdata(_vbo_index, first * sizeof(float),
+                                         vertices_.data() + first, count * sizeof(float));
+}
+
 std::vector<float>& Mesh::vertices()
 {
     return vertices_;
@@ -451,12 +505,36 @@ bool Vertex::has_attribute(int location) const
 
 void Mesh::set_vertices(float* vertices, int count)
 {
-    vertices_ = std::vector<float>(vertices, vertices + count);
+    vertices_  = std::vector<float>(vertices, vertices + count);
+    _bvh_dirty = true;
 }
 
 void Mesh::set_indices(unsigned* i, int count)
 {
-    indexes_ = std::vector<unsigned>(i, i + count);
+    indexes_   = std::vector<unsigned>(i, i + count);
+    _bvh_dirty = true;
+}
+
+const math::TriangleBvh& Mesh::bvh()
+{
+    if(!_bvh)
+        _bvh = std::make_unique<math::TriangleBvh>();
+
+    if(_bvh_dirty)
+    {
+        // We assume the position is the attribute at location 0
+        const auto* position = attribute(0);
+        const int   offset   = position != nullptr ? position->offset : 0;
+
+        if(_primitive_type == PrimitiveType::Triangles)
+            _bvh->build(vertices_.data(), vertex_size(), offset, indexes_.data(),
+                        static_cast<int>(indexes_.size()));
+        else
+            _bvh->clear();
+
+        _bvh_dirty = false;
+    }
+    return *_bvh;
 }
 
 std::vector<unsigned int>& Mesh::indexes()
@@ -1,3 +1,4 @@
+#include <corgi/filesystem/VirtualFileSystem.h>
 #include <corgi/logger/log.h>
 #include <corgi/resources/Shader.h>
 #include <glad/glad.h>
@@ -9,14 +10,6 @@ namespace corgi
 Shader::Shader(const std::string& path, const std::string& identifier)
 {
     //log_info("Shader Constructor for "+path);
-    std::string pathh = path.c_str();
-
-    if(pathh.find("_vs") != std::string::npos)
-        id_ = glCreateShader(GL_VERTEX_SHADER);
-    else if(pathh.find("_fs") != std::string::npos)
-        id_ = glCreateShader(GL_FRAGMENT_SHADER);
-    else
-        throw std::invalid_argument("Could not determine the shader from the path");
 
     // Loading the source code
 
@@ -24,7 +17,7 @@ Shader::Shader(const std::string& path, const std::string& identifier)
     std::string   code;
 
     if(!file.is_open())
-        throw std::invalid_argument("Could not load shader at : \"" + pathh + "\"");
+        throw std::invalid_argument("Could not load shader at : \"" + path + "\"");
 
     file.seekg(0, std::ios::end);
     code.reserve(std::string::size_type(file.tellg()));
@@ -32,11 +25,31 @@ Shader::Shader(const std::string& path, const std::string& identifier)
 
     code.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
 
-    auto cstr = code.c_str();
+    compile(path, code);
+}
+
+Shader::Shader(const filesystem::VirtualFileSystem& vfs, const std::string& identifier)
+{
+    const auto code = vfs.read(identifier);
+
+    compile(identifier, {reinterpret_cast<const char*>(code.data()), code.size()});
+}
+
+void Shader::compile(const std::string& path, std::string_view code)
+{
+    if(path.find("_vs") != std::string::npos)
+        id_ = glCreateShader(GL_VERTEX_SHADER);
+    else if(path.find("_fs") != std::string::npos)
+        id_ = glCreateShader(GL_FRAGMENT_SHADER);
+    else
+        throw std::invalid_argument("Could not determine the shader from the path");
 
     // Initializing the shader
 
-    glShaderSource(id_, 1, &cstr, NULL);
+    const auto* cstr   = code.data();
+    const auto  length = static_cast<GLint>(code.size());
+
+    glShaderSource(id_, 1, &cstr, &length);
     glCompileShader(id_);
 
     GLint success = 0;
@@ -57,10 +70,28 @@ Shader::Shader(const std::string& path, const std::string& identifier)
         log_error(errorLog.c_str());
 
         glDeleteShader(id_);
-        throw std::invalid_argument("Could not compile shader " + pathh);
+        throw std::invalid_argument("Could not compile shader " + path);
     }
 }
 
+bool Shader::reload(const std::string& identifier, std::string_view code)
+{
+    const auto previous = id_;
+
+    try
+    {
+        compile(identifier, code);
+    }
+    catch(const std::invalid_argument&)
+    {
+        id_ = previous;
+        return false;
+    }
+
+    glDeleteShader(previous);
+    return true;
+}
+
 Shader::~Shader()
 {
     glDeleteShader(id_);
@@ -1,6 +1,16 @@
 #include <corgi/resources/Tilemap.h>
 
+#include <corgi/filesystem/MappedFile.h>
+#include <corgi/utils/ResourcesCache.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
 #include <fstream>
+#include <stdexcept>
+#include <type_traits>
+#include <unordered_map>
+#include <utility>
 
 namespace corgi
 {
@@ -123,10 +133,14 @@ Tilemap::TileLayer::TileLayer(std::fstream& file)
 
     int data_size {0u};
     file.read(reinterpret_cast<char*>(&data_size), sizeof data_size);
-    data.resize(data_size / sizeof(long long));
+
+    // This format stores the ids on 64 bits
+    std::vector<long long> ids(data_size / sizeof(long long));
 
     if(data_size != 0)
-        file.read(reinterpret_cast<char*>(&data[0]), data_size);
+        file.read(reinterpret_cast<char*>(&ids[0]), data_size);
+
+    data = TileData(std::vector<std::uint32_t>(ids.begin(), ids.end()));
 
     read_properties(file, properties);
 }
@@ -209,6 +223,30 @@ static void read_tileset_info(std::fstream& file, Tilemap::TilesetInfo& tileset_
 
 Tilemap::Tilemap(const std::string& path, const std::string& identifier)
     : identifier(identifier)
+{
+    char magic[4] {};
+
+    {
+        std::ifstream file(path.c_str(), std::ifstream::binary);
+
+        if(!file.is_open())
+            throw std::invalid_argument("Path is not valid");
+
+        file.read(magic, sizeof magic);
+    }
+
+    if(std::equal(std::begin(magic), std::end(magic), std::begin(binary_magic)))
+        load_binary(path);
+    else
+        load_legacy(path);
+
+    build_lookup_tables();
+
+    for(const auto& tileset_info : tileset_infos)
+        ResourcesCache::add_dependency(identifier, tileset_info.image);
+}
+
+void Tilemap::load_legacy(const std::string& path)
 {
     std::fstream file(path.c_str(), std::fstream::binary | std::fstream::in);
 
@@ -260,4 +298,817 @@ Tilemap::Tilemap(const std::string& path, const std::string& identifier)
     for(size_t i {0u}; i < object_groups_size; ++i)
         object_groups.emplace_back(file);
 }
+
+void Tilemap::build_lookup_tables()
+{
+    animations.clear();
+    gid_to_tileset_.clear();
+
+    for(int t = 0; t < static_cast<int>(tileset_infos.size()); ++t)
+    {
+        auto& tileset_info = tileset_infos[t];
+
+        // tile_count should be enough, but the ids of the TileInfo are
+        // trusted too in case the tileset was modified by hand
+        int size = std::max(tileset_info.tile_count, 0);
+
+        for(const auto& tile : tileset_info.tiles)
+            size = std::max(size, tile.id + 1);
+
+        tileset_info.lookups.assign(size, TileLookup());
+
+        for(int i = 0; i < static_cast<int>(tileset_info.tiles.size()); ++i)
+        {
+            const auto& tile = tileset_info.tiles[i];
+
+            if(tile.id < 0)
+                continue;
+
+            auto& lookup = tileset_info.lookups[tile.id];
+            lookup.info  = i;
+
+            if(tile.animations.empty())
+                continue;
+
+            AnimationInfo animation;
+            animation.tileset = t;
+            animation.info    = i;
+
+            for(const auto& frame : tile.animations)
+                animation.duration += frame.duration;
+
+            lookup.animation = static_cast<std::int32_t>(animations.size());
+            animations.push_back(animation);
+        }
+
+        const auto end = static_cast<std::size_t>(tileset_info.firstgid) + size;
+
+        if(gid_to_tileset_.size() < end)
+            gid_to_tileset_.resize(end, -1);
+    }
+
+    // A gid belongs to the tileset with the highest firstgid that is lower
+    // or equal to it, like extract_tileset_from_tileid used to search for
+    for(std::size_t gid = 0; gid < gid_to_tileset_.size(); ++gid)
+    {
+        for(int t = static_cast<int>(tileset_infos.size()) - 1; t >= 0; --t)
+        {
+            if(tileset_infos[t].firstgid <= static_cast<long long>(gid))
+            {
+                gid_to_tileset_[gid] = t;
+                break;
+            }
+        }
+    }
+}
+
+int Tilemap::tileset_index(long long gid) const noexcept
+{
+    if(gid < 0)
+        return -1;
+
+    if(gid < static_cast<long long>(gid_to_tileset_.size()))
+        return gid_to_tileset_[gid];
+
+    if(gid_to_tileset_.empty())
+        return -1;
+
+    return gid_to_tileset_.back();
+}
+
+const Tilemap::TileLookup& Tilemap::TilesetInfo::lookup(long long tile_id) const noexcept
+{
+    static const TileLookup none;
+
+    if(tile_id < 0 || tile_id >= static_cast<long long>(lookups.size()))
+        return none;
+
+    return lookups[tile_id];
+}
+
+// TileData
+
+Tilemap::TileData::TileData(std::vector<std::uint32_t> tiles)
+    : tiles_(std::move(tiles))
+{
+    view_ = tiles_;
+}
+
+Tilemap::TileData::TileData(std::span<const std::uint32_t> tiles,
+                            std::shared_ptr<const void>    owner)
+    : view_(tiles)
+    , owner_(std::move(owner))
+{
+}
+
+Tilemap::TileData::TileData(const TileData& other)
+    : tiles_(other.tiles_)
+    , owner_(other.owner_)
+{
+    view_ = other.is_mapped() ? other.view_ : std::span<const std::uint32_t>(tiles_);
+}
+
+Tilemap::TileData::TileData(TileData&& other) noexcept
+    : view_(std::exchange(other.view_, {}))
+    , tiles_(std::move(other.tiles_))
+    , owner_(std::move(other.owner_))
+{
+    // Moving the vector keeps its buffer, so view_ is still valid
+}
+
+Tilemap::TileData& Tilemap::TileData::operator=(const TileData& other)
+{
+    if(this != &other)
+    {
+        TileData copy(other);
+        *this = std::move(copy);
+    }
+    return *this;
+}
+
+Tilemap::TileData& Tilemap::TileData::operator=(TileData&& other) noexcept
+{
+    if(this != &other)
+    {
+        view_  = std::exchange(other.view_, {});
+        tiles_ = std::move(other.tiles_);
+        owner_ = std::move(other.owner_);
+    }
+    return *this;
+}
+
+void Tilemap::TileData::set(std::size_t index, std::uint32_t tile)
+{
+    if(is_mapped())
+    {
+        tiles_.assign(view_.begin(), view_.end());
+        view_ = tiles_;
+        owner_.reset();
+    }
+    tiles_[index] = tile;
+}
+
+// Binary format
+//
+// A FileHeader followed by sections of fixed size records. Records reference
+// each other through (first, count) ranges, and strings through their offset
+// inside the string table. Every section starts on a 64 bytes boundary
+
+namespace
+{
+constexpr std::size_t section_alignment = 64;
+
+struct Section
+{
+    std::uint64_t offset {0};
+
+    // Record count, or byte count for the string table
+    std::uint64_t count {0};
+};
+
+struct FileHeader
+{
+    char          magic[4];
+    std::uint32_t version;
+    std::uint32_t header_size;
+
+    std::int32_t  width;
+    std::int32_t  height;
+    std::int32_t  tile_width;
+    std::int32_t  tile_height;
+    std::int32_t  next_layer_id;
+    std::int32_t  next_object_id;
+    float         tiled_format_version;
+    std::uint32_t infinite;
+
+    std::uint32_t orientation;
+    std::uint32_t render_order;
+    std::uint32_t tiled_version;
+    std::uint32_t type;
+
+    Section strings;
+    Section tilesets;
+    Section terrains;
+    Section tiles;
+    Section animations;
+    Section tile_layers;
+    Section object_groups;
+    Section objects;
+    Section points;
+    Section properties;
+};
+
+struct Range
+{
+    std::uint32_t first {0};
+    std::uint32_t count {0};
+};
+
+struct PropertyRecord
+{
+    std::uint32_t name;
+    std::uint32_t type;
+
+    // Value's bits, or the string's offset inside the string table
+    std::uint32_t value;
+};
+
+struct TerrainRecord
+{
+    std::uint32_t name;
+    std::int32_t  tile;
+};
+
+struct TileRecord
+{
+    std::int32_t id;
+    float        probability;
+    std::int32_t terrain[4];
+    Range        animations;
+};
+
+struct TilesetRecord
+{
+    std::int32_t  firstgid;
+    std::int32_t  columns;
+    std::int32_t  image_height;
+    std::int32_t  image_width;
+    std::int32_t  margin;
+    std::int32_t  tile_count;
+    std::uint32_t tile_height;
+    std::uint32_t tile_width;
+    std::int32_t  spacing;
+
+    std::uint32_t image;
+    std::uint32_t name;
+    std::uint32_t transparent_color;
+
+    Range terrains;
+    Range tiles;
+};
+
+struct LayerRecord
+{
+    std::uint32_t name;
+    std::int32_t  id;
+    float         x;
+    float         y;
+    float         opacity;
+    std::uint32_t visible;
+
+    Range properties;
+};
+
+struct TileLayerRecord
+{
+    LayerRecord layer;
+
+    float width;
+    float height;
+
+    // Absolute offset of the tile ids inside the file
+    Section data;
+};
+
+struct ObjectGroupRecord
+{
+    LayerRecord   layer;
+    std::uint32_t draw_order;
+    Range         objects;
+};
+
+struct ObjectRecord
+{
+    std::int32_t  id;
+    std::int32_t  gid;
+    std::uint32_t type;
+    std::uint32_t name;
+    std::uint32_t visible;
+    float         rotation;
+    float         x;
+    float         y;
+    float         width;
+    float         height;
+
+    Range polyline;
+    Range polygon;
+    Range properties;
+};
+
+static_assert(std::is_trivially_copyable_v<Tilemap::TileAnimation>);
+static_assert(std::is_trivially_copyable_v<Tilemap::Object::Point>);
+
+/*!
+ * @brief   Gathers the records while they are written, so the strings are
+ *          only stored once
+ */
+class BinaryWriter
+{
+public:
+    std::uint32_t intern(const std::string& string)
+    {
+        const auto it = string_ids_.find(string);
+
+        if(it != string_ids_.end())
+            return it->second;
+
+        const auto id     = static_cast<std::uint32_t>(strings_.size());
+        const auto length = static_cast<std::uint32_t>(string.size());
+
+        strings_.resize(strings_.size() + sizeof length);
+        std::memcpy(strings_.data() + id, &length, sizeof length);
+        strings_.insert(strings_.end(), string.begin(), string.end());
+        strings_.push_back('\0');
+
+        string_ids_.emplace(string, id);
+        return id;
+    }
+
+    Range add_properties(const std::vector<Tilemap::Property>& properties)
+    {
+        Range range {static_cast<std::uint32_t>(property_records.size()),
+                     static_cast<std::uint32_t>(properties.size())};
+
+        for(const auto& property : properties)
+        {
+            PropertyRecord record {intern(property.name_),
+                                   static_cast<std::uint32_t>(property.type), 0u};
+
+            switch(property.type)
+            {
+                case Tilemap::Property::Type::Bool:
+                    record.value = property.bool_value ? 1u : 0u;
+                    break;
+                case Tilemap::Property::Type::Float:
+                    std::memcpy(&record.value, &property.float_value, sizeof(float));
+                    break;
+                case Tilemap::Property::Type::Int:
+                    std::memcpy(&record.value, &property.int_value, sizeof(int));
+                    break;
+                case Tilemap::Property::Type::String:
+                    record.value = intern(property.string_value);
+                    break;
+            }
+            property_records.push_back(record);
+        }
+        return range;
+    }
+
+    LayerRecord make_layer(const Tilemap::Layer& layer)
+    {
+        return {intern(layer.name), layer.id,      layer.x,
+                layer.y,            layer.opacity, layer.visible ? 1u : 0u,
+                add_properties(layer.properties)};
+    }
+
+    template<class T>
+    Section append(const T* records, std::size_t count)
+    {
+        align();
+
+        Section section {file.size(), count};
+
+        const auto* bytes = reinterpret_cast<const char*>(records);
+        file.insert(file.end(), bytes, bytes + count * sizeof(T));
+        return section;
+    }
+
+    template<class T>
+    Section append(const std::vector<T>& records)
+    {
+        return append(records.data(), records.size());
+    }
+
+    Section append_strings() { return append(strings_.data(), strings_.size()); }
+
+    void align() { file.resize((file.size() + section_alignment - 1) & ~(section_alignment - 1)); }
+
+    std::vector<char> file;
+
+    std::vector<PropertyRecord>         property_records;
+    std::vector<TerrainRecord>          terrain_records;
+    std::vector<TileRecord>             tile_records;
+    std::vector<Tilemap::TileAnimation> animations;
+    std::vector<ObjectRecord>           object_records;
+    std::vector<Tilemap::Object::Point> points;
+
+private:
+    std::vector<char>                              strings_;
+    std::unordered_map<std::string, std::uint32_t> string_ids_;
+};
+
+/*!
+ * @brief   Validates the records of the mapped file before they are used
+ */
+class BinaryReader
+{
+public:
+    explicit BinaryReader(const filesystem::MappedFile& file)
+        : file_(file)
+    {
+    }
+
+    template<class T>
+    std::span<const T> section(const Section& section) const
+    {
+        if(section.count == 0)
+            return {};
+
+        if(section.offset % alignof(T) != 0 || section.offset > file_.size() ||
+           section.count > (file_.size() - section.offset) / sizeof(T))
+            throw std::invalid_argument("Tilemap file is corrupted");
+
+        return {reinterpret_cast<const T*>(file_.data() + section.offset),
+                static_cast<std::size_t>(section.count)};
+    }
+
+    template<class T>
+    static std::span<const T> range(std::span<const T> records, const Range& range)
+    {
+        if(range.first > records.size() || range.count > records.size() - range.first)
+            throw std::invalid_argument("Tilemap file is corrupted");
+
+        return records.subspan(range.first, range.count);
+    }
+
+    std::string string(std::uint32_t id) const
+    {
+        std::uint32_t length {0};
+
+        if(id > strings.size() || strings.size() - id < sizeof length)
+            throw std::invalid_argument("Tilemap file is corrupted");
+
+        std::memcpy(&length, strings.data() + id, sizeof length);
+
+        if(length > strings.size() - id - sizeof length)
+            throw std::invalid_argument("Tilemap file is corrupted");
+
+        return std::string(strings.data() + id + sizeof length, length);
+    }
+
+    void read_properties(const Range& range, std::vector<Tilemap::Property>& properties) const
+    {
+        for(const auto& record : BinaryReader::range(property_records, range))
+        {
+            auto name = string(record.name);
+
+            switch(static_cast<Tilemap::Property::Type>(record.type))
+            {
+                case Tilemap::Property::Type::Bool:
+                    properties.emplace_back(name, record.value != 0u);
+                    break;
+                case Tilemap::Property::Type::Float:
+                {
+                    float value;
+                    std::memcpy(&value, &record.value, sizeof value);
+                    properties.emplace_back(name, value);
+                    break;
+                }
+                case Tilemap::Property::Type::Int:
+                {
+                    int value;
+                    std::memcpy(&value, &record.value, sizeof value);
+                    properties.emplace_back(name, value);
+                    break;
+                }
+                case Tilemap::Property::Type::String:
+                    properties.emplace_back(name, string(record.value));
+                    break;
+            }
+        }
+    }
+
+    /*!
+     * @brief   Returns the tile ids of a layer, once checked they hold
+     *          exactly width * height tiles
+     */
+    std::span<const std::uint32_t> tiles(const TileLayerRecord& record) const
+    {
+        // Past 2^24, floats can't hold every whole number anymore
+        const auto is_size = [](float value)
+        {
+            return std::isfinite(value) && value >= 0.0f && value <= 16777216.0f &&
+                   value == std::floor(value);
+        };
+
+        if(!is_size(record.width) || !is_size(record.height) ||
+           record.data.count !=
+               static_cast<std::uint64_t>(record.width) * static_cast<std::uint64_t>(record.height))
+            throw std::invalid_argument("Tilemap file is corrupted");
+
+        return section<std::uint32_t>(record.data);
+    }
+
+    void read_layer(const LayerRecord& record, Tilemap::Layer& layer) const
+    {
+        layer.name    = string(record.name);
+        layer.id      = record.id;
+        layer.x       = record.x;
+        layer.y       = record.y;
+        layer.opacity = record.opacity;
+        layer.visible = record.visible != 0u;
+        read_properties(record.properties, layer.properties);
+    }
+
+    std::span<const char>           strings;
+    std::span<const PropertyRecord> property_records;
+
+private:
+    const filesystem::MappedFile& file_;
+};
+}    // namespace
+
+void Tilemap::load_binary(const std::string& path)
+{
+    auto file = std::make_shared<filesystem::MappedFile>(path);
+
+    if(!file->is_open() || file->size() < sizeof(FileHeader))
+        throw std::invalid_argument("Path is not valid");
+
+    FileHeader header;
+    std::memcpy(&header, file->data(), sizeof header);
+
+    if(header.version != binary_version || header.header_size != sizeof(FileHeader))
+        throw std::invalid_argument("Unsupported tilemap file version");
+
+    BinaryReader reader(*file);
+
+    reader.strings          = reader.section<char>(header.strings);
+    reader.property_records = reader.section<PropertyRecord>(header.properties);
+
+    width          = header.width;
+    height         = header.height;
+    tile_width     = header.tile_width;
+    tile_height    = header.tile_height;
+    nextlayerid    = header.next_layer_id;
+    next_object_id = header.next_object_id;
+    version        = header.tiled_format_version;
+    infinite       = header.infinite != 0u;
+
+    orientation   = reader.string(header.orientation);
+    render_order  = reader.string(header.render_order);
+    tiled_version = reader.string(header.tiled_version);
+    type          = reader.string(header.type);
+
+    const auto terrains   = reader.section<TerrainRecord>(header.terrains);
+    const auto tiles      = reader.section<TileRecord>(header.tiles);
+    const auto animations = reader.section<TileAnimation>(header.animations);
+    const auto objects    = reader.section<ObjectRecord>(header.objects);
+    const auto points     = reader.section<Object::Point>(header.points);
+
+    const auto tilesets = reader.section<TilesetRecord>(header.tilesets);
+    tileset_infos.reserve(tilesets.size());
+
+    for(const auto& record : tilesets)
+    {
+        auto& tileset_info = tileset_infos.emplace_back();
+
+        tileset_info.firstgid          = record.firstgid;
+        tileset_info.columns           = record.columns;
+        tileset_info.image_height      = record.image_height;
+        tileset_info.image_width       = record.image_width;
+        tileset_info.margin            = record.margin;
+        tileset_info.tile_count        = record.tile_count;
+        tileset_info.tile_height       = record.tile_height;
+        tileset_info.tile_width        = record.tile_width;
+        tileset_info.spacing           = record.spacing;
+        tileset_info.image             = reader.string(record.image);
+        tileset_info.name              = reader.string(record.name);
+        tileset_info.transparent_color = reader.string(record.transparent_color);
+
+        for(const auto& terrain : BinaryReader::range(terrains, record.terrains))
+            tileset_info.terrains.emplace_back(reader.string(terrain.name), terrain.tile);
+
+        const auto tileset_tiles = BinaryReader::range(tiles, record.tiles);
+        tileset_info.tiles.reserve(tileset_tiles.size());
+
+        for(const auto& tile : tileset_tiles)
+        {
+            auto& tile_info      = tileset_info.tiles.emplace_back();
+            tile_info.id         = tile.id;
+            tile_info.probablity = tile.probability;
+            std::copy(std::begin(tile.terrain), std::end(tile.terrain), tile_info.terrain);
+
+            const auto frames = BinaryReader::range(animations, tile.animations);
+            tile_info.animations.assign(frames.begin(), frames.end());
+        }
+    }
+
+    const auto layers = reader.section<TileLayerRecord>(header.tile_layers);
+    tile_layers.reserve(layers.size());
+
+    for(const auto& record : layers)
+    {
+        auto& layer = tile_layers.emplace_back();
+        reader.read_layer(record.layer, layer);
+
+        layer.width  = record.width;
+        layer.height = record.height;
+
+        // The ids stay inside the mapped file
+        layer.data = TileData(reader.tiles(record), file);
+    }
+
+    const auto groups = reader.section<ObjectGroupRecord>(header.object_groups);
+    object_groups.reserve(groups.size());
+
+    for(const auto& record : groups)
+    {
+        auto& group = object_groups.emplace_back();
+        reader.read_layer(record.layer, group);
+
+        group.draw_order = reader.string(record.draw_order);
+
+        const auto group_objects = BinaryReader::range(objects, record.objects);
+        group.objects.reserve(group_objects.size());
+
+        for(const auto& object_record : group_objects)
+        {
+            auto& object    = group.objects.emplace_back();
+            object.id       = object_record.id;
+            object.gid      = object_record.gid;
+            object.type     = reader.string(object_record.type);
+            object.name     = reader.string(object_record.name);
+            object.visible  = object_record.visible != 0u;
+            object.rotation = object_record.rotation;
+            object.x        = object_record.x;
+            object.y        = object_record.y;
+            object.width    = object_record.width;
+            object.height   = object_record.height;
+
+            const auto polyline = BinaryReader::range(points, object_record.polyline);
+            const auto polygon  = BinaryReader::range(points, object_record.polygon);
+
+            object.polyline.assign(polyline.begin(), polyline.end());
+            object.polygon.assign(polygon.begin(), polygon.end());
+
+            reader.read_properties(object_record.properties, object.properties);
+        }
+    }
+}
+
+void Tilemap::save(const std::string& path) const
+{
+    BinaryWriter writer;
+
+    FileHeader header {};
+    std::copy(std::begin(binary_magic), std::end(binary_magic), header.magic);
+
+    header.version              = binary_version;
+    header.header_size          = sizeof(FileHeader);
+    header.width                = width;
+    header.height               = height;
+    header.tile_width           = tile_width;
+    header.tile_height          = tile_height;
+    header.next_layer_id        = nextlayerid;
+    header.next_object_id       = next_object_id;
+    header.tiled_format_version = version;
+    header.infinite             = infinite ? 1u : 0u;
+    header.orientation          = writer.intern(orientation);
+    header.render_order         = writer.intern(render_order);
+    header.tiled_version        = writer.intern(tiled_version);
+    header.type                 = writer.intern(type);
+
+    std::vector<TilesetRecord> tilesets;
+
+    for(const auto& tileset_info : tileset_infos)
+    {
+        TilesetRecord record {};
+        record.firstgid          = tileset_info.firstgid;
+        record.columns           = tileset_info.columns;
+        record.image_height      = tileset_info.image_height;
+        record.image_width       = tileset_info.image_width;
+        record.margin            = tileset_info.margin;
+        record.tile_count        = tileset_info.tile_count;
+        record.tile_height       = tileset_info.tile_height;
+        record.tile_width        = tileset_info.tile_width;
+        record.spacing           = tileset_info.spacing;
+        record.image             = writer.intern(tileset_info.image);
+        record.name              = writer.intern(tileset_info.name);
+        record.transparent_color = writer.intern(tileset_info.transparent_color);
+
+        record.terrains = {static_cast<std::uint32_t>(writer.terrain_records.size()),
+                           static_cast<std::uint32_t>(tileset_info.terrains.size())};
+
+        for(const auto& terrain : tileset_info.terrains)
+            writer.terrain_records.push_back({writer.intern(terrain.name), terrain.tile});
+
+        record.tiles = {static_cast<std::uint32_t>(writer.tile_records.size()),
+                        static_cast<std::uint32_t>(tileset_info.tiles.size())};
+
+        for(const auto& tile : tileset_info.tiles)
+        {
+            TileRecord tile_record {};
+            tile_record.id          = tile.id;
+            tile_record.probability = tile.probablity;
+            std::copy(std::begin(tile.terrain), std::end(tile.terrain), tile_record.terrain);
+
+            tile_record.animations = {static_cast<std::uint32_t>(writer.animations.size()),
+                                      static_cast<std::uint32_t>(tile.animations.size())};
+
+            writer.animations.insert(writer.animations.end(), tile.animations.begin(),
+                                     tile.animations.end());
+
+            writer.tile_records.push_back(tile_record);
+        }
+
+        tilesets.push_back(record);
+    }
+
+    std::vector<TileLayerRecord> layers;
+
+    for(const auto& layer : tile_layers)
+    {
+        TileLayerRecord record {};
+        record.layer  = writer.make_layer(layer);
+        record.width  = layer.width;
+        record.height = layer.height;
+        layers.push_back(record);
+    }
+
+    std::vector<ObjectGroupRecord> groups;
+
+    for(const auto& group : object_groups)
+    {
+        ObjectGroupRecord record {};
+        record.layer      = writer.make_layer(group);
+        record.draw_order = writer.intern(group.draw_order);
+        record.objects    = {static_cast<std::uint32_t>(writer.object_records.size()),
+                             static_cast<std::uint32_t>(group.objects.size())};
+
+        for(const auto& object : group.objects)
+        {
+            ObjectRecord object_record {};
+            object_record.id       = object.id;
+            object_record.gid      = object.gid;
+            object_record.type     = writer.intern(object.type);
+            object_record.name     = writer.intern(object.name);
+            object_record.visible  = object.visible ? 1u : 0u;
+            object_record.rotation = object.rotation;
+            object_record.x        = object.x;
+            object_record.y        = object.y;
+            object_record.width    = object.width;
+            object_record.height   = object.height;
+
+            object_record.polyline = {static_cast<std::uint32_t>(writer.points.size()),
+                                      static_cast<std::uint32_t>(object.polyline.size())};
+            writer.points.insert(writer.points.end(), object.polyline.begin(),
+                                 object.polyline.end());
+
+            object_record.polygon = {static_cast<std::uint32_t>(writer.points.size()),
+                                     static_cast<std::uint32_t>(object.polygon.size())};
+            writer.points.insert(writer.points.end(), object.polygon.begin(),
+                                 object.polygon.end());
+
+            object_record.properties = writer.add_properties(object.properties);
+
+            writer.object_records.push_back(object_record);
+        }
+        groups.push_back(record);
+    }
+
+    // Every string is interned, we can now lay out the file
+
+    writer.file.resize(sizeof(FileHeader));
+
+    header.strings       = writer.append_strings();
+    header.tilesets      = writer.append(tilesets);
+    header.terrains      = writer.append(writer.terrain_records);
+    header.tiles         = writer.append(writer.tile_records);
+    header.animations    = writer.append(writer.animations);
+    header.objects       = writer.append(writer.object_records);
+    header.points        = writer.append(writer.points);
+    header.properties    = writer.append(writer.property_records);
+    header.object_groups = writer.append(groups);
+
+    for(std::size_t i = 0; i < tile_layers.size(); ++i)
+    {
+        const auto tiles = tile_layers[i].data.span();
+        layers[i].data   = writer.append(tiles.data(), tiles.size());
+    }
+
+    header.tile_layers = writer.append(layers);
+
+    std::memcpy(writer.file.data(), &header, sizeof header);
+
+    std::ofstream file(path.c_str(), std::ofstream::binary | std::ofstream::trunc);
+
+    if(!file.is_open())
+        throw std::invalid_argument("Path is not valid");
+
+    file.write(writer.file.data(), static_cast<std::streamsize>(writer.file.size()));
+}
+
+long long Tilemap::memory_usage() const
+{
+    long long usage = sizeof(Tilemap);
+
+    // Mapped tiles are part of the page cache, not of the tilemap
+    for(const auto& layer : tile_layers)
+    {
+        if(!layer.data.is_mapped())
+            usage += static_cast<long long>(layer.data.size() * sizeof(std::uint32_t));
+    }
+    return usage;
+}
 }    // namespace corgi
@@ -1,8 +1,10 @@
 #include <corgi/resources/image.h>
 
+#include <corgi/filesystem/MappedFile.h>
 #include <corgi/logger/log.h>
+#include <corgi/utils/StagingPool.h>
 
-#include <fstream>
+#include <cstring>
 
 #include "config.h"
 
@@ -16,36 +18,38 @@ namespace corgi
 		f +=img;
 		f += ".dat";
 
-        std::ifstream file(f, std::ifstream::binary);
+        // The file is mapped and its pixels copied once, into a buffer of the
+        // staging pool instead of a new one
+        filesystem::MappedFile file(f);
 
-        if (!file.is_open())
+        if (!file.is_open() || file.size() < 3 * sizeof(int))
         {
 			//+ std::string(img)
             log_error("Could not load image ");
+            _width = _height = _channel = 0;
+            return;
         }
 
-        char buffer[sizeof(int)];
-
-        file.read(buffer, sizeof(int));
-        _width = *(int*) buffer;
+        std::memcpy(&_width, file.data(), sizeof(int));
+        std::memcpy(&_height, file.data() + sizeof(int), sizeof(int));
+        std::memcpy(&_channel, file.data() + 2 * sizeof(int), sizeof(int));
 
-        file.read(buffer, sizeof(int));
-        _height = *(int*) buffer;
+		const auto size = std::size_t(_width) * _height * _channel;
 
-        file.read(buffer, sizeof(int));
-        _channel = *(int*) buffer;
+        if (file.size() < 3 * sizeof(int) + size)
+        {
+            log_error("Could not load image ");
+            _width = _height = _channel = 0;
+            return;
+        }
 
-        _pixels = new unsigned char[_width*_height*_channel];
-		int size = _width * _height * _channel;
-        file.read(reinterpret_cast<char*>(_pixels), static_cast<long long>(size));
+        _pixels = reinterpret_cast<Byte*>(StagingPool::shared().allocate(size));
+        std::memcpy(_pixels, file.data() + 3 * sizeof(int), size);
     }
 
     Image::~Image()
     {
-        if (_pixels != nullptr)
-        {
-            delete _pixels; 
-        }
+        StagingPool::shared().release(_pixels);
     }
 
     Image::Image(int width, int height, int channel, Byte* data)
@@ -54,7 +58,8 @@ namespace corgi
     Image::Image(int width, int height, int channel) :
          _width(width), _height(height),_channel(channel)
     {
-        _pixels = new Byte[width*height*channel];
+        _pixels = reinterpret_cast<Byte*>(
+            StagingPool::shared().allocate(std::size_t(width) * height * channel));
     }
 
     int Image::width()const
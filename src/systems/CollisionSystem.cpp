@@ -70,74 +70,36 @@ void CollisionSystem::update(float elapsed_time)
     for(auto& collider : _collider2D_pool)
         collider.colliding = false;
 
+    update_world_colliders();
+
     auto* collider2D_pool = _collider2D_pool.data();
 
-    // TODO : There's way too much things happening here. It'd be nice to check a bit what's actually happening
-    for(int i = 0; i < _collider2D_pool.size(); ++i)
+    for(size_t i = 0; i < _collider2D_pool.size(); ++i)
     {
-        for(auto j = i + 1; j < _collider2D_pool.size(); j++)
-        {
-            EntityId id_a = _collider2D_pool.entity_id(i);
-            EntityId id_b = _collider2D_pool.entity_id(j);
+        const auto& first = _world_colliders[i];
 
-            BoxCollider2D& first_collider  = collider2D_pool[i];
-            BoxCollider2D& second_collider = collider2D_pool[j];
+        if(!first.enabled)
+            continue;
 
-            auto& first_entity = _scene.entity_contiguous().at(
-                _collider2D_pool.component_index_to_entity_id().at(i));
-            auto& second_entity = _scene.entity_contiguous().at(
-                _collider2D_pool.component_index_to_entity_id().at(j));
+        for(auto j = i + 1; j < _collider2D_pool.size(); j++)
+        {
+            const auto& second = _world_colliders[j];
 
-            if(!first_collider.is_enabled() || !second_collider.is_enabled() ||
-               !first_entity.is_enabled() || !second_entity.is_enabled())
+            if(!second.enabled)
                 continue;
 
-            if(!_physic.layer_colliding(first_collider.layer(), second_collider.layer()))
+            if(!_physic.layer_colliding(first.layer, second.layer))
                 continue;
 
-            /*
-				for (auto& axe : first_collider.axes())
-					axes.emplace_back(axe);
-
-				for (auto& axe : second_collider.axes())
-					axes.emplace_back(axe);*/
-
-            const auto world_matrix_a = _transforms.get(first_entity.id()).world_matrix();
-            const auto world_matrix_b =
-                _transforms.get(second_entity.id()).world_matrix();
-
-            auto world_matrix_a_without_translation =
-                _transforms.get(first_entity.id()).world_matrix();
-            auto world_matrix_b_without_translation =
-                _transforms.get(second_entity.id()).world_matrix();
-
-            world_matrix_a_without_translation[12] = 0.0f;
-            world_matrix_b_without_translation[12] = 0.0f;
+            Vec2 minimum_translation;
 
-            world_matrix_a_without_translation[13] = 0.0f;
-            world_matrix_b_without_translation[13] = 0.0f;
-
-            world_matrix_a_without_translation[14] = 0.0f;
-            world_matrix_b_without_translation[14] = 0.0f;
-
-            // For the edges we need to remove the translation component
-            // from the world matrix as it fucks up the vectors
-
-            auto result = corgi::math::intersect_2D(
-                first_collider.positions().data(),
-                static_cast<int>(first_collider.positions().size()),
-                second_collider.positions().data(),
-                static_cast<int>(second_collider.positions().size()), world_matrix_a,
-                world_matrix_b, first_collider.axes().data(),
-                static_cast<int>(first_collider.axes().size()),
-                second_collider.axes().data(),
-                static_cast<int>(second_collider.axes().size()),
-                world_matrix_a_without_translation, world_matrix_b_without_translation);
-
-            if(result)
+            if(math::intersect_oriented_boxes(first.box, second.box, minimum_translation))
             {
-                first_collider.colliding  = true;
-                second_collider.colliding = true;
+                EntityId id_a = first.entity;
+                EntityId id_b = second.entity;
+
+                collider2D_pool[i].colliding = true;
+                collider2D_pool[j].colliding = true;
                 // If they are, we check if the collision has already
                 // been registered previously
 
@@ -145,21 +107,17 @@ void CollisionSystem::update(float elapsed_time)
                 {
                     // If not, we add the collision to our collision list
                     // we run the on_enter_ callbacks
-                    _enter_collisions.push_back({id_a, id_b});
+                    _enter_collisions.push_back({id_a, id_b, true, minimum_translation});
 
-                    first_collider.on_enter.invoke(first_entity, second_entity,
-                                                   first_collider, second_collider);
-                    second_collider.on_enter.invoke(second_entity, first_entity,
-                                                    second_collider, first_collider);
+                    _pending_callbacks.push(id_a, id_b, CollisionCallback::Enter);
+                    _pending_callbacks.push(id_b, id_a, CollisionCallback::Enter);
                 }
 
                 // We register all the collision that occurred during this frame
-                newCollisions.push_back({id_a, id_b, true});
+                newCollisions.push_back({id_a, id_b, true, minimum_translation});
 
-                first_collider.on_collision.invoke(first_entity, second_entity,
-                                                   first_collider, second_collider);
-                second_collider.on_collision.invoke(second_entity, first_entity,
-                                                    second_collider, first_collider);
+                _pending_callbacks.push(id_a, id_b, CollisionCallback::Stay);
+                _pending_callbacks.push(id_b, id_a, CollisionCallback::Stay);
             }
         }
     }
@@ -195,17 +153,74 @@ void CollisionSystem::update(float elapsed_time)
             {
                 _exit_collisions.push_back(collision);
 
-                auto& ea = _scene.get_entity(collision.entity_a);
-                auto& eb = _scene.get_entity(collision.entity_b);
-
-                auto& ca = _collider2D_pool.get(collision.entity_a);
-                auto& cb = _collider2D_pool.get(collision.entity_b);
-
-                _collider2D_pool.get(collision.entity_a).on_exit.invoke(ea, eb, ca, cb);
-                _collider2D_pool.get(collision.entity_a).on_exit.invoke(eb, ea, cb, ca);
+                _pending_callbacks.push(collision.entity_a, collision.entity_b,
+                                        CollisionCallback::Exit);
+                _pending_callbacks.push(collision.entity_b, collision.entity_a,
+                                        CollisionCallback::Exit);
             }
         }
     }
     _collisions = newCollisions;
+
+    _pending_callbacks.dispatch(
+        [&](EntityId entity_a, EntityId entity_b, CollisionCallback callback)
+        { invoke_callback(entity_a, entity_b, callback); });
+}
+
+void CollisionSystem::update_world_colliders()
+{
+    _world_colliders.resize(_collider2D_pool.size());
+
+    auto* collider2D_pool = _collider2D_pool.data();
+
+    for(size_t i = 0; i < _collider2D_pool.size(); ++i)
+    {
+        auto&       world_collider = _world_colliders[i];
+        const auto& collider       = collider2D_pool[i];
+        const auto& entity         = _scene.entities().at(
+            _collider2D_pool.component_index_to_entity_id().at(i));
+
+        world_collider.entity  = _collider2D_pool.entity_id(i);
+        world_collider.layer   = collider.layer();
+        world_collider.enabled = collider.is_enabled() && entity.is_enabled();
+
+        // No need to transform a collider that won't be tested
+        if(!world_collider.enabled)
+            continue;
+
+        math::transform_box(collider.positions().data(), collider.axes().data(),
+                            _transforms.get(entity.id()).world_matrix(),
+                            world_collider.box);
+    }
+}
+
+void CollisionSystem::invoke_callback(EntityId          entity_a,
+                                      EntityId          entity_b,
+                                      CollisionCallback callback)
+{
+    // One of the colliders could have been removed by a previous callback
+    if(!_collider2D_pool.contains(entity_a) || !_collider2D_pool.contains(entity_b))
+        return;
+
+    auto& ea = _scene.get_entity(entity_a);
+    auto& eb = _scene.get_entity(entity_b);
+
+    auto& ca = _collider2D_pool.get(entity_a);
+    auto& cb = _collider2D_pool.get(entity_b);
+
+    switch(callback)
+    {
+        case CollisionCallback::Enter:
+            ca.on_enter(ea, eb, ca, cb);
+            break;
+
+        case CollisionCallback::Stay:
+            ca.on_collision(ea, eb, ca, cb);
+            break;
+
+        case CollisionCallback::Exit:
+            ca.on_exit(ea, eb, ca, cb);
+            break;
+    }
 }
 }    // namespace corgi
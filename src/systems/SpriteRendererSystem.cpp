@@ -1,26 +1,17 @@
 #include "corgi/ecs/Entity.h"
 
-#include <corgi/components/MeshRenderer.h>
 #include <corgi/components/SpriteRenderer.h>
 #include <corgi/ecs/RefEntity.h>
 #include <corgi/main/Game.h>
 #include <corgi/rendering/texture.h>
 #include <corgi/resources/Mesh.h>
 #include <corgi/systems/SpriteRendererSystem.h>
+#include <corgi/utils/ResourcesCache.h>
 
 #include <memory>
 
 namespace corgi
 {
-// All sprite renderer use this mesh
-// This mesh is deleted in the Game destructor
-static Material default_material;
-
-static std::string main_texture      = "main_texture";
-static std::string sprite_uniform    = "sprite";
-static std::string spritetex_uniform = "sprite_tex";
-static std::string flip_x            = "flip_x";
-
 std::shared_ptr<Mesh> sprite_meshes;
 std::shared_ptr<Mesh> sUiMeshes;
 
@@ -92,69 +83,69 @@ void SpriteRendererSystem::initializeSpriteMesh()
 
 void SpriteRendererSystem::before_update(float elapsed_time)
 {
-    auto* sprites        = _scene.component_maps().get<SpriteRenderer>();
-    auto* mesh_renderers = _scene.component_maps().get<MeshRenderer>();
+    if(!_scene.component_maps().contains<SpriteRenderer>())
+        return;
 
-    auto* animator_array = sprites->components().data();
-    auto  size           = sprites->components().size();
+    auto* sprites = _scene.component_maps().get<SpriteRenderer>();
 
-    for(auto i = 0u; i < size; i++)
-    {
-        auto&       sprite_renderer = animator_array[i];
-        const auto& sprite          = sprite_renderer.sprite_;
+    auto* sprite_array = sprites->data();
+    auto  size         = sprites->size();
 
-        if(!sprite_renderer._dirty)
-            continue;
+    // A reloaded texture may have a new size, so its sprites' uvs are
+    // computed again
+    if(ResourcesCache::generation() != resources_generation_)
+    {
+        for(auto i = 0u; i < size; i++)
+        {
+            auto& sprite_renderer = sprite_array[i];
 
-        const auto entity_id = EntityId(sprites->component_index_to_entity_id().at(i));
+            if(ResourcesCache::reloaded_since(sprite_renderer.sprite_.texture,
+                                              resources_generation_))
+                sprite_renderer._dirty = true;
+        }
+        resources_generation_ = ResourcesCache::generation();
+    }
 
-        auto& entity =
-            _scene.entity_contiguous().at(sprites->component_index_to_entity_id().at(i));
+    // Only the attributes of the sprites that changed are computed again,
+    // the renderer copies them as is into the batches' instance buffers
 
-        if(!mesh_renderers->contains(entity_id))
-            mesh_renderers->add_param(entity_id, RefEntity(entity.scene(), entity));
+    for(auto i = 0u; i < size; i++)
+    {
+        auto&       sprite_renderer = sprite_array[i];
+        const auto& sprite          = sprite_renderer.sprite_;
 
-        if(!entity.is_enabled())
+        if(!sprite_renderer._dirty || sprite.texture == nullptr)
             continue;
 
-        auto& mesh_renderer = mesh_renderers->get(entity_id);
+        auto& instance = sprite_renderer._instance;
 
-        mesh_renderer.material = sprite_renderer._material;
-        mesh_renderer._mesh    = sprite_meshes;
-        mesh_renderer.layer    = sprite_renderer.cameraLayer;
+        auto* uv_rect = instance.uv_rect;
 
-        mesh_renderer.material.enable_depth_test(true);
-        mesh_renderer.material.is_transparent(true);
+        sprite.uv_rect(uv_rect);
 
-        mesh_renderer.material.set_uniform("flat_color", Vec4(2.0f, 2.0f, 2.0f, 1.0f));
-        mesh_renderer.material.set_uniform("use_flat_color", 0);
+        if(sprite_renderer._flipped_x)
+        {
+            uv_rect[0] += uv_rect[2];
+            uv_rect[2] = -uv_rect[2];
+        }
 
-        mesh_renderer.material.set_uniform("flip_x", sprite_renderer._flipped_x);
+        if(sprite_renderer._flipped_y)
+        {
+            uv_rect[1] += uv_rect[3];
+            uv_rect[3] = -uv_rect[3];
+        }
 
-        if(mesh_renderer.material._texture_uniforms.empty())
-            mesh_renderer.material.add_texture(*sprite_renderer.sprite_.texture,
-                                               main_texture.c_str());
-        else
-            mesh_renderer.material.set_texture(0, *sprite_renderer.sprite_.texture);
+        instance.quad[0] = static_cast<float>(sprite.width);
+        instance.quad[1] = static_cast<float>(sprite.height);
+        instance.quad[2] = sprite.pivot_value.x;
+        instance.quad[3] = sprite.pivot_value.y;
 
-        mesh_renderer.material.set_uniform("pivot_x", sprite.pivot_value.x);
-        mesh_renderer.material.set_uniform("pivot_y", sprite.pivot_value.y);
+        const auto& tint = sprite_renderer._tint;
 
-        mesh_renderer.material.set_uniform("sprite_width", sprite.width);
-        mesh_renderer.material.set_uniform("sprite_height", sprite.height);
+        instance.tint = SpriteBatch::pack_color(tint.getRedInt(), tint.getGreenInt(),
+                                                tint.getBlueInt(), tint.getAlphaInt());
 
-        if(sprite_renderer.sprite_.texture != nullptr)
-        {
-            mesh_renderer.material.set_uniform("offset_x",
-                                               sprite_renderer.sprite_.offset_x);
-            mesh_renderer.material.set_uniform("offset_y",
-                                               sprite_renderer.sprite_.offset_y);
-
-            mesh_renderer.material.set_uniform("texture_width",
-                                               sprite_renderer.sprite_.texture->width());
-            mesh_renderer.material.set_uniform("texture_height",
-                                               sprite_renderer.sprite_.texture->height());
-        }
+        sprite_renderer._dirty = false;
     }
 }
 }    // namespace corgi
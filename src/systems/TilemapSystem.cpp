@@ -0,0 +1,82 @@
+#include <corgi/components/Camera.h>
+#include <corgi/components/TilemapRenderer.h>
+#include <corgi/components/Transform.h>
+#include <corgi/ecs/Entity.h>
+#include <corgi/systems/TilemapSystem.h>
+#include <corgi/utils/ResourcesCache.h>
+
+#include <algorithm>
+#include <limits>
+
+namespace corgi
+{
+TilemapSystem::TilemapSystem(Scene& scene)
+    : _scene(scene)
+{
+}
+
+void TilemapSystem::before_update(float elapsed_time)
+{
+    auto* tilemaps   = _scene.component_maps().get<TilemapRenderer>();
+    auto* cameras    = _scene.component_maps().get<Camera>();
+    auto* transforms = _scene.component_maps().get<Transform>();
+
+    // Rectangle seen by every orthographic camera, in world space
+    float left   = std::numeric_limits<float>::max();
+    float bottom = std::numeric_limits<float>::max();
+    float right  = std::numeric_limits<float>::lowest();
+    float top    = std::numeric_limits<float>::lowest();
+
+    for(auto i = 0u; i < cameras->components().size(); i++)
+    {
+        const auto& camera = cameras->components()[i];
+
+        if(!camera.is_orthographic())
+            continue;
+
+        const auto entity_id = EntityId(cameras->component_index_to_entity_id().at(i));
+
+        if(!transforms->contains(entity_id))
+            continue;
+
+        const auto position = transforms->get(entity_id).world_position();
+
+        // See Camera::ortho, the height is half the height of the view
+        const float half_height = camera.orthographic_height();
+        const float half_width  = half_height * camera.ratio();
+
+        left   = std::min(left, position.x - half_width);
+        right  = std::max(right, position.x + half_width);
+        bottom = std::min(bottom, position.y - half_height);
+        top    = std::max(top, position.y + half_height);
+    }
+
+    const bool has_view = left <= right;
+
+    const bool resources_reloaded = ResourcesCache::generation() != resources_generation_;
+
+    for(auto& tilemap : tilemaps->components())
+    {
+        if(resources_reloaded)
+            tilemap.invalidate_reloaded_tilesets(resources_generation_);
+
+        tilemap.update_animations(elapsed_time);
+
+        auto root = tilemap.root();
+
+        if(!tilemap.streaming || !has_view || !root || !root->has_component<Transform>())
+        {
+            tilemap.rebuild_dirty_chunks();
+            continue;
+        }
+
+        // The chunks are positioned relative to the tilemap's root
+        const auto origin = root->get_component<Transform>()->world_position();
+
+        tilemap.stream(left - origin.x, bottom - origin.y, right - origin.x,
+                       top - origin.y);
+    }
+
+    resources_generation_ = ResourcesCache::generation();
+}
+}    // namespace corgi
@@ -46,9 +46,15 @@ void TransformSystem::update_component(Transform& transform, Entity& entity)
         transform._dirty         = false;
         transform._inverse_dirty = false;
 
+        if(!transform._has_previous_world_matrix)
+        {
+            transform._previous_world_matrix     = transform._world_matrix;
+            transform._has_previous_world_matrix = true;
+        }
+
         // Because the children transformations depends on their parent, we have to
         // update them. Their dirty flag will set to false so we don't update them more than once
-        for(auto& child : entity.children())
+        for(auto child : entity.children())
         {
             if(child->has_component<Transform>())
             {
@@ -71,16 +77,20 @@ void TransformSystem::update(float elapsed_time)
     auto* transforms              = transforms_.components().data();
     auto* comp_index_to_entity_id = transforms_.component_index_to_entity_id().data();
     auto* entity_id_to_comp       = transforms_._entity_id_to_components_vector.data();
-    auto* entity_vector           = _scene.entity_contiguous().data();
+    auto& entity_vector           = _scene.entities();
 
     const auto size = transforms_.size();
 
     auto entity_size = sizeof(Entity);
 
+    // The matrices computed by the last update become the ones the renderer
+    // interpolates from
     for(int i = 0; i < size; ++i)
     {
         auto eid             = comp_index_to_entity_id[i];
-        transforms[i]._depth = _scene.entity_contiguous()[eid]._depth;
+        transforms[i]._depth = entity_vector[eid]._depth;
+
+        transforms[i]._previous_world_matrix = transforms[i]._world_matrix;
     }
 
     for(int i = 0; i < size; ++i)
@@ -7,6 +7,8 @@
 #include <corgi/ui/Text.h>
 #include <corgi/utils/ResourcesCache.h>
 
+#include <algorithm>
+
 using namespace corgi;
 
 UISystem::UISystem(Renderer& renderer, const Inputs& inputs)
@@ -33,43 +35,7 @@ UISystem::UISystem(Renderer& renderer, const Inputs& inputs)
     //mRoot->get()->mViewport = &mRoot;
 }
 
-static ui::Widget* findDeepestWidget(const Mouse&                       mouse,
-                                     Node<std::unique_ptr<ui::Widget>>& root)
-{
-    ui::Widget* selectedWidget = nullptr;
-
-    int depth = -1;
-
-    for(auto& node : root)
-    {
-        auto* widget = node.mValue.get();
-        auto  d      = node.depth();
-
-        // We skip the widget if we manually disable its events
-        if(widget->eventsDisabled())
-            continue;
-
-        // We skip a widget if it's disabled
-        if(!widget->isEnabled())
-            continue;
-
-        // We skip a deactivated widget
-        if(!widget->isActive())
-            continue;
-
-        if(widget->contains(mouse.x(), mouse.y()) && d > depth)
-        {
-            if(widget->mProcessEvent)
-            {
-                selectedWidget = widget;
-                depth          = node.depth();
-            }
-        }
-    }
-    return selectedWidget;
-}
-
-void UISystem::handleMouseButtonDown(const float elapsedTime, NodeWidget& nodeWidget)
+void UISystem::handleMouseButtonDown(const float elapsedTime)
 {
     const auto& mouse = inputs_.mouse();
     time_since_last_button_down_ += elapsedTime;
@@ -77,7 +43,7 @@ void UISystem::handleMouseButtonDown(const float elapsedTime, NodeWidget& nodeWi
     // and then propagate the event to its parents
     if(mouse.is_button_down(Mouse::Button::Left))
     {
-        auto widget = findDeepestWidget(mouse, nodeWidget);
+        auto widget = hit_test_index_.find_deepest(mouse.x(), mouse.y());
 
         if(widget != nullptr)
         {
@@ -94,23 +60,19 @@ void UISystem::handleMouseButtonDown(const float elapsedTime, NodeWidget& nodeWi
     }
 }
 
-void UISystem::handle_mouse_over(float elapsed_time, NodeWidget& node_widget)
+void UISystem::handle_mouse_over()
 {
     if(inputs_.mouse().has_moved())
     {
-        auto widget = findDeepestWidget(inputs_.mouse(), node_widget);
+        auto widget =
+            hit_test_index_.find_deepest(inputs_.mouse().x(), inputs_.mouse().y());
 
-        if(!widget)
-            return;
-
-        if(widget->contains(inputs_.mouse().x(), inputs_.mouse().y()))
-        {
+        if(widget)
             widget->on_mouse_over_(inputs_.mouse());
-        }
     }
 }
 
-void UISystem::handle_drag_event(float elapsed_time, NodeWidget& node_widget)
+void UISystem::handle_drag_event()
 {
     // If there's no widget currently being dragged
     if(dragged_widget_ == nullptr)
@@ -119,7 +81,8 @@ void UISystem::handle_drag_event(float elapsed_time, NodeWidget& node_widget)
         if(inputs_.mouse().is_button_down(Mouse::Button::Left))
         {
             // We try to find the deepest widget
-            dragged_widget_ = findDeepestWidget(inputs_.mouse(), node_widget);
+            dragged_widget_ =
+                hit_test_index_.find_deepest(inputs_.mouse().x(), inputs_.mouse().y());
 
             // If we found a widget, we trigger the mouse_drag_start_event
             if(dragged_widget_)
@@ -144,13 +107,13 @@ void UISystem::handle_drag_event(float elapsed_time, NodeWidget& node_widget)
     }
 }
 
-void UISystem::handleMouseClick(float elapsedTime, NodeWidget& nodeWidget)
+void UISystem::handleMouseClick()
 {
     const auto& mouse = inputs_.mouse();
 
     if(mouse.is_button_up(Mouse::Button::Left))
     {
-        auto        widget         = findDeepestWidget(mouse, nodeWidget);
+        auto        widget         = hit_test_index_.find_deepest(mouse.x(), mouse.y());
         ui::Widget* previousWidget = nullptr;
 
         if(widget)
@@ -461,14 +424,14 @@ void UISystem::startResizing(ui::Widget& widget)
     widget_resize_width_before_  = widget.width();
 }
 
-void UISystem::handleMouseButtonUp(float elapsedTime, NodeWidget& nodeWidget)
+void UISystem::handleMouseButtonUp()
 {
     const auto& mouse = inputs_.mouse();
     // We're doing Event Bubbling. So we first look for the innermost widget
     // and then propagate the event to its parents
     if(mouse.is_button_up(Mouse::Button::Left))
     {
-        auto widget = findDeepestWidget(mouse, nodeWidget);
+        auto widget = hit_test_index_.find_deepest(mouse.x(), mouse.y());
 
         if(widget)
         {
@@ -482,7 +445,7 @@ void UISystem::handleMouseButtonUp(float elapsedTime, NodeWidget& nodeWidget)
     }
 }
 
-void UISystem::handleWheelEvent(float elapsedTime, NodeWidget& nodeWidget)
+void UISystem::handleWheelEvent()
 {
     const auto& mouse = inputs_.mouse();
 
@@ -490,7 +453,7 @@ void UISystem::handleWheelEvent(float elapsedTime, NodeWidget& nodeWidget)
     // and then propagate the event to its parents
     if(mouse.wheelDelta() != 0)
     {
-        auto widget = findDeepestWidget(mouse, nodeWidget);
+        auto widget = hit_test_index_.find_deepest(mouse.x(), mouse.y());
 
         if(widget)
         {
@@ -523,18 +486,30 @@ void UISystem::update(float elapsedTime)
     if(!modal_widgets_.empty())
         workingNode = modal_widgets_.children_.back().get();
 
+    exit_candidates_.clear();
+
     for(auto& node : *workingNode)
     {
         node->get()->checkForResizeEvent();
+
+        // Only widgets that haven't received their exit event yet can
+        // trigger one, so we don't have to test the whole hierarchy later
+        if(!node->get()->mouseHasExited_)
+            exit_candidates_.push_back(node->get());
     }
 
-    handleMouseEnter(elapsedTime, *workingNode);
-    handleMouseExit(elapsedTime, *workingNode);
-    handleMouseButtonDown(elapsedTime, *workingNode);
-    handleMouseButtonUp(elapsedTime, *workingNode);
-    handleWheelEvent(elapsedTime, *workingNode);
-    handleMouseClick(elapsedTime, *workingNode);
-    handle_drag_event(elapsedTime, *workingNode);
+    // Every mouse event handled this frame queries the same snapshot of the
+    // widget rectangles instead of testing every widget of the hierarchy
+    hit_test_index_.build(*workingNode->mValue);
+    hit_test_index_.query(inputs_.mouse().x(), inputs_.mouse().y(), hovered_widgets_);
+
+    handleMouseEnter();
+    handleMouseExit();
+    handleMouseButtonDown(elapsedTime);
+    handleMouseButtonUp();
+    handleWheelEvent();
+    handleMouseClick();
+    handle_drag_event();
 
     // TODO : I'm not too sure about this behavior, maybe I should
     // react to key press only if the widget is focused or something
@@ -629,6 +604,12 @@ void UISystem::update(float elapsedTime)
 
     // We destroy widgets only at the end of the update process
     removeDestroyedWidgets(*workingNode);
+
+    // The index could reference widgets we just destroyed
+    hit_test_index_.clear();
+    hovered_widgets_.clear();
+    sorted_hovered_widgets_.clear();
+    exit_candidates_.clear();
 }
 
 static void setResizeEast(ui::Widget* widget, float x, bool inPercentage)
@@ -804,44 +785,43 @@ ui::Widget& UISystem::addModalWidget(Window& window)
     return widget;
 }
 
-void UISystem::handleMouseEnter(float elapsedTime, NodeWidget& nodeWidget)
+void UISystem::handleMouseEnter()
 {
-    for(auto& childNode : nodeWidget)
+    for(auto* widget : hovered_widgets_)
     {
-        auto* widget = childNode->get();
-
         // We skip a deactivated widget
         if(!widget->activity_)
             continue;
 
-        if(widget->contains(inputs_.mouse().x(), inputs_.mouse().y()))
+        // We check this boolean just to make sure we don't trigger the mouseHasEntered function twice
+        if(!widget->mouseHasEntered_)
         {
-            // We check this boolean just to make sure we don't trigger the mouseHasEntered function twice
-            if(!widget->mouseHasEntered_)
+            widget->onMouseEnter_(inputs_.mouse().x(), inputs_.mouse().y());
+            widget->mouseHasEntered_ = true;
+            widget->mouseHasExited_  = false;
+            if(widget->hasTooltip_)
             {
-                widget->onMouseEnter_(inputs_.mouse().x(), inputs_.mouse().y());
-                widget->mouseHasEntered_ = true;
-                widget->mouseHasExited_  = false;
-                if(widget->hasTooltip_)
-                {
-                    widget->startTooltipTimer_ = 0.0f;
-                }
+                widget->startTooltipTimer_ = 0.0f;
             }
         }
     }
 }
 
-void UISystem::handleMouseExit(float elapsedTime, NodeWidget& nodeWidget)
+void UISystem::handleMouseExit()
 {
-    for(auto& node : nodeWidget)
-    {
-        auto* widget = node->get();
+    // The candidates keep their hierarchy order, so the exit events are
+    // triggered in the same order as before
+    sorted_hovered_widgets_.assign(hovered_widgets_.begin(), hovered_widgets_.end());
+    std::sort(sorted_hovered_widgets_.begin(), sorted_hovered_widgets_.end());
 
+    for(auto* widget : exit_candidates_)
+    {
         // We skip a deactivated widget
         if(!widget->activity_)
             continue;
 
-        if(!widget->contains(inputs_.mouse().x(), inputs_.mouse().y()))
+        if(!std::binary_search(sorted_hovered_widgets_.begin(), sorted_hovered_widgets_.end(),
+                               widget))
         {
             // We check this boolean just to make sure we don't trigger the mouseHasEntered function twice
             if(!widget->mouseHasExited_)
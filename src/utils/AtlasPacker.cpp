@@ -0,0 +1,443 @@
+#include <corgi/filesystem/FileSystem.h>
+#include <corgi/utils/AtlasPacker.h>
+
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <limits>
+#include <numeric>
+#include <utility>
+
+namespace corgi
+{
+	namespace
+	{
+		bool intersects(const MaxRects::Rect& a, const MaxRects::Rect& b)
+		{
+			return a.x < b.x + b.width && b.x < a.x + a.width &&
+				   a.y < b.y + b.height && b.y < a.y + a.height;
+		}
+
+		bool contains(const MaxRects::Rect& outer, const MaxRects::Rect& inner)
+		{
+			return inner.x >= outer.x && inner.y >= outer.y &&
+				   inner.x + inner.width <= outer.x + outer.width &&
+				   inner.y + inner.height <= outer.y + outer.height;
+		}
+
+		unsigned next_power_of_two(unsigned value)
+		{
+			unsigned result = 1u;
+
+			while (result < value)
+				result <<= 1u;
+			return result;
+		}
+
+		std::string escape(const std::string& str)
+		{
+			std::string result;
+
+			for (auto c : str)
+			{
+				if (c == '"' || c == '\\')
+					result += '\\';
+				result += c;
+			}
+			return result;
+		}
+	}
+
+	MaxRects::MaxRects(unsigned width, unsigned height)
+		: width_(width), height_(height)
+	{
+		free_.push_back({0u, 0u, width, height});
+	}
+
+	bool MaxRects::insert(unsigned width, unsigned height, Rect& result)
+	{
+		const Rect* best	= nullptr;
+		auto best_short		= std::numeric_limits<unsigned>::max();
+		auto best_long		= std::numeric_limits<unsigned>::max();
+
+		for (const auto& rect : free_)
+		{
+			if (rect.width < width || rect.height < height)
+				continue;
+
+			const auto leftover_x	= rect.width - width;
+			const auto leftover_y	= rect.height - height;
+			const auto short_side	= std::min(leftover_x, leftover_y);
+			const auto long_side	= std::max(leftover_x, leftover_y);
+
+			if (short_side < best_short || (short_side == best_short && long_side < best_long))
+			{
+				best		= &rect;
+				best_short	= short_side;
+				best_long	= long_side;
+			}
+		}
+
+		if (best == nullptr)
+			return false;
+
+		result = {best->x, best->y, width, height};
+
+		split(result);
+		prune();
+
+		used_area_		+= static_cast<std::size_t>(width) * height;
+		used_width_		= std::max(used_width_, result.x + width);
+		used_height_	= std::max(used_height_, result.y + height);
+		return true;
+	}
+
+	void MaxRects::split(const Rect& used)
+	{
+		new_free_.clear();
+
+		// Every free rectangle overlapping the used one is replaced by the
+		// (up to 4) maximal rectangles around it
+		for (const auto& rect : free_)
+		{
+			if (!intersects(rect, used))
+			{
+				new_free_.push_back(rect);
+				continue;
+			}
+
+			const auto used_right	= used.x + used.width;
+			const auto used_top		= used.y + used.height;
+			const auto rect_right	= rect.x + rect.width;
+			const auto rect_top		= rect.y + rect.height;
+
+			if (used.x > rect.x)
+				new_free_.push_back({rect.x, rect.y, used.x - rect.x, rect.height});
+
+			if (used_right < rect_right)
+				new_free_.push_back({used_right, rect.y, rect_right - used_right, rect.height});
+
+			if (used.y > rect.y)
+				new_free_.push_back({rect.x, rect.y, rect.width, used.y - rect.y});
+
+			if (used_top < rect_top)
+				new_free_.push_back({rect.x, used_top, rect.width, rect_top - used_top});
+		}
+		free_.swap(new_free_);
+	}
+
+	void MaxRects::prune()
+	{
+		// Removes the free rectangles contained inside another one. When two
+		// rectangles are equal, only the first one is kept
+		std::vector<bool> removed(free_.size(), false);
+
+		for (std::size_t i = 0; i < free_.size(); i++)
+		{
+			if (removed[i])
+				continue;
+
+			for (std::size_t j = i + 1; j < free_.size(); j++)
+			{
+				if (removed[j])
+					continue;
+
+				if (contains(free_[i], free_[j]))
+				{
+					removed[j] = true;
+				}
+				else if (contains(free_[j], free_[i]))
+				{
+					removed[i] = true;
+					break;
+				}
+			}
+		}
+
+		std::size_t kept = 0;
+
+		for (std::size_t i = 0; i < free_.size(); i++)
+			if (!removed[i])
+				free_[kept++] = free_[i];
+		free_.resize(kept);
+	}
+
+	float AtlasPacker::Report::efficiency() const noexcept
+	{
+		if (page_area == 0u)
+			return 0.0f;
+
+		return static_cast<float>(static_cast<double>(image_area) / static_cast<double>(page_area));
+	}
+
+	AtlasPacker::AtlasPacker(Settings settings)
+		: settings_(settings)
+	{}
+
+	void AtlasPacker::add(Image image)
+	{
+		images_.push_back(std::move(image));
+	}
+
+	bool AtlasPacker::pack()
+	{
+		pages_.clear();
+
+		const auto padding = settings_.padding;
+		const auto extrude = settings_.extrude;
+
+		std::vector<std::size_t> order(images_.size());
+		std::iota(order.begin(), order.end(), 0u);
+
+		std::stable_sort(order.begin(), order.end(), [&](std::size_t a, std::size_t b)
+		{
+			const auto& lhs = images_[a];
+			const auto& rhs = images_[b];
+
+			if (lhs.group != rhs.group)
+				return lhs.group < rhs.group;
+
+			if (lhs.height != rhs.height)
+				return lhs.height > rhs.height;
+
+			return lhs.width > rhs.width;
+		});
+
+		// Bins are a padding larger than the pages, so the padding following
+		// the last image of a row or column doesn't need to fit inside the page
+		std::vector<MaxRects> bins;
+
+		bool packed_everything = true;
+
+		for (auto index : order)
+		{
+			const auto& image = images_[index];
+
+			const auto cell_width	= image.width + 2u * extrude + padding;
+			const auto cell_height	= image.height + 2u * extrude + padding;
+
+			MaxRects::Rect cell;
+			std::size_t page = pages_.size();
+
+			for (std::size_t i = 0; i < pages_.size(); i++)
+			{
+				if (pages_[i].group == image.group && bins[i].insert(cell_width, cell_height, cell))
+				{
+					page = i;
+					break;
+				}
+			}
+
+			if (page == pages_.size())
+			{
+				auto& bin = bins.emplace_back(settings_.page_width + padding, settings_.page_height + padding);
+
+				if (!bin.insert(cell_width, cell_height, cell))
+				{
+					bins.pop_back();
+					packed_everything = false;
+					continue;
+				}
+				pages_.emplace_back().group = image.group;
+			}
+
+			pages_[page].placements.push_back(
+				{index, {cell.x + extrude, cell.y + extrude, image.width, image.height}});
+			pages_[page].used_area += static_cast<std::size_t>(image.width) * image.height;
+		}
+
+		for (std::size_t i = 0; i < pages_.size(); i++)
+		{
+			pages_[i].width		= next_power_of_two(bins[i].used_width() - padding);
+			pages_[i].height	= next_power_of_two(bins[i].used_height() - padding);
+
+			shrink(pages_[i]);
+		}
+		return packed_everything;
+	}
+
+	bool AtlasPacker::place(Page& page, unsigned width, unsigned height) const
+	{
+		const auto padding = settings_.padding;
+		const auto extrude = settings_.extrude;
+
+		MaxRects bin(width + padding, height + padding);
+		std::vector<Placement> placements;
+
+		for (const auto& placement : page.placements)
+		{
+			const auto& image = images_[placement.image];
+
+			MaxRects::Rect cell;
+
+			if (!bin.insert(image.width + 2u * extrude + padding, image.height + 2u * extrude + padding, cell))
+				return false;
+
+			placements.push_back({placement.image, {cell.x + extrude, cell.y + extrude, image.width, image.height}});
+		}
+
+		page.placements	= std::move(placements);
+		page.width		= width;
+		page.height		= height;
+		return true;
+	}
+
+	void AtlasPacker::shrink(Page& page) const
+	{
+		// Images are placed to fit the full page size, which spreads them
+		// across the page. We try again with every smaller power of two
+		// size, from the smallest area, and keep the first that works
+		std::vector<std::pair<unsigned, unsigned>> sizes;
+
+		for (unsigned width = 1u; width <= page.width; width <<= 1u)
+			for (unsigned height = 1u; height <= page.height; height <<= 1u)
+				if (static_cast<std::size_t>(width) * height >= page.used_area &&
+					static_cast<std::size_t>(width) * height < static_cast<std::size_t>(page.width) * page.height)
+					sizes.emplace_back(width, height);
+
+		std::stable_sort(sizes.begin(), sizes.end(), [](const auto& a, const auto& b)
+		{
+			return static_cast<std::size_t>(a.first) * a.second < static_cast<std::size_t>(b.first) * b.second;
+		});
+
+		for (const auto& [width, height] : sizes)
+			if (place(page, width, height))
+				return;
+	}
+
+	std::vector<unsigned char> AtlasPacker::compose(std::size_t index) const
+	{
+		const auto& page	= pages_[index];
+		const auto extrude	= static_cast<int>(settings_.extrude);
+
+		std::vector<unsigned char> pixels(static_cast<std::size_t>(page.width) * page.height * 4u, 0u);
+
+		for (const auto& placement : page.placements)
+		{
+			const auto& image	= images_[placement.image];
+			const auto& rect	= placement.rect;
+
+			if (image.pixels.size() != static_cast<std::size_t>(image.width) * image.height * 4u)
+				continue;
+
+			const auto width	= static_cast<int>(image.width);
+			const auto height	= static_cast<int>(image.height);
+
+			// Rows outside the image repeat its first or last row, and columns
+			// outside of it repeat its first or last pixel
+			for (int row = -extrude; row < height + extrude; row++)
+			{
+				const auto* source	= image.pixels.data() + std::clamp(row, 0, height - 1) * width * 4;
+				auto* destination	= pixels.data() +
+					((static_cast<int>(rect.y) + row) * static_cast<int>(page.width) + static_cast<int>(rect.x)) * 4;
+
+				std::memcpy(destination, source, static_cast<std::size_t>(width) * 4u);
+
+				for (int column = 1; column <= extrude; column++)
+				{
+					std::memcpy(destination - column * 4, source, 4u);
+					std::memcpy(destination + (width - 1 + column) * 4, source + (width - 1) * 4, 4u);
+				}
+			}
+		}
+		return pixels;
+	}
+
+	std::string AtlasPacker::page_name(std::size_t index) const
+	{
+		const auto& group = pages_[index].group;
+
+		const auto group_index = std::count_if(pages_.begin(), pages_.begin() + index,
+			[&](const Page& page) { return page.group == group; });
+
+		return "atlases/" + group + "_" + std::to_string(group_index) + ".tex";
+	}
+
+	bool AtlasPacker::write(const std::string& directory) const
+	{
+		filesystem::create_directory(directory);
+		filesystem::create_directory(directory + "/atlases");
+
+		std::ofstream manifest(directory + "/" + manifest_name);
+
+		if (!manifest.is_open())
+			return false;
+
+		manifest << "{\n\t\"pages\": [";
+
+		for (std::size_t i = 0; i < pages_.size(); i++)
+		{
+			const auto& page	= pages_[i];
+			const auto name		= page_name(i);
+			const auto path		= directory + "/" + name;
+
+			std::ofstream texture(path);
+
+			if (!texture.is_open())
+				return false;
+
+			const auto& first = images_[page.placements.front().image];
+
+			texture << "{\n"
+					<< "\t\"min_filter\"\t: \"" << first.min_filter << "\",\n"
+					<< "\t\"mag_filter\"\t: \"" << first.mag_filter << "\",\n"
+					<< "\t\"wrap_s\"\t\t: \"clamp_to_edge\",\n"
+					<< "\t\"wrap_t\"\t\t: \"clamp_to_edge\"\n"
+					<< "}";
+
+			std::ofstream image(path.substr(0, path.size() - 4) + ".img", std::ios::binary);
+
+			if (!image.is_open())
+				return false;
+
+			const int width		= static_cast<int>(page.width);
+			const int height	= static_cast<int>(page.height);
+			const int channels	= 4;
+			const auto pixels	= compose(i);
+
+			image.write(reinterpret_cast<const char*>(&width), sizeof width);
+			image.write(reinterpret_cast<const char*>(&height), sizeof height);
+			image.write(reinterpret_cast<const char*>(&channels), sizeof channels);
+			image.write(reinterpret_cast<const char*>(pixels.data()), static_cast<std::streamsize>(pixels.size()));
+
+			manifest << (i == 0 ? "\n" : ",\n") << "\t\t\"" << escape(name) << "\"";
+		}
+
+		manifest << "\n\t],\n\t\"regions\": [";
+
+		bool first_region = true;
+
+		for (std::size_t i = 0; i < pages_.size(); i++)
+		{
+			for (const auto& placement : pages_[i].placements)
+			{
+				manifest << (first_region ? "\n" : ",\n")
+						 << "\t\t{ \"name\": \"" << escape(images_[placement.image].name)
+						 << "\", \"page\": " << i
+						 << ", \"x\": " << placement.rect.x
+						 << ", \"y\": " << placement.rect.y
+						 << ", \"width\": " << placement.rect.width
+						 << ", \"height\": " << placement.rect.height << " }";
+				first_region = false;
+			}
+		}
+		manifest << "\n\t]\n}\n";
+
+		return manifest.good();
+	}
+
+	AtlasPacker::Report AtlasPacker::report() const
+	{
+		Report report;
+
+		report.page_count = pages_.size();
+
+		for (const auto& page : pages_)
+		{
+			report.image_count	+= page.placements.size();
+			report.image_area	+= page.used_area;
+			report.page_area	+= static_cast<std::size_t>(page.width) * page.height;
+		}
+		return report;
+	}
+}
@@ -0,0 +1,108 @@
+#include <corgi/components/SpriteRenderer.h>
+#include <corgi/components/Transform.h>
+#include <corgi/ecs/SceneSnapshot.h>
+#include <corgi/rendering/texture.h>
+#include <corgi/utils/ComponentSerializers.h>
+#include <corgi/utils/ResourcesCache.h>
+
+namespace corgi
+{
+    namespace
+    {
+        void write_vec3(const Vec3& v, SnapshotWriter& writer)
+        {
+            writer.write(v.x);
+            writer.write(v.y);
+            writer.write(v.z);
+        }
+
+        Vec3 read_vec3(SnapshotReader& reader)
+        {
+            const auto x = reader.read<float>();
+            const auto y = reader.read<float>();
+            const auto z = reader.read<float>();
+            return Vec3(x, y, z);
+        }
+
+        void write_transform(const Transform& transform, SnapshotWriter& writer)
+        {
+            write_vec3(transform.position(), writer);
+            write_vec3(transform.euler_angles(), writer);
+            write_vec3(transform.scale(), writer);
+            writer.write(transform.is_world());
+            writer.write(transform.enabled());
+        }
+
+        Transform read_transform(SnapshotReader& reader)
+        {
+            Transform transform;
+            transform.position(read_vec3(reader));
+            transform.euler_angles(read_vec3(reader));
+            transform.scale(read_vec3(reader));
+            transform.is_world(reader.read<bool>());
+
+            if(!reader.read<bool>())
+                transform.disable();
+
+            return transform;
+        }
+
+        void write_sprite_renderer(const SpriteRenderer& renderer, SnapshotWriter& writer)
+        {
+            const auto& sprite = renderer.sprite();
+
+            writer.write(sprite.width);
+            writer.write(sprite.height);
+            writer.write(sprite.offset_x);
+            writer.write(sprite.offset_y);
+            writer.write(sprite.pivot_value.x);
+            writer.write(sprite.pivot_value.y);
+
+            // Textures are referenced by their resource name
+            writer.write_string(sprite.texture != nullptr ? sprite.texture->name() : "");
+
+            writer.write(renderer.pivot().x);
+            writer.write(renderer.pivot().y);
+            writer.write(renderer.is_horizontally_flipped());
+            writer.write(renderer.is_vertically_flipped());
+            writer.write(renderer.cameraLayer);
+            writer.write(renderer.enabled());
+        }
+
+        SpriteRenderer read_sprite_renderer(SnapshotReader& reader)
+        {
+            Sprite sprite;
+            sprite.width         = reader.read<unsigned>();
+            sprite.height        = reader.read<unsigned>();
+            sprite.offset_x      = reader.read<unsigned>();
+            sprite.offset_y      = reader.read<unsigned>();
+            sprite.pivot_value.x = reader.read<float>();
+            sprite.pivot_value.y = reader.read<float>();
+
+            const auto& texture = reader.read_string();
+
+            if(!texture.empty())
+                sprite.texture = ResourcesCache::get<Texture>(texture);
+
+            SpriteRenderer renderer(sprite);
+
+            const auto pivot_x = reader.read<float>();
+            const auto pivot_y = reader.read<float>();
+            renderer.pivot(pivot_x, pivot_y);
+
+            renderer.flip_horizontal(reader.read<bool>());
+            renderer.flip_vertical(reader.read<bool>());
+            renderer.cameraLayer = reader.read<int>();
+            renderer.enabled(reader.read<bool>());
+
+            return renderer;
+        }
+    }    // namespace
+
+    void register_component_serializers()
+    {
+        ComponentRegistry::add<Transform>("Transform", write_transform, read_transform);
+        ComponentRegistry::add<SpriteRenderer>("SpriteRenderer", write_sprite_renderer,
+                                               read_sprite_renderer);
+    }
+}    // namespace corgi
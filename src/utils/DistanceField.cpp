@@ -0,0 +1,143 @@
+#include <corgi/utils/DistanceField.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <limits>
+
+namespace corgi::distance_field
+{
+	namespace
+	{
+		// Stands for an infinite squared distance, without overflowing when
+		// squared positions are added to it
+		constexpr float far = 1e20f;
+
+		/*!
+		 * @brief	Replaces the @a count values of @a f, read and written every
+		 *			@a stride floats, by their 1D squared distance transform
+		 *
+		 *			The lower envelope of the parabolas rooted at every sample is
+		 *			built first, then sampled. @a v, @a z and @a d are scratch
+		 *			buffers of at least @a count + 1 elements
+		 */
+		void transform(float* f, std::size_t count, std::size_t stride, int* v, float* z, float* d)
+		{
+			constexpr float infinity = std::numeric_limits<float>::infinity();
+
+			const auto intersection = [&](int q, int r)
+			{
+				return ((f[q * stride] + float(q * q)) - (f[r * stride] + float(r * r))) /
+					   float(2 * q - 2 * r);
+			};
+
+			int k = 0;
+			v[0] = 0;
+			z[0] = -infinity;
+			z[1] = infinity;
+
+			for (int q = 1; q < static_cast<int>(count); q++)
+			{
+				float s = intersection(q, v[k]);
+
+				// The parabolas hidden by the new one leave the envelope
+				while (s <= z[k])
+				{
+					k--;
+					s = intersection(q, v[k]);
+				}
+
+				k++;
+				v[k]	 = q;
+				z[k]	 = s;
+				z[k + 1] = infinity;
+			}
+
+			k = 0;
+
+			for (int q = 0; q < static_cast<int>(count); q++)
+			{
+				while (z[k + 1] < float(q))
+					k++;
+
+				const float delta = float(q - v[k]);
+				d[q] = delta * delta + f[v[k] * stride];
+			}
+
+			for (std::size_t q = 0; q < count; q++)
+				f[q * stride] = d[q];
+		}
+
+		/*!
+		 * @brief	Turns @a grid, holding 0 on the pixels we measure the
+		 *			distance to and far elsewhere, into squared distances
+		 */
+		void transform(std::vector<float>& grid, unsigned width, unsigned height)
+		{
+			const std::size_t size = std::max(width, height) + 1u;
+
+			std::vector<int>	v(size);
+			std::vector<float>	z(size + 1u);
+			std::vector<float>	d(size);
+
+			for (unsigned x = 0; x < width; x++)
+				transform(grid.data() + x, height, width, v.data(), z.data(), d.data());
+
+			for (unsigned y = 0; y < height; y++)
+				transform(grid.data() + std::size_t(y) * width, width, 1u, v.data(), z.data(), d.data());
+		}
+	}
+
+	Bitmap generate(std::span<const std::uint8_t> coverage, unsigned width, unsigned height,
+					unsigned spread)
+	{
+		Bitmap field;
+		field.width		= width + 2u * spread;
+		field.height	= height + 2u * spread;
+
+		const std::size_t size = std::size_t(field.width) * field.height;
+
+		// Coverage inside the grown bitmap, the margin being empty
+		std::vector<std::uint8_t> grown(size, 0u);
+
+		for (unsigned y = 0; y < height; y++)
+			std::copy_n(coverage.data() + std::size_t(y) * width, width,
+						grown.data() + std::size_t(y + spread) * field.width + spread);
+
+		// Distance of the outside pixels to the shape, and of the inside pixels
+		// to the outside
+		std::vector<float> outside(size);
+		std::vector<float> inside(size);
+
+		for (std::size_t i = 0; i < size; i++)
+		{
+			const bool in = grown[i] >= 128u;
+			outside[i]	  = in ? 0.0f : far;
+			inside[i]	  = in ? far : 0.0f;
+		}
+
+		transform(outside, field.width, field.height);
+		transform(inside, field.width, field.height);
+
+		field.pixels.resize(size);
+
+		const float scale = 127.5f / static_cast<float>(std::max(spread, 1u));
+
+		for (std::size_t i = 0; i < size; i++)
+		{
+			// The outline runs between the last pixel inside and the first
+			// outside, through the partially covered pixels, whose coverage
+			// tells how far inside they are
+			float distance = grown[i] >= 128u ? std::sqrt(inside[i]) - 0.5f
+											  : 0.5f - std::sqrt(outside[i]);
+
+			if (grown[i] != 0u && grown[i] != 255u)
+				distance = static_cast<float>(grown[i]) / 255.0f - 0.5f;
+
+			field.pixels[i] = static_cast<std::uint8_t>(
+				std::clamp(std::lround(127.5f + distance * scale), 0l, 255l));
+		}
+
+		return field;
+	}
+}
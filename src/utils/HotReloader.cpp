@@ -0,0 +1,170 @@
+#include <corgi/utils/HotReloader.h>
+
+#include <algorithm>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <span>
+
+namespace corgi
+{
+namespace
+{
+// How long the thread waits for new changes before checking if it must stop
+constexpr int poll_timeout_ms = 100;
+
+// Editors often write a file in several steps, or several files in a row, so
+// we wait until the directories stay quiet for this long before reading them
+constexpr int settle_timeout_ms = 50;
+
+std::vector<std::byte> read_file(const std::string& path)
+{
+    std::ifstream           file(path, std::ifstream::binary);
+    const std::vector<char> content((std::istreambuf_iterator<char>(file)),
+                                    std::istreambuf_iterator<char>());
+
+    const auto bytes = std::as_bytes(std::span(content));
+    return {bytes.begin(), bytes.end()};
+}
+}    // namespace
+
+HotReloader::~HotReloader()
+{
+    stop();
+}
+
+bool HotReloader::start(const std::vector<std::string>& directories)
+{
+    if(is_running() || !filesystem::FileWatcher::is_supported())
+        return false;
+
+    directories_ = directories;
+
+    for(const auto& directory : directories_)
+        watcher_.watch(directory);
+
+    thread_ = std::jthread([this](std::stop_token token) { run(token); });
+    return true;
+}
+
+void HotReloader::stop()
+{
+    if(!is_running())
+        return;
+
+    thread_.request_stop();
+    thread_.join();
+}
+
+std::vector<HotReloader::Change> HotReloader::take_changes()
+{
+    std::lock_guard lock(mutex_);
+
+    has_changes_ = false;
+    return std::move(changes_);
+}
+
+void HotReloader::run(std::stop_token token)
+{
+    while(!token.stop_requested())
+    {
+        auto paths = watcher_.poll(poll_timeout_ms);
+
+        if(paths.empty())
+            continue;
+
+        for(auto more = watcher_.poll(settle_timeout_ms); !more.empty();
+            more      = watcher_.poll(settle_timeout_ms))
+            paths.insert(paths.end(), more.begin(), more.end());
+
+        std::vector<std::string> identifiers;
+
+        for(const auto& path : paths)
+        {
+            auto id = identifier(path);
+
+            // Textures are described by their .tex file, and the pixels are
+            // stored inside the .img file next to it
+            if(id.ends_with(".img"))
+                id = id.substr(0, id.size() - 4) + ".tex";
+
+            if(!id.empty() && std::find(identifiers.begin(), identifiers.end(), id) ==
+                                  identifiers.end())
+                identifiers.push_back(std::move(id));
+        }
+
+        std::vector<Change> changes;
+        changes.reserve(identifiers.size());
+
+        for(const auto& id : identifiers)
+            changes.push_back(read(id));
+
+        std::lock_guard lock(mutex_);
+
+        // Changes that weren't taken yet are superseded by the new ones
+        for(auto& change : changes)
+        {
+            auto it = std::find_if(changes_.begin(), changes_.end(),
+                                   [&](const Change& other)
+                                   { return other.identifier == change.identifier; });
+
+            if(it != changes_.end())
+                changes_.erase(it);
+
+            changes_.push_back(std::move(change));
+        }
+        has_changes_ = !changes_.empty();
+    }
+}
+
+std::string HotReloader::identifier(const std::string& path) const
+{
+    for(std::size_t i = 0; i < directories_.size(); i++)
+    {
+        const auto& directory = directories_[i];
+
+        if(path.size() <= directory.size() + 1 || !path.starts_with(directory) ||
+           path[directory.size()] != '/')
+            continue;
+
+        auto relative = path.substr(directory.size() + 1);
+
+        // ResourcesCache::find uses the first directory containing the file,
+        // so the same file inside a following directory is hidden
+        for(std::size_t j = 0; j < i; j++)
+        {
+            std::error_code error;
+
+            if(std::filesystem::exists(directories_[j] + "/" + relative, error))
+                return "";
+        }
+        return relative;
+    }
+    return "";
+}
+
+HotReloader::Change HotReloader::read(const std::string& identifier) const
+{
+    Change change;
+    change.identifier = identifier;
+
+    for(const auto& directory : directories_)
+    {
+        auto path = directory + "/" + identifier;
+
+        std::error_code error;
+
+        if(!std::filesystem::exists(path, error))
+            continue;
+
+        change.content = read_file(path);
+
+        if(identifier.ends_with(".tex"))
+            change.image = read_file(path.substr(0, path.size() - 4) + ".img");
+
+        change.path = std::move(path);
+        break;
+    }
+    return change;
+}
+}    // namespace corgi
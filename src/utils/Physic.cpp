@@ -1,5 +1,6 @@
 #include <corgi/components/BoxCollider.h>
 #include <corgi/components/BoxCollider2D.h>
+#include <corgi/components/MeshCollider.h>
 #include <corgi/components/Transform.h>
 #include <corgi/ecs/Entity.h>
 #include <corgi/main/Game.h>
@@ -60,7 +61,7 @@ const Raycast2DResult Physic::raycast2D(const Vec2& start,
     for(auto& collider : *box2D_collider_map)
     {
         auto  entity_id = box2D_collider_map->component_index_to_entity_id().at(i);
-        auto& entity    = _scene.entity_contiguous().at(entity_id);
+        auto& entity    = _scene.entities().at(entity_id);
 
         if(!collider.is_enabled() || !entity.is_enabled())
         {
@@ -134,7 +135,7 @@ Physic::raycast(const Vec3& start, const Vec3& direction, float length, int_64 l
                              .get<BoxCollider>()
                              ->component_index_to_entity_id()
                              .at(i);
-        auto& entity = _scene.entity_contiguous().at(entity_id);
+        auto& entity = _scene.entities().at(entity_id);
 
         if(!collider.is_enabled() || !entity.is_enabled())
         {
@@ -168,6 +169,40 @@ Physic::raycast(const Vec3& start, const Vec3& direction, float length, int_64 l
         }
         i++;
     }
+
+    auto& component_maps = Game::instance().scene().component_maps();
+
+    if(!component_maps.contains<MeshCollider>())
+        return result;
+
+    auto* mesh_colliders = component_maps.get<MeshCollider>();
+
+    for(size_t index = 0; index < mesh_colliders->size(); ++index)
+    {
+        auto& collider = mesh_colliders->data()[index];
+        auto& entity   = _scene.entities().at(
+            mesh_colliders->component_index_to_entity_id().at(index));
+
+        if(!collider.is_enabled() || !entity.is_enabled())
+            continue;
+
+        if(((int_64(1) << collider.layer_) & layer) == 0)
+            continue;
+
+        // The mesh's BVH only transforms the ray, not the mesh's vertices
+        math::RayHit hit;
+
+        if(collider.raycast(transforms->get(entity.id()).world_matrix(), ray, hit) &&
+           (hit.point - start).length() < min_length)
+        {
+            min_length                 = (hit.point - start).length();
+            result.collision_occured   = true;
+            result.intersection_point  = hit.point;
+            result.collider            = &collider;
+            result.intersection_normal = hit.normal;
+            result.entity              = &entity;
+        }
+    }
     return result;
 }
 }    // namespace corgi
\ No newline at end of file
@@ -1,16 +1,77 @@
 #include <corgi/filesystem/FileSystem.h>
+#include <corgi/logger/log.h>
+#include <corgi/rendering/Material.h>
 #include <corgi/rendering/renderer.h>
 #include <corgi/rendering/texture.h>
+#include <corgi/resources/Shader.h>
+#include <corgi/resources/Tilemap.h>
 #include <corgi/utils/AsepriteImporter.h>
+#include <corgi/utils/AtlasPacker.h>
+#include <corgi/utils/HotReloader.h>
 #include <corgi/utils/ResourcesCache.h>
+#include <corgi/utils/StagingPool.h>
+#include <rapidjson/document.h>
 
+#include <algorithm>
 #include <fstream>
+#include <iterator>
 #include <numeric>
 
 namespace corgi
 {
+std::unique_ptr<HotReloader> ResourcesCache::hot_reloader_;
+
+namespace
+{
+/*!
+ * @brief   Reloads @a resource in place with the content of @a change
+ *
+ * @return  Returns false if the resource can't be reloaded, or if the new
+ *          content is invalid. The resource keeps its previous state then
+ */
+bool reload(Resource& resource, const HotReloader::Change& change)
+{
+    if(auto* texture = dynamic_cast<Texture*>(&resource))
+        return texture->reload(change.content, change.image);
+
+    if(auto* shader = dynamic_cast<Shader*>(&resource))
+        return shader->reload(change.identifier,
+                              {reinterpret_cast<const char*>(change.content.data()),
+                               change.content.size()});
+
+    if(auto* material = dynamic_cast<Material*>(&resource))
+        return material->reload(change.identifier,
+                                {reinterpret_cast<const char*>(change.content.data()),
+                                 change.content.size()});
+
+    if(auto* tilemap = dynamic_cast<Tilemap*>(&resource))
+    {
+        try
+        {
+            *tilemap = Tilemap(change.path, change.identifier);
+            return true;
+        }
+        catch(const std::exception& e)
+        {
+            log_warning("Could not reload the tilemap " + change.identifier + " : " + e.what());
+            return false;
+        }
+    }
+
+    log_warning("Resources of the type of " + change.identifier + " can't be reloaded");
+    return false;
+}
+}    // namespace
+
 void ResourcesCache::loadEverything()
 {
+    // The packs' manifests already list every file, nothing to scan
+    for(const auto& path : vfs_.paths())
+    {
+        if(path.ends_with(".tex"))
+            static_cast<void>(get<Texture>(std::string(path)));
+    }
+
     for(const auto& directory : directories_)
     {
         auto files = corgi::filesystem::list_directory(directory.c_str(), true);
@@ -28,10 +89,14 @@ void ResourcesCache::loadEverything()
 
                 relativePath.replace(relativePath.begin(), relativePath.end(), "\\", "/");
 
-                get<Texture>(relativePath);
+                static_cast<void>(get<Texture>(relativePath));
             }
         }
     }
+
+    // The images are loaded, the buffers they were decoded into aren't
+    // needed until the next batch
+    StagingPool::shared().trim();
 };
 
 const ResourcesCache::Resources& ResourcesCache::resources()
@@ -58,6 +123,112 @@ std::string ResourcesCache::find(const std::string& path)
     return "";
 }
 
+bool ResourcesCache::mount(const std::string& path)
+{
+    return vfs_.mount(path);
+}
+
+bool ResourcesCache::load_atlas_manifest(const std::string& identifier)
+{
+    atlas_manifest_loaded_ = true;
+
+    std::string content;
+
+    if(const auto data = vfs_.read(identifier); !data.empty())
+    {
+        content.assign(reinterpret_cast<const char*>(data.data()), data.size());
+    }
+    else
+    {
+        const auto path = find(identifier);
+
+        if(path.empty())
+            return false;
+
+        std::ifstream file(path, std::ifstream::binary);
+        content.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+    }
+
+    rapidjson::Document document;
+    document.Parse(content.c_str());
+
+    if(document.HasParseError() || !document.IsObject() || !document.HasMember("pages") ||
+       !document["pages"].IsArray() || !document.HasMember("regions") ||
+       !document["regions"].IsArray())
+    {
+        log_warning("Could not parse the atlas manifest " + identifier);
+        return false;
+    }
+
+    const auto pages = document["pages"].GetArray();
+
+    for(const auto& page : pages)
+    {
+        if(!page.IsString())
+        {
+            log_warning("Invalid page in the atlas manifest " + identifier);
+            return false;
+        }
+    }
+
+    const auto is_uint = [](const rapidjson::Value& value, const char* name)
+    { return value.HasMember(name) && value[name].IsUint(); };
+
+    // Invalid regions are skipped, the others can still be used
+    for(const auto& value : document["regions"].GetArray())
+    {
+        if(!value.IsObject() || !value.HasMember("name") || !value["name"].IsString() ||
+           !is_uint(value, "page") || !is_uint(value, "x") || !is_uint(value, "y") ||
+           !is_uint(value, "width") || !is_uint(value, "height") ||
+           value["page"].GetUint() >= pages.Size())
+        {
+            log_warning("Invalid region in the atlas manifest " + identifier);
+            continue;
+        }
+
+        AtlasRegion region;
+
+        region.page   = pages[value["page"].GetUint()].GetString();
+        region.x      = value["x"].GetUint();
+        region.y      = value["y"].GetUint();
+        region.width  = value["width"].GetUint();
+        region.height = value["height"].GetUint();
+
+        atlas_regions_.insert_or_assign(value["name"].GetString(), std::move(region));
+    }
+    return true;
+}
+
+Resource* ResourcesCache::find_atlas_region(const std::string& id)
+{
+    if(!atlas_manifest_loaded_ &&
+       (vfs_.contains(AtlasPacker::manifest_name) || !find(AtlasPacker::manifest_name).empty()))
+        load_atlas_manifest(AtlasPacker::manifest_name);
+
+    atlas_manifest_loaded_ = true;
+
+    const auto it = atlas_regions_.find(id);
+
+    if(it == atlas_regions_.end())
+        return nullptr;
+
+    const auto& region = it->second;
+    auto*       page   = get<Texture>(region.page);
+
+    if(page == nullptr)
+    {
+        log_warning("Could not find the atlas page " + region.page + " of " + id);
+        return nullptr;
+    }
+
+    add_dependency(id, region.page);
+
+    return resources_
+        .emplace(id, std::make_unique<Texture>(id, *page, region.x, region.y, region.width,
+                                               region.height))
+        .first->second.get();
+}
+
 std::map<std::string, Animation> ResourcesCache::load_animations(const std::string& path)
 {
     // Maybe just do all in one go?
@@ -122,17 +293,121 @@ std::vector<std::string>& ResourcesCache::directories() noexcept
     return directories_;
 }
 
-int ResourcesCache::memory_usage()
+long long ResourcesCache::memory_usage()
 {
-    // TODO : kinda broken anyways
-    auto sum {0};
-    /*for(const auto& resource : _resources)
-                    sum += _resource.second->memory_usage();*/
+    long long sum {0};
+
+    for(const auto& [identifier, resource] : resources_)
+        sum += resource->memory_usage();
     return sum;
 }
 
 void ResourcesCache::clear() noexcept
 {
+    resources_by_type_.clear();
     resources_.clear();
+    atlas_regions_.clear();
+    atlas_manifest_loaded_ = false;
+    dependents_.clear();
+    reload_generations_.clear();
+
+    // What was built from the cleared resources must be built again
+    generation_++;
+}
+
+bool ResourcesCache::watch()
+{
+    hot_reloader_ = std::make_unique<HotReloader>();
+
+    if(hot_reloader_->start(directories_))
+        return true;
+
+    hot_reloader_.reset();
+    return false;
+}
+
+void ResourcesCache::unwatch()
+{
+    hot_reloader_.reset();
+}
+
+std::size_t ResourcesCache::apply_reloads()
+{
+    if(!hot_reloader_ || !hot_reloader_->has_changes())
+        return 0u;
+
+    std::size_t count = 0u;
+
+    for(const auto& change : hot_reloader_->take_changes())
+    {
+        const auto it = resources_.find(change.identifier);
+
+        // Nothing to update if the resource was never loaded, and the file
+        // may have been removed since it changed
+        if(it == resources_.end() || change.path.empty())
+            continue;
+
+        if(!reload(*it->second, change))
+            continue;
+
+        generation_++;
+        reload_generations_.insert_or_assign(it->second.get(), generation_);
+        count++;
+
+        log_info("Reloaded " + change.identifier);
+
+        // Dependents keep pointing to the reloaded resource, only what they
+        // derived from it must be updated
+        for(const auto& identifier : dependents(change.identifier))
+        {
+            const auto dependent = resources_.find(identifier);
+
+            if(dependent == resources_.end())
+                continue;
+
+            // The program is shared with every copy of the material, so
+            // relinking it updates them too
+            if(auto* material = dynamic_cast<Material*>(dependent->second.get()))
+                material->relink();
+
+            reload_generations_.insert_or_assign(dependent->second.get(), generation_);
+        }
+    }
+    return count;
+}
+
+void ResourcesCache::add_dependency(const std::string& identifier, const std::string& dependency)
+{
+    auto& dependents = dependents_[dependency];
+
+    if(std::find(dependents.begin(), dependents.end(), identifier) == dependents.end())
+        dependents.push_back(identifier);
+}
+
+std::vector<std::string> ResourcesCache::dependents(const std::string& identifier)
+{
+    std::vector<std::string> result;
+
+    // Breadth first, result being the queue. Graphs are small and mostly
+    // shallow, a linear search is enough to skip the visited resources
+    for(std::size_t i = 0; i <= result.size(); i++)
+    {
+        const auto it = dependents_.find(i == 0 ? identifier : result[i - 1]);
+
+        if(it == dependents_.end())
+            continue;
+
+        for(const auto& dependent : it->second)
+            if(dependent != identifier &&
+               std::find(result.begin(), result.end(), dependent) == result.end())
+                result.push_back(dependent);
+    }
+    return result;
+}
+
+bool ResourcesCache::reloaded_since(const Resource* resource, unsigned generation)
+{
+    const auto it = reload_generations_.find(resource);
+    return it != reload_generations_.end() && it->second > generation;
 }
 }    // namespace corgi
@@ -0,0 +1,120 @@
+#include <corgi/utils/StagingPool.h>
+
+#include <algorithm>
+#include <bit>
+#include <cstring>
+
+namespace corgi
+{
+	namespace
+	{
+		// Decoders also ask for small scratch buffers, they share a few sizes
+		constexpr std::size_t min_capacity = 256u;
+	}
+
+	StagingPool::StagingPool(std::size_t max_retained_bytes)
+		: max_retained_bytes_(max_retained_bytes)
+	{
+	}
+
+	StagingPool& StagingPool::shared()
+	{
+		static StagingPool pool;
+		return pool;
+	}
+
+	std::byte* StagingPool::allocate(std::size_t size)
+	{
+		const std::lock_guard lock(mutex_);
+
+		const auto capacity = std::bit_ceil(std::max(size, min_capacity));
+
+		// Smallest released buffer that fits
+		auto it = std::lower_bound(free_.begin(), free_.end(), capacity,
+			[](const Block& block, std::size_t value) { return block.capacity < value; });
+
+		Block block;
+
+		if (it != free_.end())
+		{
+			block = std::move(*it);
+			free_.erase(it);
+			retained_bytes_ -= block.capacity;
+		}
+		else
+		{
+			block.data		= std::make_unique_for_overwrite<std::byte[]>(capacity);
+			block.capacity	= capacity;
+			system_allocations_++;
+		}
+
+		auto* data = block.data.get();
+		used_.emplace(data, std::move(block));
+		return data;
+	}
+
+	std::byte* StagingPool::reallocate(void* data, std::size_t size)
+	{
+		if (data == nullptr)
+			return allocate(size);
+
+		std::size_t capacity = 0u;
+		{
+			const std::lock_guard lock(mutex_);
+			capacity = used_.at(static_cast<const std::byte*>(data)).capacity;
+		}
+
+		if (size <= capacity)
+			return static_cast<std::byte*>(data);
+
+		auto* grown = allocate(size);
+		std::memcpy(grown, data, capacity);
+		release(data);
+		return grown;
+	}
+
+	void StagingPool::release(void* data) noexcept
+	{
+		if (data == nullptr)
+			return;
+
+		const std::lock_guard lock(mutex_);
+
+		auto node = used_.extract(static_cast<const std::byte*>(data));
+
+		if (node.empty())
+			return;
+
+		auto& block = node.mapped();
+
+		if (retained_bytes_ + block.capacity > max_retained_bytes_)
+			return;
+
+		retained_bytes_ += block.capacity;
+
+		const auto it = std::upper_bound(free_.begin(), free_.end(), block.capacity,
+			[](std::size_t value, const Block& b) { return value < b.capacity; });
+
+		free_.insert(it, std::move(block));
+	}
+
+	void StagingPool::trim() noexcept
+	{
+		const std::lock_guard lock(mutex_);
+
+		free_.clear();
+		retained_bytes_ = 0u;
+	}
+
+	std::size_t StagingPool::retained_bytes() const noexcept
+	{
+		const std::lock_guard lock(mutex_);
+		return retained_bytes_;
+	}
+
+	std::size_t StagingPool::system_allocations() const noexcept
+	{
+		const std::lock_guard lock(mutex_);
+		return system_allocations_;
+	}
+}
@@ -3,13 +3,13 @@
 #include <harfbuzz/hb.h>
 
 #include <cstring>
-#
 
 using namespace corgi::utils::text;
 
 std::vector<ShapedGlyph>
-corgi::utils::text::buildShapedGlyphs(const char*                       text,
-                                      const corgi::Font::Configuration& fontConfiguration)
+corgi::utils::text::buildShapedGlyphs(std::string_view                  text,
+                                      const corgi::Font::Configuration& fontConfiguration,
+                                      int                               textOffset)
 {
     std::vector<ShapedGlyph> shapedGlyphs;
 
@@ -19,7 +19,8 @@ corgi::utils::text::buildShapedGlyphs(const char*                       text,
     /* Create hb-buffer and populate. */
     hb_buffer_t* hb_buffer;
     hb_buffer = hb_buffer_create();
-    hb_buffer_add_utf8(hb_buffer, text, -1, 0, -1);
+    hb_buffer_add_utf8(hb_buffer, text.data(), static_cast<int>(text.size()), 0,
+                       static_cast<int>(text.size()));
 
     hb_buffer_set_direction(hb_buffer, HB_DIRECTION_LTR);
 
@@ -36,6 +37,8 @@ corgi::utils::text::buildShapedGlyphs(const char*                       text,
     hb_glyph_info_t*     info = hb_buffer_get_glyph_infos(hb_buffer, NULL);
     hb_glyph_position_t* pos  = hb_buffer_get_glyph_positions(hb_buffer, NULL);
 
+    shapedGlyphs.reserve(len);
+
     for(unsigned int i = 0; i < len; i++)
     {
         ShapedGlyph shapedGlyph;
@@ -48,40 +51,17 @@ corgi::utils::text::buildShapedGlyphs(const char*                       text,
         shapedGlyphs.push_back(shapedGlyph);
     }
 
-    int i = 0;
-    int j = 0;
-
-    float        offsetY        = 0.0f;
-    unsigned int characterIndex = 0;
-
-    auto textSize = strlen(text);
-
-    for(int i = 0; i < shapedGlyphs.size(); i++)
+    // With monotone clusters, a glyph displays the characters going from its
+    // cluster to the cluster of the next glyph
+    for(std::size_t i = 0; i < shapedGlyphs.size(); i++)
     {
         auto& glyph = shapedGlyphs[i];
 
-        // In case there is another glyph after the one we're currentyly
-        // iterating on
-        if(i + 1 < shapedGlyphs.size())
-        {
-            auto& nextGlyph = shapedGlyphs[i + 1];
-
-            // Now we iterate over the difference between the 2 clusters
-            for(auto j = glyph.cluster; j < nextGlyph.cluster; j++)
-            {
-                glyph.characters.push_back(text[characterIndex++]);
-                glyph.textOffset = static_cast<int>(characterIndex);
-            }
-        }
-        else
-        {
-            // Otherwise we just go until we processed every characters
-            for(auto j = characterIndex; j < textSize; j++)
-            {
-                glyph.characters.push_back(text[j]);
-                glyph.textOffset = static_cast<int>(j);
-            }
-        }
+        const auto end =
+            i + 1 < shapedGlyphs.size() ? shapedGlyphs[i + 1].cluster : text.size();
+
+        glyph.characters.assign(text.begin() + glyph.cluster, text.begin() + end);
+        glyph.textOffset = textOffset + static_cast<int>(glyph.cluster);
     }
 
     hb_buffer_destroy(hb_buffer);
@@ -0,0 +1,957 @@
+#include <corgi/utils/TextureCompression.h>
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstring>
+#include <limits>
+#include <utility>
+
+namespace corgi::texture_compression
+{
+	namespace
+	{
+		// Pixels of a 4x4 block, row by row, 4 channels each
+		using Block = std::array<std::array<std::uint8_t, 4>, 16>;
+
+		// Endpoints and colors are handled as floats while searching
+		template<int N>
+		using Vector = std::array<float, N>;
+
+		unsigned block_count(unsigned size)
+		{
+			return (size + 3u) / 4u;
+		}
+
+		std::size_t block_bytes(Format format)
+		{
+			return format == Format::BC1 ? 8u : 16u;
+		}
+
+		/*!
+		 * @brief	Reads the block at column @a bx and row @a by. Blocks crossing
+		 *			the border of the image repeat its last row and column
+		 */
+		Block fetch_block(const Image& image, unsigned bx, unsigned by)
+		{
+			Block block;
+
+			for (unsigned y = 0; y < 4; y++)
+			{
+				const auto row = std::min(by * 4u + y, image.height - 1u);
+
+				for (unsigned x = 0; x < 4; x++)
+				{
+					const auto column	= std::min(bx * 4u + x, image.width - 1u);
+					const auto* pixel	= &image.pixels[(std::size_t(row) * image.width + column) * 4u];
+
+					std::copy(pixel, pixel + 4, block[y * 4 + x].begin());
+				}
+			}
+			return block;
+		}
+
+		void store_block(Image& image, unsigned bx, unsigned by, const Block& block)
+		{
+			for (unsigned y = 0; y < 4 && by * 4u + y < image.height; y++)
+			{
+				for (unsigned x = 0; x < 4 && bx * 4u + x < image.width; x++)
+				{
+					const auto offset = ((std::size_t(by) * 4u + y) * image.width + bx * 4u + x) * 4u;
+					std::copy(block[y * 4 + x].begin(), block[y * 4 + x].end(), &image.pixels[offset]);
+				}
+			}
+		}
+
+		std::uint8_t to_byte(float value)
+		{
+			return static_cast<std::uint8_t>(std::clamp(std::lround(value), 0l, 255l));
+		}
+
+		/*!
+		 * @brief	Finds the segment best fitting @a points, from their principal
+		 *			axis, so the endpoints only have to be refined afterward
+		 */
+		template<int N>
+		void principal_endpoints(const std::vector<Vector<N>>& points, Vector<N>& e0, Vector<N>& e1)
+		{
+			Vector<N> mean {};
+
+			for (const auto& point : points)
+				for (int c = 0; c < N; c++)
+					mean[c] += point[c];
+
+			for (int c = 0; c < N; c++)
+				mean[c] /= static_cast<float>(points.size());
+
+			std::array<Vector<N>, N> covariance {};
+
+			for (const auto& point : points)
+				for (int i = 0; i < N; i++)
+					for (int j = 0; j < N; j++)
+						covariance[i][j] += (point[i] - mean[i]) * (point[j] - mean[j]);
+
+			// Power iterations converge quickly toward the largest eigenvector
+			Vector<N> axis;
+			axis.fill(1.0f);
+
+			for (int iteration = 0; iteration < 8; iteration++)
+			{
+				Vector<N> next {};
+
+				for (int i = 0; i < N; i++)
+					for (int j = 0; j < N; j++)
+						next[i] += covariance[i][j] * axis[j];
+
+				float length = 0.0f;
+
+				for (auto value : next)
+					length += value * value;
+
+				length = std::sqrt(length);
+
+				// Every point is the same
+				if (length < 1e-6f)
+				{
+					e0 = mean;
+					e1 = mean;
+					return;
+				}
+
+				for (int i = 0; i < N; i++)
+					axis[i] = next[i] / length;
+			}
+
+			float min = std::numeric_limits<float>::max();
+			float max = std::numeric_limits<float>::lowest();
+
+			for (const auto& point : points)
+			{
+				float t = 0.0f;
+
+				for (int c = 0; c < N; c++)
+					t += (point[c] - mean[c]) * axis[c];
+
+				min = std::min(min, t);
+				max = std::max(max, t);
+			}
+
+			for (int c = 0; c < N; c++)
+			{
+				e0[c] = std::clamp(mean[c] + min * axis[c], 0.0f, 255.0f);
+				e1[c] = std::clamp(mean[c] + max * axis[c], 0.0f, 255.0f);
+			}
+		}
+
+		/*!
+		 * @brief	Moves the endpoints to the least squares solution, given the
+		 *			interpolation weight already chosen for every point
+		 */
+		template<int N>
+		void refine_endpoints(const std::vector<Vector<N>>& points, const std::vector<float>& weights,
+							  Vector<N>& e0, Vector<N>& e1)
+		{
+			float a = 0.0f, b = 0.0f, c = 0.0f;
+			Vector<N> x0 {}, x1 {};
+
+			for (std::size_t i = 0; i < points.size(); i++)
+			{
+				const auto t = weights[i];
+
+				a += (1.0f - t) * (1.0f - t);
+				b += t * (1.0f - t);
+				c += t * t;
+
+				for (int channel = 0; channel < N; channel++)
+				{
+					x0[channel] += (1.0f - t) * points[i][channel];
+					x1[channel] += t * points[i][channel];
+				}
+			}
+
+			const auto determinant = a * c - b * b;
+
+			// Every point uses the same weight
+			if (std::abs(determinant) < 1e-6f)
+				return;
+
+			for (int channel = 0; channel < N; channel++)
+			{
+				e0[channel] = std::clamp((c * x0[channel] - b * x1[channel]) / determinant, 0.0f, 255.0f);
+				e1[channel] = std::clamp((a * x1[channel] - b * x0[channel]) / determinant, 0.0f, 255.0f);
+			}
+		}
+
+		template<int N>
+		float distance(const Vector<N>& a, const std::uint8_t* b)
+		{
+			float result = 0.0f;
+
+			for (int c = 0; c < N; c++)
+				result += (a[c] - b[c]) * (a[c] - b[c]);
+			return result;
+		}
+
+		template<int N, std::size_t Size>
+		unsigned nearest(const Vector<N>& point, const std::array<std::array<std::uint8_t, 4>, Size>& palette,
+						 unsigned count)
+		{
+			unsigned best			= 0u;
+			float	 best_distance	= std::numeric_limits<float>::max();
+
+			for (unsigned i = 0; i < count; i++)
+			{
+				const auto d = distance<N>(point, palette[i].data());
+
+				if (d < best_distance)
+				{
+					best			= i;
+					best_distance	= d;
+				}
+			}
+			return best;
+		}
+
+	// BC1 and BC3 colors
+
+		std::uint16_t pack_565(const Vector<3>& color)
+		{
+			const auto r = static_cast<unsigned>(std::lround(color[0] * 31.0f / 255.0f));
+			const auto g = static_cast<unsigned>(std::lround(color[1] * 63.0f / 255.0f));
+			const auto b = static_cast<unsigned>(std::lround(color[2] * 31.0f / 255.0f));
+
+			return static_cast<std::uint16_t>((r << 11) | (g << 5) | b);
+		}
+
+		std::array<std::uint8_t, 4> unpack_565(std::uint16_t value)
+		{
+			const unsigned r = (value >> 11) & 31u;
+			const unsigned g = (value >> 5) & 63u;
+			const unsigned b = value & 31u;
+
+			return {static_cast<std::uint8_t>((r << 3) | (r >> 2)),
+					static_cast<std::uint8_t>((g << 2) | (g >> 4)),
+					static_cast<std::uint8_t>((b << 3) | (b >> 2)), 255};
+		}
+
+		/*!
+		 * @brief	Returns the 4 colors a color block can use
+		 *
+		 *			When @a four_colors is false, the third color is the average of
+		 *			the endpoints and the fourth one is transparent black
+		 */
+		std::array<std::array<std::uint8_t, 4>, 4> color_palette(std::uint16_t c0, std::uint16_t c1,
+																  bool four_colors)
+		{
+			std::array<std::array<std::uint8_t, 4>, 4> palette;
+
+			palette[0] = unpack_565(c0);
+			palette[1] = unpack_565(c1);
+
+			for (int c = 0; c < 3; c++)
+			{
+				if (four_colors)
+				{
+					palette[2][c] = static_cast<std::uint8_t>((2 * palette[0][c] + palette[1][c]) / 3);
+					palette[3][c] = static_cast<std::uint8_t>((palette[0][c] + 2 * palette[1][c]) / 3);
+				}
+				else
+				{
+					palette[2][c] = static_cast<std::uint8_t>((palette[0][c] + palette[1][c]) / 2);
+					palette[3][c] = 0;
+				}
+			}
+			palette[2][3] = 255;
+			palette[3][3] = four_colors ? 255 : 0;
+			return palette;
+		}
+
+		/*!
+		 * @brief	Writes the 8 bytes color part of a BC1 or BC3 block
+		 *
+		 *			With @a transparency, pixels whose alpha is below 128 use the
+		 *			transparent color, which costs the block its fourth color
+		 */
+		void encode_colors(const Block& block, bool transparency, std::uint8_t* out)
+		{
+			std::vector<Vector<3>> points;
+			std::array<bool, 16> transparent {};
+
+			for (std::size_t i = 0; i < 16; i++)
+			{
+				transparent[i] = transparency && block[i][3] < 128;
+
+				if (!transparent[i])
+					points.push_back({float(block[i][0]), float(block[i][1]), float(block[i][2])});
+			}
+
+			const bool four_colors = points.size() == 16;
+
+			std::uint16_t c0 = 0;
+			std::uint16_t c1 = 0;
+
+			if (!points.empty())
+			{
+				Vector<3> e0, e1;
+				principal_endpoints<3>(points, e0, e1);
+
+				// Weight of the second endpoint for each index
+				const float four_weights[4]		= {0.0f, 1.0f, 1.0f / 3.0f, 2.0f / 3.0f};
+				const float three_weights[4]	= {0.0f, 1.0f, 0.5f, 0.0f};
+
+				std::vector<float> weights(points.size());
+
+				for (int iteration = 0; iteration < 2; iteration++)
+				{
+					const auto palette = color_palette(pack_565(e0), pack_565(e1), four_colors);
+
+					for (std::size_t i = 0; i < points.size(); i++)
+					{
+						const auto index = nearest<3>(points[i], palette, four_colors ? 4u : 3u);
+						weights[i] = four_colors ? four_weights[index] : three_weights[index];
+					}
+					refine_endpoints<3>(points, weights, e0, e1);
+				}
+
+				c0 = pack_565(e0);
+				c1 = pack_565(e1);
+			}
+
+			// The order of the endpoints tells the decoder which mode is used
+			if (four_colors ? c0 < c1 : c0 > c1)
+				std::swap(c0, c1);
+
+			// With equal endpoints the block can only be decoded with 3 colors,
+			// which is fine since every opaque pixel uses the first one
+			const auto palette = color_palette(c0, c1, four_colors && c0 != c1);
+
+			std::uint32_t indices = 0u;
+
+			for (std::size_t i = 0; i < 16; i++)
+			{
+				unsigned index = 3u;
+
+				if (!transparent[i])
+				{
+					const Vector<3> color {float(block[i][0]), float(block[i][1]), float(block[i][2])};
+					index = nearest<3>(color, palette, four_colors && c0 != c1 ? 4u : 3u);
+				}
+				indices |= index << (2 * i);
+			}
+
+			out[0] = static_cast<std::uint8_t>(c0 & 0xFF);
+			out[1] = static_cast<std::uint8_t>(c0 >> 8);
+			out[2] = static_cast<std::uint8_t>(c1 & 0xFF);
+			out[3] = static_cast<std::uint8_t>(c1 >> 8);
+			std::memcpy(out + 4, &indices, sizeof indices);
+		}
+
+		/*!
+		 * @brief	Reads the color part of a block. The colors of BC3 blocks
+		 *			always use 4 colors, whatever the endpoints' order
+		 */
+		void decode_colors(const std::uint8_t* data, bool always_four_colors, Block& block)
+		{
+			const auto c0 = static_cast<std::uint16_t>(data[0] | (data[1] << 8));
+			const auto c1 = static_cast<std::uint16_t>(data[2] | (data[3] << 8));
+
+			const auto palette = color_palette(c0, c1, always_four_colors || c0 > c1);
+
+			std::uint32_t indices;
+			std::memcpy(&indices, data + 4, sizeof indices);
+
+			for (std::size_t i = 0; i < 16; i++)
+			{
+				const auto alpha = block[i][3];
+
+				block[i] = palette[(indices >> (2 * i)) & 3u];
+
+				if (always_four_colors)
+					block[i][3] = alpha;
+			}
+		}
+
+	// BC3 alpha
+
+		std::array<std::uint8_t, 8> alpha_palette(std::uint8_t a0, std::uint8_t a1)
+		{
+			std::array<std::uint8_t, 8> palette {a0, a1};
+
+			if (a0 > a1)
+			{
+				for (int i = 2; i < 8; i++)
+					palette[i] = static_cast<std::uint8_t>(((8 - i) * a0 + (i - 1) * a1) / 7);
+			}
+			else
+			{
+				for (int i = 2; i < 6; i++)
+					palette[i] = static_cast<std::uint8_t>(((6 - i) * a0 + (i - 1) * a1) / 5);
+
+				palette[6] = 0;
+				palette[7] = 255;
+			}
+			return palette;
+		}
+
+		void encode_alpha(const Block& block, std::uint8_t* out)
+		{
+			std::uint8_t min = 255;
+			std::uint8_t max = 0;
+
+			for (const auto& pixel : block)
+			{
+				min = std::min(min, pixel[3]);
+				max = std::max(max, pixel[3]);
+			}
+
+			// With max > min, the 8 interpolated values are used
+			const auto palette = alpha_palette(max, min);
+
+			std::uint64_t indices = 0u;
+
+			for (std::size_t i = 0; i < 16; i++)
+			{
+				unsigned best		= 0u;
+				int		 best_error	= 256;
+
+				for (unsigned j = 0; j < 8; j++)
+				{
+					const auto error = std::abs(int(palette[j]) - int(block[i][3]));
+
+					if (error < best_error)
+					{
+						best		= j;
+						best_error	= error;
+					}
+				}
+				indices |= std::uint64_t(best) << (3 * i);
+			}
+
+			out[0] = max;
+			out[1] = min;
+
+			for (int i = 0; i < 6; i++)
+				out[2 + i] = static_cast<std::uint8_t>(indices >> (8 * i));
+		}
+
+		void decode_alpha(const std::uint8_t* data, Block& block)
+		{
+			const auto palette = alpha_palette(data[0], data[1]);
+
+			std::uint64_t indices = 0u;
+
+			for (int i = 0; i < 6; i++)
+				indices |= std::uint64_t(data[2 + i]) << (8 * i);
+
+			for (std::size_t i = 0; i < 16; i++)
+				block[i][3] = palette[(indices >> (3 * i)) & 7u];
+		}
+
+	// BC7 mode 6
+
+		// Interpolation weights of the 4 bits indices, out of 64
+		constexpr std::array<int, 16> bc7_weights = {0, 4, 9, 13, 17, 21, 26, 30,
+													 34, 38, 43, 47, 51, 55, 60, 64};
+
+		class BitWriter
+		{
+		public:
+
+			explicit BitWriter(std::uint8_t* data)
+				: data_(data)
+			{
+				std::fill(data, data + 16, std::uint8_t(0));
+			}
+
+			void write(unsigned value, unsigned count)
+			{
+				for (unsigned i = 0; i < count; i++, position_++)
+					if ((value >> i) & 1u)
+						data_[position_ / 8] |= static_cast<std::uint8_t>(1u << (position_ % 8));
+			}
+
+		private:
+
+			std::uint8_t*	data_;
+			unsigned		position_ {0u};
+		};
+
+		class BitReader
+		{
+		public:
+
+			explicit BitReader(const std::uint8_t* data)
+				: data_(data)
+			{
+			}
+
+			unsigned read(unsigned count)
+			{
+				unsigned value = 0u;
+
+				for (unsigned i = 0; i < count; i++, position_++)
+					value |= ((data_[position_ / 8] >> (position_ % 8)) & 1u) << i;
+
+				return value;
+			}
+
+		private:
+
+			const std::uint8_t*	data_;
+			unsigned			position_ {0u};
+		};
+
+		std::array<std::array<std::uint8_t, 4>, 16> bc7_palette(const std::array<std::uint8_t, 4>& v0,
+																const std::array<std::uint8_t, 4>& v1)
+		{
+			std::array<std::array<std::uint8_t, 4>, 16> palette;
+
+			for (std::size_t i = 0; i < 16; i++)
+				for (std::size_t c = 0; c < 4; c++)
+					palette[i][c] = static_cast<std::uint8_t>(
+						((64 - bc7_weights[i]) * v0[c] + bc7_weights[i] * v1[c] + 32) >> 6);
+
+			return palette;
+		}
+
+		/*!
+		 * @brief	Quantizes @a endpoint to 7 bits per channel plus a shared
+		 *			lowest bit, choosing the lowest bit closest to the endpoint
+		 */
+		void quantize_bc7(const Vector<4>& endpoint, std::array<std::uint8_t, 4>& quantized, unsigned& p)
+		{
+			float best_error = std::numeric_limits<float>::max();
+
+			for (unsigned bit = 0; bit < 2; bit++)
+			{
+				std::array<std::uint8_t, 4> candidate;
+				float error = 0.0f;
+
+				for (std::size_t c = 0; c < 4; c++)
+				{
+					const auto q = std::clamp(std::lround((endpoint[c] - float(bit)) / 2.0f), 0l, 127l);
+					candidate[c] = static_cast<std::uint8_t>(q);
+
+					const auto value = float((q << 1) | bit);
+					error += (value - endpoint[c]) * (value - endpoint[c]);
+				}
+
+				if (error < best_error)
+				{
+					best_error	= error;
+					quantized	= candidate;
+					p			= bit;
+				}
+			}
+		}
+
+		std::array<std::uint8_t, 4> expand_bc7(const std::array<std::uint8_t, 4>& quantized, unsigned p)
+		{
+			std::array<std::uint8_t, 4> result;
+
+			for (std::size_t c = 0; c < 4; c++)
+				result[c] = static_cast<std::uint8_t>((quantized[c] << 1) | p);
+
+			return result;
+		}
+
+		void encode_bc7(const Block& block, std::uint8_t* out)
+		{
+			std::vector<Vector<4>> points(16);
+
+			for (std::size_t i = 0; i < 16; i++)
+				for (std::size_t c = 0; c < 4; c++)
+					points[i][c] = block[i][c];
+
+			Vector<4> e0, e1;
+			principal_endpoints<4>(points, e0, e1);
+
+			std::array<std::uint8_t, 4> q0, q1;
+			unsigned p0 = 0u, p1 = 0u;
+
+			std::array<unsigned, 16> indices {};
+			std::vector<float> weights(16);
+
+			for (int iteration = 0; iteration < 3; iteration++)
+			{
+				quantize_bc7(e0, q0, p0);
+				quantize_bc7(e1, q1, p1);
+
+				const auto palette = bc7_palette(expand_bc7(q0, p0), expand_bc7(q1, p1));
+
+				for (std::size_t i = 0; i < 16; i++)
+				{
+					indices[i] = nearest<4>(points[i], palette, 16u);
+					weights[i] = bc7_weights[indices[i]] / 64.0f;
+				}
+
+				if (iteration < 2)
+					refine_endpoints<4>(points, weights, e0, e1);
+			}
+
+			// The first index is stored without its highest bit, which must
+			// be 0, so we swap the endpoints if needed
+			if (indices[0] & 8u)
+			{
+				std::swap(q0, q1);
+				std::swap(p0, p1);
+
+				for (auto& index : indices)
+					index = 15u - index;
+			}
+
+			BitWriter writer(out);
+
+			writer.write(1u << 6, 7);
+
+			for (std::size_t c = 0; c < 4; c++)
+			{
+				writer.write(q0[c], 7);
+				writer.write(q1[c], 7);
+			}
+
+			writer.write(p0, 1);
+			writer.write(p1, 1);
+
+			writer.write(indices[0], 3);
+
+			for (std::size_t i = 1; i < 16; i++)
+				writer.write(indices[i], 4);
+		}
+
+		void decode_bc7(const std::uint8_t* data, Block& block)
+		{
+			// Mode 6 is the only one with 6 zeros before its first set bit
+			if ((data[0] & 0x7F) != 0x40)
+			{
+				for (auto& pixel : block)
+					pixel.fill(0);
+				return;
+			}
+
+			BitReader reader(data);
+			reader.read(7);
+
+			std::array<std::uint8_t, 4> q0, q1;
+
+			for (std::size_t c = 0; c < 4; c++)
+			{
+				q0[c] = static_cast<std::uint8_t>(reader.read(7));
+				q1[c] = static_cast<std::uint8_t>(reader.read(7));
+			}
+
+			const auto p0 = reader.read(1);
+			const auto p1 = reader.read(1);
+
+			const auto palette = bc7_palette(expand_bc7(q0, p0), expand_bc7(q1, p1));
+
+			block[0] = palette[reader.read(3)];
+
+			for (std::size_t i = 1; i < 16; i++)
+				block[i] = palette[reader.read(4)];
+		}
+
+	// Mips
+
+		float srgb_to_linear(float value)
+		{
+			return value <= 0.04045f ? value / 12.92f : std::pow((value + 0.055f) / 1.055f, 2.4f);
+		}
+
+		float linear_to_srgb(float value)
+		{
+			return value <= 0.0031308f ? value * 12.92f : 1.055f * std::pow(value, 1.0f / 2.4f) - 0.055f;
+		}
+
+		Image downsample(const Image& image, const std::array<float, 256>& to_linear, bool srgb)
+		{
+			Image result;
+			result.width	= std::max(1u, image.width / 2u);
+			result.height	= std::max(1u, image.height / 2u);
+			result.pixels.resize(std::size_t(result.width) * result.height * 4u);
+
+			for (unsigned y = 0; y < result.height; y++)
+			{
+				for (unsigned x = 0; x < result.width; x++)
+				{
+					float color[3]	= {0.0f, 0.0f, 0.0f};
+					float plain[3]	= {0.0f, 0.0f, 0.0f};
+					float alpha		= 0.0f;
+
+					for (unsigned dy = 0; dy < 2; dy++)
+					{
+						for (unsigned dx = 0; dx < 2; dx++)
+						{
+							const auto sx = std::min(x * 2u + dx, image.width - 1u);
+							const auto sy = std::min(y * 2u + dy, image.height - 1u);
+
+							const auto* pixel = &image.pixels[(std::size_t(sy) * image.width + sx) * 4u];
+							const auto	weight = pixel[3] / 255.0f;
+
+							for (int c = 0; c < 3; c++)
+							{
+								color[c] += to_linear[pixel[c]] * weight;
+								plain[c] += to_linear[pixel[c]];
+							}
+							alpha += weight;
+						}
+					}
+
+					auto* pixel = &result.pixels[(std::size_t(y) * result.width + x) * 4u];
+
+					for (int c = 0; c < 3; c++)
+					{
+						// Fully transparent pixels keep their color, so
+						// filtering them with their neighbours stays smooth
+						const auto value = alpha > 0.0f ? color[c] / alpha : plain[c] / 4.0f;
+						pixel[c] = to_byte((srgb ? linear_to_srgb(value) : value) * 255.0f);
+					}
+					pixel[3] = to_byte(alpha / 4.0f * 255.0f);
+				}
+			}
+			return result;
+		}
+	}
+
+	std::vector<Image> generate_mips(const Image& image, bool srgb)
+	{
+		std::array<float, 256> to_linear;
+
+		for (std::size_t i = 0; i < to_linear.size(); i++)
+			to_linear[i] = srgb ? srgb_to_linear(i / 255.0f) : i / 255.0f;
+
+		std::vector<Image> levels {image};
+
+		while (levels.back().width > 1u || levels.back().height > 1u)
+		{
+			auto level = downsample(levels.back(), to_linear, srgb);
+			levels.push_back(std::move(level));
+		}
+		return levels;
+	}
+
+	std::size_t encoded_size(Format format, unsigned width, unsigned height) noexcept
+	{
+		if (format == Format::RGBA8)
+			return std::size_t(width) * height * 4u;
+
+		return std::size_t(block_count(width)) * block_count(height) * block_bytes(format);
+	}
+
+	std::vector<std::uint8_t> encode(Format format, const Image& image)
+	{
+		if (format == Format::RGBA8)
+			return image.pixels;
+
+		std::vector<std::uint8_t> result(encoded_size(format, image.width, image.height));
+
+		if (image.width == 0u || image.height == 0u)
+			return result;
+
+		auto* out = result.data();
+
+		for (unsigned by = 0; by < block_count(image.height); by++)
+		{
+			for (unsigned bx = 0; bx < block_count(image.width); bx++)
+			{
+				const auto block = fetch_block(image, bx, by);
+
+				switch (format)
+				{
+					case Format::BC1:
+						encode_colors(block, true, out);
+						break;
+
+					case Format::BC3:
+						encode_alpha(block, out);
+						encode_colors(block, false, out + 8);
+						break;
+
+					case Format::BC7:
+						encode_bc7(block, out);
+						break;
+
+					default:
+						break;
+				}
+				out += block_bytes(format);
+			}
+		}
+		return result;
+	}
+
+	Image decode(Format format, std::span<const std::uint8_t> data, unsigned width, unsigned height)
+	{
+		Image image;
+		image.width		= width;
+		image.height	= height;
+
+		if (format == Format::RGBA8)
+		{
+			image.pixels.assign(data.begin(), data.end());
+			return image;
+		}
+
+		image.pixels.resize(std::size_t(width) * height * 4u);
+
+		if (data.size() < encoded_size(format, width, height))
+			return image;
+
+		const auto* in = data.data();
+
+		for (unsigned by = 0; by < block_count(height); by++)
+		{
+			for (unsigned bx = 0; bx < block_count(width); bx++)
+			{
+				Block block;
+
+				switch (format)
+				{
+					case Format::BC1:
+						decode_colors(in, false, block);
+						break;
+
+					case Format::BC3:
+						decode_alpha(in, block);
+						decode_colors(in + 8, true, block);
+						break;
+
+					case Format::BC7:
+						decode_bc7(in, block);
+						break;
+
+					default:
+						break;
+				}
+
+				store_block(image, bx, by, block);
+				in += block_bytes(format);
+			}
+		}
+		return image;
+	}
+
+	double psnr(const Image& a, const Image& b)
+	{
+		const auto size = std::min(a.pixels.size(), b.pixels.size());
+
+		if (size == 0u)
+			return 0.0;
+
+		double error = 0.0;
+
+		for (std::size_t i = 0; i < size; i++)
+		{
+			const double difference = double(a.pixels[i]) - double(b.pixels[i]);
+			error += difference * difference;
+		}
+
+		if (error == 0.0)
+			return std::numeric_limits<double>::infinity();
+
+		return 10.0 * std::log10(255.0 * 255.0 / (error / double(size)));
+	}
+
+	Format choose_format(const Image& image)
+	{
+		for (std::size_t i = 3; i < image.pixels.size(); i += 4)
+			if (image.pixels[i] != 0 && image.pixels[i] != 255)
+				return Format::BC3;
+
+		return Format::BC1;
+	}
+
+	bool Container::is_container(std::span<const std::byte> content) noexcept
+	{
+		std::uint32_t value = 0u;
+
+		if (content.size() < sizeof value)
+			return false;
+
+		std::memcpy(&value, content.data(), sizeof value);
+		return value == magic;
+	}
+
+	bool Container::parse(std::span<const std::byte> content)
+	{
+		levels_.clear();
+
+		if (content.size() < sizeof(Header))
+			return false;
+
+		Header header;
+		std::memcpy(&header, content.data(), sizeof header);
+
+		if (header.magic != magic || header.version != version || header.format > std::uint32_t(Format::BC7) ||
+			sizeof(Header) + std::uint64_t(header.level_count) * sizeof(Entry) > content.size())
+			return false;
+
+		format_ = static_cast<Format>(header.format);
+		width_	= header.width;
+		height_ = header.height;
+
+		for (std::uint32_t i = 0; i < header.level_count; i++)
+		{
+			Entry entry;
+			std::memcpy(&entry, content.data() + sizeof(Header) + i * sizeof(Entry), sizeof entry);
+
+			// A truncated file would make the upload read past its content
+			if (entry.offset + entry.size > content.size() ||
+				entry.size < encoded_size(format_, entry.width, entry.height))
+			{
+				levels_.clear();
+				return false;
+			}
+
+			levels_.push_back({entry.width, entry.height,
+							   content.subspan(static_cast<std::size_t>(entry.offset),
+											   static_cast<std::size_t>(entry.size))});
+		}
+		return true;
+	}
+
+	std::vector<std::byte> Container::write(Format format, const std::vector<Image>& levels)
+	{
+		const auto align = [](std::size_t value) { return (value + alignment - 1) / alignment * alignment; };
+
+		Header header {magic, version, static_cast<std::uint32_t>(format),
+					   static_cast<std::uint32_t>(levels.size()),
+					   levels.empty() ? 0u : levels.front().width,
+					   levels.empty() ? 0u : levels.front().height};
+
+		std::vector<std::vector<std::uint8_t>> encoded;
+		encoded.reserve(levels.size());
+
+		for (const auto& level : levels)
+			encoded.push_back(encode(format, level));
+
+		std::vector<Entry> entries(levels.size());
+		auto offset = align(sizeof(Header) + entries.size() * sizeof(Entry));
+
+		for (std::size_t i = 0; i < levels.size(); i++)
+		{
+			entries[i]	= {offset, encoded[i].size(), levels[i].width, levels[i].height};
+			offset		= align(offset + encoded[i].size());
+		}
+
+		std::vector<std::byte> result(offset);
+
+		std::memcpy(result.data(), &header, sizeof header);
+		std::memcpy(result.data() + sizeof header, entries.data(), entries.size() * sizeof(Entry));
+
+		for (std::size_t i = 0; i < levels.size(); i++)
+			std::memcpy(result.data() + entries[i].offset, encoded[i].data(), encoded[i].size());
+
+		return result;
+	}
+
+	std::size_t Container::size() const noexcept
+	{
+		std::size_t result = 0u;
+
+		for (const auto& level : levels_)
+			result += level.data.size();
+
+		return result;
+	}
+}
@@ -1,5 +1,7 @@
 #include <corgi/utils/TimeHelper.h>
 
+#include <algorithm>
+#include <cmath>
 #include <ctime>
 #include <sstream>
 
@@ -10,6 +12,8 @@ void Time::start()
 {
 	_start_clock = std::chrono::steady_clock::now();
 	_last_update_counter = 0.0f;
+	_dropped_time = 0.0f;
+	_steps_this_frame = 0;
 }
 
 void Time::pause()
@@ -35,6 +39,7 @@ void Time::update()
 	//	_elapsed_time = timestep();
 
 	_last_update_counter += elapsed_time();
+	_steps_this_frame = 0;
 }
 
 void Time::clear()
@@ -82,8 +87,19 @@ bool Time::timestep_overrun()
 	
 	if (_last_update_counter > timestep())
 	{
+		// Too many updates this frame, we give up on the late ones but keep
+		// the fraction of a step left so the interpolation stays smooth
+		if (_steps_this_frame >= _max_catch_up_steps)
+		{
+			const auto kept = std::fmod(_last_update_counter, timestep());
+			_dropped_time += _last_update_counter - kept;
+			_last_update_counter = kept;
+			return false;
+		}
+
 		// we make up for the difference 
 		_last_update_counter -= timestep();
+		_steps_this_frame++;
 
 		for (auto* cb : _callbacks)
 			cb->update();
@@ -93,6 +109,26 @@ bool Time::timestep_overrun()
 	return false;
 }
 
+void Time::max_catch_up_steps(int steps)
+{
+	_max_catch_up_steps = steps;
+}
+
+int Time::max_catch_up_steps() const noexcept
+{
+	return _max_catch_up_steps;
+}
+
+float Time::dropped_time() const noexcept
+{
+	return _dropped_time;
+}
+
+float Time::alpha() const noexcept
+{
+	return std::clamp(_last_update_counter / timestep(), 0.0f, 1.0f);
+}
+
 std::string Time::get_time()
 {
 	auto time = std::chrono::system_clock::to_time_t(std::chrono::system_clock::now());
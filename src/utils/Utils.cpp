@@ -1,10 +1,18 @@
 #include <corgi/resources/image.h>
+#include <corgi/utils/StagingPool.h>
 #include <corgi/utils/Utils.h>
 
 #ifndef STB_IMAGE_IMPLEMENTATION
 #    define STB_IMAGE_IMPLEMENTATION
 #endif
 
+// Images are decoded straight into the staging pool, and so are the
+// decoder's scratch buffers, so loading a batch of images reuses the same
+// few buffers
+#define STBI_MALLOC(size)                  corgi::StagingPool::shared().allocate(size)
+#define STBI_REALLOC_SIZED(p, old, size)   corgi::StagingPool::shared().reallocate(p, size)
+#define STBI_FREE(p)                       corgi::StagingPool::shared().release(p)
+
 #ifndef STB_IMAGE_WRITE_IMPLEMENTATION
 #    define STB_IMAGE_WRITE_IMPLEMENTATION
 #endif
@@ -21,7 +29,8 @@ corgi::Image* Editor::Utils::LoadImageForReal(const std::string& imageFile)
 
     stbi_uc* imageData = stbi_load(imageFile.c_str(), &x, &y, &channels, STBI_rgb_alpha);
 
-    return new corgi::Image(x, y, channels, imageData);
+    // The pixels were converted to RGBA whatever the file stores
+    return new corgi::Image(x, y, 4, imageData);
 }
 
 // void Editor::Utils::WriteImage(const corgi::String& image_file, const corgi::String& output_folder)
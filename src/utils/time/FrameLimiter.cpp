@@ -0,0 +1,98 @@
+#include <corgi/utils/time/FrameLimiter.h>
+
+#include <thread>
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+#endif
+
+namespace corgi
+{
+	namespace time
+	{
+		static void sleep_for(std::chrono::nanoseconds duration)
+		{
+#ifdef _WIN32
+			// Sleep() is rounded up to the scheduler's tick, usually 15.6 ms,
+			// while a high resolution waitable timer isn't
+#ifdef CREATE_WAITABLE_TIMER_HIGH_RESOLUTION
+			static thread_local HANDLE timer = CreateWaitableTimerExW(
+				nullptr, nullptr, CREATE_WAITABLE_TIMER_HIGH_RESOLUTION, TIMER_ALL_ACCESS);
+#else
+			static thread_local HANDLE timer = nullptr;
+#endif
+			if (timer != nullptr)
+			{
+				// Negative values are relative, in 100 nanoseconds units
+				LARGE_INTEGER due;
+				due.QuadPart = -static_cast<LONGLONG>(duration.count() / 100);
+
+				if (SetWaitableTimer(timer, &due, 0, nullptr, nullptr, FALSE))
+				{
+					WaitForSingleObject(timer, INFINITE);
+					return;
+				}
+			}
+#endif
+			std::this_thread::sleep_for(duration);
+		}
+
+		void FrameLimiter::target_frame_rate(float frames_per_second) noexcept
+		{
+			target_frame_rate_	= frames_per_second;
+			next_frame_			= Clock::time_point{};
+		}
+
+		float FrameLimiter::target_frame_rate() const noexcept
+		{
+			return target_frame_rate_;
+		}
+
+		void FrameLimiter::spin_time(float seconds) noexcept
+		{
+			spin_time_ = seconds;
+		}
+
+		float FrameLimiter::spin_time() const noexcept
+		{
+			return spin_time_;
+		}
+
+		bool FrameLimiter::enabled() const noexcept
+		{
+			return target_frame_rate_ > 0.0f;
+		}
+
+		void FrameLimiter::wait()
+		{
+			if (!enabled())
+				return;
+
+			const auto frame = std::chrono::duration_cast<Clock::duration>(
+				std::chrono::duration<double>(1.0 / target_frame_rate_));
+
+			auto now = Clock::now();
+
+			// First frame, or we're more than a frame late : we don't try to
+			// make up for it with shorter frames
+			if (next_frame_ == Clock::time_point{} || now > next_frame_ + frame)
+			{
+				next_frame_ = now + frame;
+				return;
+			}
+
+			const auto spin = std::chrono::duration_cast<Clock::duration>(
+				std::chrono::duration<double>(spin_time_));
+
+			if (next_frame_ - now > spin)
+				sleep_for(next_frame_ - now - spin);
+
+			while (Clock::now() < next_frame_)
+				;
+
+			next_frame_ += frame;
+		}
+	}
+}
@@ -0,0 +1,66 @@
+#include <corgi/utils/time/FrameTimeHistogram.h>
+
+#include <algorithm>
+
+namespace corgi
+{
+	namespace time
+	{
+		void FrameTimeHistogram::add(float seconds) noexcept
+		{
+			const auto index = std::clamp(static_cast<int>(seconds / bucket_width), 0, bucket_count - 1);
+
+			buckets_[index]++;
+			count_++;
+			total_		+= seconds;
+			longest_	= std::max(longest_, seconds);
+		}
+
+		void FrameTimeHistogram::reset() noexcept
+		{
+			buckets_.fill(0);
+			count_		= 0;
+			total_		= 0.0;
+			longest_	= 0.0f;
+		}
+
+		int FrameTimeHistogram::count() const noexcept
+		{
+			return count_;
+		}
+
+		int FrameTimeHistogram::bucket(int index) const
+		{
+			return buckets_.at(index);
+		}
+
+		float FrameTimeHistogram::percentile(float percent) const noexcept
+		{
+			if (count_ == 0)
+				return 0.0f;
+
+			const auto target = percent / 100.0f * static_cast<float>(count_);
+
+			int frames = 0;
+
+			for (int i = 0; i < bucket_count; i++)
+			{
+				frames += buckets_[i];
+
+				if (static_cast<float>(frames) >= target)
+					return std::min(static_cast<float>(i + 1) * bucket_width, longest_);
+			}
+			return longest_;
+		}
+
+		float FrameTimeHistogram::average() const noexcept
+		{
+			return count_ == 0 ? 0.0f : static_cast<float>(total_ / count_);
+		}
+
+		float FrameTimeHistogram::longest() const noexcept
+		{
+			return longest_;
+		}
+	}
+}
@@ -1,5 +1,17 @@
+#include <corgi/test/test.h>
+
+#include <exception>
+#include <iostream>
 
 int main()
 {
-	return 0;
-}
\ No newline at end of file
+    try
+    {
+        return corgi::test::run_all();
+    }
+    catch(const std::exception& e)
+    {
+        std::cout << e.what() << std::endl;
+        return 1;
+    }
+}
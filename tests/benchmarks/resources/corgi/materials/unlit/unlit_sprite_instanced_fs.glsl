@@ -0,0 +1,19 @@
+#version 330 core
+
+in vec2 uv;
+in vec4 sprite_tint;
+
+uniform sampler2D	main_texture;
+
+out vec4 color;
+
+void main()
+{
+	vec4 texel = texture(main_texture, uv);
+
+	// We discard fragments that are totally transparent
+	if(texel.a == 0.0)
+		discard;
+
+	color = texel * sprite_tint;
+}
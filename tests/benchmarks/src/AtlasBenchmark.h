@@ -0,0 +1,98 @@
+#pragma once
+
+#include <corgi/rendering/Material.h>
+#include <corgi/rendering/SpriteBatch.h>
+#include <corgi/rendering/texture.h>
+#include <corgi/utils/AtlasPacker.h>
+#include <corgi/utils/time/Timer.h>
+
+#include <iostream>
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace corgi
+{
+	// Packs a few hundred sprite sized images, then counts the draw calls
+	// needed by 100k sprites using them, with and without the atlas
+	inline void test_atlas_packing()
+	{
+		const int image_count	= 256;
+		const int group_count	= 4;
+		const int sprite_count	= 100000;
+
+		std::mt19937 generator(42);
+		std::uniform_int_distribution<unsigned> size(16u, 128u);
+
+		AtlasPacker packer({1024u, 1024u, 2u, 1u});
+
+		for (int i = 0; i < image_count; i++)
+		{
+			AtlasPacker::Image image;
+
+			image.name		= "image_" + std::to_string(i) + ".tex";
+			image.group		= "group_" + std::to_string(i % group_count);
+			image.width		= size(generator);
+			image.height	= size(generator);
+
+			packer.add(std::move(image));
+		}
+
+		corgi::time::Timer timer;
+
+		timer.start();
+		packer.pack();
+		std::cout << "Packed " << image_count << " images in : " << timer.elapsed_time() * 1000.0f << " ms" << std::endl;
+
+		const auto report = packer.report();
+
+		std::cout << report.page_count << " pages, " << report.efficiency() * 100.0f
+			<< "% of the pages used" << std::endl;
+
+		// Textures are never released, their destructor needs an OpenGL context.
+		// Regions don't own any texture object, so they can be
+		std::vector<Texture*> textures;
+		std::vector<Texture*> pages;
+		std::vector<std::unique_ptr<Texture>> regions(image_count);
+
+		for (int i = 0; i < image_count; i++)
+			textures.push_back(new Texture());
+
+		for (const auto& page : packer.pages())
+		{
+			auto* texture = pages.emplace_back(new Texture());
+
+			texture->width(page.width);
+			texture->height(page.height);
+
+			for (const auto& placement : page.placements)
+			{
+				const auto& rect = placement.rect;
+
+				regions[placement.image] = std::make_unique<Texture>(
+					packer.images()[placement.image].name, *texture, rect.x, rect.y, rect.width, rect.height);
+			}
+		}
+
+		Material material("bench");
+		material._texture_uniforms.emplace_back("main_texture", 0, nullptr);
+
+		SpriteBatch batch;
+		SpriteInstance instance {};
+
+		timer.start();
+		for (int i = 0; i < sprite_count; i++)
+			batch.emplace(material, *textures[i % image_count]) = instance;
+		std::cout << "Without atlas : " << batch.draw_count() << " draw calls, batched in "
+			<< timer.elapsed_time() * 1000.0f << " ms" << std::endl;
+
+		batch.release();
+
+		timer.start();
+		for (int i = 0; i < sprite_count; i++)
+			batch.emplace(material, *regions[i % image_count]) = instance;
+		std::cout << "With atlas : " << batch.draw_count() << " draw calls, batched in "
+			<< timer.elapsed_time() * 1000.0f << " ms" << std::endl;
+	}
+}
@@ -0,0 +1,89 @@
+#pragma once
+
+#include <corgi/ecs/Entity.h>
+#include <corgi/ecs/Scene.h>
+#include <corgi/utils/time/Timer.h>
+
+#include <iostream>
+#include <typeindex>
+#include <vector>
+
+namespace corgi
+{
+	template<int N>
+	struct LookupBenchmarkComponent
+	{
+		float value = static_cast<float>(N);
+	};
+
+	// What Entity::get_component used to do : 2 searches inside a
+	// std::map<std::type_index, ...> and a dynamic_cast
+	template<class T>
+	static T& map_get_component(Scene& scene, EntityId id)
+	{
+		auto& pools = scene.component_maps();
+
+		if (!pools.contains(typeid(T)))
+			std::terminate();
+
+		auto* pool = dynamic_cast<ComponentPool<T>*>(pools.get(typeid(T)));
+
+		if (!pool->contains(id))
+			std::terminate();
+
+		return pool->get(id);
+	}
+
+	template<int... N>
+	static void add_lookup_benchmark_pools(Scene& scene, std::integer_sequence<int, N...>)
+	{
+		(scene.component_maps().add<LookupBenchmarkComponent<N>>(), ...);
+	}
+
+	inline void test_component_lookup()
+	{
+		const int entity_count = 10000;
+		const int passes = 100;
+
+		using Looked = LookupBenchmarkComponent<7>;
+
+		Scene scene;
+
+		// A game usually has a few dozen component types
+		add_lookup_benchmark_pools(scene, std::make_integer_sequence<int, 32>());
+
+		std::vector<EntityId> ids;
+
+		for (int i = 0; i < entity_count; i++)
+		{
+			auto entity = scene.new_entity("Entity");
+			entity->add_component<Looked>();
+			ids.push_back(entity->id());
+		}
+
+		std::cout << "get_component on " << entity_count << " entities, " << passes << " passes, 33 component pools" << std::endl;
+
+		corgi::time::Timer timer;
+		float sum = 0.0f;
+
+		timer.start();
+		for (int p = 0; p < passes; p++)
+			for (auto id : ids)
+				sum += map_get_component<Looked>(scene, id).value;
+		std::cout << "Map and dynamic_cast lookup done in : " << timer.elapsed_time() * 1000.0f << " ms (" << sum << ")" << std::endl;
+
+		sum = 0.0f;
+		timer.start();
+		for (int p = 0; p < passes; p++)
+			for (auto id : ids)
+				sum += scene.get_entity(id).get_component<Looked>()->value;
+		std::cout << "Type id lookup done in : " << timer.elapsed_time() * 1000.0f << " ms (" << sum << ")" << std::endl;
+
+		int count = 0;
+		timer.start();
+		for (int p = 0; p < passes; p++)
+			for (auto id : ids)
+				count += scene.get_entity(id).has_component<Looked>();
+		std::cout << "has_component done in : " << timer.elapsed_time() * 1000.0f << " ms (" << count << ")" << std::endl;
+	}
+}
@@ -7,6 +7,23 @@
 #include <corgi/ecs/Entity.h>
 
 #include "VectorBenchmark.h"
+#include "UiHitTestBenchmark.h"
+#include "TilemapBenchmark.h"
+#include "EntityFindBenchmark.h"
+#include "ComponentLookupBenchmark.h"
+#include "PrefabBenchmark.h"
+#include "SnapshotBenchmark.h"
+#include "FrameLimiterBenchmark.h"
+#include "EntityStorageBenchmark.h"
+#include "SpriteBatchBenchmark.h"
+#include "AtlasBenchmark.h"
+#include "PackFileBenchmark.h"
+#include "TextureCompressionBenchmark.h"
+#include "MapBenchmark.h"
+#include "TextEditingBenchmark.h"
+#include "TextMeshBenchmark.h"
+#include "DistanceFieldBenchmark.h"
+#include "ImageLoadingBenchmark.h"
 
 using namespace corgi;
 
@@ -43,5 +60,23 @@ int main()
 
 
 	test_vector_comparison();
+	test_ui_hit_test();
+	test_tilemap_generation();
+	test_tilemap_loading();
+	test_entity_find();
+	test_component_lookup();
+	test_prefab_instantiation();
+	test_scene_snapshot();
+	test_frame_limiter();
+	test_entity_storage();
+	test_sprite_batching();
+	test_atlas_packing();
+	test_pack_file();
+	test_texture_compression();
+	test_maps();
+	test_text_editing();
+	test_text_mesh();
+	test_distance_field();
+	test_image_loading();
 	
 }
\ No newline at end of file
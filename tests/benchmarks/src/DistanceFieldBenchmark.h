@@ -0,0 +1,193 @@
+#pragma once
+
+#include <corgi/utils/AtlasPacker.h>
+#include <corgi/utils/DistanceField.h>
+#include <corgi/utils/time/Timer.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <iostream>
+#include <vector>
+
+namespace corgi
+{
+	// Coverage of an "o" like ring drawn inside a size * size box, each pixel
+	// being sampled 8 * 8 times
+	inline std::vector<float> benchmark_ring(unsigned size)
+	{
+		std::vector<float> coverage(size * size, 0.0f);
+
+		const float outer = 0.45f * static_cast<float>(size);
+		const float inner = 0.28f * static_cast<float>(size);
+		const float center = 0.5f * static_cast<float>(size);
+
+		for (unsigned y = 0; y < size; y++)
+		{
+			for (unsigned x = 0; x < size; x++)
+			{
+				int inside = 0;
+
+				for (int sy = 0; sy < 8; sy++)
+				{
+					for (int sx = 0; sx < 8; sx++)
+					{
+						const float dx = static_cast<float>(x) + (sx + 0.5f) / 8.0f - center;
+						const float dy = static_cast<float>(y) + (sy + 0.5f) / 8.0f - center;
+						const float d = std::sqrt(dx * dx + dy * dy);
+
+						inside += (d <= outer && d >= inner) ? 1 : 0;
+					}
+				}
+				coverage[y * size + x] = static_cast<float>(inside) / 64.0f;
+			}
+		}
+		return coverage;
+	}
+
+	// Bilinear sample of a width * height single channel image, like the GPU
+	// does with a Linear filtered texture clamped to its edges
+	inline float benchmark_bilinear(const std::vector<float>& image, unsigned width, unsigned height, float x, float y)
+	{
+		x = std::clamp(x, 0.0f, static_cast<float>(width - 1));
+		y = std::clamp(y, 0.0f, static_cast<float>(height - 1));
+
+		const auto x0 = static_cast<unsigned>(x);
+		const auto y0 = static_cast<unsigned>(y);
+		const auto x1 = std::min(x0 + 1, width - 1);
+		const auto y1 = std::min(y0 + 1, height - 1);
+		const float fx = x - static_cast<float>(x0);
+		const float fy = y - static_cast<float>(y0);
+
+		const float top		= image[y0 * width + x0] * (1.0f - fx) + image[y0 * width + x1] * fx;
+		const float bottom	= image[y1 * width + x0] * (1.0f - fx) + image[y1 * width + x1] * fx;
+
+		return top * (1.0f - fy) + bottom * fy;
+	}
+
+	// Draws a glyph at sizes between 8 and 128 pixels, from the 16 pixels
+	// bitmap the .fnt files store and from a distance field built at 48
+	// pixels, and compares the memory both approaches take for a whole font
+	inline void test_distance_field()
+	{
+		const unsigned reference_size	= 48;
+		const unsigned spread			= 6;
+		const unsigned bitmap_size		= 16;
+
+		// Distance field of the glyph
+		const auto reference = benchmark_ring(reference_size);
+
+		std::vector<std::uint8_t> coverage(reference.size());
+
+		for (std::size_t i = 0; i < reference.size(); i++)
+			coverage[i] = static_cast<std::uint8_t>(std::lround(reference[i] * 255.0f));
+
+		const int iterations = 1000;
+
+		distance_field::Bitmap field;
+
+		corgi::time::Timer timer;
+		timer.start();
+
+		for (int i = 0; i < iterations; i++)
+			field = distance_field::generate(coverage, reference_size, reference_size, spread);
+
+		const auto generation = timer.elapsed_time();
+
+		std::vector<float> distances(field.pixels.size());
+
+		for (std::size_t i = 0; i < distances.size(); i++)
+			distances[i] = static_cast<float>(field.pixels[i]) / 255.0f;
+
+		const auto bitmap = benchmark_ring(bitmap_size);
+
+		std::cout << "Distance field : " << generation * 1000000.0f / iterations << " us to build a "
+			<< field.width << "x" << field.height << " glyph field" << std::endl;
+
+		// Mean coverage error on the glyph's edges, against the glyph sampled
+		// at the drawn size
+		for (unsigned size : {8u, 12u, 24u, 48u, 96u, 128u})
+		{
+			const auto expected = benchmark_ring(size);
+
+			const float texels_per_pixel = static_cast<float>(reference_size) / static_cast<float>(size);
+
+			// What fwidth gives inside the shader
+			const float width = 0.7f * texels_per_pixel * 0.5f / static_cast<float>(spread);
+
+			double bitmap_error		= 0.0;
+			double field_error		= 0.0;
+			int edge_pixels			= 0;
+
+			for (unsigned y = 0; y < size; y++)
+			{
+				for (unsigned x = 0; x < size; x++)
+				{
+					const float e = expected[y * size + x];
+
+					if (e == 0.0f || e == 1.0f)
+						continue;
+
+					const float u = (static_cast<float>(x) + 0.5f) / static_cast<float>(size);
+					const float v = (static_cast<float>(y) + 0.5f) / static_cast<float>(size);
+
+					const float scaled = benchmark_bilinear(bitmap, bitmap_size, bitmap_size,
+						u * bitmap_size - 0.5f, v * bitmap_size - 0.5f);
+
+					const float d = benchmark_bilinear(distances, field.width, field.height,
+						u * reference_size + spread - 0.5f, v * reference_size + spread - 0.5f);
+
+					const float t = std::clamp((d - 0.5f + width) / (2.0f * width), 0.0f, 1.0f);
+					const float smoothed = t * t * (3.0f - 2.0f * t);
+
+					bitmap_error += std::abs(scaled - e);
+					field_error += std::abs(smoothed - e);
+					edge_pixels++;
+				}
+			}
+
+			std::cout << "  " << size << " px : scaled bitmap edge error " << bitmap_error / edge_pixels * 100.0
+				<< " %, distance field edge error " << field_error / edge_pixels * 100.0 << " %" << std::endl;
+		}
+
+		// Roboto-Regular.fnt stores 894 glyphs on a 16746x22 RGBA row at 16
+		// pixels, about 0.55 x 0.7 em per glyph with 10 pixels between them.
+		// Each extra bitmap size adds such a row
+		const unsigned glyph_count = 894;
+
+		std::size_t bitmap_bytes = 0;
+
+		for (unsigned size = 12; size <= 64; size += 4)
+		{
+			const auto row_width = glyph_count * (static_cast<unsigned>(0.55f * size) + 10u);
+			bitmap_bytes += std::size_t(row_width) * (size * 22u / 16u) * 4u;
+		}
+
+		// A single R8 page of distance fields, packed the way
+		// Font::add_distance_field packs them
+		const unsigned glyph_width	= static_cast<unsigned>(0.55f * reference_size) + 2 * spread + 1;
+		const unsigned glyph_height	= static_cast<unsigned>(0.7f * reference_size) + 2 * spread + 1;
+
+		unsigned page = 256;
+
+		for (bool packed = false; !packed; )
+		{
+			MaxRects bin(page, page);
+			MaxRects::Rect rect;
+
+			packed = true;
+
+			for (unsigned i = 0; i < glyph_count && packed; i++)
+				packed = bin.insert(glyph_width, glyph_height, rect);
+
+			if (!packed)
+				page *= 2;
+		}
+
+		const std::size_t field_bytes = std::size_t(page) * page;
+
+		std::cout << "Bitmap atlases for 14 sizes (12 to 64 px) : " << bitmap_bytes / 1024 << " KB, "
+			<< "one distance field page (" << page << "x" << page << " R8, any size) : "
+			<< field_bytes / 1024 << " KB" << std::endl;
+	}
+}
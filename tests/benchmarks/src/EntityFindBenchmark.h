@@ -0,0 +1,91 @@
+#pragma once
+
+#include <corgi/ecs/Entity.h>
+#include <corgi/ecs/Scene.h>
+#include <corgi/utils/time/Timer.h>
+
+#include <algorithm>
+#include <cstring>
+#include <iostream>
+#include <string>
+#include <vector>
+
+namespace corgi
+{
+	// What Entity::find used to do : a depth first walk comparing every name
+	static RefEntity iterator_find(Entity& entity, const char* name)
+	{
+		auto it = std::find_if(entity.begin(), entity.end(), [&](RefEntity e)->bool
+		{
+			return std::strcmp(e->name(), name) == 0;
+		});
+
+		if (it == entity.end())
+			return RefEntity();
+		return *it;
+	}
+
+	inline void test_entity_find()
+	{
+		const int groups = 1000;
+		const int group_size = 99;
+
+		Scene scene;
+
+		std::vector<RefEntity> group_entities;
+		std::vector<std::string> names;
+
+		for (int g = 0; g < groups; g++)
+		{
+			auto group = scene.new_entity("Group " + std::to_string(g));
+			group_entities.push_back(group);
+
+			for (int i = 0; i < group_size; i++)
+			{
+				// Every group uses the same "Enemy" name, the rest is unique
+				if (i == group_size - 1)
+					group->emplace_back("Enemy");
+				else
+					group->emplace_back(("Entity " + std::to_string(g) + " " + std::to_string(i)).c_str());
+			}
+			names.push_back("Entity " + std::to_string(g) + " " + std::to_string(group_size / 2));
+		}
+
+		std::cout << "Entity find on a scene of " << groups * (group_size + 1) << " entities" << std::endl;
+
+		// The walk is so slow it only gets a few lookups
+		const int iterator_lookups = 20;
+		const int index_lookups = 100000;
+
+		corgi::time::Timer timer;
+		size_t found = 0;
+
+		auto report = [&](const char* label, int count)
+		{
+			std::cout << label << " : " << timer.elapsed_time() * 1000000.0f / count << " us per lookup (" << found << "/" << count << " found)" << std::endl;
+			found = 0;
+		};
+
+		timer.start();
+		for (int i = 0; i < iterator_lookups; i++)
+			found += static_cast<bool>(iterator_find(*scene.root(), names[(i * 7919) % groups].c_str()));
+		report("Iterator find", iterator_lookups);
+
+		timer.start();
+		for (int i = 0; i < index_lookups; i++)
+			found += static_cast<bool>(scene.find(names[(i * 7919) % groups]));
+		report("Indexed find", index_lookups);
+
+		// Scoped lookups of a name shared by every group
+
+		timer.start();
+		for (int i = 0; i < iterator_lookups; i++)
+			found += static_cast<bool>(iterator_find(*group_entities[(i * 7919) % groups], "Enemy"));
+		report("Iterator subtree find", iterator_lookups);
+
+		timer.start();
+		for (int i = 0; i < index_lookups; i++)
+			found += static_cast<bool>(group_entities[(i * 7919) % groups]->find("Enemy"));
+		report("Indexed subtree find", index_lookups);
+	}
+}
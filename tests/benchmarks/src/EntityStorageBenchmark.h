@@ -0,0 +1,56 @@
+#pragma once
+
+#include <corgi/ecs/Entity.h>
+#include <corgi/ecs/Scene.h>
+#include <corgi/utils/time/Timer.h>
+
+#include <iostream>
+#include <string>
+
+namespace corgi
+{
+	// Entities share a handful of names, which is what most scenes look like
+	inline void test_entity_storage()
+	{
+		const int roots		= 1000;
+		const int children	= 100;
+
+		std::cout << "Creating " << roots * (children + 1) << " entities" << std::endl;
+
+		corgi::time::Timer timer;
+
+		Scene scene;
+
+		timer.start();
+		for (int i = 0; i < roots; i++)
+		{
+			auto root = scene.new_entity("Group");
+
+			for (int j = 0; j < children; j++)
+				root->emplace_back("Enemy");
+		}
+		std::cout << "Entities created in : " << timer.elapsed_time() * 1000.0f << " ms ("
+			<< scene.names().size() << " distinct names)" << std::endl;
+
+		int visited = 0;
+
+		timer.start();
+		for (auto entity : *scene.root())
+			visited += entity->id().id_ != EntityId::npos;
+		std::cout << "Depth first walk done in : " << timer.elapsed_time() * 1000.0f << " ms ("
+			<< visited << " entities)" << std::endl;
+
+		visited = 0;
+
+		timer.start();
+		for (auto root : scene.root()->children())
+			for (auto child : root->children())
+				visited += child->id().id_ != EntityId::npos;
+		std::cout << "Children walk done in : " << timer.elapsed_time() * 1000.0f << " ms ("
+			<< visited << " entities)" << std::endl;
+
+		timer.start();
+		scene.clear();
+		std::cout << "Entities removed in : " << timer.elapsed_time() * 1000.0f << " ms" << std::endl;
+	}
+}
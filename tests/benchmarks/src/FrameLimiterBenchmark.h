@@ -0,0 +1,62 @@
+#pragma once
+
+#include <corgi/utils/time/FrameLimiter.h>
+#include <corgi/utils/time/FrameTimeHistogram.h>
+
+#include <chrono>
+#include <iostream>
+
+namespace corgi
+{
+	// Runs frames of about 2 ms of work at the given frame rate and records
+	// how long every frame really lasted
+	inline time::FrameTimeHistogram run_limited_frames(float frame_rate, float spin_time, int frames)
+	{
+		using Clock = std::chrono::steady_clock;
+
+		time::FrameLimiter limiter;
+		limiter.target_frame_rate(frame_rate);
+		limiter.spin_time(spin_time);
+
+		time::FrameTimeHistogram histogram;
+
+		auto last = Clock::now();
+
+		for (int i = 0; i < frames; i++)
+		{
+			const auto work_end = Clock::now() + std::chrono::milliseconds(2);
+			while (Clock::now() < work_end)
+				;
+
+			limiter.wait();
+
+			const auto now = Clock::now();
+
+			// The first frame only starts the limiter
+			if (i != 0)
+				histogram.add(std::chrono::duration<float>(now - last).count());
+			last = now;
+		}
+		return histogram;
+	}
+
+	inline void print_frame_times(const char* label, const time::FrameTimeHistogram& histogram)
+	{
+		std::cout << label << " : average " << histogram.average() * 1000.0f
+			<< " ms, p50 " << histogram.percentile(50.0f) * 1000.0f
+			<< " ms, p99 " << histogram.percentile(99.0f) * 1000.0f
+			<< " ms, longest " << histogram.longest() * 1000.0f << " ms" << std::endl;
+	}
+
+	inline void test_frame_limiter()
+	{
+		const float frame_rate	= 144.0f;
+		const int	frames		= 300;
+
+		std::cout << "Limiting " << frames << " frames to " << frame_rate << " fps ("
+			<< 1000.0f / frame_rate << " ms per frame)" << std::endl;
+
+		print_frame_times("Sleep only", run_limited_frames(frame_rate, 0.0f, frames));
+		print_frame_times("Sleep and spin", run_limited_frames(frame_rate, 0.002f, frames));
+	}
+}
@@ -0,0 +1,119 @@
+#pragma once
+
+#include <corgi/filesystem/MappedFile.h>
+#include <corgi/utils/StagingPool.h>
+#include <corgi/utils/time/Timer.h>
+
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <string>
+#include <vector>
+
+namespace corgi
+{
+	// Loads a batch of 48 raw .img files, 256 to 1024 pixels wide, 5 times,
+	// the way Texture used to read them and the way it reads them now. The
+	// upload itself needs an OpenGL context, so the pixels are copied to a
+	// staging buffer instead, which is what uploading from client memory or
+	// filling a pixel buffer costs on the CPU side
+	inline void test_image_loading()
+	{
+		const int image_count	= 48;
+		const int passes		= 5;
+
+		const auto root = std::filesystem::temp_directory_path() / "corgi_image_benchmark";
+		std::filesystem::remove_all(root);
+		std::filesystem::create_directories(root);
+
+		std::vector<std::string> paths;
+		std::size_t total_bytes = 0;
+
+		for (int i = 0; i < image_count; i++)
+		{
+			const int size		= 256 << (i % 3);
+			const int channels	= 4;
+
+			std::vector<std::uint8_t> pixels(std::size_t(size) * size * channels);
+
+			for (std::size_t p = 0; p < pixels.size(); p++)
+				pixels[p] = static_cast<std::uint8_t>(p * 7 + i);
+
+			paths.push_back((root / ("image_" + std::to_string(i) + ".img")).string());
+
+			std::ofstream file(paths.back(), std::ofstream::binary);
+			file.write(reinterpret_cast<const char*>(&size), sizeof size);
+			file.write(reinterpret_cast<const char*>(&size), sizeof size);
+			file.write(reinterpret_cast<const char*>(&channels), sizeof channels);
+			file.write(reinterpret_cast<const char*>(pixels.data()), static_cast<std::streamsize>(pixels.size()));
+
+			total_bytes += pixels.size();
+		}
+
+		corgi::time::Timer timer;
+		std::uint32_t checksum = 0;
+
+		// Before : the file was read into a vector, then copied into a new
+		// buffer for every image
+		std::size_t allocations = 0;
+
+		timer.start();
+		for (int pass = 0; pass < passes; pass++)
+		{
+			for (const auto& path : paths)
+			{
+				std::ifstream file(path, std::ifstream::binary);
+				const std::vector<char> image((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+
+				const auto size = image.size() - 3 * sizeof(int);
+				auto* staging = new unsigned char[size];
+				std::memcpy(staging, image.data() + 3 * sizeof(int), size);
+				checksum += staging[size / 2];
+				delete[] staging;
+
+				// The vector also grows while it's read
+				allocations += 2;
+			}
+		}
+		const auto before = timer.elapsed_time();
+
+		// Now : the file is mapped, and its pixels copied once into a buffer
+		// of the pool
+		StagingPool pool;
+
+		timer.start();
+		for (int pass = 0; pass < passes; pass++)
+		{
+			for (const auto& path : paths)
+			{
+				const filesystem::MappedFile image(path);
+
+				const auto size = image.size() - 3 * sizeof(int);
+				auto* staging = pool.allocate(size);
+				std::memcpy(staging, image.data() + 3 * sizeof(int), size);
+				checksum += static_cast<std::uint32_t>(staging[size / 2]);
+				pool.release(staging);
+			}
+		}
+		const auto after = timer.elapsed_time();
+
+		std::filesystem::remove_all(root);
+
+		const auto loads = static_cast<float>(image_count * passes);
+		const auto megabytes = static_cast<float>(total_bytes * passes) / (1024.0f * 1024.0f);
+
+		// Keeps the copies from being optimized away
+		volatile std::uint32_t sink = checksum;
+		(void)sink;
+
+		std::cout << "Image loading (" << image_count << " images, " << total_bytes / (1024 * 1024) << " MB, "
+			<< passes << " passes)" << std::endl;
+		std::cout << "  ifstream + new[] : " << before * 1000.0f / loads << " ms per image, "
+			<< megabytes / before << " MB/s, at least " << allocations << " allocations" << std::endl;
+		std::cout << "  mapped + staging pool : " << after * 1000.0f / loads << " ms per image, "
+			<< megabytes / after << " MB/s, " << pool.system_allocations() << " allocations" << std::endl;
+	}
+}
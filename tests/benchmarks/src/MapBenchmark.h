@@ -0,0 +1,148 @@
+#pragma once
+
+#include <corgi/containers/FlatMap.h>
+#include <corgi/containers/HashMap.h>
+#include <corgi/utils/time/Timer.h>
+
+#include <algorithm>
+#include <iostream>
+#include <map>
+#include <random>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+namespace corgi
+{
+	// Inserts every key, then looks each of them up several times, half of the
+	// lookups missing. Keys are resource like paths, looked up as string_views
+	// when the map allows it, otherwise as the strings they were built from
+	template<class MapType>
+	inline void benchmark_map(const char* name, const std::vector<std::string>& keys,
+		const std::vector<std::string>& lookups)
+	{
+		corgi::time::Timer timer;
+
+		timer.start();
+		MapType map;
+
+		for (std::size_t i = 0; i < keys.size(); i++)
+			map[keys[i]] = static_cast<int>(i);
+
+		const auto insert_time = timer.elapsed_time();
+
+		long long sum = 0;
+
+		timer.start();
+		for (int pass = 0; pass < 10; pass++)
+		{
+			for (const auto& lookup : lookups)
+			{
+				if constexpr (requires { map.find(std::string_view(lookup)); })
+				{
+					if (auto it = map.find(std::string_view(lookup)); it != map.end())
+						sum += it->second;
+				}
+				else
+				{
+					if (auto it = map.find(lookup); it != map.end())
+						sum += it->second;
+				}
+			}
+		}
+		const auto lookup_time = timer.elapsed_time();
+
+		timer.start();
+		for (int pass = 0; pass < 10; pass++)
+		{
+			for (const auto& [key, value] : map)
+				sum += value;
+		}
+		const auto iteration_time = timer.elapsed_time();
+
+		std::cout << name << " : inserted " << keys.size() << " keys in " << insert_time * 1000.0f
+			<< " ms, " << lookups.size() * 10 << " lookups in " << lookup_time * 1000.0f
+			<< " ms, 10 iterations in " << iteration_time * 1000.0f << " ms (" << sum << ")" << std::endl;
+	}
+
+	// Sorted integer keys, the worst case of an unbalanced binary tree
+	template<class MapType>
+	inline void benchmark_sorted_map(const char* name, int count)
+	{
+		corgi::time::Timer timer;
+
+		timer.start();
+		MapType map;
+
+		for (int i = 0; i < count; i++)
+			map[i] = i;
+
+		long long sum = 0;
+
+		for (int i = 0; i < count; i++)
+			sum += map.find(i)->second;
+
+		std::cout << name << " : " << count << " sorted insertions and lookups in "
+			<< timer.elapsed_time() * 1000.0f << " ms (" << sum << ")" << std::endl;
+	}
+
+	inline void test_maps()
+	{
+		const int key_count = 20000;
+
+		std::vector<std::string> keys;
+
+		for (int i = 0; i < key_count; i++)
+			keys.push_back("textures/characters/sprite_" + std::to_string(i) + ".tex");
+
+		// Half of the lookups find nothing
+		std::vector<std::string> lookups;
+
+		for (int i = 0; i < key_count; i++)
+			lookups.push_back(i % 2 == 0 ? keys[i] : "shaders/unknown_" + std::to_string(i) + ".vs");
+
+		std::shuffle(keys.begin(), keys.end(), std::mt19937(42));
+		std::shuffle(lookups.begin(), lookups.end(), std::mt19937(7));
+
+		benchmark_map<std::map<std::string, int>>("std::map", keys, lookups);
+		benchmark_map<std::map<std::string, int, std::less<>>>("std::map<less<>>", keys, lookups);
+		benchmark_map<std::unordered_map<std::string, int>>("std::unordered_map", keys, lookups);
+		benchmark_map<HashMap<std::string, int>>("corgi::HashMap", keys, lookups);
+
+		// Inserting into a FlatMap one by one moves half of it every time, so
+		// it's built from a vector like a map loaded once would be
+		corgi::time::Timer timer;
+
+		timer.start();
+		std::vector<std::pair<std::string, int>> items;
+
+		for (std::size_t i = 0; i < keys.size(); i++)
+			items.emplace_back(keys[i], static_cast<int>(i));
+
+		FlatMap<std::string, int> flat_map(std::move(items));
+		const auto build_time = timer.elapsed_time();
+
+		long long sum = 0;
+
+		timer.start();
+		for (int pass = 0; pass < 10; pass++)
+		{
+			for (const auto& lookup : lookups)
+			{
+				if (auto it = flat_map.find(std::string_view(lookup)); it != flat_map.end())
+					sum += it->second;
+			}
+		}
+		const auto lookup_time = timer.elapsed_time();
+
+		std::cout << "corgi::FlatMap : built from " << keys.size() << " keys in " << build_time * 1000.0f
+			<< " ms, " << lookups.size() * 10 << " lookups in " << lookup_time * 1000.0f << " ms ("
+			<< sum << ")" << std::endl;
+
+		benchmark_sorted_map<std::map<int, int>>("std::map", 100000);
+		benchmark_sorted_map<std::unordered_map<int, int>>("std::unordered_map", 100000);
+		benchmark_sorted_map<HashMap<int, int>>("corgi::HashMap", 100000);
+		benchmark_sorted_map<FlatMap<int, int>>("corgi::FlatMap", 100000);
+	}
+}
@@ -0,0 +1,100 @@
+#pragma once
+
+#include <corgi/filesystem/FileSystem.h>
+#include <corgi/filesystem/PackFile.h>
+#include <corgi/filesystem/VirtualFileSystem.h>
+#include <corgi/utils/time/Timer.h>
+
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <string>
+#include <vector>
+
+namespace corgi
+{
+	// Loads 2000 small resources the way ResourcesCache::find does, going
+	// through every resource directory, then from a single mounted pack
+	inline void test_pack_file()
+	{
+		const int file_count		= 2000;
+		const int directory_count	= 3;
+
+		const auto root = std::filesystem::temp_directory_path() / "corgi_pack_benchmark";
+		std::filesystem::remove_all(root);
+
+		std::vector<std::string> directories;
+
+		for (int i = 0; i < directory_count; i++)
+		{
+			directories.push_back((root / ("resources_" + std::to_string(i))).string());
+			std::filesystem::create_directories(directories.back() + "/textures");
+		}
+
+		std::vector<std::string> identifiers;
+		std::vector<filesystem::PackFile::File> files;
+
+		// Files all live inside the last directory, the others are searched first
+		for (int i = 0; i < file_count; i++)
+		{
+			identifiers.push_back("textures/texture_" + std::to_string(i) + ".tex");
+
+			const std::string content = "{ \"min_filter\" : \"nearest\", \"index\" : " + std::to_string(i) + " }";
+
+			std::ofstream(directories.back() + "/" + identifiers.back()) << content;
+
+			auto& file = files.emplace_back(identifiers.back(), std::vector<std::byte>(content.size()));
+			std::memcpy(file.second.data(), content.data(), content.size());
+		}
+
+		const auto pack_path = (root / "resources.pak").string();
+		filesystem::PackFile::write(pack_path, files);
+
+		corgi::time::Timer timer;
+
+		std::size_t bytes			= 0;
+		std::size_t existence_tests	= 0;
+		std::size_t opened_files	= 0;
+
+		timer.start();
+		for (const auto& identifier : identifiers)
+		{
+			for (const auto& directory : directories)
+			{
+				const auto path = directory + "/" + identifier;
+
+				existence_tests++;
+
+				if (filesystem::file_exist(path))
+				{
+					opened_files++;
+
+					std::ifstream file(path, std::ifstream::binary);
+					const std::string content((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+					bytes += content.size();
+					break;
+				}
+			}
+		}
+		std::cout << "Loaded " << file_count << " files from directories in : " << timer.elapsed_time() * 1000.0f
+			<< " ms (" << existence_tests << " existence tests, " << opened_files << " files opened, "
+			<< bytes << " bytes)" << std::endl;
+
+		bytes = 0;
+
+		timer.start();
+		filesystem::VirtualFileSystem vfs;
+		vfs.mount(pack_path);
+
+		for (const auto& identifier : identifiers)
+			bytes += vfs.read(identifier).size();
+
+		std::cout << "Loaded " << file_count << " files from a pack in : " << timer.elapsed_time() * 1000.0f
+			<< " ms (1 file opened, " << bytes << " bytes)" << std::endl;
+
+		vfs.unmount_all();
+		std::filesystem::remove_all(root);
+	}
+}
@@ -0,0 +1,77 @@
+#pragma once
+
+#include <corgi/ecs/Entity.h>
+#include <corgi/ecs/Prefab.h>
+#include <corgi/ecs/Scene.h>
+#include <corgi/utils/time/Timer.h>
+
+#include <iostream>
+#include <string>
+
+namespace corgi
+{
+	struct PrefabBenchmarkPosition
+	{
+		float x = 0.0f;
+		float y = 0.0f;
+	};
+
+	struct PrefabBenchmarkHealth
+	{
+		int value = 100;
+	};
+
+	// A root with 19 descendants spread on 3 levels
+	inline RefEntity make_benchmark_prefab(Scene& scene)
+	{
+		auto root = scene.new_entity("Enemy");
+		root->add_component<PrefabBenchmarkPosition>();
+		root->add_component<PrefabBenchmarkHealth>();
+
+		for (int i = 0; i < 3; i++)
+		{
+			auto limb = root->emplace_back(("Limb " + std::to_string(i)).c_str());
+			limb->add_component<PrefabBenchmarkPosition>();
+
+			for (int j = 0; j < 5; j++)
+			{
+				auto part = limb->emplace_back(("Part " + std::to_string(j)).c_str());
+				part->add_component<PrefabBenchmarkPosition>();
+			}
+		}
+		root->emplace_back("Sensor");
+		return root;
+	}
+
+	inline void test_prefab_instantiation()
+	{
+		const int copies = 500;
+
+		std::cout << "Spawning " << copies << " copies of a 20 entities prefab" << std::endl;
+
+		corgi::time::Timer timer;
+
+		{
+			Scene scene;
+			auto source = make_benchmark_prefab(scene);
+
+			timer.start();
+			for (int i = 0; i < copies; i++)
+				scene.clone(source, scene.root());
+			std::cout << "Scene::clone done in : " << timer.elapsed_time() * 1000.0f << " ms" << std::endl;
+		}
+
+		{
+			Scene scene;
+			auto source = make_benchmark_prefab(scene);
+
+			timer.start();
+			Prefab prefab(source);
+			std::cout << "Prefab compiled in : " << timer.elapsed_time() * 1000.0f << " ms" << std::endl;
+
+			timer.start();
+			auto roots = prefab.instantiate(scene, copies);
+			std::cout << "Prefab::instantiate done in : " << timer.elapsed_time() * 1000.0f << " ms (" << roots.size() << " copies)" << std::endl;
+		}
+	}
+}
@@ -0,0 +1,84 @@
+#pragma once
+
+#include <corgi/ecs/Entity.h>
+#include <corgi/ecs/Scene.h>
+#include <corgi/ecs/SceneSnapshot.h>
+#include <corgi/utils/time/Timer.h>
+
+#include <cstdio>
+#include <iostream>
+#include <string>
+#include <vector>
+
+namespace corgi
+{
+	struct SnapshotBenchmarkPosition
+	{
+		float x = 0.0f;
+		float y = 0.0f;
+		float z = 0.0f;
+	};
+
+	struct SnapshotBenchmarkVelocity
+	{
+		float x = 0.0f;
+		float y = 0.0f;
+	};
+
+	inline void test_scene_snapshot()
+	{
+		const int groups   = 10000;
+		const int children = 9;
+
+		ComponentRegistry::add<SnapshotBenchmarkPosition>("SnapshotBenchmarkPosition");
+		ComponentRegistry::add<SnapshotBenchmarkVelocity>("SnapshotBenchmarkVelocity");
+
+		Scene scene;
+
+		for (int i = 0; i < groups; i++)
+		{
+			auto group = scene.new_entity(("Group " + std::to_string(i % 100)).c_str());
+			group->add_component<SnapshotBenchmarkPosition>();
+			group->add_component<SnapshotBenchmarkVelocity>();
+
+			for (int j = 0; j < children; j++)
+			{
+				auto child = group->emplace_back("Child");
+				child->add_component<SnapshotBenchmarkPosition>();
+			}
+		}
+
+		std::cout << "Saving and loading a scene of " << groups * (children + 1) << " entities" << std::endl;
+
+		corgi::time::Timer timer;
+		std::vector<char> buffer;
+
+		timer.start();
+		SceneSnapshot::write(scene, buffer);
+		std::cout << "SceneSnapshot::write done in : " << timer.elapsed_time() * 1000.0f << " ms (" << buffer.size() / 1024 << " KB)" << std::endl;
+
+		{
+			Scene loaded;
+
+			timer.start();
+			SceneSnapshot::read(loaded, buffer.data(), buffer.size());
+			std::cout << "SceneSnapshot::read done in : " << timer.elapsed_time() * 1000.0f << " ms" << std::endl;
+		}
+
+		const std::string path = "snapshot_benchmark.snp";
+
+		timer.start();
+		SceneSnapshot::save(scene, path);
+		std::cout << "SceneSnapshot::save done in : " << timer.elapsed_time() * 1000.0f << " ms" << std::endl;
+
+		{
+			Scene loaded;
+
+			timer.start();
+			SceneSnapshot::load(loaded, path);
+			std::cout << "SceneSnapshot::load done in : " << timer.elapsed_time() * 1000.0f << " ms" << std::endl;
+		}
+
+		std::remove(path.c_str());
+	}
+}
@@ -0,0 +1,82 @@
+#pragma once
+
+#include <corgi/rendering/Material.h>
+#include <corgi/rendering/SpriteBatch.h>
+#include <corgi/rendering/texture.h>
+#include <corgi/utils/time/Timer.h>
+
+#include <iostream>
+#include <vector>
+
+namespace corgi
+{
+	// Fills the sprite batches the way Renderer::draw_sprites does for 100k
+	// animated sprites spread over a few textures. Before batching, each of
+	// these sprites was a separate draw call with its own material
+	inline void test_sprite_batching()
+	{
+		const int sprite_count	= 100000;
+		const int texture_count	= 4;
+		const int frame_count	= 8;
+		const int iterations	= 10;
+
+		// Textures are never released, their destructor needs an OpenGL context
+		std::vector<Texture*> textures;
+
+		for (int i = 0; i < texture_count; i++)
+			textures.push_back(new Texture());
+
+		// Built by hand so no shader needs to be compiled
+		Material material("bench");
+		material._texture_uniforms.emplace_back("main_texture", 0, nullptr);
+
+		std::vector<SpriteInstance> sprites(sprite_count);
+
+		for (int i = 0; i < sprite_count; i++)
+		{
+			auto& sprite = sprites[i];
+
+			for (int j = 0; j < 16; j++)
+				sprite.world_matrix[j] = (j % 5 == 0) ? 1.0f : 0.0f;
+
+			sprite.world_matrix[12] = static_cast<float>(i % 1000);
+			sprite.world_matrix[13] = static_cast<float>(i / 1000);
+
+			sprite.quad[0] = 1.0f;
+			sprite.quad[1] = 1.0f;
+			sprite.quad[2] = 0.5f;
+			sprite.quad[3] = 0.5f;
+			sprite.tint    = SpriteBatch::pack_color(255, 255, 255, 255);
+		}
+
+		SpriteBatch batch;
+		corgi::time::Timer timer;
+
+		float total = 0.0f;
+
+		for (int iteration = 0; iteration < iterations; iteration++)
+		{
+			// Every sprite changes frame, which only touches its uv rect
+			for (int i = 0; i < sprite_count; i++)
+			{
+				const int frame = (i + iteration) % frame_count;
+
+				sprites[i].uv_rect[0] = static_cast<float>(frame) / frame_count;
+				sprites[i].uv_rect[1] = 0.0f;
+				sprites[i].uv_rect[2] = 1.0f / frame_count;
+				sprites[i].uv_rect[3] = 1.0f;
+			}
+
+			timer.start();
+			batch.clear();
+
+			for (int i = 0; i < sprite_count; i++)
+				batch.emplace(material, *textures[(i / 256) % texture_count]) = sprites[i];
+			total += timer.elapsed_time();
+		}
+
+		std::cout << "Batched " << batch.instance_count() << " sprites in "
+			<< total / iterations * 1000.0f << " ms per frame, "
+			<< batch.draw_count() << " draw calls" << std::endl;
+	}
+}
@@ -0,0 +1,105 @@
+#pragma once
+
+#include <corgi/ui/TextLayout.h>
+#include <corgi/utils/time/Timer.h>
+
+#include <iostream>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace corgi
+{
+	// Stands for HarfBuzz, which needs a font and can't run here : one glyph
+	// per character, built the way buildShapedGlyphs builds them. The real
+	// shaping costs more per character, so the gap between both paths is
+	// wider in a game
+	inline std::vector<utils::text::ShapedGlyph> benchmark_shaper(std::string_view line, int textOffset)
+	{
+		std::vector<utils::text::ShapedGlyph> glyphs;
+		glyphs.reserve(line.size());
+
+		for (std::size_t i = 0; i < line.size(); i++)
+		{
+			utils::text::ShapedGlyph glyph {};
+			glyph.advance.x		= 7.0 + (line[i] & 3);
+			glyph.codepoint		= line[i];
+			glyph.cluster		= static_cast<unsigned>(i);
+			glyph.characters	= {line[i]};
+			glyph.textOffset	= textOffset + static_cast<int>(i);
+			glyphs.push_back(std::move(glyph));
+		}
+		return glyphs;
+	}
+
+	// Types 200 characters, then erases them, in the middle of a 50 KB script,
+	// the way the TextBox used to do it and the way it does it now
+	inline void test_text_editing()
+	{
+		std::string document;
+
+		for (int line = 0; document.size() < 50 * 1024; line++)
+			document += "    local value_" + std::to_string(line) + " = compute(entity, " + std::to_string(line * 7) + ") -- comment\n";
+
+		const int keystrokes = 200;
+		const std::size_t cursor = document.size() / 2;
+
+		corgi::time::Timer timer;
+
+		// Before : the whole string was shaped again after every keystroke
+		{
+			std::string text = document;
+			std::size_t shaped = 0;
+
+			timer.start();
+			for (int i = 0; i < keystrokes; i++)
+			{
+				text.insert(cursor + i, 1, 'a' + i % 26);
+
+				std::vector<utils::text::ShapedGlyph> glyphs = benchmark_shaper(text, 0);
+				shaped += text.size();
+			}
+			for (int i = keystrokes; i > 0; i--)
+			{
+				text.erase(cursor + i - 1, 1);
+
+				std::vector<utils::text::ShapedGlyph> glyphs = benchmark_shaper(text, 0);
+				shaped += text.size();
+			}
+			const auto elapsed = timer.elapsed_time();
+
+			std::cout << "Full reshape : " << elapsed * 1000000.0f / (2 * keystrokes)
+				<< " us per keystroke, " << shaped / (2 * keystrokes) << " characters shaped per keystroke" << std::endl;
+		}
+
+		// Now : only the edited line is shaped again
+		{
+			ui::TextLayout layout(benchmark_shaper);
+
+			timer.start();
+			layout.setText(document);
+			const auto setup = timer.elapsed_time();
+
+			std::size_t shaped = 0;
+
+			timer.start();
+			for (int i = 0; i < keystrokes; i++)
+			{
+				const char character = static_cast<char>('a' + i % 26);
+
+				layout.replace(cursor + i, 0, std::string_view(&character, 1));
+				shaped += layout.shapedCharacters();
+			}
+			for (int i = keystrokes; i > 0; i--)
+			{
+				layout.replace(cursor + i - 1, 1, {});
+				shaped += layout.shapedCharacters();
+			}
+			const auto elapsed = timer.elapsed_time();
+
+			std::cout << "Incremental reshape : " << elapsed * 1000000.0f / (2 * keystrokes)
+				<< " us per keystroke, " << shaped / (2 * keystrokes) << " characters shaped per keystroke ("
+				<< layout.lineCount() << " lines, shaped once in " << setup * 1000.0f << " ms)" << std::endl;
+		}
+	}
+}
@@ -0,0 +1,78 @@
+#pragma once
+
+#include <corgi/rendering/DrawList.h>
+#include <corgi/utils/time/Timer.h>
+
+#include <iostream>
+#include <string>
+#include <vector>
+
+namespace corgi
+{
+	// Builds the quads of a left aligned single line text the way
+	// DrawList::Text::update does, with a fixed advance per character, since
+	// the real one needs a font
+	inline void benchmark_text_quads(const std::string& text, std::vector<float>& vertices)
+	{
+		vertices.assign(text.size() * 20, 0.0f);
+
+		for (std::size_t i = 0; i < text.size(); i++)
+		{
+			const float x = 9.0f * static_cast<float>(i);
+			const float u = static_cast<float>(text[i]) / 128.0f;
+			float* quad	= vertices.data() + i * 20;
+
+			const float values[20] = {x,		0.0f,  0.0f, u,			0.0f,
+									  x + 8.0f, 0.0f,  0.0f, u + 0.01f, 0.0f,
+									  x + 8.0f, 14.0f, 0.0f, u + 0.01f, 1.0f,
+									  x,		14.0f, 0.0f, u,			1.0f};
+			std::copy(values, values + 20, quad);
+		}
+	}
+
+	// A score label changing every frame, during 10000 frames. Before, every
+	// change built a new mesh and uploaded all its vertices and indexes. Now
+	// the mesh keeps its buffers and only uploads the quads that changed
+	inline void test_text_mesh()
+	{
+		const int frames = 10000;
+
+		std::vector<float> before;
+		std::vector<float> after;
+
+		std::size_t rebuild_bytes		= 0;
+		std::size_t incremental_bytes	= 0;
+		std::size_t reallocations		= 0;
+		std::size_t capacity			= 0;
+
+		corgi::time::Timer timer;
+		timer.start();
+
+		for (int frame = 0; frame < frames; frame++)
+		{
+			benchmark_text_quads("Score : " + std::to_string(frame * 7), after);
+
+			const auto quads = after.size() / 20;
+
+			rebuild_bytes += after.size() * sizeof(float) + quads * 6 * sizeof(unsigned);
+
+			if (after.size() > capacity)
+			{
+				capacity = DrawList::Text::grown_quad_capacity(quads) * 20;
+				incremental_bytes += after.size() * sizeof(float) + capacity / 20 * 6 * sizeof(unsigned);
+				reallocations++;
+			}
+			else
+			{
+				incremental_bytes += DrawList::Text::changed_range(before, after).second * sizeof(float);
+			}
+			std::swap(before, after);
+		}
+		const auto elapsed = timer.elapsed_time();
+
+		std::cout << "Rebuilt text mesh : " << rebuild_bytes / frames << " bytes uploaded and 1 mesh created per frame" << std::endl;
+		std::cout << "Incremental text mesh : " << incremental_bytes / frames << " bytes uploaded per frame, "
+			<< reallocations << " reallocations in " << frames << " frames (diffing took "
+			<< elapsed * 1000000.0f / frames << " us per frame)" << std::endl;
+	}
+}
@@ -0,0 +1,100 @@
+#pragma once
+
+#include <corgi/utils/TextureCompression.h>
+#include <corgi/utils/time/Timer.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <iostream>
+#include <utility>
+#include <vector>
+
+namespace corgi
+{
+	// Encodes a 512x512 sprite sheet like image with each format, then decodes
+	// it back to compare the memory taken and the quality kept
+	inline void test_texture_compression()
+	{
+		using namespace texture_compression;
+
+		const unsigned size = 512;
+
+		texture_compression::Image image;
+		image.width		= size;
+		image.height	= size;
+		image.pixels.resize(size * size * 4);
+
+		// Gradients, hard edges and noise inside soft edged discs, on a
+		// transparent background
+		std::uint32_t seed = 12345u;
+
+		for (unsigned y = 0; y < size; y++)
+		{
+			for (unsigned x = 0; x < size; x++)
+			{
+				seed = seed * 1664525u + 1013904223u;
+
+				const float cx			= static_cast<float>(x % 64) - 31.5f;
+				const float cy			= static_cast<float>(y % 64) - 31.5f;
+				const float distance	= std::sqrt(cx * cx + cy * cy);
+
+				auto* pixel = &image.pixels[(static_cast<std::size_t>(y) * size + x) * 4];
+
+				pixel[0] = static_cast<std::uint8_t>(x / 2);
+				pixel[1] = static_cast<std::uint8_t>(((x / 16 + y / 16) % 2) * 160 + (seed >> 28));
+				pixel[2] = static_cast<std::uint8_t>(y / 2);
+				pixel[3] = static_cast<std::uint8_t>(std::clamp((30.0f - distance) * 64.0f, 0.0f, 255.0f));
+			}
+		}
+
+		// BC1 only keeps 1 bit of alpha, and its transparent pixels are black
+		texture_compression::Image bc1_reference = image;
+
+		for (std::size_t i = 0; i < bc1_reference.pixels.size(); i += 4)
+		{
+			if (bc1_reference.pixels[i + 3] < 128)
+				std::fill_n(bc1_reference.pixels.begin() + static_cast<std::ptrdiff_t>(i), 4, std::uint8_t {0});
+			else
+				bc1_reference.pixels[i + 3] = 255;
+		}
+
+		corgi::time::Timer timer;
+
+		const std::pair<Format, const char*> formats[] = {{Format::RGBA8, "RGBA8"},
+														  {Format::BC1, "BC1"},
+														  {Format::BC3, "BC3"},
+														  {Format::BC7, "BC7"}};
+
+		for (const auto& [format, name] : formats)
+		{
+			timer.start();
+			const auto encoded = encode(format, image);
+			const auto encode_time = timer.elapsed_time();
+
+			timer.start();
+			const auto decoded = decode(format, encoded, size, size);
+			const auto decode_time = timer.elapsed_time();
+
+			const double quality = psnr(format == Format::BC1 ? bc1_reference : image, decoded);
+
+			std::cout << name << " : " << encoded.size() << " bytes, " << quality << " dB, encoded in "
+				<< encode_time * 1000.0f << " ms, decoded in " << decode_time * 1000.0f << " ms"
+				<< std::endl;
+		}
+
+		timer.start();
+		const auto levels = generate_mips(image, true);
+		const auto mips_time = timer.elapsed_time();
+
+		const auto container = Container::write(Format::BC7, levels);
+
+		Container parsed;
+		parsed.parse(container);
+
+		std::cout << "Generated " << levels.size() << " mip levels in " << mips_time * 1000.0f
+			<< " ms, " << image.pixels.size() << " bytes uncompressed without mips, "
+			<< parsed.size() << " bytes as BC7 with mips (" << container.size() << " bytes container)"
+			<< std::endl;
+	}
+}
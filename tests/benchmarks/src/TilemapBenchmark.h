@@ -0,0 +1,221 @@
+#pragma once
+
+#include <corgi/components/TilemapRenderer.h>
+#include <corgi/resources/Tilemap.h>
+#include <corgi/utils/time/Timer.h>
+
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <random>
+#include <vector>
+
+namespace corgi
+{
+	// What generate_tileset_layer used to do to find the tileset of a tile
+	static int linear_tileset_search(const Tilemap& tilemap, long long tile_id)
+	{
+		for (int i = static_cast<int>(tilemap.tileset_infos.size()) - 1; i >= 0; i--)
+		{
+			if (tilemap.tileset_infos[i].firstgid <= tile_id)
+				return i;
+		}
+		return -1;
+	}
+
+	// What generate_tileset_layer used to do to know if a tile was animated
+	static bool linear_animation_search(const Tilemap::TilesetInfo& tileset_info, long long tile_id)
+	{
+		for (const auto& tile : tileset_info.tiles)
+		{
+			if (tile.id == tile_id)
+				return !tile.animations.empty();
+		}
+		return false;
+	}
+
+	inline Tilemap make_benchmark_tilemap(int width, int height)
+	{
+		Tilemap tilemap;
+		tilemap.width = width;
+		tilemap.height = height;
+		tilemap.tile_width = 16;
+		tilemap.tile_height = 16;
+
+		std::mt19937 generator(42);
+
+		// 4 tilesets of 256 tiles, each having 128 special tiles, 32 of them
+		// being animated
+
+		for (int t = 0; t < 4; t++)
+		{
+			Tilemap::TilesetInfo tileset_info;
+			tileset_info.firstgid = 1 + t * 256;
+			tileset_info.tile_count = 256;
+			tileset_info.columns = 16;
+			tileset_info.tile_width = 16;
+			tileset_info.tile_height = 16;
+			tileset_info.image_width = 256;
+			tileset_info.image_height = 256;
+
+			for (int i = 0; i < 128; i++)
+			{
+				Tilemap::TileInfo tile_info;
+				tile_info.id = i * 2;
+
+				if (i % 4 == 0)
+				{
+					for (unsigned f = 0; f < 4; f++)
+						tile_info.animations.push_back({static_cast<unsigned>(tile_info.id) + f, 100});
+				}
+				tileset_info.tiles.push_back(tile_info);
+			}
+			tilemap.tileset_infos.push_back(tileset_info);
+		}
+
+		std::uniform_int_distribution<std::uint32_t> gids(0, 4 * 256);
+
+		for (int l = 0; l < 2; l++)
+		{
+			Tilemap::TileLayer layer;
+			layer.name = "Layer" + std::to_string(l);
+			layer.width = static_cast<float>(width);
+			layer.height = static_cast<float>(height);
+			std::vector<std::uint32_t> tiles(static_cast<std::size_t>(width) * height);
+
+			for (auto& tile : tiles)
+				tile = gids(generator);
+
+			layer.data = Tilemap::TileData(std::move(tiles));
+
+			tilemap.tile_layers.push_back(std::move(layer));
+		}
+
+		return tilemap;
+	}
+
+	inline void test_tilemap_generation()
+	{
+		const int size = 1024;
+
+		auto tilemap = make_benchmark_tilemap(size, size);
+
+		std::cout << "Tilemap generation on 2 layers of " << size << "x" << size << " tiles and "
+			<< tilemap.tileset_infos.size() << " tilesets" << std::endl;
+
+		corgi::time::Timer timer;
+
+		// Every tile is classified once per tileset and twice per tile (once to
+		// count the tiles, once to emit them), like generate_tileset_layer used to
+
+		timer.start();
+		long long animated = 0;
+
+		for (const auto& layer : tilemap.tile_layers)
+		{
+			for (int t = 0; t < static_cast<int>(tilemap.tileset_infos.size()); t++)
+			{
+				const auto& tileset_info = tilemap.tileset_infos[t];
+
+				for (int pass = 0; pass < 2; pass++)
+				{
+					for (auto tile_id : layer.data)
+					{
+						if (tile_id == 0 || linear_tileset_search(tilemap, tile_id) != t)
+							continue;
+
+						animated += linear_animation_search(tileset_info, tile_id - tileset_info.firstgid);
+					}
+				}
+			}
+		}
+		std::cout << "Linear search classification done in : " << timer.elapsed_time() * 1000.0f << " ms (" << animated / 2 << " animated tiles)" << std::endl;
+
+		timer.start();
+		tilemap.build_lookup_tables();
+		std::cout << "Lookup tables built in : " << timer.elapsed_time() * 1000.0f << " ms" << std::endl;
+
+		timer.start();
+		animated = 0;
+
+		for (const auto& layer : tilemap.tile_layers)
+		{
+			for (int t = 0; t < static_cast<int>(tilemap.tileset_infos.size()); t++)
+			{
+				const auto& tileset_info = tilemap.tileset_infos[t];
+
+				for (auto tile_id : layer.data)
+				{
+					if (tile_id == 0 || tilemap.tileset_index(tile_id) != t)
+						continue;
+
+					animated += tileset_info.lookup(tile_id - tileset_info.firstgid).animation >= 0;
+				}
+			}
+		}
+		std::cout << "Lookup table classification done in : " << timer.elapsed_time() * 1000.0f << " ms (" << animated << " animated tiles)" << std::endl;
+
+		// Generating the vertices of every chunk, without uploading them
+
+		TilemapRenderer::ChunkGeometry geometry;
+		std::size_t vertices = 0;
+		const std::vector<int> no_frames;
+
+		timer.start();
+		for (int l = 0; l < static_cast<int>(tilemap.tile_layers.size()); l++)
+		{
+			for (int t = 0; t < static_cast<int>(tilemap.tileset_infos.size()); t++)
+			{
+				for (int row = 0; row < size; row += TilemapRenderer::chunk_size)
+				{
+					for (int column = 0; column < size; column += TilemapRenderer::chunk_size)
+					{
+						geometry.clear();
+						TilemapRenderer::build_geometry(tilemap, l, t, column, row,
+							column + TilemapRenderer::chunk_size, row + TilemapRenderer::chunk_size,
+							256, 256, no_frames, geometry);
+						vertices += geometry.vertices.size() / TilemapRenderer::floats_per_vertex;
+					}
+				}
+			}
+		}
+		std::cout << "Chunk geometry generated in : " << timer.elapsed_time() * 1000.0f << " ms (" << vertices << " vertices)" << std::endl;
+	}
+
+	inline void test_tilemap_loading()
+	{
+		const int size = 4096;
+		const char* path = "benchmark.tilemap";
+
+		make_benchmark_tilemap(size, size).save(path);
+
+		std::cout << "Tilemap loading with 2 layers of " << size << "x" << size << " tiles" << std::endl;
+
+		corgi::time::Timer timer;
+
+		// Roughly what the field by field format costs : reading every byte
+		// of the file through a stream, into memory we own
+
+		timer.start();
+		{
+			std::ifstream file(path, std::ifstream::binary | std::ifstream::ate);
+			std::vector<char> content(static_cast<std::size_t>(file.tellg()));
+			file.seekg(0);
+			file.read(content.data(), static_cast<std::streamsize>(content.size()));
+			std::cout << "Reading the " << content.size() / (1024 * 1024) << " MB file through a stream done in : " << timer.elapsed_time() * 1000.0f << " ms" << std::endl;
+		}
+
+		timer.start();
+		Tilemap tilemap(path, "benchmark");
+		std::cout << "Mapped tilemap loaded in : " << timer.elapsed_time() * 1000.0f << " ms" << std::endl;
+
+		timer.start();
+		std::uint64_t sum = 0;
+		for (const auto& layer : tilemap.tile_layers)
+			for (auto tile : layer.data)
+				sum += tile;
+		std::cout << "Touching every tile of the mapped tilemap done in : " << timer.elapsed_time() * 1000.0f << " ms (" << sum << ")" << std::endl;
+
+		std::remove(path);
+	}
+}
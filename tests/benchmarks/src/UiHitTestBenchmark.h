@@ -0,0 +1,165 @@
+#pragma once
+
+#include <corgi/containers/Node.h>
+#include <corgi/ui/HitTestIndex.h>
+#include <corgi/ui/Widget.h>
+#include <corgi/utils/time/Timer.h>
+
+#include <iostream>
+#include <random>
+#include <vector>
+
+namespace corgi
+{
+	/*
+	 * Widget that doesn't log anything when a child is added, and that can
+	 * be used as the root of a hierarchy, like the UISystem roots
+	 */
+	class BenchmarkWidget : public ui::Widget
+	{
+	public:
+
+		BenchmarkWidget() = default;
+
+		explicit BenchmarkWidget(Node<std::unique_ptr<ui::Widget>>& node)
+		{
+			mNode = &node;
+		}
+
+		void handleNewChild(ui::Widget*) override {}
+	};
+
+	// What the UISystem used to do for every mouse event : walking the whole
+	// hierarchy and testing every widget against the mouse position
+	static ui::Widget* brute_force_find_deepest(int x, int y, Node<std::unique_ptr<ui::Widget>>& root)
+	{
+		ui::Widget* selected = nullptr;
+		int depth = -1;
+
+		for (auto& node : root)
+		{
+			auto* widget = node.mValue.get();
+			const auto d = node.depth();
+
+			if (widget->eventsDisabled() || !widget->isEnabled() || !widget->isActive())
+				continue;
+
+			if (widget->contains(x, y) && d > depth && widget->mProcessEvent)
+			{
+				selected = widget;
+				depth = d;
+			}
+		}
+		return selected;
+	}
+
+	inline void test_ui_hit_test()
+	{
+		const float window_width = 1920.0f;
+		const float window_height = 1080.0f;
+
+		Node<std::unique_ptr<ui::Widget>> root;
+		root.mValue.reset(new BenchmarkWidget(root));
+		root.mValue->isViewport = true;
+		root.mValue->setWidth(window_width);
+		root.mValue->setHeight(window_height);
+
+		// 100 panels containing 99 buttons each, for a total of 10 000 widgets
+
+		for (int p = 0; p < 100; p++)
+		{
+			auto& panel = root.mValue->emplace_back<BenchmarkWidget>();
+			panel.setLeft(static_cast<float>(p % 10) * window_width / 10.0f);
+			panel.setTop(static_cast<float>(p / 10) * window_height / 10.0f);
+			panel.setWidth(window_width / 10.0f);
+			panel.setHeight(window_height / 10.0f);
+
+			for (int b = 0; b < 99; b++)
+			{
+				auto& button = panel.emplace_back<BenchmarkWidget>();
+				button.setLeft(static_cast<float>(b % 11) * 17.0f);
+				button.setTop(static_cast<float>(b / 11) * 12.0f);
+				button.setWidth(16.0f);
+				button.setHeight(10.0f);
+			}
+		}
+
+		// A scrollview containing 5000 rows, scrolled somewhere in the middle
+
+		auto& scroll_view = root.mValue->emplace_back<BenchmarkWidget>();
+		scroll_view.isViewport = true;
+		scroll_view.setLeft(700.0f);
+		scroll_view.setTop(200.0f);
+		scroll_view.setWidth(400.0f);
+		scroll_view.setHeight(600.0f);
+
+		auto& content = scroll_view.emplace_back<BenchmarkWidget>();
+		content.setWidth(400.0f);
+		content.setHeight(5000.0f * 20.0f);
+
+		for (int r = 0; r < 5000; r++)
+		{
+			auto& row = content.emplace_back<BenchmarkWidget>();
+			row.setTop(static_cast<float>(r) * 20.0f);
+			row.setWidth(400.0f);
+			row.setHeight(20.0f);
+		}
+
+		content.setTop(-50000.0f);
+
+		std::mt19937 generator(42);
+		std::uniform_int_distribution<int> distribution_x(0, static_cast<int>(window_width));
+		std::uniform_int_distribution<int> distribution_y(0, static_cast<int>(window_height));
+
+		// The UISystem does roughly 7 hit tests per frame (enter, exit, down, up,
+		// wheel, click, drag)
+		const int frames = 200;
+		const int queries_per_frame = 7;
+
+		std::vector<std::pair<int, int>> points;
+
+		for (int i = 0; i < frames * queries_per_frame; i++)
+			points.emplace_back(distribution_x(generator), distribution_y(generator));
+
+		std::cout << "Starting brute force hit test on " << frames << " frames" << std::endl;
+
+		corgi::time::Timer timer;
+		int found = 0;
+
+		timer.start();
+		for (auto [x, y] : points)
+			found += brute_force_find_deepest(x, y, root) != nullptr;
+		std::cout << "Brute force hit tests done in : " << timer.elapsed_time() * 1000.0f << " ms (" << found << " hits)" << std::endl;
+
+		std::cout << "Starting indexed hit test on " << frames << " frames" << std::endl;
+
+		ui::HitTestIndex index;
+		found = 0;
+		int mismatches = 0;
+
+		timer.start();
+		for (int f = 0; f < frames; f++)
+		{
+			index.build(*root.mValue);
+
+			for (int q = 0; q < queries_per_frame; q++)
+			{
+				auto [x, y] = points[f * queries_per_frame + q];
+				found += index.find_deepest(x, y) != nullptr;
+			}
+		}
+		std::cout << "Indexed hit tests (rebuilt every frame) done in : " << timer.elapsed_time() * 1000.0f << " ms (" << found << " hits, " << index.size() << " indexed widgets)" << std::endl;
+
+		timer.start();
+		for (auto [x, y] : points)
+			found += index.find_deepest(x, y) != nullptr;
+		std::cout << "Indexed hit tests (queries only) done in : " << timer.elapsed_time() * 1000.0f << " ms" << std::endl;
+
+		for (auto [x, y] : points)
+		{
+			if (index.find_deepest(x, y) != brute_force_find_deepest(x, y, root))
+				mismatches++;
+		}
+		std::cout << "Mismatches between brute force and index : " << mismatches << std::endl;
+	}
+}
@@ -0,0 +1,100 @@
+#include <corgi/test/test.h>
+#include <corgi/utils/AtlasPacker.h>
+
+#include <random>
+#include <vector>
+
+using namespace corgi;
+using namespace corgi::test;
+
+namespace
+{
+bool overlap(const MaxRects::Rect& a, const MaxRects::Rect& b)
+{
+    return a.x < b.x + b.width && b.x < a.x + a.width && a.y < b.y + b.height &&
+           b.y < a.y + a.height;
+}
+}    // namespace
+
+TEST(TestMaxRects, FillsTheBinExactly)
+{
+    MaxRects       bin(64, 64);
+    MaxRects::Rect rect;
+
+    for(int i = 0; i < 4; i++)
+        assert_that(bin.insert(32, 32, rect), equals(true));
+
+    assert_that(bin.used_area(), equals(std::size_t(64 * 64)));
+    assert_that(bin.used_width(), equals(64u));
+    assert_that(bin.used_height(), equals(64u));
+
+    // Nothing fits anymore
+    assert_that(bin.insert(1, 1, rect), equals(false));
+}
+
+TEST(TestMaxRects, RectTooLargeIsRejected)
+{
+    MaxRects bin(64, 32);
+
+    MaxRects::Rect rect {1u, 2u, 3u, 4u};
+
+    assert_that(bin.insert(65, 1, rect), equals(false));
+    assert_that(bin.insert(1, 33, rect), equals(false));
+
+    // The result is left untouched
+    assert_that(rect.x, equals(1u));
+    assert_that(rect.y, equals(2u));
+    assert_that(rect.width, equals(3u));
+    assert_that(rect.height, equals(4u));
+    assert_that(bin.used_area(), equals(std::size_t(0)));
+}
+
+TEST(TestMaxRects, PackedRectsDontOverlapAndStayInBounds)
+{
+    std::mt19937                            random(42);
+    std::uniform_int_distribution<unsigned> size(1u, 48u);
+
+    for(int pass = 0; pass < 8; pass++)
+    {
+        MaxRects bin(256, 192);
+
+        std::vector<MaxRects::Rect> placed;
+        std::size_t                 area     = 0;
+        int                         failures = 0;
+
+        // Until the bin is full enough to reject rects a few times in a row
+        while(failures < 16)
+        {
+            const auto width  = size(random);
+            const auto height = size(random);
+
+            MaxRects::Rect rect;
+
+            if(!bin.insert(width, height, rect))
+            {
+                failures++;
+                continue;
+            }
+
+            failures = 0;
+
+            assert_that(rect.width, equals(width));
+            assert_that(rect.height, equals(height));
+            assert_that(rect.x + rect.width <= bin.width(), equals(true));
+            assert_that(rect.y + rect.height <= bin.height(), equals(true));
+            assert_that(rect.x + rect.width <= bin.used_width(), equals(true));
+            assert_that(rect.y + rect.height <= bin.used_height(), equals(true));
+
+            for(const auto& other : placed)
+                assert_that(overlap(rect, other), equals(false));
+
+            placed.push_back(rect);
+            area += std::size_t(width) * height;
+        }
+
+        assert_that(bin.used_area(), equals(area));
+
+        // Best Short Side Fit leaves little space once the bin is full
+        assert_that(area * 2 > std::size_t(bin.width()) * bin.height(), equals(true));
+    }
+}
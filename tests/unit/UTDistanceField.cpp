@@ -0,0 +1,135 @@
+#include <corgi/test/test.h>
+#include <corgi/utils/DistanceField.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <random>
+#include <vector>
+
+using namespace corgi;
+using namespace corgi::test;
+
+namespace
+{
+// Compares every pixel to every other one, the way the field is defined
+distance_field::Bitmap brute_force(const std::vector<std::uint8_t>& coverage, unsigned width,
+                                   unsigned height, unsigned spread)
+{
+    distance_field::Bitmap field;
+    field.width  = width + 2u * spread;
+    field.height = height + 2u * spread;
+    field.pixels.resize(std::size_t(field.width) * field.height);
+
+    const auto inside = [&](int x, int y)
+    {
+        const int cx = x - static_cast<int>(spread);
+        const int cy = y - static_cast<int>(spread);
+
+        return cx >= 0 && cy >= 0 && cx < static_cast<int>(width) &&
+               cy < static_cast<int>(height) && coverage[std::size_t(cy) * width + cx] >= 128u;
+    };
+
+    for(int y = 0; y < static_cast<int>(field.height); y++)
+    {
+        for(int x = 0; x < static_cast<int>(field.width); x++)
+        {
+            const bool in      = inside(x, y);
+            double     nearest = -1.0;
+
+            for(int oy = 0; oy < static_cast<int>(field.height); oy++)
+            {
+                for(int ox = 0; ox < static_cast<int>(field.width); ox++)
+                {
+                    if(inside(ox, oy) == in)
+                        continue;
+
+                    const double squared = double(ox - x) * (ox - x) + double(oy - y) * (oy - y);
+
+                    if(nearest < 0.0 || squared < nearest)
+                        nearest = squared;
+                }
+            }
+
+            // Nothing on the other side, the pixel is as far as it gets
+            double distance = in ? 1e9 : -1e9;
+
+            if(nearest >= 0.0)
+                distance = in ? std::sqrt(nearest) - 0.5 : 0.5 - std::sqrt(nearest);
+
+            const double value = 127.5 + distance * 127.5 / std::max(spread, 1u);
+
+            field.pixels[std::size_t(y) * field.width + x] =
+                static_cast<std::uint8_t>(std::lround(std::clamp(value, 0.0, 255.0)));
+        }
+    }
+    return field;
+}
+}    // namespace
+
+TEST(TestDistanceField, GrowsBySpread)
+{
+    const std::vector<std::uint8_t> coverage(6 * 4, 255u);
+
+    const auto field = distance_field::generate(coverage, 6, 4, 3);
+
+    assert_that(field.width, equals(12u));
+    assert_that(field.height, equals(10u));
+    assert_that(field.pixels.size(), equals(std::size_t(120)));
+
+    // The corners are further than the spread from the shape
+    assert_that(static_cast<int>(field.pixels[0]), equals(0));
+
+    // The outline runs between the margin and the shape
+    assert_that(static_cast<int>(field.pixels[5 * 12 + 2]), equals(106));
+    assert_that(static_cast<int>(field.pixels[5 * 12 + 3]), equals(149));
+}
+
+TEST(TestDistanceField, EmptyCoverage)
+{
+    const std::vector<std::uint8_t> coverage(5 * 5, 0u);
+
+    const auto field = distance_field::generate(coverage, 5, 5, 2);
+
+    assert_that(std::all_of(field.pixels.begin(), field.pixels.end(),
+                            [](auto pixel) { return pixel == 0u; }),
+                equals(true));
+}
+
+TEST(TestDistanceField, PartialCoverageMovesTheOutline)
+{
+    // A single pixel, a quarter, half and three quarters covered
+    for(std::uint8_t coverage : {64, 128, 192})
+    {
+        const auto field = distance_field::generate(std::vector<std::uint8_t> {coverage}, 1, 1, 4);
+
+        const auto expected = std::lround(127.5f + (coverage / 255.0f - 0.5f) * 127.5f / 4.0f);
+
+        assert_that(static_cast<long>(field.pixels[4 * 9 + 4]), equals(expected));
+    }
+}
+
+TEST(TestDistanceField, MatchesBruteForce)
+{
+    std::mt19937 random(1);
+
+    for(int pass = 0; pass < 100; pass++)
+    {
+        const unsigned width  = 1u + random() % 14u;
+        const unsigned height = 1u + random() % 14u;
+        const unsigned spread = random() % 5u;
+
+        std::vector<std::uint8_t> coverage(std::size_t(width) * height);
+
+        for(auto& pixel : coverage)
+            pixel = random() % 3u == 0u ? 255u : 0u;
+
+        const auto field    = distance_field::generate(coverage, width, height, spread);
+        const auto expected = brute_force(coverage, width, height, spread);
+
+        assert_that(field.width, equals(expected.width));
+        assert_that(field.height, equals(expected.height));
+
+        assert_that((field.pixels == expected.pixels), equals(true));
+    }
+}
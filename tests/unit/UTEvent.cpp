@@ -0,0 +1,230 @@
+#include <corgi/test/test.h>
+#include <corgi/utils/Delegate.h>
+#include <corgi/utils/Event.h>
+
+#include <array>
+#include <memory>
+#include <string>
+#include <vector>
+
+using namespace corgi;
+using namespace corgi::test;
+
+TEST(TestDelegate, InvokesStoredCallable)
+{
+    int                   value = 0;
+    Delegate<int(int)> delegate = [&value](int i) { return value += i; };
+
+    assert_that(static_cast<bool>(delegate), equals(true));
+    assert_that(delegate(2), equals(2));
+    assert_that(delegate(3), equals(5));
+}
+
+TEST(TestDelegate, SmallCallablesAreStoredInline)
+{
+    int* a = nullptr;
+    int* b = nullptr;
+
+    auto small = [a, b]() { return a == b; };
+    auto big   = [array = std::array<char, 256> {}]() { return array[0] == 0; };
+
+    assert_that(Delegate<bool()>::is_stored_inline<decltype(small)>, equals(true));
+    assert_that(Delegate<bool()>::is_stored_inline<decltype(big)>, equals(false));
+
+    // Both are invoked the same way
+    Delegate<bool()> delegate = big;
+    assert_that(delegate(), equals(true));
+}
+
+TEST(TestDelegate, CopyAndMove)
+{
+    auto counter = std::make_shared<int>(0);
+
+    Delegate<void()> delegate = [counter]() { (*counter)++; };
+    Delegate<void()> copy     = delegate;
+
+    copy();
+    delegate();
+    assert_that(*counter, equals(2));
+    assert_that(counter.use_count(), equals(3l));
+
+    Delegate<void()> moved = std::move(delegate);
+    assert_that(static_cast<bool>(delegate), equals(false));
+    moved();
+    assert_that(*counter, equals(3));
+
+    moved.reset();
+    copy.reset();
+    assert_that(counter.use_count(), equals(1l));
+}
+
+TEST(TestEvent, InvokesCallbacksInOrder)
+{
+    Event<int>       event;
+    std::vector<int> calls;
+
+    event += [&](int i) { calls.push_back(i); };
+    event += [&](int i) { calls.push_back(i * 10); };
+
+    event(2);
+
+    assert_that((calls == std::vector<int> {2, 20}), equals(true));
+    assert_that(event.size(), equals(std::size_t(2)));
+}
+
+TEST(TestEvent, EmptyEventDoesNothing)
+{
+    Event<int> event;
+
+    assert_that(event.empty(), equals(true));
+    event(1);
+    event -= EventHandle {};
+    assert_that(event.size(), equals(std::size_t(0)));
+}
+
+TEST(TestEvent, UnsubscribeKeepsOrder)
+{
+    Event<>          event;
+    std::vector<int> calls;
+
+    event += [&]() { calls.push_back(1); };
+    const auto second = event += [&]() { calls.push_back(2); };
+    event += [&]() { calls.push_back(3); };
+
+    event -= second;
+    event();
+
+    assert_that((calls == std::vector<int> {1, 3}), equals(true));
+    assert_that(event.size(), equals(std::size_t(2)));
+}
+
+TEST(TestEvent, StaleHandleDoesNothing)
+{
+    Event<>          event;
+    std::vector<int> calls;
+
+    const auto first = event += [&]() { calls.push_back(1); };
+    event -= first;
+
+    // Reuses the slot of the first callback, with another generation
+    const auto second = event += [&]() { calls.push_back(2); };
+
+    assert_that(second.index, equals(first.index));
+
+    event -= first;
+    event();
+
+    assert_that((calls == std::vector<int> {2}), equals(true));
+}
+
+TEST(TestEvent, SubscribeDuringDispatchIsDeferred)
+{
+    Event<>          event;
+    std::vector<int> calls;
+
+    event += [&]()
+    {
+        calls.push_back(1);
+
+        if(calls.size() == 1)
+            event += [&]() { calls.push_back(2); };
+    };
+
+    event();
+    assert_that((calls == std::vector<int> {1}), equals(true));
+
+    event();
+    assert_that((calls == std::vector<int> {1, 1, 2}), equals(true));
+}
+
+TEST(TestEvent, UnsubscribeDuringDispatch)
+{
+    Event<>          event;
+    std::vector<int> calls;
+    EventHandle      second;
+
+    // The first callback removes the second one, which isn't called anymore
+    event += [&]()
+    {
+        calls.push_back(1);
+        event -= second;
+    };
+    second = event += [&]() { calls.push_back(2); };
+    event += [&]() { calls.push_back(3); };
+
+    event();
+    event();
+
+    assert_that((calls == std::vector<int> {1, 3, 1, 3}), equals(true));
+    assert_that(event.size(), equals(std::size_t(2)));
+}
+
+TEST(TestEvent, ClearDuringDispatch)
+{
+    Event<>          event;
+    std::vector<int> calls;
+
+    event += [&]()
+    {
+        calls.push_back(1);
+        event.clear();
+    };
+    event += [&]() { calls.push_back(2); };
+
+    event();
+    event();
+
+    assert_that((calls == std::vector<int> {1}), equals(true));
+    assert_that(event.empty(), equals(true));
+}
+
+TEST(TestEvent, ArgumentsAreCopiedForEveryCallback)
+{
+    Event<std::string>       event;
+    std::vector<std::string> received;
+
+    // A callback moving its argument doesn't empty the next one's
+    event += [&](std::string s) { received.push_back(std::move(s)); };
+    event += [&](std::string s) { received.push_back(std::move(s)); };
+
+    event(std::string("corgi"));
+
+    assert_that((received == std::vector<std::string> {"corgi", "corgi"}), equals(true));
+}
+
+TEST(TestEvent, CopyKeepsCallbacks)
+{
+    Event<>          event;
+    std::vector<int> calls;
+
+    event += [&]() { calls.push_back(1); };
+
+    Event<> copy = event;
+    copy();
+    event();
+
+    assert_that((calls == std::vector<int> {1, 1}), equals(true));
+}
+
+TEST(TestEventQueue, DispatchesInOrder)
+{
+    EventQueue<int, int> queue;
+    EventQueue<int, int> worker;
+
+    queue.push(1, 2);
+    worker.push(3, 4);
+    queue.append(worker);
+
+    assert_that(worker.empty(), equals(true));
+    assert_that(queue.size(), equals(std::size_t(2)));
+
+    Event<int, int>  event;
+    std::vector<int> calls;
+
+    event += [&](int a, int b) { calls.push_back(a + b); };
+
+    queue.dispatch(event);
+
+    assert_that((calls == std::vector<int> {3, 7}), equals(true));
+    assert_that(queue.empty(), equals(true));
+}
@@ -0,0 +1,176 @@
+#include <corgi/filesystem/PackFile.h>
+#include <corgi/test/test.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+
+using namespace corgi;
+using namespace corgi::filesystem;
+using namespace corgi::test;
+
+namespace
+{
+const std::string path =
+    (std::filesystem::temp_directory_path() / "corgi_unit_pack.cpak").string();
+
+std::vector<std::byte> bytes(std::string_view str)
+{
+    const auto span = std::as_bytes(std::span(str.data(), str.size()));
+    return {span.begin(), span.end()};
+}
+
+std::vector<PackFile::File> make_files()
+{
+    return {{"textures/grass.tex", bytes("grass")},
+            {"sounds/jump.wav", bytes("a jump that takes more than 16 bytes")},
+            {"empty.txt", {}},
+            {"levels/first.json", bytes("{}")}};
+}
+
+std::vector<char> read_file()
+{
+    std::ifstream file(path, std::ifstream::binary);
+    return {std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>()};
+}
+
+void write_file(const std::vector<char>& content)
+{
+    std::ofstream file(path, std::ofstream::binary | std::ofstream::trunc);
+    file.write(content.data(), static_cast<std::streamsize>(content.size()));
+}
+
+// The entries directly follow the header
+PackFile::Entry read_entry(const std::vector<char>& content, std::size_t index)
+{
+    PackFile::Entry entry;
+    std::memcpy(&entry, content.data() + sizeof(PackFile::Header) + index * sizeof entry,
+                sizeof entry);
+    return entry;
+}
+
+void write_entry(std::vector<char>& content, std::size_t index, const PackFile::Entry& entry)
+{
+    std::memcpy(content.data() + sizeof(PackFile::Header) + index * sizeof entry, &entry,
+                sizeof entry);
+}
+
+std::string_view text(std::span<const std::byte> content)
+{
+    return {reinterpret_cast<const char*>(content.data()), content.size()};
+}
+}    // namespace
+
+TEST(TestPackFile, WriteAndOpen)
+{
+    const auto files = make_files();
+
+    assert_that(PackFile::write(path, files), equals(true));
+
+    {
+        PackFile pack(path);
+
+        assert_that(pack.is_open(), equals(true));
+        assert_that(pack.entries().size(), equals(files.size()));
+
+        for(const auto& [file_path, content] : files)
+        {
+            const auto* entry = pack.find(file_path);
+
+            assert_that(entry != nullptr, equals(true));
+            assert_that(pack.path(*entry), equals(std::string_view(file_path)));
+            assert_that(entry->offset % PackFile::alignment, equals(std::uint64_t(0)));
+            assert_that(entry->size, equals(std::uint64_t(content.size())));
+            assert_that((std::vector<std::byte>(pack.content(*entry).begin(),
+                                                pack.content(*entry).end()) == content),
+                        equals(true));
+            assert_that(pack.verify(*entry), equals(true));
+        }
+
+        assert_that(pack.find("missing.txt") == nullptr, equals(true));
+    }
+
+    std::filesystem::remove(path);
+}
+
+TEST(TestPackFile, FindWithSharedHash)
+{
+    PackFile::write(path, make_files());
+
+    // Gives every path the same hash, the way two colliding paths would
+    auto content = read_file();
+
+    for(std::size_t i = 0; i < make_files().size(); i++)
+    {
+        auto entry      = read_entry(content, i);
+        entry.path_hash = 42u;
+        write_entry(content, i, entry);
+    }
+    write_file(content);
+
+    {
+        PackFile pack(path);
+
+        assert_that(pack.is_open(), equals(true));
+
+        const auto* entry = pack.find("sounds/jump.wav", 42u);
+
+        assert_that(entry != nullptr, equals(true));
+        assert_that(pack.path(*entry), equals(std::string_view("sounds/jump.wav")));
+        assert_that(text(pack.content(*entry)),
+                    equals(std::string_view("a jump that takes more than 16 bytes")));
+
+        // Same hash, but no such path
+        assert_that(pack.find("sounds/land.wav", 42u) == nullptr, equals(true));
+        assert_that(pack.find("sounds/jump.wav") == nullptr, equals(true));
+    }
+
+    std::filesystem::remove(path);
+}
+
+TEST(TestPackFile, TruncatedPackIsRejected)
+{
+    PackFile::write(path, make_files());
+
+    const auto original = read_file();
+
+    // Cuts the last file short
+    auto content = original;
+    content.resize(content.size() - 1);
+    write_file(content);
+    assert_that(PackFile(path).is_open(), equals(false));
+
+    // Cuts inside the manifest
+    content.resize(sizeof(PackFile::Header) + sizeof(PackFile::Entry));
+    write_file(content);
+    assert_that(PackFile(path).is_open(), equals(false));
+
+    // An offset and size whose sum wraps around to a small value
+    content     = original;
+    auto entry  = read_entry(content, 0);
+    entry.size  = ~std::uint64_t(0) - entry.offset + 2u;
+    write_entry(content, 0, entry);
+    write_file(content);
+    assert_that(PackFile(path).is_open(), equals(false));
+
+    // An offset past the end of the pack
+    content      = original;
+    entry        = read_entry(content, 0);
+    entry.offset = original.size() + 1u;
+    entry.size   = 0u;
+    write_entry(content, 0, entry);
+    write_file(content);
+    assert_that(PackFile(path).is_open(), equals(false));
+
+    write_file(original);
+    assert_that(PackFile(path).is_open(), equals(true));
+
+    std::filesystem::remove(path);
+}
@@ -0,0 +1,119 @@
+#include <corgi/test/test.h>
+#include <corgi/utils/StagingPool.h>
+
+#include <cstddef>
+#include <cstring>
+
+using namespace corgi;
+using namespace corgi::test;
+
+TEST(TestStagingPool, ReleasedBuffersAreReused)
+{
+    StagingPool pool;
+
+    auto* first = pool.allocate(1000);
+    pool.release(first);
+
+    // Capacities are rounded up to a power of two, 1024 here
+    assert_that(pool.retained_bytes(), equals(std::size_t(1024)));
+
+    auto* second = pool.allocate(1024);
+
+    assert_that(second == first, equals(true));
+    assert_that(pool.system_allocations(), equals(std::size_t(1)));
+    assert_that(pool.retained_bytes(), equals(std::size_t(0)));
+
+    // Too large for the released buffer
+    pool.release(second);
+    auto* third = pool.allocate(1025);
+
+    assert_that(pool.system_allocations(), equals(std::size_t(2)));
+    assert_that(pool.retained_bytes(), equals(std::size_t(1024)));
+
+    pool.release(third);
+}
+
+TEST(TestStagingPool, SmallestFittingBufferIsUsed)
+{
+    StagingPool pool;
+
+    auto* small  = pool.allocate(300);
+    auto* medium = pool.allocate(5000);
+    auto* large  = pool.allocate(100000);
+
+    pool.release(large);
+    pool.release(small);
+    pool.release(medium);
+
+    assert_that(pool.allocate(4000) == medium, equals(true));
+    assert_that(pool.allocate(1) == small, equals(true));
+    assert_that(pool.allocate(70000) == large, equals(true));
+    assert_that(pool.system_allocations(), equals(std::size_t(3)));
+}
+
+TEST(TestStagingPool, RetainedBytesAreCapped)
+{
+    StagingPool pool(4096);
+
+    auto* first  = pool.allocate(4096);
+    auto* second = pool.allocate(256);
+
+    pool.release(first);
+    assert_that(pool.retained_bytes(), equals(std::size_t(4096)));
+
+    // Keeping it would exceed the cap, so it's freed
+    pool.release(second);
+    assert_that(pool.retained_bytes(), equals(std::size_t(4096)));
+
+    assert_that(pool.allocate(256) == first, equals(true));
+    assert_that(pool.system_allocations(), equals(std::size_t(2)));
+}
+
+TEST(TestStagingPool, Reallocate)
+{
+    StagingPool pool;
+
+    auto* data = pool.reallocate(nullptr, 300);
+    std::memset(data, 7, 300);
+
+    // Still fits inside its 512 bytes
+    assert_that(pool.reallocate(data, 512) == data, equals(true));
+
+    auto* grown = pool.reallocate(data, 600);
+
+    assert_that(grown != data, equals(true));
+    assert_that(grown[0] == std::byte {7}, equals(true));
+    assert_that(grown[299] == std::byte {7}, equals(true));
+
+    // The old buffer went back to the pool
+    assert_that(pool.retained_bytes(), equals(std::size_t(512)));
+
+    pool.release(grown);
+}
+
+TEST(TestStagingPool, TrimFreesRetainedBuffers)
+{
+    StagingPool pool;
+
+    auto* used     = pool.allocate(2048);
+    auto* released = pool.allocate(2048);
+
+    pool.release(released);
+    pool.trim();
+
+    assert_that(pool.retained_bytes(), equals(std::size_t(0)));
+
+    // Buffers still used aren't touched
+    used[2047] = std::byte {1};
+    pool.release(used);
+    assert_that(pool.retained_bytes(), equals(std::size_t(2048)));
+
+    static_cast<void>(pool.allocate(2048));
+    assert_that(pool.system_allocations(), equals(std::size_t(2)));
+
+    // Releasing nullptr or a buffer from elsewhere does nothing
+    std::byte outside[4];
+    pool.release(nullptr);
+    pool.release(outside);
+    assert_that(pool.retained_bytes(), equals(std::size_t(0)));
+}
@@ -0,0 +1,181 @@
+#include <corgi/test/test.h>
+#include <corgi/ui/TextBuffer.h>
+#include <corgi/ui/TextLayout.h>
+
+#include <random>
+#include <string>
+#include <string_view>
+#include <vector>
+
+using namespace corgi;
+using namespace corgi::test;
+using namespace corgi::ui;
+
+namespace
+{
+// Stands for HarfBuzz : one glyph per character, except "fi" which becomes a
+// single ligature, so a glyph can display more than one character
+std::vector<utils::text::ShapedGlyph> shaper(std::string_view line, int textOffset)
+{
+    std::vector<utils::text::ShapedGlyph> glyphs;
+
+    for(std::size_t i = 0; i < line.size(); i++)
+    {
+        utils::text::ShapedGlyph glyph {};
+        glyph.advance.x  = 5.0 + (line[i] & 3);
+        glyph.codepoint  = line[i];
+        glyph.cluster    = static_cast<unsigned>(i);
+        glyph.characters = {line[i]};
+        glyph.textOffset = textOffset + static_cast<int>(i);
+
+        if(line[i] == 'f' && i + 1 < line.size() && line[i + 1] == 'i')
+        {
+            glyph.codepoint  = 0xFB01;
+            glyph.characters = {'f', 'i'};
+            i++;
+        }
+        glyphs.push_back(std::move(glyph));
+    }
+    return glyphs;
+}
+
+bool same_glyphs(const TextLayout& a, const TextLayout& b)
+{
+    if(a.glyphs().size() != b.glyphs().size() || a.lineCount() != b.lineCount())
+        return false;
+
+    for(std::size_t i = 0; i < a.glyphs().size(); i++)
+    {
+        const auto& first  = a.glyphs()[i];
+        const auto& second = b.glyphs()[i];
+
+        if(first.codepoint != second.codepoint || first.cluster != second.cluster ||
+           first.characters != second.characters || first.textOffset != second.textOffset ||
+           first.advance.x != second.advance.x)
+            return false;
+    }
+
+    for(int line = 0; line < a.lineCount(); line++)
+        if(a.lineFirstGlyph(line) != b.lineFirstGlyph(line) ||
+           a.lineEndGlyph(line) != b.lineEndGlyph(line))
+            return false;
+
+    return true;
+}
+}    // namespace
+
+TEST(TestTextBuffer, InsertAndErase)
+{
+    TextBuffer buffer("hello world");
+
+    buffer.insert(5, ",");
+    assert_that(buffer.str(), equals(std::string("hello, world")));
+
+    // Moves the gap back and forth
+    buffer.insert(0, ">");
+    buffer.insert(buffer.size(), "!");
+    buffer.erase(1, 7);
+    assert_that(buffer.str(), equals(std::string(">world!")));
+    assert_that(buffer.size(), equals(std::size_t(7)));
+    assert_that(buffer[1], equals('w'));
+    assert_that(buffer.substr(1, 3), equals(std::string("wor")));
+    assert_that(buffer.equals(">world!"), equals(true));
+    assert_that(buffer.equals(">world"), equals(false));
+
+    buffer.erase(0, buffer.size());
+    assert_that(buffer.empty(), equals(true));
+    assert_that(buffer.lineCount(), equals(std::size_t(1)));
+}
+
+TEST(TestTextBuffer, LineStarts)
+{
+    TextBuffer buffer("first\nsecond\n\nlast");
+
+    assert_that(buffer.lineCount(), equals(std::size_t(4)));
+    assert_that(buffer.line(1), equals(std::string("second")));
+    assert_that(buffer.line(2), equals(std::string("")));
+    assert_that(buffer.lineStart(3), equals(std::size_t(14)));
+    assert_that(buffer.lineEnd(3), equals(buffer.size()));
+
+    // The '\n' belongs to the line it ends
+    assert_that(buffer.lineOf(5), equals(std::size_t(0)));
+    assert_that(buffer.lineOf(6), equals(std::size_t(1)));
+
+    buffer.insert(3, "\n");
+    buffer.erase(13, 1);
+
+    assert_that(buffer.str(), equals(std::string("fir\nst\nsecond\nlast")));
+    assert_that(buffer.lineCount(), equals(std::size_t(4)));
+    assert_that(buffer.line(1), equals(std::string("st")));
+    assert_that(buffer.lineStart(3), equals(std::size_t(14)));
+}
+
+TEST(TestTextLayout, NewLineGlyphs)
+{
+    TextLayout layout(shaper);
+    layout.setText("ab\nfit");
+
+    // a, b, '\n', fi, t
+    assert_that(layout.glyphs().size(), equals(std::size_t(5)));
+    assert_that(layout.lineCount(), equals(2));
+    assert_that(layout.glyphs()[2].codepoint, equals(0));
+    assert_that(layout.lineEndGlyph(0), equals(2));
+    assert_that(layout.lineFirstGlyph(1), equals(3));
+    assert_that(layout.lineEndGlyph(1), equals(5));
+    assert_that(layout.glyphs()[4].textOffset, equals(5));
+
+    assert_that(layout.lineOfGlyph(2), equals(0));
+    assert_that(layout.lineOfGlyph(3), equals(1));
+    assert_that(layout.lineOfGlyph(5), equals(1));
+}
+
+TEST(TestTextLayout, ReplaceOnlyShapesEditedLines)
+{
+    TextLayout layout(shaper);
+    layout.setText("first line\nsecond line\nthird line");
+
+    layout.replace(13, 0, "xx");
+    assert_that(layout.shapedCharacters(), equals(std::size_t(13)));
+
+    // Merges the first two lines
+    layout.replace(10, 1, "");
+    assert_that(layout.shapedCharacters(), equals(std::size_t(23)));
+    assert_that(layout.lineCount(), equals(2));
+    assert_that(layout.buffer().str(), equals(std::string("first linesexxcond line\nthird line")));
+}
+
+TEST(TestTextLayout, ReplaceMatchesSetText)
+{
+    std::mt19937                       random(7);
+    std::uniform_int_distribution<int> action(0, 9);
+
+    const std::string_view alphabet = "abfi \n";
+
+    TextLayout  incremental(shaper);
+    TextLayout  full(shaper);
+    std::string text = "fi\nfirst\n\nfinal line";
+
+    incremental.setText(text);
+
+    for(int edit = 0; edit < 2000; edit++)
+    {
+        const auto offset = std::uniform_int_distribution<std::size_t>(0, text.size())(random);
+        const auto removed =
+            action(random) < 4
+                ? std::uniform_int_distribution<std::size_t>(0, text.size() - offset)(random) % 4
+                : std::size_t(0);
+
+        std::string inserted;
+
+        for(int i = action(random) % 4; i > 0; i--)
+            inserted += alphabet[std::uniform_int_distribution<std::size_t>(
+                0, alphabet.size() - 1)(random)];
+
+        text.replace(offset, removed, inserted);
+        incremental.replace(offset, removed, inserted);
+        full.setText(text);
+
+        assert_that(incremental.buffer().equals(text), equals(true));
+        assert_that(same_glyphs(incremental, full), equals(true));
+    }
+}
@@ -0,0 +1,98 @@
+#include <corgi/rendering/DrawList.h>
+#include <corgi/test/test.h>
+
+#include <vector>
+
+using namespace corgi;
+using namespace corgi::test;
+
+using Range = std::pair<std::size_t, std::size_t>;
+
+TEST(TestTextMesh, QuadIndexes)
+{
+    std::vector<unsigned> indexes;
+
+    DrawList::Text::append_quad_indexes(indexes, 2);
+
+    assert_that((indexes == std::vector<unsigned> {0, 1, 2, 0, 2, 3, 4, 5, 6, 4, 6, 7}),
+                equals(true));
+
+    // Only the missing quads are appended
+    DrawList::Text::append_quad_indexes(indexes, 3);
+
+    assert_that(indexes.size(), equals(std::size_t(18)));
+    assert_that((std::vector<unsigned>(indexes.begin() + 12, indexes.end()) ==
+                 std::vector<unsigned> {8, 9, 10, 8, 10, 11}),
+                equals(true));
+
+    DrawList::Text::append_quad_indexes(indexes, 1);
+    assert_that(indexes.size(), equals(std::size_t(18)));
+}
+
+TEST(TestTextMesh, ChangedRange)
+{
+    const std::vector<float> text {1.0f, 2.0f, 3.0f, 4.0f, 5.0f};
+
+    assert_that((DrawList::Text::changed_range(text, text) == Range {5, 0}), equals(true));
+
+    // Only the floats between the first and the last difference
+    assert_that((DrawList::Text::changed_range(text, {1.0f, 9.0f, 3.0f, 9.0f, 5.0f}) ==
+                 Range {1, 3}),
+                equals(true));
+
+    // When the size changes, everything after the first difference moved
+    assert_that((DrawList::Text::changed_range(text, {1.0f, 2.0f, 3.0f, 4.0f, 5.0f, 6.0f}) ==
+                 Range {5, 1}),
+                equals(true));
+    assert_that((DrawList::Text::changed_range(text, {1.0f, 4.0f, 5.0f}) == Range {1, 2}),
+                equals(true));
+    assert_that((DrawList::Text::changed_range(text, {}) == Range {0, 0}), equals(true));
+    assert_that((DrawList::Text::changed_range({}, text) == Range {0, 5}), equals(true));
+}
+
+TEST(TestTextMesh, CopyingTheChangedRangeUpdatesTheMesh)
+{
+    std::vector<float> before {0.0f, 1.0f, 2.0f, 3.0f, 4.0f, 5.0f, 6.0f, 7.0f};
+
+    const std::vector<std::vector<float>> texts {{0.0f, 1.0f, 9.0f, 3.0f, 4.0f, 5.0f, 6.0f, 7.0f},
+                                                 {0.0f, 1.0f, 9.0f},
+                                                 {0.0f, 1.0f, 9.0f, 8.0f, 8.0f},
+                                                 {5.0f},
+                                                 {}};
+
+    // The way DrawList::Text::upload_changed_quads applies it
+    for(const auto& after : texts)
+    {
+        const auto [first, count] = DrawList::Text::changed_range(before, after);
+
+        before.resize(after.size());
+        std::copy(after.begin() + static_cast<std::ptrdiff_t>(first),
+                  after.begin() + static_cast<std::ptrdiff_t>(first + count),
+                  before.begin() + static_cast<std::ptrdiff_t>(first));
+
+        assert_that((before == after), equals(true));
+    }
+}
+
+TEST(TestTextMesh, CapacityGrowth)
+{
+    // Small texts get room for 16 glyphs
+    assert_that(DrawList::Text::grown_quad_capacity(0), equals(std::size_t(16)));
+    assert_that(DrawList::Text::grown_quad_capacity(3), equals(std::size_t(16)));
+
+    // A counter gaining a glyph at a time reallocates a logarithmic number
+    // of times
+    std::size_t capacity      = 0;
+    int         reallocations = 0;
+
+    for(std::size_t quads = 1; quads <= 1000; quads++)
+    {
+        if(quads > capacity)
+        {
+            capacity = DrawList::Text::grown_quad_capacity(quads);
+            reallocations++;
+        }
+        assert_that(capacity >= quads, equals(true));
+    }
+    assert_that(reallocations, equals(7));
+}
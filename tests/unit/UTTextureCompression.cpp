@@ -0,0 +1,224 @@
+#include <corgi/test/test.h>
+#include <corgi/utils/TextureCompression.h>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+
+using namespace corgi;
+using namespace corgi::test;
+using namespace corgi::texture_compression;
+
+namespace
+{
+// Smooth gradients, the kind of content block compression is made for
+Image make_gradient(unsigned width, unsigned height, bool with_alpha)
+{
+    Image image;
+    image.width  = width;
+    image.height = height;
+    image.pixels.resize(std::size_t(width) * height * 4);
+
+    for(unsigned y = 0; y < height; y++)
+    {
+        for(unsigned x = 0; x < width; x++)
+        {
+            auto* pixel = image.pixels.data() + (std::size_t(y) * width + x) * 4;
+
+            pixel[0] = static_cast<std::uint8_t>(x * 255 / (width - 1));
+            pixel[1] = static_cast<std::uint8_t>(y * 255 / (height - 1));
+            pixel[2] = static_cast<std::uint8_t>(128 + (x + y) % 32);
+            pixel[3] = with_alpha
+                           ? static_cast<std::uint8_t>((x + y) * 255 / (width + height - 2))
+                           : 255;
+        }
+    }
+    return image;
+}
+
+Image round_trip(Format format, const Image& image)
+{
+    return decode(format, encode(format, image), image.width, image.height);
+}
+
+int max_difference(const Image& a, const Image& b)
+{
+    int difference = 0;
+
+    for(std::size_t i = 0; i < a.pixels.size(); i++)
+        difference = std::max(difference, std::abs(a.pixels[i] - b.pixels[i]));
+    return difference;
+}
+}    // namespace
+
+TEST(TestTextureCompression, EncodedSize)
+{
+    assert_that(encoded_size(Format::RGBA8, 5, 3), equals(std::size_t(5 * 3 * 4)));
+
+    // Partial blocks take a whole block
+    assert_that(encoded_size(Format::BC1, 5, 3), equals(std::size_t(2 * 1 * 8)));
+    assert_that(encoded_size(Format::BC3, 8, 8), equals(std::size_t(2 * 2 * 16)));
+    assert_that(encoded_size(Format::BC7, 1, 1), equals(std::size_t(16)));
+
+    const auto image = make_gradient(12, 8, true);
+
+    for(auto format : {Format::RGBA8, Format::BC1, Format::BC3, Format::BC7})
+        assert_that(encode(format, image).size(), equals(encoded_size(format, 12, 8)));
+}
+
+TEST(TestTextureCompression, RGBA8IsLossless)
+{
+    const auto image   = make_gradient(7, 5, true);
+    const auto decoded = round_trip(Format::RGBA8, image);
+
+    assert_that((decoded.pixels == image.pixels), equals(true));
+}
+
+TEST(TestTextureCompression, SolidColors)
+{
+    Image image;
+    image.width  = 8;
+    image.height = 8;
+
+    // Stored exactly by 565 colors
+    for(std::size_t i = 0; i < 64; i++)
+        image.pixels.insert(image.pixels.end(), {255, 0, 255, 255});
+
+    assert_that(max_difference(image, round_trip(Format::BC1, image)), equals(0));
+    assert_that(max_difference(image, round_trip(Format::BC3, image)), equals(0));
+
+    // The endpoints of BC7's mode 6 share their lowest bit between channels,
+    // so 0 and 255 can't both be exact
+    assert_that(max_difference(image, round_trip(Format::BC7, image)), equals(1));
+}
+
+TEST(TestTextureCompression, GradientsKeepTheirQuality)
+{
+    const auto opaque      = make_gradient(32, 32, false);
+    const auto transparent = make_gradient(32, 32, true);
+
+    assert_that(psnr(opaque, round_trip(Format::BC1, opaque)) > 32.0, equals(true));
+    assert_that(psnr(transparent, round_trip(Format::BC3, transparent)) > 32.0, equals(true));
+    assert_that(psnr(transparent, round_trip(Format::BC7, transparent)) > 32.0, equals(true));
+}
+
+TEST(TestTextureCompression, BC1KeepsBinaryAlpha)
+{
+    auto image = make_gradient(8, 8, false);
+
+    // The left half is transparent
+    for(unsigned y = 0; y < 8; y++)
+        for(unsigned x = 0; x < 4; x++)
+            image.pixels[(y * 8 + x) * 4 + 3] = 0;
+
+    assert_that(choose_format(image) == Format::BC1, equals(true));
+
+    const auto decoded = round_trip(Format::BC1, image);
+
+    for(unsigned y = 0; y < 8; y++)
+        for(unsigned x = 0; x < 8; x++)
+            assert_that(static_cast<int>(decoded.pixels[(y * 8 + x) * 4 + 3]),
+                        equals(x < 4 ? 0 : 255));
+
+    // Partial transparency needs BC3
+    image.pixels[3] = 100;
+    assert_that(choose_format(image) == Format::BC3, equals(true));
+}
+
+TEST(TestTextureCompression, PartialBlocksAreDecoded)
+{
+    const auto image   = make_gradient(30, 18, false);
+    const auto decoded = round_trip(Format::BC7, image);
+
+    assert_that(decoded.width, equals(30u));
+    assert_that(decoded.height, equals(18u));
+    assert_that(decoded.pixels.size(), equals(image.pixels.size()));
+    assert_that(psnr(image, decoded) > 30.0, equals(true));
+}
+
+TEST(TestTextureCompression, MipChain)
+{
+    const auto levels = generate_mips(make_gradient(8, 2, true), false);
+
+    // 8x2, 4x1, 2x1, 1x1
+    assert_that(levels.size(), equals(std::size_t(4)));
+    assert_that(levels[1].width, equals(4u));
+    assert_that(levels[1].height, equals(1u));
+    assert_that(levels[3].width, equals(1u));
+    assert_that(levels[3].height, equals(1u));
+    assert_that(levels[3].pixels.size(), equals(std::size_t(4)));
+}
+
+TEST(TestTextureCompression, ContainerRoundTrip)
+{
+    const auto levels  = generate_mips(make_gradient(16, 8, true), false);
+    const auto content = Container::write(Format::BC3, levels);
+
+    assert_that(Container::is_container(content), equals(true));
+
+    Container container;
+    assert_that(container.parse(content), equals(true));
+
+    assert_that(container.format() == Format::BC3, equals(true));
+    assert_that(container.width(), equals(16u));
+    assert_that(container.height(), equals(8u));
+    assert_that(container.levels().size(), equals(levels.size()));
+
+    std::size_t size = 0;
+
+    for(std::size_t i = 0; i < levels.size(); i++)
+    {
+        const auto& level = container.levels()[i];
+
+        assert_that(level.width, equals(levels[i].width));
+        assert_that(level.height, equals(levels[i].height));
+
+        // Levels are aligned inside the container
+        assert_that((level.data.data() - content.data()) % Container::alignment,
+                    equals(std::ptrdiff_t(0)));
+
+        const auto encoded = encode(Format::BC3, levels[i]);
+
+        assert_that(level.data.size(), equals(encoded.size()));
+        assert_that(std::memcmp(level.data.data(), encoded.data(), encoded.size()), equals(0));
+
+        size += encoded.size();
+    }
+    assert_that(container.size(), equals(size));
+}
+
+TEST(TestTextureCompression, InvalidContainers)
+{
+    const auto content =
+        Container::write(Format::BC1, generate_mips(make_gradient(8, 8, false), false));
+
+    Container container;
+
+    assert_that(container.parse(content), equals(true));
+
+    // Truncated inside the last level
+    const auto& last = container.levels().back();
+    const auto  end =
+        static_cast<std::size_t>(last.data.data() + last.data.size() - content.data());
+
+    assert_that(container.parse(std::span(content).first(end - 1)), equals(false));
+    assert_that(container.levels().empty(), equals(true));
+
+    // Truncated inside the entries
+    assert_that(container.parse(std::span(content).first(sizeof(Container::Header) + 4)),
+                equals(false));
+
+    // Unknown format
+    auto                corrupted = content;
+    const std::uint32_t format    = 42;
+    std::memcpy(corrupted.data() + offsetof(Container::Header, format), &format, sizeof format);
+    assert_that(container.parse(corrupted), equals(false));
+
+    // Raw .img files aren't containers
+    std::vector<std::byte> image(3 * sizeof(int) + 4, std::byte {1});
+    assert_that(Container::is_container(image), equals(false));
+    assert_that(container.parse(image), equals(false));
+}
@@ -0,0 +1,177 @@
+#include <corgi/resources/Tilemap.h>
+#include <corgi/test/test.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <limits>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+using namespace corgi;
+using namespace corgi::test;
+
+namespace
+{
+const std::string path =
+    (std::filesystem::temp_directory_path() / "corgi_unit_tilemap.bin").string();
+
+// A 7x5 layer, whose size is easy to find back inside the file
+Tilemap make_tilemap()
+{
+    Tilemap tilemap;
+    tilemap.width       = 7;
+    tilemap.height      = 5;
+    tilemap.tile_width  = 16;
+    tilemap.tile_height = 16;
+    tilemap.orientation = "orthogonal";
+
+    Tilemap::TilesetInfo tileset_info;
+    tileset_info.firstgid   = 1;
+    tileset_info.tile_count = 64;
+    tileset_info.columns    = 8;
+    tileset_info.name       = "tileset";
+    tileset_info.image      = "tileset.tex";
+    tilemap.tileset_infos.push_back(tileset_info);
+
+    Tilemap::TileLayer layer;
+    layer.name   = "ground";
+    layer.width  = 7.0f;
+    layer.height = 5.0f;
+    layer.properties.emplace_back("solid", true);
+
+    std::vector<std::uint32_t> tiles(7 * 5);
+
+    for(std::size_t i = 0; i < tiles.size(); i++)
+        tiles[i] = static_cast<std::uint32_t>(i % 64 + 1);
+
+    layer.data = Tilemap::TileData(std::move(tiles));
+    tilemap.tile_layers.push_back(std::move(layer));
+
+    return tilemap;
+}
+
+std::vector<char> read_file()
+{
+    std::ifstream file(path, std::ifstream::binary);
+    return {std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>()};
+}
+
+void write_file(const std::vector<char>& content)
+{
+    std::ofstream file(path, std::ofstream::binary | std::ofstream::trunc);
+    file.write(content.data(), static_cast<std::streamsize>(content.size()));
+}
+
+// Offset of the width and height of the layer record
+std::size_t layer_size_offset(const std::vector<char>& content)
+{
+    const float size[2] = {7.0f, 5.0f};
+
+    const auto* bytes = reinterpret_cast<const char*>(size);
+    const auto  it    = std::search(content.begin(), content.end(), bytes, bytes + sizeof size);
+
+    return static_cast<std::size_t>(it - content.begin());
+}
+
+bool loads()
+{
+    try
+    {
+        Tilemap tilemap(path, "unit_tilemap");
+        return true;
+    }
+    catch(const std::invalid_argument&)
+    {
+        return false;
+    }
+}
+
+void set_layer_width(std::size_t offset, float width)
+{
+    auto content = read_file();
+    std::memcpy(content.data() + offset, &width, sizeof width);
+    write_file(content);
+}
+}    // namespace
+
+TEST(TestTilemap, BinaryRoundTrip)
+{
+    const auto original = make_tilemap();
+    original.save(path);
+
+    {
+        Tilemap tilemap(path, "unit_tilemap");
+
+        assert_that(tilemap.width, equals(7));
+        assert_that(tilemap.height, equals(5));
+        assert_that(tilemap.orientation, equals(std::string("orthogonal")));
+        assert_that(tilemap.tileset_infos.size(), equals(std::size_t(1)));
+        assert_that(tilemap.tileset_infos[0].image, equals(std::string("tileset.tex")));
+        assert_that(tilemap.tile_layers.size(), equals(std::size_t(1)));
+
+        const auto& layer = tilemap.tile_layers[0];
+
+        assert_that(layer.name, equals(std::string("ground")));
+        assert_that(layer.width, equals(7.0f));
+        assert_that(layer.height, equals(5.0f));
+        assert_that(layer.properties.size(), equals(std::size_t(1)));
+        assert_that(layer.properties[0].bool_value, equals(true));
+
+        // The ids are read from the mapped file
+        assert_that(layer.data.is_mapped(), equals(true));
+        assert_that(std::equal(layer.data.begin(), layer.data.end(),
+                               original.tile_layers[0].data.begin(),
+                               original.tile_layers[0].data.end()),
+                    equals(true));
+    }
+
+    std::filesystem::remove(path);
+}
+
+TEST(TestTilemap, LayerSizeMustMatchItsTiles)
+{
+    make_tilemap().save(path);
+
+    const auto offset = layer_size_offset(read_file());
+    assert_that(offset < read_file().size(), equals(true));
+
+    // More tiles than the layer holds
+    set_layer_width(offset, 8.0f);
+    assert_that(loads(), equals(false));
+
+    for(float width : {-7.0f, 6.5f, std::numeric_limits<float>::quiet_NaN(),
+                       std::numeric_limits<float>::infinity()})
+    {
+        set_layer_width(offset, width);
+        assert_that(loads(), equals(false));
+    }
+
+    set_layer_width(offset, 7.0f);
+    assert_that(loads(), equals(true));
+
+    std::filesystem::remove(path);
+}
+
+TEST(TestTilemap, TruncatedFileIsRejected)
+{
+    make_tilemap().save(path);
+
+    auto content = read_file();
+
+    // Inside the layer records, the last section written
+    content.resize(content.size() - 4);
+    write_file(content);
+    assert_that(loads(), equals(false));
+
+    // Inside the header
+    content.resize(16);
+    write_file(content);
+    assert_that(loads(), equals(false));
+
+    std::filesystem::remove(path);
+}
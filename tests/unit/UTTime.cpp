@@ -0,0 +1,158 @@
+#include <corgi/test/test.h>
+#include <corgi/utils/TimeHelper.h>
+#include <corgi/utils/time/FrameLimiter.h>
+
+#include <chrono>
+#include <cmath>
+#include <thread>
+
+using namespace corgi;
+using namespace corgi::test;
+
+namespace
+{
+using Clock = std::chrono::steady_clock;
+
+float seconds_since(Clock::time_point start)
+{
+    return std::chrono::duration<float>(Clock::now() - start).count();
+}
+
+// Runs the fixed updates of a frame the way Game::run does
+int fixed_updates(Time& time)
+{
+    int steps = 0;
+
+    while(time.timestep_overrun())
+        steps++;
+
+    return steps;
+}
+}    // namespace
+
+TEST(TestTime, HitchRunsTheCappedNumberOfSteps)
+{
+    Time time;
+    time.timestep(0.01f);
+    time.max_catch_up_steps(3);
+    time.start();
+
+    // Worth 10 steps, way past the 3 allowed
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    time.update();
+
+    assert_that(fixed_updates(time), equals(3));
+
+    // Whole steps are dropped, the fraction of a step is kept
+    const auto dropped = time.dropped_time();
+    const auto kept    = time.alpha() * time.timestep();
+
+    assert_that(dropped >= time.elapsed_time() - 4.0f * time.timestep(), equals(true));
+    assert_that(std::abs(dropped / time.timestep() - std::round(dropped / time.timestep())) < 1e-3f,
+                equals(true));
+    assert_that(std::abs(time.elapsed_time() - (3.0f * time.timestep() + dropped + kept)) < 1e-4f,
+                equals(true));
+
+    // The next frame starts from the kept fraction, not from the hitch
+    time.update();
+    assert_that(fixed_updates(time) <= 1, equals(true));
+    assert_that(time.dropped_time(), equals(dropped));
+}
+
+TEST(TestTime, NoTimeIsDroppedBelowTheCap)
+{
+    Time time;
+    time.timestep(0.01f);
+    time.max_catch_up_steps(100);
+    time.start();
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(35));
+    time.update();
+
+    const auto steps = fixed_updates(time);
+
+    assert_that(steps >= 3, equals(true));
+    assert_that(time.dropped_time(), equals(0.0f));
+    assert_that(std::abs(time.elapsed_time() - (steps + time.alpha()) * time.timestep()) < 1e-4f,
+                equals(true));
+}
+
+TEST(TestTime, AlphaKeepsTheFractionOfAStep)
+{
+    Time time;
+    time.timestep(1.0f);
+    time.start();
+
+    assert_that(time.alpha(), equals(0.0f));
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    time.update();
+
+    // Not enough for a step, everything is left for the interpolation
+    assert_that(time.timestep_overrun(), equals(false));
+    assert_that(time.alpha(), equals(time.elapsed_time()));
+
+    for(int frame = 0; frame < 5; frame++)
+    {
+        std::this_thread::sleep_for(std::chrono::milliseconds(3));
+        time.update();
+        fixed_updates(time);
+
+        assert_that(time.alpha() >= 0.0f, equals(true));
+        assert_that(time.alpha() <= 1.0f, equals(true));
+    }
+}
+
+TEST(TestFrameLimiter, DisabledByDefault)
+{
+    time::FrameLimiter limiter;
+
+    assert_that(limiter.enabled(), equals(false));
+
+    const auto start = Clock::now();
+
+    for(int frame = 0; frame < 100; frame++)
+        limiter.wait();
+
+    assert_that(seconds_since(start) < 0.005f, equals(true));
+}
+
+TEST(TestFrameLimiter, FramesLastAtLeastTheTarget)
+{
+    time::FrameLimiter limiter;
+    limiter.target_frame_rate(100.0f);
+
+    assert_that(limiter.enabled(), equals(true));
+
+    // The first call only sets the deadline
+    limiter.wait();
+
+    const auto start = Clock::now();
+
+    for(int frame = 0; frame < 5; frame++)
+        limiter.wait();
+
+    const auto elapsed = seconds_since(start);
+
+    assert_that(elapsed >= 0.049f, equals(true));
+    assert_that(elapsed < 0.2f, equals(true));
+}
+
+TEST(TestFrameLimiter, LateFramesAreNotMadeUpFor)
+{
+    time::FrameLimiter limiter;
+    limiter.target_frame_rate(100.0f);
+    limiter.wait();
+
+    // More than a frame late
+    std::this_thread::sleep_for(std::chrono::milliseconds(40));
+
+    auto start = Clock::now();
+    limiter.wait();
+    assert_that(seconds_since(start) < 0.005f, equals(true));
+
+    // The next frame still gets its full duration
+    start = Clock::now();
+    limiter.wait();
+    assert_that(seconds_since(start) >= 0.009f, equals(true));
+}
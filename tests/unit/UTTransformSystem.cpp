@@ -0,0 +1,73 @@
+#include <corgi/components/Transform.h>
+#include <corgi/ecs/Entity.h>
+#include <corgi/ecs/Scene.h>
+#include <corgi/systems/TransformSystem.h>
+#include <corgi/test/test.h>
+
+#include <algorithm>
+
+using namespace corgi;
+using namespace corgi::test;
+
+namespace
+{
+// Matrix::operator== is declared but not defined
+bool same_matrix(const Matrix& a, const Matrix& b)
+{
+    return std::equal(a.data(), a.data() + 16, b.data());
+}
+}    // namespace
+
+class TestTransformSystem : public Test
+{
+public:
+    Scene     scene;
+    RefEntity entity;
+
+    void set_up() override
+    {
+        scene.component_maps().add<Transform>();
+        scene.emplace_system<TransformSystem>(scene,
+                                              *scene.component_maps().get<Transform>());
+
+        // Children are placed relative to their parent's transform
+        scene.root()->add_component<Transform>();
+
+        entity = scene.new_entity("moving");
+        entity->add_component<Transform>(1.0f, 0.0f, 0.0f);
+    }
+
+    Transform& transform() { return *entity->get_component<Transform>(); }
+};
+
+TEST_F(TestTransformSystem, FirstUpdateHasNothingToInterpolate)
+{
+    scene.update(0.01f);
+
+    assert_that(same_matrix(transform().previous_world_matrix(), transform().world_matrix()),
+                equals(true));
+    assert_that(same_matrix(transform().world_matrix(), Matrix::translation(1.0f, 0.0f, 0.0f)),
+                equals(true));
+}
+
+TEST_F(TestTransformSystem, InterpolatesBetweenTheLastTwoUpdates)
+{
+    scene.update(0.01f);
+
+    transform().position(5.0f, 0.0f, 0.0f);
+    scene.update(0.01f);
+
+    const auto previous = Matrix::translation(1.0f, 0.0f, 0.0f);
+    const auto current  = Matrix::translation(5.0f, 0.0f, 0.0f);
+
+    assert_that(same_matrix(transform().interpolated_world_matrix(0.0f), previous), equals(true));
+    assert_that(same_matrix(transform().interpolated_world_matrix(1.0f), current), equals(true));
+    assert_that(same_matrix(transform().interpolated_world_matrix(0.5f),
+                            Matrix::translation(3.0f, 0.0f, 0.0f)),
+                equals(true));
+
+    // Nothing moved since, both matrices are the same again
+    scene.update(0.01f);
+
+    assert_that(same_matrix(transform().interpolated_world_matrix(0.0f), current), equals(true));
+}
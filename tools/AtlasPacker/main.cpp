@@ -0,0 +1,186 @@
+#include <corgi/filesystem/FileSystem.h>
+#include <corgi/utils/AtlasPacker.h>
+#include <rapidjson/document.h>
+
+#include <algorithm>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <string>
+#include <vector>
+
+using namespace corgi;
+
+// Packs the textures of the input resource directories into atlas pages
+//
+// Only textures whose .tex file has an "atlas" member are packed, the value
+// being the name of the group they're packed with:
+//
+//	{
+//		"min_filter"	: "nearest",
+//		"mag_filter"	: "nearest",
+//		"wrap_s"		: "repeat",
+//		"wrap_t"		: "repeat",
+//		"atlas"			: "characters"
+//	}
+//
+// Usage : CorgiAtlasPacker -I <directory>... -O <directory>
+//			[--page-size <pixels>] [--padding <pixels>] [--extrude <pixels>]
+
+static void print_usage()
+{
+	std::cout << "Usage : CorgiAtlasPacker -I <directory>... -O <directory> "
+			  << "[--page-size <pixels>] [--padding <pixels>] [--extrude <pixels>]" << std::endl;
+}
+
+static bool load_image(const std::string& tex_path, AtlasPacker::Image& image)
+{
+	std::ifstream file(tex_path.substr(0, tex_path.size() - 4) + ".img", std::ifstream::binary);
+
+	if (!file.is_open())
+		return false;
+
+	int width;
+	int height;
+	int channels;
+
+	file.read(reinterpret_cast<char*>(&width), sizeof width);
+	file.read(reinterpret_cast<char*>(&height), sizeof height);
+	file.read(reinterpret_cast<char*>(&channels), sizeof channels);
+
+	if (!file || width <= 0 || height <= 0)
+		return false;
+
+	// .img files always store 4 channels, whatever the source image had
+	image.width		= static_cast<unsigned>(width);
+	image.height	= static_cast<unsigned>(height);
+	image.pixels.resize(static_cast<std::size_t>(width) * height * 4u);
+
+	file.read(reinterpret_cast<char*>(image.pixels.data()), static_cast<std::streamsize>(image.pixels.size()));
+	return static_cast<bool>(file);
+}
+
+static void add_directory(AtlasPacker& packer, const std::string& directory)
+{
+	for (const auto& file : filesystem::list_directory(directory, true))
+	{
+		if (file.extension() != "tex")
+			continue;
+
+		std::ifstream stream(file.path());
+		std::string content((std::istreambuf_iterator<char>(stream)), std::istreambuf_iterator<char>());
+
+		rapidjson::Document document;
+		document.Parse(content.c_str());
+
+		if (document.HasParseError() || !document.HasMember("atlas"))
+			continue;
+
+		AtlasPacker::Image image;
+
+		image.name	= file.path().substr(directory.size() + 1);
+		image.group	= document["atlas"].GetString();
+
+		std::replace(image.name.begin(), image.name.end(), '\\', '/');
+
+		if (document.HasMember("min_filter"))
+			image.min_filter = document["min_filter"].GetString();
+
+		if (document.HasMember("mag_filter"))
+			image.mag_filter = document["mag_filter"].GetString();
+
+		if (!load_image(file.path(), image))
+		{
+			std::cout << "Could not read the image of " << file.path() << std::endl;
+			continue;
+		}
+		packer.add(std::move(image));
+	}
+}
+
+int main(int argc, char** argv)
+{
+	std::vector<std::string> inputs;
+	std::string output;
+	AtlasPacker::Settings settings;
+
+	for (int i = 1; i < argc; i++)
+	{
+		const std::string arg = argv[i];
+
+		if (arg == "-O" && i + 1 < argc)
+		{
+			output = argv[++i];
+		}
+		else if (arg == "-I")
+		{
+			while (i + 1 < argc && argv[i + 1][0] != '-')
+				inputs.emplace_back(argv[++i]);
+		}
+		else if (arg == "--page-size" && i + 1 < argc)
+		{
+			settings.page_width		= static_cast<unsigned>(std::stoul(argv[++i]));
+			settings.page_height	= settings.page_width;
+		}
+		else if (arg == "--padding" && i + 1 < argc)
+		{
+			settings.padding = static_cast<unsigned>(std::stoul(argv[++i]));
+		}
+		else if (arg == "--extrude" && i + 1 < argc)
+		{
+			settings.extrude = static_cast<unsigned>(std::stoul(argv[++i]));
+		}
+		else
+		{
+			print_usage();
+			return 1;
+		}
+	}
+
+	if (inputs.empty() || output.empty())
+	{
+		print_usage();
+		return 1;
+	}
+
+	AtlasPacker packer(settings);
+
+	for (auto& input : inputs)
+	{
+		while (!input.empty() && (input.back() == '/' || input.back() == '\\'))
+			input.pop_back();
+
+		add_directory(packer, input);
+	}
+
+	const bool packed_everything = packer.pack();
+
+	if (!packer.write(output))
+	{
+		std::cout << "Could not write the atlases inside " << output << std::endl;
+		return 1;
+	}
+
+	// Packing efficiency report
+	for (std::size_t i = 0; i < packer.pages().size(); i++)
+	{
+		const auto& page = packer.pages()[i];
+
+		std::cout << packer.page_name(i) << " : " << page.width << "x" << page.height << ", "
+				  << page.placements.size() << " images, "
+				  << 100.0 * page.used_area / (static_cast<double>(page.width) * page.height)
+				  << "% used" << std::endl;
+	}
+
+	const auto report = packer.report();
+
+	std::cout << report.image_count << " images packed in " << report.page_count
+			  << " pages, " << report.efficiency() * 100.0f << "% of the pages used" << std::endl;
+
+	if (!packed_everything)
+	{
+		std::cout << "Some images are larger than a page and were not packed" << std::endl;
+		return 1;
+	}
+	return 0;
+}
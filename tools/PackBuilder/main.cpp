@@ -0,0 +1,95 @@
+#include <corgi/filesystem/PackFile.h>
+
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <set>
+#include <string>
+#include <vector>
+
+using namespace corgi;
+
+// Builds a pack file from the content of resource directories
+//
+// Files keep their path relative to their directory, which is also the
+// identifier given to the ResourcesCache. When several directories contain
+// the same path, the first directory wins, like ResourcesCache::find
+//
+// Usage : CorgiPackBuilder -I <directory>... -O <pack>
+
+static void print_usage()
+{
+	std::cout << "Usage : CorgiPackBuilder -I <directory>... -O <pack>" << std::endl;
+}
+
+int main(int argc, char** argv)
+{
+	std::vector<std::string> inputs;
+	std::string output;
+
+	for (int i = 1; i < argc; i++)
+	{
+		const std::string arg = argv[i];
+
+		if (arg == "-O" && i + 1 < argc)
+		{
+			output = argv[++i];
+		}
+		else if (arg == "-I")
+		{
+			while (i + 1 < argc && argv[i + 1][0] != '-')
+				inputs.emplace_back(argv[++i]);
+		}
+		else
+		{
+			print_usage();
+			return 1;
+		}
+	}
+
+	if (inputs.empty() || output.empty())
+	{
+		print_usage();
+		return 1;
+	}
+
+	std::vector<filesystem::PackFile::File> files;
+	std::set<std::string> paths;
+	std::size_t total_size = 0;
+
+	for (const auto& input : inputs)
+	{
+		std::error_code error;
+
+		for (const auto& item : std::filesystem::recursive_directory_iterator(input, error))
+		{
+			if (!item.is_regular_file())
+				continue;
+
+			auto path = std::filesystem::relative(item.path(), input).generic_string();
+
+			if (!paths.insert(path).second)
+				continue;
+
+			std::vector<std::byte> content(static_cast<std::size_t>(item.file_size()));
+
+			std::ifstream stream(item.path(), std::ios::binary);
+			stream.read(reinterpret_cast<char*>(content.data()), static_cast<std::streamsize>(content.size()));
+
+			total_size += content.size();
+			files.emplace_back(std::move(path), std::move(content));
+		}
+
+		if (error)
+			std::cout << "Could not read the directory " << input << std::endl;
+	}
+
+	if (!filesystem::PackFile::write(output, files))
+	{
+		std::cout << "Could not write " << output << std::endl;
+		return 1;
+	}
+
+	std::cout << files.size() << " files, " << total_size << " bytes, packed into " << output << std::endl;
+	return 0;
+}
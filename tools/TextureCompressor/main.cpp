@@ -0,0 +1,276 @@
+#include <corgi/filesystem/FileSystem.h>
+#include <corgi/utils/TextureCompression.h>
+#include <rapidjson/document.h>
+
+#include <algorithm>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <optional>
+#include <string>
+#include <vector>
+
+using namespace corgi;
+using namespace corgi::texture_compression;
+
+// Converts the images of the input resource directories into compressed
+// containers, holding the whole mip chain, that Texture uploads as is
+//
+// The .tex files are copied next to their converted .img, mirroring the input
+// directories. A texture chooses its format with the "compression" member,
+// which can be "none", "bc1", "bc3" or "bc7". Otherwise the format given by
+// -F is used, "auto" picking BC1 for images without partial transparency and
+// BC3 for the others:
+//
+//	{
+//		"min_filter"	: "linear_mipmap_linear",
+//		"mag_filter"	: "linear",
+//		"wrap_s"		: "repeat",
+//		"wrap_t"		: "repeat",
+//		"compression"	: "bc7"
+//	}
+//
+// Mip levels are only generated for textures using a mipmap min filter
+//
+// Usage : CorgiTextureCompressor -I <directory>... -O <directory>
+//			[-F none|bc1|bc3|bc7|auto]
+
+static void print_usage()
+{
+	std::cout << "Usage : CorgiTextureCompressor -I <directory>... -O <directory> "
+			  << "[-F none|bc1|bc3|bc7|auto]" << std::endl;
+}
+
+// Returns an empty optional for "auto"
+static bool parse_format(const std::string& name, std::optional<Format>& format)
+{
+	if (name == "none")
+		format = Format::RGBA8;
+	else if (name == "bc1")
+		format = Format::BC1;
+	else if (name == "bc3")
+		format = Format::BC3;
+	else if (name == "bc7")
+		format = Format::BC7;
+	else if (name == "auto")
+		format.reset();
+	else
+		return false;
+	return true;
+}
+
+static const char* format_name(Format format)
+{
+	switch (format)
+	{
+		case Format::RGBA8:	return "rgba8";
+		case Format::BC1:	return "bc1";
+		case Format::BC3:	return "bc3";
+		case Format::BC7:	return "bc7";
+	}
+	return "";
+}
+
+static bool load_image(const std::string& img_path, Image& image)
+{
+	std::ifstream file(img_path, std::ifstream::binary);
+
+	if (!file.is_open())
+		return false;
+
+	int width;
+	int height;
+	int channels;
+
+	file.read(reinterpret_cast<char*>(&width), sizeof width);
+	file.read(reinterpret_cast<char*>(&height), sizeof height);
+	file.read(reinterpret_cast<char*>(&channels), sizeof channels);
+
+	if (!file || width <= 0 || height <= 0)
+		return false;
+
+	// .img files always store 4 channels, whatever the source image had
+	image.width		= static_cast<unsigned>(width);
+	image.height	= static_cast<unsigned>(height);
+	image.pixels.resize(static_cast<std::size_t>(width) * height * 4u);
+
+	file.read(reinterpret_cast<char*>(image.pixels.data()), static_cast<std::streamsize>(image.pixels.size()));
+	return static_cast<bool>(file);
+}
+
+// BC1 only keeps 1 bit of alpha, and its transparent pixels are black, so the
+// quality is measured against what BC1 could keep at best
+static Image bc1_reference(Image image)
+{
+	for (std::size_t i = 0; i < image.pixels.size(); i += 4)
+	{
+		if (image.pixels[i + 3] < 128)
+			std::fill_n(image.pixels.begin() + static_cast<std::ptrdiff_t>(i), 4, std::uint8_t {0});
+		else
+			image.pixels[i + 3] = 255;
+	}
+	return image;
+}
+
+static bool compress_directory(const std::string& directory, const std::string& output,
+							   const std::optional<Format>& default_format,
+							   std::size_t& raw_total, std::size_t& compressed_total)
+{
+	bool success = true;
+
+	for (const auto& file : filesystem::list_directory(directory, true))
+	{
+		if (file.extension() != "tex")
+			continue;
+
+		auto name = file.path().substr(directory.size() + 1);
+		std::replace(name.begin(), name.end(), '\\', '/');
+
+		std::ifstream stream(file.path());
+		std::string content((std::istreambuf_iterator<char>(stream)), std::istreambuf_iterator<char>());
+
+		rapidjson::Document document;
+		document.Parse(content.c_str());
+
+		if (document.HasParseError())
+		{
+			std::cout << "Could not parse " << file.path() << std::endl;
+			success = false;
+			continue;
+		}
+
+		auto format = default_format;
+
+		if (document.HasMember("compression") &&
+			!parse_format(document["compression"].GetString(), format))
+		{
+			std::cout << "Unknown compression for " << name << std::endl;
+			success = false;
+			continue;
+		}
+
+		Image image;
+
+		if (!load_image(file.path().substr(0, file.path().size() - 4) + ".img", image))
+		{
+			std::cout << "Could not read the image of " << name << std::endl;
+			success = false;
+			continue;
+		}
+
+		if (!format)
+			format = choose_format(image);
+
+		const std::string min_filter =
+			document.HasMember("min_filter") ? document["min_filter"].GetString() : "";
+
+		std::vector<Image> levels;
+
+		if (min_filter.find("mipmap") != std::string::npos)
+			levels = generate_mips(image, true);
+		else
+			levels.push_back(image);
+
+		const auto container = Container::write(*format, levels);
+
+		const auto tex_path = output + "/" + name;
+		const auto img_path = tex_path.substr(0, tex_path.size() - 4) + ".img";
+
+		std::error_code error;
+		std::filesystem::create_directories(std::filesystem::path(tex_path).parent_path(), error);
+
+		std::ofstream tex_file(tex_path, std::ofstream::binary);
+		tex_file << content;
+
+		std::ofstream img_file(img_path, std::ofstream::binary);
+		img_file.write(reinterpret_cast<const char*>(container.data()), static_cast<std::streamsize>(container.size()));
+
+		if (!tex_file || !img_file)
+		{
+			std::cout << "Could not write " << img_path << std::endl;
+			success = false;
+			continue;
+		}
+
+		// Quality of the first level, decoded back
+		Container parsed;
+		parsed.parse(container);
+
+		const auto& level	= parsed.levels().front();
+		const auto decoded	= decode(*format,
+									 {reinterpret_cast<const std::uint8_t*>(level.data.data()), level.data.size()},
+									 level.width, level.height);
+
+		const double quality = psnr(*format == Format::BC1 ? bc1_reference(image) : image, decoded);
+
+		const auto raw_size = image.pixels.size();
+
+		std::cout << name << " : " << format_name(*format) << ", " << levels.size() << " levels, "
+				  << raw_size << " -> " << parsed.size() << " bytes, " << quality << " dB"
+				  << std::endl;
+
+		raw_total			+= raw_size;
+		compressed_total	+= parsed.size();
+	}
+	return success;
+}
+
+int main(int argc, char** argv)
+{
+	std::vector<std::string> inputs;
+	std::string output;
+	std::optional<Format> format;
+
+	for (int i = 1; i < argc; i++)
+	{
+		const std::string arg = argv[i];
+
+		if (arg == "-O" && i + 1 < argc)
+		{
+			output = argv[++i];
+		}
+		else if (arg == "-I")
+		{
+			while (i + 1 < argc && argv[i + 1][0] != '-')
+				inputs.emplace_back(argv[++i]);
+		}
+		else if (arg == "-F" && i + 1 < argc && parse_format(argv[i + 1], format))
+		{
+			i++;
+		}
+		else
+		{
+			print_usage();
+			return 1;
+		}
+	}
+
+	if (inputs.empty() || output.empty())
+	{
+		print_usage();
+		return 1;
+	}
+
+	while (!output.empty() && (output.back() == '/' || output.back() == '\\'))
+		output.pop_back();
+
+	bool success = true;
+
+	std::size_t raw_total			= 0u;
+	std::size_t compressed_total	= 0u;
+
+	for (auto& input : inputs)
+	{
+		while (!input.empty() && (input.back() == '/' || input.back() == '\\'))
+			input.pop_back();
+
+		success = compress_directory(input, output, format, raw_total, compressed_total) && success;
+	}
+
+	// The raw size doesn't count the mip levels, which take another third
+	std::cout << raw_total << " bytes of images compressed into " << compressed_total
+			  << " bytes with their mip levels" << std::endl;
+
+	return success ? 0 : 1;
+}